@@ -64,6 +64,7 @@
  * - Access to existing data
  * - Modify existing data
  * - Uses native C++ types
+ * - Thread-safe, no shared state is used when packing or unpacking
  *
  * __Draw Backs__
  * - Memory Usage: Serialization makes a copy of the contents
@@ -117,7 +118,7 @@
  * zakero::messagepack::Object the_answer = Object{uint64_t(42)};
  * array.append(the_answer);
  * array.append(Object{true});
- * array.append({std::string("Hello, World!")});
+ * array.append(std::string_view("Hello, World!"));
  * ~~~
  *
  * _Deserialize data_
@@ -127,6 +128,17 @@
  * zakero::messagepack::Object object = zakero::messagepack::deserialize(data);
  * ~~~
  *
+ * _Deserialize data into an arena_
+ *
+ * Objects use `std::pmr` containers. When deserialized with a memory 
+ * resource, all the strings, binary data, and containers are allocated from 
+ * that resource:
+ * ~~~
+ * std::pmr::monotonic_buffer_resource arena;
+ *
+ * zakero::messagepack::Object object = zakero::messagepack::deserialize(data, &arena);
+ * ~~~
+ *
  * The data in the MessagePack can be modified:
  * ~~~
  * if(object.isArray())
@@ -140,10 +152,57 @@
  * ~~~
  * data = zakero::messagepack::serialize(object);
  * ~~~
+ *
+ * _Pack data directly_
+ *
+ * When the data is only being written, a 
+ * [Packer](\ref zakero::messagepack::Packer) avoids creating Objects:
+ * ~~~
+ * std::vector<uint8_t> data;
+ * zakero::messagepack::Packer packer(data);
+ *
+ * packer.packArrayHeader(2);
+ * packer.packUint(42);
+ * packer.packStr("Hello, World!");
+ * ~~~
  * \endparhow
  *
  *
  * \parversion{zakero_messagepack}
+ * __v0.10.0__
+ * - Serialization and deserialization no longer use shared state
+ * - Added the Packer to write MessagePack data without Objects
+ * - Added ObjectView, ArrayView, and MapView to read packed data without 
+ *   copying it
+ * - deserialize() accepts a std::span
+ * - Added the Reader, a pull parser that decodes one token at a time
+ * - Added the Unpacker to deserialize data that arrives in pieces
+ * - Added serializedSize(), serialize() allocates its buffer once
+ * - Object, Array, Ext, and Map use std::pmr containers
+ * - deserialize() accepts a std::pmr::memory_resource
+ * - Map keeps its key/value pairs in order, string keys are found without 
+ *   allocating memory
+ * - Added ZAKERO_MESSAGEPACK_FIELDS() to pack structs without Objects
+ * - Added Packer::packRaw() to write data that is already packed
+ * - Added skip() and validate() to check packed data without decoding it
+ * - Added ArrayIndex for random access to the elements of a packed Array
+ * - Added MappedFile to iterate over a file of packed Objects
+ * - Added Array::appendRange() and Packer::packArray() for numeric columns
+ * - Added the Typed Array extension for numeric arrays that are read in place
+ * - The Packer can gather large data into a list of iovec for writev()
+ * - Array, Map, and Object accept rvalues, added Array::emplace() and 
+ *   Map::emplace()
+ * - deserialize() decodes Array elements in place
+ * - deserialize() does not use recursion and accepts Limits for untrusted data
+ * - Added deserializeBatch() to deserialize a sequence of Objects in parallel
+ * - serialize() can pack large Arrays and Maps in parallel
+ * - Added KeyCache to decode the repeated string keys of Maps faster
+ * - Added ShapeCache to decode Maps with the same keys faster
+ * - Map only allocates its storage when a key is added, Object is half the size
+ * - Added toJson() to convert MessagePack data directly to JSON
+ * - Added fromJson() to convert JSON directly to MessagePack data
+ * - Added Query to find an Object in packed data by its path
+ *
  * __v0.9.5__
  * - Bug fixes
  * - More test cases
@@ -202,18 +261,47 @@
  */
 
 // C++
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
 #include <cstring>
 #include <ctime>
+#include <deque>
+#include <functional>
 #include <limits>
-#include <map>
+#include <iterator>
+#include <memory_resource>
+#include <mutex>
+#include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
 // POSIX
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// x86
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST
+#include <optional>
+#endif
 
 // Linux
 
@@ -241,15 +329,145 @@
  *    The text that will be used by `std::error_code.message()`
  */
 #define ZAKERO_MESSAGEPACK__ERROR_DATA \
-	X(Error_None                , 0 , "No Error"                                ) \
-	X(Error_Unknown             , 1 , "An unknown error has occurred"           ) \
-	X(Error_Incomplete          , 2 , "The data to deserialize is incomplete"   ) \
-	X(Error_Invalid_Format_Type , 3 , "An invalid Format Type was encountered"  ) \
-	X(Error_Invalid_Index       , 4 , "Invalid starting index to deserialize"   ) \
-	X(Error_No_Data             , 5 , "No data to deserialize"                  ) \
-	X(Error_Array_Too_Big       , 6 , "The array is too large to serialize"     ) \
-	X(Error_Ext_Too_Big         , 7 , "The extension is too large to serialize" ) \
-	X(Error_Map_Too_Big         , 8 , "The map is too large to serialize"       ) \
+	X(Error_None                , 0  , "No Error"                                  ) \
+	X(Error_Unknown             , 1  , "An unknown error has occurred"             ) \
+	X(Error_Incomplete          , 2  , "The data to deserialize is incomplete"     ) \
+	X(Error_Invalid_Format_Type , 3  , "An invalid Format Type was encountered"    ) \
+	X(Error_Invalid_Index       , 4  , "Invalid starting index to deserialize"     ) \
+	X(Error_No_Data             , 5  , "No data to deserialize"                    ) \
+	X(Error_Array_Too_Big       , 6  , "The array is too large to serialize"       ) \
+	X(Error_Ext_Too_Big         , 7  , "The extension is too large to serialize"   ) \
+	X(Error_Map_Too_Big         , 8  , "The map is too large to serialize"         ) \
+	X(Error_Binary_Too_Big      , 9  , "The binary data is too large to serialize" ) \
+	X(Error_String_Too_Big      , 10 , "The string is too large to serialize"      ) \
+	X(Error_Buffer_Too_Small    , 11 , "The buffer is too small for the data"      ) \
+	X(Error_Depth_Limit         , 12 , "The data is nested too deeply"             ) \
+	X(Error_Type_Mismatch       , 13 , "The packed type does not match the field"  ) \
+	X(Error_Element_Limit       , 14 , "The data has too many elements"            ) \
+	X(Error_Size_Limit          , 15 , "The data is larger than the size limit"    ) \
+	X(Error_Invalid_Json        , 16 , "The JSON text is not valid"                ) \
+	X(Error_Invalid_Path        , 17 , "The path is not valid"                     ) \
+	X(Error_Path_Not_Found      , 18 , "The path was not found in the data"        ) \
+
+/**
+ * \brief Generate the MessagePack codec of a struct.
+ *
+ * The named fields of the \p type_ are packed as a Map, using the field names 
+ * as the keys. The following functions will be generated in the namespace 
+ * where the macro is used:
+ * - `std::error_code encode(const type_&, zakero::messagepack::Packer&)`
+ * - `std::error_code decode(zakero::messagepack::Reader&, type_&)`
+ * - `std::error_code decode(std::span<const uint8_t>, type_&)`
+ *
+ * The fields are written and read directly, no Object, Array, or Map is 
+ * created. The keys are packed at compile-time.
+ *
+ * When decoding, keys that are not fields are skipped and fields that are not 
+ * in the data are not changed. A value that can not be stored in its field 
+ * causes Error_Type_Mismatch.
+ *
+ * Fields can be:
+ * - `bool`, integers, characters, enums, `float`, and `double`
+ * - strings: `std::string`, `std::pmr::string`, or `std::string_view`
+ * - binary data: `std::vector<uint8_t>` or `std::span<const uint8_t>`
+ * - `std::optional` of any field type, Null when empty
+ * - `std::vector` or `std::array` of any field type
+ * - structs that use ZAKERO_MESSAGEPACK_FIELDS()
+ *
+ * A struct can have up to 256 fields.
+ *
+ * \parcode
+ * namespace telemetry
+ * {
+ * 	struct Sample
+ * 	{
+ * 		uint64_t    id;
+ * 		double      value;
+ * 		std::string unit;
+ * 	};
+ *
+ * 	ZAKERO_MESSAGEPACK_FIELDS(Sample, id, value, unit)
+ * }
+ *
+ * std::vector<uint8_t> data;
+ * zakero::messagepack::Packer packer(data);
+ *
+ * telemetry::Sample sample = { 42, 1.5, "volt" };
+ * encode(sample, packer);
+ *
+ * telemetry::Sample copy;
+ * std::error_code error = decode(data, copy);
+ * \endparcode
+ *
+ * \note A `std::string_view` or `std::span` field refers to the packed data, 
+ * which must exist for as long as the field is used.
+ *
+ * \param type_ The struct
+ * \param ...   The fields of the struct
+ */
+#define ZAKERO_MESSAGEPACK_FIELDS(type_, ...) \
+	inline std::error_code encode(const type_& value \
+		, zakero::messagepack::Packer&     packer \
+		) noexcept \
+	{ \
+		packer.packMapHeader(0 ZAKERO_MESSAGEPACK__FOR_EACH(ZAKERO_MESSAGEPACK__FIELD_COUNT, __VA_ARGS__)); \
+		ZAKERO_MESSAGEPACK__FOR_EACH(ZAKERO_MESSAGEPACK__FIELD_ENCODE, __VA_ARGS__) \
+		return packer.error(); \
+	} \
+	inline std::error_code decode(zakero::messagepack::Reader& reader \
+		, type_&                                           value \
+		) noexcept \
+	{ \
+		return zakero::messagepack::fieldMapDecode_(reader \
+			, [&](const std::string_view key) noexcept -> std::error_code \
+			{ \
+				ZAKERO_MESSAGEPACK__FOR_EACH(ZAKERO_MESSAGEPACK__FIELD_DECODE, __VA_ARGS__) \
+				return zakero::messagepack::fieldSkip_(reader); \
+			}); \
+	} \
+	inline std::error_code decode(const std::span<const uint8_t> data \
+		, type_&                                           value \
+		) noexcept \
+	{ \
+		zakero::messagepack::Reader reader(data); \
+		reader.next(); \
+		return decode(reader, value); \
+	}
+
+/**
+ * \internal
+ *
+ * \brief Field helpers.
+ *
+ * ZAKERO_MESSAGEPACK__FOR_EACH() applies the `macro_` to every argument. The 
+ * ZAKERO_MESSAGEPACK__EXPAND() macros rescan the result enough times for 256 
+ * arguments.
+ */
+#define ZAKERO_MESSAGEPACK__FIELD_COUNT(field_) + 1
+#define ZAKERO_MESSAGEPACK__FIELD_ENCODE(field_) \
+	{ \
+		static constexpr zakero::messagepack::FieldKey_ key = #field_; \
+		packer.packRaw(key.span()); \
+		zakero::messagepack::fieldEncode_(packer, value.field_); \
+	}
+#define ZAKERO_MESSAGEPACK__FIELD_DECODE(field_) \
+	if(key == #field_) \
+	{ \
+		return zakero::messagepack::fieldDecode_(reader, value.field_); \
+	}
+
+#define ZAKERO_MESSAGEPACK__PARENS ()
+#define ZAKERO_MESSAGEPACK__EXPAND(...)  ZAKERO_MESSAGEPACK__EXPAND4(ZAKERO_MESSAGEPACK__EXPAND4(ZAKERO_MESSAGEPACK__EXPAND4(ZAKERO_MESSAGEPACK__EXPAND4(__VA_ARGS__))))
+#define ZAKERO_MESSAGEPACK__EXPAND4(...) ZAKERO_MESSAGEPACK__EXPAND3(ZAKERO_MESSAGEPACK__EXPAND3(ZAKERO_MESSAGEPACK__EXPAND3(ZAKERO_MESSAGEPACK__EXPAND3(__VA_ARGS__))))
+#define ZAKERO_MESSAGEPACK__EXPAND3(...) ZAKERO_MESSAGEPACK__EXPAND2(ZAKERO_MESSAGEPACK__EXPAND2(ZAKERO_MESSAGEPACK__EXPAND2(ZAKERO_MESSAGEPACK__EXPAND2(__VA_ARGS__))))
+#define ZAKERO_MESSAGEPACK__EXPAND2(...) ZAKERO_MESSAGEPACK__EXPAND1(ZAKERO_MESSAGEPACK__EXPAND1(ZAKERO_MESSAGEPACK__EXPAND1(ZAKERO_MESSAGEPACK__EXPAND1(__VA_ARGS__))))
+#define ZAKERO_MESSAGEPACK__EXPAND1(...) __VA_ARGS__
+#define ZAKERO_MESSAGEPACK__FOR_EACH(macro_, ...) \
+	__VA_OPT__(ZAKERO_MESSAGEPACK__EXPAND(ZAKERO_MESSAGEPACK__FOR_EACH_NEXT(macro_, __VA_ARGS__)))
+#define ZAKERO_MESSAGEPACK__FOR_EACH_NEXT(macro_, field_, ...) \
+	macro_(field_) \
+	__VA_OPT__(ZAKERO_MESSAGEPACK__FOR_EACH_AGAIN ZAKERO_MESSAGEPACK__PARENS (macro_, __VA_ARGS__))
+#define ZAKERO_MESSAGEPACK__FOR_EACH_AGAIN() ZAKERO_MESSAGEPACK__FOR_EACH_NEXT
 
 // }}}
 
@@ -281,10 +499,46 @@ namespace zakero::messagepack
 
 	// }}}
 
+		// {{{ Limits
+
+		struct Limits
+		{
+			static constexpr size_t Depth_Max = 1024;
+
+			size_t max_depth    = Depth_Max;
+			size_t max_elements = std::numeric_limits<size_t>::max();
+			size_t max_bytes    = std::numeric_limits<size_t>::max();
+		};
+
+		// }}} Limits
+		// {{{ Json
+
+		enum class JsonEncoding : uint8_t
+		{	Array
+		,	Base64
+		,	Base64_Url
+		,	Hex
+		};
+
+		struct JsonOptions
+		{
+			JsonEncoding binary      = JsonEncoding::Base64;
+			JsonEncoding ext         = JsonEncoding::Base64;
+			bool         pretty      = false;
+			uint8_t      indent      = 2;
+			size_t       buffer_size = 4096;
+		};
+
+		using JsonSink = std::function<void(std::string_view)>;
+
+		// }}} Json
+
 		struct Array;
 		struct Ext;
-		struct Map;
+		class  KeyCache;
+		class  Map;
 		struct Object;
+		class  ShapeCache;
 
 		// {{{ Array
 
@@ -296,17 +550,28 @@ namespace zakero::messagepack
 			[[]]          size_t        append(const float) noexcept;
 			[[]]          size_t        append(const double) noexcept;
 			[[]]          size_t        append(const std::string_view) noexcept;
-			[[]]          size_t        append(const std::vector<uint8_t>&) noexcept;
-			[[]]          size_t        append(std::vector<uint8_t>&) noexcept;
+			[[]]          size_t        append(const std::span<const uint8_t>) noexcept;
+			[[]]          size_t        append(std::pmr::vector<uint8_t>&) noexcept;
+			[[]]          size_t        append(std::pmr::vector<uint8_t>&&) noexcept;
 			[[]]          size_t        append(const Array&) noexcept;
 			[[]]          size_t        append(Array&) noexcept;
+			[[]]          size_t        append(Array&&) noexcept;
 			[[]]          size_t        append(const Ext&) noexcept;
 			[[]]          size_t        append(Ext&) noexcept;
+			[[]]          size_t        append(Ext&&) noexcept;
 			[[]]          size_t        append(const Map&) noexcept;
 			[[]]          size_t        append(Map&) noexcept;
+			[[]]          size_t        append(Map&&) noexcept;
 			[[]]          size_t        append(const Object&) noexcept;
 			[[]]          size_t        append(Object&) noexcept;
+			[[]]          size_t        append(Object&&) noexcept;
 			[[]]          size_t        appendNull() noexcept;
+			[[]]          size_t        appendRange(const std::span<const float>) noexcept;
+			[[]]          size_t        appendRange(const std::span<const double>) noexcept;
+			[[]]          size_t        appendRange(const std::span<const int32_t>) noexcept;
+			[[]]          size_t        appendRange(const std::span<const int64_t>) noexcept;
+			template<typename T, typename... Args>
+			[[]]          T&            emplace(Args&&...) noexcept;
 
 			[[nodiscard]] Object&       object(const size_t index) noexcept       { return object_vector[index]; }
 			[[nodiscard]] const Object& object(const size_t index) const noexcept { return object_vector[index]; }
@@ -318,7 +583,7 @@ namespace zakero::messagepack
 			Object&       operator[](size_t index) noexcept       { return object_vector[index];    }
 			const Object& operator[](size_t index) const noexcept { return object_vector.at(index); }
 
-			std::vector<Object> object_vector = {};
+			std::pmr::vector<Object> object_vector = {};
 		};
 
 		// }}} Array
@@ -326,54 +591,194 @@ namespace zakero::messagepack
 
 		struct Ext
 		{
-			std::vector<uint8_t> data = {};
+			std::pmr::vector<uint8_t> data = {};
 			int8_t               type = 0;
 		};
 
 		// }}} Ext
 		// {{{ Map
 
-		struct Map
-		{
-			[[]]          std::error_code set(Object&, Object&) noexcept;
-			[[]]          std::error_code set(const Object&, const Object&) noexcept;
-			[[nodiscard]] bool            keyExists(const Object&) const noexcept;
-			[[nodiscard]] Object&         at(Object&) noexcept;
-			[[nodiscard]] const Object&   at(const Object&) const noexcept;
-
-			[[]]          void            erase(const Object&) noexcept;
-			[[]]          inline void     clear() noexcept;
-			[[nodiscard]] inline size_t   size() const noexcept;
-
-			Object&       operator[](Object& object) noexcept                   { return at(object);                      }
-			const Object& operator[](const Object& object) const noexcept       { return at(object);                      }
-			Object&       operator[](bool key) noexcept                         { return bool_map[key];                   }
-			const Object& operator[](bool key) const noexcept                   { return bool_map.at(key);                }
-			Object&       operator[](int64_t key) noexcept                      { return int64_map[key];                  }
-			const Object& operator[](int64_t key) const noexcept                { return int64_map.at(key);               }
-			Object&       operator[](uint64_t key) noexcept                     { return uint64_map[key];                 }
-			const Object& operator[](uint64_t key) const noexcept               { return uint64_map.at(key);              }
-			Object&       operator[](float key) noexcept                        { return float_map[key];                  }
-			const Object& operator[](float key) const noexcept                  { return float_map.at(key);               }
-			Object&       operator[](double key) noexcept                       { return double_map[key];                 }
-			const Object& operator[](double key) const noexcept                 { return double_map.at(key);              }
-			Object&       operator[](const char* key) noexcept                  { return string_map[std::string(key)];    }
-			const Object& operator[](const char* key) const noexcept            { return string_map.at(std::string(key)); }
-			Object&       operator[](std::string key) noexcept                  { return string_map[key];                 }
-			const Object& operator[](std::string key) const noexcept            { return string_map.at(key);              }
-			Object&       operator[](const std::string_view key) noexcept       { return string_map[std::string(key)];    }
-			const Object& operator[](const std::string_view key) const noexcept { return string_map.at(std::string(key)); }
-
-			std::vector<Object>           null_map   = {};
-			std::map<bool, Object>        bool_map   = {};
-			std::map<int64_t, Object>     int64_map  = {};
-			std::map<uint64_t, Object>    uint64_map = {};
-			std::map<float, Object>       float_map  = {};
-			std::map<double, Object>      double_map = {};
-			std::map<std::string, Object> string_map = {};
+		class Map
+		{
+			public:
+				static constexpr size_t Index_Threshold = 8;
+
+				Map() noexcept = default;
+				explicit Map(std::pmr::memory_resource*) noexcept;
+				Map(const Map&) noexcept;
+				Map(Map&&) noexcept;
+				~Map() noexcept;
+
+				Map& operator=(const Map&) noexcept;
+				Map& operator=(Map&&) noexcept;
+
+				[[]]          std::error_code set(Object&, Object&) noexcept;
+				[[]]          std::error_code set(const Object&, const Object&) noexcept;
+				[[]]          std::error_code set(Object&&, Object&&) noexcept;
+				template<typename T, typename Key, typename... Args>
+				[[]]          T&              emplace(const Key&, Args&&...) noexcept;
+				[[nodiscard]] bool            keyExists(const Object&) const noexcept;
+				[[nodiscard]] bool            keyExists(const std::string_view) const noexcept;
+				[[nodiscard]] Object&         at(Object&) noexcept;
+				[[nodiscard]] const Object&   at(const Object&) const noexcept;
+
+				[[nodiscard]] const Object&   key(const size_t index) const noexcept   { return data_->key_vector[index];   }
+				[[nodiscard]] Object&         value(const size_t index) noexcept       { return data_->value_vector[index]; }
+				[[nodiscard]] const Object&   value(const size_t index) const noexcept { return data_->value_vector[index]; }
+
+				[[]]          void            erase(const Object&) noexcept;
+				[[]]          void            clear() noexcept;
+				[[]]          void            reserve(const size_t) noexcept;
+				[[nodiscard]] size_t          size() const noexcept { return (data_ == nullptr) ? 0 : data_->key_vector.size(); }
+
+				Object&       operator[](Object& object) noexcept             { return at(object); }
+				const Object& operator[](const Object& object) const noexcept { return at(object); }
+				Object&       operator[](const bool) noexcept;
+				const Object& operator[](const bool) const noexcept;
+				Object&       operator[](const int64_t) noexcept;
+				const Object& operator[](const int64_t) const noexcept;
+				Object&       operator[](const uint64_t) noexcept;
+				const Object& operator[](const uint64_t) const noexcept;
+				Object&       operator[](const float) noexcept;
+				const Object& operator[](const float) const noexcept;
+				Object&       operator[](const double) noexcept;
+				const Object& operator[](const double) const noexcept;
+				Object&       operator[](const char* key) noexcept             { return operator[](std::string_view(key)); }
+				const Object& operator[](const char* key) const noexcept       { return operator[](std::string_view(key)); }
+				Object&       operator[](const std::string_view) noexcept;
+				const Object& operator[](const std::string_view) const noexcept;
+
+			private:
+				static constexpr size_t Npos = std::numeric_limits<size_t>::max();
+
+				friend class  ShapeCache;
+				friend Object deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, const Limits&, KeyCache*, ShapeCache*, std::pmr::memory_resource*) noexcept;
+
+				struct Data_
+				{
+					explicit Data_(std::pmr::memory_resource* resource) noexcept
+						: key_vector(resource)
+						, value_vector(resource)
+						, index_vector(resource)
+					{
+					}
+
+					std::pmr::vector<Object>   key_vector;
+					std::pmr::vector<Object>   value_vector;
+					std::pmr::vector<uint32_t> index_vector;
+				};
+
+				std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+				Data_*                     data_     = nullptr;
+
+				[[nodiscard]] static const Data_& empty_() noexcept;
+				[[nodiscard]] const Data_&        readable_() const noexcept { return (data_ == nullptr) ? empty_() : *data_; }
+				[[nodiscard]] Data_&              writable_() noexcept;
+
+				template<typename Key>
+				[[nodiscard]] size_t find_(const Key&) const noexcept;
+				[[nodiscard]] Object& findOrInsert_(Object&&) noexcept;
+				[[nodiscard]] const Object& findOrNull_(const Object&) const noexcept;
+				[[nodiscard]] Object& insert_(Object&&, const uint64_t) noexcept;
+				[[]]          void    indexBuild_() noexcept;
+				[[]]          void    indexInsert_(const size_t) noexcept;
+				[[]]          void    indexInsert_(const size_t, const uint64_t) noexcept;
 		};
 
 		// }}} Map
+		// {{{ KeyCache
+
+		class KeyCache
+		{
+			public:
+				static constexpr size_t Capacity       = 256;
+				static constexpr size_t Key_Length_Max = 64;
+
+				explicit KeyCache(const size_t = Capacity) noexcept;
+
+				[[]]          void   clear() noexcept;
+				[[]]          void   clearStatistics() noexcept;
+				[[nodiscard]] size_t capacity() const noexcept { return capacity_;            }
+				[[nodiscard]] size_t size() const noexcept     { return entry_vector_.size(); }
+				[[nodiscard]] size_t hits() const noexcept     { return hits_;                }
+				[[nodiscard]] size_t misses() const noexcept   { return misses_;              }
+				[[nodiscard]] double hitRate() const noexcept;
+
+			private:
+				static constexpr size_t Npos = std::numeric_limits<size_t>::max();
+
+				friend Object deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, const Limits&, KeyCache*, ShapeCache*, std::pmr::memory_resource*) noexcept;
+
+				struct Entry
+				{
+					std::string key  = {};
+					uint64_t    hash = 0;
+				};
+
+				std::vector<Entry>    entry_vector_ = {};
+				std::vector<uint32_t> slot_vector_  = {};
+				size_t                capacity_     = 0;
+				size_t                hits_         = 0;
+				size_t                misses_       = 0;
+
+				[[nodiscard]] size_t intern_(const std::string_view) noexcept;
+		};
+
+		// }}} KeyCache
+		// {{{ ShapeCache
+
+		class ShapeCache
+		{
+			public:
+				static constexpr size_t Capacity       = 16;
+				static constexpr size_t Key_Count_Max  = 64;
+				static constexpr size_t Key_Length_Max = 64;
+
+				explicit ShapeCache(const size_t = Capacity) noexcept;
+
+				[[]]          void   clear() noexcept;
+				[[]]          void   clearStatistics() noexcept;
+				[[nodiscard]] size_t capacity() const noexcept { return capacity_;            }
+				[[nodiscard]] size_t size() const noexcept     { return shape_vector_.size(); }
+				[[nodiscard]] size_t hits() const noexcept     { return hits_;                }
+				[[nodiscard]] size_t misses() const noexcept   { return misses_;              }
+				[[nodiscard]] double hitRate() const noexcept;
+
+			private:
+				static constexpr size_t Npos = std::numeric_limits<size_t>::max();
+
+				friend Object deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, const Limits&, KeyCache*, ShapeCache*, std::pmr::memory_resource*) noexcept;
+
+				struct Shape
+				{
+					std::vector<uint8_t>  key_bytes    = {};
+					std::vector<size_t>   key_offset   = {};
+					std::vector<Object>   key_vector   = {};
+					std::vector<uint32_t> index_vector = {};
+					uint64_t              generation   = 0;
+				};
+
+				std::vector<Shape>    shape_vector_  = {};
+				std::vector<uint8_t>  record_bytes_  = {};
+				std::vector<size_t>   record_offset_ = {};
+				size_t                capacity_      = 0;
+				size_t                next_          = 0;
+				uint64_t              generation_    = 0;
+				size_t                hits_          = 0;
+				size_t                misses_        = 0;
+
+				[[nodiscard]] size_t find_(const std::span<const uint8_t>, const size_t, const uint64_t) const noexcept;
+				[[nodiscard]] bool   match_(const Shape&, const size_t, const std::span<const uint8_t>, const size_t) const noexcept;
+				[[]]          void   create_(const Shape&, Map&, std::pmr::memory_resource*) const noexcept;
+				[[nodiscard]] size_t recordBegin_() noexcept;
+				[[nodiscard]] size_t recordBegin_(const Shape&, const size_t) noexcept;
+				[[nodiscard]] bool   recordKey_(const size_t, const std::span<const uint8_t>) noexcept;
+				[[]]          void   recordEnd_(const size_t, const Map&) noexcept;
+				[[]]          void   recordCancel_(const size_t) noexcept;
+				[[]]          void   add_(const size_t, const Map&) noexcept;
+		};
+
+		// }}} ShapeCache
 		// {{{ Object
 
 		struct Object
@@ -384,5872 +789,19609 @@ namespace zakero::messagepack
 				, uint64_t
 				, float
 				, double
-				, std::string
-				, std::vector<uint8_t>
+				, std::pmr::string
+				, std::pmr::vector<uint8_t>
 				, zakero::messagepack::Array
 				, zakero::messagepack::Ext
 				, zakero::messagepack::Map
 				> value = {};
 
 			template<typename T>
-			[[nodiscard]] T&                          as() noexcept             { return std::get<T>(value); }
+			[[nodiscard]] T&                               as() noexcept             { return std::get<T>(value); }
 			template<typename T>
-			[[nodiscard]] const T&                    as() const noexcept       { return std::get<T>(value); }
-
-			[[nodiscard]] messagepack::Array&         asArray() noexcept        { return std::get<messagepack::Array>(value);   }
-			[[nodiscard]] const messagepack::Array&   asArray() const noexcept  { return std::get<messagepack::Array>(value);   }
-			[[nodiscard]] messagepack::Ext&           asExt() noexcept          { return std::get<messagepack::Ext>(value);     }
-			[[nodiscard]] const messagepack::Ext&     asExt() const noexcept    { return std::get<messagepack::Ext>(value);     }
-			[[nodiscard]] messagepack::Map&           asMap() noexcept          { return std::get<messagepack::Map>(value);     }
-			[[nodiscard]] const messagepack::Map&     asMap() const noexcept    { return std::get<messagepack::Map>(value);     }
-			[[nodiscard]] std::vector<uint8_t>&       asBinary() noexcept       { return std::get<std::vector<uint8_t>>(value); }
-			[[nodiscard]] const std::vector<uint8_t>& asBinary() const noexcept { return std::get<std::vector<uint8_t>>(value); }
-			[[nodiscard]] const std::string&          asString() const noexcept { return std::get<std::string>(value);          }
+			[[nodiscard]] const T&                         as() const noexcept       { return std::get<T>(value); }
+
+			[[nodiscard]] messagepack::Array&              asArray() noexcept        { return std::get<messagepack::Array>(value);        }
+			[[nodiscard]] const messagepack::Array&        asArray() const noexcept  { return std::get<messagepack::Array>(value);        }
+			[[nodiscard]] messagepack::Ext&                asExt() noexcept          { return std::get<messagepack::Ext>(value);          }
+			[[nodiscard]] const messagepack::Ext&          asExt() const noexcept    { return std::get<messagepack::Ext>(value);          }
+			[[nodiscard]] messagepack::Map&                asMap() noexcept          { return std::get<messagepack::Map>(value);          }
+			[[nodiscard]] const messagepack::Map&          asMap() const noexcept    { return std::get<messagepack::Map>(value);          }
+			[[nodiscard]] std::pmr::vector<uint8_t>&       asBinary() noexcept       { return std::get<std::pmr::vector<uint8_t>>(value); }
+			[[nodiscard]] const std::pmr::vector<uint8_t>& asBinary() const noexcept { return std::get<std::pmr::vector<uint8_t>>(value); }
+			[[nodiscard]] const std::pmr::string&          asString() const noexcept { return std::get<std::pmr::string>(value);          }
 
 			template<typename T>
-			[[nodiscard]] constexpr bool              is() const noexcept       { return std::holds_alternative<T>(value); }
-
-			[[nodiscard]] constexpr bool              isArray() const noexcept  { return std::holds_alternative<messagepack::Array>(value);   }
-			[[nodiscard]] constexpr bool              isBinary() const noexcept { return std::holds_alternative<std::vector<uint8_t>>(value); }
-			[[nodiscard]] constexpr bool              isExt() const noexcept    { return std::holds_alternative<messagepack::Ext>(value);     }
-			[[nodiscard]] constexpr bool              isMap() const noexcept    { return std::holds_alternative<messagepack::Map>(value);     }
-			[[nodiscard]] constexpr bool              isNull() const noexcept   { return std::holds_alternative<std::monostate>(value);       }
-			[[nodiscard]] constexpr bool              isString() const noexcept { return std::holds_alternative<std::string>(value);          }
-
-			[[nodiscard]] std::string                 type() const noexcept;
-
-			Object& operator=(bool value) noexcept                        { this->value = value;              return *this; };
-			Object& operator=(int64_t value) noexcept                     { this->value = value;              return *this; };
-			Object& operator=(uint64_t value) noexcept                    { this->value = value;              return *this; };
-			Object& operator=(float value) noexcept                       { this->value = value;              return *this; };
-			Object& operator=(double value) noexcept                      { this->value = value;              return *this; };
-			Object& operator=(const char* value) noexcept                 { this->value = std::string(value); return *this; };
-			Object& operator=(const std::string value) noexcept           { this->value = value;              return *this; };
-			Object& operator=(const std::string_view value) noexcept      { this->value = std::string(value); return *this; };
-			Object& operator=(zakero::messagepack::Array& value) noexcept { this->value = value;              return *this; };
-			Object& operator=(zakero::messagepack::Ext& value) noexcept   { this->value = value;              return *this; };
-			Object& operator=(zakero::messagepack::Map& value) noexcept   { this->value = value;              return *this; };
+			[[nodiscard]] constexpr bool                   is() const noexcept       { return std::holds_alternative<T>(value); }
+
+			[[nodiscard]] constexpr bool                   isArray() const noexcept  { return std::holds_alternative<messagepack::Array>(value);        }
+			[[nodiscard]] constexpr bool                   isBinary() const noexcept { return std::holds_alternative<std::pmr::vector<uint8_t>>(value); }
+			[[nodiscard]] constexpr bool                   isExt() const noexcept    { return std::holds_alternative<messagepack::Ext>(value);          }
+			[[nodiscard]] constexpr bool                   isMap() const noexcept    { return std::holds_alternative<messagepack::Map>(value);          }
+			[[nodiscard]] constexpr bool                   isNull() const noexcept   { return std::holds_alternative<std::monostate>(value);            }
+			[[nodiscard]] constexpr bool                   isString() const noexcept { return std::holds_alternative<std::pmr::string>(value);          }
+
+			[[nodiscard]] std::string                      type() const noexcept;
+
+			Object& operator=(bool value) noexcept                             { this->value = value;                   return *this; };
+			Object& operator=(int64_t value) noexcept                          { this->value = value;                   return *this; };
+			Object& operator=(uint64_t value) noexcept                         { this->value = value;                   return *this; };
+			Object& operator=(float value) noexcept                            { this->value = value;                   return *this; };
+			Object& operator=(double value) noexcept                           { this->value = value;                   return *this; };
+			Object& operator=(const char* value) noexcept                      { this->value = std::pmr::string(value); return *this; };
+			Object& operator=(const std::string value) noexcept                { this->value = std::pmr::string(value); return *this; };
+			Object& operator=(const std::pmr::string& value) noexcept          { this->value = value;                   return *this; };
+			Object& operator=(std::pmr::string&& value) noexcept               { this->value = std::move(value);        return *this; };
+			Object& operator=(const std::pmr::vector<uint8_t>& value) noexcept { this->value = value;                   return *this; };
+			Object& operator=(std::pmr::vector<uint8_t>&& value) noexcept      { this->value = std::move(value);        return *this; };
+			Object& operator=(const std::string_view value) noexcept           { this->value = std::pmr::string(value); return *this; };
+			Object& operator=(zakero::messagepack::Array& value) noexcept      { this->value = value;                   return *this; };
+			Object& operator=(zakero::messagepack::Array&& value) noexcept     { this->value = std::move(value);        return *this; };
+			Object& operator=(zakero::messagepack::Ext& value) noexcept        { this->value = value;                   return *this; };
+			Object& operator=(zakero::messagepack::Ext&& value) noexcept       { this->value = std::move(value);        return *this; };
+			Object& operator=(zakero::messagepack::Map& value) noexcept        { this->value = value;                   return *this; };
+			Object& operator=(zakero::messagepack::Map&& value) noexcept       { this->value = std::move(value);        return *this; };
 		};
 
-		// }}} Object
-		// {{{ Extensions
 
-		[[nodiscard]] bool            extensionTimestampCheck(const Object&) noexcept;
-		[[nodiscard]] struct timespec extensionTimestampConvert(const Object&) noexcept;
-		[[nodiscard]] Object          extensionTimestampConvert(const struct timespec&) noexcept;
+		/**
+		 * \brief Construct a value at the end of the Array.
+		 *
+		 * A new Object is added to the end of the Array and its value 
+		 * is constructed in place, as a `T`, from the \p args. `T` must 
+		 * be one of the types that an Object can hold. Since a reference 
+		 * to the new value is returned, nested containers can be built 
+		 * without copying or moving them.
+		 *
+		 * \parcode
+		 * zakero::messagepack::Array array;
+		 *
+		 * zakero::messagepack::Map& map = array.emplace<zakero::messagepack::Map>();
+		 * map.emplace<std::pmr::string>("name", "zakero");
+		 * \endparcode
+		 *
+		 * \note The reference is no longer valid when more values are 
+		 * added to the Array.
+		 *
+		 * \return The new value.
+		 */
+		template<typename T, typename... Args>
+		T& Array::emplace(Args&&... args ///< The constructor arguments
+			) noexcept
+		{
+			return object_vector.emplace_back().value.template emplace<T>(std::forward<Args>(args)...);
+		}
 
-		// }}} Extensions
-		// {{{ Utilities
 
-		[[nodiscard]] Object               deserialize(const std::vector<uint8_t>&) noexcept;
-		[[nodiscard]] Object               deserialize(const std::vector<uint8_t>&, std::error_code&) noexcept;
-		[[nodiscard]] Object               deserialize(const std::vector<uint8_t>&, size_t&) noexcept;
-		[[nodiscard]] Object               deserialize(const std::vector<uint8_t>&, size_t&, std::error_code&) noexcept;
-		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Array&) noexcept;
-		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Array&, std::error_code&) noexcept;
-		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Ext&) noexcept;
-		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Ext&, std::error_code&) noexcept;
-		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Map&) noexcept;
-		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Map&, std::error_code&) noexcept;
-		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Object&) noexcept;
-		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Object&, std::error_code&) noexcept;
-		[[nodiscard]] std::string          to_string(const messagepack::Array&) noexcept;
-		[[nodiscard]] std::string          to_string(const messagepack::Ext&) noexcept;
-		[[nodiscard]] std::string          to_string(const messagepack::Map&) noexcept;
-		[[nodiscard]] std::string          to_string(const messagepack::Object&) noexcept;
+		/**
+		 * \brief Construct the value of a key.
+		 *
+		 * The value of the \p key will be constructed in place, as a `T`, 
+		 * from the \p args. `T` must be one of the types that an Object 
+		 * can hold. If the \p key already exists, its value will be 
+		 * replaced. The \p key can be any type that operator[]() 
+		 * accepts.
+		 *
+		 * \parcode
+		 * zakero::messagepack::Map map;
+		 *
+		 * zakero::messagepack::Array& list = map.emplace<zakero::messagepack::Array>("list");
+		 * list.append(int64_t(1));
+		 * \endparcode
+		 *
+		 * \note The reference is no longer valid when more keys are 
+		 * added to the Map.
+		 *
+		 * \return The new value.
+		 */
+		template<typename T, typename Key, typename... Args>
+		T& Map::emplace(const Key& key ///< The key
+			, Args&&...        args ///< The constructor arguments
+			) noexcept
+		{
+			static_assert(std::is_same_v<Key, Object> == false, "Use set() for Object keys");
 
-		// }}} Utilities
-} // zakero::messagepack
+			return operator[](key).value.template emplace<T>(std::forward<Args>(args)...);
+		}
 
-// {{{ Operators
+		// }}} Object
+		// {{{ Packer
 
-std::ostream& operator<<(std::ostream&, const zakero::messagepack::Array&) noexcept;
-std::ostream& operator<<(std::ostream&, const zakero::messagepack::Ext&) noexcept;
-std::ostream& operator<<(std::ostream&, const zakero::messagepack::Map&) noexcept;
-std::ostream& operator<<(std::ostream&, const zakero::messagepack::Object&) noexcept;
+		/**
+		 * \internal
+		 *
+		 * \brief The element types of the Typed Array extension.
+		 */
+		template<typename T>
+		concept TypedArrayElement_ = std::is_same_v<T, int8_t>
+			|| std::is_same_v<T, int16_t>
+			|| std::is_same_v<T, int32_t>
+			|| std::is_same_v<T, int64_t>
+			|| std::is_same_v<T, uint8_t>
+			|| std::is_same_v<T, uint16_t>
+			|| std::is_same_v<T, uint32_t>
+			|| std::is_same_v<T, uint64_t>
+			|| std::is_same_v<T, float>
+			|| std::is_same_v<T, double>
+			;
 
-bool operator==(const zakero::messagepack::Object& lhs, const zakero::messagepack::Object& rhs) noexcept;
-bool operator!=(const zakero::messagepack::Object& lhs, const zakero::messagepack::Object& rhs) noexcept;
 
-// }}}
-// {{{ Implementation
+		/**
+		 * \internal
+		 *
+		 * \brief The Typed Array element code of `T`.
+		 *
+		 * The high nibble is the kind of number (0: unsigned, 1: 
+		 * signed, 2: floating point) and the low nibble is the size of 
+		 * the number in bytes.
+		 */
+		template<TypedArrayElement_ T>
+		constexpr uint8_t typedArrayElement_() noexcept
+		{
+			const uint8_t kind = std::is_floating_point_v<T> ? 2
+				: std::is_signed_v<T> ? 1
+				: 0;
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION
+			return (uint8_t)((kind << 4) | sizeof(T));
+		}
 
-// {{{ Macros
-// {{{ Macros : Doxygen
 
-#ifdef ZAKERO__DOXYGEN_DEFINE_DOCS
+		class Packer
+		{
+			public:
+				using Sink = std::function<void(std::span<const uint8_t>)>;
+
+				static constexpr size_t Sink_Buffer_Size = 4096;
+				static constexpr size_t Gather_Size      = 1024;
+
+				explicit Packer(std::vector<uint8_t>&) noexcept;
+				explicit Packer(std::span<uint8_t>) noexcept;
+				explicit Packer(Sink, const size_t = Sink_Buffer_Size) noexcept;
+				Packer(std::vector<uint8_t>&, std::vector<struct iovec>&, const size_t = Gather_Size) noexcept;
+				~Packer() noexcept;
+
+				Packer(const Packer&) = delete;
+				Packer& operator=(const Packer&) = delete;
+
+				[[]]          std::error_code packNull() noexcept;
+				[[]]          std::error_code packBool(const bool) noexcept;
+				[[]]          std::error_code packInt(const int64_t) noexcept;
+				[[]]          std::error_code packUint(const uint64_t) noexcept;
+				[[]]          std::error_code packFloat(const float) noexcept;
+				[[]]          std::error_code packDouble(const double) noexcept;
+				[[]]          std::error_code packStr(const std::string_view) noexcept;
+				[[]]          std::error_code packBin(const std::span<const uint8_t>) noexcept;
+				[[]]          std::error_code packExt(const int8_t, const std::span<const uint8_t>) noexcept;
+				[[]]          std::error_code packArrayHeader(const size_t) noexcept;
+				[[]]          std::error_code packMapHeader(const size_t) noexcept;
+				[[]]          std::error_code packRaw(const std::span<const uint8_t>) noexcept;
+				[[]]          std::error_code packArray(const std::span<const float>) noexcept;
+				[[]]          std::error_code packArray(const std::span<const double>) noexcept;
+				[[]]          std::error_code packArray(const std::span<const int32_t>) noexcept;
+				[[]]          std::error_code packArray(const std::span<const int64_t>) noexcept;
+
+				template<TypedArrayElement_ T>
+				[[]]          std::error_code packTypedArray(const std::span<const T> value) noexcept
+				{
+					return packTypedArray_(typedArrayElement_<T>(), std::as_bytes(value));
+				}
+				[[]]          std::error_code pack(const messagepack::Array&) noexcept;
+				[[]]          std::error_code pack(const messagepack::Ext&) noexcept;
+				[[]]          std::error_code pack(const messagepack::Map&) noexcept;
+				[[]]          std::error_code pack(const messagepack::Object&) noexcept;
+				[[]]          std::error_code pack(const std::span<const messagepack::Object>) noexcept;
+
+				[[]]          std::error_code flush() noexcept;
+				[[nodiscard]] std::error_code error() const noexcept { return error_; }
+				[[nodiscard]] size_t          size() const noexcept  { return size_;  }
+
+			private:
+				std::vector<uint8_t>* vector_      = nullptr;
+				std::span<uint8_t>    buffer_      = {};
+				std::vector<uint8_t>  sink_buffer_ = {};
+				Sink                  sink_        = {};
+				size_t                index_       = 0;
+				size_t                size_        = 0;
+				std::error_code       error_       = Error_None;
+
+				std::vector<struct iovec>*             iovec_vector_  = nullptr;
+				std::vector<std::pair<size_t, size_t>> gather_vector_ = {};
+				size_t                                 gather_size_   = 0;
+				size_t                                 gather_offset_ = 0;
+
+				[[]]          void            gather_() noexcept;
+				[[nodiscard]] uint8_t*        reserve_(const size_t) noexcept;
+				[[]]          void            write_(const uint8_t*, const size_t) noexcept;
+				template<typename T>
+				[[]]          std::error_code writeFormat_(const uint8_t, const T) noexcept;
+				template<typename T>
+				[[]]          std::error_code writeColumn_(const uint8_t, const std::span<const T>) noexcept;
+				template<typename T>
+				[[]]          size_t          packRun_(const uint8_t, const std::span<const messagepack::Object>) noexcept;
+				[[]]          std::error_code packTypedArray_(const uint8_t, const std::span<const std::byte>) noexcept;
+		};
 
-// Only used for generating Doxygen documentation
+		// }}} Packer
+		// {{{ ObjectView
 
-/**
- * \brief Activate the implementation code.
- *
- * Defining this macro will cause the zakero::MessagePack implementation to be 
- * included. This should only be done once, since compiler and/or linker errors 
- * will typically be generated if more than a single implementation is found.
- *
- * \note It does not matter if the macro is given a value or not, only its 
- * existence is checked.
- */
-#define ZAKERO_MESSAGEPACK_IMPLEMENTATION
+		class ArrayView;
+		class MapView;
 
-/**
- * \def X(name_, val_, mesg_)
- *
- * \brief Generate Code.
- */
+		struct ExtView
+		{
+			std::span<const uint8_t> data = {};
+			int8_t                   type = 0;
+		};
 
-#endif
+		class ObjectView
+		{
+			public:
+				ObjectView() noexcept = default;
+				explicit ObjectView(const std::span<const uint8_t>) noexcept;
+				ObjectView(const std::span<const uint8_t>, size_t&, std::error_code&) noexcept;
+
+				template<std::ranges::contiguous_range Range>
+				requires (sizeof(std::ranges::range_value_t<Range>) == 1)
+				explicit ObjectView(const Range& range) noexcept
+					: ObjectView(std::span<const uint8_t>((const uint8_t*)std::ranges::data(range), std::ranges::size(range)))
+				{
+				}
 
-// }}}
+				[[nodiscard]] ArrayView                asArray() const noexcept;
+				[[nodiscard]] std::span<const uint8_t> asBinary() const noexcept;
+				[[nodiscard]] bool                     asBool() const noexcept;
+				[[nodiscard]] double                   asDouble() const noexcept;
+				[[nodiscard]] ExtView                  asExt() const noexcept;
+				[[nodiscard]] float                    asFloat() const noexcept;
+				[[nodiscard]] int64_t                  asInt() const noexcept;
+				[[nodiscard]] MapView                  asMap() const noexcept;
+				[[nodiscard]] std::string_view         asString() const noexcept;
+				[[nodiscard]] uint64_t                 asUint() const noexcept;
+
+				[[nodiscard]] bool                     isArray() const noexcept;
+				[[nodiscard]] bool                     isBinary() const noexcept;
+				[[nodiscard]] bool                     isBool() const noexcept;
+				[[nodiscard]] bool                     isDouble() const noexcept;
+				[[nodiscard]] bool                     isExt() const noexcept;
+				[[nodiscard]] bool                     isFloat() const noexcept;
+				[[nodiscard]] bool                     isInt() const noexcept;
+				[[nodiscard]] bool                     isMap() const noexcept;
+				[[nodiscard]] bool                     isNull() const noexcept;
+				[[nodiscard]] bool                     isString() const noexcept;
+				[[nodiscard]] bool                     isUint() const noexcept;
+				[[nodiscard]] bool                     isValid() const noexcept;
+
+				[[nodiscard]] std::span<const uint8_t> data() const noexcept;
+
+			private:
+				std::span<const uint8_t> data_     = {};
+				uint64_t                 value_    = 0;
+				size_t                   offset_   = 0;
+				uint8_t                  type_     = 0;
+				int8_t                   ext_type_ = 0;
+		};
 
-/**
- * \internal
- *
- * \brief Format Data
- *
- * This X-Macro table contains:
- * - The internal format type name
- * - The type id
- * - A type id mask (the bit-wise complement is used to get the value)
- * - The minimum size of the format, including the ID byte
- * - The type spec name
- */
-#define ZAKERO_MESSAGEPACK__FORMAT_TYPE \
-	/* Variable       Id          Mask          Size      Name         */ \
-	X(Fixed_Int_Pos , 0x00      , 0b10000000  , 1      , "positive fixint" ) \
-	X(Fixed_Map     , 0x80      , 0b11110000  , 1      , "fixmap"          ) \
-	X(Fixed_Array   , 0x90      , 0b11110000  , 1      , "fixarray"        ) \
-	X(Fixed_Str     , 0xa0      , 0b11100000  , 1      , "fixstr"          ) \
-	X(Nill          , 0xc0      , 0b11111111  , 1      , "nill"            ) \
-	X(Never_Used    , 0xc1      , 0b11111111  , 1      , "(never used)"    ) \
-	X(False         , 0xc2      , 0b11111111  , 1      , "false"           ) \
-	X(True          , 0xc3      , 0b11111111  , 1      , "true"            ) \
-	X(Bin8          , 0xc4      , 0b11111111  , 2      , "bin 8"           ) \
-	X(Bin16         , 0xc5      , 0b11111111  , 259    , "bin 16"          ) \
-	X(Bin32         , 0xc6      , 0b11111111  , 65541  , "bin 32"          ) \
-	X(Ext8          , 0xc7      , 0b11111111  , 3      , "ext 8"           ) \
-	X(Ext16         , 0xc8      , 0b11111111  , 260    , "ext 16"          ) \
-	X(Ext32         , 0xc9      , 0b11111111  , 65542  , "ext 32"          ) \
-	X(Float32       , 0xca      , 0b11111111  , 5      , "float 32"        ) \
-	X(Float64       , 0xcb      , 0b11111111  , 9      , "float 64"        ) \
-	X(Uint8         , 0xcc      , 0b11111111  , 2      , "uint 8"          ) \
-	X(Uint16        , 0xcd      , 0b11111111  , 3      , "uint 16"         ) \
-	X(Uint32        , 0xce      , 0b11111111  , 5      , "uint 32"         ) \
-	X(Uint64        , 0xcf      , 0b11111111  , 9      , "uint 64"         ) \
-	X(Int8          , 0xd0      , 0b11111111  , 2      , "int 8"           ) \
-	X(Int16         , 0xd1      , 0b11111111  , 3      , "int 16"          ) \
-	X(Int32         , 0xd2      , 0b11111111  , 5      , "int 32"          ) \
-	X(Int64         , 0xd3      , 0b11111111  , 9      , "int 64"          ) \
-	X(Fixed_Ext1    , 0xd4      , 0b11111111  , 3      , "fixext 1"        ) \
-	X(Fixed_Ext2    , 0xd5      , 0b11111111  , 4      , "fixext 2"        ) \
-	X(Fixed_Ext4    , 0xd6      , 0b11111111  , 6      , "fixext 4"        ) \
-	X(Fixed_Ext8    , 0xd7      , 0b11111111  , 10     , "fixext 8"        ) \
-	X(Fixed_Ext16   , 0xd8      , 0b11111111  , 18     , "fixext 16"       ) \
-	X(Str8          , 0xd9      , 0b11111111  , 34     , "str 8"           ) \
-	X(Str16         , 0xda      , 0b11111111  , 259    , "str 16"          ) \
-	X(Str32         , 0xdb      , 0b11111111  , 65541  , "str 32"          ) \
-	X(Array16       , 0xdc      , 0b11111111  , 19     , "array 16"        ) \
-	X(Array32       , 0xdd      , 0b11111111  , 65541  , "array 32"        ) \
-	X(Map16         , 0xde      , 0b11111111  , 35     , "map 16"          ) \
-	X(Map32         , 0xdf      , 0b11111111  , 131076 , "map 32"          ) \
-	X(Fixed_Int_Neg , 0xe0      , 0b11100000  , 1      , "negative fixint" ) \
-/**
- * \def X
- *
- * \brief Convert macro data into code.
- */
+		// }}} ObjectView
+		// {{{ ArrayView
 
-// }}}
+		class ArrayView
+		{
+			public:
+				class Iterator
+				{
+					public:
+						using iterator_category = std::forward_iterator_tag;
+						using difference_type   = std::ptrdiff_t;
+						using value_type        = ObjectView;
+						using pointer           = void;
+						using reference         = ObjectView;
 
-namespace zakero::messagepack
-{
-// {{{ Documentation
+						Iterator() noexcept = default;
 
-/**
- * \class ErrorCategory_
- *
- * \brief MessagePack Error Categories.
- */
+						ObjectView operator*() const noexcept                      { return ObjectView(data_.subspan(index_)); }
+						Iterator&  operator++() noexcept;
+						Iterator   operator++(int) noexcept                        { Iterator iter = *this; ++(*this); return iter; }
+						bool       operator==(const Iterator& other) const noexcept { return remaining_ == other.remaining_; }
 
-// }}}
-// {{{ Anonymous Namespace
+					private:
+						friend class ArrayView;
 
-namespace
-{
-	/**
-	 * \brief MessagePack Format IDs.
-	 */
-	enum class Format : uint8_t
-	{
-#define X(type_, id_, mask_, size_, text_) \
-		type_ = id_, \
+						Iterator(const std::span<const uint8_t>, const size_t) noexcept;
 
-		ZAKERO_MESSAGEPACK__FORMAT_TYPE
-#undef X
-	};
+						void check_() noexcept;
 
+						std::span<const uint8_t> data_      = {};
+						size_t                   index_     = 0;
+						size_t                   remaining_ = 0;
+				};
 
-	/**
-	 * \brief Format ID names.
-	 *
-	 * Useful for debugging.
-	std::map<uint8_t, std::string> Format_Name =
-	{
-	#define X(type_, id_, mask_, size_, text_) \
-		{ uint8_t(id_ & mask_), std::string(name_) },
+				ArrayView() noexcept = default;
 
-		ZAKERO_MESSAGEPACK__FORMAT_TYPE
-	#undef X
-	};
-	 */
+				[[nodiscard]] ObjectView object(const size_t) const noexcept;
+				[[nodiscard]] size_t     size() const noexcept  { return size_;                 }
+				[[nodiscard]] Iterator   begin() const noexcept { return Iterator(data_, size_); }
+				[[nodiscard]] Iterator   end() const noexcept   { return Iterator(data_, 0);     }
 
+				ObjectView operator[](const size_t index) const noexcept { return object(index); }
 
-	/**
-	 * \name Format ID Masks
-	 * \{
-	 */
-#define X(type_, id_, mask_, size_, text_) \
-	constexpr uint8_t type_ ## _Mask  = mask_;  \
+			private:
+				friend class ObjectView;
 
-	ZAKERO_MESSAGEPACK__FORMAT_TYPE
-#undef X
-	/**
-	 * \}
-	 */
+				ArrayView(const std::span<const uint8_t> data, const size_t size) noexcept : data_(data), size_(size) {}
 
+				std::span<const uint8_t> data_ = {};
+				size_t                   size_ = 0;
+		};
 
-	/**
-	 * \name Format Value Masks
-	 * \{
-	 */
-#define X(type_, id_, mask_, size_, text_) \
-	constexpr uint8_t type_ ## _Value = (uint8_t)~mask_;\
+		// }}} ArrayView
+		// {{{ ArrayIndex
 
-	ZAKERO_MESSAGEPACK__FORMAT_TYPE
-#undef X
-	/**
-	 * \}
-	 */
+		class ArrayIndex
+		{
+			public:
+				ArrayIndex() noexcept = default;
 
+				[[]]          std::error_code          build(const std::span<const uint8_t>) noexcept;
+				[[]]          std::error_code          load(const std::span<const uint8_t>, const std::span<const uint8_t>) noexcept;
+				[[nodiscard]] std::vector<uint8_t>     save() const noexcept;
 
-	/**
-	 * \brief In-Place Byte Conversion.
-	 */
-	union
-	{
-		uint64_t uint64;
-		uint32_t uint32;
-		uint16_t uint16;
-		uint8_t  uint8;
-		int64_t  int64;
-		int32_t  int32;
-		int16_t  int16;
-		int8_t   int8;
-		float    float32;
-		double   float64;
-		uint8_t  uint8_[8];
-	} Convert;
+				[[nodiscard]] Object                   at(const size_t) const noexcept;
+				[[nodiscard]] Object                   at(const size_t, std::error_code&, std::pmr::memory_resource* = std::pmr::get_default_resource()) const noexcept;
+				[[nodiscard]] std::span<const uint8_t> element(const size_t) const noexcept;
+				[[nodiscard]] size_t                   size() const noexcept { return offset_vector_.empty() ? 0 : offset_vector_.size() - 1; }
 
+				ObjectView operator[](const size_t index) const noexcept { return ObjectView(element(index)); }
 
-	/**
-	 * \name Endian Conversion
-	 * \{
-	 */
-#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
-	uint8_t& Convert_Byte0 = Convert.uint8_[7];
-	uint8_t& Convert_Byte1 = Convert.uint8_[6];
-	uint8_t& Convert_Byte2 = Convert.uint8_[5];
-	uint8_t& Convert_Byte3 = Convert.uint8_[4];
-	uint8_t& Convert_Byte4 = Convert.uint8_[3];
-	uint8_t& Convert_Byte5 = Convert.uint8_[2];
-	uint8_t& Convert_Byte6 = Convert.uint8_[1];
-	uint8_t& Convert_Byte7 = Convert.uint8_[0];
-#elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
-	uint8_t& Convert_Byte0 = Convert.uint8_[0];
-	uint8_t& Convert_Byte1 = Convert.uint8_[1];
-	uint8_t& Convert_Byte2 = Convert.uint8_[2];
-	uint8_t& Convert_Byte3 = Convert.uint8_[3];
-	uint8_t& Convert_Byte4 = Convert.uint8_[4];
-	uint8_t& Convert_Byte5 = Convert.uint8_[5];
-	uint8_t& Convert_Byte6 = Convert.uint8_[6];
-	uint8_t& Convert_Byte7 = Convert.uint8_[7];
-#endif
-	/**
-	 * \}
-	 */
+			private:
+				std::span<const uint8_t> data_          = {};
+				std::vector<uint64_t>    offset_vector_ = {};
+		};
 
-	
-	/**
-	 * \brief Get the minimum byte size of the Format ID
-	 *
-	 * \return The size.
-	 */
-	constexpr size_t formatSize(Format id ///< The Format ID
-		) noexcept
-	{
-		switch(id)
+		// }}} ArrayIndex
+		// {{{ MapView
+
+		class MapView
 		{
-#define X(type_, id_, mask_, size_, text_) \
-			case Format::type_: return size_;
-			ZAKERO_MESSAGEPACK__FORMAT_TYPE
-#undef X
-			default: return 0;
-		}
-	}
+			public:
+				class Iterator
+				{
+					public:
+						using iterator_category = std::forward_iterator_tag;
+						using difference_type   = std::ptrdiff_t;
+						using value_type        = std::pair<ObjectView, ObjectView>;
+						using pointer           = void;
+						using reference         = std::pair<ObjectView, ObjectView>;
 
-	std::error_code serialize_(const messagepack::Array&, std::vector<uint8_t>&) noexcept;
-	std::error_code serialize_(const messagepack::Ext&, std::vector<uint8_t>&) noexcept;
-	std::error_code serialize_(const messagepack::Map&, std::vector<uint8_t>&) noexcept;
+						Iterator() noexcept = default;
 
-	/**
-	 * \brief Serialize a MessagePack Object.
-	 *
-	 * The provided \p object will be serialized into a byte-code which 
-	 * will be appended onto the \p vector.
-	 *
-	 * \return An error code.
-	 */
-	std::error_code serialize_(const messagepack::Object& object ///< The Object to serialize
-		, std::vector<uint8_t>&                       vector ///< Where to store the Object
-		) noexcept
-	{
-		if(object.isNull())
-		{
-			vector.push_back((uint8_t)Format::Nill);
+						reference operator*() const noexcept                      { return {ObjectView(data_.subspan(key_)), ObjectView(data_.subspan(value_))}; }
+						Iterator& operator++() noexcept;
+						Iterator  operator++(int) noexcept                        { Iterator iter = *this; ++(*this); return iter; }
+						bool      operator==(const Iterator& other) const noexcept { return remaining_ == other.remaining_; }
 
-			return Error_None;
-		}
+					private:
+						friend class MapView;
 
-		if(object.is<bool>())
-		{
-			vector.push_back(object.as<bool>()
-				? (uint8_t)Format::True
-				: (uint8_t)Format::False
-				);
+						Iterator(const std::span<const uint8_t>, const size_t) noexcept;
 
-			return Error_None;
-		}
-		
-		if(object.is<int64_t>())
+						void seek_() noexcept;
+
+						std::span<const uint8_t> data_      = {};
+						size_t                   key_       = 0;
+						size_t                   value_     = 0;
+						size_t                   remaining_ = 0;
+				};
+
+				MapView() noexcept = default;
+
+				[[nodiscard]] ObjectView at(const std::string_view) const noexcept;
+				[[nodiscard]] ObjectView at(const int64_t) const noexcept;
+				[[nodiscard]] bool       keyExists(const std::string_view) const noexcept;
+				[[nodiscard]] bool       keyExists(const int64_t) const noexcept;
+				[[nodiscard]] size_t     size() const noexcept  { return size_;                 }
+				[[nodiscard]] Iterator   begin() const noexcept { return Iterator(data_, size_); }
+				[[nodiscard]] Iterator   end() const noexcept   { return Iterator(data_, 0);     }
+
+				ObjectView operator[](const std::string_view key) const noexcept { return at(key); }
+				ObjectView operator[](const int64_t key) const noexcept          { return at(key); }
+
+			private:
+				friend class ObjectView;
+
+				MapView(const std::span<const uint8_t> data, const size_t size) noexcept : data_(data), size_(size) {}
+
+				std::span<const uint8_t> data_ = {};
+				size_t                   size_ = 0;
+		};
+
+		// }}} MapView
+		// {{{ Query
+
+		class Query
 		{
-			const int64_t value = object.as<int64_t>();
+			public:
+				Query() noexcept = default;
+				explicit Query(const std::string_view) noexcept;
+
+				[[]]          std::error_code compile(const std::string_view) noexcept;
+				[[nodiscard]] std::error_code error() const noexcept { return error_;              }
+				[[nodiscard]] std::error_code find(const std::span<const uint8_t>, size_t&) const noexcept;
+				[[nodiscard]] ObjectView      find(const std::span<const uint8_t>) const noexcept;
+				[[nodiscard]] size_t          size() const noexcept  { return step_vector_.size(); }
+
+			private:
+				struct Step_
+				{
+					std::string key    = {};
+					int64_t     index  = 0;
+					bool        is_key = false;
+				};
 
-			if(value < 0)
-			{
-				if(value >= -32)
+				std::vector<Step_> step_vector_ = {};
+				std::error_code    error_       = Error_None;
+		};
+
+		// }}} Query
+		// {{{ Reader
+
+		class Reader
+		{
+			public:
+				static constexpr size_t Depth_Max = 64;
+
+				enum class Token : uint8_t
+				{	None
+				,	Null
+				,	Bool
+				,	Int
+				,	Uint
+				,	Float
+				,	Double
+				,	Str
+				,	Bin
+				,	Ext
+				,	Array_Begin
+				,	Array_End
+				,	Map_Begin
+				,	Map_End
+				,	Key
+				,	End
+				,	Error
+				};
+
+				explicit Reader(const std::span<const uint8_t>) noexcept;
+
+				template<std::ranges::contiguous_range Range>
+				requires (sizeof(std::ranges::range_value_t<Range>) == 1)
+				explicit Reader(const Range& range) noexcept
+					: Reader(std::span<const uint8_t>((const uint8_t*)std::ranges::data(range), std::ranges::size(range)))
 				{
-					vector.push_back((uint8_t)Format::Fixed_Int_Neg
-						| (uint8_t)(value & Fixed_Int_Neg_Value)
-						);
 				}
-				else if(value >= std::numeric_limits<int8_t>::min())
-				{
-					vector.reserve(vector.size() + 2);
 
-					vector.push_back((uint8_t)Format::Int8);
-					vector.push_back((int8_t)value);
-				}
-				else if(value >= std::numeric_limits<int16_t>::min())
+				[[]]          Token                    next() noexcept;
+				[[]]          std::error_code          skip() noexcept;
+
+				[[nodiscard]] Token                    token() const noexcept    { return key_ ? Token::Key : token_; }
+				[[nodiscard]] Token                    keyToken() const noexcept { return token_;                     }
+				[[nodiscard]] bool                     isKey() const noexcept    { return key_;                       }
+				[[nodiscard]] size_t                   depth() const noexcept    { return depth_;                     }
+				[[nodiscard]] size_t                   index() const noexcept    { return index_;                     }
+				[[nodiscard]] std::error_code          error() const noexcept    { return error_;                     }
+
+				[[nodiscard]] std::span<const uint8_t> asBinary() const noexcept;
+				[[nodiscard]] bool                     asBool() const noexcept;
+				[[nodiscard]] double                   asDouble() const noexcept;
+				[[nodiscard]] ExtView                  asExt() const noexcept;
+				[[nodiscard]] float                    asFloat() const noexcept;
+				[[nodiscard]] int64_t                  asInt() const noexcept;
+				[[nodiscard]] std::string_view         asString() const noexcept;
+				[[nodiscard]] uint64_t                 asUint() const noexcept;
+				[[nodiscard]] size_t                   size() const noexcept;
+
+			private:
+				struct Frame
 				{
-					vector.reserve(vector.size() + 3);
+					uint64_t remaining = 0;
+					bool     map       = false;
+				};
+
+				std::span<const uint8_t>      data_     = {};
+				size_t                        index_    = 0;
+				size_t                        start_    = 0;
+				uint64_t                      value_    = 0;
+				std::error_code               error_    = Error_None;
+				size_t                        depth_    = 0;
+				Token                         token_    = Token::None;
+				int8_t                        ext_type_ = 0;
+				bool                          key_      = false;
+				std::array<Frame, Depth_Max>  stack_    = {};
+		};
 
-					vector.push_back((uint8_t)Format::Int16);
+		// }}} Reader
+		// {{{ Unpacker
 
-					Convert.int16 = (int16_t)value;
-					vector.push_back(Convert_Byte1);
-					vector.push_back(Convert_Byte0);
-				}
-				else if(value >= std::numeric_limits<int32_t>::min())
+		class Unpacker
+		{
+			public:
+				Unpacker() noexcept = default;
+				explicit Unpacker(const Limits&) noexcept;
+
+				[[]]          std::error_code feed(const std::span<const uint8_t>) noexcept;
+				[[nodiscard]] bool            next(Object&) noexcept;
+				[[]]          void            reset() noexcept;
+
+				[[nodiscard]] size_t          available() const noexcept { return ready_.size();                                      }
+				[[nodiscard]] size_t          consumed() const noexcept  { return consumed_;                                          }
+				[[nodiscard]] std::error_code error() const noexcept     { return error_;                                             }
+				[[nodiscard]] bool            pending() const noexcept   { return header_size_ > 0 || payload_ > 0 || !stack_.empty(); }
+
+			private:
+				struct Frame
 				{
-					vector.reserve(vector.size() + 5);
+					Object   object    = {};
+					Object   key       = {};
+					uint64_t remaining = 0;
+					bool     has_key   = false;
+				};
+
+				std::deque<Object>     ready_       = {};
+				std::vector<Frame>     stack_       = {};
+				Limits                 limits_      = {};
+				size_t                 elements_    = 0;
+				size_t                 bytes_       = 0;
+				Object                 value_       = {};
+				uint64_t               payload_     = 0;
+				std::array<uint8_t, 9> header_      = {};
+				size_t                 header_size_ = 0;
+				size_t                 consumed_    = 0;
+				std::error_code        error_       = Error_None;
+
+				void complete_(Object&&) noexcept;
+		};
 
-					vector.push_back((uint8_t)Format::Int32);
+		// }}} Unpacker
+		// {{{ MappedFile
 
-					Convert.int32 = (int32_t)value;
-					vector.push_back(Convert_Byte3);
-					vector.push_back(Convert_Byte2);
-					vector.push_back(Convert_Byte1);
-					vector.push_back(Convert_Byte0);
-				}
-				else if(value >= std::numeric_limits<int64_t>::min())
+		class MappedFile
+		{
+			public:
+				static constexpr size_t Release_Size = 64 * 1024 * 1024;
+
+				class Iterator
 				{
-					vector.reserve(vector.size() + 9);
-
-					vector.push_back((uint8_t)Format::Int64);
-
-					Convert.int64 = (int64_t)value;
-					vector.push_back(Convert_Byte7);
-					vector.push_back(Convert_Byte6);
-					vector.push_back(Convert_Byte5);
-					vector.push_back(Convert_Byte4);
-					vector.push_back(Convert_Byte3);
-					vector.push_back(Convert_Byte2);
-					vector.push_back(Convert_Byte1);
-					vector.push_back(Convert_Byte0);
-				}
-			}
-			else
+					public:
+						using iterator_category = std::forward_iterator_tag;
+						using difference_type   = std::ptrdiff_t;
+						using value_type        = ObjectView;
+						using pointer           = void;
+						using reference         = ObjectView;
+
+						Iterator() noexcept = default;
+
+						ObjectView operator*() const noexcept                      { return ObjectView(data_.subspan(index_, next_ - index_)); }
+						Iterator&  operator++() noexcept;
+						Iterator   operator++(int) noexcept                        { Iterator iter = *this; ++(*this); return iter; }
+						bool       operator==(const Iterator& other) const noexcept { return index_ == other.index_; }
+
+						[[nodiscard]] Object          object(std::pmr::memory_resource* = std::pmr::get_default_resource()) const noexcept;
+						[[nodiscard]] size_t          offset() const noexcept { return index_; }
+						[[nodiscard]] std::error_code error() const noexcept  { return error_; }
+
+					private:
+						friend class MappedFile;
+
+						Iterator(const std::span<const uint8_t>, const size_t) noexcept;
+
+						void check_() noexcept;
+
+						std::span<const uint8_t> data_     = {};
+						size_t                   index_    = 0;
+						size_t                   next_     = 0;
+						size_t                   released_ = 0;
+						std::error_code          error_    = Error_None;
+				};
+
+				MappedFile() noexcept = default;
+				~MappedFile() noexcept;
+
+				MappedFile(const MappedFile&) = delete;
+				MappedFile& operator=(const MappedFile&) = delete;
+				MappedFile(MappedFile&&) noexcept;
+				MappedFile& operator=(MappedFile&&) noexcept;
+
+				[[]]          std::error_code          open(const std::string&) noexcept;
+				[[]]          void                     close() noexcept;
+
+				[[nodiscard]] std::span<const uint8_t> data() const noexcept  { return {memory_, size_};              }
+				[[nodiscard]] size_t                   size() const noexcept  { return size_;                         }
+				[[nodiscard]] Iterator                 begin() const noexcept { return Iterator(data(), 0);           }
+				[[nodiscard]] Iterator                 end() const noexcept   { return Iterator(data(), size_);       }
+
+			private:
+				const uint8_t* memory_ = nullptr;
+				size_t         size_   = 0;
+		};
+
+		// }}} MappedFile
+		// {{{ Fields
+
+		/**
+		 * \internal
+		 *
+		 * \brief A packed field name.
+		 *
+		 * The format of the key is selected and the key is packed when 
+		 * the program is compiled.
+		 */
+		template<size_t Size>
+		struct FieldKey_
+		{
+			std::array<uint8_t, Size + 1> data   = {};
+			size_t                        length = 0;
+
+			constexpr FieldKey_(const char (&name)[Size]) noexcept
 			{
-				if(value <= std::numeric_limits<int8_t>::max())
+				static_assert(Size - 1 <= std::numeric_limits<uint8_t>::max(), "The field name is too long");
+
+				if(Size - 1 < 32)
 				{
-					vector.push_back((int8_t)value);
+					data[length++] = (uint8_t)(0xa0 | (Size - 1));
 				}
-				else if(value <= std::numeric_limits<int16_t>::max())
+				else
 				{
-					vector.reserve(vector.size() + 3);
-
-					vector.push_back((uint8_t)Format::Int16);
-
-					Convert.int16 = (int16_t)value;
-					vector.push_back(Convert_Byte1);
-					vector.push_back(Convert_Byte0);
+					data[length++] = 0xd9;
+					data[length++] = (uint8_t)(Size - 1);
 				}
-				else if(value <= std::numeric_limits<int32_t>::max())
-				{
-					vector.reserve(vector.size() + 5);
 
-					vector.push_back((uint8_t)Format::Int32);
-
-					Convert.int32 = (int32_t)value;
-					vector.push_back(Convert_Byte3);
-					vector.push_back(Convert_Byte2);
-					vector.push_back(Convert_Byte1);
-					vector.push_back(Convert_Byte0);
-				}
-				else if(value <= std::numeric_limits<int64_t>::max())
+				for(size_t i = 0; i + 1 < Size; i++)
 				{
-					vector.reserve(vector.size() + 9);
-
-					vector.push_back((uint8_t)Format::Int64);
-
-					Convert.int64 = (int64_t)value;
-					vector.push_back(Convert_Byte7);
-					vector.push_back(Convert_Byte6);
-					vector.push_back(Convert_Byte5);
-					vector.push_back(Convert_Byte4);
-					vector.push_back(Convert_Byte3);
-					vector.push_back(Convert_Byte2);
-					vector.push_back(Convert_Byte1);
-					vector.push_back(Convert_Byte0);
+					data[length++] = (uint8_t)name[i];
 				}
 			}
 
-			return Error_None;
-		}
-		
-		if(object.is<uint64_t>())
+			[[nodiscard]] constexpr std::span<const uint8_t> span() const noexcept
+			{
+				return {data.data(), length};
+			}
+		};
+
+
+		template<typename T>
+		concept FieldString_ = std::is_class_v<T>
+			&& std::is_convertible_v<const T&, std::string_view>
+			;
+
+		template<typename T>
+		concept FieldBinary_ = std::ranges::contiguous_range<T>
+			&& std::is_same_v<std::ranges::range_value_t<T>, uint8_t>
+			;
+
+		template<typename T>
+		concept FieldOptional_ = requires(T& value)
 		{
-			const uint64_t value = object.as<uint64_t>();
+			value.has_value();
+			value.reset();
+			value.emplace();
+			*value;
+		};
 
-			if(value <= std::numeric_limits<uint8_t>::max())
-			{
-				vector.reserve(vector.size() + 2);
 
-				vector.push_back((uint8_t)Format::Uint8);
-				vector.push_back((uint8_t)value);
+		/**
+		 * \internal
+		 *
+		 * \brief Pack the value of a field.
+		 *
+		 * \return An error code.
+		 */
+		template<typename T>
+		std::error_code fieldEncode_(Packer& packer
+			, const T&                   value
+			) noexcept
+		{
+			if constexpr(std::is_same_v<T, bool>)
+			{
+				return packer.packBool(value);
 			}
-			else if(value <= std::numeric_limits<uint16_t>::max())
+			else if constexpr(std::is_enum_v<T>)
 			{
-				vector.reserve(vector.size() + 3);
-
-				vector.push_back((uint8_t)Format::Uint16);
+				return fieldEncode_(packer, static_cast<std::underlying_type_t<T>>(value));
+			}
+			else if constexpr(std::is_integral_v<T> && std::is_signed_v<T>)
+			{
+				return packer.packInt(value);
+			}
+			else if constexpr(std::is_integral_v<T>)
+			{
+				return packer.packUint(value);
+			}
+			else if constexpr(std::is_same_v<T, float>)
+			{
+				return packer.packFloat(value);
+			}
+			else if constexpr(std::is_same_v<T, double>)
+			{
+				return packer.packDouble(value);
+			}
+			else if constexpr(FieldString_<T>)
+			{
+				return packer.packStr(value);
+			}
+			else if constexpr(FieldBinary_<const T>)
+			{
+				return packer.packBin(std::span<const uint8_t>(std::ranges::data(value), std::ranges::size(value)));
+			}
+			else if constexpr(FieldOptional_<T>)
+			{
+				if(value.has_value())
+				{
+					return fieldEncode_(packer, *value);
+				}
 
-				Convert.uint16 = (uint16_t)value;
-				vector.push_back(Convert_Byte1);
-				vector.push_back(Convert_Byte0);
+				return packer.packNull();
+			}
+			else if constexpr(requires { encode(value, packer); })
+			{
+				return encode(value, packer);
 			}
-			else if(value <= std::numeric_limits<uint32_t>::max())
+			else if constexpr(std::ranges::sized_range<const T>)
 			{
-				vector.reserve(vector.size() + 5);
+				packer.packArrayHeader(std::ranges::size(value));
 
-				vector.push_back((uint8_t)Format::Uint32);
+				for(const auto& element : value)
+				{
+					fieldEncode_(packer, element);
+				}
 
-				Convert.uint32 = (uint32_t)value;
-				vector.push_back(Convert_Byte3);
-				vector.push_back(Convert_Byte2);
-				vector.push_back(Convert_Byte1);
-				vector.push_back(Convert_Byte0);
+				return packer.error();
 			}
 			else
 			{
-				vector.reserve(vector.size() + 9);
-
-				vector.push_back((uint8_t)Format::Uint64);
-
-				Convert.uint64 = value;
-				vector.push_back(Convert_Byte7);
-				vector.push_back(Convert_Byte6);
-				vector.push_back(Convert_Byte5);
-				vector.push_back(Convert_Byte4);
-				vector.push_back(Convert_Byte3);
-				vector.push_back(Convert_Byte2);
-				vector.push_back(Convert_Byte1);
-				vector.push_back(Convert_Byte0);
+				static_assert(sizeof(T) == 0, "The field type can not be packed");
 			}
-
-			return Error_None;
 		}
-		
-		if(object.is<float>())
-		{
-			float value = object.as<float>();
 
-			vector.reserve(vector.size() + 5);
 
-			vector.push_back((uint8_t)Format::Float32);
+		/**
+		 * \internal
+		 *
+		 * \brief Decode the value of a field.
+		 *
+		 * The current token of the \p reader is the value.
+		 *
+		 * \return An error code.
+		 */
+		template<typename T>
+		std::error_code fieldDecode_(Reader& reader
+			, T&                         value
+			) noexcept
+		{
+			using Token = Reader::Token;
 
-			Convert.float32 = value;
-			vector.push_back(Convert_Byte3);
-			vector.push_back(Convert_Byte2);
-			vector.push_back(Convert_Byte1);
-			vector.push_back(Convert_Byte0);
+			const Token token = reader.token();
 
-			return Error_None;
-		}
-		
-		if(object.is<double>())
-		{
-			double value = object.as<double>();
+			if(token == Token::Error)
+			{
+				return reader.error();
+			}
 
-			vector.push_back((uint8_t)Format::Float64);
+			if constexpr(std::is_same_v<T, bool>)
+			{
+				if(token != Token::Bool)
+				{
+					return Error_Type_Mismatch;
+				}
 
-			Convert.float64 = value;
-			vector.push_back(Convert_Byte7);
-			vector.push_back(Convert_Byte6);
-			vector.push_back(Convert_Byte5);
-			vector.push_back(Convert_Byte4);
-			vector.push_back(Convert_Byte3);
-			vector.push_back(Convert_Byte2);
-			vector.push_back(Convert_Byte1);
-			vector.push_back(Convert_Byte0);
+				value = reader.asBool();
+			}
+			else if constexpr(std::is_enum_v<T>)
+			{
+				std::underlying_type_t<T> integer = {};
 
-			return Error_None;
-		}
-		
-		if(object.isString())
-		{
-			const std::string& value = object.asString();
+				std::error_code error = fieldDecode_(reader, integer);
 
-			const size_t string_length = value.size();
+				if(error)
+				{
+					return error;
+				}
 
-			if(string_length <= 31)
+				value = static_cast<T>(integer);
+			}
+			else if constexpr(std::is_integral_v<T>)
 			{
-				vector.reserve(string_length + 1);
+				// std::in_range() does not accept character types
+				using Integer = std::conditional_t<std::is_signed_v<T>
+					, std::make_signed_t<T>
+					, std::make_unsigned_t<T>
+					>;
 
-				vector.push_back((uint8_t)Format::Fixed_Str
-					| (uint8_t)string_length
-					);
+				if(token == Token::Int && std::in_range<Integer>(reader.asInt()))
+				{
+					value = (T)reader.asInt();
+				}
+				else if(token == Token::Uint && std::in_range<Integer>(reader.asUint()))
+				{
+					value = (T)reader.asUint();
+				}
+				else
+				{
+					return Error_Type_Mismatch;
+				}
+			}
+			else if constexpr(std::is_floating_point_v<T>)
+			{
+				switch(token)
+				{
+					case Token::Float:  value = (T)reader.asFloat();  break;
+					case Token::Double: value = (T)reader.asDouble(); break;
+					case Token::Int:    value = (T)reader.asInt();    break;
+					case Token::Uint:   value = (T)reader.asUint();   break;
+					default:            return Error_Type_Mismatch;
+				}
+			}
+			else if constexpr(FieldString_<T>)
+			{
+				if(token != Token::Str)
+				{
+					return Error_Type_Mismatch;
+				}
 
-				for(const auto& c : value)
+				if constexpr(std::is_same_v<T, std::string_view>)
+				{
+					value = reader.asString();
+				}
+				else
 				{
-					vector.push_back((uint8_t)c);
+					const std::string_view string = reader.asString();
+
+					value.assign(string.data(), string.size());
 				}
 			}
-			else if(string_length <= std::numeric_limits<uint8_t>::max())
+			else if constexpr(FieldBinary_<T>)
 			{
-				vector.reserve(string_length + 2);
+				if(token != Token::Bin)
+				{
+					return Error_Type_Mismatch;
+				}
 
-				vector.push_back((uint8_t)Format::Str8);
-				vector.push_back((uint8_t)string_length);
+				const std::span<const uint8_t> binary = reader.asBinary();
 
-				for(const auto& c : value)
+				if constexpr(std::is_assignable_v<T&, std::span<const uint8_t>>)
+				{
+					value = binary;
+				}
+				else if constexpr(requires { value.assign(binary.begin(), binary.end()); })
 				{
-					vector.push_back((uint8_t)c);
+					value.assign(binary.begin(), binary.end());
+				}
+				else
+				{
+					if(binary.size() != std::ranges::size(value))
+					{
+						return Error_Type_Mismatch;
+					}
+
+					std::ranges::copy(binary, std::ranges::begin(value));
 				}
 			}
-			else if(string_length <= std::numeric_limits<uint16_t>::max())
+			else if constexpr(FieldOptional_<T>)
 			{
-				vector.reserve(string_length + 3);
+				if(token == Token::Null)
+				{
+					value.reset();
 
-				vector.push_back((uint8_t)Format::Str16);
+					return Error_None;
+				}
+
+				typename T::value_type element = {};
 
-				Convert.uint16 = (uint16_t)string_length;
-				vector.push_back(Convert_Byte1);
-				vector.push_back(Convert_Byte0);
+				std::error_code error = fieldDecode_(reader, element);
 
-				for(const auto& c : value)
+				if(error)
 				{
-					vector.push_back((uint8_t)c);
+					return error;
 				}
+
+				value = std::move(element);
 			}
-			else if(string_length <= std::numeric_limits<uint32_t>::max())
+			else if constexpr(requires { decode(reader, value); })
 			{
-				vector.reserve(string_length + 5);
+				return decode(reader, value);
+			}
+			else if constexpr(requires { value.clear(); value.emplace_back(); })
+			{
+				if(token != Token::Array_Begin)
+				{
+					return Error_Type_Mismatch;
+				}
 
-				vector.push_back((uint8_t)Format::Str32);
+				const size_t size = reader.size();
 
-				Convert.uint32 = (uint32_t)string_length;
-				vector.push_back(Convert_Byte3);
-				vector.push_back(Convert_Byte2);
-				vector.push_back(Convert_Byte1);
-				vector.push_back(Convert_Byte0);
+				value.clear();
 
-				for(const auto& c : value)
+				for(size_t i = 0; i < size; i++)
 				{
-					vector.push_back((uint8_t)c);
-				}
-			}
+					reader.next();
 
-			return Error_None;
-		}
-		
-		if(object.isBinary())
-		{
-			const std::vector<uint8_t>& value = object.asBinary();
+					std::error_code error = fieldDecode_(reader, value.emplace_back());
 
-			const size_t vector_length = value.size();
+					if(error)
+					{
+						return error;
+					}
+				}
 
-			if(vector_length <= std::numeric_limits<uint8_t>::max())
+				reader.next();
+			}
+			else if constexpr(requires { std::tuple_size<T>::value; })
 			{
-				vector.reserve(vector_length + 2);
+				if(token != Token::Array_Begin || reader.size() != std::tuple_size<T>::value)
+				{
+					return Error_Type_Mismatch;
+				}
+
+				for(auto& element : value)
+				{
+					reader.next();
+
+					std::error_code error = fieldDecode_(reader, element);
 
-				vector.push_back((uint8_t)Format::Bin8);
-				vector.push_back((uint8_t)vector_length);
+					if(error)
+					{
+						return error;
+					}
+				}
 
-				vector.insert(vector.end()
-					, value.begin()
-					, value.end()
-					);
+				reader.next();
 			}
-			else if(vector_length <= std::numeric_limits<uint16_t>::max())
+			else
 			{
-				vector.reserve(vector_length + 3);
+				static_assert(sizeof(T) == 0, "The field type can not be decoded");
+			}
+
+			return reader.error();
+		}
 
-				vector.push_back((uint8_t)Format::Bin16);
 
-				Convert.uint16 = (uint16_t)vector_length;
-				vector.push_back(Convert_Byte1);
-				vector.push_back(Convert_Byte0);
+		/**
+		 * \internal
+		 *
+		 * \brief Decode a Map of fields.
+		 *
+		 * The current token of the \p reader must be the beginning of a 
+		 * Map. The \p field function is called with the key, when the 
+		 * current token is the value.
+		 *
+		 * \return An error code.
+		 */
+		template<typename Function>
+		std::error_code fieldMapDecode_(Reader& reader
+			, Function&&                        field
+			) noexcept
+		{
+			using Token = Reader::Token;
 
-				vector.insert(vector.end()
-					, value.begin()
-					, value.end()
-					);
+			switch(reader.token())
+			{
+				case Token::Map_Begin: break;
+				case Token::Error:     return reader.error();
+				case Token::End:       return Error_No_Data;
+				default:               return Error_Type_Mismatch;
 			}
-			else if(vector_length <= std::numeric_limits<uint32_t>::max())
+
+			while(reader.next() == Token::Key)
 			{
-				vector.reserve(vector_length + 5);
+				const std::string_view key = reader.asString();
 
-				vector.push_back((uint8_t)Format::Bin32);
+				reader.next();
 
-				Convert.uint32 = (uint32_t)vector_length;
-				vector.push_back(Convert_Byte3);
-				vector.push_back(Convert_Byte2);
-				vector.push_back(Convert_Byte1);
-				vector.push_back(Convert_Byte0);
+				std::error_code error = field(key);
 
-				vector.insert(vector.end()
-					, value.begin()
-					, value.end()
-					);
+				if(error)
+				{
+					return error;
+				}
 			}
 
-			return Error_None;
+			return reader.error();
 		}
-		
-		if(object.isArray())
-		{
-			const messagepack::Array& array = object.asArray();
 
-			std::error_code error = serialize_(array, vector);
 
-			return error;
-		}
-		
-		if(object.isExt())
+		/**
+		 * \internal
+		 *
+		 * \brief Skip a value that is not a field.
+		 *
+		 * \return An error code.
+		 */
+		inline std::error_code fieldSkip_(Reader& reader
+			) noexcept
 		{
-			const messagepack::Ext& ext = object.asExt();
+			return reader.skip();
+		}
+
+		// }}} Fields
+		// {{{ Extensions
 
-			std::error_code error = serialize_(ext, vector);
+		[[nodiscard]] bool            extensionTimestampCheck(const Object&) noexcept;
+		[[nodiscard]] struct timespec extensionTimestampConvert(const Object&) noexcept;
+		[[nodiscard]] Object          extensionTimestampConvert(const struct timespec&) noexcept;
 
-			return error;
+		constexpr int8_t Extension_Typed_Array = 127;
+
+		[[nodiscard]] bool            extensionTypedArrayCheck(const Object&) noexcept;
+		[[nodiscard]] bool            extensionTypedArrayCheck(const ExtView&) noexcept;
+
+		[[nodiscard]] Object          extensionTypedArrayCreate_(const uint8_t, const std::span<const std::byte>) noexcept;
+		[[nodiscard]] std::error_code extensionTypedArrayData_(const int8_t, const std::span<const uint8_t>, const uint8_t, std::span<const uint8_t>&) noexcept;
+		[[]]          void            extensionTypedArrayCopy_(const std::span<const uint8_t>, const size_t, uint8_t*) noexcept;
+
+
+		/**
+		 * \brief Create a Typed Array extension.
+		 *
+		 * The \p value will be copied into an Ext. Use 
+		 * Packer::packTypedArray() to pack the values without creating an 
+		 * Object.
+		 *
+		 * \parcode
+		 * std::vector<float> sample = sensor.read();
+		 *
+		 * zakero::messagepack::Object object =
+		 * 	zakero::messagepack::extensionTypedArrayCreate<float>(sample);
+		 * \endparcode
+		 *
+		 * \return A MessagePack Object.
+		 */
+		template<TypedArrayElement_ T>
+		[[nodiscard]] Object extensionTypedArrayCreate(const std::span<const T> value ///< The values
+			) noexcept
+		{
+			return extensionTypedArrayCreate_(typedArrayElement_<T>(), std::as_bytes(value));
 		}
-		
-		if(object.isMap())
+
+
+		/**
+		 * \brief View the values of a Typed Array extension.
+		 *
+		 * The returned span refers directly to the extension data, no 
+		 * values are copied. The span will be empty if:
+		 * - The \p ext is not a Typed Array of `T`
+		 * - The values are not aligned for `T` in memory
+		 * - The CPU is not little-endian
+		 *
+		 * Use extensionTypedArrayConvert() when the values must be 
+		 * available in all of those cases.
+		 *
+		 * \parcode
+		 * zakero::messagepack::ObjectView view(data);
+		 *
+		 * for(const float value : zakero::messagepack::extensionTypedArrayView<float>(view.asExt()))
+		 * {
+		 * 	sum += value;
+		 * }
+		 * \endparcode
+		 *
+		 * \return The values.
+		 */
+		template<TypedArrayElement_ T>
+		[[nodiscard]] std::span<const T> extensionTypedArrayView(const ExtView& ext ///< The extension
+			) noexcept
 		{
-			const messagepack::Map& map = object.asMap();
+			std::span<const uint8_t> data;
 
-			std::error_code error = serialize_(map, vector);
+			if(std::endian::native != std::endian::little
+				|| extensionTypedArrayData_(ext.type, ext.data, typedArrayElement_<T>(), data)
+				|| ((uintptr_t)data.data() % alignof(T)) != 0
+				)
+			{
+				return {};
+			}
 
-			return error;
+			return {(const T*)data.data(), data.size() / sizeof(T)};
 		}
 
-		return Error_Invalid_Format_Type;
-	}
-
-
-	/**
-	 * \brief Serialize a MessagePack Array.
-	 *
-	 * The provided \p array will be serialized into a byte-code which will 
-	 * be appended onto the \p vector.
-	 *
-	 * \return An error code.
-	 */
-	std::error_code serialize_(const messagepack::Array& array  ///< The Array to serialize
-		, std::vector<uint8_t>&                      vector ///< Where to store the Array
-		) noexcept
-	{
-		const size_t array_size = array.size();
-
-		if(array_size < 16)
-		{
-			vector.push_back((uint8_t)Format::Fixed_Array
-				| (uint8_t)array_size
-				);
-		}
-		else if(array_size <= std::numeric_limits<uint16_t>::max())
-		{
-			vector.push_back((uint8_t)Format::Array16);
-
-			Convert.uint16 = (uint16_t)array_size;
-			vector.push_back(Convert_Byte1);
-			vector.push_back(Convert_Byte0);
-		}
-		else if(array_size <= std::numeric_limits<uint32_t>::max())
-		{
-			vector.push_back((uint8_t)Format::Array32);
-
-			Convert.uint32 = (uint32_t)array_size;
-			vector.push_back(Convert_Byte3);
-			vector.push_back(Convert_Byte2);
-			vector.push_back(Convert_Byte1);
-			vector.push_back(Convert_Byte0);
-		}
-		else
-		{
-			return Error_Array_Too_Big;
-		}
 
-		for(const messagepack::Object& object : array.object_vector)
+		/**
+		 * \brief View the values of a Typed Array extension.
+		 *
+		 * \copydetails extensionTypedArrayView(const ExtView&)
+		 */
+		template<TypedArrayElement_ T>
+		[[nodiscard]] std::span<const T> extensionTypedArrayView(const Object& object ///< The extension
+			) noexcept
 		{
-			std::error_code error = serialize_(object, vector);
-
-			if(error)
+			if(object.isExt() == false)
 			{
-				return error;
+				return {};
 			}
-		}
-
-		return Error_None;
-	}
-
-
-	/**
-	 * \brief Serialize a MessagePack Extension.
-	 *
-	 * The provided \p array will be serialized into a byte-code which will 
-	 * be appended onto the \p vector.
-	 *
-	 * \return An error code.
-	 */
-	std::error_code serialize_(const messagepack::Ext& ext    ///< The Extension to serialize
-		, std::vector<uint8_t>&                    vector ///< Where to store the Extension
-		) noexcept
-	{
-		const size_t data_size = ext.data.size();
-
-		if(data_size == 1)
-		{
-			vector.push_back((uint8_t)Format::Fixed_Ext1);
-		}
-		else if(data_size == 2)
-		{
-			vector.push_back((uint8_t)Format::Fixed_Ext2);
-		}
-		else if(data_size == 4)
-		{
-			vector.push_back((uint8_t)Format::Fixed_Ext4);
-		}
-		else if(data_size == 8)
-		{
-			vector.push_back((uint8_t)Format::Fixed_Ext8);
-		}
-		else if(data_size == 16)
-		{
-			vector.push_back((uint8_t)Format::Fixed_Ext16);
-		}
-		else if(data_size == 0
-			|| data_size <= std::numeric_limits<uint8_t>::max()
-			)
-		{
-			vector.push_back((uint8_t)Format::Ext8);
-			vector.push_back((uint8_t)data_size);
-		}
-		else if(data_size <= std::numeric_limits<uint16_t>::max())
-		{
-			vector.push_back((uint8_t)Format::Ext16);
-
-			Convert.uint64 = data_size;
-			vector.push_back(Convert_Byte1);
-			vector.push_back(Convert_Byte0);
-		}
-		else if(data_size <= std::numeric_limits<uint32_t>::max())
-		{
-			vector.push_back((uint8_t)Format::Ext32);
-
-			Convert.uint64 = data_size;
-			vector.push_back(Convert_Byte3);
-			vector.push_back(Convert_Byte2);
-			vector.push_back(Convert_Byte1);
-			vector.push_back(Convert_Byte0);
-		}
-		else
-		{
-			return Error_Ext_Too_Big;
-		}
 
-		Convert.uint64 = 0;
-		Convert.int8   = ext.type;
-		vector.push_back(Convert.uint8);
+			const Ext& ext = object.asExt();
 
-		if(data_size > 0)
-		{
-			size_t index = vector.size();
-			vector.resize(vector.size() + data_size);
-			memcpy((void*)(vector.data() + index), (void*)ext.data.data(), data_size);
-		}
-
-		return Error_None;
-	}
-
-
-	/**
-	 * \brief Serialize a MessagePack Map.
-	 *
-	 * The provided \p map will be serialized into a byte-code which will 
-	 * be appended onto the \p vector.
-	 *
-	 * \return An error code.
-	 */
-	std::error_code serialize_(const messagepack::Map& map    ///< The Map to serialize
-		, std::vector<uint8_t>&                    vector ///< Where to store the Map
-		) noexcept
-	{
-		const size_t map_size = map.size();
-
-		if(map_size < 16)
-		{
-			vector.push_back((uint8_t)Format::Fixed_Map
-				| (uint8_t)map_size
-				);
-		}
-		else if(map_size <= std::numeric_limits<uint16_t>::max())
-		{
-			vector.push_back((uint8_t)Format::Map16);
-
-			Convert.uint16 = (uint16_t)map_size;
-			vector.push_back(Convert_Byte1);
-			vector.push_back(Convert_Byte0);
+			return extensionTypedArrayView<T>(ExtView{ext.data, ext.type});
 		}
-		else if(map_size <= std::numeric_limits<uint32_t>::max())
-		{
-			vector.push_back((uint8_t)Format::Map32);
 
-			Convert.uint32 = (uint32_t)map_size;
-			vector.push_back(Convert_Byte3);
-			vector.push_back(Convert_Byte2);
-			vector.push_back(Convert_Byte1);
-			vector.push_back(Convert_Byte0);
-		}
-		else
-		{
-			return Error_Map_Too_Big;
-		}
-			
-		std::error_code error = Error_None;
 
-		if(map.null_map.empty() == false)
+		/**
+		 * \brief Copy the values of a Typed Array extension.
+		 *
+		 * The values are copied from the extension data and converted to 
+		 * the byte order of the CPU. If the \p ext is not a Typed Array 
+		 * of `T`, the returned vector will be empty.
+		 *
+		 * \return The values.
+		 */
+		template<TypedArrayElement_ T>
+		[[nodiscard]] std::vector<T> extensionTypedArrayConvert(const ExtView& ext ///< The extension
+			) noexcept
 		{
-			error = serialize_(Object{}, vector);
-
-			if(error)
-			{
-				return error;
-			}
+			std::span<const uint8_t> data;
 
-			error = serialize_(map.null_map[0], vector);
-
-			if(error)
+			if(extensionTypedArrayData_(ext.type, ext.data, typedArrayElement_<T>(), data))
 			{
-				return error;
+				return {};
 			}
-		}
-
-		for(const auto& [key, value] : map.bool_map)
-		{
-			error = serialize_(Object{key}, vector);
 
-			if(error)
-			{
-				return error;
-			}
+			std::vector<T> vector(data.size() / sizeof(T));
 
-			error = serialize_(value, vector);
+			extensionTypedArrayCopy_(data, sizeof(T), (uint8_t*)vector.data());
 
-			if(error)
-			{
-				return error;
-			}
+			return vector;
 		}
 
-		for(const auto& [key, value] : map.int64_map)
-		{
-			error = serialize_(Object{key}, vector);
-
-			if(error)
-			{
-				return error;
-			}
-
-			error = serialize_(value, vector);
-
-			if(error)
-			{
-				return error;
-			}
-		}
 
-		for(const auto& [key, value] : map.uint64_map)
+		/**
+		 * \brief Copy the values of a Typed Array extension.
+		 *
+		 * \copydetails extensionTypedArrayConvert(const ExtView&)
+		 */
+		template<TypedArrayElement_ T>
+		[[nodiscard]] std::vector<T> extensionTypedArrayConvert(const Object& object ///< The extension
+			) noexcept
 		{
-			error = serialize_(Object{key}, vector);
-
-			if(error)
+			if(object.isExt() == false)
 			{
-				return error;
+				return {};
 			}
 
-			error = serialize_(value, vector);
+			const Ext& ext = object.asExt();
 
-			if(error)
-			{
-				return error;
-			}
+			return extensionTypedArrayConvert<T>(ExtView{ext.data, ext.type});
 		}
 
-		for(const auto& [key, value] : map.float_map)
-		{
-			error = serialize_(Object{key}, vector);
-
-			if(error)
-			{
-				return error;
-			}
-
-			error = serialize_(value, vector);
-
-			if(error)
-			{
-				return error;
-			}
-		}
+		// }}} Extensions
+		// {{{ Utilities
 
-		for(const auto& [key, value] : map.double_map)
-		{
-			error = serialize_(Object{key}, vector);
+		[[nodiscard]] Object               deserialize(const std::vector<uint8_t>&) noexcept;
+		[[nodiscard]] Object               deserialize(const std::vector<uint8_t>&, std::error_code&) noexcept;
+		[[nodiscard]] Object               deserialize(const std::vector<uint8_t>&, size_t&) noexcept;
+		[[nodiscard]] Object               deserialize(const std::vector<uint8_t>&, size_t&, std::error_code&) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>, size_t&, std::error_code&) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>, std::pmr::memory_resource*) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, std::pmr::memory_resource*) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, const Limits&) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, const Limits&, std::pmr::memory_resource*) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, KeyCache&) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, const Limits&, KeyCache*, std::pmr::memory_resource*) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, ShapeCache&) noexcept;
+		[[nodiscard]] Object               deserialize(const std::span<const uint8_t>, size_t&, std::error_code&, const Limits&, KeyCache*, ShapeCache*, std::pmr::memory_resource*) noexcept;
+		[[nodiscard]] std::error_code      deserializeBatch(const std::span<const uint8_t>, std::vector<Object>&, size_t = 0) noexcept;
+		[[nodiscard]] std::error_code      deserializeBatch(const std::span<const uint8_t>, size_t&, std::vector<Object>&, size_t = 0) noexcept;
+		[[nodiscard]] ObjectView           find(const std::span<const uint8_t>, const std::string_view) noexcept;
+		[[nodiscard]] std::error_code      fromJson(const std::string_view, Packer&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> fromJson(const std::string_view, std::error_code&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Array&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Array&, std::error_code&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Array&, std::error_code&, const size_t) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Ext&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Ext&, std::error_code&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Map&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Map&, std::error_code&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Map&, std::error_code&, const size_t) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Object&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Object&, std::error_code&) noexcept;
+		[[nodiscard]] std::vector<uint8_t> serialize(const messagepack::Object&, std::error_code&, const size_t) noexcept;
+		[[nodiscard]] std::error_code      serialize(const messagepack::Object&, std::vector<uint8_t>&, std::vector<struct iovec>&) noexcept;
+		[[nodiscard]] size_t               serializedSize(const messagepack::Array&) noexcept;
+		[[nodiscard]] size_t               serializedSize(const messagepack::Ext&) noexcept;
+		[[nodiscard]] size_t               serializedSize(const messagepack::Map&) noexcept;
+		[[nodiscard]] size_t               serializedSize(const messagepack::Object&) noexcept;
+		[[nodiscard]] std::error_code      skip(const std::span<const uint8_t>, size_t&) noexcept;
+		[[nodiscard]] std::error_code      toJson(const std::span<const uint8_t>, const JsonSink&, const JsonOptions& = {}) noexcept;
+		[[nodiscard]] std::error_code      toJson(const std::span<const uint8_t>, size_t&, const JsonSink&, const JsonOptions& = {}) noexcept;
+		[[nodiscard]] std::string          toJson(const std::span<const uint8_t>, std::error_code&, const JsonOptions& = {}) noexcept;
+		[[nodiscard]] std::string          to_string(const messagepack::Array&) noexcept;
+		[[nodiscard]] std::string          to_string(const messagepack::Ext&) noexcept;
+		[[nodiscard]] std::string          to_string(const messagepack::Map&) noexcept;
+		[[nodiscard]] std::string          to_string(const messagepack::Object&) noexcept;
+		[[nodiscard]] std::error_code      validate(const std::span<const uint8_t>) noexcept;
 
-			if(error)
-			{
-				return error;
-			}
+		// }}} Utilities
+} // zakero::messagepack
 
-			error = serialize_(value, vector);
+// {{{ Operators
 
-			if(error)
-			{
-				return error;
-			}
-		}
+std::ostream& operator<<(std::ostream&, const zakero::messagepack::Array&) noexcept;
+std::ostream& operator<<(std::ostream&, const zakero::messagepack::Ext&) noexcept;
+std::ostream& operator<<(std::ostream&, const zakero::messagepack::Map&) noexcept;
+std::ostream& operator<<(std::ostream&, const zakero::messagepack::Object&) noexcept;
 
-		for(const auto& [key, value] : map.string_map)
-		{
-			error = serialize_(Object{key}, vector);
+bool operator==(const zakero::messagepack::Object& lhs, const zakero::messagepack::Object& rhs) noexcept;
+bool operator!=(const zakero::messagepack::Object& lhs, const zakero::messagepack::Object& rhs) noexcept;
 
-			if(error)
-			{
-				return error;
-			}
+// }}}
+// {{{ Implementation
 
-			error = serialize_(value, vector);
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION
 
-			if(error)
-			{
-				return error;
-			}
-		}
+// {{{ Macros
+// {{{ Macros : Doxygen
 
-		return Error_None;
-	}
-}
+#ifdef ZAKERO__DOXYGEN_DEFINE_DOCS
 
-// }}}
-// {{{ Error
+// Only used for generating Doxygen documentation
 
 /**
- * \class ErrorCategary_
+ * \brief Activate the implementation code.
  *
- * \brief Error categories.
+ * Defining this macro will cause the zakero::MessagePack implementation to be 
+ * included. This should only be done once, since compiler and/or linker errors 
+ * will typically be generated if more than a single implementation is found.
  *
- * This class holds all the error categories for the error codes. The data in 
- * this class is built from the ZAKERO_MESSAGEPACK__ERROR_DATA macro.
+ * \note It does not matter if the macro is given a value or not, only its 
+ * existence is checked.
  */
-
+#define ZAKERO_MESSAGEPACK_IMPLEMENTATION
 
 /**
- * \fn ErrorCategory_::ErrorCategory_()
+ * \def X(name_, val_, mesg_)
  *
- * \brief Constructor
+ * \brief Generate Code.
  */
 
+#endif
 
-/**
- * \brief The name of the error category.
- * 
- * \return A C-Style string.
- */
-const char* ErrorCategory_::name() const noexcept
-{
-	return "zakero::messagepack";
-}
-
+// }}}
 
 /**
- * \brief A description message.
+ * \internal
  *
- * \return The message.
- */
-std::string ErrorCategory_::message(int condition ///< The error code.
-	) const noexcept
-{
-	switch(condition)
-	{
-#define X(name_, val_, mesg_) \
-		case val_: return mesg_;
-		ZAKERO_MESSAGEPACK__ERROR_DATA
-#undef X
-	}
-
-	return "Unknown error condition";
-}
-
-
-/**
- * \brief A single instance.
+ * \brief Format Data
  *
- * This one instance will be used by all error codes.
+ * This X-Macro table contains:
+ * - The internal format type name
+ * - The type id
+ * - A type id mask (the bit-wise complement is used to get the value)
+ * - The minimum size of the format, including the ID byte
+ * - The type spec name
  */
-ErrorCategory_ ErrorCategory;
-
-// }}}
-// {{{ Array
-
+#define ZAKERO_MESSAGEPACK__FORMAT_TYPE \
+	/* Variable       Id          Mask          Size      Name         */ \
+	X(Fixed_Int_Pos , 0x00      , 0b10000000  , 1      , "positive fixint" ) \
+	X(Fixed_Map     , 0x80      , 0b11110000  , 1      , "fixmap"          ) \
+	X(Fixed_Array   , 0x90      , 0b11110000  , 1      , "fixarray"        ) \
+	X(Fixed_Str     , 0xa0      , 0b11100000  , 1      , "fixstr"          ) \
+	X(Nill          , 0xc0      , 0b11111111  , 1      , "nill"            ) \
+	X(Never_Used    , 0xc1      , 0b11111111  , 1      , "(never used)"    ) \
+	X(False         , 0xc2      , 0b11111111  , 1      , "false"           ) \
+	X(True          , 0xc3      , 0b11111111  , 1      , "true"            ) \
+	X(Bin8          , 0xc4      , 0b11111111  , 2      , "bin 8"           ) \
+	X(Bin16         , 0xc5      , 0b11111111  , 259    , "bin 16"          ) \
+	X(Bin32         , 0xc6      , 0b11111111  , 65541  , "bin 32"          ) \
+	X(Ext8          , 0xc7      , 0b11111111  , 3      , "ext 8"           ) \
+	X(Ext16         , 0xc8      , 0b11111111  , 260    , "ext 16"          ) \
+	X(Ext32         , 0xc9      , 0b11111111  , 65542  , "ext 32"          ) \
+	X(Float32       , 0xca      , 0b11111111  , 5      , "float 32"        ) \
+	X(Float64       , 0xcb      , 0b11111111  , 9      , "float 64"        ) \
+	X(Uint8         , 0xcc      , 0b11111111  , 2      , "uint 8"          ) \
+	X(Uint16        , 0xcd      , 0b11111111  , 3      , "uint 16"         ) \
+	X(Uint32        , 0xce      , 0b11111111  , 5      , "uint 32"         ) \
+	X(Uint64        , 0xcf      , 0b11111111  , 9      , "uint 64"         ) \
+	X(Int8          , 0xd0      , 0b11111111  , 2      , "int 8"           ) \
+	X(Int16         , 0xd1      , 0b11111111  , 3      , "int 16"          ) \
+	X(Int32         , 0xd2      , 0b11111111  , 5      , "int 32"          ) \
+	X(Int64         , 0xd3      , 0b11111111  , 9      , "int 64"          ) \
+	X(Fixed_Ext1    , 0xd4      , 0b11111111  , 3      , "fixext 1"        ) \
+	X(Fixed_Ext2    , 0xd5      , 0b11111111  , 4      , "fixext 2"        ) \
+	X(Fixed_Ext4    , 0xd6      , 0b11111111  , 6      , "fixext 4"        ) \
+	X(Fixed_Ext8    , 0xd7      , 0b11111111  , 10     , "fixext 8"        ) \
+	X(Fixed_Ext16   , 0xd8      , 0b11111111  , 18     , "fixext 16"       ) \
+	X(Str8          , 0xd9      , 0b11111111  , 34     , "str 8"           ) \
+	X(Str16         , 0xda      , 0b11111111  , 259    , "str 16"          ) \
+	X(Str32         , 0xdb      , 0b11111111  , 65541  , "str 32"          ) \
+	X(Array16       , 0xdc      , 0b11111111  , 19     , "array 16"        ) \
+	X(Array32       , 0xdd      , 0b11111111  , 65541  , "array 32"        ) \
+	X(Map16         , 0xde      , 0b11111111  , 35     , "map 16"          ) \
+	X(Map32         , 0xdf      , 0b11111111  , 131076 , "map 32"          ) \
+	X(Fixed_Int_Neg , 0xe0      , 0b11100000  , 1      , "negative fixint" ) \
 /**
- * \struct Array
- *
- * \brief An array of Objects.
- *
- * The role of this structure is to store a collection of Objects in a 
- * resizable array. The underling `object_vector` can be accessed directly or 
- * use the helper methods to increase code readability.
+ * \def X
  *
- * Objects can be tested to find out if they are Arrays by using 
- * Object::isArray() and converted into an Array with Object::asArray(). An 
- * Array can not be converted into an Object. However, an Object can be 
- * constructed using an Array.
+ * \brief Convert macro data into code.
  */
 
+// }}}
+
+namespace zakero::messagepack
+{
+// {{{ Documentation
 
 /**
- * \var zakero::messagepack::Array::object_vector
- *
- * \brief Store the Object data.
+ * \class ErrorCategory_
  *
- * The `object_vector` is used to store all the Qbjects in the Array.
+ * \brief MessagePack Error Categories.
  */
 
+// }}}
+// {{{ Anonymous Namespace
 
-/**
- * \brief Append a boolean value.
- *
- * The \p value will be appended to the contents of the Array. 
- *
- * \parcode
- * zakero::messagepack::Array array;
- * array.append(true);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const bool value ///< The value to add
-	) noexcept
+namespace
 {
-	const size_t index = object_vector.size();
-
-	object_vector.emplace_back(Object{value});
+	/**
+	 * \brief MessagePack Format IDs.
+	 */
+	enum class Format : uint8_t
+	{
+#define X(type_, id_, mask_, size_, text_) \
+		type_ = id_, \
 
-	return index;
-}
+		ZAKERO_MESSAGEPACK__FORMAT_TYPE
+#undef X
+	};
 
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/bool")
-{
-	Array array;
+	/**
+	 * \brief Format ID names.
+	 *
+	 * Useful for debugging.
+	std::map<uint8_t, std::string> Format_Name =
+	{
+	#define X(type_, id_, mask_, size_, text_) \
+		{ uint8_t(id_ & mask_), std::string(name_) },
 
-	size_t index = array.append(true);
+		ZAKERO_MESSAGEPACK__FORMAT_TYPE
+	#undef X
+	};
+	 */
 
-	CHECK(index == 0);
-	CHECK(array.size() == 1);
 
-	index = array.append(false);
+	/**
+	 * \name Format ID Masks
+	 * \{
+	 */
+#define X(type_, id_, mask_, size_, text_) \
+	constexpr uint8_t type_ ## _Mask  = mask_;  \
 
-	CHECK(index == 1);
-	CHECK(array.size() == 2);
+	ZAKERO_MESSAGEPACK__FORMAT_TYPE
+#undef X
+	/**
+	 * \}
+	 */
 
-	// Check serialized data
 
-	std::vector<uint8_t> data = serialize(array);
-	CHECK(data.size() == 3);
+	/**
+	 * \name Format Value Masks
+	 * \{
+	 */
+#define X(type_, id_, mask_, size_, text_) \
+	constexpr uint8_t type_ ## _Value = (uint8_t)~mask_;\
 
-	index = 0;
-	CHECK((data[index] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
-	CHECK((data[index++] & Fixed_Array_Value) == 2);
-	CHECK(data[index++] == (uint8_t)Format::True);
-	CHECK(data[index++] == (uint8_t)Format::False);
+	ZAKERO_MESSAGEPACK__FORMAT_TYPE
+#undef X
+	/**
+	 * \}
+	 */
 
-	// Check deserialized data
 
-	Object object = deserialize(data);
+	/**
+	 * \brief The unsigned integer type that has the same size as `T`.
+	 */
+	template<typename T>
+	using Unsigned_ = std::conditional_t<sizeof(T) == 1, uint8_t
+		, std::conditional_t<sizeof(T) == 2, uint16_t
+		, std::conditional_t<sizeof(T) == 4, uint32_t
+		, uint64_t
+		>>>;
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == 2);
 
+	/**
+	 * \brief Read a big-endian value.
+	 *
+	 * MessagePack stores all multi-byte values in big-endian (network) byte 
+	 * order. The `sizeof(T)` bytes starting at \p data will be converted 
+	 * into a native value of type `T`.
+	 *
+	 * This function does not use any shared state, so it is safe to call 
+	 * from multiple threads.
+	 *
+	 * \return The value.
+	 *
+	 * \tparam T The type of the value.
+	 */
+	template<typename T>
+	constexpr T fromBigEndian(const uint8_t* data ///< The bytes to read
+		) noexcept
 	{
-		const messagepack::Object& object = array.object(0);
-		CHECK(object.is<bool>());
-		CHECK(object.as<bool>() == true);
-	}
+		Unsigned_<T> value = 0;
 
-	{
-		const messagepack::Object& object = array.object(1);
-		CHECK(object.is<bool>());
-		CHECK(object.as<bool>() == false);
+		for(size_t i = 0; i < sizeof(T); i++)
+		{
+			value = (Unsigned_<T>)((value << 8) | data[i]);
+		}
+
+		return std::bit_cast<T>(value);
 	}
-}
-#endif // }}}
 
 
-/**
- * \brief Append a signed integer value.
- *
- * The \p value will be appended to the contents of the Array.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * array.append(int64_t(0));
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const int64_t value ///< The value to add
-	) noexcept
-{
-	const size_t index = object_vector.size();
+	/**
+	 * \brief Read a big-endian value and advance the index.
+	 *
+	 * The same as fromBigEndian(), but the value will be read from \p data 
+	 * starting at \p index. The \p index will be moved past the value.
+	 *
+	 * \return The value.
+	 *
+	 * \tparam T The type of the value.
+	 */
+	template<typename T>
+	constexpr T readBigEndian(const uint8_t* data  ///< The bytes to read
+		, size_t&                        index ///< The location to read
+		) noexcept
+	{
+		const T value = fromBigEndian<T>(data + index);
 
-	object_vector.emplace_back(Object{value});
+		index += sizeof(T);
 
-	return index;
-}
+		return value;
+	}
 
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/int64_t")
-{
-	const int64_t i8_min = -31;
-	const int64_t i8_max = 127;
-	const int64_t i16_min = std::numeric_limits<int16_t>::min();
-	const int64_t i16_max = std::numeric_limits<int16_t>::max();
-	const int64_t i32_min = std::numeric_limits<int32_t>::min();
-	const int64_t i32_max = std::numeric_limits<int32_t>::max();
-	const int64_t i64_min = std::numeric_limits<int64_t>::min();
-	const int64_t i64_max = std::numeric_limits<int64_t>::max();
-	size_t count = 0;
+	/**
+	 * \brief Write a big-endian value.
+	 *
+	 * The \p value will be written into the `sizeof(T)` bytes starting at 
+	 * \p data using big-endian (network) byte order.
+	 *
+	 * This function does not use any shared state, so it is safe to call 
+	 * from multiple threads.
+	 *
+	 * \tparam T The type of the value.
+	 */
+	template<typename T>
+	constexpr void toBigEndian(const T value ///< The value to write
+		, uint8_t*                         data  ///< Where to write
+		) noexcept
+	{
+		const Unsigned_<T> bits = std::bit_cast<Unsigned_<T>>(value);
 
-	Array array;
-	array.append(i8_min);  count++;
-	array.append(i8_max);  count++;
-	array.append(i16_min); count++;
-	array.append(i16_max); count++;
-	array.append(i32_min); count++;
-	array.append(i32_max); count++;
-	array.append(i64_min); count++;
-	array.append(i64_max); count++;
+		for(size_t i = 0; i < sizeof(T); i++)
+		{
+			data[i] = (uint8_t)(bits >> ((sizeof(T) - 1 - i) * 8));
+		}
+	}
 
-	CHECK(array.size() == count);
 
-	// Check serialized data
+	/**
+	 * \brief Append a big-endian value.
+	 *
+	 * The \p value will be appended to the \p vector using big-endian 
+	 * (network) byte order.
+	 *
+	 * \tparam T The type of the value.
+	 */
+	template<typename T>
+	void appendBigEndian(std::vector<uint8_t>& vector ///< Where to store the value
+		, const T                           value  ///< The value to append
+		) noexcept
+	{
+		const size_t index = vector.size();
 
-	std::vector<uint8_t> data = serialize(array);
+		vector.resize(index + sizeof(T));
 
-	// Check deserialized data
+		toBigEndian(value, vector.data() + index);
+	}
 
-	Object object = deserialize(data);
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+	/**
+	 * \brief Write a column of fixed width values.
+	 *
+	 * Each of the \p count values will be written as the \p format ID
+	 * followed by the big-endian value. The \p data must have room for
+	 * `count * (1 + sizeof(T))` bytes.
+	 *
+	 * \tparam T The type of the values.
+	 */
+	template<typename T>
+	void packColumnScalar_(const uint8_t format ///< The Format ID
+		, const T*                     value  ///< The values
+		, const size_t                 count  ///< The number of values
+		, uint8_t*                     data   ///< Where to write
+		) noexcept
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			data[0] = format;
+			toBigEndian(value[i], data + 1);
 
-	size_t index = 0;
-	CHECK(test.object(index).is<int64_t>());
-	CHECK(test.object(index).as<int64_t>() == i8_min);
+			data += 1 + sizeof(T);
+		}
+	}
 
-	index++;
-	CHECK(test.object(index).is<int64_t>());
-	CHECK(test.object(index).as<int64_t>() == i8_max);
+#if defined(__x86_64__) || defined(__i386__)
 
-	index++;
-	CHECK(test.object(index).is<int64_t>());
-	CHECK(test.object(index).as<int64_t>() == i16_min);
+	/**
+	 * \brief Write a column of fixed width values using SSSE3.
+	 *
+	 * A single byte shuffle swaps the byte order of the values in a 16 byte
+	 * block and makes room for the Format IDs. The bytes of the last value
+	 * that do not fit in the block are written directly.
+	 *
+	 * \see packColumnScalar_()
+	 *
+	 * \tparam T The type of the values.
+	 */
+	template<typename T>
+	__attribute__((target("ssse3")))
+	void packColumnSsse3_(const uint8_t format ///< The Format ID
+		, const T*                    value  ///< The values
+		, const size_t                count  ///< The number of values
+		, uint8_t*                    data   ///< Where to write
+		) noexcept
+	{
+		static_assert(sizeof(T) == 4 || sizeof(T) == 8);
 
-	index++;
-	CHECK(test.object(index).is<int64_t>());
-	CHECK(test.object(index).as<int64_t>() == i16_max);
+		constexpr size_t Step   = 16 / sizeof(T);
+		constexpr size_t Stride = 1 + sizeof(T);
 
-	index++;
-	CHECK(test.object(index).is<int64_t>());
-	CHECK(test.object(index).as<int64_t>() == i32_min);
+		const uint8_t* bytes = (const uint8_t*)value;
+		size_t         i     = 0;
 
-	index++;
-	CHECK(test.object(index).is<int64_t>());
-	CHECK(test.object(index).as<int64_t>() == i32_max);
+		if constexpr(sizeof(T) == 4)
+		{
+			const __m128i shuffle = _mm_setr_epi8(-1, 3, 2, 1, 0, -1, 7, 6, 5, 4, -1, 11, 10, 9, 8, -1);
+			const __m128i tag     = _mm_and_si128(_mm_set1_epi8((char)format)
+				, _mm_setr_epi8(-1, 0, 0, 0, 0, -1, 0, 0, 0, 0, -1, 0, 0, 0, 0, -1)
+				);
 
-	index++;
-	CHECK(test.object(index).is<int64_t>());
-	CHECK(test.object(index).as<int64_t>() == i64_min);
+			for(; i + Step <= count; i += Step)
+			{
+				const uint8_t* in = bytes + (i * sizeof(T));
+				const __m128i  v  = _mm_loadu_si128((const __m128i*)in);
 
-	index++;
-	CHECK(test.object(index).is<int64_t>());
-	CHECK(test.object(index).as<int64_t>() == i64_max);
-}
-#endif // }}}
+				_mm_storeu_si128((__m128i*)data, _mm_or_si128(_mm_shuffle_epi8(v, shuffle), tag));
 
+				data[16] = in[15];
+				data[17] = in[14];
+				data[18] = in[13];
+				data[19] = in[12];
 
-/**
- * \brief Append an unsigned integer value.
- *
- * The \p value will be appended to the contents of the Array.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * array.append(uint64_t(0));
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const uint64_t value ///< The value to add
-	) noexcept
-{
-	const size_t index = object_vector.size();
+				data += Step * Stride;
+			}
+		}
+		else
+		{
+			const __m128i shuffle = _mm_setr_epi8(-1, 7, 6, 5, 4, 3, 2, 1, 0, -1, 15, 14, 13, 12, 11, 10);
+			const __m128i tag     = _mm_and_si128(_mm_set1_epi8((char)format)
+				, _mm_setr_epi8(-1, 0, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0, 0)
+				);
 
-	object_vector.emplace_back(Object{value});
+			for(; i + Step <= count; i += Step)
+			{
+				const uint8_t* in = bytes + (i * sizeof(T));
+				const __m128i  v  = _mm_loadu_si128((const __m128i*)in);
 
-	return index;
-}
+				_mm_storeu_si128((__m128i*)data, _mm_or_si128(_mm_shuffle_epi8(v, shuffle), tag));
 
+				data[16] = in[9];
+				data[17] = in[8];
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/uint64_t")
-{
-	const uint64_t u8_min = -31;
-	const uint64_t u8_max = 127;
-	const uint64_t u16_min = std::numeric_limits<uint16_t>::min();
-	const uint64_t u16_max = std::numeric_limits<uint16_t>::max();
-	const uint64_t u32_min = std::numeric_limits<uint32_t>::min();
-	const uint64_t u32_max = std::numeric_limits<uint32_t>::max();
-	const uint64_t u64_min = std::numeric_limits<uint64_t>::min();
-	const uint64_t u64_max = std::numeric_limits<uint64_t>::max();
-	size_t count = 0;
+				data += Step * Stride;
+			}
+		}
 
-	Array array;
-	array.append(u8_min);  count++;
-	array.append(u8_max);  count++;
-	array.append(u16_min); count++;
-	array.append(u16_max); count++;
-	array.append(u32_min); count++;
-	array.append(u32_max); count++;
-	array.append(u64_min); count++;
-	array.append(u64_max); count++;
+		packColumnScalar_(format, value + i, count - i, data);
+	}
 
-	CHECK(array.size() == count);
 
-	// Check serialized data
+	/**
+	 * \brief Write a column of fixed width values using AVX2.
+	 *
+	 * The same as packColumnSsse3_(), but two 16 byte blocks are swapped
+	 * at a time.
+	 *
+	 * \see packColumnScalar_()
+	 *
+	 * \tparam T The type of the values.
+	 */
+	template<typename T>
+	__attribute__((target("avx2")))
+	void packColumnAvx2_(const uint8_t format ///< The Format ID
+		, const T*                   value  ///< The values
+		, const size_t               count  ///< The number of values
+		, uint8_t*                   data   ///< Where to write
+		) noexcept
+	{
+		static_assert(sizeof(T) == 4 || sizeof(T) == 8);
 
-	std::vector<uint8_t> data = serialize(array);
+		constexpr size_t Step   = 32 / sizeof(T);
+		constexpr size_t Stride = 1 + sizeof(T);
+		constexpr size_t Lane   = (Step / 2) * Stride;
 
-	// Check deserialized data
+		const uint8_t* bytes = (const uint8_t*)value;
+		size_t         i     = 0;
 
-	Object object = deserialize(data);
+		if constexpr(sizeof(T) == 4)
+		{
+			const __m256i shuffle = _mm256_setr_epi8(
+				  -1, 3, 2, 1, 0, -1, 7, 6, 5, 4, -1, 11, 10, 9, 8, -1
+				, -1, 3, 2, 1, 0, -1, 7, 6, 5, 4, -1, 11, 10, 9, 8, -1
+				);
+			const __m256i tag = _mm256_and_si256(_mm256_set1_epi8((char)format), _mm256_setr_epi8(
+				  -1, 0, 0, 0, 0, -1, 0, 0, 0, 0, -1, 0, 0, 0, 0, -1
+				, -1, 0, 0, 0, 0, -1, 0, 0, 0, 0, -1, 0, 0, 0, 0, -1
+				));
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+			for(; i + Step <= count; i += Step)
+			{
+				const uint8_t* in  = bytes + (i * sizeof(T));
+				const __m256i  v   = _mm256_loadu_si256((const __m256i*)in);
+				const __m256i  out = _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), tag);
+
+				_mm_storeu_si128((__m128i*)data, _mm256_castsi256_si128(out));
+				data[16] = in[15];
+				data[17] = in[14];
+				data[18] = in[13];
+				data[19] = in[12];
+
+				_mm_storeu_si128((__m128i*)(data + Lane), _mm256_extracti128_si256(out, 1));
+				data[Lane + 16] = in[31];
+				data[Lane + 17] = in[30];
+				data[Lane + 18] = in[29];
+				data[Lane + 19] = in[28];
+
+				data += Step * Stride;
+			}
+		}
+		else
+		{
+			const __m256i shuffle = _mm256_setr_epi8(
+				  -1, 7, 6, 5, 4, 3, 2, 1, 0, -1, 15, 14, 13, 12, 11, 10
+				, -1, 7, 6, 5, 4, 3, 2, 1, 0, -1, 15, 14, 13, 12, 11, 10
+				);
+			const __m256i tag = _mm256_and_si256(_mm256_set1_epi8((char)format), _mm256_setr_epi8(
+				  -1, 0, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0, 0
+				, -1, 0, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0, 0
+				));
 
-	size_t index = 0;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == u8_min);
+			for(; i + Step <= count; i += Step)
+			{
+				const uint8_t* in  = bytes + (i * sizeof(T));
+				const __m256i  v   = _mm256_loadu_si256((const __m256i*)in);
+				const __m256i  out = _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), tag);
 
-	index++;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == u8_max);
+				_mm_storeu_si128((__m128i*)data, _mm256_castsi256_si128(out));
+				data[16] = in[9];
+				data[17] = in[8];
 
-	index++;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == u16_min);
+				_mm_storeu_si128((__m128i*)(data + Lane), _mm256_extracti128_si256(out, 1));
+				data[Lane + 16] = in[25];
+				data[Lane + 17] = in[24];
 
-	index++;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == u16_max);
+				data += Step * Stride;
+			}
+		}
 
-	index++;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == u32_min);
+		packColumnScalar_(format, value + i, count - i, data);
+	}
 
-	index++;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == u32_max);
+#endif
 
-	index++;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == u64_min);
+	/**
+	 * \brief The SIMD instructions that packColumn_() will use.
+	 *
+	 * The CPU is only checked once.
+	 *
+	 * \retval 0 Scalar code
+	 * \retval 1 SSSE3
+	 * \retval 2 AVX2
+	 */
+	int packColumnLevel_() noexcept
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		static const int level = __builtin_cpu_supports("avx2") ? 2
+			: __builtin_cpu_supports("ssse3") ? 1
+			: 0;
 
-	index++;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == u64_max);
-}
-#endif // }}}
+		return level;
+#else
+		return 0;
+#endif
+	}
 
 
-/**
- * \brief Append a 32-bit floating point value.
- *
- * The \p value will be appended to the contents of the Array.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * array.append(float(4.2));
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const float value ///< The value to add
-	) noexcept
-{
-	const size_t index = object_vector.size();
+	/**
+	 * \brief Write a column of fixed width values.
+	 *
+	 * The fastest version of packColumnScalar_() that the CPU supports will
+	 * be used. All versions write the same bytes.
+	 *
+	 * \tparam T The type of the values.
+	 */
+	template<typename T>
+	void packColumn_(const uint8_t format ///< The Format ID
+		, const T*               value  ///< The values
+		, const size_t           count  ///< The number of values
+		, uint8_t*               data   ///< Where to write
+		) noexcept
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		switch(packColumnLevel_())
+		{
+			case 2: return packColumnAvx2_(format, value, count, data);
+			case 1: return packColumnSsse3_(format, value, count, data);
+		}
+#endif
 
-	object_vector.emplace_back(Object{value});
+		packColumnScalar_(format, value, count, data);
+	}
 
-	return index;
-}
 
+	/**
+	 * \brief Get the minimum byte size of the Format ID
+	 *
+	 * \return The size.
+	 */
+	constexpr size_t formatSize(Format id ///< The Format ID
+		) noexcept
+	{
+		switch(id)
+		{
+#define X(type_, id_, mask_, size_, text_) \
+			case Format::type_: return size_;
+			ZAKERO_MESSAGEPACK__FORMAT_TYPE
+#undef X
+			default: return 0;
+		}
+	}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/float")
-{
-	const float f32_min = std::numeric_limits<float>::min();
-	const float f32_max = std::numeric_limits<float>::max();
-	size_t count = 0;
 
-	Array array;
-	array.append(f32_min); count++;
-	array.append(f32_max); count++;
+	/**
+	 * \brief The kind of data that a Format ID holds.
+	 *
+	 * Many Format IDs hold the same kind of data, for example `int 8` and 
+	 * `int 64` both hold a signed integer.
+	 */
+	enum class Type_ : uint8_t
+	{	Invalid
+	,	Null
+	,	Bool
+	,	Int
+	,	Uint
+	,	Float
+	,	Double
+	,	String
+	,	Binary
+	,	Array
+	,	Map
+	,	Ext
+	};
 
-	CHECK(array.size() == count);
 
-	// Check serialized data
+	/**
+	 * \brief A decoded Format ID.
+	 *
+	 * The meaning of the `value` depends on the `type`:
+	 * - Bool: `0` or `1`
+	 * - Int: The bits of the `int64_t`
+	 * - Uint: The value
+	 * - Float: The bits of the `float`
+	 * - Double: The bits of the `double`
+	 * - String, Binary, Ext: The number of bytes that follow the header
+	 * - Array: The number of elements
+	 * - Map: The number of key/value pairs
+	 */
+	struct Header_
+	{
+		Type_    type     = Type_::Invalid;
+		uint64_t value    = 0;
+		int8_t   ext_type = 0;
+	};
 
-	std::vector<uint8_t> data = serialize(array);
 
-	// Check deserialized data
+	/**
+	 * \brief The size of a header.
+	 *
+	 * The header is the Format ID and any size, count, extension type, or 
+	 * value that follows it.
+	 *
+	 * \return The number of bytes in the header.
+	 */
+	constexpr size_t headerSize_(const uint8_t format_byte ///< The Format ID
+		) noexcept
+	{
+		switch((Format)format_byte)
+		{
+			case Format::Bin8:
+			case Format::Int8:
+			case Format::Str8:
+			case Format::Uint8:
+			case Format::Fixed_Ext1:
+			case Format::Fixed_Ext2:
+			case Format::Fixed_Ext4:
+			case Format::Fixed_Ext8:
+			case Format::Fixed_Ext16:
+				return 2;
+
+			case Format::Array16:
+			case Format::Bin16:
+			case Format::Ext8:
+			case Format::Int16:
+			case Format::Map16:
+			case Format::Str16:
+			case Format::Uint16:
+				return 3;
+
+			case Format::Ext16:
+				return 4;
+
+			case Format::Array32:
+			case Format::Bin32:
+			case Format::Float32:
+			case Format::Int32:
+			case Format::Map32:
+			case Format::Str32:
+			case Format::Uint32:
+				return 5;
+
+			case Format::Ext32:
+				return 6;
+
+			case Format::Float64:
+			case Format::Int64:
+			case Format::Uint64:
+				return 9;
+
+			default:
+				return 1;
+		}
+	}
 
-	Object object = deserialize(data);
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+	/**
+	 * \brief Decode a header.
+	 *
+	 * The header that starts at \p bytes will be decoded into the \p 
+	 * header. There must be at least headerSize_() bytes available.
+	 *
+	 * This is the only place where Format IDs are decoded, all the 
+	 * deserializers build on this function.
+	 *
+	 * \retval Error_Invalid_Format_Type The Format ID is never used.
+	 *
+	 * \return An error code.
+	 */
+	std::error_code decodeHeader_(const uint8_t* bytes  ///< The header
+		, Header_&                           header ///< The decoded header
+		) noexcept
+	{
+		const uint8_t format_byte = bytes[0];
+		const Format  format_type = (Format)format_byte;
 
-	size_t index = 0;
-	CHECK(test.object(index).is<float>());
-	CHECK(test.object(index).as<float>() == f32_min);
+		size_t index = 1;
 
-	index++;
-	CHECK(test.object(index).is<float>());
-	CHECK(test.object(index).as<float>() == f32_max);
-}
-#endif // }}}
+		header.ext_type = 0;
 
+		switch(format_type)
+		{
+			case Format::Nill:
+				header.type  = Type_::Null;
+				header.value = 0;
+				return Error_None;
+
+			case Format::Never_Used:
+				header.type = Type_::Invalid;
+				return Error_Invalid_Format_Type;
+
+			case Format::False:
+				header.type  = Type_::Bool;
+				header.value = 0;
+				return Error_None;
+
+			case Format::True:
+				header.type  = Type_::Bool;
+				header.value = 1;
+				return Error_None;
+
+			case Format::Int8:
+				header.type  = Type_::Int;
+				header.value = (uint64_t)int64_t(readBigEndian<int8_t>(bytes, index));
+				return Error_None;
+
+			case Format::Int16:
+				header.type  = Type_::Int;
+				header.value = (uint64_t)int64_t(readBigEndian<int16_t>(bytes, index));
+				return Error_None;
+
+			case Format::Int32:
+				header.type  = Type_::Int;
+				header.value = (uint64_t)int64_t(readBigEndian<int32_t>(bytes, index));
+				return Error_None;
+
+			case Format::Int64:
+				header.type  = Type_::Int;
+				header.value = readBigEndian<uint64_t>(bytes, index);
+				return Error_None;
+
+			case Format::Uint8:
+				header.type  = Type_::Uint;
+				header.value = readBigEndian<uint8_t>(bytes, index);
+				return Error_None;
+
+			case Format::Uint16:
+				header.type  = Type_::Uint;
+				header.value = readBigEndian<uint16_t>(bytes, index);
+				return Error_None;
+
+			case Format::Uint32:
+				header.type  = Type_::Uint;
+				header.value = readBigEndian<uint32_t>(bytes, index);
+				return Error_None;
+
+			case Format::Uint64:
+				header.type  = Type_::Uint;
+				header.value = readBigEndian<uint64_t>(bytes, index);
+				return Error_None;
+
+			case Format::Float32:
+				header.type  = Type_::Float;
+				header.value = readBigEndian<uint32_t>(bytes, index);
+				return Error_None;
+
+			case Format::Float64:
+				header.type  = Type_::Double;
+				header.value = readBigEndian<uint64_t>(bytes, index);
+				return Error_None;
+
+			case Format::Str8:
+				header.type  = Type_::String;
+				header.value = readBigEndian<uint8_t>(bytes, index);
+				return Error_None;
+
+			case Format::Str16:
+				header.type  = Type_::String;
+				header.value = readBigEndian<uint16_t>(bytes, index);
+				return Error_None;
+
+			case Format::Str32:
+				header.type  = Type_::String;
+				header.value = readBigEndian<uint32_t>(bytes, index);
+				return Error_None;
+
+			case Format::Bin8:
+				header.type  = Type_::Binary;
+				header.value = readBigEndian<uint8_t>(bytes, index);
+				return Error_None;
+
+			case Format::Bin16:
+				header.type  = Type_::Binary;
+				header.value = readBigEndian<uint16_t>(bytes, index);
+				return Error_None;
+
+			case Format::Bin32:
+				header.type  = Type_::Binary;
+				header.value = readBigEndian<uint32_t>(bytes, index);
+				return Error_None;
+
+			case Format::Array16:
+				header.type  = Type_::Array;
+				header.value = readBigEndian<uint16_t>(bytes, index);
+				return Error_None;
+
+			case Format::Array32:
+				header.type  = Type_::Array;
+				header.value = readBigEndian<uint32_t>(bytes, index);
+				return Error_None;
+
+			case Format::Map16:
+				header.type  = Type_::Map;
+				header.value = readBigEndian<uint16_t>(bytes, index);
+				return Error_None;
+
+			case Format::Map32:
+				header.type  = Type_::Map;
+				header.value = readBigEndian<uint32_t>(bytes, index);
+				return Error_None;
+
+			case Format::Fixed_Ext1:
+			case Format::Fixed_Ext2:
+			case Format::Fixed_Ext4:
+			case Format::Fixed_Ext8:
+			case Format::Fixed_Ext16:
+				header.type     = Type_::Ext;
+				header.value    = formatSize(format_type) - 2;
+				header.ext_type = (int8_t)bytes[index++];
+				return Error_None;
+
+			case Format::Ext8:
+				header.type     = Type_::Ext;
+				header.value    = readBigEndian<uint8_t>(bytes, index);
+				header.ext_type = (int8_t)bytes[index++];
+				return Error_None;
+
+			case Format::Ext16:
+				header.type     = Type_::Ext;
+				header.value    = readBigEndian<uint16_t>(bytes, index);
+				header.ext_type = (int8_t)bytes[index++];
+				return Error_None;
+
+			case Format::Ext32:
+				header.type     = Type_::Ext;
+				header.value    = readBigEndian<uint32_t>(bytes, index);
+				header.ext_type = (int8_t)bytes[index++];
+				return Error_None;
+
+			default:
+				if((format_byte & Fixed_Int_Pos_Mask) == (uint8_t)Format::Fixed_Int_Pos)
+				{
+					header.type  = Type_::Int;
+					header.value = format_byte & Fixed_Int_Pos_Value;
+					return Error_None;
+				}
 
-/**
- * \brief Append a 64-bit floating point value.
- *
- * The \p value will be appended to the contents of the Array.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * array.append(double(0.42));
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const double value ///< The value to add
-	) noexcept
-{
-	const size_t index = object_vector.size();
+				if((format_byte & Fixed_Int_Neg_Mask) == (uint8_t)Format::Fixed_Int_Neg)
+				{
+					header.type  = Type_::Int;
+					header.value = (uint64_t)int64_t((int8_t)(format_byte & Fixed_Int_Neg_Value) - 32);
+					return Error_None;
+				}
 
-	object_vector.emplace_back(Object{value});
+				if((format_byte & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array)
+				{
+					header.type  = Type_::Array;
+					header.value = format_byte & Fixed_Array_Value;
+					return Error_None;
+				}
 
-	return index;
-}
+				if((format_byte & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map)
+				{
+					header.type  = Type_::Map;
+					header.value = format_byte & Fixed_Map_Value;
+					return Error_None;
+				}
 
+				// Only Fixed_Str remains
+				header.type  = Type_::String;
+				header.value = format_byte & Fixed_Str_Value;
+				return Error_None;
+		}
+	}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/double")
-{
-	const double f64_min = std::numeric_limits<double>::min();
-	const double f64_max = std::numeric_limits<double>::max();
-	size_t count = 0;
 
-	Array array;
-	array.append(f64_min); count++;
-	array.append(f64_max); count++;
+	/**
+	 * \brief Decode a Format ID.
+	 *
+	 * The Format ID at \p index and any size, count, or value that follows 
+	 * it will be decoded into the \p header. The \p index will be moved to 
+	 * the first byte after the header. For String, Binary, and Ext data, 
+	 * that is the first byte of the data, which is checked to be in \p 
+	 * data. The contents of Arrays and Maps are not checked.
+	 *
+	 * \return An error code.
+	 */
+	std::error_code readHeader_(const std::span<const uint8_t> data   ///< The packed data
+		, size_t&                                        index  ///< The location of the Format ID
+		, Header_&                                       header ///< The decoded Format ID
+		) noexcept
+	{
+		if(data.size() == 0)
+		{
+			return Error_No_Data;
+		}
 
-	CHECK(array.size() == count);
+		if(index >= data.size())
+		{
+			return Error_Invalid_Index;
+		}
 
-	// Check serialized data
+		const uint8_t format_byte = data[index];
+		const size_t  header_size = headerSize_(format_byte);
 
-	std::vector<uint8_t> data = serialize(array);
+		if((index + formatSize((Format)format_byte)) > data.size()
+			|| (index + header_size) > data.size()
+			)
+		{
+			index++;
 
-	// Check deserialized data
+			return Error_Incomplete;
+		}
 
-	Object object = deserialize(data);
+		std::error_code error = decodeHeader_(data.data() + index, header);
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+		if(error)
+		{
+			index++;
 
-	size_t index = 0;
-	CHECK(test.object(index).is<double>());
-	CHECK(test.object(index).as<double>() == f64_min);
+			return error;
+		}
 
-	index++;
-	CHECK(test.object(index).is<double>());
-	CHECK(test.object(index).as<double>() == f64_max);
-}
-#endif // }}}
+		index += header_size;
 
+		switch(header.type)
+		{
+			case Type_::String:
+			case Type_::Binary:
+			case Type_::Ext:
+				// The data must be available
+				if(header.value > (data.size() - index))
+				{
+					return Error_Incomplete;
+				}
+				break;
 
-/**
- * \brief Append a string.
- *
- * The \p value will be appended to the contents of the Array.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * array.append("Hello, World!");
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const std::string_view value ///< The value to add
-	) noexcept
-{
-	const size_t index = object_vector.size();
+			default:
+				break;
+		}
 
-	object_vector.emplace_back(Object{std::string(value)});
+		return Error_None;
+	}
 
-	return index;
-}
 
+	/**
+	 * \brief How to skip a Format ID.
+	 *
+	 * - `type`: The kind of data, only Invalid, String, Array, and Map 
+	 *   are used by skip_(). String is used for all data that has bytes 
+	 *   after the header and Null for everything else.
+	 * - `size`: The number of bytes in the header.
+	 * - `length`: The number of bytes in the size or count that follows 
+	 *   the Format ID, `0` if it is fixed.
+	 * - `count`: The fixed size or count.
+	 * - `minimum`: The minimum number of bytes, from formatSize().
+	 * - `key`: The data can be a Map key. Arrays, Maps, binary data, and 
+	 *   extensions can not.
+	 */
+	struct Skip_
+	{
+		Type_    type    = Type_::Invalid;
+		uint8_t  size    = 0;
+		uint8_t  length  = 0;
+		uint8_t  count   = 0;
+		uint32_t minimum = 0;
+		bool     key     = true;
+	};
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/string")
-{
-	const std::string str_0;
-	const std::string str_f (31, '_');
-	const std::string str_8 (32, 'X');
-	const std::string str_16(std::numeric_limits<uint8_t>::max() + 1 , '*');
-	const std::string str_32(std::numeric_limits<uint16_t>::max() + 1, '|');
-	size_t count = 0;
 
-	Array array;
-	array.append(str_0);  count++;
-	array.append(str_f);  count++;
-	array.append(str_8);  count++;
-	array.append(str_16); count++;
-	array.append(str_32); count++;
+	/**
+	 * \brief Create the Skip_Table_.
+	 *
+	 * \return The table.
+	 */
+	constexpr std::array<Skip_, 256> skipTable_() noexcept
+	{
+		std::array<Skip_, 256> table = {};
 
-	CHECK(array.size() == count);
+		for(size_t i = 0; i < table.size(); i++)
+		{
+			const uint8_t format_byte = (uint8_t)i;
 
-	// Check serialized data
+			Skip_& skip = table[i];
 
-	std::vector<uint8_t> data = serialize(array);
+			skip.type    = Type_::Null;
+			skip.size    = (uint8_t)headerSize_(format_byte);
+			skip.minimum = (uint32_t)formatSize((Format)format_byte);
 
-	// Check deserialized data
+			switch((Format)format_byte)
+			{
+				case Format::Never_Used:
+					skip.type = Type_::Invalid;
+					break;
+
+				case Format::Bin8:
+				case Format::Ext8:
+					skip.type   = Type_::String;
+					skip.length = 1;
+					skip.key    = false;
+					break;
+
+				case Format::Str8:
+					skip.type   = Type_::String;
+					skip.length = 1;
+					break;
+
+				case Format::Bin16:
+				case Format::Ext16:
+					skip.type   = Type_::String;
+					skip.length = 2;
+					skip.key    = false;
+					break;
+
+				case Format::Str16:
+					skip.type   = Type_::String;
+					skip.length = 2;
+					break;
+
+				case Format::Bin32:
+				case Format::Ext32:
+					skip.type   = Type_::String;
+					skip.length = 4;
+					skip.key    = false;
+					break;
+
+				case Format::Str32:
+					skip.type   = Type_::String;
+					skip.length = 4;
+					break;
+
+				case Format::Fixed_Ext1:
+				case Format::Fixed_Ext2:
+				case Format::Fixed_Ext4:
+				case Format::Fixed_Ext8:
+				case Format::Fixed_Ext16:
+					skip.type  = Type_::String;
+					skip.count = (uint8_t)(skip.minimum - 2);
+					skip.key   = false;
+					break;
+
+				case Format::Array16:
+					skip.type   = Type_::Array;
+					skip.length = 2;
+					skip.key    = false;
+					break;
+
+				case Format::Array32:
+					skip.type   = Type_::Array;
+					skip.length = 4;
+					skip.key    = false;
+					break;
+
+				case Format::Map16:
+					skip.type   = Type_::Map;
+					skip.length = 2;
+					skip.key    = false;
+					break;
+
+				case Format::Map32:
+					skip.type   = Type_::Map;
+					skip.length = 4;
+					skip.key    = false;
+					break;
+
+				default:
+					if((format_byte & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map)
+					{
+						skip.type  = Type_::Map;
+						skip.count = format_byte & Fixed_Map_Value;
+						skip.key   = false;
+					}
+					else if((format_byte & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array)
+					{
+						skip.type  = Type_::Array;
+						skip.count = format_byte & Fixed_Array_Value;
+						skip.key   = false;
+					}
+					else if((format_byte & Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str)
+					{
+						skip.type  = Type_::String;
+						skip.count = format_byte & Fixed_Str_Value;
+					}
+					break;
+			}
+		}
 
-	Object object = deserialize(data);
+		return table;
+	}
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
 
-	size_t index = 0;
-	CHECK(test.object(index).is<std::string>());
-	CHECK(test.object(index).as<std::string>() == str_0);
+	/**
+	 * \brief How to skip each of the 256 Format IDs.
+	 */
+	constexpr std::array<Skip_, 256> Skip_Table_ = skipTable_();
 
-	index++;
-	CHECK(test.object(index).is<std::string>());
-	CHECK(test.object(index).as<std::string>() == str_f);
 
-	index++;
-	CHECK(test.object(index).is<std::string>());
-	CHECK(test.object(index).as<std::string>() == str_8);
+	/**
+	 * \brief Skip over packed data.
+	 *
+	 * The \p index will be moved past the Object that it is at, including 
+	 * all the contents of Arrays and Maps. The data is not decoded, each 
+	 * Format ID is looked up in the Skip_Table_ and only sizes and counts 
+	 * are read.
+	 *
+	 * Instead of recursion, the number of Objects that still need to be 
+	 * skipped in each Array and Map is kept on a stack. The stack can hold 
+	 * 32 levels without allocating memory. This avoids stack overflows 
+	 * from deeply nested data.
+	 *
+	 * The same data is accepted as deserialize(), so Arrays, Maps, binary 
+	 * data, and extensions can not be Map keys. If there is an error, the 
+	 * \p index is not changed.
+	 *
+	 * \return An error code.
+	 */
+	std::error_code skip_(const std::span<const uint8_t> data  ///< The packed data
+		, size_t&                                  index ///< The location of the Object
+		) noexcept
+	{
+		if(data.size() == 0)
+		{
+			return Error_No_Data;
+		}
 
-	index++;
-	CHECK(test.object(index).is<std::string>());
-	CHECK(test.object(index).as<std::string>() == str_16);
+		struct Frame
+		{
+			uint64_t remaining;
+			bool     map;
+		};
 
-	index++;
-	CHECK(test.object(index).is<std::string>());
-	CHECK(test.object(index).as<std::string>() == str_32);
-}
-#endif // }}}
+		constexpr size_t Stack_Size = 32;
 
+		std::array<Frame, Stack_Size> stack_array;
+		std::vector<Frame>            stack_vector;
 
-/**
- * \brief Append a vector of binary data.
- *
- * The \p value will be appended to the contents of the Array.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * const std::vector<uint8_t> data = { 0xde, 0xad, 0xca, 0xfe };
- * array.append(data);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const std::vector<uint8_t>& value ///< The value to add
-	) noexcept
-{
-	const size_t index = object_vector.size();
+		Frame* stack    = stack_array.data();
+		size_t capacity = stack_array.size();
+		size_t depth    = 1;
 
-	object_vector.emplace_back(Object{value});
+		const uint8_t* bytes    = data.data();
+		const size_t   size     = data.size();
+		size_t         position = index;
 
-	return index;
-}
+		stack[0] = {1, false};
 
+		while(true)
+		{
+			while(depth > 0 && stack[depth - 1].remaining == 0)
+			{
+				depth--;
+			}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/binary (copy)")
-{
-	const std::vector<uint8_t> bin_0;
-	const std::vector<uint8_t> bin_8 (32, 'X');
-	const std::vector<uint8_t> bin_16(std::numeric_limits<uint8_t>::max() + 1 , '-');
-	const std::vector<uint8_t> bin_32(std::numeric_limits<uint16_t>::max() + 1, '|');
-	size_t count = 0;
+			if(depth == 0)
+			{
+				break;
+			}
 
-	Array array;
-	array.append(bin_0);  count++;
-	array.append(bin_8);  count++;
-	array.append(bin_16); count++;
-	array.append(bin_32); count++;
+			Frame& frame = stack[depth - 1];
 
-	CHECK(array.size() == count);
+			if(position >= size)
+			{
+				return Error_Invalid_Index;
+			}
 
-	// Check serialized data
+			const Skip_& skip = Skip_Table_[bytes[position]];
 
-	std::vector<uint8_t> data = serialize(array);
+			if(skip.type == Type_::Invalid)
+			{
+				return Error_Invalid_Format_Type;
+			}
 
-	// Check deserialized data
+			if(skip.minimum > (size - position)
+				|| skip.size > (size - position)
+				)
+			{
+				return Error_Incomplete;
+			}
 
-	Object object = deserialize(data);
+			uint64_t value = skip.count;
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+			switch(skip.length)
+			{
+				case 1: value = bytes[position + 1];                            break;
+				case 2: value = fromBigEndian<uint16_t>(bytes + position + 1); break;
+				case 4: value = fromBigEndian<uint32_t>(bytes + position + 1); break;
+			}
 
-	size_t index = 0;
-	CHECK(test.object(index).is<std::vector<uint8_t>>());
-	CHECK(test.object(index).as<std::vector<uint8_t>>() == bin_0);
+			// Map keys are at the even counts
+			const bool is_key = (frame.map == true && (frame.remaining & 1) == 0);
 
-	index++;
-	CHECK(test.object(index).is<std::vector<uint8_t>>());
-	CHECK(test.object(index).as<std::vector<uint8_t>>() == bin_8);
+			position += skip.size;
+			frame.remaining--;
 
-	index++;
-	CHECK(test.object(index).is<std::vector<uint8_t>>());
-	CHECK(test.object(index).as<std::vector<uint8_t>>() == bin_16);
+			if(skip.type == Type_::String
+				&& value > (size - position)
+				)
+			{
+				return Error_Incomplete;
+			}
 
-	index++;
-	CHECK(test.object(index).is<std::vector<uint8_t>>());
-	CHECK(test.object(index).as<std::vector<uint8_t>>() == bin_32);
-}
-#endif // }}}
+			if(is_key == true && skip.key == false)
+			{
+				return Error_Invalid_Format_Type;
+			}
 
+			switch(skip.type)
+			{
+				case Type_::String:
+					position += value;
+					break;
+
+				case Type_::Array:
+				case Type_::Map:
+					if(value == 0)
+					{
+						break;
+					}
+
+					if(depth == capacity)
+					{
+						// Every container is at least 1 byte, the
+						// stack will never need to grow again.
+						capacity = depth + (size - position) + 1;
+
+						stack_vector.reserve(capacity);
+						stack_vector.assign(stack, stack + depth);
+						stack_vector.resize(capacity);
+
+						stack = stack_vector.data();
+					}
+
+					if(skip.type == Type_::Map)
+					{
+						stack[depth] = {value * 2, true};
+					}
+					else
+					{
+						stack[depth] = {value, false};
+					}
+
+					depth++;
+					break;
+
+				default:
+					break;
+			}
+		}
 
-/**
- * \brief Append a vector of binary data.
- *
- * The \p value will be appended to the contents of the Array.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * std::vector<uint8_t> data = { 0xde, 0xad, 0xca, 0xfe };
- * array.append(data);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(std::vector<uint8_t>& value ///< The value to add
-	) noexcept
-{
-	const size_t index = object_vector.size();
+		index = position;
 
-	object_vector.emplace_back(Object{std::move(value)});
+		return Error_None;
+	}
 
-	return index;
-}
 
+	/**
+	 * \name Map Keys
+	 *
+	 * Hashing and comparing the keys of a Map. A string key can be 
+	 * compared with a std::string_view so that looking up a key does not 
+	 * need to create an Object.
+	 *
+	 * Floating-point keys are compared by their bits so that every key, 
+	 * including NaN, can be found.
+	 * \{
+	 */
+	constexpr size_t Key_Type_Count_ = 7;
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/binary (move)")
-{
-	const std::vector<uint8_t> bin_0;
-	const std::vector<uint8_t> bin_8 (32, 'X');
-	const std::vector<uint8_t> bin_16(std::numeric_limits<uint8_t>::max() + 1 , '-');
-	const std::vector<uint8_t> bin_32(std::numeric_limits<uint16_t>::max() + 1, '|');
-	size_t count = 0;
+	constexpr uint64_t keyMix_(uint64_t value ///< The value to mix
+		) noexcept
+	{
+		value ^= value >> 30;
+		value *= 0xbf58476d1ce4e5b9;
+		value ^= value >> 27;
+		value *= 0x94d049bb133111eb;
+		value ^= value >> 31;
 
-	std::vector<uint8_t> tmp_0(bin_0);
-	std::vector<uint8_t> tmp_8(bin_8);
-	std::vector<uint8_t> tmp_16(bin_16);
-	std::vector<uint8_t> tmp_32(bin_32);
+		return value;
+	}
 
-	Array array;
-	array.append(tmp_0);  count++;
-	array.append(tmp_8);  count++;
-	array.append(tmp_16); count++;
-	array.append(tmp_32); count++;
+	inline uint64_t keyHash_(const std::string_view key ///< The key
+		) noexcept
+	{
+		return keyMix_(std::hash<std::string_view>{}(key) + 6);
+	}
 
-	CHECK(array.size() == count);
-	CHECK(tmp_0.empty());
-	CHECK(tmp_8.empty());
-	CHECK(tmp_16.empty());
-	CHECK(tmp_32.empty());
-
-	// Check serialized data
+	inline uint64_t keyHash_(const Object& key ///< The key
+		) noexcept
+	{
+		constexpr uint64_t Golden = 0x9e3779b97f4a7c15;
 
-	std::vector<uint8_t> data = serialize(array);
+		switch(key.value.index())
+		{
+			case 1: return keyMix_(key.as<bool>() + 1 * Golden);
+			case 2: return keyMix_(key.as<int64_t>() + 2 * Golden);
+			case 3: return keyMix_(key.as<uint64_t>() + 3 * Golden);
+			case 4: return keyMix_(std::bit_cast<uint32_t>(key.as<float>()) + 4 * Golden);
+			case 5: return keyMix_(std::bit_cast<uint64_t>(key.as<double>()) + 5 * Golden);
+			case 6: return keyHash_(std::string_view(key.asString()));
+		}
 
-	// Check deserialized data
+		return keyMix_(0);
+	}
 
-	Object object = deserialize(data);
+	inline bool keyEqual_(const Object& lhs ///< The key
+		, const std::string_view    rhs ///< The key
+		) noexcept
+	{
+		return lhs.isString() && (lhs.asString() == rhs);
+	}
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+	inline bool keyEqual_(const Object& lhs ///< The key
+		, const Object&             rhs ///< The key
+		) noexcept
+	{
+		if(lhs.value.index() != rhs.value.index())
+		{
+			return false;
+		}
 
-	size_t index = 0;
-	CHECK(test.object(index).is<std::vector<uint8_t>>());
-	CHECK(test.object(index).as<std::vector<uint8_t>>() == bin_0);
+		switch(lhs.value.index())
+		{
+			case 0: return true;
+			case 1: return lhs.as<bool>() == rhs.as<bool>();
+			case 2: return lhs.as<int64_t>() == rhs.as<int64_t>();
+			case 3: return lhs.as<uint64_t>() == rhs.as<uint64_t>();
+			case 4: return std::bit_cast<uint32_t>(lhs.as<float>()) == std::bit_cast<uint32_t>(rhs.as<float>());
+			case 5: return std::bit_cast<uint64_t>(lhs.as<double>()) == std::bit_cast<uint64_t>(rhs.as<double>());
+			case 6: return lhs.asString() == rhs.asString();
+		}
 
-	index++;
-	CHECK(test.object(index).is<std::vector<uint8_t>>());
-	CHECK(test.object(index).as<std::vector<uint8_t>>() == bin_8);
+		return false;
+	}
+	/**
+	 * \}
+	 */
 
-	index++;
-	CHECK(test.object(index).is<std::vector<uint8_t>>());
-	CHECK(test.object(index).as<std::vector<uint8_t>>() == bin_16);
 
-	index++;
-	CHECK(test.object(index).is<std::vector<uint8_t>>());
-	CHECK(test.object(index).as<std::vector<uint8_t>>() == bin_32);
-}
-#endif // }}}
+	/**
+	 * \name Packed Sizes
+	 *
+	 * The number of bytes that the Packer will use for a value. These 
+	 * must match the formats that are selected by the Packer.
+	 * \{
+	 */
+	constexpr size_t sizeInt_(const int64_t value ///< The value
+		) noexcept
+	{
+		if(value >= -32 && value <= std::numeric_limits<int8_t>::max())
+		{
+			return 1;
+		}
 
+		if(value >= std::numeric_limits<int8_t>::min() && value < 0)
+		{
+			return 2;
+		}
 
-/**
- * \brief Append an Array.
- *
- * The \p array will be appended to the contents of this Array.
- *
- * \parcode
- * zakero::messagepack::Array sub_array;
- * sub_array.append(false);
- * sub_array.append(0x42);
- *
- * zakero::messagepack::Array array;
- * array.append(sub_array);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const Array& array ///< The Array to add
-	) noexcept
-{
-	size_t index = object_vector.size();
-	object_vector.emplace_back(Object{Array{}});
+		if(value >= std::numeric_limits<int16_t>::min()
+			&& value <= std::numeric_limits<int16_t>::max()
+			)
+		{
+			return 3;
+		}
 
-	Array& sub_array = object_vector[index].asArray();
-	sub_array.object_vector = array.object_vector;
+		if(value >= std::numeric_limits<int32_t>::min()
+			&& value <= std::numeric_limits<int32_t>::max()
+			)
+		{
+			return 5;
+		}
 
-	return index;
-}
+		return 9;
+	}
 
+	constexpr size_t sizeUint_(const uint64_t value ///< The value
+		) noexcept
+	{
+		if(value <= std::numeric_limits<uint8_t>::max())  return 2;
+		if(value <= std::numeric_limits<uint16_t>::max()) return 3;
+		if(value <= std::numeric_limits<uint32_t>::max()) return 5;
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/array (copy)")
-{
-	messagepack::Array sub_0;
-	messagepack::Array sub_1;
-		sub_1.appendNull();
-	messagepack::Array sub_2;
-		sub_2.append(true);
-		sub_2.append(false);
-	messagepack::Array sub_3;
-		sub_3.append(std::string_view("Hello"));
-		sub_3.append(std::string_view("World"));
-	size_t count = 0;
+		return 9;
+	}
 
-	const messagepack::Array tmp_0 = sub_0;
-	const messagepack::Array tmp_1 = sub_1;
-	const messagepack::Array tmp_2 = sub_2;
-	const messagepack::Array tmp_3 = sub_3;
+	constexpr size_t sizeStr_(const size_t length ///< The string length
+		) noexcept
+	{
+		if(length <= 31)                                   return 1 + length;
+		if(length <= std::numeric_limits<uint8_t>::max())  return 2 + length;
+		if(length <= std::numeric_limits<uint16_t>::max()) return 3 + length;
 
-	Array array;
-	array.append(tmp_0); count++;
-	array.append(tmp_1); count++;
-	array.append(tmp_2); count++;
-	array.append(tmp_3); count++;
+		return 5 + length;
+	}
 
-	CHECK(array.size() == count);
-	CHECK(tmp_0.size() == 0);
-	CHECK(tmp_1.size() == 1);
-	CHECK(tmp_2.size() == 2);
-	CHECK(tmp_3.size() == 2);
+	constexpr size_t sizeBin_(const size_t length ///< The data length
+		) noexcept
+	{
+		if(length <= std::numeric_limits<uint8_t>::max())  return 2 + length;
+		if(length <= std::numeric_limits<uint16_t>::max()) return 3 + length;
 
-	// Check serialized data
+		return 5 + length;
+	}
 
-	std::vector<uint8_t> data = serialize(array);
+	constexpr size_t sizeExt_(const size_t length ///< The data length
+		) noexcept
+	{
+		switch(length)
+		{
+			case 1: case 2: case 4: case 8: case 16:
+				return 2 + length;
+		}
 
-	// Check deserialized data
+		if(length <= std::numeric_limits<uint8_t>::max())  return 3 + length;
+		if(length <= std::numeric_limits<uint16_t>::max()) return 4 + length;
 
-	Object object = deserialize(data);
+		return 6 + length;
+	}
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+	constexpr size_t sizeContainer_(const size_t count ///< The element count
+		) noexcept
+	{
+		if(count < 16)                                    return 1;
+		if(count <= std::numeric_limits<uint16_t>::max()) return 3;
 
-	size_t index = 0;
-	CHECK(test.object(index).isArray());
-	CHECK(test.object(index).asArray().size() == 0);
+		return 5;
+	}
+	/**
+	 * \}
+	 */
 
-	index++;
-	CHECK(test.object(index).isArray());
-	CHECK(test.object(index).asArray().size() == 1);
-	CHECK(test.object(index).asArray().object(0).isNull());
 
-	index++;
-	CHECK(test.object(index).isArray());
-	CHECK(test.object(index).asArray().size() == 2);
-	CHECK(test.object(index).asArray().object(0).is<bool>());
-	CHECK(test.object(index).asArray().object(0).as<bool>() == true);
-	CHECK(test.object(index).asArray().object(1).is<bool>());
-	CHECK(test.object(index).asArray().object(1).as<bool>() == false);
+	/**
+	 * \brief Run work on several threads.
+	 *
+	 * The \p work is called by \p thread_count threads, including the 
+	 * calling thread. When this function returns, all the threads have 
+	 * finished. If the \p thread_count is `0`, 
+	 * `std::thread::hardware_concurrency()` threads are used.
+	 */
+	template<typename Work>
+	void runThreads_(size_t thread_count ///< The number of threads
+		, const Work&   work         ///< The work
+		) noexcept
+	{
+		if(thread_count == 0)
+		{
+			thread_count = std::max(1u, std::thread::hardware_concurrency());
+		}
 
-	index++;
-	CHECK(test.object(index).isArray());
-	CHECK(test.object(index).asArray().size() == 2);
-	CHECK(test.object(index).asArray().object(0).is<std::string>());
-	CHECK(test.object(index).asArray().object(0).as<std::string>() == "Hello");
-	CHECK(test.object(index).asArray().object(1).is<std::string>());
-	CHECK(test.object(index).asArray().object(1).as<std::string>() == "World");
-}
-#endif // }}}
+		std::vector<std::thread> thread_vector;
+		thread_vector.reserve(thread_count - 1);
 
+		for(size_t i = 1; i < thread_count; i++)
+		{
+			thread_vector.emplace_back(work);
+		}
 
-/**
- * \brief Append an Array.
- *
- * The \p array will be appended to the contents of this Array.
- *
- * \parcode
- * zakero::messagepack::Array sub_array;
- * sub_array.append(false);
- * sub_array.append(0x42);
- *
- * zakero::messagepack::Array array;
- * array.append(sub_array);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(Array& array ///< The Array to add
-	) noexcept
-{
-	size_t index = object_vector.size();
-	object_vector.emplace_back(Object{Array{}});
+		work();
 
-	Array& sub_array = object_vector[index].asArray();
-	sub_array.object_vector = std::move(array.object_vector);
+		for(std::thread& thread : thread_vector)
+		{
+			thread.join();
+		}
+	}
 
-	return index;
-}
 
+	/**
+	 * \name Parallel Serialization
+	 *
+	 * To serialize in parallel, the Object is split into units that are 
+	 * packed one after another. A unit is the header of an Array or Map, 
+	 * a range of Objects, or a range of the key/value pairs of a Map. 
+	 * Small Arrays and Maps near the top are split into their contents so 
+	 * that a few huge children are packed in parallel too.
+	 * \{
+	 */
+	struct SerializeUnit_
+	{
+		enum class Kind : uint8_t
+		{	Array_Header
+		,	Map_Header
+		,	Objects
+		,	Pairs
+		};
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/array (move)")
-{
-	messagepack::Array sub_0;
-	messagepack::Array sub_1;
-		sub_1.appendNull();
-	messagepack::Array sub_2;
-		sub_2.append(true);
-		sub_2.append(false);
-	messagepack::Array sub_3;
-		sub_3.append(std::string_view("Hello"));
-		sub_3.append(std::string_view("World"));
-	size_t count = 0;
+		Kind          kind   = Kind::Objects;
+		const Object* object = nullptr;
+		const Map*    map    = nullptr;
+		size_t        first  = 0;
+		size_t        count  = 0;
+	};
 
-	messagepack::Array tmp_0 = sub_0;
-	messagepack::Array tmp_1 = sub_1;
-	messagepack::Array tmp_2 = sub_2;
-	messagepack::Array tmp_3 = sub_3;
+	// Objects or pairs in a unit
+	constexpr size_t Serialize_Unit_Size_  = 256;
+	// Containers with fewer elements are split into their contents
+	constexpr size_t Serialize_Split_Size_ = 64;
+	// Containers deeper than this are not split
+	constexpr size_t Serialize_Split_Depth_ = 8;
+	// Stop splitting after this many units
+	constexpr size_t Serialize_Unit_Max_   = 64 * 1024;
 
-	Array array;
-	array.append(tmp_0); count++;
-	array.append(tmp_1); count++;
-	array.append(tmp_2); count++;
-	array.append(tmp_3); count++;
+	void serializeUnits_(const Object&, std::vector<SerializeUnit_>&, const size_t) noexcept;
 
-	CHECK(array.size() == count);
-	CHECK(tmp_0.size() == 0);
-	CHECK(tmp_1.size() == 0);
-	CHECK(tmp_2.size() == 0);
-	CHECK(tmp_3.size() == 0);
+	void serializeUnits_(const Array& array         ///< The Array
+		, std::vector<SerializeUnit_>& unit_vector ///< The units
+		, const size_t                 depth       ///< The depth of the Array
+		) noexcept
+	{
+		using Kind = SerializeUnit_::Kind;
 
-	// Check serialized data
+		const size_t size = array.size();
 
-	std::vector<uint8_t> data = serialize(array);
+		unit_vector.push_back({Kind::Array_Header, nullptr, nullptr, 0, size});
 
-	// Check deserialized data
+		if(size < Serialize_Split_Size_
+			&& depth < Serialize_Split_Depth_
+			&& unit_vector.size() < Serialize_Unit_Max_
+			)
+		{
+			for(const Object& object : array.object_vector)
+			{
+				serializeUnits_(object, unit_vector, depth + 1);
+			}
 
-	Object object = deserialize(data);
+			return;
+		}
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+		for(size_t i = 0; i < size; i += Serialize_Unit_Size_)
+		{
+			unit_vector.push_back({Kind::Objects, &array.object_vector[i], nullptr, 0, std::min(Serialize_Unit_Size_, size - i)});
+		}
+	}
 
-	size_t index = 0;
-	CHECK(test.object(index).isArray());
-	CHECK(test.object(index).asArray().size() == 0);
+	void serializeUnits_(const Map& map             ///< The Map
+		, std::vector<SerializeUnit_>& unit_vector ///< The units
+		, const size_t                 depth       ///< The depth of the Map
+		) noexcept
+	{
+		using Kind = SerializeUnit_::Kind;
 
-	index++;
-	CHECK(test.object(index).isArray());
-	CHECK(test.object(index).asArray().size() == 1);
-	CHECK(test.object(index).asArray().object(0).isNull());
+		const size_t size = map.size();
 
-	index++;
-	CHECK(test.object(index).isArray());
-	CHECK(test.object(index).asArray().size() == 2);
-	CHECK(test.object(index).asArray().object(0).is<bool>());
-	CHECK(test.object(index).asArray().object(0).as<bool>() == true);
-	CHECK(test.object(index).asArray().object(1).is<bool>());
-	CHECK(test.object(index).asArray().object(1).as<bool>() == false);
+		unit_vector.push_back({Kind::Map_Header, nullptr, nullptr, 0, size});
 
-	index++;
-	CHECK(test.object(index).isArray());
-	CHECK(test.object(index).asArray().size() == 2);
-	CHECK(test.object(index).asArray().object(0).is<std::string>());
-	CHECK(test.object(index).asArray().object(0).as<std::string>() == "Hello");
-	CHECK(test.object(index).asArray().object(1).is<std::string>());
-	CHECK(test.object(index).asArray().object(1).as<std::string>() == "World");
-}
-#endif // }}}
-
-
-/**
- * \brief Append an extension.
- *
- * The \p value will be appended to the contents of this Array.
- *
- * \parcode
- * zakero::messagepack::Ext ext;
- * ext.type = 42;
- * ext.data = std::vector<uint8_t>(42, '*');
- *
- * zakero::messagepack::Array array;
- * array.append(ext);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const Ext& ext ///< The Ext to add
-	) noexcept
-{
-	size_t index = object_vector.size();
-	object_vector.emplace_back(Object{ext});
-
-	return index;
-}
+		if(size < Serialize_Split_Size_
+			&& depth < Serialize_Split_Depth_
+			&& unit_vector.size() < Serialize_Unit_Max_
+			)
+		{
+			for(size_t i = 0; i < size; i++)
+			{
+				unit_vector.push_back({Kind::Objects, &map.key(i), nullptr, 0, 1});
+				serializeUnits_(map.value(i), unit_vector, depth + 1);
+			}
 
+			return;
+		}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/ext (copy)")
-{
-	const uint8_t chr_16 = '-';
-	const uint8_t chr_32 = '|';
+		for(size_t i = 0; i < size; i += Serialize_Unit_Size_)
+		{
+			unit_vector.push_back({Kind::Pairs, nullptr, &map, i, std::min(Serialize_Unit_Size_, size - i)});
+		}
+	}
 
-	Ext ext_0;
-	ext_0.type = 0;
-	ext_0.data = {};
+	void serializeUnits_(const Object& object        ///< The Object
+		, std::vector<SerializeUnit_>& unit_vector ///< The units
+		, const size_t                 depth       ///< The depth of the Object
+		) noexcept
+	{
+		if(object.isArray())
+		{
+			serializeUnits_(object.asArray(), unit_vector, depth);
+		}
+		else if(object.isMap())
+		{
+			serializeUnits_(object.asMap(), unit_vector, depth);
+		}
+		else
+		{
+			unit_vector.push_back({SerializeUnit_::Kind::Objects, &object, nullptr, 0, 1});
+		}
+	}
 
-	const Ext ext_16 =
-	{	.data = std::vector<uint8_t>(16, chr_16)
-	,	.type = 16
-	};
+	size_t serializeUnitSize_(const SerializeUnit_& unit ///< The unit
+		) noexcept
+	{
+		using Kind = SerializeUnit_::Kind;
 
-	const Ext ext_32 =
-	{	.data = std::vector<uint8_t>(32, chr_32)
-	,	.type = 32
-	};
+		size_t size = 0;
 
-	size_t count = 0;
-	Array array;
-	array.append(ext_0);  count++;
-	array.append(ext_16); count++;
-	array.append(ext_32); count++;
+		switch(unit.kind)
+		{
+			case Kind::Array_Header:
+			case Kind::Map_Header:
+				size = sizeContainer_(unit.count);
+				break;
 
-	CHECK(array.size() == count);
-	CHECK(ext_0.data.size()  == 0);
-	CHECK(ext_16.data.size() == 16);
-	CHECK(ext_32.data.size() == 32);
+			case Kind::Objects:
+				for(size_t i = 0; i < unit.count; i++)
+				{
+					size += serializedSize(unit.object[i]);
+				}
+				break;
 
-	// Check serialized data
+			case Kind::Pairs:
+				for(size_t i = unit.first; i < unit.first + unit.count; i++)
+				{
+					size += serializedSize(unit.map->key(i))
+						+ serializedSize(unit.map->value(i))
+						;
+				}
+				break;
+		}
 
-	std::vector<uint8_t> data = serialize(array);
+		return size;
+	}
 
-	// Check deserialized data
+	std::error_code serializeUnitPack_(const SerializeUnit_& unit   ///< The unit
+		, Packer&                                        packer ///< The Packer
+		) noexcept
+	{
+		using Kind = SerializeUnit_::Kind;
 
-	Object object = deserialize(data);
+		switch(unit.kind)
+		{
+			case Kind::Array_Header:
+				return packer.packArrayHeader(unit.count);
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+			case Kind::Map_Header:
+				return packer.packMapHeader(unit.count);
 
-	size_t index = 0;
-	CHECK(test.object(index).isExt() == true);
-	CHECK(test.object(index).asExt().type == 0);
-	CHECK(test.object(index).asExt().data.size() == 0);
+			case Kind::Objects:
+				return packer.pack(std::span<const Object>(unit.object, unit.count));
 
-	index++;
-	CHECK(test.object(index).isExt() == true);
-	CHECK(test.object(index).asExt().type == 16);
-	CHECK(test.object(index).asExt().data.size() == 16);
-	for(size_t i = 0; i < test.object(index).asExt().data.size(); i++)
-	{
-		CHECK(test.object(index).asExt().data[i] == chr_16);
-	}
+			case Kind::Pairs:
+				for(size_t i = unit.first; i < unit.first + unit.count; i++)
+				{
+					packer.pack(unit.map->key(i));
+					packer.pack(unit.map->value(i));
+				}
+				break;
+		}
 
-	index++;
-	CHECK(test.object(index).isExt() == true);
-	CHECK(test.object(index).asExt().type == 32);
-	CHECK(test.object(index).asExt().data.size() == 32);
-	for(size_t i = 0; i < test.object(index).asExt().data.size(); i++)
-	{
-		CHECK(test.object(index).asExt().data[i] == chr_32);
+		return packer.error();
 	}
-}
-#endif // }}}
-
 
-/**
- * \brief Append an extension.
- *
- * The \p value will be appended to the contents of this Array.
- *
- * \parcode
- * zakero::messagepack::Ext ext;
- * ext.type = 42;
- * ext.data = std::vector<uint8_t>(42, '*');
- *
- * zakero::messagepack::Array array;
- * array.append(ext);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(Ext& ext ///< The Ext to add
-	) noexcept
-{
-	size_t index = object_vector.size();
-	object_vector.push_back(Object{std::move(ext)});
 
-	return index;
-}
+	/**
+	 * \brief Serialize the \p unit_vector in parallel.
+	 *
+	 * \return The packed data, or empty if there was an error.
+	 */
+	std::vector<uint8_t> serializeUnits_(const std::vector<SerializeUnit_>& unit_vector  ///< The units
+		, const size_t                                             thread_count ///< The number of threads
+		) noexcept
+	{
+		// Units sized or packed by a thread at a time
+		constexpr size_t Group_Size = 16;
 
+		const size_t unit_count = unit_vector.size();
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/ext (move)")
-{
-	const uint8_t chr_16 = '-';
-	const uint8_t chr_32 = '|';
+		const size_t threads = std::min(thread_count == 0
+			? std::max(1u, std::thread::hardware_concurrency())
+			: thread_count
+			, (unit_count + Group_Size - 1) / Group_Size
+			);
 
-	Ext ext_0;
-	ext_0.type = 0;
-	ext_0.data = {};
+		std::vector<size_t> offset_vector(unit_count + 1);
+		std::atomic<size_t> next_group = 0;
 
-	Ext ext_16;
-	ext_16.type = 16;
-	ext_16.data = std::vector<uint8_t>(16, chr_16);
+		runThreads_(threads, [&]()
+		{
+			for(size_t first = next_group.fetch_add(Group_Size)
+				; first < unit_count
+				; first = next_group.fetch_add(Group_Size)
+				)
+			{
+				const size_t last = std::min(first + Group_Size, unit_count);
 
-	Ext ext_32;
-	ext_32.type = 32;
-	ext_32.data = std::vector<uint8_t>(32, chr_32);
+				for(size_t i = first; i < last; i++)
+				{
+					offset_vector[i + 1] = serializeUnitSize_(unit_vector[i]);
+				}
+			}
+		});
 
-	size_t count = 0;
-	Array array;
-	array.append(ext_0);  count++;
-	array.append(ext_16); count++;
-	array.append(ext_32); count++;
+		for(size_t i = 0; i < unit_count; i++)
+		{
+			offset_vector[i + 1] += offset_vector[i];
+		}
 
-	CHECK(array.size() == count);
-	CHECK(ext_16.data.size() == 0);
-	CHECK(ext_32.data.size() == 0);
+		std::vector<uint8_t> vector(offset_vector.back());
+		std::atomic<bool>    failed = false;
 
-	// Check serialized data
+		next_group = 0;
 
-	std::vector<uint8_t> data = serialize(array);
+		runThreads_(threads, [&]()
+		{
+			for(size_t first = next_group.fetch_add(Group_Size)
+				; first < unit_count && !failed
+				; first = next_group.fetch_add(Group_Size)
+				)
+			{
+				const size_t last = std::min(first + Group_Size, unit_count);
 
-	// Check deserialized data
+				for(size_t i = first; i < last; i++)
+				{
+					const size_t size = offset_vector[i + 1] - offset_vector[i];
 
-	Object object = deserialize(data);
+					Packer packer(std::span<uint8_t>(vector.data() + offset_vector[i], size));
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+					if(serializeUnitPack_(unit_vector[i], packer)
+						|| packer.size() != size
+						)
+					{
+						failed = true;
+						break;
+					}
+				}
+			}
+		});
 
-	size_t index = 0;
-	CHECK(test.object(index).isExt());
-	CHECK(test.object(index).asExt().type == 0);
-	CHECK(test.object(index).asExt().data.size() == 0);
+		if(failed)
+		{
+			return {};
+		}
 
-	index++;
-	CHECK(test.object(index).isExt());
-	CHECK(test.object(index).asExt().type == 16);
-	CHECK(test.object(index).asExt().data.size() == 16);
-	for(size_t i = 0; i < test.object(index).asExt().data.size(); i++)
-	{
-		CHECK(test.object(index).asExt().data[i] == chr_16);
+		return vector;
 	}
+	/**
+	 * \}
+	 */
 
-	index++;
-	CHECK(test.object(index).isExt());
-	CHECK(test.object(index).asExt().type == 32);
-	CHECK(test.object(index).asExt().data.size() == 32);
-	for(size_t i = 0; i < test.object(index).asExt().data.size(); i++)
+	/**
+	 * \name JSON
+	 *
+	 * toJson() writes its output into a JsonWriter_, which collects it in a 
+	 * buffer and passes full buffers to the JsonSink. Strings are copied a 
+	 * run at a time, only the bytes that must be escaped are handled one at 
+	 * a time.
+	 *
+	 * fromJson() works like simdjson. First, the structural characters of 
+	 * 64 bytes are found at once with SIMD compares, and bit operations 
+	 * remove the ones that are in strings. Then the tokens are checked and 
+	 * the containers are counted, and finally the tokens are packed.
+	 * \{
+	 */
+	class JsonWriter_
 	{
-		CHECK(test.object(index).asExt().data[i] == chr_32);
-	}
-}
-#endif // }}}
+		public:
+			/// The most bytes that reserve() can provide.
+			static constexpr size_t Reserve_Size = 64;
+
+			JsonWriter_(const JsonSink& sink    ///< The data receiver
+				, const size_t      buffer_size ///< The size of the buffer
+				) noexcept
+				: sink_(sink)
+				, buffer_(std::max(buffer_size, Reserve_Size))
+			{
+			}
 
+			/// Get space for \p size bytes, no more than Reserve_Size.
+			char* reserve(const size_t size ///< The number of bytes
+				) noexcept
+			{
+				if(size_ + size > buffer_.size())
+				{
+					flush();
+				}
 
-/**
- * \brief Append a Map.
- *
- * The \p value will be appended to the contents of this Array.
- *
- * \parcode
- * zakero::messagepack::Map map;
- * map.set(Object{42}, Object{std::string("foo")});
- *
- * zakero::messagepack::Array array;
- * array.append(map);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const Map& map ///< The Map to add
-	) noexcept
-{
-	size_t index = object_vector.size();
-	object_vector.emplace_back(Object{map});
+				return buffer_.data() + size_;
+			}
 
-	return index;
-}
+			/// Keep \p size bytes of the reserve()'ed space.
+			void commit(const size_t size ///< The number of bytes
+				) noexcept
+			{
+				size_ += size;
+			}
 
+			/// Write a character.
+			void put(const char character ///< The character
+				) noexcept
+			{
+				*reserve(1) = character;
+				size_++;
+			}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/map (copy)")
-{
-	const Object key_1 = Object{true};
-	const Object key_2 = Object{int64_t(0)};
+			/// Write text, text that does not fit in the buffer skips it.
+			void put(const std::string_view text ///< The text
+				) noexcept
+			{
+				if(size_ + text.size() > buffer_.size())
+				{
+					flush();
 
-	const std::string str("Hello, World!");
-	const uint64_t    num(21);
+					if(text.size() > buffer_.size())
+					{
+						sink_(text);
 
-	const Object val_1 = Object{str};
-	const Object val_2 = Object{num};
+						return;
+					}
+				}
 
-	Map map_1;
-	map_1.set(key_1, val_1);
-	map_1.set(key_2, val_2);
+				memcpy(buffer_.data() + size_, text.data(), text.size());
+				size_ += text.size();
+			}
 
-	Map map_2;
-	map_2.set(val_1, key_1);
-	map_2.set(val_2, key_2);
+			/// Pass the contents of the buffer to the sink.
+			void flush() noexcept
+			{
+				if(size_ > 0)
+				{
+					sink_(std::string_view(buffer_.data(), size_));
+					size_ = 0;
+				}
+			}
 
-	size_t count = 0;
-	Array array;
-	array.append((const Map)map_1); count++;
-	array.append((const Map)map_2); count++;
+		private:
+			const JsonSink&   sink_;
+			std::vector<char> buffer_;
+			size_t            size_ = 0;
+	};
 
-	CHECK(map_1.size() == 2);
-	CHECK(map_2.size() == 2);
-	CHECK(array.size() == count);
 
-	// Check serialized data
+	/**
+	 * \brief The JSON escape of each byte.
+	 *
+	 * `0` if the byte does not need to be escaped, `u` if it is escaped as 
+	 * `\u00XX`, otherwise the character that follows the `\`.
+	 */
+	constexpr std::array<char, 256> Json_Escape_ = []() constexpr
+	{
+		std::array<char, 256> table = {};
 
-	std::vector<uint8_t> data = serialize(array);
+		for(size_t i = 0; i < 0x20; i++)
+		{
+			table[i] = 'u';
+		}
 
-	// Check deserialized data
+		table['\b'] = 'b';
+		table['\f'] = 'f';
+		table['\n'] = 'n';
+		table['\r'] = 'r';
+		table['\t'] = 't';
+		table['"']  = '"';
+		table['\\'] = '\\';
 
-	Object object = deserialize(data);
+		return table;
+	}();
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
 
-	size_t index = 0;
-	CHECK(test.object(index).isMap());
-	CHECK(test.object(index).asMap().size() == 2);
-	CHECK(test.object(index).asMap().keyExists(key_1) == true);
-	CHECK(test.object(index).asMap().at(key_1) == val_1);
-	CHECK(test.object(index).asMap().keyExists(key_2) == true);
-	CHECK(test.object(index).asMap().at(key_2) == val_2);
+	constexpr char Json_Hex_[] = "0123456789abcdef";
 
-	index++;
-	CHECK(test.object(index).isMap());
-	CHECK(test.object(index).asMap().size() == 2);
-	CHECK(test.object(index).asMap().keyExists(val_1) == true);
-	CHECK(test.object(index).asMap().at(val_1) == key_1);
-	CHECK(test.object(index).asMap().keyExists(val_2) == true);
-	CHECK(test.object(index).asMap().at(val_2) == key_2);
-}
-#endif // }}}
 
+	/**
+	 * \brief Check 8 bytes for JSON escapes.
+	 *
+	 * \retval true  At least one of the bytes must be escaped.
+	 * \retval false None of the bytes must be escaped.
+	 */
+	constexpr bool jsonEscapeAny_(const uint64_t word ///< 8 bytes
+		) noexcept
+	{
+		constexpr uint64_t Ones = 0x0101010101010101;
+		constexpr uint64_t High = 0x8080808080808080;
 
-/**
- * \brief Append a Map.
- *
- * The \p value will be appended to the contents of this Array.
- *
- * \parcode
- * zakero::messagepack::Map map;
- * map.set(Object{42}, Object{std::string("foo")});
- *
- * zakero::messagepack::Array array;
- * array.append(map);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(Map& map ///< The Map to add
-	) noexcept
-{
-	size_t index = object_vector.size();
-	object_vector.push_back(Object{std::move(map)});
+		const uint64_t quote     = word ^ (Ones * '"');
+		const uint64_t backslash = word ^ (Ones * '\\');
 
-	return index;
-}
+		const uint64_t control    = (word - (Ones * 0x20)) & ~word;
+		const uint64_t has_quote  = (quote - Ones) & ~quote;
+		const uint64_t has_escape = (backslash - Ones) & ~backslash;
 
+		return ((control | has_quote | has_escape) & High) != 0;
+	}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/map (move)")
-{
-	const Object key_1 = Object{true};
-	const Object key_2 = Object{int64_t(0)};
 
-	const std::string str("Hello, World!");
-	const uint64_t    num(21);
+	/**
+	 * \brief Write a JSON string.
+	 */
+	void jsonString_(JsonWriter_& writer ///< The output
+		, const std::string_view text   ///< The string
+		) noexcept
+	{
+		writer.put('"');
 
-	const Object val_1 = Object{str};
-	const Object val_2 = Object{num};
+		size_t begin = 0;
+		size_t index = 0;
 
-	Map map_1;
-	map_1.set(key_1, val_1);
-	map_1.set(key_2, val_2);
+		while(index < text.size())
+		{
+			while(index + sizeof(uint64_t) <= text.size())
+			{
+				uint64_t word;
+				memcpy(&word, text.data() + index, sizeof(uint64_t));
 
-	Map map_2;
-	map_2.set(val_1, key_1);
-	map_2.set(val_2, key_2);
+				if(jsonEscapeAny_(word))
+				{
+					break;
+				}
 
-	size_t count = 0;
-	Array array;
-	array.append(map_1); count++;
-	array.append(map_2); count++;
+				index += sizeof(uint64_t);
+			}
 
-	CHECK(array.size() == count);
-	CHECK(map_1.size() == 0);
-	CHECK(map_2.size() == 0);
+			const size_t end = std::min(index + sizeof(uint64_t), text.size());
 
-	// Check serialized data
+			for(; index < end; index++)
+			{
+				const uint8_t byte   = (uint8_t)text[index];
+				const char    escape = Json_Escape_[byte];
 
-	std::vector<uint8_t> data = serialize(array);
+				if(escape == 0)
+				{
+					continue;
+				}
 
-	// Check deserialized data
+				writer.put(text.substr(begin, index - begin));
+				begin = index + 1;
 
-	Object object = deserialize(data);
+				char* pointer = writer.reserve(6);
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+				pointer[0] = '\\';
+				pointer[1] = escape;
 
-	size_t index = 0;
-	CHECK(test.object(index).isMap());
-	CHECK(test.object(index).asMap().size() == 2);
-	CHECK(test.object(index).asMap().keyExists(key_1) == true);
-	CHECK(test.object(index).asMap().at(key_1) == val_1);
-	CHECK(test.object(index).asMap().keyExists(key_2) == true);
-	CHECK(test.object(index).asMap().at(key_2) == val_2);
+				if(escape != 'u')
+				{
+					writer.commit(2);
+					continue;
+				}
 
-	index++;
-	CHECK(test.object(index).isMap());
-	CHECK(test.object(index).asMap().size() == 2);
-	CHECK(test.object(index).asMap().keyExists(val_1) == true);
-	CHECK(test.object(index).asMap().at(val_1) == key_1);
-	CHECK(test.object(index).asMap().keyExists(val_2) == true);
-	CHECK(test.object(index).asMap().at(val_2) == key_2);
-}
-#endif // }}}
+				pointer[2] = '0';
+				pointer[3] = '0';
+				pointer[4] = Json_Hex_[byte >> 4];
+				pointer[5] = Json_Hex_[byte & 0x0f];
+				writer.commit(6);
+			}
+		}
 
+		writer.put(text.substr(begin));
+		writer.put('"');
+	}
 
-/**
- * \brief Append an Object.
- *
- * The \p value will be appended to the contents of this Array.
- *
- * \parcode
- * const zakero::messagepack::Object object{int8_t(42)};
- * zakero::messagepack::Array array;
- * array.append(object);
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(const Object& object ///< The object to add
-	) noexcept
-{
-	const size_t index = object_vector.size();
 
-	object_vector.push_back(object);
+	/**
+	 * \brief Write a JSON number.
+	 *
+	 * NaN and infinity are not JSON numbers, they are written as `null`.
+	 */
+	template<typename T>
+	void jsonNumber_(JsonWriter_& writer ///< The output
+		, const T             value  ///< The number
+		) noexcept
+	{
+		if constexpr(std::is_floating_point_v<T>)
+		{
+			if(std::isfinite(value) == false)
+			{
+				writer.put("null");
 
-	return index;
-}
+				return;
+			}
+		}
 
+		char* pointer = writer.reserve(JsonWriter_::Reserve_Size);
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/object (copy)")
-{
-	messagepack::Object obj_0 = Object{true};
-	messagepack::Object obj_1 = Object{(uint64_t)42};
-	messagepack::Object obj_2 = Object{std::string("foo")};
+		const std::to_chars_result result = std::to_chars(pointer
+			, pointer + JsonWriter_::Reserve_Size
+			, value
+			);
 
-	const messagepack::Object tmp_0 = obj_0;
-	const messagepack::Object tmp_1 = obj_1;
-	const messagepack::Object tmp_2 = obj_2;
-	size_t count = 0;
+		writer.commit(result.ptr - pointer);
+	}
 
-	Array array;
-	array.append(tmp_0); count++;
-	array.append(tmp_1); count++;
-	array.append(tmp_2); count++;
 
-	CHECK(array.size() == count);
-	CHECK(tmp_0.isNull() == false);
-	CHECK(tmp_1.isNull() == false);
-	CHECK(tmp_2.isNull() == false);
+	/**
+	 * \brief Write binary data.
+	 *
+	 * Base64 and Hex are written as a JSON string, Array is written as an 
+	 * array of numbers. Base64 is padded, Base64_Url is not.
+	 */
+	void jsonBytes_(JsonWriter_&  writer   ///< The output
+		, const std::span<const uint8_t> bytes    ///< The data
+		, const JsonEncoding             encoding ///< The encoding
+		, const bool                     pretty   ///< Add spaces
+		) noexcept
+	{
+		constexpr char Base64[]     = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		constexpr char Base64_Url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
 
-	// Check serialized data
+		switch(encoding)
+		{
+			case JsonEncoding::Array:
+			{
+				writer.put('[');
 
-	std::vector<uint8_t> data = serialize(array);
+				for(size_t i = 0; i < bytes.size(); i++)
+				{
+					if(i > 0)
+					{
+						writer.put(pretty ? ", " : ",");
+					}
 
-	// Check deserialized data
+					jsonNumber_(writer, bytes[i]);
+				}
 
-	Object object = deserialize(data);
+				writer.put(']');
+				break;
+			}
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+			case JsonEncoding::Base64:
+			case JsonEncoding::Base64_Url:
+			{
+				const char* alphabet = (encoding == JsonEncoding::Base64) ? Base64 : Base64_Url;
 
-	size_t index = 0;
-	CHECK(test.object(index).is<bool>());
-	CHECK(test.object(index).as<bool>() == true);
+				// 48 bytes become 64 characters
+				constexpr size_t Chunk = (JsonWriter_::Reserve_Size / 4) * 3;
 
-	index++;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == 42);
+				writer.put('"');
 
-	index++;
-	CHECK(test.object(index).is<std::string>());
-	CHECK(test.object(index).as<std::string>() == "foo");
-}
-#endif // }}}
+				size_t index = 0;
 
+				while(index + 3 <= bytes.size())
+				{
+					const size_t end = index + std::min(Chunk, ((bytes.size() - index) / 3) * 3);
 
-/**
- * \brief Append an Object.
- *
- * The \p value will be appended to the contents of this Array.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * array.append( Object{ int8_t(42) } );
- * \endparcode
- *
- * \return The index location of where the \p value was stored.
- */
-size_t Array::append(Object& object ///< The object to add
-	) noexcept
-{
-	const size_t index = object_vector.size();
+					char* pointer = writer.reserve(JsonWriter_::Reserve_Size);
+					char* output  = pointer;
 
-	object_vector.push_back(std::move(object));
-	object = Object{};
+					for(; index < end; index += 3)
+					{
+						const uint32_t value = (uint32_t(bytes[index]) << 16)
+							| (uint32_t(bytes[index + 1]) << 8)
+							| uint32_t(bytes[index + 2])
+							;
 
-	return index;
-}
+						*output++ = alphabet[(value >> 18) & 0x3f];
+						*output++ = alphabet[(value >> 12) & 0x3f];
+						*output++ = alphabet[(value >>  6) & 0x3f];
+						*output++ = alphabet[value & 0x3f];
+					}
 
+					writer.commit(output - pointer);
+				}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/object (move)")
-{
-	messagepack::Object obj_0 = Object{true};
-	messagepack::Object obj_1 = Object{(uint64_t)42};
-	messagepack::Object obj_2 = Object{std::string("foo")};
+				const size_t remaining = bytes.size() - index;
 
-	messagepack::Object tmp_0 = obj_0;
-	messagepack::Object tmp_1 = obj_1;
-	messagepack::Object tmp_2 = obj_2;
-	size_t count = 0;
+				if(remaining > 0)
+				{
+					const uint32_t value = (uint32_t(bytes[index]) << 16)
+						| ((remaining > 1) ? (uint32_t(bytes[index + 1]) << 8) : 0)
+						;
+
+					writer.put(alphabet[(value >> 18) & 0x3f]);
+					writer.put(alphabet[(value >> 12) & 0x3f]);
+
+					if(remaining > 1)
+					{
+						writer.put(alphabet[(value >> 6) & 0x3f]);
+					}
+
+					if(encoding == JsonEncoding::Base64)
+					{
+						writer.put((remaining > 1) ? "=" : "==");
+					}
+				}
 
-	Array array;
-	array.append(tmp_0); count++;
-	array.append(tmp_1); count++;
-	array.append(tmp_2); count++;
+				writer.put('"');
+				break;
+			}
 
-	CHECK(array.size() == count);
-	CHECK(tmp_0.isNull() == true);
-	CHECK(tmp_1.isNull() == true);
-	CHECK(tmp_2.isNull() == true);
+			case JsonEncoding::Hex:
+			{
+				constexpr size_t Chunk = JsonWriter_::Reserve_Size / 2;
 
-	// Check serialized data
+				writer.put('"');
 
-	std::vector<uint8_t> data = serialize(array);
+				for(size_t index = 0; index < bytes.size(); index += Chunk)
+				{
+					const size_t count = std::min(Chunk, bytes.size() - index);
 
-	// Check deserialized data
-
-	Object object = deserialize(data);
-
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
+					char* pointer = writer.reserve(count * 2);
 
-	size_t index = 0;
-	CHECK(test.object(index).is<bool>());
-	CHECK(test.object(index).as<bool>() == true);
+					for(size_t i = 0; i < count; i++)
+					{
+						pointer[i * 2]     = Json_Hex_[bytes[index + i] >> 4];
+						pointer[i * 2 + 1] = Json_Hex_[bytes[index + i] & 0x0f];
+					}
 
-	index++;
-	CHECK(test.object(index).is<uint64_t>());
-	CHECK(test.object(index).as<uint64_t>() == 42);
+					writer.commit(count * 2);
+				}
 
-	index++;
-	CHECK(test.object(index).is<std::string>());
-	CHECK(test.object(index).as<std::string>() == "foo");
-}
-#endif // }}}
+				writer.put('"');
+				break;
+			}
+		}
+	}
 
 
-/**
- * \brief Append a "Null" value.
- *
- * A "Null" value will be appended to the contents of this Array.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * array.appendNull();
- * \endparcode
- *
- * \return The index location of where the value was stored.
- */
-size_t Array::appendNull() noexcept
-{
-	const size_t index = object_vector.size();
+	/**
+	 * \brief Start a new line.
+	 */
+	void jsonIndent_(JsonWriter_& writer ///< The output
+		, size_t              spaces ///< The indentation
+		) noexcept
+	{
+		writer.put('\n');
 
-	object_vector.emplace_back();
+		while(spaces > 0)
+		{
+			const size_t count = std::min(spaces, JsonWriter_::Reserve_Size);
 
-	return index;
-}
+			memset(writer.reserve(count), ' ', count);
+			writer.commit(count);
 
+			spaces -= count;
+		}
+	}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("array/append/null")
-{
-	const size_t count = std::numeric_limits<uint16_t>::max() + 1;
-	Array array;
 
-	for(size_t i = 0; i < count; i++)
+	/**
+	 * \brief Write a value that is not a container.
+	 *
+	 * The \p header has been read and the \p index is at the data that 
+	 * follows it, the \p index is moved past that data.
+	 */
+	void jsonValue_(JsonWriter_&   writer  ///< The output
+		, const std::span<const uint8_t> data    ///< The packed data
+		, size_t&                        index   ///< The data of the value
+		, const Header_&                 header  ///< The header of the value
+		, const JsonOptions&             options ///< The options
+		) noexcept
 	{
-		array.append(Object{true});
-	}
+		const std::span<const uint8_t> bytes = (header.type == Type_::String
+			|| header.type == Type_::Binary
+			|| header.type == Type_::Ext
+			) ? data.subspan(index, header.value)
+			: std::span<const uint8_t>{}
+			;
 
-	CHECK(array.size() == count);
+		index += bytes.size();
 
-	// Check serialized data
+		switch(header.type)
+		{
+			case Type_::Null:
+				writer.put("null");
+				break;
+
+			case Type_::Bool:
+				writer.put((header.value != 0) ? "true" : "false");
+				break;
+
+			case Type_::Int:
+				jsonNumber_(writer, (int64_t)header.value);
+				break;
+
+			case Type_::Uint:
+				jsonNumber_(writer, header.value);
+				break;
+
+			case Type_::Float:
+				jsonNumber_(writer, std::bit_cast<float>((uint32_t)header.value));
+				break;
+
+			case Type_::Double:
+				jsonNumber_(writer, std::bit_cast<double>(header.value));
+				break;
+
+			case Type_::String:
+				jsonString_(writer, std::string_view((const char*)bytes.data(), bytes.size()));
+				break;
+
+			case Type_::Binary:
+				jsonBytes_(writer, bytes, options.binary, options.pretty);
+				break;
+
+			case Type_::Ext:
+				writer.put(options.pretty ? "{\"type\": " : "{\"type\":");
+				jsonNumber_(writer, (int)header.ext_type);
+				writer.put(options.pretty ? ", \"data\": " : ",\"data\":");
+				jsonBytes_(writer, bytes, options.ext, options.pretty);
+				writer.put('}');
+				break;
+
+			case Type_::Array:
+			case Type_::Map:
+			case Type_::Invalid:
+				break;
+		}
+	}
 
-	std::vector<uint8_t> data = serialize(array);
 
-	// Check deserialized data
+	/**
+	 * \brief The JSON characters of a block of bytes.
+	 *
+	 * Each bit is a byte of the block, the lowest bit is the first byte.
+	 */
+	struct JsonBlock_
+	{
+		uint64_t quote     = 0; ///< `"`
+		uint64_t backslash = 0; ///< `\`
+		uint64_t operators = 0; ///< `{`, `}`, `[`, `]`, `:`, and `,`
+		uint64_t space     = 0; ///< Space, tab, line feed, and carriage return
+	};
 
-	Object object = deserialize(data);
+	/// The number of bytes in a JsonBlock_.
+	constexpr size_t Json_Block_Size_ = 64;
 
-	CHECK(object.isArray());
-	Array& test = object.asArray();
-	CHECK(test.size() == count);
 
-	for(size_t i = 0; i < count; i++)
+	/**
+	 * \brief Find the JSON characters of a block, one byte at a time.
+	 *
+	 * \return The characters.
+	 */
+	JsonBlock_ jsonClassifyScalar_(const uint8_t* block ///< Json_Block_Size_ bytes
+		) noexcept
 	{
-		CHECK(test.object(i).is<bool>());
-		CHECK(test.object(i).as<bool>() == true);
-	}
-}
-#endif // }}}
+		JsonBlock_ result;
 
+		for(size_t i = 0; i < Json_Block_Size_; i++)
+		{
+			const uint64_t bit = uint64_t(1) << i;
 
-/**
- * \fn zakero::messagepack::Array::object(const size_t)
- *
- * \brief Access a data object.
- *
- * After data has been added to the Array, that data can still be access by 
- * using its index value. The data object's type will be the C++ datatype, not 
- * the MessagePack format type.
- *
- * The returned Object can be modified as needed.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * size_t index_foo = array.append(int64_t(0));
- * size_t index_bar = array.append(int64_t(0));
- *
- * int64_t val = rand();
- * array.object(index_foo) = val;
- * if(val & 1)
- * {
- *      // Change to string
- * 	array.object(index_bar) = "That's odd...";
- * }
- * else
- * {
- *      // Change to boolean
- * 	array.object(index_bar) = true;
- * }
- * \endparcode
- *
- * \return The data object.
- *
- * \param  index  The index of the data object.
- */
+			switch(block[i])
+			{
+				case '"':
+					result.quote |= bit;
+					break;
 
+				case '\\':
+					result.backslash |= bit;
+					break;
 
-// No tests needed, functionality is tested else where.
+				case '{': case '}': case '[': case ']': case ':': case ',':
+					result.operators |= bit;
+					break;
 
+				case ' ': case '\t': case '\n': case '\r':
+					result.space |= bit;
+					break;
+			}
+		}
 
-/**
- * \fn zakero::messagepack::Array::object(const size_t) const
- *
- * \brief Access a data object.
- *
- * After data has been added to the Array, that data can still be access by 
- * using its index value. The data object's type will be the C++ datatype, not 
- * the MessagePack format type.
- *
- * The returned Object is Read-Only.
- *
- * \parcode
- * zakero::messagepack::Array array;
- * size_t index_foo = array.append(int64_t(0));
- * size_t index_bar = array.append(int64_t(0));
- *
- * int64_t val = rand();
- * if(array.object(index_foo) > val)
- * {
- * 	std::cout << "Foo Bigger\n";
- * }
- *
- * if(array.object(index_bar) > val)
- * {
- * 	std::cout << "Bar Bigger\n";
- * }
- * \endparcode
- *
- * \return The data object.
- *
- * \param  index  The index of the data object.
- */
+		return result;
+	}
 
+#if defined(__x86_64__) || defined(__i386__)
 
-// No tests needed, functionality is tested else where.
+	/**
+	 * \brief Find the JSON characters of a block using SSE2.
+	 *
+	 * Setting bit 5 turns `[` and `]` into `{` and `}`, so the four brackets 
+	 * only need two compares.
+	 *
+	 * \see jsonClassifyScalar_()
+	 *
+	 * \return The characters.
+	 */
+	__attribute__((target("sse2")))
+	JsonBlock_ jsonClassifySse2_(const uint8_t* block ///< Json_Block_Size_ bytes
+		) noexcept
+	{
+		JsonBlock_ result;
 
+		for(size_t i = 0; i < Json_Block_Size_; i += 16)
+		{
+			const __m128i bytes = _mm_loadu_si128((const __m128i*)(block + i));
+			const __m128i lower = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
 
-/**
- * \fn zakero::messagepack::Array::clear()
- *
- * \brief Remove all data from the Array.
- *
- * Remove all data from the Array.
- */
+			const __m128i quote     = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('"'));
+			const __m128i backslash = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'));
 
+			const __m128i operators = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}')))
+				, _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(':')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(',')))
+				);
 
-// No tests needed, a pass-thru to the std::vector<Object>.
+			const __m128i space = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t')))
+				, _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r')))
+				);
 
+			result.quote     |= (uint64_t)(uint16_t)_mm_movemask_epi8(quote)     << i;
+			result.backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(backslash) << i;
+			result.operators |= (uint64_t)(uint16_t)_mm_movemask_epi8(operators) << i;
+			result.space     |= (uint64_t)(uint16_t)_mm_movemask_epi8(space)     << i;
+		}
 
-/**
- * \fn zakero::messagepack::Array::size()
- *
- * \brief Get the size of the Array.
- *
- * \return The Array size.
- */
+		return result;
+	}
 
 
-// No tests needed, a pass-thru to the std::vector<Object>.
+	/**
+	 * \brief Find the JSON characters of a block using AVX2.
+	 *
+	 * \see jsonClassifySse2_()
+	 *
+	 * \return The characters.
+	 */
+	__attribute__((target("avx2")))
+	JsonBlock_ jsonClassifyAvx2_(const uint8_t* block ///< Json_Block_Size_ bytes
+		) noexcept
+	{
+		JsonBlock_ result;
 
-// }}} Array
-// {{{ Ext
+		for(size_t i = 0; i < Json_Block_Size_; i += 32)
+		{
+			const __m256i bytes = _mm256_loadu_si256((const __m256i*)(block + i));
+			const __m256i lower = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
 
-/**
- * \struct Ext
- *
- * \brief Extension Data.
- *
- * The MessagePack specification defines a structure to hold new data-types and 
- * this structure implements that feature. To add a new data-type, set the 
- * Ext::type to a positive value and then fill the Ext::data with the 
- * information to be stored.
- *
- * \note Negative Ext::type value are reserved for use by the MessagePack 
- * specification.
- *
- * As an example, to add a GIF data-type, define the type value then fill the 
- * Ext::data with the GIF.
- * 
- * \parcode
- * #define TYPE_GIF    2
- * #define INDEX_NAME  0
- * #define INDEX_FILE  1
- * #define INDEX_IMAGE 2
- *
- * zakero::messagepack::Array array = {};
- * array.append({std::string_view("Super-Sonic Scooter")});
- * array.append({std::string_view("super_sonic_scooter.gif")});
- *
- * zakero::messagepack::Ext gif = {};
- * gif.type = TYPE_GIF;
- * gif.data = loadGif("super_sonic_scooter.gif");
- * array.append(gif);
- *
- * auto data = zakero::messagepack::serialize(array);
- *
- * // ...somewhere later...
- *
- * zakero::messagepack::Object object = zakero::messagepack::deserialize(data);
- * zakero::messagepack::Array image = object.asArray();
- *
- * std::string image_name = image.object(INDEX_NAME).asString();
- * std::string image_file = image.object(INDEX_FILE).asString();
- *
- * zakero::messagepack::Ext raw_data = image.object(INDEX_IMAGE).asExt();
- * Image image;
- * if(raw_data.type == TYPE_GIF)
- * {
- * 	image = parseGif(raw_data.data);
- * }
- * \endparcode
- */
+			const __m256i quote     = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"'));
+			const __m256i backslash = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'));
 
-/**
- * \var Ext::data
- *
- * \brief Extension binary data.
- */
+			const __m256i operators = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}')))
+				, _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(',')))
+				);
 
-/**
- * \var Ext::type
- *
- * \brief A unique identifier for the extension.
- */
+			const __m256i space = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t')))
+				, _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r')))
+				);
 
-// }}} Ext
-// {{{ Map
+			result.quote     |= (uint64_t)(uint32_t)_mm256_movemask_epi8(quote)     << i;
+			result.backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(backslash) << i;
+			result.operators |= (uint64_t)(uint32_t)_mm256_movemask_epi8(operators) << i;
+			result.space     |= (uint64_t)(uint32_t)_mm256_movemask_epi8(space)     << i;
+		}
 
-/**
- * \struct Map
- *
- * \brief A Key/Value collection of Objects.
- *
- * The MessagePack specification allows any Object to be the "key" of a map.  
- * As interesting as it would be to having a Map as the key to another Map, 
- * programmatically, it is not practical. This implementation limits the types 
- * of the "keys" to include all MessagePack types __except__ Array, Binary, 
- * Ext, and Map.
- *
- * The Map uses several std::map's to hold the "values". While it is possible 
- * to directly access these std::map's, it is recommended to use Map's methods 
- * since they ensure the uniqueness of the key and other checks.
- *
- * Objects can be tested to find out if they are Map by using Object::isMap() 
- * and converted into a Map with Object::asMap(). A Map can not be converted 
- * into an Object. However, an Object can be constructed using a Map.
- */
-
-/**
- * \brief Set a key/value pair.
- *
- * The provided \p key / \p value pair will be added to the Map. If the \p key 
- * already exists, its value will be replaced with \p value.
- *
- * \parcode
- * zakero::messagepack::Map map;
- *
- * map.set({std::string("Error Code")}   , {uint64_t(42)});
- * map.set({std::string("Error Message")}, {std::string("All the errors!")});
- * \endparcode
- *
- * \return An error code.
- */
-std::error_code Map::set(const Object& key   ///< The key
-	, const Object&                value ///< The value
-	) noexcept
-{
-	if(keyExists(key))
-	{
-		erase(key);
+		return result;
 	}
 
-	if(key.isNull())
-	{
-		null_map.clear();
-		null_map.push_back(value);
-	}
-	else if(key.is<bool>())
-	{
-		bool_map[key.as<bool>()] = value;
-	}
-	else if(key.is<int64_t>())
-	{
-		int64_map[key.as<int64_t>()] = value;
-	}
-	else if(key.is<uint64_t>())
+#endif
+
+	/**
+	 * \brief The SIMD instructions that jsonClassify_() will use.
+	 *
+	 * The CPU is only checked once.
+	 *
+	 * \retval 0 Scalar code
+	 * \retval 1 SSE2
+	 * \retval 2 AVX2
+	 */
+	int jsonClassifyLevel_() noexcept
 	{
-		uint64_map[key.as<uint64_t>()] = value;
+#if defined(__x86_64__) || defined(__i386__)
+		static const int level = __builtin_cpu_supports("avx2") ? 2
+			: __builtin_cpu_supports("sse2") ? 1
+			: 0;
+
+		return level;
+#else
+		return 0;
+#endif
 	}
-	else if(key.is<float>())
+
+
+	/**
+	 * \brief Find the JSON characters of a block.
+	 *
+	 * The fastest version of jsonClassifyScalar_() that the CPU supports will 
+	 * be used. All versions find the same characters.
+	 *
+	 * \return The characters.
+	 */
+	JsonBlock_ jsonClassify_(const uint8_t* block ///< Json_Block_Size_ bytes
+		) noexcept
 	{
-		float_map[key.as<float>()] = value;
+#if defined(__x86_64__) || defined(__i386__)
+		switch(jsonClassifyLevel_())
+		{
+			case 2: return jsonClassifyAvx2_(block);
+			case 1: return jsonClassifySse2_(block);
+		}
+#endif
+
+		return jsonClassifyScalar_(block);
 	}
-	else if(key.is<double>())
+
+
+	/**
+	 * \brief Flip all the bits after each set bit.
+	 *
+	 * Given the quotes of a block, the result has the bits from each opening 
+	 * quote up to, but not including, each closing quote.
+	 *
+	 * \return The bits.
+	 */
+	constexpr uint64_t jsonPrefixXor_(uint64_t bits ///< The bits
+		) noexcept
 	{
-		double_map[key.as<double>()] = value;
+		bits ^= bits << 1;
+		bits ^= bits << 2;
+		bits ^= bits << 4;
+		bits ^= bits << 8;
+		bits ^= bits << 16;
+		bits ^= bits << 32;
+
+		return bits;
 	}
-	else if(key.is<std::string>())
+
+
+	/**
+	 * \brief Find the tokens of JSON text.
+	 *
+	 * The \p text is classified a block at a time and the position of every 
+	 * token is added to the \p token_vector:
+	 * - The operators `{`, `}`, `[`, `]`, `:`, and `,`
+	 * - The opening `"` of a string
+	 * - The first character of a number, `true`, `false`, and `null`
+	 *
+	 * Characters that are escaped by a `\` are found with carries instead of 
+	 * looking at each `\` and the bytes in strings are found with 
+	 * jsonPrefixXor_(), so there are no branches that depend on the text.
+	 *
+	 * \retval Error_None       The tokens were found.
+	 * \retval Error_Incomplete A string is not closed.
+	 * \retval Error_Size_Limit The \p text is 4GB or larger.
+	 *
+	 * \return An error code.
+	 */
+	std::error_code jsonTokens_(const std::string_view text         ///< The JSON text
+		, std::vector<uint32_t>&                   token_vector ///< The token positions
+		) noexcept
 	{
-		string_map[key.as<std::string>()] = value;
-	}
+		constexpr uint64_t Even_Bits = 0x5555555555555555;
 
-	return Error_Invalid_Format_Type;
-}
+		if(text.size() >= std::numeric_limits<uint32_t>::max())
+		{
+			return Error_Size_Limit;
+		}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("map/set (copy)")
-{
-	const Object key_null  = {};
-	const Object key_zero  = {int64_t(0)};
-	const Object val_null  = {};
-	const Object val_zero  = {int64_t(0)};
+		token_vector.clear();
 
-	Map map;
+		uint8_t  last_block[Json_Block_Size_];
+		uint64_t prev_escaped   = 0;
+		uint64_t prev_in_string = 0;
+		uint64_t prev_scalar    = 0;
 
-	SUBCASE("Same Key, Same Value")
-	{
-		map.set(key_null, val_null);
-		CHECK(map.size() == 1);
-		const Object& obj_1 = map.at(key_null);
-		CHECK(obj_1  == val_null);
-		CHECK(&obj_1 != &val_null);
+		for(size_t offset = 0; offset < text.size(); offset += Json_Block_Size_)
+		{
+			const uint8_t* block = (const uint8_t*)text.data() + offset;
 
-		map.set(key_null, val_null);
-		CHECK(map.size() == 1);
-		const Object& obj_2 = map.at(key_null);
-		CHECK(obj_2  == val_null);
-		CHECK(&obj_2 != &val_null);
-	}
+			if(text.size() - offset < Json_Block_Size_)
+			{
+				memset(last_block, ' ', Json_Block_Size_);
+				memcpy(last_block, block, text.size() - offset);
+				block = last_block;
+			}
 
-	SUBCASE("Same Key, Differnt Value")
-	{
-		map.set(key_null, val_null);
-		CHECK(map.size() == 1);
-		const Object& obj_1 = map.at(key_null);
-		CHECK(obj_1 == val_null);
+			const JsonBlock_ found = jsonClassify_(block);
 
-		map.set(key_null, val_zero);
-		CHECK(map.size() == 1);
-		const Object& obj_2 = map.at(key_null);
-		CHECK(obj_2 == val_zero);
-	}
+			// A run of backslashes escapes every other character, the 
+			// character after an odd length run is escaped.
+			const uint64_t backslash      = found.backslash & ~prev_escaped;
+			const uint64_t follows_escape = (backslash << 1) | prev_escaped;
+			const uint64_t odd_starts     = backslash & ~Even_Bits & ~follows_escape;
 
-	SUBCASE("Different Key, Same Value")
-	{
-		map.set(key_null, val_null);
-		map.set(key_zero, val_null);
-		CHECK(map.size() == 2);
+			uint64_t even_runs = 0;
+			prev_escaped = __builtin_add_overflow(odd_starts, backslash, &even_runs);
 
-		const Object& obj_1 = map.at(key_null);
-		CHECK(obj_1 == val_null);
+			const uint64_t escaped = (Even_Bits ^ (even_runs << 1)) & follows_escape;
 
-		const Object& obj_2 = map.at(key_zero);
-		CHECK(obj_2 == val_null);
-	}
+			const uint64_t quote     = found.quote & ~escaped;
+			const uint64_t in_string = jsonPrefixXor_(quote) ^ prev_in_string;
+			prev_in_string = (uint64_t)((int64_t)in_string >> 63);
 
-	SUBCASE("Different Key, Different Value")
-	{
-		map.set(key_null, val_null);
-		map.set(key_zero, val_zero);
-		CHECK(map.size() == 2);
+			// Everything in a string after the opening quote
+			const uint64_t string_tail = in_string ^ quote;
 
-		const Object& obj_1 = map.at(key_null);
-		CHECK(obj_1 == val_null);
+			const uint64_t scalar          = ~(found.operators | found.space);
+			const uint64_t nonquote_scalar = scalar & ~quote;
+			const uint64_t follows_scalar  = (nonquote_scalar << 1) | prev_scalar;
+			prev_scalar = nonquote_scalar >> 63;
 
-		const Object& obj_2 = map.at(key_zero);
-		CHECK(obj_2 == val_zero);
-	}
-}
-#endif // }}}
+			uint64_t tokens = (found.operators | (scalar & ~follows_scalar)) & ~string_tail;
 
+			const size_t size = token_vector.size();
+			token_vector.resize(size + std::popcount(tokens));
 
-/**
- * \brief Set a key/value pair.
- *
- * The provided \p key / \p value pair will be added to the Map. If the \p key 
- * already exists, its value will be replaced with \p value.
- *
- * \parcode
- * zakero::messagepack::Map map;
- *
- * map.set({std::string("Error Code")}   , {uint64_t(42)});
- * map.set({std::string("Error Message")}, {std::string("All the errors!")});
- * \endparcode
- *
- * \return An error code.
- */
-std::error_code Map::set(Object& key   ///< The key
-	, Object&                value ///< The value
-	) noexcept
-{
-	if(keyExists(key))
-	{
-		erase(key);
-	}
+			uint32_t* position = token_vector.data() + size;
 
-	if(key.isNull())
-	{
-		null_map.clear();
-		null_map.push_back(value);
-	}
-	else if(key.is<bool>())
-	{
-		bool_map[key.as<bool>()] = value;
-	}
-	else if(key.is<int64_t>())
-	{
-		int64_map[key.as<int64_t>()] = value;
-	}
-	else if(key.is<uint64_t>())
-	{
-		uint64_map[key.as<uint64_t>()] = value;
-	}
-	else if(key.is<float>())
-	{
-		float_map[key.as<float>()] = value;
-	}
-	else if(key.is<double>())
-	{
-		double_map[key.as<double>()] = value;
+			while(tokens != 0)
+			{
+				*position++ = (uint32_t)(offset + std::countr_zero(tokens));
+				tokens &= tokens - 1;
+			}
+		}
+
+		if(prev_in_string != 0)
+		{
+			return Error_Incomplete;
+		}
+
+		return Error_None;
 	}
-	else if(key.is<std::string>())
+
+
+	/**
+	 * \brief Check the grammar of the JSON tokens.
+	 *
+	 * MessagePack containers start with the number of elements, so the number 
+	 * of elements of each JSON array and object is added to the \p 
+	 * count_vector, in the order that the containers start. The tokens are 
+	 * walked with a stack, not recursion.
+	 *
+	 * \retval Error_None         The tokens are valid.
+	 * \retval Error_No_Data      There are no tokens.
+	 * \retval Error_Incomplete   The JSON value is not complete.
+	 * \retval Error_Invalid_Json A token is not valid where it was found.
+	 *
+	 * \return An error code.
+	 */
+	std::error_code jsonCount_(const std::string_view text         ///< The JSON text
+		, const std::vector<uint32_t>&            token_vector ///< The token positions
+		, std::vector<uint32_t>&                  count_vector ///< The element counts
+		) noexcept
 	{
-		string_map[key.as<std::string>()] = value;
-	}
+		enum class Expect : uint8_t
+		{	Value
+		,	Key
+		,	Colon
+		,	Next
+		};
 
-	return Error_Invalid_Format_Type;
-}
+		struct Frame
+		{
+			size_t count;
+			bool   map;
+		};
 
+		count_vector.clear();
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("map/set")
-{
-	Object key_true = Object{true};
-	Object key_zero = Object{int64_t(0)};
-	Object val_true = Object{true};
-	Object val_zero = Object{int64_t(0)};
+		if(token_vector.empty())
+		{
+			return Error_No_Data;
+		}
 
-	Map map;
+		std::vector<Frame> stack;
+		Expect             expect = Expect::Value;
+		bool               first  = false;
 
-	SUBCASE("Same Key, Same Value")
-	{
-		map.set(key_true, val_true);
-		CHECK(map.size() == 1);
+		for(const uint32_t position : token_vector)
+		{
+			const char token = text[position];
 
-		Object& obj_1 = map.at(key_true);
-		CHECK(obj_1 == val_true);
-		obj_1 = {val_zero};
-		CHECK(map.at(key_true) == val_zero);
+			switch(expect)
+			{
+				case Expect::Value:
+					if(token == ']' && first)
+					{
+						stack.pop_back();
+						expect = Expect::Next;
+						break;
+					}
+
+					// Map entries are counted by their key
+					if(stack.empty() == false && stack.back().map == false)
+					{
+						count_vector[stack.back().count]++;
+					}
+
+					switch(token)
+					{
+						case '{':
+						case '[':
+							stack.push_back({count_vector.size(), token == '{'});
+							count_vector.push_back(0);
+							expect = (token == '{') ? Expect::Key : Expect::Value;
+							first  = true;
+							break;
+
+						case '}': case ']': case ':': case ',':
+							return Error_Invalid_Json;
+
+						default:
+							expect = Expect::Next;
+					}
+					break;
+
+				case Expect::Key:
+					if(token == '}' && first)
+					{
+						stack.pop_back();
+						expect = Expect::Next;
+						break;
+					}
+
+					if(token != '"')
+					{
+						return Error_Invalid_Json;
+					}
+
+					count_vector[stack.back().count]++;
+					expect = Expect::Colon;
+					break;
+
+				case Expect::Colon:
+					if(token != ':')
+					{
+						return Error_Invalid_Json;
+					}
+
+					expect = Expect::Value;
+					first  = false;
+					break;
+
+				case Expect::Next:
+					if(stack.empty())
+					{
+						return Error_Invalid_Json;
+					}
+
+					if(token == ',')
+					{
+						expect = stack.back().map ? Expect::Key : Expect::Value;
+						first  = false;
+						break;
+					}
+
+					if(token != (stack.back().map ? '}' : ']'))
+					{
+						return Error_Invalid_Json;
+					}
+
+					stack.pop_back();
+					break;
+			}
+		}
 
-		map.set(key_true, val_zero);
-		CHECK(map.size() == 1);
+		if(stack.empty() == false || expect != Expect::Next)
+		{
+			return Error_Incomplete;
+		}
 
-		Object& obj_2 = map.at(key_true);
-		CHECK(obj_2 == val_zero);
+		return Error_None;
 	}
 
-	SUBCASE("Same Key, Differnt Value")
+
+	/**
+	 * \brief Read the 4 hex digits of a `\u` escape.
+	 *
+	 * \retval true  The \p value was read.
+	 * \retval false The digits are not valid.
+	 */
+	bool jsonHex4_(const std::string_view text  ///< The JSON text
+		, const size_t                index ///< The first digit
+		, uint32_t&                   value ///< The value
+		) noexcept
 	{
-		map.set(key_true, val_true);
-		CHECK(map.size() == 1);
+		if(index + 4 > text.size())
+		{
+			return false;
+		}
 
-		CHECK(map.at(key_true) == val_true);
+		const std::from_chars_result result = std::from_chars(text.data() + index
+			, text.data() + index + 4
+			, value
+			, 16
+			);
 
-		map.set(key_true, val_zero);
-		CHECK(map.size() == 1);
-		CHECK(map.at(key_true) == val_zero);
+		return result.ec == std::errc{}
+			&& result.ptr == text.data() + index + 4
+			;
 	}
 
-	SUBCASE("Different Key, Same Value")
+
+	/**
+	 * \brief Add a code point to a string as UTF-8.
+	 */
+	void jsonUtf8_(std::string& string ///< The string
+		, const uint32_t    code   ///< The code point
+		) noexcept
 	{
-		map.set(key_true, val_true);
-		map.set(key_zero, val_true);
-		CHECK(map.size() == 2);
-		CHECK(map.at(key_true) == val_true);
-		CHECK(map.at(key_zero) == val_true);
+		if(code < 0x80)
+		{
+			string += (char)code;
+		}
+		else if(code < 0x800)
+		{
+			string += (char)(0xc0 | (code >> 6));
+			string += (char)(0x80 | (code & 0x3f));
+		}
+		else if(code < 0x10000)
+		{
+			string += (char)(0xe0 | (code >> 12));
+			string += (char)(0x80 | ((code >> 6) & 0x3f));
+			string += (char)(0x80 | (code & 0x3f));
+		}
+		else
+		{
+			string += (char)(0xf0 | (code >> 18));
+			string += (char)(0x80 | ((code >> 12) & 0x3f));
+			string += (char)(0x80 | ((code >> 6) & 0x3f));
+			string += (char)(0x80 | (code & 0x3f));
+		}
 	}
 
-	SUBCASE("Different Key, Different Value")
-	{
-		map.set(key_true, val_true);
-		map.set(key_zero, val_zero);
-		CHECK(map.size() == 2);
-		CHECK(map.at(key_true) == val_true);
-		CHECK(map.at(key_zero) == val_zero);
-	}
-}
-#endif // }}}
 
-
-/**
- * \brief Erase a key/value pair.
- *
- * If the specified \p key exists, the \p key and matching value will be 
- * removed frame the Map.
- *
- * \parcode
- * zakero::messagepack::Map map;
- *
- * // What is true?
- * map.set({true}, {uint64_t(123456)});
- *
- * // Truth can not be defined...
- * map.erase({true});
- * \endparcode
- */
-void Map::erase(const Object& key ///< The key
-	) noexcept
-{
-	if(key.isNull())
-	{
-		null_map.clear();
-	}
-	else if(key.is<bool>())
-	{
-		bool_map.erase(key.as<bool>());
-	}
-	else if(key.is<int64_t>())
-	{
-		int64_map.erase(key.as<int64_t>());
-	}
-	else if(key.is<uint64_t>())
-	{
-		uint64_map.erase(key.as<uint64_t>());
-	}
-	else if(key.is<float>())
-	{
-		float_map.erase(key.as<float>());
-	}
-	else if(key.is<double>())
+	/**
+	 * \brief Find the end of the bytes that are copied as-is.
+	 *
+	 * Like jsonString_(), 8 bytes are checked at a time.
+	 *
+	 * \return The index of the first `"`, `\`, or control character.
+	 */
+	size_t jsonPlainEnd_(const std::string_view text  ///< The JSON text
+		, size_t                            index ///< Where to start
+		) noexcept
 	{
-		double_map.erase(key.as<double>());
+		while(index + sizeof(uint64_t) <= text.size())
+		{
+			uint64_t word;
+			memcpy(&word, text.data() + index, sizeof(uint64_t));
+
+			if(jsonEscapeAny_(word))
+			{
+				break;
+			}
+
+			index += sizeof(uint64_t);
+		}
+
+		while(index < text.size() && Json_Escape_[(uint8_t)text[index]] == 0)
+		{
+			index++;
+		}
+
+		return index;
 	}
-	else if(key.is<std::string>())
+
+
+	/**
+	 * \brief Read a JSON string.
+	 *
+	 * A string without escapes is not copied, the \p result refers to the \p 
+	 * text. Otherwise the string is decoded into the \p scratch.
+	 *
+	 * \retval Error_None         The string was read.
+	 * \retval Error_Incomplete   The string is not closed.
+	 * \retval Error_Invalid_Json The string has a control character or an 
+	 *                            invalid escape.
+	 *
+	 * \return An error code.
+	 */
+	std::error_code jsonStringRead_(const std::string_view text    ///< The JSON text
+		, const size_t                               begin   ///< The opening quote
+		, std::string&                               scratch ///< The decoded string
+		, std::string_view&                          result  ///< The string
+		) noexcept
 	{
-		string_map.erase(key.as<std::string>());
-	}
-}
+		size_t index = jsonPlainEnd_(text, begin + 1);
 
+		if(index < text.size() && text[index] == '"')
+		{
+			result = text.substr(begin + 1, index - begin - 1);
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("map/erase")
-{
-	Object key_nope = Object{};
-	Object key_true = Object{true};
-	Object key_zero = Object{int64_t(0)};
-	Object val_null = Object{};
+			return Error_None;
+		}
 
-	Map map;
+		scratch.assign(text.data() + begin + 1, index - begin - 1);
 
-	map.erase(key_nope); // Nothing should happen
+		while(index < text.size())
+		{
+			const char character = text[index];
 
-	map.set(key_true, val_null);
-	map.set(key_zero, val_null);
-	CHECK(map.keyExists(key_true) == true);
-	CHECK(map.keyExists(key_zero) == true);
+			if(character == '"')
+			{
+				result = scratch;
 
-	map.erase(key_nope); // Nothing should happen
-	CHECK(map.size() == 2);
+				return Error_None;
+			}
 
-	map.erase(key_true);
-	CHECK(map.size() == 1);
-	CHECK(map.keyExists(key_true) == false);
-	CHECK(map.keyExists(key_zero) == true);
+			if(character != '\\' || index + 1 >= text.size())
+			{
+				return (character == '\\') ? Error_Incomplete : Error_Invalid_Json;
+			}
 
-	map.erase(key_true);
-	CHECK(map.size() == 1);
-	CHECK(map.keyExists(key_true) == false);
-	CHECK(map.keyExists(key_zero) == true);
+			const char escape = text[index + 1];
+			index += 2;
 
-	map.erase(key_zero);
-	CHECK(map.size() == 0);
-	CHECK(map.keyExists(key_true) == false);
-	CHECK(map.keyExists(key_zero) == false);
+			switch(escape)
+			{
+				case '"':  scratch += '"';  break;
+				case '\\': scratch += '\\'; break;
+				case '/':  scratch += '/';  break;
+				case 'b':  scratch += '\b'; break;
+				case 'f':  scratch += '\f'; break;
+				case 'n':  scratch += '\n'; break;
+				case 'r':  scratch += '\r'; break;
+				case 't':  scratch += '\t'; break;
+
+				case 'u':
+				{
+					uint32_t code = 0;
+
+					if(jsonHex4_(text, index, code) == false)
+					{
+						return Error_Invalid_Json;
+					}
+
+					index += 4;
+
+					if(code >= 0xdc00 && code <= 0xdfff)
+					{
+						return Error_Invalid_Json;
+					}
+
+					if(code >= 0xd800 && code <= 0xdbff)
+					{
+						uint32_t low = 0;
+
+						if(text.substr(index, 2) != "\\u"
+							|| jsonHex4_(text, index + 2, low) == false
+							|| low < 0xdc00
+							|| low > 0xdfff
+							)
+						{
+							return Error_Invalid_Json;
+						}
+
+						index += 6;
+						code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+					}
+
+					jsonUtf8_(scratch, code);
+					break;
+				}
 
-	map.erase(key_zero);
-	CHECK(map.size() == 0);
-	CHECK(map.keyExists(key_true) == false);
-	CHECK(map.keyExists(key_zero) == false);
-}
-#endif // }}}
+				default:
+					return Error_Invalid_Json;
+			}
 
+			const size_t end = jsonPlainEnd_(text, index);
 
-/**
- * \brief Check if a key exists.
- *
- * Search the Map and return \true if the \p key exists. If the \p key was not 
- * found, return \false.
- *
- * \parcode
- * zakero::messagepack::Map map;
- *
- * map.set(Object{}, Object{});
- * if(map.keyExists(Object{}))
- * {
- * 	// In the Key of Null
- * }
- * \endparcode
- *
- * \retval true  The key exists.
- * \retval false The key does not exist.
- */
-bool Map::keyExists(const Object& key ///< The key Object
-	) const noexcept
-{
-	if(key.isNull())
-	{
-		return (null_map.empty() == false);
-	}
-	else if(key.is<bool>())
-	{
-		return bool_map.contains(key.as<bool>());
-	}
-	else if(key.is<int64_t>())
-	{
-		return int64_map.contains(key.as<int64_t>());
-	}
-	else if(key.is<uint64_t>())
-	{
-		return uint64_map.contains(key.as<uint64_t>());
-	}
-	else if(key.is<float>())
-	{
-		return float_map.contains(key.as<float>());
-	}
-	else if(key.is<double>())
-	{
-		return double_map.contains(key.as<double>());
+			scratch.append(text.data() + index, end - index);
+			index = end;
+		}
+
+		return Error_Incomplete;
 	}
-	else if(key.is<std::string>())
+
+
+	/**
+	 * \brief Pack a JSON number, `true`, `false`, or `null`.
+	 *
+	 * Integers that fit in an `int64_t` are packed with Packer::packInt(), 
+	 * larger positive integers with Packer::packUint(), everything else is a 
+	 * `double`. Like JavaScript, numbers too large for a `double` become 
+	 * infinity and numbers too small become zero.
+	 *
+	 * \retval Error_Invalid_Json The \p atom is not valid.
+	 *
+	 * \return An error code.
+	 */
+	std::error_code jsonAtom_(const std::string_view atom   ///< The text
+		, Packer&                             packer ///< The output
+		) noexcept
 	{
-		return string_map.contains(key.as<std::string>());
-	}
+		switch(atom[0])
+		{
+			case 't': return (atom == "true")  ? packer.packBool(true)  : Error_Invalid_Json;
+			case 'f': return (atom == "false") ? packer.packBool(false) : Error_Invalid_Json;
+			case 'n': return (atom == "null")  ? packer.packNull()      : Error_Invalid_Json;
+		}
 
-	return false;
-}
+		auto is_digit = [](const char character)
+		{
+			return character >= '0' && character <= '9';
+		};
 
+		const bool negative = (atom[0] == '-');
+		size_t     index    = negative ? 1 : 0;
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("map/keyexists")
-{
-	const Object key_true = Object{true};
-	const Object key_zero = Object{int64_t(0)};
-	const Object val_null = Object{};
+		// The decimal exponent of the first digit, to tell overflow from 
+		// underflow.
+		int64_t magnitude = -1;
 
-	Map map;
+		if(index < atom.size() && atom[index] == '0')
+		{
+			index++;
+		}
+		else if(index < atom.size() && is_digit(atom[index]))
+		{
+			while(index < atom.size() && is_digit(atom[index]))
+			{
+				index++;
+				magnitude++;
+			}
+		}
+		else
+		{
+			return Error_Invalid_Json;
+		}
 
-	CHECK(map.size() == 0);
-	CHECK(map.keyExists(key_true) == false);
-	CHECK(map.keyExists(key_zero) == false);
+		const size_t integer_end = index;
 
-	map.set(key_true, val_null);
-	CHECK(map.keyExists(key_true) == true);
-	CHECK(map.keyExists(key_zero) == false);
+		if(index < atom.size() && atom[index] == '.')
+		{
+			const size_t fraction = ++index;
+			bool         zero     = (magnitude < 0);
 
-	map.set(key_zero, val_null);
-	CHECK(map.keyExists(key_true) == true);
-	CHECK(map.keyExists(key_zero) == true);
-}
-#endif // }}}
+			while(index < atom.size() && is_digit(atom[index]))
+			{
+				zero = zero && (atom[index] == '0');
 
+				if(zero)
+				{
+					magnitude--;
+				}
 
-/**
- * \brief Get the value of a key.
- *
- * The value associated with the provided \p key will be returned. If the \p 
- * key does not exist, then a reference to the \p key will be returned.
- *
- * \parcode
- * zakero::messagepack::Map map;
- *
- * map.set(Object{uint64_t(42)}, Object{std::string("The Answer"});
- *
- * const zakero::messagepack::Object key = Object{true};
- * const zakero::messagepack::Object& object = map.at({true});
- *
- * if(&object == &key)
- * {
- * 	// key not found
- * }
- * \endparcode
- *
- * \return The value.
- */
-const Object& Map::at(const Object& key ///< The key
-	) const noexcept
-{
-	if(keyExists(key) == false)
-	{
-		return key;
-	}
+				index++;
+			}
 
-	if(key.isNull())
-	{
-		return null_map.at(0);
-	}
-	else if(key.is<bool>())
-	{
-		return bool_map.at(key.as<bool>());
-	}
-	else if(key.is<int64_t>())
-	{
-		return int64_map.at(key.as<int64_t>());
-	}
-	else if(key.is<uint64_t>())
-	{
-		return uint64_map.at(key.as<uint64_t>());
-	}
-	else if(key.is<float>())
-	{
-		return float_map.at(key.as<float>());
-	}
-	else if(key.is<double>())
-	{
-		return double_map.at(key.as<double>());
-	}
-	else if(key.is<std::string>())
-	{
-		return string_map.at(key.as<std::string>());
-	}
+			if(index == fraction)
+			{
+				return Error_Invalid_Json;
+			}
+		}
 
-	return key;
-}
+		if(index < atom.size() && (atom[index] == 'e' || atom[index] == 'E'))
+		{
+			index++;
 
+			const bool exponent_negative = (index < atom.size() && atom[index] == '-');
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("map/set/at (const)")
-{
-	Map map;
+			if(index < atom.size() && (atom[index] == '-' || atom[index] == '+'))
+			{
+				index++;
+			}
 
-	SUBCASE("Exists")
-	{
-		const Object key_null   = {};
-		const Object key_bool   = {true};
-		const Object key_int64  = {int64_t(0)};
-		const Object key_uint64 = {uint64_t(0)};
-		const Object key_float  = {float(0)};
-		const Object key_double = {double(0)};
-		const Object key_string = {std::string("_")};
+			const size_t exponent = index;
+			int64_t      value    = 0;
 
-		const Object value_0 = {uint64_t(0)};
-		const Object value_1 = {uint64_t(1)};
-		const Object value_2 = {uint64_t(2)};
-		const Object value_3 = {uint64_t(3)};
-		const Object value_4 = {uint64_t(4)};
-		const Object value_5 = {uint64_t(5)};
-		const Object value_6 = {uint64_t(6)};
+			while(index < atom.size() && is_digit(atom[index]))
+			{
+				value = std::min<int64_t>(value * 10 + (atom[index] - '0'), 1'000'000);
+				index++;
+			}
 
-		map.set(key_null,   value_0);
-		map.set(key_bool,   value_1);
-		map.set(key_int64,  value_2);
-		map.set(key_uint64, value_3);
-		map.set(key_float,  value_4);
-		map.set(key_double, value_5);
-		map.set(key_string, value_6);
+			if(index == exponent)
+			{
+				return Error_Invalid_Json;
+			}
 
-		CHECK(map.at(key_null)   == value_0);
-		CHECK(map.at(key_bool)   == value_1);
-		CHECK(map.at(key_int64)  == value_2);
-		CHECK(map.at(key_uint64) == value_3);
-		CHECK(map.at(key_float)  == value_4);
-		CHECK(map.at(key_double) == value_5);
-		CHECK(map.at(key_string) == value_6);
-	}
+			magnitude += exponent_negative ? -value : value;
+		}
 
-	SUBCASE("Not Exists")
-	{
-		const Object  bad_key = {};
-		const Object& bad_val = map.at(bad_key);
-		CHECK(&bad_key == &bad_val);
-	}
-}
+		if(index != atom.size())
+		{
+			return Error_Invalid_Json;
+		}
 
-TEST_CASE("map/set/operator[](Object&) (const)")
-{
-	Map map;
+		if(integer_end == atom.size())
+		{
+			uint64_t value    = 0;
+			bool     overflow = false;
 
-	SUBCASE("Exists")
-	{
-		const Object key_null   = {};
-		const Object key_bool   = {true};
-		const Object key_int64  = {int64_t(0)};
-		const Object key_uint64 = {uint64_t(0)};
-		const Object key_float  = {float(0)};
-		const Object key_double = {double(0)};
-		const Object key_string = {std::string("_")};
+			for(size_t i = negative ? 1 : 0; i < atom.size(); i++)
+			{
+				overflow |= __builtin_mul_overflow(value, 10, &value);
+				overflow |= __builtin_add_overflow(value, (uint64_t)(atom[i] - '0'), &value);
+			}
 
-		const Object value_0 = {uint64_t(0)};
-		const Object value_1 = {uint64_t(1)};
-		const Object value_2 = {uint64_t(2)};
-		const Object value_3 = {uint64_t(3)};
-		const Object value_4 = {uint64_t(4)};
-		const Object value_5 = {uint64_t(5)};
-		const Object value_6 = {uint64_t(6)};
+			if(overflow == false)
+			{
+				constexpr uint64_t Int64_Max = (uint64_t)std::numeric_limits<int64_t>::max();
 
-		map.set(key_null,   value_0);
-		map.set(key_bool,   value_1);
-		map.set(key_int64,  value_2);
-		map.set(key_uint64, value_3);
-		map.set(key_float,  value_4);
-		map.set(key_double, value_5);
-		map.set(key_string, value_6);
+				if(negative && value <= Int64_Max + 1)
+				{
+					return packer.packInt((int64_t)(0 - value));
+				}
 
-		CHECK(map[key_null]   == value_0);
-		CHECK(map[key_bool]   == value_1);
-		CHECK(map[key_int64]  == value_2);
-		CHECK(map[key_uint64] == value_3);
-		CHECK(map[key_float]  == value_4);
-		CHECK(map[key_double] == value_5);
-		CHECK(map[key_string] == value_6);
-	}
+				if(negative == false)
+				{
+					return (value <= Int64_Max)
+						? packer.packInt((int64_t)value)
+						: packer.packUint(value)
+						;
+				}
+			}
+		}
 
-	SUBCASE("Not Exists")
-	{
-		const Object  bad_key = {};
-		const Object& bad_val = map[bad_key];
-		CHECK(&bad_key == &bad_val);
+		double value = 0;
+
+		const std::from_chars_result result = std::from_chars(atom.data(), atom.data() + atom.size(), value);
+
+		if(result.ec == std::errc::result_out_of_range)
+		{
+			value = (magnitude > 0) ? std::numeric_limits<double>::infinity() : 0.0;
+			value = negative ? -value : value;
+		}
+		else if(result.ec != std::errc{})
+		{
+			return Error_Invalid_Json;
+		}
+
+		return packer.packDouble(value);
 	}
-}
 
-TEST_CASE("map/set/operator[](native type) (const)")
-{
-	Map map;
 
-	SUBCASE("Exists")
+
+	/**
+	 * \brief Pack JSON text.
+	 *
+	 * The \p token_vector and \p count_vector come from jsonTokens_() and 
+	 * jsonCount_(), so the grammar is already known to be valid. Only the 
+	 * strings and atoms need to be checked.
+	 *
+	 * \return An error code.
+	 */
+	std::error_code jsonPack_(const std::string_view text         ///< The JSON text
+		, const std::vector<uint32_t>&           token_vector ///< The token positions
+		, const std::vector<uint32_t>&           count_vector ///< The element counts
+		, Packer&                                packer       ///< The output
+		) noexcept
 	{
-		const bool        key_bool   = {true};
-		const int64_t     key_int64  = {int64_t(0)};
-		const uint64_t    key_uint64 = {uint64_t(0)};
-		const float       key_float  = {float(0)};
-		const double      key_double = {double(0)};
-		const std::string key_string = {std::string("_")};
+		std::string     scratch;
+		std::error_code error     = Error_None;
+		size_t          container = 0;
 
-		const Object value_1 = {uint64_t(1)};
-		const Object value_2 = {uint64_t(2)};
-		const Object value_3 = {uint64_t(3)};
-		const Object value_4 = {uint64_t(4)};
-		const Object value_5 = {uint64_t(5)};
-		const Object value_6 = {uint64_t(6)};
+		for(size_t i = 0; i < token_vector.size() && !error; i++)
+		{
+			const size_t position = token_vector[i];
 
-		map.set({key_bool  } , value_1);
-		map.set({key_int64 } , value_2);
-		map.set({key_uint64} , value_3);
-		map.set({key_float } , value_4);
-		map.set({key_double} , value_5);
-		map.set({key_string} , value_6);
+			switch(text[position])
+			{
+				case '{':
+					error = packer.packMapHeader(count_vector[container++]);
+					break;
 
-		CHECK(map[key_bool]   == value_1);
-		CHECK(map[key_int64]  == value_2);
-		CHECK(map[key_uint64] == value_3);
-		CHECK(map[key_float]  == value_4);
-		CHECK(map[key_double] == value_5);
-		CHECK(map[key_string] == value_6);
+				case '[':
+					error = packer.packArrayHeader(count_vector[container++]);
+					break;
+
+				case '}': case ']': case ':': case ',':
+					break;
+
+				case '"':
+				{
+					std::string_view string;
+
+					error = jsonStringRead_(text, position, scratch, string);
+
+					if(!error)
+					{
+						error = packer.packStr(string);
+					}
+					break;
+				}
+
+				default:
+				{
+					size_t end = (i + 1 < token_vector.size())
+						? token_vector[i + 1]
+						: text.size()
+						;
+
+					while(text[end - 1] == ' '
+						|| text[end - 1] == '\t'
+						|| text[end - 1] == '\n'
+						|| text[end - 1] == '\r'
+						)
+					{
+						end--;
+					}
+
+					error = jsonAtom_(text.substr(position, end - position), packer);
+				}
+			}
+		}
+
+		return error;
 	}
+	/**
+	 * \}
+	 */
 }
-#endif // }}}
 
+// }}}
+// {{{ Error
 
 /**
- * \brief Get the value of a key.
- *
- * The value associated with the provided \p key will be returned. If the \p 
- * key does not exist, then a reference to the \p key will be returned.  
- * Checking if the key exists (keyExists()) is more reliable than using this 
- * error handling.
- *
- * \parcode
- * zakero::messagepack::Map map;
- *
- * map.set(Object{uint64_t(42)}, Object{std::string("The Answer"});
- * zakero::messagepack::Object& thing = map.at({uint64_t(42)});
+ * \class ErrorCategary_
  *
- * zakero::messagepack::Object key = Object{true};
- * zakero::messagepack::Object& object = map.at(key);
+ * \brief Error categories.
  *
- * if(&object == &key)
- * {
- * 	// key not found
- * }
- * \endparcode
+ * This class holds all the error categories for the error codes. The data in 
+ * this class is built from the ZAKERO_MESSAGEPACK__ERROR_DATA macro.
+ */
+
+
+/**
+ * \fn ErrorCategory_::ErrorCategory_()
  *
- * \return The value.
+ * \brief Constructor
  */
-Object& Map::at(Object& key ///< The key
-	) noexcept
-{
-	if(keyExists(key) == false)
-	{
-		return key;
-	}
 
-	if(key.isNull())
-	{
-		return null_map.at(0);
-	}
-	else if(key.is<bool>())
-	{
-		return bool_map.at(key.as<bool>());
-	}
-	else if(key.is<int64_t>())
-	{
-		return int64_map.at(key.as<int64_t>());
-	}
-	else if(key.is<uint64_t>())
-	{
-		return uint64_map.at(key.as<uint64_t>());
-	}
-	else if(key.is<float>())
-	{
-		return float_map.at(key.as<float>());
-	}
-	else if(key.is<double>())
-	{
-		return double_map.at(key.as<double>());
-	}
-	else if(key.is<std::string>())
-	{
-		return string_map.at(key.as<std::string>());
-	}
 
-	return key;
+/**
+ * \brief The name of the error category.
+ * 
+ * \return A C-Style string.
+ */
+const char* ErrorCategory_::name() const noexcept
+{
+	return "zakero::messagepack";
 }
 
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("map/set/at")
+/**
+ * \brief A description message.
+ *
+ * \return The message.
+ */
+std::string ErrorCategory_::message(int condition ///< The error code.
+	) const noexcept
 {
-	Map map;
-
-	SUBCASE("Exists")
+	switch(condition)
 	{
-		Object key_null   = {};
-		Object key_bool   = {true};
-		Object key_int64  = {int64_t(0)};
-		Object key_uint64 = {uint64_t(0)};
-		Object key_float  = {float(0)};
-		Object key_double = {double(0)};
-		Object key_string = {std::string("_")};
-
-		Object value_0 = {uint64_t(0)};
-		Object value_1 = {uint64_t(1)};
-		Object value_2 = {uint64_t(2)};
-		Object value_3 = {uint64_t(3)};
-		Object value_4 = {uint64_t(4)};
-		Object value_5 = {uint64_t(5)};
-		Object value_6 = {uint64_t(6)};
-
-		map.set(key_null,   value_0);
-		map.set(key_bool,   value_1);
-		map.set(key_int64,  value_2);
-		map.set(key_uint64, value_3);
-		map.set(key_float,  value_4);
-		map.set(key_double, value_5);
-		map.set(key_string, value_6);
-
-		CHECK(map.at(key_null)   == value_0);
-		CHECK(map.at(key_bool)   == value_1);
-		CHECK(map.at(key_int64)  == value_2);
-		CHECK(map.at(key_uint64) == value_3);
-		CHECK(map.at(key_float)  == value_4);
-		CHECK(map.at(key_double) == value_5);
-		CHECK(map.at(key_string) == value_6);
-
-		map.at(key_null) = {false};
-		CHECK(map.at(key_null) == Object{false});
+#define X(name_, val_, mesg_) \
+		case val_: return mesg_;
+		ZAKERO_MESSAGEPACK__ERROR_DATA
+#undef X
 	}
 
-	SUBCASE("Not Exists")
-	{
-		Object  bad_key = {};
-		Object& bad_val = map.at(bad_key);
-		CHECK(&bad_key == &bad_val);
-	}
-}
-
-TEST_CASE("map/set/operator[](Object&)")
-{
-	Map map;
-
-	SUBCASE("Exists")
-	{
-		Object key_null   = {};
-		Object key_bool   = {true};
-		Object key_int64  = {int64_t(0)};
-		Object key_uint64 = {uint64_t(0)};
-		Object key_float  = {float(0)};
-		Object key_double = {double(0)};
-		Object key_string = {std::string("_")};
-
-		Object value_0 = {uint64_t(0)};
-		Object value_1 = {uint64_t(1)};
-		Object value_2 = {uint64_t(2)};
-		Object value_3 = {uint64_t(3)};
-		Object value_4 = {uint64_t(4)};
-		Object value_5 = {uint64_t(5)};
-		Object value_6 = {uint64_t(6)};
-
-		map.set(key_null,   value_0);
-		map.set(key_bool,   value_1);
-		map.set(key_int64,  value_2);
-		map.set(key_uint64, value_3);
-		map.set(key_float,  value_4);
-		map.set(key_double, value_5);
-		map.set(key_string, value_6);
-
-		CHECK(map[key_null]   == value_0);
-		CHECK(map[key_bool]   == value_1);
-		CHECK(map[key_int64]  == value_2);
-		CHECK(map[key_uint64] == value_3);
-		CHECK(map[key_float]  == value_4);
-		CHECK(map[key_double] == value_5);
-		CHECK(map[key_string] == value_6);
-	}
-
-	SUBCASE("Not Exists")
-	{
-		Object  bad_key = {};
-		Object& bad_val = map[bad_key];
-		CHECK(&bad_key == &bad_val);
-	}
-}
-
-TEST_CASE("map/set/operator[](raw native types)")
-{
-	Map map;
-
-	SUBCASE("Exists")
-	{
-		std::string string = "Hello, World!";
-		Object value = {string};
-
-		map.set({(bool)     true } , value);
-		map.set({(int64_t)  0    } , value);
-		map.set({(uint64_t) 1    } , value);
-		map.set({(float)    2.2  } , value);
-		map.set({(double)   3.3  } , value);
-		map.set({           "foo"} , value);
-
-		CHECK(map[(bool)     true ].isString() == true);
-		CHECK(map[(bool)     true ].isString() == value.isString());
-		CHECK(map[(bool)     true ] == value);
-		CHECK(map[(bool)     true ].asString() == string);
-
-		CHECK(map[(int64_t)  0    ].isString() == true);
-		CHECK(map[(int64_t)  0    ].isString() == value.isString());
-		CHECK(map[(int64_t)  0    ] == value);
-		CHECK(map[(int64_t)  0    ].asString() == string);
-
-		CHECK(map[(uint64_t) 1    ].isString() == true);
-		CHECK(map[(uint64_t) 1    ].isString() == value.isString());
-		CHECK(map[(uint64_t) 1    ] == value);
-		CHECK(map[(uint64_t) 1    ].asString() == string);
-
-		CHECK(map[(float)    2.2  ].isString() == true);
-		CHECK(map[(float)    2.2  ].isString() == value.isString());
-		CHECK(map[(float)    2.2  ] == value);
-		CHECK(map[(float)    2.2  ].asString() == string);
-
-		CHECK(map[(double)   3.3  ].isString() == true);
-		CHECK(map[(double)   3.3  ].isString() == value.isString());
-		CHECK(map[(double)   3.3  ] == value);
-		CHECK(map[(double)   3.3  ].asString() == string);
-
-		CHECK(map[           "foo"].isString() == true);
-		CHECK(map[           "foo"].isString() == value.isString());
-		CHECK(map[           "foo"] == value);
-		CHECK(map[           "foo"].asString() == string);
-
-		Object obj = map["foo"];
-		CHECK(obj == value);
-		CHECK(obj.isString() == true);
-
-		std::string str = map["foo"].asString();
-		CHECK(str == string);
-
-		map.set({ "aaa" } , { "aaa" });
-
-		bool b = map["aaa"].isString();
-		CHECK(b == true);
-
-		std::string s = map["aaa"].asString();
-		CHECK(s == "aaa");
-	}
-}
-#endif // }}}
-
-
-/**
- * \fn zakero::messagepack::Map::clear()
- *
- * \brief Remove the contents of the Map.
- *
- * All of the key/value pairs will be removed.
- */
-void Map::clear() noexcept
-{
-	null_map.clear();
-	bool_map.clear();
-	int64_map.clear();
-	uint64_map.clear();
-	float_map.clear();
-	double_map.clear();
-	string_map.clear();
+	return "Unknown error condition";
 }
 
 
 /**
- * \brief Get the size of the Map.
+ * \brief A single instance.
  *
- * \return The number of key/value pairs.
+ * This one instance will be used by all error codes.
  */
-size_t Map::size() const noexcept
-{
-	const size_t size = null_map.size()
-		+ bool_map.size()
-		+ int64_map.size()
-		+ uint64_map.size()
-		+ float_map.size()
-		+ double_map.size()
-		+ string_map.size()
-		;
-
-	return size;
-}
-
+ErrorCategory_ ErrorCategory;
 
-// }}} Map
-// {{{ Object
+// }}}
+// {{{ Limits
 
 /**
- * \struct Object
+ * \struct Limits
  *
- * \brief A Data Object.
- *
- * The role of this object is to store all the data-types in the MessagePack 
- * specification. This is accomplish by using the `std::variant` and a 
- * collection of helper methods to reduce the verbosity of templates.
- *
- * \note The `std::monostate` is used to represent `null`.
+ * \brief Limits on the data that deserialize() and the Unpacker will accept.
  *
- * Once an Object has been set to a type, it is an error to cast the object to 
- * any other type.
+ * Data from an untrusted source can be nested deeply, have a huge number of 
+ * elements, or be much larger than expected. Decoding stops with an error as 
+ * soon as one of these limits is exceeded, before the memory for the data 
+ * has been allocated.
  *
  * \parcode
- * zakero::messagepack::Object object;
- *
- * object = {true}; // Object is now a boolean
- * int64_t value = object.as<int64_t>(); // Error: Object is not a int64_t
- *
- * // Reusing the same object...
- * object = {int64_t(42)}; // Object is now a int64_t
- * value = object.as<int64_t>(); // Ok: Object is a int64_t
- * \endparcode
- */
-
-
-/**
- * \fn zakero::messagepack::Object::as()
- *
- * \brief Convert to type `T`.
- *
- * The Object will be converted so that it will be treated __as__ the requested 
- * \p T type.
+ * zakero::messagepack::Limits limits;
+ * limits.max_depth    = 16;
+ * limits.max_elements = 10'000;
+ * limits.max_bytes    = 64 * 1024;
  *
- * \parcode
- * zakero::messagepack::Object object = {true};
+ * size_t          index = 0;
+ * std::error_code error;
  *
- * bool b = object.as<bool>();
+ * zakero::messagepack::Object object = zakero::messagepack::deserialize(data, index, error, limits);
  * \endparcode
- *
- * \return The request data-type.
- *
- * \tparam T The data-type to convert to.
  */
 
-
 /**
- * \fn zakero::messagepack::Object::as() const
- *
- * \brief Convert to type `T`.
- *
- * The Object will be converted so that it will be treated __as__ the requested 
- * \p T type.
- *
- * \parcode
- * zakero::messagepack::Object object = {true};
- *
- * bool b = object.as<bool>();
- * \endparcode
+ * \var Limits::Depth_Max
  *
- * \return The request data-type.
+ * \brief The deepest nesting that deserialize() will produce.
  *
- * \tparam T The data-type to convert to.
+ * Decoding does not use recursion, but destroying, copying, and serializing 
+ * an Object does. To keep those safe, a Limits::max_depth that is larger 
+ * than this value is treated as this value.
  */
 
-
 /**
- * \fn zakero::messagepack::Object::asArray()
- *
- * \brief Convert to an Array.
- *
- * The same as: `object.as<zakero::messagepack::Array>()`
+ * \var Limits::max_depth
  *
- * \return A reference to an Array.
+ * \brief The maximum number of nested Arrays and Maps.
  *
- * \see as()
+ * Going deeper causes Error_Depth_Limit. A value of `0` only allows a 
+ * single value that is not an Array or a Map. The value can not be larger 
+ * than Limits::Depth_Max.
  */
 
-
 /**
- * \fn zakero::messagepack::Object::asArray() const
- *
- * \brief Convert to an Array.
- *
- * The same as: `object.as<zakero::messagepack::Array>()`
+ * \var Limits::max_elements
  *
- * \return A reference to an Array.
+ * \brief The maximum number of Objects.
  *
- * \see as()
+ * Every value, including Arrays, Maps, and Map keys, is counted. Going over 
+ * causes Error_Element_Limit. An Array or Map that claims to have more 
+ * elements than are left is rejected as soon as it is found.
  */
 
-
 /**
- * \fn zakero::messagepack::Object::asBinary()
- *
- * \brief Convert to a std::vector<uint8_t>.
+ * \var Limits::max_bytes
  *
- * The same as: `object.as<std::vector<uint8_t>>()`
+ * \brief The maximum size of the packed data.
  *
- * \return A reference to a std::vector<uint8_t>.
- *
- * \see as()
+ * Going over causes Error_Size_Limit. Strings, binary data, and extensions 
+ * are checked before they are copied.
  */
 
+// }}}
+// {{{ Array
 
 /**
- * \fn zakero::messagepack::Object::asBinary() const
- *
- * \brief Convert to a std::vector<uint8_t>.
+ * \struct Array
  *
- * The same as: `object.as<std::vector<uint8_t>>()`
+ * \brief An array of Objects.
  *
- * \return A reference to a std::vector<uint8_t>.
+ * The role of this structure is to store a collection of Objects in a 
+ * resizable array. The underling `object_vector` can be accessed directly or 
+ * use the helper methods to increase code readability.
  *
- * \see as()
+ * Objects can be tested to find out if they are Arrays by using 
+ * Object::isArray() and converted into an Array with Object::asArray(). An 
+ * Array can not be converted into an Object. However, an Object can be 
+ * constructed using an Array.
  */
 
 
 /**
- * \fn zakero::messagepack::Object::asExt()
- *
- * \brief Convert to an Ext.
- *
- * The same as: `object.as<zakero::messagepack::Ext>()`
+ * \var zakero::messagepack::Array::object_vector
  *
- * \return A reference to an Ext.
+ * \brief Store the Object data.
  *
- * \see as()
+ * The `object_vector` is used to store all the Qbjects in the Array.
  */
 
 
 /**
- * \fn zakero::messagepack::Object::asExt() const
- *
- * \brief Convert to an Ext.
+ * \brief Append a boolean value.
  *
- * The same as: `object.as<zakero::messagepack::Ext>()`
+ * The \p value will be appended to the contents of the Array. 
  *
- * \return A reference to an Ext.
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.append(true);
+ * \endparcode
  *
- * \see as()
+ * \return The index location of where the \p value was stored.
  */
+size_t Array::append(const bool value ///< The value to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
 
+	object_vector.emplace_back(Object{value});
 
-/**
- * \fn zakero::messagepack::Object::asMap()
- *
- * \brief Convert to a Map.
- *
- * The same as: `object.as<zakero::messagepack::Map>()`
- *
- * \return A reference to a Map.
- *
- * \see as()
- */
+	return index;
+}
 
 
-/**
- * \fn zakero::messagepack::Object::asMap() const
- *
- * \brief Convert to a Map.
- *
- * The same as: `object.as<zakero::messagepack::Map>()`
- *
- * \return A reference to a Map.
- *
- * \see as()
- */
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/bool")
+{
+	Array array;
 
+	size_t index = array.append(true);
 
-/**
- * \fn zakero::messagepack::Object::asString() const
- *
- * \brief Convert to a std::string.
- *
- * The same as: `object.as<std::string>()`
- *
- * \return A reference to a std::string.
- *
- * \see as()
- */
+	CHECK(index == 0);
+	CHECK(array.size() == 1);
 
+	index = array.append(false);
 
-/**
- * \fn zakero::messagepack::Object::is() const
- *
- * \brief Is Object of type `T`.
- *
- * The Object will be checked to see if it is of type `T`.
- *
- * \parcode
- * zakero::messagepack::Object object = {int64_t(123)};
- *
- * bool is_int = object.is<int64_t>();
- * \endparcode
- *
- * \retval true  The Object is of type `T`
- * \retval false The Object is not of type `T`
- *
- * \tparam T The data-type to check.
- */
+	CHECK(index == 1);
+	CHECK(array.size() == 2);
 
+	// Check serialized data
 
-/**
- * \fn zakero::messagepack::Object::isArray()
- *
- * \brief Is Object an Array?
- *
- * The same as: `object.is<zakero::messagepack::Array>()`
- *
- * \retval true  The Object is an Array
- * \retval false The Object is not an Array
- *
- * \see is()
- */
+	std::vector<uint8_t> data = serialize(array);
+	CHECK(data.size() == 3);
 
+	index = 0;
+	CHECK((data[index] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
+	CHECK((data[index++] & Fixed_Array_Value) == 2);
+	CHECK(data[index++] == (uint8_t)Format::True);
+	CHECK(data[index++] == (uint8_t)Format::False);
 
-/**
- * \fn zakero::messagepack::Object::isBinary()
- *
- * \brief Is Object binary data?
- *
- * The same as: `object.is<std::vector<uint8_t>>()`
- *
- * \retval true  The Object is a std::vector<uint8_t>
- * \retval false The Object is not a std::vector<uint8_t>
- *
- * \see is()
- */
+	// Check deserialized data
 
+	Object object = deserialize(data);
 
-/**
- * \fn zakero::messagepack::Object::isExt()
- *
- * \brief Is Object an Ext?
- *
- * The same as: `object.is<zakero::messagepack::Ext>()`
- *
- * \retval true  The Object is an Ext
- * \retval false The Object is not an Ext
- *
- * \see is()
- */
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == 2);
 
+	{
+		const messagepack::Object& object = array.object(0);
+		CHECK(object.is<bool>());
+		CHECK(object.as<bool>() == true);
+	}
 
-/**
- * \fn zakero::messagepack::Object::isMap()
- *
- * \brief Is Object a Map?
- *
- * The same as: `object.is<zakero::messagepack::Map>()`
- *
- * \retval true  The Object is a Map
- * \retval false The Object is not a Map
- *
- * \see is()
- */
+	{
+		const messagepack::Object& object = array.object(1);
+		CHECK(object.is<bool>());
+		CHECK(object.as<bool>() == false);
+	}
+}
+#endif // }}}
 
 
 /**
- * \fn zakero::messagepack::Object::isNull()
- *
- * \brief Does the Object represent a `null`?
+ * \brief Append a signed integer value.
  *
- * The same as: `object.is<std::monostate>()`
+ * The \p value will be appended to the contents of the Array.
  *
- * \retval true  The Object is a std::monostate
- * \retval false The Object is not a std::monostate
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.append(int64_t(0));
+ * \endparcode
  *
- * \see is()
+ * \return The index location of where the \p value was stored.
  */
+size_t Array::append(const int64_t value ///< The value to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
 
+	object_vector.emplace_back(Object{value});
 
-/**
- * \fn zakero::messagepack::Object::isString()
- *
- * \brief Is Object a std::string?
- *
- * The same as: `object.is<std::string>()`
- *
- * \retval true  The Object is a std::string
- * \retval false The Object is not a std::string
- *
- * \see is()
- */
+	return index;
+}
 
 
-/**
- * \fn zakero::messagepack::Object::type()
- *
- * \brief Provide the Object type as a std::string.
- *
- * The datatype name of the value in this Object will be returned as a 
- * std::string. While not very useful for final/release codebases, this method 
- * can be a great help when debugging.
- *
- * \return A string.
- */
-std::string Object::type() const noexcept
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/int64_t")
 {
-	if(this->isNull())
-	{
-		return "null";
-	}
+	const int64_t i8_min = -31;
+	const int64_t i8_max = 127;
+	const int64_t i16_min = std::numeric_limits<int16_t>::min();
+	const int64_t i16_max = std::numeric_limits<int16_t>::max();
+	const int64_t i32_min = std::numeric_limits<int32_t>::min();
+	const int64_t i32_max = std::numeric_limits<int32_t>::max();
+	const int64_t i64_min = std::numeric_limits<int64_t>::min();
+	const int64_t i64_max = std::numeric_limits<int64_t>::max();
+	size_t count = 0;
 
-	if(this->is<bool>())
-	{
-		return "bool";
-	}
+	Array array;
+	array.append(i8_min);  count++;
+	array.append(i8_max);  count++;
+	array.append(i16_min); count++;
+	array.append(i16_max); count++;
+	array.append(i32_min); count++;
+	array.append(i32_max); count++;
+	array.append(i64_min); count++;
+	array.append(i64_max); count++;
 
-	if(this->is<int64_t>())
-	{
-		return "int64_t";
-	}
+	CHECK(array.size() == count);
 
-	if(this->is<uint64_t>())
-	{
-		return "uint64_t";
-	}
+	// Check serialized data
 
-	if(this->is<float>())
-	{
-		return "float";
-	}
+	std::vector<uint8_t> data = serialize(array);
 
-	if(this->is<double>())
-	{
-		return "dnuble";
-	}
+	// Check deserialized data
 
-	if(this->is<std::string>())
-	{
-		return "std::string";
-	}
+	Object object = deserialize(data);
 
-	if(this->is<std::vector<uint8_t>>())
-	{
-		return "std::vector<uint8_t>";
-	}
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
 
-	if(this->isArray())
-	{
-		return "zakero::messagepack::Array";
-	}
+	size_t index = 0;
+	CHECK(test.object(index).is<int64_t>());
+	CHECK(test.object(index).as<int64_t>() == i8_min);
 
-	if(this->isExt())
-	{
-		return "zakero::messagepack::Ext";
-	}
+	index++;
+	CHECK(test.object(index).is<int64_t>());
+	CHECK(test.object(index).as<int64_t>() == i8_max);
 
-	if(this->isMap())
-	{
-		return "zakero::messagepack::Map";
-	}
+	index++;
+	CHECK(test.object(index).is<int64_t>());
+	CHECK(test.object(index).as<int64_t>() == i16_min);
 
-	return {};
-}
+	index++;
+	CHECK(test.object(index).is<int64_t>());
+	CHECK(test.object(index).as<int64_t>() == i16_max);
 
-// }}} Object
-// {{{ Extensions
-// {{{ Extensions: Timestamp
+	index++;
+	CHECK(test.object(index).is<int64_t>());
+	CHECK(test.object(index).as<int64_t>() == i32_min);
 
-/**
- * \brief Timestamp Extension Check.
- *
- * Use this method to determine if the \p object is a MessagePack Timestamp 
- * Extension.
- *
- * \parcode
- * std::vector<uint8_t> data = getSerializedData();
- * zakero::messagepack::Object obj = zakero::messagepack::deserialize(data);
- *
- * if(zakero::messagepack::extensionTimestampCheck(obj) == false)
- * {
- * 	return ERROR_INVALID_TIMESTAMP;
- * }
+	index++;
+	CHECK(test.object(index).is<int64_t>());
+	CHECK(test.object(index).as<int64_t>() == i32_max);
+
+	index++;
+	CHECK(test.object(index).is<int64_t>());
+	CHECK(test.object(index).as<int64_t>() == i64_min);
+
+	index++;
+	CHECK(test.object(index).is<int64_t>());
+	CHECK(test.object(index).as<int64_t>() == i64_max);
+}
+#endif // }}}
+
+
+/**
+ * \brief Append an unsigned integer value.
+ *
+ * The \p value will be appended to the contents of the Array.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.append(uint64_t(0));
  * \endparcode
  *
- * \retval true  The \p object is a Timestamp extension.
- * \retval false The \p object is not a Timestamp extension.
+ * \return The index location of where the \p value was stored.
  */
-bool extensionTimestampCheck(const Object& object ///< The Ext to check.
+size_t Array::append(const uint64_t value ///< The value to add
 	) noexcept
 {
-	if(object.isExt() == true)
-	{
-		const Ext& ext = object.asExt();
+	const size_t index = object_vector.size();
 
-		if(ext.type == -1)
-		{
-			if(ext.data.size() == 4
-				|| ext.data.size() == 8
-				|| ext.data.size() == 12
-				)
-			{
-				return true;
-			}
-		}
-	}
+	object_vector.emplace_back(Object{value});
 
-	return false;
+	return index;
 }
 
 
 #ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("extension/timestamp/check")
+TEST_CASE("array/append/uint64_t")
 {
-	Object object = {Ext{}};
-	Ext& ext      = object.asExt();
+	const uint64_t u8_min = -31;
+	const uint64_t u8_max = 127;
+	const uint64_t u16_min = std::numeric_limits<uint16_t>::min();
+	const uint64_t u16_max = std::numeric_limits<uint16_t>::max();
+	const uint64_t u32_min = std::numeric_limits<uint32_t>::min();
+	const uint64_t u32_max = std::numeric_limits<uint32_t>::max();
+	const uint64_t u64_min = std::numeric_limits<uint64_t>::min();
+	const uint64_t u64_max = std::numeric_limits<uint64_t>::max();
+	size_t count = 0;
 
-	CHECK(extensionTimestampCheck(object) == false);
+	Array array;
+	array.append(u8_min);  count++;
+	array.append(u8_max);  count++;
+	array.append(u16_min); count++;
+	array.append(u16_max); count++;
+	array.append(u32_min); count++;
+	array.append(u32_max); count++;
+	array.append(u64_min); count++;
+	array.append(u64_max); count++;
 
-	// --- Bad Ext.type value --- //
+	CHECK(array.size() == count);
 
-	ext.data = std::vector<uint8_t>();
-	CHECK(extensionTimestampCheck(object) == false);
+	// Check serialized data
 
-	ext.data = std::vector<uint8_t>(1, 0);
-	CHECK(extensionTimestampCheck(object) == false);
+	std::vector<uint8_t> data = serialize(array);
 
-	ext.data = std::vector<uint8_t>(4, 0);
-	CHECK(extensionTimestampCheck(object) == false);
+	// Check deserialized data
 
-	ext.data = std::vector<uint8_t>(8, 0);
-	CHECK(extensionTimestampCheck(object) == false);
+	Object object = deserialize(data);
 
-	ext.data = std::vector<uint8_t>(12, 0);
-	CHECK(extensionTimestampCheck(object) == false);
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
 
-	// --- Good Ext.type value --- //
+	size_t index = 0;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == u8_min);
 
-	ext.type = -1;
-	ext.data = std::vector<uint8_t>();
-	CHECK(extensionTimestampCheck(object) == false);
+	index++;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == u8_max);
 
-	ext.data = std::vector<uint8_t>();
-	CHECK(extensionTimestampCheck(object) == false);
+	index++;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == u16_min);
 
-	ext.data = std::vector<uint8_t>(1, 0);
-	CHECK(extensionTimestampCheck(object) == false);
+	index++;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == u16_max);
 
-	ext.data = std::vector<uint8_t>(4, 0);
-	CHECK(extensionTimestampCheck(object) == true);
+	index++;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == u32_min);
 
-	ext.data = std::vector<uint8_t>(8, 0);
-	CHECK(extensionTimestampCheck(object) == true);
+	index++;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == u32_max);
 
-	ext.data = std::vector<uint8_t>(12, 0);
-	CHECK(extensionTimestampCheck(object) == true);
+	index++;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == u64_min);
+
+	index++;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == u64_max);
 }
 #endif // }}}
 
 
 /**
- * \brief Convert MessagePack Timestamp extension into a `struct timespec`.
+ * \brief Append a 32-bit floating point value.
  *
- * Conversion from Object to `struct timespec` is performed by this method. If 
- * the provided \p object is not a valid Timestamp extension then an empty 
- * `struct timespec` will be returned.
+ * The \p value will be appended to the contents of the Array.
  *
  * \parcode
- * std::vector<uint8_t> data = getSerializedData();
- * zakero::messagepack::Object obj = zakero::messagepack::deserialize(data);
- * struct timespec ts = zakero::messagepack::extensionTimestampConvert(obj);
- *
- * char buf[128];
- * std::strftime(buf, sizeof(buf), "%D %T", std::gmtime(&ts.tv_sec));
- * std::printf("Time: %s.%09ld UTC\n", buf, ts.tv_nsec);
+ * zakero::messagepack::Array array;
+ * array.append(float(4.2));
  * \endparcode
  *
- * \return A `struct timespec`.
+ * \return The index location of where the \p value was stored.
  */
-struct timespec extensionTimestampConvert(const Object& object ///< The Ext data.
+size_t Array::append(const float value ///< The value to add
 	) noexcept
 {
-	if(object.isExt() == false)
-	{
-		return {};
-	}
-
-	const Ext& ext = object.asExt();
+	const size_t index = object_vector.size();
 
-	if(ext.type != -1)
-	{
-		return {};
-	}
+	object_vector.emplace_back(Object{value});
 
-	switch(ext.data.size())
-	{
-		case 4:
-		{
-			Convert.uint64 = 0;
-			Convert_Byte3 = ext.data[0];
-			Convert_Byte2 = ext.data[1];
-			Convert_Byte1 = ext.data[2];
-			Convert_Byte0 = ext.data[3];
+	return index;
+}
 
-			timespec ts =
-			{	.tv_sec  = Convert.uint32
-			,	.tv_nsec = 0
-			};
 
-			return ts;
-		}
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/float")
+{
+	const float f32_min = std::numeric_limits<float>::min();
+	const float f32_max = std::numeric_limits<float>::max();
+	size_t count = 0;
 
-		case 8:
-		{
-			Convert.uint64 = 0;
-			Convert_Byte3 = ext.data[0];
-			Convert_Byte2 = ext.data[1];
-			Convert_Byte1 = ext.data[2];
-			Convert_Byte0 = ext.data[3];
-			const uint32_t nsec = Convert.uint32 >> 2;
-
-			Convert.uint64 = 0;
-			Convert_Byte4 = ext.data[3];
-			Convert_Byte3 = ext.data[4];
-			Convert_Byte2 = ext.data[5];
-			Convert_Byte1 = ext.data[6];
-			Convert_Byte0 = ext.data[7];
-			const int64_t sec = Convert.int64 & 0x0000'0003'ffff'ffff;
+	Array array;
+	array.append(f32_min); count++;
+	array.append(f32_max); count++;
 
-			timespec ts =
-			{	.tv_sec  = sec
-			,	.tv_nsec = nsec
-			};
+	CHECK(array.size() == count);
 
-			return ts;
-		}
+	// Check serialized data
 
-		case 12:
-		{
-			Convert.uint64 = 0;
-			Convert_Byte3 = ext.data[0];
-			Convert_Byte2 = ext.data[1];
-			Convert_Byte1 = ext.data[2];
-			Convert_Byte0 = ext.data[3];
-			const uint32_t nsec = Convert.uint32;
-
-			Convert.uint64 = 0;
-			Convert_Byte7 = ext.data[ 4];
-			Convert_Byte6 = ext.data[ 5];
-			Convert_Byte5 = ext.data[ 6];
-			Convert_Byte4 = ext.data[ 7];
-			Convert_Byte3 = ext.data[ 8];
-			Convert_Byte2 = ext.data[ 9];
-			Convert_Byte1 = ext.data[10];
-			Convert_Byte0 = ext.data[11];
-			const int64_t sec = Convert.int64;
+	std::vector<uint8_t> data = serialize(array);
 
-			timespec ts =
-			{	.tv_sec  = sec
-			,	.tv_nsec = nsec
-			};
+	// Check deserialized data
 
-			return ts;
-		}
-	}
+	Object object = deserialize(data);
 
-	return {};
-}
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
 
+	size_t index = 0;
+	CHECK(test.object(index).is<float>());
+	CHECK(test.object(index).as<float>() == f32_min);
 
-// Test is below
+	index++;
+	CHECK(test.object(index).is<float>());
+	CHECK(test.object(index).as<float>() == f32_max);
+}
+#endif // }}}
 
 
 /**
- * \brief Convert a `struct timespec` into a MessagePack Timestamp extension.
+ * \brief Append a 64-bit floating point value.
  *
- * Conversion from a `struct timespec` into the MessagePack Timestamp extension 
- * is handled by this method.
+ * The \p value will be appended to the contents of the Array.
  *
  * \parcode
- * std::timespec ts;
- * std::timespec_get(&ts, TIME_UTC);
- *
- * zakero::messagepack::Object object =
- * 	zakero::messagepack::extensionTimestampConvert(ts);
- *
- * std::vector<uint8_t> data = zakero::messagepack::serialize(object);
+ * zakero::messagepack::Array array;
+ * array.append(double(0.42));
  * \endparcode
  *
- * \return A MessagePack Object.
+ * \return The index location of where the \p value was stored.
  */
-Object extensionTimestampConvert(const struct timespec& ts ///< The time data
+size_t Array::append(const double value ///< The value to add
 	) noexcept
 {
-	Object object = {Ext{}};
-	Ext&   ext    = object.asExt();
+	const size_t index = object_vector.size();
 
-	if((ts.tv_sec >> 34) == 0)
-	{
-		Convert.uint64 = (ts.tv_nsec << 34) | ts.tv_sec;
-		if((Convert.uint64 & 0xffff'ffff'0000'0000) == 0)
-		{
-			ext.type = -1;
-			ext.data.resize(4);
+	object_vector.emplace_back(Object{value});
 
-			size_t index = 0;
-			ext.data[index++] = Convert_Byte3;
-			ext.data[index++] = Convert_Byte2;
-			ext.data[index++] = Convert_Byte1;
-			ext.data[index++] = Convert_Byte0;
+	return index;
+}
 
-			return object;
-		}
 
-		ext.type = -1;
-		ext.data.resize(8);
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/double")
+{
+	const double f64_min = std::numeric_limits<double>::min();
+	const double f64_max = std::numeric_limits<double>::max();
+	size_t count = 0;
 
-		size_t index = 0;
-		ext.data[index++] = Convert_Byte7;
-		ext.data[index++] = Convert_Byte6;
-		ext.data[index++] = Convert_Byte5;
-		ext.data[index++] = Convert_Byte4;
-		ext.data[index++] = Convert_Byte3;
-		ext.data[index++] = Convert_Byte2;
-		ext.data[index++] = Convert_Byte1;
-		ext.data[index++] = Convert_Byte0;
+	Array array;
+	array.append(f64_min); count++;
+	array.append(f64_max); count++;
 
-		return object;
-	}
+	CHECK(array.size() == count);
 
-	ext.type = -1;
-	ext.data.resize(12);
+	// Check serialized data
+
+	std::vector<uint8_t> data = serialize(array);
+
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
 
 	size_t index = 0;
-	Convert.uint64 = ts.tv_nsec;
-	ext.data[index++] = Convert_Byte3;
-	ext.data[index++] = Convert_Byte2;
-	ext.data[index++] = Convert_Byte1;
-	ext.data[index++] = Convert_Byte0;
-
-	Convert.uint64 = ts.tv_sec;
-	ext.data[index++] = Convert_Byte7;
-	ext.data[index++] = Convert_Byte6;
-	ext.data[index++] = Convert_Byte5;
-	ext.data[index++] = Convert_Byte4;
-	ext.data[index++] = Convert_Byte3;
-	ext.data[index++] = Convert_Byte2;
-	ext.data[index++] = Convert_Byte1;
-	ext.data[index++] = Convert_Byte0;
+	CHECK(test.object(index).is<double>());
+	CHECK(test.object(index).as<double>() == f64_min);
 
-	return object;
+	index++;
+	CHECK(test.object(index).is<double>());
+	CHECK(test.object(index).as<double>() == f64_max);
 }
+#endif // }}}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("extension/timestamp/convert/32bit")
+
+/**
+ * \brief Append a string.
+ *
+ * The \p value will be appended to the contents of the Array.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.append("Hello, World!");
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(const std::string_view value ///< The value to add
+	) noexcept
 {
-	SUBCASE("min")
-	{
-		const uint64_t sec  = 0;
-		const uint32_t nsec = 0;
+	const size_t index = object_vector.size();
 
-		struct timespec time =
-		{	.tv_sec  = sec
-		,	.tv_nsec = nsec
-		};
+	object_vector.emplace_back(Object{std::pmr::string(value, object_vector.get_allocator())});
 
-		Object object = extensionTimestampConvert(time);
-		{
-			Ext& ext = object.asExt();
-			CHECK(ext.type        == -1);
-			CHECK(ext.data.size() == 4);
-		}
+	return index;
+}
 
-		std::vector<uint8_t> data = serialize(object);
-		CHECK(data.size() == 6);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext4);
-		CHECK(data[index++] == (uint8_t)-1);
-		CHECK(data[index++] == 0);
-		CHECK(data[index++] == 0);
-		CHECK(data[index++] == 0);
-		CHECK(data[index++] == 0);
 
-		object = deserialize(data);
-		CHECK(object.isExt() == true);
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/string")
+{
+	const std::pmr::string str_0;
+	const std::pmr::string str_f (31, '_');
+	const std::pmr::string str_8 (32, 'X');
+	const std::pmr::string str_16(std::numeric_limits<uint8_t>::max() + 1 , '*');
+	const std::pmr::string str_32(std::numeric_limits<uint16_t>::max() + 1, '|');
+	size_t count = 0;
 
-		Ext& ext = object.asExt();
-		CHECK(ext.type        == -1);
-		CHECK(ext.data.size() == 4);
+	Array array;
+	array.append(str_0);  count++;
+	array.append(str_f);  count++;
+	array.append(str_8);  count++;
+	array.append(str_16); count++;
+	array.append(str_32); count++;
 
-		time = extensionTimestampConvert(object);
-		CHECK(time.tv_sec  == sec);
-		CHECK(time.tv_nsec == nsec);
-	}
+	CHECK(array.size() == count);
 
-	SUBCASE("max")
-	{
-		const uint64_t sec  = 0x0000'0000'ffff'ffff;
-		const uint32_t nsec = 0;
+	// Check serialized data
 
-		struct timespec time =
-		{	.tv_sec  = sec
-		,	.tv_nsec = nsec
-		};
+	std::vector<uint8_t> data = serialize(array);
 
-		Object object = extensionTimestampConvert(time);
-		{
-			Ext& ext = object.asExt();
-			CHECK(ext.type        == -1);
-			CHECK(ext.data.size() == 4);
-		}
+	// Check deserialized data
 
-		std::vector<uint8_t> data = serialize(object);
-		CHECK(data.size() == 6);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext4);
-		CHECK(data[index++] == (uint8_t)-1);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
+	Object object = deserialize(data);
 
-		object = deserialize(data);
-		CHECK(object.isExt() == true);
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
 
-		Ext& ext = object.asExt();
-		CHECK(ext.type        == -1);
-		CHECK(ext.data.size() == 4);
+	size_t index = 0;
+	CHECK(test.object(index).is<std::pmr::string>());
+	CHECK(test.object(index).as<std::pmr::string>() == str_0);
 
-		time = extensionTimestampConvert(object);
-		CHECK(time.tv_sec  == sec);
-		CHECK(time.tv_nsec == nsec);
-	}
+	index++;
+	CHECK(test.object(index).is<std::pmr::string>());
+	CHECK(test.object(index).as<std::pmr::string>() == str_f);
 
-	SUBCASE("pattern")
-	{
-		const uint64_t sec  = 0x12345678;
-		const uint32_t nsec = 0;
+	index++;
+	CHECK(test.object(index).is<std::pmr::string>());
+	CHECK(test.object(index).as<std::pmr::string>() == str_8);
 
-		struct timespec time =
-		{	.tv_sec  = sec
-		,	.tv_nsec = nsec
-		};
+	index++;
+	CHECK(test.object(index).is<std::pmr::string>());
+	CHECK(test.object(index).as<std::pmr::string>() == str_16);
 
-		Object object = extensionTimestampConvert(time);
-		{
-			Ext& ext = object.asExt();
-			CHECK(ext.type        == -1);
-			CHECK(ext.data.size() == 4);
-		}
+	index++;
+	CHECK(test.object(index).is<std::pmr::string>());
+	CHECK(test.object(index).as<std::pmr::string>() == str_32);
+}
+#endif // }}}
 
-		std::vector<uint8_t> data = serialize(object);
-		CHECK(data.size() == 6);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext4);
-		CHECK(data[index++] == (uint8_t)-1);
-		CHECK(data[index++] == 0x12);
-		CHECK(data[index++] == 0x34);
-		CHECK(data[index++] == 0x56);
-		CHECK(data[index++] == 0x78);
 
-		object = deserialize(data);
-		CHECK(object.isExt() == true);
+/**
+ * \brief Append binary data.
+ *
+ * A copy of the \p value will be appended to the contents of the Array, using 
+ * the same memory resource as the Array.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * const std::vector<uint8_t> data = { 0xde, 0xad, 0xca, 0xfe };
+ * array.append(data);
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(const std::span<const uint8_t> value ///< The value to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
 
-		Ext& ext = object.asExt();
-		CHECK(ext.type        == -1);
-		CHECK(ext.data.size() == 4);
+	object_vector.emplace_back(Object{std::pmr::vector<uint8_t>(value.begin(), value.end(), object_vector.get_allocator())});
 
-		time = extensionTimestampConvert(object);
-		CHECK(time.tv_sec  == sec);
-		CHECK(time.tv_nsec == nsec);
-	}
+	return index;
 }
 
-TEST_CASE("extension/timestamp/convert/64bit")
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/binary (copy)")
 {
-	SUBCASE("min")
-	{
-		const uint64_t sec  = 0x0000'0002'0000'0000;
-		const uint32_t nsec = 0;
+	const std::pmr::vector<uint8_t> bin_0;
+	const std::pmr::vector<uint8_t> bin_8 (32, 'X');
+	const std::pmr::vector<uint8_t> bin_16(std::numeric_limits<uint8_t>::max() + 1 , '-');
+	const std::pmr::vector<uint8_t> bin_32(std::numeric_limits<uint16_t>::max() + 1, '|');
+	size_t count = 0;
 
-		struct timespec time =
-		{	.tv_sec  = sec
-		,	.tv_nsec = nsec
-		};
+	Array array;
+	array.append(bin_0);  count++;
+	array.append(bin_8);  count++;
+	array.append(bin_16); count++;
+	array.append(bin_32); count++;
 
-		Object object = extensionTimestampConvert(time);
-		{
-			Ext& ext = object.asExt();
-			CHECK(ext.type        == -1);
-			CHECK(ext.data.size() == 8);
-		}
+	CHECK(array.size() == count);
 
-		std::vector<uint8_t> data = serialize(object);
-		CHECK(data.size() == 10);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext8);
-		CHECK(data[index++] == (uint8_t)-1);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x02);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
+	// Check serialized data
 
-		object = deserialize(data);
-		CHECK(object.isExt() == true);
+	std::vector<uint8_t> data = serialize(array);
 
-		Ext& ext = object.asExt();
-		CHECK(ext.type        == -1);
-		CHECK(ext.data.size() == 8);
+	// Check deserialized data
 
-		time = extensionTimestampConvert(object);
-		CHECK(time.tv_sec  == sec);
-		CHECK(time.tv_nsec == nsec);
-	}
+	Object object = deserialize(data);
 
-	SUBCASE("max")
-	{
-		const uint64_t sec  = 0x0000'0003'ffff'ffff;
-		const uint32_t nsec = 0x3fff'ffff;
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
 
-		struct timespec time =
-		{	.tv_sec  = sec
-		,	.tv_nsec = nsec
-		};
+	size_t index = 0;
+	CHECK(test.object(index).is<std::pmr::vector<uint8_t>>());
+	CHECK(test.object(index).as<std::pmr::vector<uint8_t>>() == bin_0);
 
-		Object object = extensionTimestampConvert(time);
-		{
-			Ext& ext = object.asExt();
-			CHECK(ext.type        == -1);
-			CHECK(ext.data.size() == 8);
-		}
+	index++;
+	CHECK(test.object(index).is<std::pmr::vector<uint8_t>>());
+	CHECK(test.object(index).as<std::pmr::vector<uint8_t>>() == bin_8);
 
-		std::vector<uint8_t> data = serialize(object);
-		CHECK(data.size() == 10);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext8);
-		CHECK(data[index++] == (uint8_t)-1);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-
-		object = deserialize(data);
-		CHECK(object.isExt() == true);
-
-		Ext& ext = object.asExt();
-		CHECK(ext.type        == -1);
-		CHECK(ext.data.size() == 8);
-
-		time = extensionTimestampConvert(object);
-		CHECK(time.tv_sec  == sec);
-		CHECK(time.tv_nsec == nsec);
-	}
-
-	SUBCASE("pattern")
-	{
-		const uint64_t sec  = 0x0000'0001'2345'6789;
-		const uint32_t nsec = 0x0fed'cba9;
-		// 0x0fed'cba9
-		// 0b0000'1111'1110'1101'1100'1011'1010'1001
-		//                                      << 2
-		// 0b0011'1111'1011'0111'0010'1110'1010'0100
-		// 0x3fb7'2ea4
-
-		struct timespec time =
-		{	.tv_sec  = sec
-		,	.tv_nsec = nsec
-		};
-
-		Object object = extensionTimestampConvert(time);
-		{
-			Ext& ext = object.asExt();
-			CHECK(ext.type        == -1);
-			CHECK(ext.data.size() == 8);
-		}
-
-		std::vector<uint8_t> data = serialize(object);
-		CHECK(data.size() == 10);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext8);
-		CHECK(data[index++] == (uint8_t)-1);
-		CHECK(data[index++] == 0x3f);
-		CHECK(data[index++] == 0xb7);
-		CHECK(data[index++] == 0x2e);
-		CHECK(data[index++] == 0xa5); // 0xa4 | 0x01
-		CHECK(data[index++] == 0x23);
-		CHECK(data[index++] == 0x45);
-		CHECK(data[index++] == 0x67);
-		CHECK(data[index++] == 0x89);
-
-		object = deserialize(data);
-		CHECK(object.isExt() == true);
-
-		Ext& ext = object.asExt();
-		CHECK(ext.type        == -1);
-		CHECK(ext.data.size() == 8);
+	index++;
+	CHECK(test.object(index).is<std::pmr::vector<uint8_t>>());
+	CHECK(test.object(index).as<std::pmr::vector<uint8_t>>() == bin_16);
 
-		time = extensionTimestampConvert(object);
-		CHECK(time.tv_sec  == sec);
-		CHECK(time.tv_nsec == nsec);
-	}
+	index++;
+	CHECK(test.object(index).is<std::pmr::vector<uint8_t>>());
+	CHECK(test.object(index).as<std::pmr::vector<uint8_t>>() == bin_32);
 }
+#endif // }}}
 
-TEST_CASE("extension/timestamp/convert/96bit")
-{
-	SUBCASE("min")
-	{
-		const int64_t  sec  = 0x0000'0004'0000'0000;
-		const uint64_t nsec = 0x0000'0000;
-
-		struct timespec time =
-		{	.tv_sec  = sec
-		,	.tv_nsec = nsec
-		};
-
-		Object object = extensionTimestampConvert(time);
-		{
-			Ext& ext = object.asExt();
-			CHECK(ext.type        == -1);
-			CHECK(ext.data.size() == 12);
-		}
-
-		std::vector<uint8_t> data = serialize(object);
-		CHECK(data.size() == 15);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext8);
-		CHECK(data[index++] == 12);
-		CHECK(data[index++] == (uint8_t)-1);
-		// nsec
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		// sec
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x04);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
-		CHECK(data[index++] == 0x00);
 
-		object = deserialize(data);
-		CHECK(object.isExt() == true);
+/**
+ * \brief Append a vector of binary data.
+ *
+ * The \p value will be moved into the contents of the Array.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * std::pmr::vector<uint8_t> data = { 0xde, 0xad, 0xca, 0xfe };
+ * array.append(data);
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(std::pmr::vector<uint8_t>& value ///< The value to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
 
-		Ext& ext = object.asExt();
-		CHECK(ext.type        == -1);
-		CHECK(ext.data.size() == 12);
+	object_vector.emplace_back(Object{std::move(value)});
 
-		time = extensionTimestampConvert(object);
-		CHECK(time.tv_sec  == sec);
-		CHECK(time.tv_nsec == nsec);
-	}
+	return index;
+}
 
-	SUBCASE("max")
-	{
-		const int64_t  sec  = 0x7fff'ffff'ffff'ffff;
-		const uint64_t nsec = 0xffff'ffff;
 
-		struct timespec time =
-		{	.tv_sec  = sec
-		,	.tv_nsec = nsec
-		};
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/binary (move)")
+{
+	const std::pmr::vector<uint8_t> bin_0;
+	const std::pmr::vector<uint8_t> bin_8 (32, 'X');
+	const std::pmr::vector<uint8_t> bin_16(std::numeric_limits<uint8_t>::max() + 1 , '-');
+	const std::pmr::vector<uint8_t> bin_32(std::numeric_limits<uint16_t>::max() + 1, '|');
+	size_t count = 0;
 
-		Object object = extensionTimestampConvert(time);
-		{
-			Ext& ext = object.asExt();
-			CHECK(ext.type        == -1);
-			CHECK(ext.data.size() == 12);
-		}
+	std::pmr::vector<uint8_t> tmp_0(bin_0);
+	std::pmr::vector<uint8_t> tmp_8(bin_8);
+	std::pmr::vector<uint8_t> tmp_16(bin_16);
+	std::pmr::vector<uint8_t> tmp_32(bin_32);
 
-		std::vector<uint8_t> data = serialize(object);
-		CHECK(data.size() == 15);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext8);
-		CHECK(data[index++] == 12);
-		CHECK(data[index++] == (uint8_t)-1);
-		// nsec
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		// sec
-		CHECK(data[index++] == 0x7f);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
-		CHECK(data[index++] == 0xff);
+	Array array;
+	array.append(tmp_0);  count++;
+	array.append(tmp_8);  count++;
+	array.append(tmp_16); count++;
+	array.append(tmp_32); count++;
 
-		object = deserialize(data);
-		CHECK(object.isExt() == true);
+	CHECK(array.size() == count);
+	CHECK(tmp_0.empty());
+	CHECK(tmp_8.empty());
+	CHECK(tmp_16.empty());
+	CHECK(tmp_32.empty());
 
-		Ext& ext = object.asExt();
-		CHECK(ext.type        == -1);
-		CHECK(ext.data.size() == 12);
+	// Check serialized data
 
-		time = extensionTimestampConvert(object);
-		CHECK(time.tv_sec  == sec);
-		CHECK(time.tv_nsec == nsec);
-	}
+	std::vector<uint8_t> data = serialize(array);
 
-	SUBCASE("pattern")
-	{
-		const int64_t  sec  = 0x1234'5678'9abc'def0;
-		const uint64_t nsec = 0xfedc'ba98;
+	// Check deserialized data
 
-		struct timespec time =
-		{	.tv_sec  = sec
-		,	.tv_nsec = nsec
-		};
+	Object object = deserialize(data);
 
-		Object object = extensionTimestampConvert(time);
-		{
-			Ext& ext = object.asExt();
-			CHECK(ext.type        == -1);
-			CHECK(ext.data.size() == 12);
-		}
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
 
-		std::vector<uint8_t> data = serialize(object);
-		CHECK(data.size() == 15);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext8);
-		CHECK(data[index++] == 12);
-		CHECK(data[index++] == (uint8_t)-1);
-		// nsec
-		CHECK(data[index++] == 0xfe);
-		CHECK(data[index++] == 0xdc);
-		CHECK(data[index++] == 0xba);
-		CHECK(data[index++] == 0x98);
-		// sec
-		CHECK(data[index++] == 0x12);
-		CHECK(data[index++] == 0x34);
-		CHECK(data[index++] == 0x56);
-		CHECK(data[index++] == 0x78);
-		CHECK(data[index++] == 0x9a);
-		CHECK(data[index++] == 0xbc);
-		CHECK(data[index++] == 0xde);
-		CHECK(data[index++] == 0xf0);
+	size_t index = 0;
+	CHECK(test.object(index).is<std::pmr::vector<uint8_t>>());
+	CHECK(test.object(index).as<std::pmr::vector<uint8_t>>() == bin_0);
 
-		object = deserialize(data);
-		CHECK(object.isExt() == true);
+	index++;
+	CHECK(test.object(index).is<std::pmr::vector<uint8_t>>());
+	CHECK(test.object(index).as<std::pmr::vector<uint8_t>>() == bin_8);
 
-		Ext& ext = object.asExt();
-		CHECK(ext.type        == -1);
-		CHECK(ext.data.size() == 12);
+	index++;
+	CHECK(test.object(index).is<std::pmr::vector<uint8_t>>());
+	CHECK(test.object(index).as<std::pmr::vector<uint8_t>>() == bin_16);
 
-		time = extensionTimestampConvert(object);
-		CHECK(time.tv_sec  == sec);
-		CHECK(time.tv_nsec == nsec);
-	}
+	index++;
+	CHECK(test.object(index).is<std::pmr::vector<uint8_t>>());
+	CHECK(test.object(index).as<std::pmr::vector<uint8_t>>() == bin_32);
 }
 #endif // }}}
-// }}} Extensions: Timestamp
-// }}} Extensions
-// {{{ Utilities
-// {{{ Utilities::deserialize
+
 
 /**
- * \brief Deserialize MessagePack data.
+ * \brief Append a vector of binary data.
  *
- * The packed vector of \p data will be converted into an object that can be 
- * queried and used.
+ * The \p value will be moved into the contents of the Array.
  *
  * \parcode
- * std::vector<uint8_t> command_result = get_reply(command_id);
- *
- * zakero::messagepack::Object object;
- * object = zakero::messagepack::deserialize(command_result);
- * if(object.isArray() == false)
- * {
- * 	writeError(ERROR_INVALID_COMMAND_RESULT);
+ * zakero::messagepack::Array array;
+ * array.append(loadImage());
+ * \endparcode
  *
- * 	return;
- * }
- *
- * zakero::messagepack::Array& array = object.asArray();
- *
- * constexpr size_t success_index = 1;
- * constexpr size_t result_code_index = 2;
- * if(array(success_index).boolean == true)
- * {
- * 	writeError(array(error_code_index).as<int64_t>());
- * }
- * \endparcode
- *
- * \return The MessagePack Object.
+ * \return The index location of where the \p value was stored.
  */
-Object deserialize(const std::vector<uint8_t>& data ///< The packed data
+size_t Array::append(std::pmr::vector<uint8_t>&& value ///< The value to add
 	) noexcept
 {
-	size_t          index = 0;
-	std::error_code error = {};
+	const size_t index = object_vector.size();
 
-	return deserialize(data, index, error);
+	object_vector.emplace_back(Object{std::move(value)});
+
+	return index;
 }
 
 
 /**
- * \brief Deserialize MessagePack data.
+ * \brief Append an Array.
  *
- * The packed vector of \p data will be converted into an object that can be 
- * queried and used.
+ * The \p array will be appended to the contents of this Array.
  *
  * \parcode
- * std::vector<uint8_t> command_result = get_reply(command_id);
- *
- * zakero::messagepack::Object object;
- * std::error_code             error;
- * object = zakero::messagepack::deserialize(command_result, error);
- * if(error)
- * {
- *	writeError(ERROR_INVALID_COMMAND_RESULT);
- *
- * 	return;
- * }
- *
- * zakero::messagepack::Array& array = object.asArray();
+ * zakero::messagepack::Array sub_array;
+ * sub_array.append(false);
+ * sub_array.append(0x42);
  *
- * constexpr size_t error_index = 1;
- * constexpr size_t error_code_index = 2;
- * if(array(error_index).as<bool>() == true)
- * {
- * 	writeError(array(error_code_index).as<int64_t>());
- * }
+ * zakero::messagepack::Array array;
+ * array.append(sub_array);
  * \endparcode
  *
- * \return The MessagePack Object.
+ * \return The index location of where the \p value was stored.
  */
-Object deserialize(const std::vector<uint8_t>& data  ///< The packed data
-	, std::error_code&                     error ///< The error code
+size_t Array::append(const Array& array ///< The Array to add
 	) noexcept
 {
-	size_t index = 0;
+	size_t index = object_vector.size();
+	object_vector.emplace_back(Object{Array{}});
 
-	return deserialize(data, index, error);
+	Array& sub_array = object_vector[index].asArray();
+	sub_array.object_vector = array.object_vector;
+
+	return index;
 }
 
 
-/**
- * \brief Deserialize MessagePack data.
- *
- * The packed vector of \p data will be converted into an object that can be 
- * queried and used.
- *
- * \parcode
- * std::vector<uint8_t> command_result = get_reply(command_id);
- *
- * zakero::messagepack::Object object;
- * size_t                      index;
- * object = zakero::messagepack::deserialize(command_result, index);
- * if(object.isArray() == false)
- * {
- *	writeError(ERROR_INVALID_COMMAND_RESULT);
- *
- * 	return;
- * }
- *
- * zakero::messagepack::Array& array = object.asArray();
- *
- * constexpr size_t error_index = 1;
- * constexpr size_t error_code_index = 2;
- * if(array(error_index).as<bool>() == true)
- * {
- * 	writeError(array(error_code_index).as<int64_t>());
- * }
- * \endparcode
- *
- * \return The MessagePack Object.
- */
-Object deserialize(const std::vector<uint8_t>& data  ///< The packed data
-	, size_t&                              index ///< The starting index
-	) noexcept
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/array (copy)")
 {
-	std::error_code error = {};
+	messagepack::Array sub_0;
+	messagepack::Array sub_1;
+		sub_1.appendNull();
+	messagepack::Array sub_2;
+		sub_2.append(true);
+		sub_2.append(false);
+	messagepack::Array sub_3;
+		sub_3.append(std::string_view("Hello"));
+		sub_3.append(std::string_view("World"));
+	size_t count = 0;
 
-	return deserialize(data, index, error);
+	const messagepack::Array tmp_0 = sub_0;
+	const messagepack::Array tmp_1 = sub_1;
+	const messagepack::Array tmp_2 = sub_2;
+	const messagepack::Array tmp_3 = sub_3;
+
+	Array array;
+	array.append(tmp_0); count++;
+	array.append(tmp_1); count++;
+	array.append(tmp_2); count++;
+	array.append(tmp_3); count++;
+
+	CHECK(array.size() == count);
+	CHECK(tmp_0.size() == 0);
+	CHECK(tmp_1.size() == 1);
+	CHECK(tmp_2.size() == 2);
+	CHECK(tmp_3.size() == 2);
+
+	// Check serialized data
+
+	std::vector<uint8_t> data = serialize(array);
+
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
+
+	size_t index = 0;
+	CHECK(test.object(index).isArray());
+	CHECK(test.object(index).asArray().size() == 0);
+
+	index++;
+	CHECK(test.object(index).isArray());
+	CHECK(test.object(index).asArray().size() == 1);
+	CHECK(test.object(index).asArray().object(0).isNull());
+
+	index++;
+	CHECK(test.object(index).isArray());
+	CHECK(test.object(index).asArray().size() == 2);
+	CHECK(test.object(index).asArray().object(0).is<bool>());
+	CHECK(test.object(index).asArray().object(0).as<bool>() == true);
+	CHECK(test.object(index).asArray().object(1).is<bool>());
+	CHECK(test.object(index).asArray().object(1).as<bool>() == false);
+
+	index++;
+	CHECK(test.object(index).isArray());
+	CHECK(test.object(index).asArray().size() == 2);
+	CHECK(test.object(index).asArray().object(0).is<std::pmr::string>());
+	CHECK(test.object(index).asArray().object(0).as<std::pmr::string>() == "Hello");
+	CHECK(test.object(index).asArray().object(1).is<std::pmr::string>());
+	CHECK(test.object(index).asArray().object(1).as<std::pmr::string>() == "World");
 }
+#endif // }}}
 
 
 /**
- * \brief Deserialize MessagePack data.
+ * \brief Append an Array.
  *
- * The packed vector of \p data will be converted into an object that can be 
- * queried and used.
+ * The \p array will be appended to the contents of this Array.
  *
  * \parcode
- * std::vector<uint8_t> command_result = get_reply(command_id);
- *
- * zakero::messagepack::Object object;
- * size_t index;
- * std::error_code error;
- * object = zakero::messagepack::deserialize(command_result, index, error);
- * if(object.isArray() == false)
- * {
- *	writeError(ERROR_INVALID_COMMAND_RESULT, error);
- *
- * 	// index points to the end of the "object"
- * 	crashAnalysis(&command_result[index]);
- *
- * 	return;
- * }
- *
- * zakero::messagepack::Array& array = object.asArray();
+ * zakero::messagepack::Array sub_array;
+ * sub_array.append(false);
+ * sub_array.append(0x42);
  *
- * constexpr size_t error_index = 1;
- * constexpr size_t error_code_index = 2;
- * if(array(error_index).as<bool>() == true)
- * {
- * 	writeError(array(error_code_index).as<int64_t>());
- * }
+ * zakero::messagepack::Array array;
+ * array.append(sub_array);
  * \endparcode
  *
- * \return The MessagePack Object.
+ * \return The index location of where the \p value was stored.
  */
-Object deserialize(const std::vector<uint8_t>& data  ///< The packed data
-	, size_t&                              index ///< The starting index
-	, std::error_code&                     error ///< The error code
+size_t Array::append(Array& array ///< The Array to add
 	) noexcept
 {
-	error = Error_None;
+	size_t index = object_vector.size();
+	object_vector.emplace_back(Object{Array{}});
 
-	if(data.size() == 0)
-	{
-		error = Error_No_Data;
-		return {};
-	}
+	Array& sub_array = object_vector[index].asArray();
+	sub_array.object_vector = std::move(array.object_vector);
 
-	if(index >= data.size())
-	{
-		error = Error_Invalid_Index;
-		return {};
-	}
+	return index;
+}
 
-	const uint8_t format_byte = data[index++];
 
-	const Format format_type = (Format)format_byte;
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/array (move)")
+{
+	messagepack::Array sub_0;
+	messagepack::Array sub_1;
+		sub_1.appendNull();
+	messagepack::Array sub_2;
+		sub_2.append(true);
+		sub_2.append(false);
+	messagepack::Array sub_3;
+		sub_3.append(std::string_view("Hello"));
+		sub_3.append(std::string_view("World"));
+	size_t count = 0;
 
-	if((index + formatSize(format_type) - 1) > data.size())
-	{
-		error = Error_Incomplete;
-		return {};
-	}
+	messagepack::Array tmp_0 = sub_0;
+	messagepack::Array tmp_1 = sub_1;
+	messagepack::Array tmp_2 = sub_2;
+	messagepack::Array tmp_3 = sub_3;
 
-	if(format_type == Format::Never_Used)
-	{
-		error = Error_Invalid_Format_Type;
-		return {};
-	}
+	Array array;
+	array.append(tmp_0); count++;
+	array.append(tmp_1); count++;
+	array.append(tmp_2); count++;
+	array.append(tmp_3); count++;
 
-	switch(format_type)
-	{
-		case Format::Nill:
-			return Object{};
+	CHECK(array.size() == count);
+	CHECK(tmp_0.size() == 0);
+	CHECK(tmp_1.size() == 0);
+	CHECK(tmp_2.size() == 0);
+	CHECK(tmp_3.size() == 0);
 
-		case Format::False:
-			return Object{false};
+	// Check serialized data
 
-		case Format::True:
-			return Object{true};
+	std::vector<uint8_t> data = serialize(array);
 
-		case Format::Int8:
-			Convert.int64 = (int8_t)data[index++];
-			return Object{Convert.int64};
-	
-		case Format::Int16:
-			Convert.uint64 = 0;
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			return Object{int64_t(Convert.int16)};
-
-		case Format::Int32:
-			Convert.uint64 = 0;
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			return Object{int64_t(Convert.int32)};
-	
-		case Format::Int64:
-			Convert_Byte7 = data[index++];
-			Convert_Byte6 = data[index++];
-			Convert_Byte5 = data[index++];
-			Convert_Byte4 = data[index++];
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			return Object{Convert.int64};
-	
-		case Format::Uint8:
-			Convert.uint64 = data[index++];
-			return Object{Convert.uint64};
-	
-		case Format::Uint16:
-			Convert.uint64 = 0;
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			return Object{Convert.uint64};
-	
-		case Format::Uint32:
-			Convert.uint64 = 0;
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			return Object{Convert.uint64};
-
-		case Format::Uint64:
-			Convert_Byte7 = data[index++];
-			Convert_Byte6 = data[index++];
-			Convert_Byte5 = data[index++];
-			Convert_Byte4 = data[index++];
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			return Object{Convert.uint64};
-	
-		case Format::Float32:
-			Convert.uint64 = 0;
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			return Object{Convert.float32};
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
+
+	size_t index = 0;
+	CHECK(test.object(index).isArray());
+	CHECK(test.object(index).asArray().size() == 0);
+
+	index++;
+	CHECK(test.object(index).isArray());
+	CHECK(test.object(index).asArray().size() == 1);
+	CHECK(test.object(index).asArray().object(0).isNull());
+
+	index++;
+	CHECK(test.object(index).isArray());
+	CHECK(test.object(index).asArray().size() == 2);
+	CHECK(test.object(index).asArray().object(0).is<bool>());
+	CHECK(test.object(index).asArray().object(0).as<bool>() == true);
+	CHECK(test.object(index).asArray().object(1).is<bool>());
+	CHECK(test.object(index).asArray().object(1).as<bool>() == false);
+
+	index++;
+	CHECK(test.object(index).isArray());
+	CHECK(test.object(index).asArray().size() == 2);
+	CHECK(test.object(index).asArray().object(0).is<std::pmr::string>());
+	CHECK(test.object(index).asArray().object(0).as<std::pmr::string>() == "Hello");
+	CHECK(test.object(index).asArray().object(1).is<std::pmr::string>());
+	CHECK(test.object(index).asArray().object(1).as<std::pmr::string>() == "World");
+}
+#endif // }}}
+
+
+/**
+ * \brief Append an Array.
+ *
+ * The \p array will be moved into the contents of this Array.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.append(createList());
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(Array&& array ///< The Array to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.emplace_back(Object{std::move(array)});
+
+	return index;
+}
+
+
+/**
+ * \brief Append an extension.
+ *
+ * The \p value will be appended to the contents of this Array.
+ *
+ * \parcode
+ * zakero::messagepack::Ext ext;
+ * ext.type = 42;
+ * ext.data = std::pmr::vector<uint8_t>(42, '*');
+ *
+ * zakero::messagepack::Array array;
+ * array.append(ext);
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(const Ext& ext ///< The Ext to add
+	) noexcept
+{
+	size_t index = object_vector.size();
+	object_vector.emplace_back(Object{ext});
+
+	return index;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/ext (copy)")
+{
+	const uint8_t chr_16 = '-';
+	const uint8_t chr_32 = '|';
+
+	Ext ext_0;
+	ext_0.type = 0;
+	ext_0.data = {};
+
+	const Ext ext_16 =
+	{	.data = std::pmr::vector<uint8_t>(16, chr_16)
+	,	.type = 16
+	};
+
+	const Ext ext_32 =
+	{	.data = std::pmr::vector<uint8_t>(32, chr_32)
+	,	.type = 32
+	};
+
+	size_t count = 0;
+	Array array;
+	array.append(ext_0);  count++;
+	array.append(ext_16); count++;
+	array.append(ext_32); count++;
+
+	CHECK(array.size() == count);
+	CHECK(ext_0.data.size()  == 0);
+	CHECK(ext_16.data.size() == 16);
+	CHECK(ext_32.data.size() == 32);
+
+	// Check serialized data
+
+	std::vector<uint8_t> data = serialize(array);
+
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
+
+	size_t index = 0;
+	CHECK(test.object(index).isExt() == true);
+	CHECK(test.object(index).asExt().type == 0);
+	CHECK(test.object(index).asExt().data.size() == 0);
+
+	index++;
+	CHECK(test.object(index).isExt() == true);
+	CHECK(test.object(index).asExt().type == 16);
+	CHECK(test.object(index).asExt().data.size() == 16);
+	for(size_t i = 0; i < test.object(index).asExt().data.size(); i++)
+	{
+		CHECK(test.object(index).asExt().data[i] == chr_16);
+	}
+
+	index++;
+	CHECK(test.object(index).isExt() == true);
+	CHECK(test.object(index).asExt().type == 32);
+	CHECK(test.object(index).asExt().data.size() == 32);
+	for(size_t i = 0; i < test.object(index).asExt().data.size(); i++)
+	{
+		CHECK(test.object(index).asExt().data[i] == chr_32);
+	}
+}
+#endif // }}}
+
+
+/**
+ * \brief Append an extension.
+ *
+ * The \p value will be appended to the contents of this Array.
+ *
+ * \parcode
+ * zakero::messagepack::Ext ext;
+ * ext.type = 42;
+ * ext.data = std::pmr::vector<uint8_t>(42, '*');
+ *
+ * zakero::messagepack::Array array;
+ * array.append(ext);
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(Ext& ext ///< The Ext to add
+	) noexcept
+{
+	size_t index = object_vector.size();
+	object_vector.push_back(Object{std::move(ext)});
+
+	return index;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/ext (move)")
+{
+	const uint8_t chr_16 = '-';
+	const uint8_t chr_32 = '|';
+
+	Ext ext_0;
+	ext_0.type = 0;
+	ext_0.data = {};
+
+	Ext ext_16;
+	ext_16.type = 16;
+	ext_16.data = std::pmr::vector<uint8_t>(16, chr_16);
+
+	Ext ext_32;
+	ext_32.type = 32;
+	ext_32.data = std::pmr::vector<uint8_t>(32, chr_32);
+
+	size_t count = 0;
+	Array array;
+	array.append(ext_0);  count++;
+	array.append(ext_16); count++;
+	array.append(ext_32); count++;
+
+	CHECK(array.size() == count);
+	CHECK(ext_16.data.size() == 0);
+	CHECK(ext_32.data.size() == 0);
+
+	// Check serialized data
+
+	std::vector<uint8_t> data = serialize(array);
+
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
+
+	size_t index = 0;
+	CHECK(test.object(index).isExt());
+	CHECK(test.object(index).asExt().type == 0);
+	CHECK(test.object(index).asExt().data.size() == 0);
+
+	index++;
+	CHECK(test.object(index).isExt());
+	CHECK(test.object(index).asExt().type == 16);
+	CHECK(test.object(index).asExt().data.size() == 16);
+	for(size_t i = 0; i < test.object(index).asExt().data.size(); i++)
+	{
+		CHECK(test.object(index).asExt().data[i] == chr_16);
+	}
+
+	index++;
+	CHECK(test.object(index).isExt());
+	CHECK(test.object(index).asExt().type == 32);
+	CHECK(test.object(index).asExt().data.size() == 32);
+	for(size_t i = 0; i < test.object(index).asExt().data.size(); i++)
+	{
+		CHECK(test.object(index).asExt().data[i] == chr_32);
+	}
+}
+#endif // }}}
+
+
+/**
+ * \brief Append an extension.
+ *
+ * The \p ext will be moved into the contents of this Array.
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(Ext&& ext ///< The Ext to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.emplace_back(Object{std::move(ext)});
+
+	return index;
+}
+
+
+/**
+ * \brief Append a Map.
+ *
+ * The \p value will be appended to the contents of this Array.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ * map.set(Object{42}, Object{std::pmr::string("foo")});
+ *
+ * zakero::messagepack::Array array;
+ * array.append(map);
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(const Map& map ///< The Map to add
+	) noexcept
+{
+	size_t index = object_vector.size();
+	object_vector.emplace_back(Object{map});
+
+	return index;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/map (copy)")
+{
+	const Object key_1 = Object{true};
+	const Object key_2 = Object{int64_t(0)};
+
+	const std::pmr::string str("Hello, World!");
+	const uint64_t    num(21);
+
+	const Object val_1 = Object{str};
+	const Object val_2 = Object{num};
+
+	Map map_1;
+	map_1.set(key_1, val_1);
+	map_1.set(key_2, val_2);
+
+	Map map_2;
+	map_2.set(val_1, key_1);
+	map_2.set(val_2, key_2);
+
+	size_t count = 0;
+	Array array;
+	array.append((const Map)map_1); count++;
+	array.append((const Map)map_2); count++;
+
+	CHECK(map_1.size() == 2);
+	CHECK(map_2.size() == 2);
+	CHECK(array.size() == count);
+
+	// Check serialized data
+
+	std::vector<uint8_t> data = serialize(array);
+
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
+
+	size_t index = 0;
+	CHECK(test.object(index).isMap());
+	CHECK(test.object(index).asMap().size() == 2);
+	CHECK(test.object(index).asMap().keyExists(key_1) == true);
+	CHECK(test.object(index).asMap().at(key_1) == val_1);
+	CHECK(test.object(index).asMap().keyExists(key_2) == true);
+	CHECK(test.object(index).asMap().at(key_2) == val_2);
+
+	index++;
+	CHECK(test.object(index).isMap());
+	CHECK(test.object(index).asMap().size() == 2);
+	CHECK(test.object(index).asMap().keyExists(val_1) == true);
+	CHECK(test.object(index).asMap().at(val_1) == key_1);
+	CHECK(test.object(index).asMap().keyExists(val_2) == true);
+	CHECK(test.object(index).asMap().at(val_2) == key_2);
+}
+#endif // }}}
+
+
+/**
+ * \brief Append a Map.
+ *
+ * The \p value will be appended to the contents of this Array.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ * map.set(Object{42}, Object{std::pmr::string("foo")});
+ *
+ * zakero::messagepack::Array array;
+ * array.append(map);
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(Map& map ///< The Map to add
+	) noexcept
+{
+	size_t index = object_vector.size();
+	object_vector.push_back(Object{std::move(map)});
+
+	return index;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/map (move)")
+{
+	const Object key_1 = Object{true};
+	const Object key_2 = Object{int64_t(0)};
+
+	const std::pmr::string str("Hello, World!");
+	const uint64_t    num(21);
+
+	const Object val_1 = Object{str};
+	const Object val_2 = Object{num};
+
+	Map map_1;
+	map_1.set(key_1, val_1);
+	map_1.set(key_2, val_2);
+
+	Map map_2;
+	map_2.set(val_1, key_1);
+	map_2.set(val_2, key_2);
+
+	size_t count = 0;
+	Array array;
+	array.append(map_1); count++;
+	array.append(map_2); count++;
+
+	CHECK(array.size() == count);
+	CHECK(map_1.size() == 0);
+	CHECK(map_2.size() == 0);
+
+	// Check serialized data
+
+	std::vector<uint8_t> data = serialize(array);
+
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
+
+	size_t index = 0;
+	CHECK(test.object(index).isMap());
+	CHECK(test.object(index).asMap().size() == 2);
+	CHECK(test.object(index).asMap().keyExists(key_1) == true);
+	CHECK(test.object(index).asMap().at(key_1) == val_1);
+	CHECK(test.object(index).asMap().keyExists(key_2) == true);
+	CHECK(test.object(index).asMap().at(key_2) == val_2);
+
+	index++;
+	CHECK(test.object(index).isMap());
+	CHECK(test.object(index).asMap().size() == 2);
+	CHECK(test.object(index).asMap().keyExists(val_1) == true);
+	CHECK(test.object(index).asMap().at(val_1) == key_1);
+	CHECK(test.object(index).asMap().keyExists(val_2) == true);
+	CHECK(test.object(index).asMap().at(val_2) == key_2);
+}
+#endif // }}}
+
+
+/**
+ * \brief Append a Map.
+ *
+ * The \p map will be moved into the contents of this Array.
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(Map&& map ///< The Map to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.emplace_back(Object{std::move(map)});
+
+	return index;
+}
+
+
+/**
+ * \brief Append an Object.
+ *
+ * The \p value will be appended to the contents of this Array.
+ *
+ * \parcode
+ * const zakero::messagepack::Object object{int8_t(42)};
+ * zakero::messagepack::Array array;
+ * array.append(object);
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(const Object& object ///< The object to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.push_back(object);
+
+	return index;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/object (copy)")
+{
+	messagepack::Object obj_0 = Object{true};
+	messagepack::Object obj_1 = Object{(uint64_t)42};
+	messagepack::Object obj_2 = Object{std::pmr::string("foo")};
+
+	const messagepack::Object tmp_0 = obj_0;
+	const messagepack::Object tmp_1 = obj_1;
+	const messagepack::Object tmp_2 = obj_2;
+	size_t count = 0;
+
+	Array array;
+	array.append(tmp_0); count++;
+	array.append(tmp_1); count++;
+	array.append(tmp_2); count++;
+
+	CHECK(array.size() == count);
+	CHECK(tmp_0.isNull() == false);
+	CHECK(tmp_1.isNull() == false);
+	CHECK(tmp_2.isNull() == false);
+
+	// Check serialized data
+
+	std::vector<uint8_t> data = serialize(array);
+
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
+
+	size_t index = 0;
+	CHECK(test.object(index).is<bool>());
+	CHECK(test.object(index).as<bool>() == true);
+
+	index++;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == 42);
+
+	index++;
+	CHECK(test.object(index).is<std::pmr::string>());
+	CHECK(test.object(index).as<std::pmr::string>() == "foo");
+}
+#endif // }}}
+
+
+/**
+ * \brief Append an Object.
+ *
+ * The \p value will be appended to the contents of this Array.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.append( Object{ int8_t(42) } );
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(Object& object ///< The object to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.push_back(std::move(object));
+	object = Object{};
+
+	return index;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/object (move)")
+{
+	messagepack::Object obj_0 = Object{true};
+	messagepack::Object obj_1 = Object{(uint64_t)42};
+	messagepack::Object obj_2 = Object{std::pmr::string("foo")};
+
+	messagepack::Object tmp_0 = obj_0;
+	messagepack::Object tmp_1 = obj_1;
+	messagepack::Object tmp_2 = obj_2;
+	size_t count = 0;
+
+	Array array;
+	array.append(tmp_0); count++;
+	array.append(tmp_1); count++;
+	array.append(tmp_2); count++;
+
+	CHECK(array.size() == count);
+	CHECK(tmp_0.isNull() == true);
+	CHECK(tmp_1.isNull() == true);
+	CHECK(tmp_2.isNull() == true);
+
+	// Check serialized data
+
+	std::vector<uint8_t> data = serialize(array);
+
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
+
+	size_t index = 0;
+	CHECK(test.object(index).is<bool>());
+	CHECK(test.object(index).as<bool>() == true);
+
+	index++;
+	CHECK(test.object(index).is<uint64_t>());
+	CHECK(test.object(index).as<uint64_t>() == 42);
+
+	index++;
+	CHECK(test.object(index).is<std::pmr::string>());
+	CHECK(test.object(index).as<std::pmr::string>() == "foo");
+}
+#endif // }}}
+
+
+/**
+ * \brief Append an Object.
+ *
+ * The \p object will be moved into the contents of this Array.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.append(zakero::messagepack::deserialize(data));
+ * \endparcode
+ *
+ * \return The index location of where the \p value was stored.
+ */
+size_t Array::append(Object&& object ///< The object to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.push_back(std::move(object));
+
+	return index;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/rvalue")
+{
+	std::pmr::vector<uint8_t> binary(1'000, 'b');
+	Array                     sub_array;
+	Ext                       ext;
+	Map                       map;
+	Object                    object = {std::pmr::string(100, 'o')};
+
+	sub_array.append(int64_t(1));
+	ext.data = std::pmr::vector<uint8_t>(100, 'e');
+	map.set(Object{"key"}, Object{"value"});
+
+	const uint8_t* binary_data = binary.data();
+	const Object*  array_data  = sub_array.object_vector.data();
+	const uint8_t* ext_data    = ext.data.data();
+	const Object*  map_key     = &map.key(0);
+	const char*    object_data = object.asString().data();
+
+	Array array;
+	CHECK(array.append(std::move(binary))    == 0);
+	CHECK(array.append(std::move(sub_array)) == 1);
+	CHECK(array.append(std::move(ext))       == 2);
+	CHECK(array.append(std::move(map))       == 3);
+	CHECK(array.append(std::move(object))    == 4);
+
+	// Nothing was copied
+
+	CHECK(array[0].asBinary().data()             == binary_data);
+	CHECK(array[1].asArray().object_vector.data() == array_data);
+	CHECK(array[2].asExt().data.data()           == ext_data);
+	CHECK(&array[3].asMap().key(0)               == map_key);
+	CHECK(array[4].asString().data()             == object_data);
+
+	CHECK(array[1].asArray()[0].as<int64_t>() == 1);
+	CHECK(array[3].asMap()["key"].asString()  == "value");
+
+	// Temporaries are moved
+
+	array.append(Array{});
+	array.append(Map{});
+	array.append(std::pmr::vector<uint8_t>(10, 't'));
+	CHECK(array[5].isArray());
+	CHECK(array[6].isMap());
+	CHECK(array[7].asBinary().size() == 10);
+}
+#endif // }}}
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/emplace")
+{
+	Array array;
+
+	CHECK(array.emplace<int64_t>(-1) == -1);
+	CHECK(array.emplace<std::pmr::string>("string") == "string");
+	CHECK(array.emplace<std::pmr::vector<uint8_t>>(10, 'b').size() == 10);
+	array.emplace<std::monostate>();
+
+	Map& map = array.emplace<Map>();
+	map.emplace<Array>("list").emplace<bool>(true);
+
+	Array& sub = array.emplace<Array>();
+	sub.emplace<Array>().emplace<Array>().emplace<uint64_t>(3);
+
+	CHECK(array.size() == 6);
+	CHECK(array[0].as<int64_t>() == -1);
+	CHECK(array[1].asString() == "string");
+	CHECK(array[2].asBinary().size() == 10);
+	CHECK(array[3].isNull());
+	CHECK(array[4].asMap()["list"].asArray()[0].as<bool>() == true);
+	CHECK(array[5].asArray()[0].asArray()[0].asArray()[0].as<uint64_t>() == 3);
+
+	// Same as building with append()
+
+	Array expect;
+	expect.append(int64_t(-1));
+	expect.append(std::string_view("string"));
+	expect.append(std::pmr::vector<uint8_t>(10, 'b'));
+	expect.appendNull();
+
+	Map expect_map;
+	Array expect_list;
+	expect_list.append(true);
+	expect_map.set(Object{"list"}, Object{std::move(expect_list)});
+	expect.append(std::move(expect_map));
+
+	Array level_3;
+	level_3.append(uint64_t(3));
+	Array level_2;
+	level_2.append(std::move(level_3));
+	Array level_1;
+	level_1.append(std::move(level_2));
+	expect.append(std::move(level_1));
+
+	CHECK(serialize(array) == serialize(expect));
+}
+#endif // }}}
+
+
+/**
+ * \brief Append a "Null" value.
+ *
+ * A "Null" value will be appended to the contents of this Array.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.appendNull();
+ * \endparcode
+ *
+ * \return The index location of where the value was stored.
+ */
+size_t Array::appendNull() noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.emplace_back();
+
+	return index;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/null")
+{
+	const size_t count = std::numeric_limits<uint16_t>::max() + 1;
+	Array array;
+
+	for(size_t i = 0; i < count; i++)
+	{
+		array.append(Object{true});
+	}
+
+	CHECK(array.size() == count);
+
+	// Check serialized data
+
+	std::vector<uint8_t> data = serialize(array);
+
+	// Check deserialized data
+
+	Object object = deserialize(data);
+
+	CHECK(object.isArray());
+	Array& test = object.asArray();
+	CHECK(test.size() == count);
+
+	for(size_t i = 0; i < count; i++)
+	{
+		CHECK(test.object(i).is<bool>());
+		CHECK(test.object(i).as<bool>() == true);
+	}
+}
+#endif // }}}
+
+
+/**
+ * \brief Append a range of floating point values.
+ *
+ * All the values in the \p range will be appended to the contents of the
+ * Array, which is faster than calling append() for each value. When the
+ * Array will be serialized without changes, Packer::packArray() can pack
+ * the \p range directly.
+ *
+ * \parcode
+ * std::vector<float> sample = sensor.read();
+ *
+ * zakero::messagepack::Array array;
+ * array.appendRange(sample);
+ * \endparcode
+ *
+ * \return The index location of where the first value was stored.
+ */
+size_t Array::appendRange(const std::span<const float> range ///< The values to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.reserve(index + range.size());
+
+	for(const float value : range)
+	{
+		object_vector.emplace_back(Object{value});
+	}
+
+	return index;
+}
+
+
+/**
+ * \brief Append a range of floating point values.
+ *
+ * \copydetails appendRange(const std::span<const float>)
+ */
+size_t Array::appendRange(const std::span<const double> range ///< The values to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.reserve(index + range.size());
+
+	for(const double value : range)
+	{
+		object_vector.emplace_back(Object{value});
+	}
+
+	return index;
+}
+
+
+/**
+ * \brief Append a range of signed integer values.
+ *
+ * All the values in the \p range will be appended to the contents of the
+ * Array as `int64_t`, which is faster than calling append() for each value.
+ *
+ * \return The index location of where the first value was stored.
+ */
+size_t Array::appendRange(const std::span<const int32_t> range ///< The values to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.reserve(index + range.size());
+
+	for(const int32_t value : range)
+	{
+		object_vector.emplace_back(Object{int64_t(value)});
+	}
+
+	return index;
+}
+
+
+/**
+ * \brief Append a range of signed integer values.
+ *
+ * \copydetails appendRange(const std::span<const int32_t>)
+ */
+size_t Array::appendRange(const std::span<const int64_t> range ///< The values to add
+	) noexcept
+{
+	const size_t index = object_vector.size();
+
+	object_vector.reserve(index + range.size());
+
+	for(const int64_t value : range)
+	{
+		object_vector.emplace_back(Object{value});
+	}
+
+	return index;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("array/append/range")
+{
+	const std::vector<float>   f = {0.5f, -1.25f, 3.0f};
+	const std::vector<double>  d = {2.5, -0.125};
+	const std::vector<int32_t> i = {std::numeric_limits<int32_t>::min(), -1, 0, 200};
+	const std::vector<int64_t> l = {std::numeric_limits<int64_t>::max()};
+
+	Array array;
+	array.appendNull();
+
+	CHECK(array.appendRange(f) == 1);
+	CHECK(array.appendRange(d) == 4);
+	CHECK(array.appendRange(i) == 6);
+	CHECK(array.appendRange(l) == 10);
+	CHECK(array.appendRange(std::span<const float>{}) == 11);
+	CHECK(array.size() == 11);
+
+	CHECK(array.object(0).isNull());
+	CHECK(array.object(1).as<float>()    == 0.5f);
+	CHECK(array.object(3).as<float>()    == 3.0f);
+	CHECK(array.object(4).as<double>()   == 2.5);
+	CHECK(array.object(5).as<double>()   == -0.125);
+	CHECK(array.object(6).as<int64_t>()  == std::numeric_limits<int32_t>::min());
+	CHECK(array.object(9).as<int64_t>()  == 200);
+	CHECK(array.object(10).as<int64_t>() == std::numeric_limits<int64_t>::max());
+
+	Array expected;
+	expected.appendNull();
+	for(const float   value : f) { expected.append(value); }
+	for(const double  value : d) { expected.append(value); }
+	for(const int32_t value : i) { expected.append(int64_t(value)); }
+	for(const int64_t value : l) { expected.append(value); }
+
+	CHECK(serialize(array) == serialize(expected));
+}
+#endif // }}}
+
+
+/**
+ * \fn zakero::messagepack::Array::object(const size_t)
+ *
+ * \brief Access a data object.
+ *
+ * After data has been added to the Array, that data can still be access by 
+ * using its index value. The data object's type will be the C++ datatype, not 
+ * the MessagePack format type.
+ *
+ * The returned Object can be modified as needed.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * size_t index_foo = array.append(int64_t(0));
+ * size_t index_bar = array.append(int64_t(0));
+ *
+ * int64_t val = rand();
+ * array.object(index_foo) = val;
+ * if(val & 1)
+ * {
+ *      // Change to string
+ * 	array.object(index_bar) = "That's odd...";
+ * }
+ * else
+ * {
+ *      // Change to boolean
+ * 	array.object(index_bar) = true;
+ * }
+ * \endparcode
+ *
+ * \return The data object.
+ *
+ * \param  index  The index of the data object.
+ */
+
+
+// No tests needed, functionality is tested else where.
+
+
+/**
+ * \fn zakero::messagepack::Array::object(const size_t) const
+ *
+ * \brief Access a data object.
+ *
+ * After data has been added to the Array, that data can still be access by 
+ * using its index value. The data object's type will be the C++ datatype, not 
+ * the MessagePack format type.
+ *
+ * The returned Object is Read-Only.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * size_t index_foo = array.append(int64_t(0));
+ * size_t index_bar = array.append(int64_t(0));
+ *
+ * int64_t val = rand();
+ * if(array.object(index_foo) > val)
+ * {
+ * 	std::cout << "Foo Bigger\n";
+ * }
+ *
+ * if(array.object(index_bar) > val)
+ * {
+ * 	std::cout << "Bar Bigger\n";
+ * }
+ * \endparcode
+ *
+ * \return The data object.
+ *
+ * \param  index  The index of the data object.
+ */
+
+
+// No tests needed, functionality is tested else where.
+
+
+/**
+ * \fn zakero::messagepack::Array::clear()
+ *
+ * \brief Remove all data from the Array.
+ *
+ * Remove all data from the Array.
+ */
+
+
+// No tests needed, a pass-thru to the std::vector<Object>.
+
+
+/**
+ * \fn zakero::messagepack::Array::size()
+ *
+ * \brief Get the size of the Array.
+ *
+ * \return The Array size.
+ */
+
+
+// No tests needed, a pass-thru to the std::vector<Object>.
+
+// }}} Array
+// {{{ Ext
+
+/**
+ * \struct Ext
+ *
+ * \brief Extension Data.
+ *
+ * The MessagePack specification defines a structure to hold new data-types and 
+ * this structure implements that feature. To add a new data-type, set the 
+ * Ext::type to a positive value and then fill the Ext::data with the 
+ * information to be stored.
+ *
+ * \note Negative Ext::type value are reserved for use by the MessagePack 
+ * specification.
+ *
+ * As an example, to add a GIF data-type, define the type value then fill the 
+ * Ext::data with the GIF.
+ * 
+ * \parcode
+ * #define TYPE_GIF    2
+ * #define INDEX_NAME  0
+ * #define INDEX_FILE  1
+ * #define INDEX_IMAGE 2
+ *
+ * zakero::messagepack::Array array = {};
+ * array.append({std::string_view("Super-Sonic Scooter")});
+ * array.append({std::string_view("super_sonic_scooter.gif")});
+ *
+ * zakero::messagepack::Ext gif = {};
+ * gif.type = TYPE_GIF;
+ * gif.data = loadGif("super_sonic_scooter.gif");
+ * array.append(gif);
+ *
+ * auto data = zakero::messagepack::serialize(array);
+ *
+ * // ...somewhere later...
+ *
+ * zakero::messagepack::Object object = zakero::messagepack::deserialize(data);
+ * zakero::messagepack::Array image = object.asArray();
+ *
+ * std::string_view image_name = image.object(INDEX_NAME).asString();
+ * std::string_view image_file = image.object(INDEX_FILE).asString();
+ *
+ * zakero::messagepack::Ext raw_data = image.object(INDEX_IMAGE).asExt();
+ * Image image;
+ * if(raw_data.type == TYPE_GIF)
+ * {
+ * 	image = parseGif(raw_data.data);
+ * }
+ * \endparcode
+ */
+
+/**
+ * \var Ext::data
+ *
+ * \brief Extension binary data.
+ */
+
+/**
+ * \var Ext::type
+ *
+ * \brief A unique identifier for the extension.
+ */
+
+// }}} Ext
+// {{{ Map
+
+/**
+ * \class Map
+ *
+ * \brief A Key/Value collection of Objects.
+ *
+ * The MessagePack specification allows any Object to be the "key" of a map.  
+ * As interesting as it would be to having a Map as the key to another Map, 
+ * programmatically, it is not practical. This implementation limits the types 
+ * of the "keys" to include all MessagePack types __except__ Array, Binary, 
+ * Ext, and Map.
+ *
+ * The key/value pairs are kept in the order that they were added, which is 
+ * also the order that they are serialized in. A deserialized Map keeps the 
+ * order of the packed data. Use key() and value() with an index from `0` to 
+ * size() to visit every key/value pair.
+ *
+ * The keys and values are stored in flat arrays. Small Maps are searched 
+ * directly, a Map with more than Index_Threshold keys also has a hash table 
+ * of the keys. A string key can be found with a `std::string_view`, so 
+ * looking up a key does not allocate memory.
+ *
+ * The arrays are kept in a single block that is allocated when the first key 
+ * is added, so a Map is only two pointers in size. This keeps every Object 
+ * small, since an Object is as large as its largest type.
+ *
+ * Objects can be tested to find out if they are Map by using Object::isMap() 
+ * and converted into a Map with Object::asMap(). A Map can not be converted 
+ * into an Object. However, an Object can be constructed using a Map.
+ */
+
+/**
+ * \brief Constructor.
+ *
+ * The keys, values, and hash table of the Map will be allocated from the \p 
+ * resource.
+ *
+ * \parcode
+ * std::pmr::monotonic_buffer_resource arena;
+ *
+ * zakero::messagepack::Map map(&arena);
+ * \endparcode
+ */
+Map::Map(std::pmr::memory_resource* resource ///< The memory resource
+	) noexcept
+	: resource_(resource)
+{
+}
+
+
+/**
+ * \brief Copy constructor.
+ *
+ * The copy uses the default memory resource.
+ */
+Map::Map(const Map& other ///< The Map to copy
+	) noexcept
+{
+	if(other.size() > 0)
+	{
+		Data_& data = writable_();
+
+		data.key_vector.assign(other.data_->key_vector.begin(), other.data_->key_vector.end());
+		data.value_vector.assign(other.data_->value_vector.begin(), other.data_->value_vector.end());
+		data.index_vector.assign(other.data_->index_vector.begin(), other.data_->index_vector.end());
+	}
+}
+
+
+/**
+ * \brief Move constructor.
+ *
+ * The contents and the memory resource of the \p other Map are moved, the \p 
+ * other Map will be empty.
+ */
+Map::Map(Map&& other ///< The Map to move
+	) noexcept
+	: resource_(other.resource_)
+	, data_(std::exchange(other.data_, nullptr))
+{
+}
+
+
+/**
+ * \brief Destructor.
+ */
+Map::~Map() noexcept
+{
+	if(data_ != nullptr)
+	{
+		std::pmr::polymorphic_allocator<Data_>(resource_).delete_object(data_);
+	}
+}
+
+
+/**
+ * \brief Copy assignment.
+ *
+ * The Map keeps its memory resource.
+ *
+ * \return This Map.
+ */
+Map& Map::operator=(const Map& other ///< The Map to copy
+	) noexcept
+{
+	if(this == &other)
+	{
+		return *this;
+	}
+
+	clear();
+
+	if(other.size() > 0)
+	{
+		Data_& data = writable_();
+
+		data.key_vector.assign(other.data_->key_vector.begin(), other.data_->key_vector.end());
+		data.value_vector.assign(other.data_->value_vector.begin(), other.data_->value_vector.end());
+		data.index_vector.assign(other.data_->index_vector.begin(), other.data_->index_vector.end());
+	}
+
+	return *this;
+}
+
+
+/**
+ * \brief Move assignment.
+ *
+ * The Map keeps its memory resource. If the \p other Map uses the same memory 
+ * resource its contents are moved, otherwise they are moved one at a time.  
+ * The \p other Map will be empty.
+ *
+ * \return This Map.
+ */
+Map& Map::operator=(Map&& other ///< The Map to move
+	) noexcept
+{
+	if(this == &other)
+	{
+		return *this;
+	}
+
+	if(resource_ == other.resource_
+		|| resource_->is_equal(*other.resource_)
+		)
+	{
+		std::swap(data_, other.data_);
+		other.clear();
+
+		return *this;
+	}
+
+	clear();
+
+	if(other.size() > 0)
+	{
+		Data_& data = writable_();
+
+		data.key_vector   = std::move(other.data_->key_vector);
+		data.value_vector = std::move(other.data_->value_vector);
+		data.index_vector = std::move(other.data_->index_vector);
+
+		other.clear();
+	}
+
+	return *this;
+}
+
+
+/**
+ * \brief Set a key/value pair.
+ *
+ * The provided \p key / \p value pair will be added to the Map. If the \p key 
+ * already exists, its value will be replaced with \p value.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ *
+ * map.set({"Error Code"}   , {uint64_t(42)});
+ * map.set({"Error Message"}, {"All the errors!"});
+ * \endparcode
+ *
+ * \retval Error_None                 The key/value pair was set.
+ * \retval Error_Invalid_Format_Type  The \p key can not be used in a Map.
+ */
+std::error_code Map::set(const Object& key   ///< The key
+	, const Object&                value ///< The value
+	) noexcept
+{
+	if(key.value.index() >= Key_Type_Count_)
+	{
+		return Error_Invalid_Format_Type;
+	}
+
+	const size_t index = find_(key);
+	Data_&       data  = writable_();
+
+	if(index == Npos)
+	{
+		data.key_vector.push_back(key);
+		data.value_vector.push_back(value);
+		indexInsert_(data.key_vector.size() - 1);
+	}
+	else
+	{
+		data.value_vector[index] = value;
+	}
+
+	return Error_None;
+}
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("map/set (copy)")
+{
+	const Object key_null  = {};
+	const Object key_zero  = {int64_t(0)};
+	const Object val_null  = {};
+	const Object val_zero  = {int64_t(0)};
+
+	Map map;
+
+	SUBCASE("Same Key, Same Value")
+	{
+		map.set(key_null, val_null);
+		CHECK(map.size() == 1);
+		const Object& obj_1 = map.at(key_null);
+		CHECK(obj_1  == val_null);
+		CHECK(&obj_1 != &val_null);
+
+		map.set(key_null, val_null);
+		CHECK(map.size() == 1);
+		const Object& obj_2 = map.at(key_null);
+		CHECK(obj_2  == val_null);
+		CHECK(&obj_2 != &val_null);
+	}
+
+	SUBCASE("Same Key, Differnt Value")
+	{
+		map.set(key_null, val_null);
+		CHECK(map.size() == 1);
+		const Object& obj_1 = map.at(key_null);
+		CHECK(obj_1 == val_null);
+
+		map.set(key_null, val_zero);
+		CHECK(map.size() == 1);
+		const Object& obj_2 = map.at(key_null);
+		CHECK(obj_2 == val_zero);
+	}
+
+	SUBCASE("Different Key, Same Value")
+	{
+		map.set(key_null, val_null);
+		map.set(key_zero, val_null);
+		CHECK(map.size() == 2);
+
+		const Object& obj_1 = map.at(key_null);
+		CHECK(obj_1 == val_null);
+
+		const Object& obj_2 = map.at(key_zero);
+		CHECK(obj_2 == val_null);
+	}
+
+	SUBCASE("Different Key, Different Value")
+	{
+		map.set(key_null, val_null);
+		map.set(key_zero, val_zero);
+		CHECK(map.size() == 2);
+
+		const Object& obj_1 = map.at(key_null);
+		CHECK(obj_1 == val_null);
+
+		const Object& obj_2 = map.at(key_zero);
+		CHECK(obj_2 == val_zero);
+	}
+}
+#endif // }}}
+
+
+/**
+ * \brief Set a key/value pair.
+ *
+ * The provided \p key / \p value pair will be added to the Map. If the \p key 
+ * already exists, its value will be replaced with \p value.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ *
+ * map.set({"Error Code"}   , {uint64_t(42)});
+ * map.set({"Error Message"}, {"All the errors!"});
+ * \endparcode
+ *
+ * \return An error code.
+ */
+std::error_code Map::set(Object& key   ///< The key
+	, Object&                value ///< The value
+	) noexcept
+{
+	return set(std::as_const(key), std::as_const(value));
+}
+
+
+/**
+ * \brief Move a key/value pair.
+ *
+ * The provided \p key / \p value pair will be moved into the Map. If the \p 
+ * key already exists, its value will be replaced with \p value. Moving keeps 
+ * the contents of the \p key and \p value in the memory resource that they 
+ * were created with.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ *
+ * zakero::messagepack::Object key   = {"Image"};
+ * zakero::messagepack::Object value = {loadImage()};
+ *
+ * map.set(std::move(key), std::move(value));
+ * \endparcode
+ *
+ * \retval Error_None                 The key/value pair was set.
+ * \retval Error_Invalid_Format_Type  The \p key can not be used in a Map.
+ */
+std::error_code Map::set(Object&& key   ///< The key
+	, Object&&                value ///< The value
+	) noexcept
+{
+	if(key.value.index() >= Key_Type_Count_)
+	{
+		return Error_Invalid_Format_Type;
+	}
+
+	const size_t index = find_(key);
+	Data_&       data  = writable_();
+
+	if(index == Npos)
+	{
+		data.key_vector.push_back(std::move(key));
+		data.value_vector.push_back(std::move(value));
+		indexInsert_(data.key_vector.size() - 1);
+	}
+	else
+	{
+		data.value_vector[index] = std::move(value);
+	}
+
+	return Error_None;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("map/set")
+{
+	Object key_true = Object{true};
+	Object key_zero = Object{int64_t(0)};
+	Object val_true = Object{true};
+	Object val_zero = Object{int64_t(0)};
+
+	Map map;
+
+	SUBCASE("Same Key, Same Value")
+	{
+		map.set(key_true, val_true);
+		CHECK(map.size() == 1);
+
+		Object& obj_1 = map.at(key_true);
+		CHECK(obj_1 == val_true);
+		obj_1 = {val_zero};
+		CHECK(map.at(key_true) == val_zero);
+
+		map.set(key_true, val_zero);
+		CHECK(map.size() == 1);
+
+		Object& obj_2 = map.at(key_true);
+		CHECK(obj_2 == val_zero);
+	}
+
+	SUBCASE("Same Key, Differnt Value")
+	{
+		map.set(key_true, val_true);
+		CHECK(map.size() == 1);
+
+		CHECK(map.at(key_true) == val_true);
+
+		map.set(key_true, val_zero);
+		CHECK(map.size() == 1);
+		CHECK(map.at(key_true) == val_zero);
+	}
+
+	SUBCASE("Different Key, Same Value")
+	{
+		map.set(key_true, val_true);
+		map.set(key_zero, val_true);
+		CHECK(map.size() == 2);
+		CHECK(map.at(key_true) == val_true);
+		CHECK(map.at(key_zero) == val_true);
+	}
+
+	SUBCASE("Different Key, Different Value")
+	{
+		map.set(key_true, val_true);
+		map.set(key_zero, val_zero);
+		CHECK(map.size() == 2);
+		CHECK(map.at(key_true) == val_true);
+		CHECK(map.at(key_zero) == val_zero);
+	}
+}
+#endif // }}}
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("map/emplace")
+{
+	Map map;
+
+	Array& list = map.emplace<Array>("list");
+	list.append(int64_t(1));
+	list.append(int64_t(2));
+
+	map.emplace<std::pmr::string>(uint64_t(7), 100, 's');
+	map.emplace<Map>(true).emplace<double>("pi", 3.14);
+
+	CHECK(map.size() == 3);
+	CHECK(map["list"].asArray().size() == 2);
+	CHECK(map["list"].asArray()[1].as<int64_t>() == 2);
+	CHECK(map[uint64_t(7)].asString() == std::string(100, 's').c_str());
+	CHECK(map[true].asMap()["pi"].as<double>() == 3.14);
+
+	SUBCASE("Replace")
+	{
+		map.emplace<int64_t>("list", -1);
+
+		CHECK(map.size() == 3);
+		CHECK(map["list"].as<int64_t>() == -1);
+	}
+
+	SUBCASE("Same as set()")
+	{
+		Map expect;
+		expect.set(Object{"list"}, Object{Array{}});
+		expect["list"].asArray().append(int64_t(1));
+		expect["list"].asArray().append(int64_t(2));
+		expect.set(Object{uint64_t(7)}, Object{std::pmr::string(100, 's')});
+		expect.set(Object{true}, Object{Map{}});
+		expect[true].asMap().set(Object{"pi"}, Object{3.14});
+
+		CHECK(serialize(Object{map}) == serialize(Object{expect}));
+	}
+}
+
+
+TEST_CASE("map/set/rvalue")
+{
+	Array list;
+	list.append(std::pmr::vector<uint8_t>(1'000, 'b'));
+
+	const Object* list_data = list.object_vector.data();
+
+	Map map;
+	CHECK(map.set(Object{"list"}, Object{std::move(list)}) == Error_None);
+	CHECK(map["list"].asArray().object_vector.data() == list_data);
+
+	Object value;
+	value = Map{};
+	value.asMap().set(Object{"key"}, Object{"value"});
+
+	const Object* key_data = &value.asMap().key(0);
+
+	CHECK(map.set(Object{"map"}, std::move(value)) == Error_None);
+	CHECK(&map["map"].asMap().key(0) == key_data);
+
+	std::pmr::string str(100, 's');
+	const char* str_data = str.data();
+
+	map["str"] = std::move(str);
+	CHECK(map["str"].asString().data() == str_data);
+}
+#endif // }}}
+
+
+/**
+ * \brief Erase a key/value pair.
+ *
+ * If the specified \p key exists, the \p key and matching value will be 
+ * removed frame the Map.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ *
+ * // What is true?
+ * map.set({true}, {uint64_t(123456)});
+ *
+ * // Truth can not be defined...
+ * map.erase({true});
+ * \endparcode
+ */
+void Map::erase(const Object& key ///< The key
+	) noexcept
+{
+	const size_t index = find_(key);
+
+	if(index == Npos)
+	{
+		return;
+	}
+
+	Data_& data = *data_;
+
+	data.key_vector.erase(data.key_vector.begin() + index);
+	data.value_vector.erase(data.value_vector.begin() + index);
+
+	indexBuild_();
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("map/erase")
+{
+	Object key_nope = Object{};
+	Object key_true = Object{true};
+	Object key_zero = Object{int64_t(0)};
+	Object val_null = Object{};
+
+	Map map;
+
+	map.erase(key_nope); // Nothing should happen
+
+	map.set(key_true, val_null);
+	map.set(key_zero, val_null);
+	CHECK(map.keyExists(key_true) == true);
+	CHECK(map.keyExists(key_zero) == true);
+
+	map.erase(key_nope); // Nothing should happen
+	CHECK(map.size() == 2);
+
+	map.erase(key_true);
+	CHECK(map.size() == 1);
+	CHECK(map.keyExists(key_true) == false);
+	CHECK(map.keyExists(key_zero) == true);
+
+	map.erase(key_true);
+	CHECK(map.size() == 1);
+	CHECK(map.keyExists(key_true) == false);
+	CHECK(map.keyExists(key_zero) == true);
+
+	map.erase(key_zero);
+	CHECK(map.size() == 0);
+	CHECK(map.keyExists(key_true) == false);
+	CHECK(map.keyExists(key_zero) == false);
+
+	map.erase(key_zero);
+	CHECK(map.size() == 0);
+	CHECK(map.keyExists(key_true) == false);
+	CHECK(map.keyExists(key_zero) == false);
+}
+#endif // }}}
+
+
+/**
+ * \brief Check if a key exists.
+ *
+ * Search the Map and return \true if the \p key exists. If the \p key was not 
+ * found, return \false.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ *
+ * map.set(Object{}, Object{});
+ * if(map.keyExists(Object{}))
+ * {
+ * 	// In the Key of Null
+ * }
+ * \endparcode
+ *
+ * \retval true  The key exists.
+ * \retval false The key does not exist.
+ */
+bool Map::keyExists(const Object& key ///< The key Object
+	) const noexcept
+{
+	return (find_(key) != Npos);
+}
+
+
+/**
+ * \brief Check if a string key exists.
+ *
+ * Search the Map and return \true if a string key that matches the \p key 
+ * exists. If the \p key was not found, return \false. A temporary Object is 
+ * not needed to do the search.
+ *
+ * \parcode
+ * if(map.keyExists("status"))
+ * {
+ * 	// ...
+ * }
+ * \endparcode
+ *
+ * \retval true  The key exists.
+ * \retval false The key does not exist.
+ */
+bool Map::keyExists(const std::string_view key ///< The key
+	) const noexcept
+{
+	return (find_(key) != Npos);
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("map/keyexists")
+{
+	const Object key_true = Object{true};
+	const Object key_zero = Object{int64_t(0)};
+	const Object val_null = Object{};
+
+	Map map;
+
+	CHECK(map.size() == 0);
+	CHECK(map.keyExists(key_true) == false);
+	CHECK(map.keyExists(key_zero) == false);
+
+	map.set(key_true, val_null);
+	CHECK(map.keyExists(key_true) == true);
+	CHECK(map.keyExists(key_zero) == false);
+
+	map.set(key_zero, val_null);
+	CHECK(map.keyExists(key_true) == true);
+	CHECK(map.keyExists(key_zero) == true);
+}
+#endif // }}}
+
+
+/**
+ * \brief Get the value of a key.
+ *
+ * The value associated with the provided \p key will be returned. If the \p 
+ * key does not exist, then a reference to the \p key will be returned.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ *
+ * map.set(Object{uint64_t(42)}, Object{std::pmr::string("The Answer"});
+ *
+ * const zakero::messagepack::Object key = Object{true};
+ * const zakero::messagepack::Object& object = map.at({true});
+ *
+ * if(&object == &key)
+ * {
+ * 	// key not found
+ * }
+ * \endparcode
+ *
+ * \return The value.
+ */
+const Object& Map::at(const Object& key ///< The key
+	) const noexcept
+{
+	const size_t index = find_(key);
+
+	if(index == Npos)
+	{
+		return key;
+	}
+
+	return data_->value_vector[index];
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("map/set/at (const)")
+{
+	Map map;
+
+	SUBCASE("Exists")
+	{
+		const Object key_null   = {};
+		const Object key_bool   = {true};
+		const Object key_int64  = {int64_t(0)};
+		const Object key_uint64 = {uint64_t(0)};
+		const Object key_float  = {float(0)};
+		const Object key_double = {double(0)};
+		const Object key_string = {std::pmr::string("_")};
+
+		const Object value_0 = {uint64_t(0)};
+		const Object value_1 = {uint64_t(1)};
+		const Object value_2 = {uint64_t(2)};
+		const Object value_3 = {uint64_t(3)};
+		const Object value_4 = {uint64_t(4)};
+		const Object value_5 = {uint64_t(5)};
+		const Object value_6 = {uint64_t(6)};
+
+		map.set(key_null,   value_0);
+		map.set(key_bool,   value_1);
+		map.set(key_int64,  value_2);
+		map.set(key_uint64, value_3);
+		map.set(key_float,  value_4);
+		map.set(key_double, value_5);
+		map.set(key_string, value_6);
+
+		CHECK(map.at(key_null)   == value_0);
+		CHECK(map.at(key_bool)   == value_1);
+		CHECK(map.at(key_int64)  == value_2);
+		CHECK(map.at(key_uint64) == value_3);
+		CHECK(map.at(key_float)  == value_4);
+		CHECK(map.at(key_double) == value_5);
+		CHECK(map.at(key_string) == value_6);
+	}
+
+	SUBCASE("Not Exists")
+	{
+		const Object  bad_key = {};
+		const Object& bad_val = map.at(bad_key);
+		CHECK(&bad_key == &bad_val);
+	}
+}
+
+TEST_CASE("map/set/operator[](Object&) (const)")
+{
+	Map map;
+
+	SUBCASE("Exists")
+	{
+		const Object key_null   = {};
+		const Object key_bool   = {true};
+		const Object key_int64  = {int64_t(0)};
+		const Object key_uint64 = {uint64_t(0)};
+		const Object key_float  = {float(0)};
+		const Object key_double = {double(0)};
+		const Object key_string = {std::pmr::string("_")};
+
+		const Object value_0 = {uint64_t(0)};
+		const Object value_1 = {uint64_t(1)};
+		const Object value_2 = {uint64_t(2)};
+		const Object value_3 = {uint64_t(3)};
+		const Object value_4 = {uint64_t(4)};
+		const Object value_5 = {uint64_t(5)};
+		const Object value_6 = {uint64_t(6)};
+
+		map.set(key_null,   value_0);
+		map.set(key_bool,   value_1);
+		map.set(key_int64,  value_2);
+		map.set(key_uint64, value_3);
+		map.set(key_float,  value_4);
+		map.set(key_double, value_5);
+		map.set(key_string, value_6);
+
+		CHECK(map[key_null]   == value_0);
+		CHECK(map[key_bool]   == value_1);
+		CHECK(map[key_int64]  == value_2);
+		CHECK(map[key_uint64] == value_3);
+		CHECK(map[key_float]  == value_4);
+		CHECK(map[key_double] == value_5);
+		CHECK(map[key_string] == value_6);
+	}
+
+	SUBCASE("Not Exists")
+	{
+		const Object  bad_key = {};
+		const Object& bad_val = map[bad_key];
+		CHECK(&bad_key == &bad_val);
+	}
+}
+
+TEST_CASE("map/set/operator[](native type) (const)")
+{
+	Map map;
+
+	SUBCASE("Exists")
+	{
+		const bool             key_bool   = {true};
+		const int64_t          key_int64  = {int64_t(0)};
+		const uint64_t         key_uint64 = {uint64_t(0)};
+		const float            key_float  = {float(0)};
+		const double           key_double = {double(0)};
+		const std::pmr::string key_string = {std::pmr::string("_")};
+
+		const Object value_1 = {uint64_t(1)};
+		const Object value_2 = {uint64_t(2)};
+		const Object value_3 = {uint64_t(3)};
+		const Object value_4 = {uint64_t(4)};
+		const Object value_5 = {uint64_t(5)};
+		const Object value_6 = {uint64_t(6)};
+
+		map.set({key_bool  } , value_1);
+		map.set({key_int64 } , value_2);
+		map.set({key_uint64} , value_3);
+		map.set({key_float } , value_4);
+		map.set({key_double} , value_5);
+		map.set({key_string} , value_6);
+
+		CHECK(map[key_bool]   == value_1);
+		CHECK(map[key_int64]  == value_2);
+		CHECK(map[key_uint64] == value_3);
+		CHECK(map[key_float]  == value_4);
+		CHECK(map[key_double] == value_5);
+		CHECK(map[key_string] == value_6);
+	}
+}
+#endif // }}}
+
+
+/**
+ * \brief Get the value of a key.
+ *
+ * The value associated with the provided \p key will be returned. If the \p 
+ * key does not exist, then a reference to the \p key will be returned.  
+ * Checking if the key exists (keyExists()) is more reliable than using this 
+ * error handling.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ *
+ * map.set(Object{uint64_t(42)}, Object{std::pmr::string("The Answer"});
+ * zakero::messagepack::Object& thing = map.at({uint64_t(42)});
+ *
+ * zakero::messagepack::Object key = Object{true};
+ * zakero::messagepack::Object& object = map.at(key);
+ *
+ * if(&object == &key)
+ * {
+ * 	// key not found
+ * }
+ * \endparcode
+ *
+ * \return The value.
+ */
+Object& Map::at(Object& key ///< The key
+	) noexcept
+{
+	const size_t index = find_(key);
+
+	if(index == Npos)
+	{
+		return key;
+	}
+
+	return data_->value_vector[index];
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("map/set/at")
+{
+	Map map;
+
+	SUBCASE("Exists")
+	{
+		Object key_null   = {};
+		Object key_bool   = {true};
+		Object key_int64  = {int64_t(0)};
+		Object key_uint64 = {uint64_t(0)};
+		Object key_float  = {float(0)};
+		Object key_double = {double(0)};
+		Object key_string = {std::pmr::string("_")};
+
+		Object value_0 = {uint64_t(0)};
+		Object value_1 = {uint64_t(1)};
+		Object value_2 = {uint64_t(2)};
+		Object value_3 = {uint64_t(3)};
+		Object value_4 = {uint64_t(4)};
+		Object value_5 = {uint64_t(5)};
+		Object value_6 = {uint64_t(6)};
+
+		map.set(key_null,   value_0);
+		map.set(key_bool,   value_1);
+		map.set(key_int64,  value_2);
+		map.set(key_uint64, value_3);
+		map.set(key_float,  value_4);
+		map.set(key_double, value_5);
+		map.set(key_string, value_6);
+
+		CHECK(map.at(key_null)   == value_0);
+		CHECK(map.at(key_bool)   == value_1);
+		CHECK(map.at(key_int64)  == value_2);
+		CHECK(map.at(key_uint64) == value_3);
+		CHECK(map.at(key_float)  == value_4);
+		CHECK(map.at(key_double) == value_5);
+		CHECK(map.at(key_string) == value_6);
+
+		map.at(key_null) = {false};
+		CHECK(map.at(key_null) == Object{false});
+	}
+
+	SUBCASE("Not Exists")
+	{
+		Object  bad_key = {};
+		Object& bad_val = map.at(bad_key);
+		CHECK(&bad_key == &bad_val);
+	}
+}
+
+TEST_CASE("map/set/operator[](Object&)")
+{
+	Map map;
+
+	SUBCASE("Exists")
+	{
+		Object key_null   = {};
+		Object key_bool   = {true};
+		Object key_int64  = {int64_t(0)};
+		Object key_uint64 = {uint64_t(0)};
+		Object key_float  = {float(0)};
+		Object key_double = {double(0)};
+		Object key_string = {std::pmr::string("_")};
+
+		Object value_0 = {uint64_t(0)};
+		Object value_1 = {uint64_t(1)};
+		Object value_2 = {uint64_t(2)};
+		Object value_3 = {uint64_t(3)};
+		Object value_4 = {uint64_t(4)};
+		Object value_5 = {uint64_t(5)};
+		Object value_6 = {uint64_t(6)};
+
+		map.set(key_null,   value_0);
+		map.set(key_bool,   value_1);
+		map.set(key_int64,  value_2);
+		map.set(key_uint64, value_3);
+		map.set(key_float,  value_4);
+		map.set(key_double, value_5);
+		map.set(key_string, value_6);
+
+		CHECK(map[key_null]   == value_0);
+		CHECK(map[key_bool]   == value_1);
+		CHECK(map[key_int64]  == value_2);
+		CHECK(map[key_uint64] == value_3);
+		CHECK(map[key_float]  == value_4);
+		CHECK(map[key_double] == value_5);
+		CHECK(map[key_string] == value_6);
+	}
+
+	SUBCASE("Not Exists")
+	{
+		Object  bad_key = {};
+		Object& bad_val = map[bad_key];
+		CHECK(&bad_key == &bad_val);
+	}
+}
+
+TEST_CASE("map/set/operator[](raw native types)")
+{
+	Map map;
+
+	SUBCASE("Exists")
+	{
+		std::pmr::string string = "Hello, World!";
+		Object value = {string};
+
+		map.set({(bool)     true } , value);
+		map.set({(int64_t)  0    } , value);
+		map.set({(uint64_t) 1    } , value);
+		map.set({(float)    2.2  } , value);
+		map.set({(double)   3.3  } , value);
+		map.set({           "foo"} , value);
+
+		CHECK(map[(bool)     true ].isString() == true);
+		CHECK(map[(bool)     true ].isString() == value.isString());
+		CHECK(map[(bool)     true ] == value);
+		CHECK(map[(bool)     true ].asString() == string);
+
+		CHECK(map[(int64_t)  0    ].isString() == true);
+		CHECK(map[(int64_t)  0    ].isString() == value.isString());
+		CHECK(map[(int64_t)  0    ] == value);
+		CHECK(map[(int64_t)  0    ].asString() == string);
+
+		CHECK(map[(uint64_t) 1    ].isString() == true);
+		CHECK(map[(uint64_t) 1    ].isString() == value.isString());
+		CHECK(map[(uint64_t) 1    ] == value);
+		CHECK(map[(uint64_t) 1    ].asString() == string);
+
+		CHECK(map[(float)    2.2  ].isString() == true);
+		CHECK(map[(float)    2.2  ].isString() == value.isString());
+		CHECK(map[(float)    2.2  ] == value);
+		CHECK(map[(float)    2.2  ].asString() == string);
+
+		CHECK(map[(double)   3.3  ].isString() == true);
+		CHECK(map[(double)   3.3  ].isString() == value.isString());
+		CHECK(map[(double)   3.3  ] == value);
+		CHECK(map[(double)   3.3  ].asString() == string);
+
+		CHECK(map[           "foo"].isString() == true);
+		CHECK(map[           "foo"].isString() == value.isString());
+		CHECK(map[           "foo"] == value);
+		CHECK(map[           "foo"].asString() == string);
+
+		Object obj = map["foo"];
+		CHECK(obj == value);
+		CHECK(obj.isString() == true);
+
+		std::pmr::string str = map["foo"].asString();
+		CHECK(str == string);
+
+		map.set({ "aaa" } , { "aaa" });
+
+		bool b = map["aaa"].isString();
+		CHECK(b == true);
+
+		std::pmr::string s = map["aaa"].asString();
+		CHECK(s == "aaa");
+	}
+}
+#endif // }}}
+
+
+/**
+ * \name Access by key
+ *
+ * Get the value of a key. If the key does not exist, the non-const versions 
+ * will add the key with a Null value. The const versions will return a Null 
+ * Object instead.
+ *
+ * String keys are found without creating an Object, memory is only allocated 
+ * when the key is added.
+ *
+ * \parcode
+ * zakero::messagepack::Map& request = object.asMap();
+ *
+ * const std::string_view method = request["method"].asString();
+ * \endparcode
+ *
+ * \return The value.
+ * \{
+ */
+Object& Map::operator[](const bool key ///< The key
+	) noexcept
+{
+	return findOrInsert_(Object{key});
+}
+
+const Object& Map::operator[](const bool key ///< The key
+	) const noexcept
+{
+	return findOrNull_(Object{key});
+}
+
+Object& Map::operator[](const int64_t key ///< The key
+	) noexcept
+{
+	return findOrInsert_(Object{key});
+}
+
+const Object& Map::operator[](const int64_t key ///< The key
+	) const noexcept
+{
+	return findOrNull_(Object{key});
+}
+
+Object& Map::operator[](const uint64_t key ///< The key
+	) noexcept
+{
+	return findOrInsert_(Object{key});
+}
+
+const Object& Map::operator[](const uint64_t key ///< The key
+	) const noexcept
+{
+	return findOrNull_(Object{key});
+}
+
+Object& Map::operator[](const float key ///< The key
+	) noexcept
+{
+	return findOrInsert_(Object{key});
+}
+
+const Object& Map::operator[](const float key ///< The key
+	) const noexcept
+{
+	return findOrNull_(Object{key});
+}
+
+Object& Map::operator[](const double key ///< The key
+	) noexcept
+{
+	return findOrInsert_(Object{key});
+}
+
+const Object& Map::operator[](const double key ///< The key
+	) const noexcept
+{
+	return findOrNull_(Object{key});
+}
+
+Object& Map::operator[](const std::string_view key ///< The key
+	) noexcept
+{
+	const size_t index = find_(key);
+
+	if(index != Npos)
+	{
+		return data_->value_vector[index];
+	}
+
+	return findOrInsert_(Object{std::pmr::string(key, resource_)});
+}
+
+const Object& Map::operator[](const std::string_view key ///< The key
+	) const noexcept
+{
+	static const Object null = {};
+
+	const size_t index = find_(key);
+
+	if(index == Npos)
+	{
+		return null;
+	}
+
+	return data_->value_vector[index];
+}
+/**
+ * \}
+ */
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("map/operator[](string_view)")
+{
+	Map map;
+
+	map["alpha"] = Object{int64_t(1)};
+	map[std::string_view("beta")] = Object{int64_t(2)};
+	map[std::string("gamma")] = Object{int64_t(3)};
+
+	CHECK(map.size() == 3);
+	CHECK(map.keyExists("alpha"));
+	CHECK(map.keyExists(Object{"beta"}));
+	CHECK(map.keyExists("delta") == false);
+	CHECK(map["alpha"] == Object{int64_t(1)});
+
+	const Map& const_map = map;
+	CHECK(const_map["gamma"] == Object{int64_t(3)});
+	CHECK(const_map["delta"].isNull());
+	CHECK(const_map[int64_t(4)].isNull());
+	CHECK(map.size() == 3);
+
+	map["alpha"] = Object{int64_t(10)};
+	CHECK(map.size() == 3);
+	CHECK(const_map["alpha"] == Object{int64_t(10)});
+
+	map[int64_t(4)] = Object{"four"};
+	CHECK(map.size() == 4);
+	CHECK(map.keyExists("four") == false);
+	CHECK(map.key(3) == Object{int64_t(4)});
+}
+#endif // }}}
+
+
+/**
+ * \brief Remove the contents of the Map.
+ *
+ * All of the key/value pairs will be removed.
+ */
+void Map::clear() noexcept
+{
+	if(data_ == nullptr)
+	{
+		return;
+	}
+
+	data_->key_vector.clear();
+	data_->value_vector.clear();
+	data_->index_vector.clear();
+}
+
+
+/**
+ * \brief Reserve space.
+ *
+ * Allocate enough space for \p count key/value pairs.
+ */
+void Map::reserve(const size_t count ///< The number of key/value pairs
+	) noexcept
+{
+	if(count == 0)
+	{
+		return;
+	}
+
+	Data_& data = writable_();
+
+	data.key_vector.reserve(count);
+	data.value_vector.reserve(count);
+}
+
+
+/**
+ * \fn zakero::messagepack::Map::size()
+ *
+ * \brief Get the size of the Map.
+ *
+ * \return The number of key/value pairs.
+ */
+
+
+/**
+ * \fn zakero::messagepack::Map::key(const size_t)
+ *
+ * \brief Get a key.
+ *
+ * Keys are in the order that they were added to the Map.
+ *
+ * \parcode
+ * for(size_t i = 0; i < map.size(); i++)
+ * {
+ * 	printf("%s\n", to_string(map.key(i)).c_str());
+ * }
+ * \endparcode
+ *
+ * \return The key at the \p index.
+ */
+
+
+/**
+ * \fn zakero::messagepack::Map::value(const size_t)
+ *
+ * \brief Get a value.
+ *
+ * The value that belongs to the key(), at the same \p index.
+ *
+ * \return The value at the \p index.
+ */
+
+
+/**
+ * \brief Find a key.
+ *
+ * Small Maps are searched in order, larger Maps use the hash table.
+ *
+ * \return The index of the \p key or Npos.
+ */
+template<typename Key>
+size_t Map::find_(const Key& key ///< The key
+	) const noexcept
+{
+	const Data_& data = readable_();
+
+	if(data.index_vector.empty())
+	{
+		for(size_t i = 0; i < data.key_vector.size(); i++)
+		{
+			if(keyEqual_(data.key_vector[i], key))
+			{
+				return i;
+			}
+		}
+
+		return Npos;
+	}
+
+	const size_t mask = data.index_vector.size() - 1;
+
+	for(size_t slot = keyHash_(key) & mask; data.index_vector[slot] != 0; slot = (slot + 1) & mask)
+	{
+		const size_t index = data.index_vector[slot] - 1;
+
+		if(keyEqual_(data.key_vector[index], key))
+		{
+			return index;
+		}
+	}
+
+	return Npos;
+}
+
+
+/**
+ * \brief Find a key, or add it.
+ *
+ * If the \p key does not exist, the \p key is added with a Null value.
+ *
+ * \return The value.
+ */
+Object& Map::findOrInsert_(Object&& key ///< The key
+	) noexcept
+{
+	const size_t index = find_(key);
+	Data_&       data  = writable_();
+
+	if(index != Npos)
+	{
+		return data.value_vector[index];
+	}
+
+	data.key_vector.push_back(std::move(key));
+	data.value_vector.emplace_back();
+	indexInsert_(data.key_vector.size() - 1);
+
+	return data.value_vector.back();
+}
+
+
+/**
+ * \brief Add a key that is not in the Map.
+ *
+ * The \p key is added with a Null value, without checking if it already 
+ * exists. The \p hash must be the hash of the \p key.
+ *
+ * \return The value.
+ */
+Object& Map::insert_(Object&& key  ///< The key
+	, const uint64_t      hash ///< The hash of the key
+	) noexcept
+{
+	Data_& data = writable_();
+
+	data.key_vector.push_back(std::move(key));
+	data.value_vector.emplace_back();
+	indexInsert_(data.key_vector.size() - 1, hash);
+
+	return data.value_vector.back();
+}
+
+
+/**
+ * \brief Find a key, or Null.
+ *
+ * \return The value of the \p key or a Null Object.
+ */
+const Object& Map::findOrNull_(const Object& key ///< The key
+	) const noexcept
+{
+	static const Object null = {};
+
+	const size_t index = find_(key);
+
+	if(index == Npos)
+	{
+		return null;
+	}
+
+	return data_->value_vector[index];
+}
+
+
+/**
+ * \brief The contents of every empty Map.
+ *
+ * \return An empty Data_.
+ */
+const Map::Data_& Map::empty_() noexcept
+{
+	static const Data_ empty(std::pmr::null_memory_resource());
+
+	return empty;
+}
+
+
+/**
+ * \brief The contents of the Map.
+ *
+ * The contents are allocated from the memory resource the first time that 
+ * they are needed.
+ *
+ * \return The Data_.
+ */
+Map::Data_& Map::writable_() noexcept
+{
+	if(data_ == nullptr)
+	{
+		data_ = std::pmr::polymorphic_allocator<Data_>(resource_).new_object<Data_>(resource_);
+	}
+
+	return *data_;
+}
+
+
+/**
+ * \brief Rebuild the hash table.
+ *
+ * The hash table is only used when there are more than Index_Threshold keys.  
+ * The table size is a power of 2 and is kept at most half full.
+ */
+void Map::indexBuild_() noexcept
+{
+	if(data_ == nullptr)
+	{
+		return;
+	}
+
+	Data_& data = *data_;
+
+	data.index_vector.clear();
+
+	if(data.key_vector.size() <= Index_Threshold)
+	{
+		return;
+	}
+
+	data.index_vector.resize(std::bit_ceil(data.key_vector.size() * 2), 0);
+
+	const size_t mask = data.index_vector.size() - 1;
+
+	for(size_t index = 0; index < data.key_vector.size(); index++)
+	{
+		size_t slot = keyHash_(data.key_vector[index]) & mask;
+
+		while(data.index_vector[slot] != 0)
+		{
+			slot = (slot + 1) & mask;
+		}
+
+		data.index_vector[slot] = (uint32_t)(index + 1);
+	}
+}
+
+
+/**
+ * \brief Add a key to the hash table.
+ *
+ * The key at \p index has been added to the end of the Map.
+ */
+void Map::indexInsert_(const size_t index ///< The index of the key
+	) noexcept
+{
+	if(size() <= Index_Threshold)
+	{
+		return;
+	}
+
+	indexInsert_(index, keyHash_(data_->key_vector[index]));
+}
+
+
+/**
+ * \brief Add a key to the hash table.
+ *
+ * The key at \p index has been added to the end of the Map and its \p hash 
+ * is already known.
+ */
+void Map::indexInsert_(const size_t index ///< The index of the key
+	, const uint64_t            hash  ///< The hash of the key
+	) noexcept
+{
+	if(size() <= Index_Threshold)
+	{
+		return;
+	}
+
+	Data_& data = *data_;
+
+	if(data.key_vector.size() * 2 > data.index_vector.size())
+	{
+		indexBuild_();
+
+		return;
+	}
+
+	const size_t mask = data.index_vector.size() - 1;
+
+	size_t slot = hash & mask;
+
+	while(data.index_vector[slot] != 0)
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	data.index_vector[slot] = (uint32_t)(index + 1);
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("map/order")
+{
+	Map map;
+
+	const std::vector<Object> key_list =
+	{	Object{"zeta"}
+	,	Object{int64_t(-3)}
+	,	Object{}
+	,	Object{"alpha"}
+	,	Object{uint64_t(7)}
+	,	Object{true}
+	,	Object{double(0.5)}
+	,	Object{float(0.25)}
+	};
+
+	for(size_t i = 0; i < key_list.size(); i++)
+	{
+		map.set(key_list[i], Object{uint64_t(i)});
+	}
+
+	CHECK(map.size() == key_list.size());
+
+	for(size_t i = 0; i < key_list.size(); i++)
+	{
+		CHECK(map.key(i) == key_list[i]);
+		CHECK(map.value(i) == Object{uint64_t(i)});
+	}
+
+	// Replacing a value keeps its place
+
+	map.set(Object{"alpha"}, Object{"replaced"});
+	CHECK(map.key(3) == Object{"alpha"});
+	CHECK(map.value(3) == Object{"replaced"});
+
+	// Erasing keeps the order of the rest
+
+	map.erase(Object{int64_t(-3)});
+	CHECK(map.size() == key_list.size() - 1);
+	CHECK(map.key(0) == key_list[0]);
+	CHECK(map.key(1) == key_list[2]);
+	CHECK(map.key(2) == key_list[3]);
+
+	// The packed data has the same order
+
+	const std::vector<uint8_t> data = serialize(map);
+
+	MapView view = ObjectView(data).asMap();
+	size_t  index = 0;
+
+	for(const auto& [key, value] : view)
+	{
+		CHECK(index < map.size());
+		CHECK(value.data().size() > 0);
+
+		if(map.key(index).isString())
+		{
+			CHECK(key.asString() == map.key(index).asString().c_str());
+		}
+
+		index++;
+	}
+
+	CHECK(index == map.size());
+
+	Object object = deserialize(data);
+	const Map& test = object.asMap();
+
+	CHECK(test.size() == map.size());
+
+	for(size_t i = 0; i < map.size(); i++)
+	{
+		CHECK(test.key(i) == map.key(i));
+		CHECK(test.value(i) == map.value(i));
+	}
+
+	// Keys that can not be used
+
+	CHECK(map.set(Object{Array{}}, Object{}) == Error_Invalid_Format_Type);
+	CHECK(map.set(Object{Map{}}, Object{}) == Error_Invalid_Format_Type);
+	CHECK(map.size() == key_list.size() - 1);
+}
+
+
+TEST_CASE("map/index")
+{
+	Map map;
+
+	const size_t count = 1'000;
+
+	for(size_t i = 0; i < count; i++)
+	{
+		map.set(Object{std::pmr::string(std::to_string(i))}, Object{int64_t(i)});
+		map.set(Object{int64_t(i)}, Object{std::pmr::string(std::to_string(i))});
+		map.set(Object{double(i) + 0.5}, Object{uint64_t(i)});
+	}
+
+	CHECK(map.size() == count * 3);
+
+	for(size_t i = 0; i < count; i++)
+	{
+		const std::string string = std::to_string(i);
+
+		CHECK(map.keyExists(string));
+		CHECK(map[string] == Object{int64_t(i)});
+		CHECK(map[int64_t(i)].asString() == string.c_str());
+		CHECK(map[double(i) + 0.5] == Object{uint64_t(i)});
+		CHECK(map.keyExists(Object{uint64_t(i)}) == false);
+	}
+
+	// Erase from the middle, the rest must still be found
+
+	for(size_t i = 0; i < count; i += 2)
+	{
+		map.erase(Object{int64_t(i)});
+	}
+
+	CHECK(map.size() == count * 3 - count / 2);
+
+	for(size_t i = 0; i < count; i++)
+	{
+		CHECK(map.keyExists(Object{int64_t(i)}) == (i % 2 == 1));
+		CHECK(map.keyExists(std::to_string(i)));
+	}
+
+	// Shrink below the threshold
+
+	map.clear();
+
+	for(size_t i = 0; i < Map::Index_Threshold + 1; i++)
+	{
+		map.set(Object{int64_t(i)}, Object{});
+	}
+
+	map.erase(Object{int64_t(0)});
+	CHECK(map.size() == Map::Index_Threshold);
+
+	for(size_t i = 1; i < Map::Index_Threshold + 1; i++)
+	{
+		CHECK(map.keyExists(Object{int64_t(i)}));
+	}
+
+	// NaN can be a key
+
+	map.set(Object{std::numeric_limits<double>::quiet_NaN()}, Object{true});
+	CHECK(map[std::numeric_limits<double>::quiet_NaN()] == Object{true});
+}
+
+
+class CountingResource_
+	: public std::pmr::memory_resource
+{
+	public:
+		size_t count = 0;
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			count++;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+};
+
+
+TEST_CASE("map/memory_resource")
+{
+	std::pmr::monotonic_buffer_resource arena;
+
+	Map map(&arena);
+
+	for(size_t i = 0; i < 100; i++)
+	{
+		map[std::to_string(i)] = Object{int64_t(i)};
+	}
+
+	CHECK(map.size() == 100);
+	CHECK(map["42"] == Object{int64_t(42)});
+	CHECK(map.key(0).asString().get_allocator().resource() == &arena);
+
+	CountingResource_ heap;
+
+	std::pmr::memory_resource* default_resource = std::pmr::set_default_resource(&heap);
+
+	const Map& const_map = map;
+	size_t     count     = 0;
+
+	for(size_t i = 0; i < 100; i++)
+	{
+		const std::string_view key = (i % 2) ? "99" : "missing";
+
+		count += map.keyExists(key);
+		count += const_map[key].isNull();
+		count += (const_map[key] == Object{int64_t(99)});
+	}
+
+	CHECK(count == 150);
+	CHECK(heap.count == 0);
+
+	std::pmr::set_default_resource(default_resource);
+
+	Map copy = map;
+
+	CHECK(copy.size() == 100);
+	CHECK(copy["42"] == Object{int64_t(42)});
+	CHECK(copy.key(0).asString().get_allocator().resource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE("map/storage")
+{
+	CHECK(sizeof(Map) == 2 * sizeof(void*));
+
+	SUBCASE("Empty")
+	{
+		CountingResource_ heap;
+
+		// An empty Map does not allocate
+		Map map(&heap);
+		map.clear();
+		map.reserve(0);
+
+		const Map& const_map = map;
+
+		CHECK(map.size() == 0);
+		CHECK(map.keyExists("key") == false);
+		CHECK(const_map["key"].isNull());
+		CHECK(const_map[int64_t(1)].isNull());
+
+		Map copy = map;
+		Map move = std::move(map);
+
+		copy = move;
+		move = std::move(copy);
+
+		CHECK(heap.count == 0);
+
+		// One block for the Map, then the keys and values
+		map[int64_t(1)] = Object{true};
+		CHECK(heap.count == 3);
+	}
+
+	SUBCASE("Copy")
+	{
+		std::pmr::monotonic_buffer_resource arena;
+
+		Map map(&arena);
+
+		for(size_t i = 0; i < 20; i++)
+		{
+			map[std::to_string(i)] = Object{int64_t(i)};
+		}
+
+		Map copy = map;
+
+		CHECK(copy.size() == 20);
+		CHECK(copy["19"] == Object{int64_t(19)});
+		CHECK(copy.key(0).asString().get_allocator().resource() == std::pmr::get_default_resource());
+
+		Map other(&arena);
+		other["x"] = Object{true};
+
+		// Copied Objects use the default memory resource
+		other = copy;
+
+		CHECK(other.size() == 20);
+		CHECK(other.keyExists("x") == false);
+		CHECK(other["7"] == Object{int64_t(7)});
+		CHECK(other.key(0).asString().get_allocator().resource() == std::pmr::get_default_resource());
+
+		other = other;
+		CHECK(other.size() == 20);
+	}
+
+	SUBCASE("Move")
+	{
+		std::pmr::monotonic_buffer_resource arena;
+
+		Map map(&arena);
+
+		for(size_t i = 0; i < 20; i++)
+		{
+			map[std::to_string(i)] = Object{int64_t(i)};
+		}
+
+		const Object* value = &map["5"];
+
+		Map move = std::move(map);
+
+		CHECK(map.size() == 0);
+		CHECK(map.keyExists("5") == false);
+		CHECK(move.size() == 20);
+		CHECK(&move["5"] == value);
+
+		// The same memory resource, the contents are moved
+		Map same(&arena);
+		same["x"] = Object{true};
+		same = std::move(move);
+
+		CHECK(move.size() == 0);
+		CHECK(same.size() == 20);
+		CHECK(&same["5"] == value);
+
+		// A different memory resource, the contents are moved one at a time
+		// and the moved Objects keep their memory resource
+		Map other;
+		other = std::move(same);
+
+		CHECK(same.size() == 0);
+		CHECK(other.size() == 20);
+		CHECK(other["19"] == Object{int64_t(19)});
+		CHECK(&other["5"] != value);
+		CHECK(other.key(0).asString().get_allocator().resource() == &arena);
+
+		// A moved from Map can be used
+		same["y"] = Object{false};
+		CHECK(same.size() == 1);
+		CHECK(same["y"] == Object{false});
+	}
+}
+#endif // }}}
+
+// }}} Map
+// {{{ KeyCache
+
+/**
+ * \class KeyCache
+ *
+ * \brief An intern table for the string keys of Maps.
+ *
+ * Messages that have the same keys over and over spend much of their decode 
+ * time on the keys: each key is compared with, or hashed and compared with, 
+ * the other keys of its Map to find duplicates. When a KeyCache is passed 
+ * to deserialize(), each string key is looked up in the KeyCache, which 
+ * remembers the keys that it has seen and their hash.
+ *
+ * The first 64 keys in the KeyCache are tracked for every Map that is being 
+ * decoded. When one of those keys is found in a Map for the first time, it 
+ * can not be a duplicate. It is added to the Map without comparing it with 
+ * the other keys and the hash is not calculated again. All other keys are 
+ * added the same way as without a KeyCache.
+ *
+ * Keys are added to the KeyCache until it is full, keys that are longer 
+ * than Key_Length_Max are never added. The hits() and misses() are counted 
+ * so that the hitRate() can be checked.
+ *
+ * \parcode
+ * zakero::messagepack::KeyCache key_cache;
+ *
+ * while(receive(data))
+ * {
+ * 	size_t          index = 0;
+ * 	std::error_code error;
+ *
+ * 	zakero::messagepack::Object object = zakero::messagepack::deserialize(data, index, error, key_cache);
+ * }
+ *
+ * printf("Key hit rate: %f\n", key_cache.hitRate());
+ * \endparcode
+ *
+ * \note The decoded keys are still copied into each Map, a KeyCache does not 
+ * change the Objects that deserialize() creates. Use a memory resource, such 
+ * as `std::pmr::monotonic_buffer_resource`, to make those copies cheap.
+ *
+ * \note A KeyCache must not be used by more than one thread at a time.
+ */
+
+/**
+ * \var KeyCache::Capacity
+ *
+ * \brief The default number of keys.
+ */
+
+/**
+ * \var KeyCache::Key_Length_Max
+ *
+ * \brief Longer keys are not added to the KeyCache.
+ */
+
+/**
+ * \fn KeyCache::capacity()
+ *
+ * \brief The maximum number of keys.
+ *
+ * \return The capacity.
+ */
+
+/**
+ * \fn KeyCache::size()
+ *
+ * \brief The number of keys.
+ *
+ * \return The size.
+ */
+
+/**
+ * \fn KeyCache::hits()
+ *
+ * \brief The number of keys that were found in the KeyCache.
+ *
+ * \return The hit count.
+ */
+
+/**
+ * \fn KeyCache::misses()
+ *
+ * \brief The number of keys that were not found in the KeyCache.
+ *
+ * A key that is added to the KeyCache is a miss.
+ *
+ * \return The miss count.
+ */
+
+/**
+ * \brief Constructor.
+ *
+ * Create an empty KeyCache that can hold \p capacity keys.
+ */
+KeyCache::KeyCache(const size_t capacity ///< The maximum number of keys
+	) noexcept
+	: slot_vector_(std::bit_ceil(std::max(capacity, size_t(1)) * 2), 0)
+	, capacity_(capacity)
+{
+	entry_vector_.reserve(capacity);
+}
+
+
+/**
+ * \brief Remove all the keys.
+ *
+ * The statistics are not changed.
+ */
+void KeyCache::clear() noexcept
+{
+	entry_vector_.clear();
+	std::fill(slot_vector_.begin(), slot_vector_.end(), 0);
+}
+
+
+/**
+ * \brief Reset the statistics.
+ *
+ * The hits() and misses() are set to `0`. The keys are not changed.
+ */
+void KeyCache::clearStatistics() noexcept
+{
+	hits_   = 0;
+	misses_ = 0;
+}
+
+
+/**
+ * \brief The fraction of keys that were found.
+ *
+ * \return A value from `0.0` to `1.0`.
+ */
+double KeyCache::hitRate() const noexcept
+{
+	const size_t lookups = hits_ + misses_;
+
+	if(lookups == 0)
+	{
+		return 0;
+	}
+
+	return (double)hits_ / (double)lookups;
+}
+
+
+/**
+ * \brief Find a key, or add it.
+ *
+ * The \p key is looked up with a quick hash of its length and its first and 
+ * last bytes, then compared.
+ *
+ * \return The index of the key in the KeyCache, or Npos if the \p key is 
+ * not in the KeyCache and could not be added.
+ */
+size_t KeyCache::intern_(const std::string_view key ///< The key
+	) noexcept
+{
+	uint64_t head = 0;
+	uint64_t tail = 0;
+
+	if(key.size() >= sizeof(uint64_t))
+	{
+		memcpy(&head, key.data(), sizeof(uint64_t));
+		memcpy(&tail, key.data() + key.size() - sizeof(uint64_t), sizeof(uint64_t));
+	}
+	else
+	{
+		memcpy(&head, key.data(), key.size());
+	}
+
+	const size_t mask = slot_vector_.size() - 1;
+
+	size_t slot = keyMix_(head ^ keyMix_(tail + key.size())) & mask;
+
+	for(; slot_vector_[slot] != 0; slot = (slot + 1) & mask)
+	{
+		const size_t index = slot_vector_[slot] - 1;
+
+		if(entry_vector_[index].key == key)
+		{
+			hits_++;
+
+			return index;
+		}
+	}
+
+	misses_++;
+
+	if(entry_vector_.size() >= capacity_
+		|| key.size() > Key_Length_Max
+		)
+	{
+		return Npos;
+	}
+
+	entry_vector_.push_back({std::string(key), keyHash_(key)});
+	slot_vector_[slot] = (uint32_t)entry_vector_.size();
+
+	return entry_vector_.size() - 1;
+}
+
+
+// }}} KeyCache
+// {{{ ShapeCache
+
+/**
+ * \class ShapeCache
+ *
+ * \brief Remembers the keys of recently decoded Maps.
+ *
+ * Messages often have the same _shape_ over and over: a Map with the same 
+ * keys in the same order. When a ShapeCache is passed to deserialize(), the 
+ * packed keys of each Map are remembered as a shape. When a Map with the same 
+ * number of keys and the same first key is found, the keys of the shape are 
+ * added to the Map all at once and each key in the data is only compared, 
+ * byte for byte, with the packed key of the shape. The keys are not decoded, 
+ * not compared with the other keys of the Map, and not hashed. The values 
+ * are decoded directly into their place in the Map.
+ *
+ * If a key in the data is not the same as the key of the shape, the keys 
+ * that have not been found yet are removed from the Map and the rest of the 
+ * Map is decoded the normal way. The Object is always the same as the Object 
+ * that deserialize() creates without a ShapeCache.
+ *
+ * Maps with more than Key_Count_Max keys, with duplicate keys, or with keys 
+ * that are longer than Key_Length_Max bytes are not remembered. When the 
+ * ShapeCache is full, a new shape replaces the oldest shape. The hits() and 
+ * misses() are counted for each Map so that the hitRate() can be checked.
+ *
+ * \parcode
+ * zakero::messagepack::ShapeCache shape_cache;
+ *
+ * while(receive(data))
+ * {
+ * 	size_t          index = 0;
+ * 	std::error_code error;
+ *
+ * 	zakero::messagepack::Object object = zakero::messagepack::deserialize(data, index, error, shape_cache);
+ * }
+ *
+ * printf("Shape hit rate: %f\n", shape_cache.hitRate());
+ * \endparcode
+ *
+ * \note Shapes are found by the number of keys and the first key. Different 
+ * shapes that have the same number of keys and the same first key replace 
+ * each other.
+ *
+ * \note A ShapeCache must not be used by more than one thread at a time.
+ */
+
+/**
+ * \var ShapeCache::Capacity
+ *
+ * \brief The default number of shapes.
+ */
+
+/**
+ * \var ShapeCache::Key_Count_Max
+ *
+ * \brief Maps with more keys are not added to the ShapeCache.
+ */
+
+/**
+ * \var ShapeCache::Key_Length_Max
+ *
+ * \brief Maps with longer packed keys are not added to the ShapeCache.
+ */
+
+/**
+ * \fn ShapeCache::capacity()
+ *
+ * \brief The maximum number of shapes.
+ *
+ * \return The capacity.
+ */
+
+/**
+ * \fn ShapeCache::size()
+ *
+ * \brief The number of shapes.
+ *
+ * \return The size.
+ */
+
+/**
+ * \fn ShapeCache::hits()
+ *
+ * \brief The number of Maps that were decoded with a shape.
+ *
+ * \return The hit count.
+ */
+
+/**
+ * \fn ShapeCache::misses()
+ *
+ * \brief The number of Maps that were not decoded with a shape.
+ *
+ * Empty Maps are not counted.
+ *
+ * \return The miss count.
+ */
+
+/**
+ * \brief Constructor.
+ *
+ * Create an empty ShapeCache that can hold \p capacity shapes.
+ */
+ShapeCache::ShapeCache(const size_t capacity ///< The maximum number of shapes
+	) noexcept
+	: capacity_(capacity)
+{
+	shape_vector_.reserve(capacity);
+}
+
+
+/**
+ * \brief Remove all the shapes.
+ *
+ * The statistics are not changed.
+ */
+void ShapeCache::clear() noexcept
+{
+	shape_vector_.clear();
+	next_ = 0;
+}
+
+
+/**
+ * \brief Reset the statistics.
+ *
+ * The hits() and misses() are set to `0`. The shapes are not changed.
+ */
+void ShapeCache::clearStatistics() noexcept
+{
+	hits_   = 0;
+	misses_ = 0;
+}
+
+
+/**
+ * \brief The fraction of Maps that were decoded with a shape.
+ *
+ * \return A value from `0.0` to `1.0`.
+ */
+double ShapeCache::hitRate() const noexcept
+{
+	const size_t lookups = hits_ + misses_;
+
+	if(lookups == 0)
+	{
+		return 0;
+	}
+
+	return (double)hits_ / (double)lookups;
+}
+
+
+/**
+ * \brief Find a shape.
+ *
+ * The first key of the Map starts at the \p index of the \p data.
+ *
+ * \return The index of the shape or Npos.
+ */
+size_t ShapeCache::find_(const std::span<const uint8_t> data  ///< The packed data
+	, const size_t                                  index ///< The first key
+	, const uint64_t                                count ///< The number of keys
+	) const noexcept
+{
+	for(size_t i = 0; i < shape_vector_.size(); i++)
+	{
+		const Shape& shape = shape_vector_[i];
+
+		if(shape.key_vector.size() == count
+			&& match_(shape, 0, data, index)
+			)
+		{
+			return i;
+		}
+	}
+
+	return Npos;
+}
+
+
+/**
+ * \brief Compare a key.
+ *
+ * \retval true  The packed key at the \p index of the \p data is the same as 
+ *               key \p key of the \p shape.
+ * \retval false The keys are not the same.
+ */
+bool ShapeCache::match_(const Shape&            shape ///< The shape
+	, const size_t                          key   ///< The index of the key
+	, const std::span<const uint8_t>        data  ///< The packed data
+	, const size_t                          index ///< The packed key
+	) const noexcept
+{
+	const size_t begin  = shape.key_offset[key];
+	const size_t length = shape.key_offset[key + 1] - begin;
+
+	return (length <= data.size() - index)
+		&& (memcmp(data.data() + index, shape.key_bytes.data() + begin, length) == 0)
+		;
+}
+
+
+/**
+ * \brief Add the keys of a shape to a Map.
+ *
+ * The empty \p map gets all the keys of the \p shape, each with a Null value, 
+ * and the hash table of the \p shape.
+ */
+void ShapeCache::create_(const Shape&   shape    ///< The shape
+	, Map&                          map      ///< The Map
+	, std::pmr::memory_resource*    resource ///< The memory resource
+	) const noexcept
+{
+	Map::Data_& data = map.writable_();
+
+	data.key_vector.reserve(shape.key_vector.size());
+
+	for(const Object& key : shape.key_vector)
+	{
+		Object& copy = data.key_vector.emplace_back();
+
+		if(key.isString())
+		{
+			copy.value.emplace<std::pmr::string>(key.asString(), resource);
+		}
+		else
+		{
+			copy.value = key.value;
+		}
+	}
+
+	data.value_vector.resize(shape.key_vector.size());
+	data.index_vector.assign(shape.index_vector.begin(), shape.index_vector.end());
+}
+
+
+/**
+ * \brief Start recording the keys of a Map.
+ *
+ * The keys of nested Maps are recorded after the keys of their parent and 
+ * are removed when the nested Map ends.
+ *
+ * \return The record.
+ */
+size_t ShapeCache::recordBegin_() noexcept
+{
+	record_offset_.push_back(record_bytes_.size());
+
+	return record_offset_.size() - 1;
+}
+
+
+/**
+ * \brief Start recording the keys of a Map.
+ *
+ * The first \p key_count keys of the Map are the keys of the \p shape.
+ *
+ * \return The record.
+ */
+size_t ShapeCache::recordBegin_(const Shape& shape     ///< The shape
+	, const size_t                       key_count ///< The number of keys
+	) noexcept
+{
+	const size_t record = recordBegin_();
+	const size_t base   = record_offset_[record];
+
+	record_bytes_.insert(record_bytes_.end()
+		, shape.key_bytes.begin()
+		, shape.key_bytes.begin() + shape.key_offset[key_count]
+		);
+
+	for(size_t i = 1; i <= key_count; i++)
+	{
+		record_offset_.push_back(base + shape.key_offset[i]);
+	}
+
+	return record;
+}
+
+
+/**
+ * \brief Record a packed key.
+ *
+ * If the \p key is too long, the \p record is cancelled.
+ *
+ * \retval true  The \p key was recorded.
+ * \retval false The \p record was cancelled.
+ */
+bool ShapeCache::recordKey_(const size_t record ///< The record
+	, const std::span<const uint8_t> key    ///< The packed key
+	) noexcept
+{
+	if(key.size() > Key_Length_Max)
+	{
+		recordCancel_(record);
+
+		return false;
+	}
+
+	record_bytes_.insert(record_bytes_.end(), key.begin(), key.end());
+	record_offset_.push_back(record_bytes_.size());
+
+	return true;
+}
+
+
+/**
+ * \brief Stop recording the keys of a Map.
+ *
+ * If every key of the \p map was recorded and none of them were duplicates, 
+ * the keys are added as a shape.
+ */
+void ShapeCache::recordEnd_(const size_t record ///< The record
+	, const Map&                     map    ///< The decoded Map
+	) noexcept
+{
+	const size_t key_count = record_offset_.size() - record - 1;
+
+	if(key_count > 0
+		&& key_count == map.size()
+		)
+	{
+		add_(record, map);
+	}
+
+	recordCancel_(record);
+}
+
+
+/**
+ * \brief Stop recording the keys of a Map.
+ *
+ * The recorded keys are removed.
+ */
+void ShapeCache::recordCancel_(const size_t record ///< The record
+	) noexcept
+{
+	record_bytes_.resize(record_offset_[record]);
+	record_offset_.resize(record);
+}
+
+
+/**
+ * \brief Add a shape.
+ *
+ * A shape with the same number of keys and the same first key is replaced, 
+ * otherwise the oldest shape is replaced when the ShapeCache is full.
+ */
+void ShapeCache::add_(const size_t record ///< The record
+	, const Map&               map    ///< The decoded Map
+	) noexcept
+{
+	if(capacity_ == 0)
+	{
+		return;
+	}
+
+	const size_t base = record_offset_[record];
+
+	const std::span<const uint8_t> bytes(record_bytes_.data() + base
+		, record_bytes_.size() - base
+		);
+
+	size_t slot = find_(bytes, 0, map.size());
+
+	if(slot == Npos)
+	{
+		if(shape_vector_.size() < capacity_)
+		{
+			slot = shape_vector_.size();
+			shape_vector_.emplace_back();
+		}
+		else
+		{
+			slot  = next_;
+			next_ = (next_ + 1) % capacity_;
+		}
+	}
+
+	Shape& shape = shape_vector_[slot];
+
+	shape.key_bytes.assign(bytes.begin(), bytes.end());
+
+	shape.key_offset.clear();
+
+	for(size_t i = record; i < record_offset_.size(); i++)
+	{
+		shape.key_offset.push_back(record_offset_[i] - base);
+	}
+
+	shape.key_vector.assign(map.data_->key_vector.begin(), map.data_->key_vector.end());
+	shape.index_vector.assign(map.data_->index_vector.begin(), map.data_->index_vector.end());
+	shape.generation = ++generation_;
+}
+
+// }}} ShapeCache
+// {{{ Object
+
+/**
+ * \struct Object
+ *
+ * \brief A Data Object.
+ *
+ * The role of this object is to store all the data-types in the MessagePack 
+ * specification. This is accomplish by using the `std::variant` and a 
+ * collection of helper methods to reduce the verbosity of templates.
+ *
+ * \note The `std::monostate` is used to represent `null`.
+ *
+ * Once an Object has been set to a type, it is an error to cast the object to 
+ * any other type.
+ *
+ * \parcode
+ * zakero::messagepack::Object object;
+ *
+ * object = {true}; // Object is now a boolean
+ * int64_t value = object.as<int64_t>(); // Error: Object is not a int64_t
+ *
+ * // Reusing the same object...
+ * object = {int64_t(42)}; // Object is now a int64_t
+ * value = object.as<int64_t>(); // Ok: Object is a int64_t
+ * \endparcode
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::as()
+ *
+ * \brief Convert to type `T`.
+ *
+ * The Object will be converted so that it will be treated __as__ the requested 
+ * \p T type.
+ *
+ * \parcode
+ * zakero::messagepack::Object object = {true};
+ *
+ * bool b = object.as<bool>();
+ * \endparcode
+ *
+ * \return The request data-type.
+ *
+ * \tparam T The data-type to convert to.
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::as() const
+ *
+ * \brief Convert to type `T`.
+ *
+ * The Object will be converted so that it will be treated __as__ the requested 
+ * \p T type.
+ *
+ * \parcode
+ * zakero::messagepack::Object object = {true};
+ *
+ * bool b = object.as<bool>();
+ * \endparcode
+ *
+ * \return The request data-type.
+ *
+ * \tparam T The data-type to convert to.
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::asArray()
+ *
+ * \brief Convert to an Array.
+ *
+ * The same as: `object.as<zakero::messagepack::Array>()`
+ *
+ * \return A reference to an Array.
+ *
+ * \see as()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::asArray() const
+ *
+ * \brief Convert to an Array.
+ *
+ * The same as: `object.as<zakero::messagepack::Array>()`
+ *
+ * \return A reference to an Array.
+ *
+ * \see as()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::asBinary()
+ *
+ * \brief Convert to a std::pmr::vector<uint8_t>.
+ *
+ * The same as: `object.as<std::pmr::vector<uint8_t>>()`
+ *
+ * \return A reference to a std::pmr::vector<uint8_t>.
+ *
+ * \see as()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::asBinary() const
+ *
+ * \brief Convert to a std::pmr::vector<uint8_t>.
+ *
+ * The same as: `object.as<std::pmr::vector<uint8_t>>()`
+ *
+ * \return A reference to a std::pmr::vector<uint8_t>.
+ *
+ * \see as()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::asExt()
+ *
+ * \brief Convert to an Ext.
+ *
+ * The same as: `object.as<zakero::messagepack::Ext>()`
+ *
+ * \return A reference to an Ext.
+ *
+ * \see as()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::asExt() const
+ *
+ * \brief Convert to an Ext.
+ *
+ * The same as: `object.as<zakero::messagepack::Ext>()`
+ *
+ * \return A reference to an Ext.
+ *
+ * \see as()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::asMap()
+ *
+ * \brief Convert to a Map.
+ *
+ * The same as: `object.as<zakero::messagepack::Map>()`
+ *
+ * \return A reference to a Map.
+ *
+ * \see as()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::asMap() const
+ *
+ * \brief Convert to a Map.
+ *
+ * The same as: `object.as<zakero::messagepack::Map>()`
+ *
+ * \return A reference to a Map.
+ *
+ * \see as()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::asString() const
+ *
+ * \brief Convert to a std::pmr::string.
+ *
+ * The same as: `object.as<std::pmr::string>()`
+ *
+ * \return A reference to a std::pmr::string.
+ *
+ * \see as()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::is() const
+ *
+ * \brief Is Object of type `T`.
+ *
+ * The Object will be checked to see if it is of type `T`.
+ *
+ * \parcode
+ * zakero::messagepack::Object object = {int64_t(123)};
+ *
+ * bool is_int = object.is<int64_t>();
+ * \endparcode
+ *
+ * \retval true  The Object is of type `T`
+ * \retval false The Object is not of type `T`
+ *
+ * \tparam T The data-type to check.
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::isArray()
+ *
+ * \brief Is Object an Array?
+ *
+ * The same as: `object.is<zakero::messagepack::Array>()`
+ *
+ * \retval true  The Object is an Array
+ * \retval false The Object is not an Array
+ *
+ * \see is()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::isBinary()
+ *
+ * \brief Is Object binary data?
+ *
+ * The same as: `object.is<std::pmr::vector<uint8_t>>()`
+ *
+ * \retval true  The Object is a std::pmr::vector<uint8_t>
+ * \retval false The Object is not a std::pmr::vector<uint8_t>
+ *
+ * \see is()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::isExt()
+ *
+ * \brief Is Object an Ext?
+ *
+ * The same as: `object.is<zakero::messagepack::Ext>()`
+ *
+ * \retval true  The Object is an Ext
+ * \retval false The Object is not an Ext
+ *
+ * \see is()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::isMap()
+ *
+ * \brief Is Object a Map?
+ *
+ * The same as: `object.is<zakero::messagepack::Map>()`
+ *
+ * \retval true  The Object is a Map
+ * \retval false The Object is not a Map
+ *
+ * \see is()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::isNull()
+ *
+ * \brief Does the Object represent a `null`?
+ *
+ * The same as: `object.is<std::monostate>()`
+ *
+ * \retval true  The Object is a std::monostate
+ * \retval false The Object is not a std::monostate
+ *
+ * \see is()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::isString()
+ *
+ * \brief Is Object a std::pmr::string?
+ *
+ * The same as: `object.is<std::pmr::string>()`
+ *
+ * \retval true  The Object is a std::pmr::string
+ * \retval false The Object is not a std::pmr::string
+ *
+ * \see is()
+ */
+
+
+/**
+ * \fn zakero::messagepack::Object::type()
+ *
+ * \brief Provide the Object type as a std::string.
+ *
+ * The datatype name of the value in this Object will be returned as a 
+ * std::string. While not very useful for final/release codebases, this method 
+ * can be a great help when debugging.
+ *
+ * \return A string.
+ */
+std::string Object::type() const noexcept
+{
+	if(this->isNull())
+	{
+		return "null";
+	}
+
+	if(this->is<bool>())
+	{
+		return "bool";
+	}
+
+	if(this->is<int64_t>())
+	{
+		return "int64_t";
+	}
+
+	if(this->is<uint64_t>())
+	{
+		return "uint64_t";
+	}
+
+	if(this->is<float>())
+	{
+		return "float";
+	}
+
+	if(this->is<double>())
+	{
+		return "dnuble";
+	}
+
+	if(this->is<std::pmr::string>())
+	{
+		return "std::pmr::string";
+	}
+
+	if(this->is<std::pmr::vector<uint8_t>>())
+	{
+		return "std::pmr::vector<uint8_t>";
+	}
+
+	if(this->isArray())
+	{
+		return "zakero::messagepack::Array";
+	}
+
+	if(this->isExt())
+	{
+		return "zakero::messagepack::Ext";
+	}
+
+	if(this->isMap())
+	{
+		return "zakero::messagepack::Map";
+	}
+
+	return {};
+}
+
+// }}} Object
+// {{{ Packer
+
+/**
+ * \class Packer
+ *
+ * \brief Write MessagePack data directly.
+ *
+ * Building an Object tree just to serialize it costs an allocation for
+ * every container and every string, and then serialize() allocates the
+ * result. The Packer skips all of that by writing the MessagePack
+ * byte-code directly into a destination owned by the caller:
+ * - __std::vector__<br>
+ *   The data is appended to the vector, which will grow as needed.
+ * - __std::span__<br>
+ *   The data is written into a fixed size buffer. If the buffer is too
+ *   small, Error_Buffer_Too_Small is returned and no more data will be
+ *   written. The contents of the buffer will be incomplete.
+ * - __Sink__<br>
+ *   The data is collected in an internal buffer. When the internal buffer
+ *   is full, its contents are passed to the Sink. Large string, binary,
+ *   and extension data will be passed directly to the Sink.
+ * - __Gather__<br>
+ *   The data is appended to a vector, except for large string, binary,
+ *   and extension data. That data is not copied, instead a list of
+ *   `struct iovec` refers to both the vector and the original data, ready
+ *   for `writev()` or `sendmsg()`.
+ *
+ * Containers are written by first packing a header that has the number of
+ * elements in the container, then packing each element. For a Map, each
+ * element is a key followed by its value.
+ *
+ * \parcode
+ * std::vector<uint8_t> buffer;
+ * zakero::messagepack::Packer packer(buffer);
+ *
+ * packer.packArrayHeader(3);
+ * packer.packInt(command_id);
+ * packer.packStr("status");
+ * packer.packBin(payload);
+ *
+ * if(packer.error())
+ * {
+ * 	logError(command_id, packer.error());
+ * }
+ * \endparcode
+ *
+ * The Packer produces the same byte-code as serialize() and an entire
+ * Object can be packed with pack().
+ *
+ * Once an error has occurred, all later calls will do nothing and return
+ * the same error.
+ *
+ * \note The Packer is not copyable because the Sink buffer is owned by the
+ * Packer.
+ */
+
+
+/**
+ * \typedef Packer::Sink
+ *
+ * \brief Receives the packed data.
+ *
+ * The Sink will be given the packed data in the order that it was packed.
+ * The data is only valid for the duration of the call.
+ */
+
+
+/**
+ * \var Packer::Sink_Buffer_Size
+ *
+ * \brief The default size of the Sink buffer.
+ */
+
+
+/**
+ * \var Packer::Gather_Size
+ *
+ * \brief The default size of data that will not be copied.
+ *
+ * Copying a small amount of data costs less than the `struct iovec` that 
+ * would refer to it.
+ */
+
+
+/**
+ * \brief Constructor.
+ *
+ * All packed data will be appended to the \p vector. The \p vector must
+ * exist for the life-time of the Packer.
+ *
+ * \parcode
+ * std::vector<uint8_t> vector;
+ * zakero::messagepack::Packer packer(vector);
+ * \endparcode
+ */
+Packer::Packer(std::vector<uint8_t>& vector ///< Where to store the data
+	) noexcept
+	: vector_(&vector)
+{
+}
+
+
+/**
+ * \brief Constructor.
+ *
+ * All packed data will be written into the \p buffer. If the \p buffer is
+ * not large enough, Error_Buffer_Too_Small will be returned. The number of
+ * bytes that have been written is available from size().
+ *
+ * \parcode
+ * uint8_t buffer[1024];
+ * zakero::messagepack::Packer packer(buffer);
+ * \endparcode
+ */
+Packer::Packer(std::span<uint8_t> buffer ///< Where to store the data
+	) noexcept
+	: buffer_(buffer)
+{
+}
+
+
+/**
+ * \brief Constructor.
+ *
+ * All packed data will be given to the \p sink. To reduce the number of
+ * times that the \p sink is called, the packed data is collected in a
+ * buffer of \p buffer_size bytes. Call flush() to pass any remaining data
+ * to the \p sink. The destructor will also call flush().
+ *
+ * \parcode
+ * zakero::messagepack::Packer packer([&](std::span<const uint8_t> data)
+ * {
+ * 	socket.write(data.data(), data.size());
+ * });
+ * \endparcode
+ */
+Packer::Packer(Sink sink          ///< The data receiver
+	, const size_t buffer_size ///< The size of the buffer
+	) noexcept
+	: sink_buffer_(std::max(buffer_size, size_t(16)))
+	, sink_(std::move(sink))
+{
+	buffer_ = sink_buffer_;
+}
+
+
+/**
+ * \brief Constructor.
+ *
+ * All packed data will be appended to the \p buffer, except for string, 
+ * binary, and extension data that has \p gather_size or more bytes. The 
+ * \p iovec_vector will refer to the packed data in order, so that it can be 
+ * written with `writev()` or `sendmsg()`. Large data that is not copied must 
+ * exist until the data has been written.
+ *
+ * The entries that refer to the \p buffer are only valid after flush() has 
+ * been called, and until the \p buffer is changed. The destructor will 
+ * also call flush().
+ *
+ * \parcode
+ * std::vector<uint8_t>      buffer;
+ * std::vector<struct iovec> iovec_vector;
+ *
+ * {
+ * 	zakero::messagepack::Packer packer(buffer, iovec_vector);
+ *
+ * 	packer.packArrayHeader(2);
+ * 	packer.packStr(file_name);
+ * 	packer.packBin(file_contents);
+ * }
+ *
+ * writev(fd, iovec_vector.data(), iovec_vector.size());
+ * \endparcode
+ *
+ * \note The number of `struct iovec` that `writev()` will accept is 
+ * limited, see `sysconf(_SC_IOV_MAX)`.
+ */
+Packer::Packer(std::vector<uint8_t>& buffer    ///< Where to store the data
+	, std::vector<struct iovec>& iovec_vector ///< The data to write
+	, const size_t               gather_size  ///< The size of data that is not copied
+	) noexcept
+	: vector_(&buffer)
+	, iovec_vector_(&iovec_vector)
+	, gather_size_(std::max(gather_size, size_t(1)))
+	, gather_offset_(buffer.size())
+{
+}
+
+
+/**
+ * \brief Destructor.
+ *
+ * If a Sink is being used, any data that is in the buffer will be passed
+ * to the Sink. When gathering data, flush() will be called.
+ */
+Packer::~Packer() noexcept
+{
+	flush();
+}
+
+
+/**
+ * \brief Pass the buffered data to the Sink.
+ *
+ * When gathering data, the `struct iovec` list will be completed.
+ *
+ * This method does nothing if a Sink is not being used and data is not 
+ * being gathered.
+ *
+ * \return The current error.
+ */
+std::error_code Packer::flush() noexcept
+{
+	if(sink_ && index_ > 0)
+	{
+		sink_(std::span<const uint8_t>(buffer_.data(), index_));
+
+		index_ = 0;
+	}
+
+	if(iovec_vector_ != nullptr)
+	{
+		gather_();
+
+		// The buffer may have moved, so all the entries are updated
+		for(const auto& [index, offset] : gather_vector_)
+		{
+			(*iovec_vector_)[index].iov_base = vector_->data() + offset;
+		}
+	}
+
+	return error_;
+}
+
+
+/**
+ * \fn Packer::error()
+ *
+ * \brief The current error.
+ *
+ * \return The error code.
+ */
+
+
+/**
+ * \fn Packer::size()
+ *
+ * \brief The number of bytes that have been packed.
+ *
+ * \return The byte count.
+ */
+
+
+/**
+ * \brief Get space to write into.
+ *
+ * Space for \p count bytes will be made available. If a Sink is being used
+ * and the buffer is full, the buffer will be flushed first.
+ *
+ * \return A pointer to the space or `nullptr` if the space could not be
+ * provided.
+ */
+uint8_t* Packer::reserve_(const size_t count ///< The number of bytes
+	) noexcept
+{
+	if(vector_ != nullptr)
+	{
+		const size_t index = vector_->size();
+
+		vector_->resize(index + count);
+		size_ += count;
+
+		return vector_->data() + index;
+	}
+
+	if(count > buffer_.size() - index_)
+	{
+		if(sink_ && count <= buffer_.size())
+		{
+			flush();
+		}
+		else
+		{
+			error_ = Error_Buffer_Too_Small;
+
+			return nullptr;
+		}
+	}
+
+	uint8_t* pointer = buffer_.data() + index_;
+
+	index_ += count;
+	size_  += count;
+
+	return pointer;
+}
+
+
+/**
+ * \brief Add the buffer to the gathered data.
+ *
+ * The bytes that were added to the buffer since the last call will be
+ * added to the `struct iovec` list. Since the buffer may move, the offset
+ * is kept and the address is set by flush().
+ */
+void Packer::gather_() noexcept
+{
+	const size_t size = vector_->size();
+
+	if(size > gather_offset_)
+	{
+		gather_vector_.emplace_back(iovec_vector_->size(), gather_offset_);
+		iovec_vector_->push_back({nullptr, size - gather_offset_});
+
+		gather_offset_ = size;
+	}
+}
+
+
+/**
+ * \brief Write bytes.
+ *
+ * The \p count bytes of \p data will be copied as-is. When using a Sink,
+ * data that is too large for the buffer is passed directly to the Sink.
+ * When gathering data, large data is referred to instead of copied.
+ */
+void Packer::write_(const uint8_t* data ///< The bytes to write
+	, const size_t              count ///< The number of bytes
+	) noexcept
+{
+	if(count == 0)
+	{
+		return;
+	}
+
+	if(iovec_vector_ != nullptr && count >= gather_size_)
+	{
+		gather_();
+
+		iovec_vector_->push_back({(void*)data, count});
+
+		size_ += count;
+
+		return;
+	}
+
+	if(sink_ && count > buffer_.size() - index_)
+	{
+		flush();
+
+		if(count >= buffer_.size())
+		{
+			sink_(std::span<const uint8_t>(data, count));
+
+			size_ += count;
+
+			return;
+		}
+	}
+
+	uint8_t* pointer = reserve_(count);
+
+	if(pointer != nullptr)
+	{
+		memcpy(pointer, data, count);
+	}
+}
+
+
+/**
+ * \brief Write a Format ID and a big-endian value.
+ *
+ * \return The current error.
+ */
+template<typename T>
+std::error_code Packer::writeFormat_(const uint8_t format ///< The Format ID
+	, const T                                 value  ///< The value
+	) noexcept
+{
+	uint8_t* pointer = reserve_(1 + sizeof(T));
+
+	if(pointer != nullptr)
+	{
+		pointer[0] = format;
+
+		toBigEndian(value, pointer + 1);
+	}
+
+	return error_;
+}
+
+
+/**
+ * \brief Write a column of fixed width values.
+ *
+ * Each value is written as the \p format ID followed by the big-endian
+ * value. The values are converted in blocks that fill the available space
+ * so that the byte order can be swapped with SIMD instructions.
+ *
+ * \return The current error.
+ */
+template<typename T>
+std::error_code Packer::writeColumn_(const uint8_t format ///< The Format ID
+	, const std::span<const T>                 value  ///< The values
+	) noexcept
+{
+	constexpr size_t Stride = 1 + sizeof(T);
+
+	size_t index = 0;
+
+	while(index < value.size())
+	{
+		size_t count = value.size() - index;
+
+		if(sink_)
+		{
+			if(buffer_.size() - index_ < Stride)
+			{
+				flush();
+			}
+
+			count = std::clamp<size_t>((buffer_.size() - index_) / Stride, 1, count);
+		}
+
+		uint8_t* pointer = reserve_(count * Stride);
+
+		if(pointer == nullptr)
+		{
+			break;
+		}
+
+		packColumn_(format, value.data() + index, count, pointer);
+
+		index += count;
+	}
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack a run of values.
+ *
+ * The leading \p object values that hold a `T` are copied into a block
+ * and written with writeColumn_(). The bytes are the same as calling
+ * pack() for each Object.
+ *
+ * \return The number of Objects that were packed.
+ */
+template<typename T>
+size_t Packer::packRun_(const uint8_t format                ///< The Format ID
+	, const std::span<const messagepack::Object> object ///< The Objects
+	) noexcept
+{
+	constexpr size_t Block_Size = 64;
+
+	T      block[Block_Size];
+	size_t count = 0;
+
+	while(count < Block_Size
+		&& count < object.size()
+		&& std::holds_alternative<T>(object[count].value)
+		)
+	{
+		block[count] = std::get<T>(object[count].value);
+		count++;
+	}
+
+	writeColumn_(format, std::span<const T>(block, count));
+
+	return count;
+}
+
+
+/**
+ * \brief Pack a Null.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packNull() noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	uint8_t* pointer = reserve_(1);
+
+	if(pointer != nullptr)
+	{
+		pointer[0] = (uint8_t)Format::Nill;
+	}
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack a boolean value.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packBool(const bool value ///< The value
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	uint8_t* pointer = reserve_(1);
+
+	if(pointer != nullptr)
+	{
+		pointer[0] = value
+			? (uint8_t)Format::True
+			: (uint8_t)Format::False
+			;
+	}
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack a signed integer value.
+ *
+ * The smallest format that can hold the \p value will be used.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packInt(const int64_t value ///< The value
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	if(value >= -32 && value <= std::numeric_limits<int8_t>::max())
+	{
+		uint8_t* pointer = reserve_(1);
+
+		if(pointer != nullptr)
+		{
+			pointer[0] = (value < 0)
+				? (uint8_t)Format::Fixed_Int_Neg | (uint8_t)(value & Fixed_Int_Neg_Value)
+				: (uint8_t)value
+				;
+		}
+
+		return error_;
+	}
+
+	if(value >= std::numeric_limits<int8_t>::min()
+		&& value < 0
+		)
+	{
+		return writeFormat_((uint8_t)Format::Int8, (int8_t)value);
+	}
+
+	if(value >= std::numeric_limits<int16_t>::min()
+		&& value <= std::numeric_limits<int16_t>::max()
+		)
+	{
+		return writeFormat_((uint8_t)Format::Int16, (int16_t)value);
+	}
+
+	if(value >= std::numeric_limits<int32_t>::min()
+		&& value <= std::numeric_limits<int32_t>::max()
+		)
+	{
+		return writeFormat_((uint8_t)Format::Int32, (int32_t)value);
+	}
+
+	return writeFormat_((uint8_t)Format::Int64, value);
+}
+
+
+/**
+ * \brief Pack an unsigned integer value.
+ *
+ * The smallest unsigned format that can hold the \p value will be used.
+ * To preserve the type, a fixint is never used.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packUint(const uint64_t value ///< The value
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	if(value <= std::numeric_limits<uint8_t>::max())
+	{
+		return writeFormat_((uint8_t)Format::Uint8, (uint8_t)value);
+	}
+
+	if(value <= std::numeric_limits<uint16_t>::max())
+	{
+		return writeFormat_((uint8_t)Format::Uint16, (uint16_t)value);
+	}
+
+	if(value <= std::numeric_limits<uint32_t>::max())
+	{
+		return writeFormat_((uint8_t)Format::Uint32, (uint32_t)value);
+	}
+
+	return writeFormat_((uint8_t)Format::Uint64, value);
+}
+
+
+/**
+ * \brief Pack a 32-bit floating point value.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packFloat(const float value ///< The value
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	return writeFormat_((uint8_t)Format::Float32, value);
+}
+
+
+/**
+ * \brief Pack a 64-bit floating point value.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packDouble(const double value ///< The value
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	return writeFormat_((uint8_t)Format::Float64, value);
+}
+
+
+/**
+ * \brief Pack a string.
+ *
+ * \retval Error_String_Too_Big The string is longer than 4GiB.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packStr(const std::string_view value ///< The value
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	const size_t length = value.size();
+
+	if(length <= 31)
+	{
+		uint8_t* pointer = reserve_(1);
+
+		if(pointer != nullptr)
+		{
+			pointer[0] = (uint8_t)Format::Fixed_Str | (uint8_t)length;
+		}
+	}
+	else if(length <= std::numeric_limits<uint8_t>::max())
+	{
+		writeFormat_((uint8_t)Format::Str8, (uint8_t)length);
+	}
+	else if(length <= std::numeric_limits<uint16_t>::max())
+	{
+		writeFormat_((uint8_t)Format::Str16, (uint16_t)length);
+	}
+	else if(length <= std::numeric_limits<uint32_t>::max())
+	{
+		writeFormat_((uint8_t)Format::Str32, (uint32_t)length);
+	}
+	else
+	{
+		error_ = Error_String_Too_Big;
+	}
+
+	if(error_)
+	{
+		return error_;
+	}
+
+	write_((const uint8_t*)value.data(), length);
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack binary data.
+ *
+ * \retval Error_Binary_Too_Big The data is larger than 4GiB.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packBin(const std::span<const uint8_t> value ///< The value
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	const size_t length = value.size();
+
+	if(length <= std::numeric_limits<uint8_t>::max())
+	{
+		writeFormat_((uint8_t)Format::Bin8, (uint8_t)length);
+	}
+	else if(length <= std::numeric_limits<uint16_t>::max())
+	{
+		writeFormat_((uint8_t)Format::Bin16, (uint16_t)length);
+	}
+	else if(length <= std::numeric_limits<uint32_t>::max())
+	{
+		writeFormat_((uint8_t)Format::Bin32, (uint32_t)length);
+	}
+	else
+	{
+		error_ = Error_Binary_Too_Big;
+	}
+
+	if(error_)
+	{
+		return error_;
+	}
+
+	write_(value.data(), length);
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack extension data.
+ *
+ * \retval Error_Ext_Too_Big The data is larger than 4GiB.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packExt(const int8_t type ///< The extension type
+	, const std::span<const uint8_t>     value ///< The extension data
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	const size_t length = value.size();
+
+	uint8_t* pointer = nullptr;
+
+	switch(length)
+	{
+		case 1:  pointer = reserve_(2); if(pointer) pointer[0] = (uint8_t)Format::Fixed_Ext1;  break;
+		case 2:  pointer = reserve_(2); if(pointer) pointer[0] = (uint8_t)Format::Fixed_Ext2;  break;
+		case 4:  pointer = reserve_(2); if(pointer) pointer[0] = (uint8_t)Format::Fixed_Ext4;  break;
+		case 8:  pointer = reserve_(2); if(pointer) pointer[0] = (uint8_t)Format::Fixed_Ext8;  break;
+		case 16: pointer = reserve_(2); if(pointer) pointer[0] = (uint8_t)Format::Fixed_Ext16; break;
+		default:
+			if(length <= std::numeric_limits<uint8_t>::max())
+			{
+				pointer = reserve_(3);
+
+				if(pointer != nullptr)
+				{
+					pointer[0] = (uint8_t)Format::Ext8;
+					pointer[1] = (uint8_t)length;
+					pointer += 1;
+				}
+			}
+			else if(length <= std::numeric_limits<uint16_t>::max())
+			{
+				pointer = reserve_(4);
+
+				if(pointer != nullptr)
+				{
+					pointer[0] = (uint8_t)Format::Ext16;
+					toBigEndian((uint16_t)length, pointer + 1);
+					pointer += 2;
+				}
+			}
+			else if(length <= std::numeric_limits<uint32_t>::max())
+			{
+				pointer = reserve_(6);
+
+				if(pointer != nullptr)
+				{
+					pointer[0] = (uint8_t)Format::Ext32;
+					toBigEndian((uint32_t)length, pointer + 1);
+					pointer += 4;
+				}
+			}
+			else
+			{
+				error_ = Error_Ext_Too_Big;
+			}
+	}
+
+	if(pointer == nullptr)
+	{
+		return error_;
+	}
+
+	// The type always follows the size
+	pointer[1] = (uint8_t)type;
+
+	write_(value.data(), length);
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack an Array header.
+ *
+ * The next \p count values that are packed will be the contents of the
+ * Array.
+ *
+ * \retval Error_Array_Too_Big The \p count is too large.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packArrayHeader(const size_t count ///< The number of elements
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	if(count < 16)
+	{
+		uint8_t* pointer = reserve_(1);
+
+		if(pointer != nullptr)
+		{
+			pointer[0] = (uint8_t)Format::Fixed_Array | (uint8_t)count;
+		}
+
+		return error_;
+	}
+
+	if(count <= std::numeric_limits<uint16_t>::max())
+	{
+		return writeFormat_((uint8_t)Format::Array16, (uint16_t)count);
+	}
+
+	if(count <= std::numeric_limits<uint32_t>::max())
+	{
+		return writeFormat_((uint8_t)Format::Array32, (uint32_t)count);
+	}
+
+	error_ = Error_Array_Too_Big;
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack a Map header.
+ *
+ * The next \p count pairs of values that are packed will be the contents
+ * of the Map. The first value of each pair is the key.
+ *
+ * \retval Error_Map_Too_Big The \p count is too large.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packMapHeader(const size_t count ///< The number of key/value pairs
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	if(count < 16)
+	{
+		uint8_t* pointer = reserve_(1);
+
+		if(pointer != nullptr)
+		{
+			pointer[0] = (uint8_t)Format::Fixed_Map | (uint8_t)count;
+		}
+
+		return error_;
+	}
+
+	if(count <= std::numeric_limits<uint16_t>::max())
+	{
+		return writeFormat_((uint8_t)Format::Map16, (uint16_t)count);
+	}
+
+	if(count <= std::numeric_limits<uint32_t>::max())
+	{
+		return writeFormat_((uint8_t)Format::Map32, (uint32_t)count);
+	}
+
+	error_ = Error_Map_Too_Big;
+
+	return error_;
+}
+
+
+/**
+ * \brief Write packed data.
+ *
+ * The \p data must already be MessagePack byte-code, it is written as-is.  
+ * This is useful for data that is packed once and then written many times.
+ *
+ * \parcode
+ * const std::vector<uint8_t> header = zakero::messagepack::serialize(object);
+ *
+ * packer.packArrayHeader(2);
+ * packer.packRaw(header);
+ * packer.packUint(sequence++);
+ * \endparcode
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packRaw(const std::span<const uint8_t> data ///< The packed data
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	write_(data.data(), data.size());
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack an Array of floating point values.
+ *
+ * The Array header and all the \p value are packed. Each value uses the
+ * `float 32` format. This is the same as calling packArrayHeader() and then
+ * packFloat() for each value, but the byte order of a whole block of values
+ * is swapped at once using SIMD instructions when the CPU supports them.
+ *
+ * \parcode
+ * std::vector<float> sample = sensor.read();
+ *
+ * packer.packMapHeader(2);
+ * packer.packStr("time");
+ * packer.packUint(now);
+ * packer.packStr("sample");
+ * packer.packArray(sample);
+ * \endparcode
+ *
+ * \retval Error_Array_Too_Big The \p value has too many elements.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packArray(const std::span<const float> value ///< The values
+	) noexcept
+{
+	if(packArrayHeader(value.size()))
+	{
+		return error_;
+	}
+
+	return writeColumn_((uint8_t)Format::Float32, value);
+}
+
+
+/**
+ * \brief Pack an Array of floating point values.
+ *
+ * Each value uses the `float 64` format.
+ *
+ * \copydetails packArray(const std::span<const float>)
+ */
+std::error_code Packer::packArray(const std::span<const double> value ///< The values
+	) noexcept
+{
+	if(packArrayHeader(value.size()))
+	{
+		return error_;
+	}
+
+	return writeColumn_((uint8_t)Format::Float64, value);
+}
+
+
+/**
+ * \brief Pack an Array of signed integer values.
+ *
+ * The Array header and all the \p value are packed. Unlike packInt(), which
+ * uses the smallest format that can hold the value, each value uses the
+ * `int 32` format. The fixed size allows the byte order of a whole block of
+ * values to be swapped at once using SIMD instructions.
+ *
+ * \retval Error_Array_Too_Big The \p value has too many elements.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packArray(const std::span<const int32_t> value ///< The values
+	) noexcept
+{
+	if(packArrayHeader(value.size()))
+	{
+		return error_;
+	}
+
+	return writeColumn_((uint8_t)Format::Int32, value);
+}
+
+
+/**
+ * \brief Pack an Array of signed integer values.
+ *
+ * Each value uses the `int 64` format.
+ *
+ * \copydetails packArray(const std::span<const int32_t>)
+ */
+std::error_code Packer::packArray(const std::span<const int64_t> value ///< The values
+	) noexcept
+{
+	if(packArrayHeader(value.size()))
+	{
+		return error_;
+	}
+
+	return writeColumn_((uint8_t)Format::Int64, value);
+}
+
+
+/**
+ * \fn Packer::packTypedArray(const std::span<const T>)
+ *
+ * \brief Pack a Typed Array extension.
+ *
+ * The \p value is packed as a Typed Array extension, see
+ * Extension_Typed_Array. The values are copied as-is, so packing a large
+ * array costs little more than a `memcpy()`.
+ *
+ * Padding is added so that the values are aligned in memory, which allows
+ * extensionTypedArrayView() to access the values without copying them.
+ * The alignment is based on:
+ * - __std::vector__<br>
+ *   The location in the vector.
+ * - __std::span__<br>
+ *   The memory address.
+ * - __Sink__ and __Gather__<br>
+ *   The number of bytes that have been packed. The receiver must store the
+ *   data in an aligned buffer.
+ *
+ * \parcode
+ * std::vector<float> sample = sensor.read();
+ *
+ * packer.packTypedArray<float>(sample);
+ * \endparcode
+ *
+ * \retval Error_Ext_Too_Big The \p value is larger than 4GiB.
+ *
+ * \return An error code.
+ */
+
+
+/**
+ * \brief Pack a Typed Array extension.
+ *
+ * \see packTypedArray()
+ *
+ * \return An error code.
+ */
+std::error_code Packer::packTypedArray_(const uint8_t element ///< The element code
+	, const std::span<const std::byte>            value   ///< The values
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	const size_t size  = element & 0x0f;
+	const size_t bound = 2 + 7 + value.size();
+
+	if(bound > std::numeric_limits<uint32_t>::max())
+	{
+		error_ = Error_Ext_Too_Big;
+
+		return error_;
+	}
+
+	// The format is chosen by the largest length so that the padding
+	// will not change the size of the header.
+	const size_t header = (bound <= std::numeric_limits<uint8_t>::max()) ? 3
+		: (bound <= std::numeric_limits<uint16_t>::max()) ? 4
+		: 6;
+
+	size_t position = size_;
+
+	if(vector_ != nullptr && iovec_vector_ == nullptr)
+	{
+		position = vector_->size();
+	}
+	else if(!sink_)
+	{
+		position = (uintptr_t)(buffer_.data() + index_);
+	}
+
+	const size_t pad    = (size - ((position + header + 2) % size)) % size;
+	const size_t length = 2 + pad + value.size();
+
+	uint8_t* pointer = reserve_(header + 2 + pad);
+
+	if(pointer == nullptr)
+	{
+		return error_;
+	}
+
+	switch(header)
+	{
+		case 3:
+			pointer[0] = (uint8_t)Format::Ext8;
+			pointer[1] = (uint8_t)length;
+			break;
+		case 4:
+			pointer[0] = (uint8_t)Format::Ext16;
+			toBigEndian((uint16_t)length, pointer + 1);
+			break;
+		default:
+			pointer[0] = (uint8_t)Format::Ext32;
+			toBigEndian((uint32_t)length, pointer + 1);
+	}
+
+	pointer += header;
+
+	pointer[-1] = (uint8_t)Extension_Typed_Array;
+	pointer[0]  = element;
+	pointer[1]  = (uint8_t)pad;
+
+	memset(pointer + 2, 0, pad);
+
+	if constexpr(std::endian::native == std::endian::little)
+	{
+		write_((const uint8_t*)value.data(), value.size());
+	}
+	else
+	{
+		const uint8_t* data = (const uint8_t*)value.data();
+
+		for(size_t i = 0; i < value.size(); i += size)
+		{
+			pointer = reserve_(size);
+
+			if(pointer == nullptr)
+			{
+				break;
+			}
+
+			for(size_t b = 0; b < size; b++)
+			{
+				pointer[b] = data[i + size - 1 - b];
+			}
+		}
+	}
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack an Array.
+ *
+ * The header and all the contents of the \p array will be packed. Runs of
+ * `float` and `double` values are packed in blocks, the same way as
+ * packArray().
+ *
+ * \return An error code.
+ */
+std::error_code Packer::pack(const messagepack::Array& array ///< The Array
+	) noexcept
+{
+	packArrayHeader(array.size());
+
+	return pack(std::span<const messagepack::Object>(array.object_vector));
+}
+
+
+/**
+ * \brief Pack a sequence of Objects.
+ *
+ * All the Objects in the \p object span are packed one after another, 
+ * without an Array header. This can be used to pack part of an Array, or a 
+ * stream of Objects. Runs of `float` and `double` values are packed in 
+ * blocks, the same way as packArray().
+ *
+ * \parcode
+ * std::vector<zakero::messagepack::Object> record_vector = loadRecords();
+ *
+ * std::vector<uint8_t>        data;
+ * zakero::messagepack::Packer packer(data);
+ *
+ * packer.pack(record_vector);
+ * \endparcode
+ *
+ * \return An error code.
+ */
+std::error_code Packer::pack(const std::span<const messagepack::Object> object ///< The Objects
+	) noexcept
+{
+	size_t index = 0;
+
+	while(index < object.size() && !error_)
+	{
+		switch(object[index].value.index())
+		{
+			case 4:
+				index += packRun_<float>((uint8_t)Format::Float32, object.subspan(index));
+				break;
+			case 5:
+				index += packRun_<double>((uint8_t)Format::Float64, object.subspan(index));
+				break;
+			default:
+				pack(object[index]);
+				index++;
+		}
+	}
+
+	return error_;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("packer/objects")
+{
+	Array array;
+	array.append(int64_t(-1));
+	array.append(std::string_view("string"));
+	array.appendRange(std::vector<float>(100, 1.5f));
+	array.append(Map{});
+	array.appendRange(std::vector<double>(10, 2.5));
+	array.append(true);
+
+	std::vector<uint8_t> data;
+	Packer               packer(data);
+
+	CHECK(packer.pack(std::span<const Object>(array.object_vector)) == Error_None);
+
+	// The same as an Array without its header
+	const std::vector<uint8_t> expected = serialize(array);
+	CHECK(data == std::vector<uint8_t>(expected.begin() + 3, expected.end()));
+
+	// Any part of an Array
+	for(size_t split = 0; split <= array.size(); split += 7)
+	{
+		const std::span<const Object> object(array.object_vector);
+
+		std::vector<uint8_t> part;
+		Packer               part_packer(part);
+
+		part_packer.packArrayHeader(array.size());
+		part_packer.pack(object.first(split));
+		part_packer.pack(object.subspan(split));
+
+		CHECK(part == expected);
+	}
+
+	data.clear();
+	CHECK(packer.pack(std::span<const Object>{}) == Error_None);
+	CHECK(data.empty());
+}
+#endif // }}}
+
+
+/**
+ * \brief Pack an Extension.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::pack(const messagepack::Ext& ext ///< The Extension
+	) noexcept
+{
+	return packExt(ext.type, ext.data);
+}
+
+
+/**
+ * \brief Pack a Map.
+ *
+ * The header and all the contents of the \p map will be packed.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::pack(const messagepack::Map& map ///< The Map
+	) noexcept
+{
+	packMapHeader(map.size());
+
+	for(size_t i = 0; i < map.size(); i++)
+	{
+		pack(map.key(i));
+		pack(map.value(i));
+	}
+
+	return error_;
+}
+
+
+/**
+ * \brief Pack an Object.
+ *
+ * The \p object will be packed. If the \p object is a container, all of
+ * its contents will also be packed.
+ *
+ * \return An error code.
+ */
+std::error_code Packer::pack(const messagepack::Object& object ///< The Object
+	) noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	switch(object.value.index())
+	{
+		case 0:  return packNull();
+		case 1:  return packBool(object.as<bool>());
+		case 2:  return packInt(object.as<int64_t>());
+		case 3:  return packUint(object.as<uint64_t>());
+		case 4:  return packFloat(object.as<float>());
+		case 5:  return packDouble(object.as<double>());
+		case 6:  return packStr(object.asString());
+		case 7:  return packBin(object.asBinary());
+		case 8:  return pack(object.asArray());
+		case 9:  return pack(object.asExt());
+		case 10: return pack(object.asMap());
+	}
+
+	error_ = Error_Invalid_Format_Type;
+
+	return error_;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("packer/scalar")
+{
+	const std::vector<Object> object_list =
+	{	Object{}
+	,	Object{true}
+	,	Object{false}
+	,	Object{int64_t(0)}
+	,	Object{int64_t(-1)}
+	,	Object{int64_t(-32)}
+	,	Object{int64_t(-33)}
+	,	Object{int64_t(127)}
+	,	Object{int64_t(128)}
+	,	Object{int64_t(-129)}
+	,	Object{int64_t(32'768)}
+	,	Object{int64_t(-32'769)}
+	,	Object{int64_t(2'147'483'648)}
+	,	Object{std::numeric_limits<int64_t>::min()}
+	,	Object{uint64_t(0)}
+	,	Object{uint64_t(256)}
+	,	Object{uint64_t(65'536)}
+	,	Object{std::numeric_limits<uint64_t>::max()}
+	,	Object{float(3.14f)}
+	,	Object{double(-2.71)}
+	};
+
+	for(const Object& object : object_list)
+	{
+		std::vector<uint8_t> data;
+		Packer packer(data);
+
+		CHECK(packer.pack(object) == Error_None);
+		CHECK(packer.size() == data.size());
+		CHECK(data == serialize(object));
+	}
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	packer.packInt(-100);
+	packer.packUint(100);
+	packer.packBool(true);
+	packer.packNull();
+	packer.packDouble(0.5);
+
+	size_t index = 0;
+	CHECK(deserialize(data, index).as<int64_t>()  == -100);
+	CHECK(deserialize(data, index).as<uint64_t>() == 100);
+	CHECK(deserialize(data, index).as<bool>()     == true);
+	CHECK(deserialize(data, index).isNull());
+	CHECK(deserialize(data, index).as<double>()   == 0.5);
+	CHECK(index == data.size());
+}
+
+TEST_CASE("packer/str")
+{
+	for(const size_t length : {0, 31, 32, 255, 256, 65'535, 65'536})
+	{
+		const std::pmr::string string(length, '_');
+
+		std::vector<uint8_t> data;
+		Packer packer(data);
+
+		CHECK(packer.packStr(string) == Error_None);
+		CHECK(data == serialize(Object{string}));
+
+		Object object = deserialize(data);
+		CHECK(object.isString());
+		CHECK(object.asString() == string);
+	}
+}
+
+TEST_CASE("packer/bin")
+{
+	for(const size_t length : {0, 255, 256, 65'535, 65'536})
+	{
+		const std::pmr::vector<uint8_t> binary(length, '_');
+
+		std::vector<uint8_t> data;
+		Packer packer(data);
+
+		CHECK(packer.packBin(binary) == Error_None);
+		CHECK(data == serialize(Object{binary}));
+
+		Object object = deserialize(data);
+		CHECK(object.isBinary());
+		CHECK(object.asBinary() == binary);
+	}
+}
+
+TEST_CASE("packer/ext")
+{
+	for(const size_t length : {0, 1, 2, 3, 4, 8, 16, 255, 256, 65'535, 65'536})
+	{
+		Ext ext;
+		ext.type = -42;
+		ext.data = std::pmr::vector<uint8_t>(length, '_');
+
+		std::vector<uint8_t> data;
+		Packer packer(data);
+
+		CHECK(packer.packExt(ext.type, ext.data) == Error_None);
+		CHECK(data == serialize(ext));
+
+		Object object = deserialize(data);
+		CHECK(object.isExt());
+		CHECK(object.asExt().type == ext.type);
+		CHECK(object.asExt().data == ext.data);
+	}
+}
+
+TEST_CASE("packer/array")
+{
+	for(const size_t count : {0, 15, 16, 65'535, 65'536})
+	{
+		Array array;
+
+		std::vector<uint8_t> data;
+		Packer packer(data);
+
+		packer.packArrayHeader(count);
+
+		for(size_t i = 0; i < count; i++)
+		{
+			array.append(int64_t(i));
+			packer.packInt(int64_t(i));
+		}
+
+		CHECK(packer.error() == Error_None);
+		CHECK(data == serialize(array));
+
+		Object object = deserialize(data);
+		CHECK(object.isArray());
+		CHECK(object.asArray().size() == count);
+	}
+}
+
+TEST_CASE("packer/map")
+{
+	for(const size_t count : {0, 15, 16, 65'535, 65'536})
+	{
+		Map map;
+
+		std::vector<uint8_t> data;
+		Packer packer(data);
+
+		packer.packMapHeader(count);
+
+		for(size_t i = 0; i < count; i++)
+		{
+			map.set(Object{int64_t(i)}, Object{true});
+			packer.packInt(int64_t(i));
+			packer.packBool(true);
+		}
+
+		CHECK(packer.error() == Error_None);
+		CHECK(data == serialize(map));
+
+		Object object = deserialize(data);
+		CHECK(object.isMap());
+		CHECK(object.asMap().size() == count);
+	}
+}
+
+TEST_CASE("packer/raw")
+{
+	const std::vector<uint8_t> header = serialize(Object{"header"});
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	packer.packArrayHeader(3);
+	packer.packRaw(header);
+	packer.packRaw({});
+	packer.packRaw(header);
+	packer.packUint(1);
+
+	CHECK(packer.error() == Error_None);
+
+	Array array;
+	array.append(std::string_view("header"));
+	array.append(std::string_view("header"));
+	array.append(uint64_t(1));
+
+	CHECK(data == serialize(array));
+
+	std::array<uint8_t, 4> buffer;
+	Packer small(std::span<uint8_t>{buffer});
+
+	CHECK(small.packRaw(header) == Error_Buffer_Too_Small);
+}
+
+TEST_CASE("packer/array/column")
+{
+	std::vector<uint64_t> bits(41);
+	for(size_t i = 0; i < bits.size(); i++)
+	{
+		bits[i] = 0x0102030405060708 * (i + 1) ^ (i << 60);
+	}
+
+	auto check = [&]<typename T>(const uint8_t format, const T*)
+	{
+		std::vector<T> value(bits.size());
+		for(size_t i = 0; i < value.size(); i++)
+		{
+			value[i] = std::bit_cast<T>((Unsigned_<T>)bits[i]);
+		}
+
+		for(size_t count = 0; count <= value.size(); count++)
+		{
+			const size_t length = count * (1 + sizeof(T));
+
+			std::vector<uint8_t> expected(length + 1, 0xee);
+			packColumnScalar_(format, value.data(), count, expected.data());
+			CHECK(expected[length] == 0xee);
+
+			for(size_t i = 0; i < count; i++)
+			{
+				CHECK(expected[i * (1 + sizeof(T))] == format);
+				CHECK(fromBigEndian<T>(&expected[i * (1 + sizeof(T)) + 1]) == value[i]);
+			}
+
+			std::vector<uint8_t> data(length + 1, 0xee);
+			packColumn_(format, value.data(), count, data.data());
+			CHECK(data == expected);
+
+#if defined(__x86_64__) || defined(__i386__)
+			if(__builtin_cpu_supports("ssse3"))
+			{
+				std::ranges::fill(data, 0xee);
+				packColumnSsse3_(format, value.data(), count, data.data());
+				CHECK(data == expected);
+			}
+
+			if(__builtin_cpu_supports("avx2"))
+			{
+				std::ranges::fill(data, 0xee);
+				packColumnAvx2_(format, value.data(), count, data.data());
+				CHECK(data == expected);
+			}
+#endif
+		}
+	};
+
+	check((uint8_t)Format::Float32, (const float*)nullptr);
+	check((uint8_t)Format::Float64, (const double*)nullptr);
+	check((uint8_t)Format::Int32,   (const int32_t*)nullptr);
+	check((uint8_t)Format::Int64,   (const int64_t*)nullptr);
+}
+
+TEST_CASE("packer/array/float")
+{
+	for(const size_t count : {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 64, 65, 100, 65'536})
+	{
+		std::vector<float>  f(count);
+		std::vector<double> d(count);
+		for(size_t i = 0; i < count; i++)
+		{
+			f[i] = float(i) * -0.75f;
+			d[i] = double(i) / 3.0;
+		}
+
+		Array array_f;
+		Array array_d;
+		for(size_t i = 0; i < count; i++)
+		{
+			array_f.append(f[i]);
+			array_d.append(d[i]);
+		}
+
+		std::vector<uint8_t> data;
+		Packer packer(data);
+
+		CHECK(packer.packArray(f) == Error_None);
+		CHECK(packer.size() == data.size());
+		CHECK(data == serialize(array_f));
+
+		data.clear();
+		Packer packer_d(data);
+
+		CHECK(packer_d.packArray(d) == Error_None);
+		CHECK(data == serialize(array_d));
+
+		Object object = deserialize(data);
+		CHECK(object.isArray());
+		CHECK(object.asArray().size() == count);
+		for(size_t i = 0; i < count; i++)
+		{
+			CHECK(object.asArray().object(i).as<double>() == d[i]);
+		}
+	}
+}
+
+TEST_CASE("packer/array/int")
+{
+	const std::vector<int32_t> i32 =
+	{	0
+	,	1
+	,	-1
+	,	127
+	,	std::numeric_limits<int32_t>::min()
+	,	std::numeric_limits<int32_t>::max()
+	};
+	const std::vector<int64_t> i64 =
+	{	0
+	,	-2
+	,	std::numeric_limits<int64_t>::min()
+	,	std::numeric_limits<int64_t>::max()
+	};
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	CHECK(packer.packArray(i32) == Error_None);
+	CHECK(data.size() == 1 + (i32.size() * 5));
+	CHECK(data[1] == (uint8_t)Format::Int32);
+	CHECK(data[6] == (uint8_t)Format::Int32);
+
+	size_t index = 0;
+	Object object = deserialize(data, index);
+	CHECK(index == data.size());
+	CHECK(object.isArray());
+	CHECK(object.asArray().size() == i32.size());
+	for(size_t i = 0; i < i32.size(); i++)
+	{
+		CHECK(object.asArray().object(i).as<int64_t>() == i32[i]);
+	}
+
+	data.clear();
+	Packer packer_64(data);
+
+	CHECK(packer_64.packArray(i64) == Error_None);
+	CHECK(data.size() == 1 + (i64.size() * 9));
+	CHECK(data[1] == (uint8_t)Format::Int64);
+
+	object = deserialize(data);
+	CHECK(object.isArray());
+	CHECK(object.asArray().size() == i64.size());
+	for(size_t i = 0; i < i64.size(); i++)
+	{
+		CHECK(object.asArray().object(i).as<int64_t>() == i64[i]);
+	}
+}
+
+TEST_CASE("packer/array/sink")
+{
+	std::vector<double> value(1'000);
+	for(size_t i = 0; i < value.size(); i++)
+	{
+		value[i] = double(i) * 1.5;
+	}
+
+	std::vector<uint8_t> expected;
+	Packer vector_packer(expected);
+	vector_packer.packNull();
+	vector_packer.packArray(value);
+
+	for(const size_t buffer_size : {16, 17, 100, 4'096})
+	{
+		std::vector<uint8_t> data;
+		size_t               call_count = 0;
+
+		Packer packer([&](std::span<const uint8_t> part)
+			{
+				CHECK(part.size() <= buffer_size);
+				data.insert(data.end(), part.begin(), part.end());
+				call_count++;
+			}
+			, buffer_size
+			);
+
+		packer.packNull();
+		CHECK(packer.packArray(value) == Error_None);
+		packer.flush();
+
+		CHECK(call_count > 1);
+		CHECK(packer.size() == expected.size());
+		CHECK(data == expected);
+	}
+}
+
+TEST_CASE("packer/array/span")
+{
+	const std::vector<float> value(100, 1.0f);
+	const size_t             size  = 3 + (value.size() * 5);
+
+	std::vector<uint8_t> buffer(size);
+
+	Packer packer(std::span<uint8_t>{buffer});
+	CHECK(packer.packArray(value) == Error_None);
+	CHECK(packer.size() == size);
+	CHECK(deserialize(buffer).asArray().size() == value.size());
+
+	Packer small(std::span<uint8_t>{buffer.data(), size - 1});
+	CHECK(small.packArray(value) == Error_Buffer_Too_Small);
+	CHECK(small.packFloat(1.0f) == Error_Buffer_Too_Small);
+
+	Packer header(std::span<uint8_t>{buffer.data(), 2});
+	CHECK(header.packArray(value) == Error_Buffer_Too_Small);
+}
+
+TEST_CASE("packer/array/runs")
+{
+	Array array;
+	std::vector<uint8_t> expected;
+	Packer packer(expected);
+
+	packer.packArrayHeader(300);
+	for(size_t i = 0; i < 300; i++)
+	{
+		if(i % 100 < 70)
+		{
+			array.append(float(i));
+			packer.packFloat(float(i));
+		}
+		else if(i % 100 < 95)
+		{
+			array.append(double(i));
+			packer.packDouble(double(i));
+		}
+		else
+		{
+			array.append(int64_t(i));
+			packer.packInt(int64_t(i));
+		}
+	}
+
+	CHECK(serialize(array) == expected);
+
+	std::vector<uint8_t> data;
+	Packer sink([&](std::span<const uint8_t> part)
+		{
+			data.insert(data.end(), part.begin(), part.end());
+		}
+		, 64
+		);
+
+	CHECK(sink.pack(array) == Error_None);
+	sink.flush();
+	CHECK(data == expected);
+}
+
+TEST_CASE("packer/object")
+{
+	Map map;
+	map.set(Object{}, Object{"null"});
+	map.set(Object{false}, Object{int64_t(-1)});
+	map.set(Object{int64_t(-2)}, Object{uint64_t(2)});
+	map.set(Object{uint64_t(3)}, Object{float(3)});
+	map.set(Object{float(4)}, Object{double(4)});
+	map.set(Object{double(5)}, Object{std::pmr::vector<uint8_t>(5, '5')});
+	map.set(Object{"six"}, Object{Array{}});
+
+	Ext ext;
+	ext.type = 7;
+	ext.data = std::pmr::vector<uint8_t>(7, '7');
+
+	Object object = {Array{}};
+	Array& array = object.asArray();
+	array.append(map);
+	array.append(ext);
+	array.append(std::string_view("eight"));
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	CHECK(packer.pack(object) == Error_None);
+	CHECK(data == serialize(object));
+}
+
+TEST_CASE("packer/vector/append")
+{
+	std::vector<uint8_t> data = {'a', 'b'};
+	Packer packer(data);
+
+	packer.packStr("c");
+
+	CHECK(packer.size() == 2);
+	CHECK(data.size() == 4);
+	CHECK(data[0] == 'a');
+	CHECK(data[1] == 'b');
+	CHECK(data[2] == ((uint8_t)Format::Fixed_Str | 1));
+	CHECK(data[3] == 'c');
+}
+
+TEST_CASE("packer/span")
+{
+	uint8_t buffer[8] = {};
+
+	SUBCASE("fits")
+	{
+		Packer packer(buffer);
+
+		CHECK(packer.packArrayHeader(2) == Error_None);
+		CHECK(packer.packInt(-1)         == Error_None);
+		CHECK(packer.packStr("abc")      == Error_None);
+		CHECK(packer.size() == 6);
+
+		Object object = deserialize(std::vector<uint8_t>(buffer, buffer + 6));
+		CHECK(object.isArray());
+		CHECK(object.asArray()[0].as<int64_t>() == -1);
+		CHECK(object.asArray()[1].asString()    == "abc");
+	}
+
+	SUBCASE("exact")
+	{
+		Packer packer(buffer);
+
+		CHECK(packer.packDouble(1.0) == Error_Buffer_Too_Small);
+
+		Packer packer_float(std::span<uint8_t>(buffer).first(5));
+		CHECK(packer_float.packFloat(1.0f) == Error_None);
+		CHECK(packer_float.size() == 5);
+	}
+
+	SUBCASE("overflow")
+	{
+		Packer packer(buffer);
+
+		CHECK(packer.packStr("abcdef") == Error_None);
+		CHECK(packer.size() == 7);
+		CHECK(packer.packStr("gh") == Error_Buffer_Too_Small);
+		CHECK(packer.error() == Error_Buffer_Too_Small);
+
+		// The header was written but not the string
+		CHECK(packer.size() == 8);
+
+		// Errors are sticky
+		CHECK(packer.packNull() == Error_Buffer_Too_Small);
+		CHECK(packer.size() == 8);
+	}
+}
+
+TEST_CASE("packer/sink")
+{
+	const std::string          string(100, 's');
+	const std::vector<uint8_t> binary(1000, 'b');
+
+	Array array;
+	array.append(string);
+	array.append(binary);
+
+	for(size_t i = 0; i < 100; i++)
+	{
+		array.append(int64_t(i) * 1'000);
+	}
+
+	const std::vector<uint8_t> expected = serialize(array);
+
+	std::vector<uint8_t> data;
+	size_t               call_count = 0;
+
+	{
+		Packer packer([&](std::span<const uint8_t> span)
+		{
+			data.insert(data.end(), span.begin(), span.end());
+			call_count++;
+		}
+		, 64
+		);
+
+		CHECK(packer.pack(array) == Error_None);
+		CHECK(packer.size() == expected.size());
+	}
+
+	CHECK(call_count > 1);
+	CHECK(data == expected);
+
+	data.clear();
+
+	Packer packer([&](std::span<const uint8_t> span)
+	{
+		data.insert(data.end(), span.begin(), span.end());
+	});
+
+	packer.packBool(true);
+	CHECK(data.empty());
+
+	packer.flush();
+	CHECK(data.size() == 1);
+	CHECK(data[0] == (uint8_t)Format::True);
+}
+#endif // }}}
+
+// }}} Packer
+// {{{ ObjectView
+
+/**
+ * \struct ExtView
+ *
+ * \brief A view of Extension data.
+ *
+ * The same as an Ext, except that the `data` refers to the packed data 
+ * instead of being a copy.
+ */
+
+
+/**
+ * \var zakero::messagepack::ExtView::data
+ *
+ * \brief The Extension data.
+ */
+
+
+/**
+ * \var zakero::messagepack::ExtView::type
+ *
+ * \brief The Extension type.
+ */
+
+
+/**
+ * \class ObjectView
+ *
+ * \brief A read-only view of packed data.
+ *
+ * Using deserialize() creates an Object that is a copy of the packed data, 
+ * including all strings and binary data. An ObjectView does not copy 
+ * anything, instead it refers to the packed data. Only the header of the 
+ * Object is decoded when the ObjectView is created. The contents of Arrays 
+ * and Maps are decoded only when they are accessed.
+ *
+ * Strings are available as a `std::string_view` and binary data is 
+ * available as a `std::span`, both of which point into the packed data.
+ *
+ * \parcode
+ * std::vector<uint8_t> data = load_data();
+ *
+ * zakero::messagepack::ObjectView view(data);
+ *
+ * if(view.isMap())
+ * {
+ * 	zakero::messagepack::MapView map = view.asMap();
+ *
+ * 	std::string_view         name  = map["name"].asString();
+ * 	std::span<const uint8_t> image = map["image"].asBinary();
+ * }
+ * \endparcode
+ *
+ * Any contiguous range of bytes can be used, such as a `std::vector`, 
+ * `std::array`, `std::string`, or a `std::span`.
+ *
+ * If the ObjectView is not the type being requested, the `as` methods will 
+ * return an empty value such as `0`, `false`, or an empty view.
+ *
+ * \note The packed data must exist for as long as the ObjectView, and any 
+ * view that is created from it, is in use.
+ */
+
+
+/**
+ * \fn ObjectView::ObjectView()
+ *
+ * \brief Constructor.
+ *
+ * The ObjectView will not be valid.
+ */
+
+
+/**
+ * \fn ObjectView::ObjectView(const Range&)
+ *
+ * \brief Constructor.
+ *
+ * Create a view of the first Object in the \p range. The \p range can be 
+ * any contiguous range of bytes.
+ *
+ * \tparam Range The type of the byte range.
+ */
+
+
+/**
+ * \brief Constructor.
+ *
+ * Create a view of the first Object in the \p data. Only the header of 
+ * the Object is checked, use ObjectView(const std::span<const uint8_t>, 
+ * size_t&, std::error_code&) to check the entire Object.
+ *
+ * If the header can not be decoded, the ObjectView will not be valid.
+ *
+ * \parcode
+ * zakero::messagepack::ObjectView view(std::span(buffer, length));
+ * \endparcode
+ */
+ObjectView::ObjectView(const std::span<const uint8_t> data ///< The packed data
+	) noexcept
+{
+	size_t  index = 0;
+	Header_ header;
+
+	if(readHeader_(data, index, header))
+	{
+		return;
+	}
+
+	data_     = data;
+	value_    = header.value;
+	offset_   = index;
+	type_     = (uint8_t)header.type;
+	ext_type_ = header.ext_type;
+}
+
+
+/**
+ * \brief Constructor.
+ *
+ * Create a view of the Object that is at the \p index of the \p data. The 
+ * entire Object, including the contents of Arrays and Maps, will be 
+ * checked but nothing will be decoded.
+ *
+ * If there are no errors, the \p index will be moved to the byte after the 
+ * Object. This makes it possible to view a sequence of Objects.
+ *
+ * \parcode
+ * size_t          index = 0;
+ * std::error_code error;
+ *
+ * while(index < data.size())
+ * {
+ * 	zakero::messagepack::ObjectView view(data, index, error);
+ *
+ * 	if(error)
+ * 	{
+ * 		break;
+ * 	}
+ *
+ * 	process(view);
+ * }
+ * \endparcode
+ */
+ObjectView::ObjectView(const std::span<const uint8_t> data  ///< The packed data
+	, size_t&                                     index ///< The location of the Object
+	, std::error_code&                            error ///< The error code
+	) noexcept
+{
+	const size_t start = index;
+
+	error = skip_(data, index);
+
+	if(error)
+	{
+		index = start;
+
+		return;
+	}
+
+	*this = ObjectView(data.subspan(start, index - start));
+}
+
+
+/**
+ * \brief Get an Array.
+ *
+ * \return The Array.
+ */
+ArrayView ObjectView::asArray() const noexcept
+{
+	if(isArray() == false)
+	{
+		return {};
+	}
+
+	return ArrayView(data_.subspan(offset_), value_);
+}
+
+
+/**
+ * \brief Get binary data.
+ *
+ * \return The binary data.
+ */
+std::span<const uint8_t> ObjectView::asBinary() const noexcept
+{
+	if(isBinary() == false)
+	{
+		return {};
+	}
+
+	return data_.subspan(offset_, value_);
+}
+
+
+/**
+ * \brief Get a boolean value.
+ *
+ * \return The value.
+ */
+bool ObjectView::asBool() const noexcept
+{
+	return isBool() && (value_ != 0);
+}
+
+
+/**
+ * \brief Get a 64-bit floating point value.
+ *
+ * \return The value.
+ */
+double ObjectView::asDouble() const noexcept
+{
+	if(isDouble() == false)
+	{
+		return 0;
+	}
+
+	return std::bit_cast<double>(value_);
+}
+
+
+/**
+ * \brief Get Extension data.
+ *
+ * \return The Extension data.
+ */
+ExtView ObjectView::asExt() const noexcept
+{
+	if(isExt() == false)
+	{
+		return {};
+	}
+
+	return ExtView{data_.subspan(offset_, value_), ext_type_};
+}
+
+
+/**
+ * \brief Get a 32-bit floating point value.
+ *
+ * \return The value.
+ */
+float ObjectView::asFloat() const noexcept
+{
+	if(isFloat() == false)
+	{
+		return 0;
+	}
+
+	return std::bit_cast<float>((uint32_t)value_);
+}
+
+
+/**
+ * \brief Get a signed integer value.
+ *
+ * \return The value.
+ */
+int64_t ObjectView::asInt() const noexcept
+{
+	if(isInt() == false)
+	{
+		return 0;
+	}
+
+	return (int64_t)value_;
+}
+
+
+/**
+ * \brief Get a Map.
+ *
+ * \return The Map.
+ */
+MapView ObjectView::asMap() const noexcept
+{
+	if(isMap() == false)
+	{
+		return {};
+	}
+
+	return MapView(data_.subspan(offset_), value_);
+}
+
+
+/**
+ * \brief Get a string.
+ *
+ * \return The string.
+ */
+std::string_view ObjectView::asString() const noexcept
+{
+	if(isString() == false)
+	{
+		return {};
+	}
+
+	return std::string_view((const char*)data_.data() + offset_, value_);
+}
+
+
+/**
+ * \brief Get an unsigned integer value.
+ *
+ * \return The value.
+ */
+uint64_t ObjectView::asUint() const noexcept
+{
+	if(isUint() == false)
+	{
+		return 0;
+	}
+
+	return value_;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is an Array.
+ * \retval false The ObjectView is not an Array.
+ */
+bool ObjectView::isArray() const noexcept
+{
+	return type_ == (uint8_t)Type_::Array;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is binary data.
+ * \retval false The ObjectView is not binary data.
+ */
+bool ObjectView::isBinary() const noexcept
+{
+	return type_ == (uint8_t)Type_::Binary;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is a boolean.
+ * \retval false The ObjectView is not a boolean.
+ */
+bool ObjectView::isBool() const noexcept
+{
+	return type_ == (uint8_t)Type_::Bool;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is a 64-bit floating point value.
+ * \retval false The ObjectView is not a 64-bit floating point value.
+ */
+bool ObjectView::isDouble() const noexcept
+{
+	return type_ == (uint8_t)Type_::Double;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is an Extension.
+ * \retval false The ObjectView is not an Extension.
+ */
+bool ObjectView::isExt() const noexcept
+{
+	return type_ == (uint8_t)Type_::Ext;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is a 32-bit floating point value.
+ * \retval false The ObjectView is not a 32-bit floating point value.
+ */
+bool ObjectView::isFloat() const noexcept
+{
+	return type_ == (uint8_t)Type_::Float;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is a signed integer.
+ * \retval false The ObjectView is not a signed integer.
+ */
+bool ObjectView::isInt() const noexcept
+{
+	return type_ == (uint8_t)Type_::Int;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is a Map.
+ * \retval false The ObjectView is not a Map.
+ */
+bool ObjectView::isMap() const noexcept
+{
+	return type_ == (uint8_t)Type_::Map;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is a Null.
+ * \retval false The ObjectView is not a Null.
+ */
+bool ObjectView::isNull() const noexcept
+{
+	return type_ == (uint8_t)Type_::Null;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is a string.
+ * \retval false The ObjectView is not a string.
+ */
+bool ObjectView::isString() const noexcept
+{
+	return type_ == (uint8_t)Type_::String;
+}
+
+
+/**
+ * \brief Check the type.
+ *
+ * \retval true  The ObjectView is an unsigned integer.
+ * \retval false The ObjectView is not an unsigned integer.
+ */
+bool ObjectView::isUint() const noexcept
+{
+	return type_ == (uint8_t)Type_::Uint;
+}
+
+
+/**
+ * \brief Check the ObjectView.
+ *
+ * An ObjectView is not valid if it was default constructed, if the header 
+ * could not be decoded, or if a requested Map key was not found.
+ *
+ * \retval true  The ObjectView can be used.
+ * \retval false The ObjectView is empty.
+ */
+bool ObjectView::isValid() const noexcept
+{
+	return type_ != (uint8_t)Type_::Invalid;
+}
+
+
+/**
+ * \brief The packed data.
+ *
+ * All the bytes of the Object, including the contents of Arrays and Maps. 
+ * This can be given to deserialize() to create an Object.
+ *
+ * \return The packed data.  If the data is not valid, the span will be 
+ * empty.
+ */
+std::span<const uint8_t> ObjectView::data() const noexcept
+{
+	size_t index = 0;
+
+	if(skip_(data_, index))
+	{
+		return {};
+	}
+
+	return data_.first(index);
+}
+
+// }}} ObjectView
+// {{{ ArrayView
+
+/**
+ * \class ArrayView
+ *
+ * \brief A read-only view of a packed Array.
+ *
+ * The elements of the Array are only decoded when they are accessed. 
+ * Iterating over the ArrayView is the fastest way to access all the 
+ * elements.
+ *
+ * \parcode
+ * for(const zakero::messagepack::ObjectView view : object_view.asArray())
+ * {
+ * 	sum += view.asInt();
+ * }
+ * \endparcode
+ *
+ * \note To find an element, all the elements before it must be skipped. 
+ * Using object() in a loop is slow, use the iterator instead.
+ */
+
+
+/**
+ * \class ArrayView::Iterator
+ *
+ * \brief Access the elements of an ArrayView.
+ */
+
+
+/**
+ * \brief Constructor.
+ */
+ArrayView::Iterator::Iterator(const std::span<const uint8_t> data      ///< The packed data
+	, const size_t                                       remaining ///< The number of elements
+	) noexcept
+	: data_(data)
+	, remaining_(remaining)
+{
+	check_();
+}
+
+
+/**
+ * \brief Check the current element.
+ *
+ * If the current element can not be decoded, the Iterator will become the 
+ * end Iterator.
+ */
+void ArrayView::Iterator::check_() noexcept
+{
+	if(remaining_ == 0)
+	{
+		return;
+	}
+
+	size_t  index = index_;
+	Header_ header;
+
+	if(readHeader_(data_, index, header))
+	{
+		remaining_ = 0;
+	}
+}
+
+
+/**
+ * \brief Move to the next element.
+ *
+ * If the data is invalid, the Iterator will become the end Iterator.
+ *
+ * \return The Iterator.
+ */
+ArrayView::Iterator& ArrayView::Iterator::operator++() noexcept
+{
+	if(remaining_ == 0)
+	{
+		return *this;
+	}
+
+	remaining_--;
+
+	if(skip_(data_, index_))
+	{
+		remaining_ = 0;
+	}
+
+	check_();
+
+	return *this;
+}
+
+
+/**
+ * \brief Access an element.
+ *
+ * \return The element. If the \p index is out of range, the ObjectView 
+ * will not be valid.
+ */
+ObjectView ArrayView::object(const size_t index ///< The element index
+	) const noexcept
+{
+	if(index >= size_)
+	{
+		return {};
+	}
+
+	size_t offset = 0;
+
+	for(size_t i = 0; i < index; i++)
+	{
+		if(skip_(data_, offset))
+		{
+			return {};
+		}
+	}
+
+	return ObjectView(data_.subspan(offset));
+}
+
+// }}} ArrayView
+// {{{ ArrayIndex
+
+/**
+ * \class ArrayIndex
+ *
+ * \brief Random access to the elements of a packed Array.
+ *
+ * Finding an element of an ArrayView means skipping all the elements before 
+ * it, and deserialize() decodes all of them. The ArrayIndex walks the packed 
+ * Array once and records where each element starts. After that, any element 
+ * can be found in O(1) and only that element is decoded.
+ *
+ * \parcode
+ * zakero::messagepack::ArrayIndex index;
+ *
+ * if(index.build(payload))
+ * {
+ * 	return;
+ * }
+ *
+ * zakero::messagepack::Object object = index.at(1'000'000);
+ * \endparcode
+ *
+ * Building the index checks the entire Array. The index can be saved with 
+ * save() and stored next to the packed data. Using load() is much faster 
+ * than build() because the elements are not walked again.
+ *
+ * \parcode
+ * std::vector<uint8_t> index_data = index.save();
+ * writeFile("payload.index", index_data);
+ *
+ * // Later
+ * zakero::messagepack::ArrayIndex index;
+ * index.load(payload, readFile("payload.index"));
+ * \endparcode
+ *
+ * \note The packed data must exist for as long as the ArrayIndex is in use.
+ */
+
+
+/**
+ * \brief Build the index.
+ *
+ * The \p data must start with a packed Array. All the elements will be 
+ * checked and the location of each element will be stored. Nothing is 
+ * decoded.
+ *
+ * \retval Error_Invalid_Format_Type The \p data is not an Array.
+ *
+ * \return An error code.
+ */
+std::error_code ArrayIndex::build(const std::span<const uint8_t> data ///< The packed data
+	) noexcept
+{
+	data_ = {};
+	offset_vector_.clear();
+
+	size_t  index = 0;
+	Header_ header;
+
+	std::error_code error = readHeader_(data, index, header);
+
+	if(error)
+	{
+		return error;
+	}
+
+	if(header.type != Type_::Array)
+	{
+		return Error_Invalid_Format_Type;
+	}
+
+	if(header.value > (data.size() - index))
+	{
+		return Error_Incomplete;
+	}
+
+	std::vector<uint64_t> offset_vector(header.value + 1);
+
+	for(size_t i = 0; i < header.value; i++)
+	{
+		offset_vector[i] = index;
+
+		error = skip_(data, index);
+
+		if(error)
+		{
+			return error;
+		}
+	}
+
+	offset_vector[header.value] = index;
+
+	data_          = data;
+	offset_vector_ = std::move(offset_vector);
+
+	return Error_None;
+}
+
+
+/**
+ * \brief Load a saved index.
+ *
+ * Use the \p index_data that was created by save() as the index of the \p 
+ * data. The \p index_data is checked to match the \p data, but the 
+ * elements are not checked until they are used.
+ *
+ * \retval Error_Invalid_Format_Type The \p index_data is not an index.
+ * \retval Error_Invalid_Index       The \p index_data is not for the \p data.
+ *
+ * \return An error code.
+ */
+std::error_code ArrayIndex::load(const std::span<const uint8_t> data ///< The packed data
+	, const std::span<const uint8_t>                        index_data ///< The saved index
+	) noexcept
+{
+	data_ = {};
+	offset_vector_.clear();
+
+	Reader reader(index_data);
+
+	using Token = Reader::Token;
+
+	if(reader.next() != Token::Array_Begin || reader.size() != 3
+		|| reader.next() != Token::Uint
+		)
+	{
+		return (reader.error()) ? reader.error() : Error_Invalid_Format_Type;
+	}
+
+	const uint64_t data_size = reader.asUint();
+
+	if(reader.next() != Token::Uint)
+	{
+		return (reader.error()) ? reader.error() : Error_Invalid_Format_Type;
+	}
+
+	const uint64_t count = reader.asUint();
+
+	if(reader.next() != Token::Bin)
+	{
+		return (reader.error()) ? reader.error() : Error_Invalid_Format_Type;
+	}
+
+	const std::span<const uint8_t> offset_data = reader.asBinary();
+
+	if(count >= offset_data.size() || offset_data.size() != (count + 1) * sizeof(uint64_t))
+	{
+		return Error_Invalid_Format_Type;
+	}
+
+	if(data_size != data.size())
+	{
+		return Error_Invalid_Index;
+	}
+
+	std::vector<uint64_t> offset_vector(count + 1);
+
+	uint64_t previous = 0;
+
+	for(size_t i = 0; i <= count; i++)
+	{
+		const uint64_t offset = fromBigEndian<uint64_t>(offset_data.data() + (i * sizeof(uint64_t)));
+
+		if(offset < previous || offset > data.size())
+		{
+			return Error_Invalid_Index;
+		}
+
+		offset_vector[i] = offset;
+		previous         = offset;
+	}
+
+	data_          = data;
+	offset_vector_ = std::move(offset_vector);
+
+	return Error_None;
+}
+
+
+/**
+ * \brief Save the index.
+ *
+ * The index is packed as an Array of the size of the packed data, the 
+ * number of elements, and the location of the elements as Binary data. Use 
+ * load() to use the index again.
+ *
+ * \return The packed index.
+ */
+std::vector<uint8_t> ArrayIndex::save() const noexcept
+{
+	std::vector<uint8_t> offset_data(offset_vector_.size() * sizeof(uint64_t));
+
+	for(size_t i = 0; i < offset_vector_.size(); i++)
+	{
+		toBigEndian(offset_vector_[i], offset_data.data() + (i * sizeof(uint64_t)));
+	}
+
+	std::vector<uint8_t> vector;
+	Packer packer(vector);
+
+	packer.packArrayHeader(3);
+	packer.packUint(data_.size());
+	packer.packUint(size());
+	packer.packBin(offset_data);
+
+	return vector;
+}
+
+
+/**
+ * \brief Decode an element.
+ *
+ * Only the element at the \p index is decoded.
+ *
+ * \return The element or a Null Object if the \p index is out of range or 
+ * the element could not be decoded.
+ */
+Object ArrayIndex::at(const size_t index ///< The element index
+	) const noexcept
+{
+	std::error_code error;
+
+	return at(index, error);
+}
+
+
+/**
+ * \brief Decode an element.
+ *
+ * Only the element at the \p index is decoded. Memory is allocated from the 
+ * \p resource, see deserialize().
+ *
+ * \retval Error_Invalid_Index The \p index is out of range.
+ *
+ * \return The element or a Null Object if there was an error.
+ */
+Object ArrayIndex::at(const size_t index    ///< The element index
+	, std::error_code&             error    ///< The error code
+	, std::pmr::memory_resource*   resource ///< The memory resource
+	) const noexcept
+{
+	if(index >= size())
+	{
+		error = Error_Invalid_Index;
+
+		return {};
+	}
+
+	size_t offset = 0;
+
+	return deserialize(element(index), offset, error, resource);
+}
+
+
+/**
+ * \brief Access the packed data of an element.
+ *
+ * \return The packed data or an empty span if the \p index is out of 
+ * range.
+ */
+std::span<const uint8_t> ArrayIndex::element(const size_t index ///< The element index
+	) const noexcept
+{
+	if(index >= size())
+	{
+		return {};
+	}
+
+	return data_.subspan(offset_vector_[index], offset_vector_[index + 1] - offset_vector_[index]);
+}
+
+
+/**
+ * \fn ArrayIndex::size()
+ *
+ * \brief The number of elements.
+ *
+ * \return The number of elements.
+ */
+
+
+/**
+ * \fn ArrayIndex::operator[](const size_t)
+ *
+ * \brief View an element.
+ *
+ * \return The element. If the \p index is out of range, the ObjectView 
+ * will not be valid.
+ */
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("arrayindex")
+{
+	Array array;
+
+	for(size_t i = 0; i < 70'000; i++)
+	{
+		switch(i % 4)
+		{
+			case 0:
+				array.append(int64_t(i) * -3);
+				break;
+
+			case 1:
+				array.append(std::string_view(std::string(i % 50, 'a')));
+				break;
+
+			case 2:
+				array.append(std::span<const uint8_t>(std::vector<uint8_t>(i % 300, 'b')));
+				break;
+
+			case 3:
+			{
+				Array inner;
+				inner.append(uint64_t(i));
+				array.append(inner);
+				break;
+			}
+		}
+	}
+
+	const std::vector<uint8_t> data = serialize(array);
+
+	ArrayIndex index;
+
+	CHECK(index.size() == 0);
+	CHECK(index.build(data) == Error_None);
+	CHECK(index.size() == array.size());
+
+	for(size_t i = 0; i < array.size(); i += 997)
+	{
+		CHECK(index.at(i) == array[i]);
+		CHECK(std::ranges::equal(index.element(i), serialize(array[i])));
+	}
+
+	CHECK(index[0].asInt() == 0);
+	CHECK(index[3].asArray()[0].asUint() == 3);
+	CHECK(index.at(array.size() - 1) == array[array.size() - 1]);
+
+	std::error_code error;
+	CHECK(index.at(array.size(), error).isNull());
+	CHECK(error == Error_Invalid_Index);
+	CHECK(index.element(array.size()).empty());
+	CHECK(index[array.size()].isValid() == false);
+
+	// Save and load
+
+	const std::vector<uint8_t> index_data = index.save();
+
+	ArrayIndex loaded;
+
+	CHECK(loaded.load(data, index_data) == Error_None);
+	CHECK(loaded.size() == index.size());
+
+	for(size_t i = 0; i < array.size(); i += 991)
+	{
+		CHECK(loaded.element(i).data() == index.element(i).data());
+		CHECK(loaded.element(i).size() == index.element(i).size());
+	}
+
+	CHECK(loaded.at(12'345) == array[12'345]);
+	CHECK(loaded.save() == index_data);
+}
+
+TEST_CASE("arrayindex/error")
+{
+	ArrayIndex index;
+
+	CHECK(index.build(std::span<const uint8_t>{}) == Error_No_Data);
+	CHECK(index.build(serialize(Object{"string"})) == Error_Invalid_Format_Type);
+
+	Array array;
+	array.append(std::string_view("hello"));
+	array.append(int64_t(1));
+
+	std::vector<uint8_t> data = serialize(array);
+
+	std::vector<uint8_t> truncated = data;
+	truncated.pop_back();
+
+	CHECK(index.build(truncated) != Error_None);
+	CHECK(index.size() == 0);
+
+	const std::vector<uint8_t> header = { (uint8_t)Format::Array32, 0xff, 0xff, 0xff, 0xff };
+	CHECK(index.build(header) == Error_Incomplete);
+
+	// Loading
+
+	REQUIRE(index.build(data) == Error_None);
+
+	const std::vector<uint8_t> index_data = index.save();
+
+	ArrayIndex loaded;
+
+	CHECK(loaded.load(data, serialize(Object{"index"})) == Error_Invalid_Format_Type);
+	CHECK(loaded.load(truncated, index_data) == Error_Invalid_Index);
+	CHECK(loaded.load(data, std::span(index_data).first(index_data.size() - 1)) != Error_None);
+
+	std::vector<uint8_t> bad_offset = index_data;
+	bad_offset[bad_offset.size() - 1] = 0xff;
+	CHECK(loaded.load(data, bad_offset) == Error_Invalid_Index);
+	CHECK(loaded.size() == 0);
+
+	CHECK(loaded.load(data, index_data) == Error_None);
+	CHECK(loaded.size() == 2);
+}
+#endif // }}}
+
+// }}} ArrayIndex
+// {{{ MapView
+
+/**
+ * \class MapView
+ *
+ * \brief A read-only view of a packed Map.
+ *
+ * The keys and values of the Map are only decoded when they are accessed. 
+ * Keys are searched for in the order that they were packed.
+ *
+ * \parcode
+ * zakero::messagepack::MapView map = object_view.asMap();
+ *
+ * for(const auto& [key, value] : map)
+ * {
+ * 	if(key.asString() == "id")
+ * 	{
+ * 		id = value.asUint();
+ * 	}
+ * }
+ *
+ * std::string_view name = map["name"].asString();
+ * \endparcode
+ */
+
+
+/**
+ * \class MapView::Iterator
+ *
+ * \brief Access the key/value pairs of a MapView.
+ */
+
+
+/**
+ * \brief Constructor.
+ */
+MapView::Iterator::Iterator(const std::span<const uint8_t> data      ///< The packed data
+	, const size_t                                     remaining ///< The number of pairs
+	) noexcept
+	: data_(data)
+	, remaining_(remaining)
+{
+	seek_();
+}
+
+
+/**
+ * \brief Find the value of the current key.
+ *
+ * If the data is invalid, the Iterator will become the end Iterator.
+ */
+void MapView::Iterator::seek_() noexcept
+{
+	if(remaining_ == 0)
+	{
+		return;
+	}
+
+	value_ = key_;
+
+	if(skip_(data_, value_))
+	{
+		remaining_ = 0;
+	}
+}
+
+
+/**
+ * \brief Move to the next key/value pair.
+ *
+ * If the data is invalid, the Iterator will become the end Iterator.
+ *
+ * \return The Iterator.
+ */
+MapView::Iterator& MapView::Iterator::operator++() noexcept
+{
+	if(remaining_ == 0)
+	{
+		return *this;
+	}
+
+	remaining_--;
+
+	key_ = value_;
+
+	if(skip_(data_, key_))
+	{
+		remaining_ = 0;
+	}
+
+	seek_();
+
+	return *this;
+}
+
+
+/**
+ * \brief Access a value.
+ *
+ * \return The value of the \p key. If the \p key was not found, the 
+ * ObjectView will not be valid.
+ */
+ObjectView MapView::at(const std::string_view key ///< The key
+	) const noexcept
+{
+	for(const auto& [key_view, value_view] : *this)
+	{
+		if(key_view.isString() && key_view.asString() == key)
+		{
+			return value_view;
+		}
+	}
+
+	return {};
+}
+
+
+/**
+ * \brief Access a value.
+ *
+ * Both signed and unsigned integer keys will be compared with the \p key.
+ *
+ * \return The value of the \p key. If the \p key was not found, the 
+ * ObjectView will not be valid.
+ */
+ObjectView MapView::at(const int64_t key ///< The key
+	) const noexcept
+{
+	for(const auto& [key_view, value_view] : *this)
+	{
+		if((key_view.isInt() && key_view.asInt() == key)
+			|| (key_view.isUint() && key >= 0 && key_view.asUint() == (uint64_t)key)
+			)
+		{
+			return value_view;
+		}
+	}
+
+	return {};
+}
+
+
+/**
+ * \brief Check if a key exists.
+ *
+ * \retval true  The \p key was found.
+ * \retval false The \p key was not found.
+ */
+bool MapView::keyExists(const std::string_view key ///< The key
+	) const noexcept
+{
+	return at(key).isValid();
+}
+
+
+/**
+ * \brief Check if a key exists.
+ *
+ * \retval true  The \p key was found.
+ * \retval false The \p key was not found.
+ */
+bool MapView::keyExists(const int64_t key ///< The key
+	) const noexcept
+{
+	return at(key).isValid();
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("view/scalar")
+{
+	const std::vector<Object> object_list =
+	{	Object{}
+	,	Object{true}
+	,	Object{false}
+	,	Object{int64_t(5)}
+	,	Object{int64_t(-5)}
+	,	Object{int64_t(-100)}
+	,	Object{std::numeric_limits<int64_t>::min()}
+	,	Object{uint64_t(5)}
+	,	Object{std::numeric_limits<uint64_t>::max()}
+	,	Object{float(1.5f)}
+	,	Object{double(-2.5)}
+	};
+
+	for(const Object& object : object_list)
+	{
+		const std::vector<uint8_t> data = serialize(object);
+
+		ObjectView view(data);
+
+		CHECK(view.isValid());
+		CHECK(view.isNull()   == object.isNull());
+		CHECK(view.isBool()   == object.is<bool>());
+		CHECK(view.isInt()    == object.is<int64_t>());
+		CHECK(view.isUint()   == object.is<uint64_t>());
+		CHECK(view.isFloat()  == object.is<float>());
+		CHECK(view.isDouble() == object.is<double>());
+		CHECK(view.isString() == false);
+
+		if(object.is<bool>())     { CHECK(view.asBool()   == object.as<bool>());     }
+		if(object.is<int64_t>())  { CHECK(view.asInt()    == object.as<int64_t>());  }
+		if(object.is<uint64_t>()) { CHECK(view.asUint()   == object.as<uint64_t>()); }
+		if(object.is<float>())    { CHECK(view.asFloat()  == object.as<float>());    }
+		if(object.is<double>())   { CHECK(view.asDouble() == object.as<double>());   }
+
+		CHECK(view.data().size() == data.size());
+	}
+
+	// Wrong type
+	ObjectView view(serialize(Object{int64_t(42)}));
+	CHECK(view.asUint()           == 0);
+	CHECK(view.asString().empty() == true);
+	CHECK(view.asArray().size()   == 0);
+}
+
+TEST_CASE("view/zero-copy")
+{
+	const std::string          string(300, 's');
+	const std::vector<uint8_t> binary(70'000, 'b');
+
+	Ext ext;
+	ext.type = 9;
+	ext.data = std::pmr::vector<uint8_t>(4, 'e');
+
+	Array array;
+	array.append(string);
+	array.append(binary);
+	array.append(ext);
+
+	const std::vector<uint8_t> data = serialize(array);
+	const uint8_t*             begin = data.data();
+	const uint8_t*             end   = data.data() + data.size();
+
+	ObjectView view(data);
+	REQUIRE(view.isArray());
+
+	ArrayView array_view = view.asArray();
+	CHECK(array_view.size() == 3);
+
+	std::string_view str = array_view[0].asString();
+	CHECK(str == string);
+	CHECK((const uint8_t*)str.data() >= begin);
+	CHECK((const uint8_t*)str.data() <  end);
+
+	std::span<const uint8_t> bin = array_view[1].asBinary();
+	CHECK(bin.size() == binary.size());
+	CHECK(bin.data() >= begin);
+	CHECK(bin.data() <  end);
+	CHECK(std::equal(bin.begin(), bin.end(), binary.begin()));
+
+	ExtView ext_view = array_view[2].asExt();
+	CHECK(ext_view.type        == 9);
+	CHECK(ext_view.data.size() == 4);
+	CHECK(ext_view.data[0]     == 'e');
+}
+
+TEST_CASE("view/array")
+{
+	Array inner;
+	inner.append(int64_t(-1));
+	inner.append(std::string_view("inner"));
+
+	Array array;
+	for(int64_t i = 0; i < 20; i++)
+	{
+		array.append(i);
+	}
+	array.append(inner);
+	array.append(int64_t(20));
+
+	const std::vector<uint8_t> data = serialize(array);
+
+	ArrayView view = ObjectView(data).asArray();
+	CHECK(view.size() == 22);
+
+	int64_t expected = 0;
+	size_t  count    = 0;
+
+	for(const ObjectView element : view)
+	{
+		if(element.isArray())
+		{
+			CHECK(element.asArray().size() == 2);
+			CHECK(element.asArray()[0].asInt() == -1);
+			CHECK(element.asArray()[1].asString() == "inner");
+		}
+		else
+		{
+			CHECK(element.asInt() == expected++);
+		}
+
+		count++;
+	}
+
+	CHECK(count == 22);
+	CHECK(view[21].asInt()   == 20);
+	CHECK(view[22].isValid() == false);
+}
+
+TEST_CASE("view/map")
+{
+	Map inner;
+	inner.set(Object{"x"}, Object{int64_t(1)});
+
+	Map map;
+	map["name"]        = Object{"zakero"};
+	map["inner"]       = Object{inner};
+	map[int64_t(-7)]   = Object{true};
+	map[uint64_t(8)]   = Object{false};
+
+	const std::vector<uint8_t> data = serialize(map);
+
+	MapView view = ObjectView(data).asMap();
+	CHECK(view.size() == 4);
+
+	CHECK(view["name"].asString()   == "zakero");
+	CHECK(view["inner"].asMap()["x"].asInt() == 1);
+	CHECK(view[-7].asBool()         == true);
+	CHECK(view[8].isBool()          == true);
+	CHECK(view.keyExists("name")    == true);
+	CHECK(view.keyExists("missing") == false);
+	CHECK(view.keyExists(9)         == false);
+	CHECK(view["missing"].isValid() == false);
+
+	size_t count = 0;
+	for(const auto& [key, value] : view)
+	{
+		CHECK(key.isValid());
+		CHECK(value.isValid());
+		count++;
+	}
+	CHECK(count == 4);
+}
+
+TEST_CASE("view/range")
+{
+	const std::vector<uint8_t> data = serialize(Object{"abc"});
+
+	const std::string string(data.begin(), data.end());
+	CHECK(ObjectView(string).asString() == "abc");
+
+	std::array<std::byte, 4> bytes;
+	memcpy(bytes.data(), data.data(), data.size());
+	CHECK(ObjectView(bytes).asString() == "abc");
+
+	CHECK(ObjectView(std::span<const uint8_t>(data)).asString() == "abc");
+}
+
+TEST_CASE("view/sequence")
+{
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	packer.packInt(1);
+	packer.packArrayHeader(2);
+	packer.packStr("a");
+	packer.packStr("b");
+	packer.packBool(true);
+
+	size_t          index = 0;
+	std::error_code error;
+
+	ObjectView view(data, index, error);
+	CHECK(error == Error_None);
+	CHECK(view.asInt() == 1);
+	CHECK(index == 1);
+
+	view = ObjectView(data, index, error);
+	CHECK(error == Error_None);
+	CHECK(view.asArray().size() == 2);
+	CHECK(view.data().size() == 5);
+	CHECK(index == 6);
+
+	view = ObjectView(data, index, error);
+	CHECK(error == Error_None);
+	CHECK(view.asBool() == true);
+	CHECK(index == data.size());
+
+	view = ObjectView(data, index, error);
+	CHECK(error == Error_Invalid_Index);
+	CHECK(view.isValid() == false);
+
+	// Incomplete data is found without decoding
+	data.pop_back();
+	data.pop_back();
+	index = 1;
+
+	view = ObjectView(data, index, error);
+	CHECK(error == Error_Incomplete);
+	CHECK(index == 1);
+	CHECK(view.isValid() == false);
+}
+
+TEST_CASE("view/invalid")
+{
+	ObjectView view;
+	CHECK(view.isValid() == false);
+	CHECK(view.isNull()  == false);
+
+	const std::vector<uint8_t> data = {(uint8_t)Format::Never_Used};
+	view = ObjectView(data);
+	CHECK(view.isValid() == false);
+
+	// Array claims more elements than available
+	const std::vector<uint8_t> array = {(uint8_t)Format::Fixed_Array | 3, 0x01};
+	ArrayView array_view = ObjectView(array).asArray();
+	CHECK(array_view.size() == 3);
+	CHECK(array_view[0].asInt() == 1);
+	CHECK(array_view[1].isValid() == false);
+
+	size_t count = 0;
+	for(const ObjectView element : array_view)
+	{
+		(void)element;
+		count++;
+	}
+	CHECK(count == 1);
+}
+#endif // }}}
+
+// }}} MapView
+// {{{ Query
+
+/**
+ * \class Query
+ *
+ * \brief Find an Object in packed data by its path.
+ *
+ * Getting one value that is deep in a large message with deserialize() 
+ * decodes the entire message. With the views, only the Arrays and Maps on 
+ * the way are looked at, but the path must be written as code. A Query is a 
+ * path that has been compiled once and can then be used to find the Object 
+ * in any number of messages.
+ *
+ * The path is a list of steps:
+ * | Step         | Array                          | Map                        |
+ * |--------------|--------------------------------|----------------------------|
+ * | `name`       | -                              | The String key `name`      |
+ * | `.name`      | -                              | The String key `name`      |
+ * | `[3]`        | The element at index `3`       | The Integer key `3`        |
+ * | `[-1]`       | The last element               | The Integer key `-1`       |
+ * | `["a.b"]`    | -                              | The String key `a.b`       |
+ *
+ * A name ends at the next `.` or `[`. In a quoted key, `\` uses the next 
+ * character as-is, so `["say \"hi\""]` is the key `say "hi"`. An empty path 
+ * finds the Object itself.
+ *
+ * \parcode
+ * const zakero::messagepack::Query query("route.hops[-1].host");
+ *
+ * for(const auto& message : message_list)
+ * {
+ * 	std::string_view host = query.find(message).asString();
+ * }
+ * \endparcode
+ *
+ * The packed data is walked with the same code as skip(): elements that are 
+ * not on the path are stepped over using only their headers and nothing is 
+ * decoded. String keys are compared directly with the packed bytes. Keys are 
+ * searched for in the order that they were packed.
+ *
+ * A Query does not change after it is compiled, so it can be used by many 
+ * threads at the same time.
+ */
+
+
+/**
+ * \fn Query::Query()
+ *
+ * \brief Constructor.
+ *
+ * The Query has no steps and will find the Object itself.
+ */
+
+
+/**
+ * \brief Constructor.
+ *
+ * The \p path is compiled. If it is not valid, error() will be 
+ * Error_Invalid_Path.
+ *
+ * \see compile()
+ */
+Query::Query(const std::string_view path ///< The path
+	) noexcept
+{
+	compile(path);
+}
+
+
+/**
+ * \brief Compile a path.
+ *
+ * The steps of the \p path replace the steps of the Query.
+ *
+ * \retval Error_None         The path was compiled.
+ * \retval Error_Invalid_Path The path is not valid. The Query will not 
+ *                            find anything until a valid path is compiled.
+ *
+ * \return An error code.
+ */
+std::error_code Query::compile(const std::string_view path ///< The path
+	) noexcept
+{
+	step_vector_.clear();
+	error_ = Error_None;
+
+	auto fail = [&]()
+	{
+		step_vector_.clear();
+		error_ = Error_Invalid_Path;
+
+		return error_;
+	};
+
+	const char* end        = path.data() + path.size();
+	size_t      index      = 0;
+	bool        name_start = true;
+
+	while(index < path.size())
+	{
+		switch(path[index])
+		{
+			case '[':
+				index++;
+				name_start = false;
+
+				if(index < path.size() && path[index] == '"')
+				{
+					std::string key;
+
+					for(index++; index < path.size() && path[index] != '"'; index++)
+					{
+						if(path[index] == '\\' && index + 1 < path.size())
+						{
+							index++;
+						}
+
+						key += path[index];
+					}
+
+					if(index + 1 >= path.size() || path[index + 1] != ']')
+					{
+						return fail();
+					}
+
+					index += 2;
+					step_vector_.push_back({std::move(key), 0, true});
+				}
+				else
+				{
+					int64_t value = 0;
+
+					const std::from_chars_result result = std::from_chars(path.data() + index, end, value);
+
+					if(result.ec != std::errc{} || result.ptr == end || *result.ptr != ']')
+					{
+						return fail();
+					}
+
+					index = (result.ptr - path.data()) + 1;
+					step_vector_.push_back({std::string{}, value, false});
+				}
+				break;
+
+			case '.':
+				index++;
+
+				if(index == path.size() || path[index] == '.' || path[index] == '[')
+				{
+					return fail();
+				}
+
+				name_start = true;
+				break;
+
+			default:
+			{
+				if(name_start == false)
+				{
+					return fail();
+				}
+
+				const size_t name_end = std::min(path.find_first_of(".[]", index), path.size());
+
+				if(name_end < path.size() && path[name_end] == ']')
+				{
+					return fail();
+				}
+
+				step_vector_.push_back({std::string(path.substr(index, name_end - index)), 0, true});
+				index      = name_end;
+				name_start = false;
+			}
+		}
+	}
+
+	return error_;
+}
+
+
+/**
+ * \fn Query::error()
+ *
+ * \brief The result of compiling the path.
+ *
+ * \return An error code.
+ */
+
+
+/**
+ * \brief Find an Object.
+ *
+ * The path is followed starting from the Object at the \p index of the 
+ * packed \p data. If the Object was found, the \p index will be moved to 
+ * it. Otherwise, the \p index is not changed.
+ *
+ * Only the headers of the Objects on the way to the found Object are 
+ * checked, use validate() first if the entire \p data must be valid.
+ *
+ * \retval Error_None                The Object was found.
+ * \retval Error_Invalid_Path        The path was not compiled.
+ * \retval Error_Path_Not_Found      A key or index is not in the data, or 
+ *                                   a step reached something that is not 
+ *                                   an Array or Map.
+ * \retval Error_No_Data             The \p data is empty.
+ * \retval Error_Invalid_Index       The \p index is not in the \p data.
+ * \retval Error_Incomplete          The data is not complete.
+ * \retval Error_Invalid_Format_Type An invalid Format ID was found.
+ *
+ * \return An error code.
+ */
+std::error_code Query::find(const std::span<const uint8_t> data  ///< The packed data
+	, size_t&                                          index ///< The location of the Object
+	) const noexcept
+{
+	if(error_)
+	{
+		return error_;
+	}
+
+	size_t position = index;
+
+	for(const Step_& step : step_vector_)
+	{
+		Header_ header;
+
+		std::error_code error = readHeader_(data, position, header);
+
+		if(error)
+		{
+			return error;
+		}
+
+		if(header.type == Type_::Array && step.is_key == false)
+		{
+			const int64_t count   = (int64_t)std::min<uint64_t>(header.value, std::numeric_limits<int64_t>::max());
+			const int64_t element = (step.index < 0) ? step.index + count : step.index;
+
+			if(element < 0 || element >= count)
+			{
+				return Error_Path_Not_Found;
+			}
+
+			for(int64_t i = 0; i < element; i++)
+			{
+				error = skip_(data, position);
+
+				if(error)
+				{
+					return error;
+				}
+			}
+
+			continue;
+		}
+
+		if(header.type != Type_::Map)
+		{
+			return Error_Path_Not_Found;
+		}
+
+		bool found = false;
+
+		for(uint64_t i = 0; i < header.value && found == false; i++)
+		{
+			size_t  key = position;
+			Header_ key_header;
+
+			error = readHeader_(data, key, key_header);
+
+			if(error)
+			{
+				return error;
+			}
+
+			if(step.is_key)
+			{
+				found = key_header.type == Type_::String
+					&& key_header.value == step.key.size()
+					&& memcmp(data.data() + key, step.key.data(), step.key.size()) == 0
+					;
+			}
+			else
+			{
+				found = (key_header.type == Type_::Int && (int64_t)key_header.value == step.index)
+					|| (key_header.type == Type_::Uint && step.index >= 0 && key_header.value == (uint64_t)step.index)
+					;
+			}
+
+			// Step over the key, and the value if the key did not match
+			if(key_header.type == Type_::String)
+			{
+				position = key + key_header.value;
+			}
+			else
+			{
+				error = skip_(data, position);
+			}
+
+			if(error == Error_None && found == false)
+			{
+				error = skip_(data, position);
+			}
+
+			if(error)
+			{
+				return error;
+			}
+		}
+
+		if(found == false)
+		{
+			return Error_Path_Not_Found;
+		}
+	}
+
+	Header_ header;
+	size_t  check = position;
+
+	std::error_code error = readHeader_(data, check, header);
+
+	if(error == Error_None)
+	{
+		index = position;
+	}
+
+	return error;
+}
+
+
+/**
+ * \brief Find an Object.
+ *
+ * The path is followed starting from the first Object in the packed \p 
+ * data.
+ *
+ * \see find(const std::span<const uint8_t>, size_t&)
+ *
+ * \return The Object. If the Object was not found, the ObjectView will not 
+ * be valid.
+ */
+ObjectView Query::find(const std::span<const uint8_t> data ///< The packed data
+	) const noexcept
+{
+	size_t index = 0;
+
+	if(find(data, index))
+	{
+		return {};
+	}
+
+	return ObjectView(data.subspan(index));
+}
+
+
+/**
+ * \fn Query::size()
+ *
+ * \brief The number of steps in the path.
+ *
+ * \return The number of steps.
+ */
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("query/compile")
+{
+	for(const auto& [path, size] : std::vector<std::pair<std::string_view, size_t>>
+		{	{ ""                   , 0 }
+		,	{ "a"                  , 1 }
+		,	{ ".a"                 , 1 }
+		,	{ "a.b.c"              , 3 }
+		,	{ "a[3]"               , 2 }
+		,	{ "[3]"                , 1 }
+		,	{ "[-1][0]"            , 2 }
+		,	{ "a[3].b[4][5].c"     , 6 }
+		,	{ "[\"a.b\"]"          , 1 }
+		,	{ "a[\"[x]\"].b"       , 3 }
+		,	{ "[\"\"]"             , 1 }
+		,	{ "[\"say \\\"hi\\\"\"]", 1 }
+		,	{ "with space"         , 1 }
+		})
+	{
+		CAPTURE(path);
+
+		Query query(path);
+
+		CHECK(query.error() == Error_None);
+		CHECK(query.size() == size);
+	}
+
+	for(const std::string_view path : {".", "a.", "a..b", "a.[0]", "[", "[]", "[x]", "[1", "[1.5]", "[+1]", "[1]a", "a]", "a[0]]", "[\"a\"", "[\"a]", "[\"a\"x]", "[99999999999999999999]"})
+	{
+		CAPTURE(path);
+
+		Query query(path);
+
+		CHECK(query.error() == Error_Invalid_Path);
+		CHECK(query.size() == 0);
+
+		const std::vector<uint8_t> data = serialize(Object{});
+
+		size_t index = 0;
+
+		CHECK(query.find(data, index) == Error_Invalid_Path);
+		CHECK(query.find(data).isValid() == false);
+	}
+
+	// A Query can be compiled again
+	Query query("[");
+
+	CHECK(query.compile("a.b") == Error_None);
+	CHECK(query.size() == 2);
+}
+
+TEST_CASE("query/find")
+{
+	Object object = {Map{}};
+	Map&   map    = object.asMap();
+
+	map.emplace<int64_t>("id", 42);
+	map.emplace<std::pmr::string>("a.b", "dotted");
+	map.emplace<std::pmr::string>("say \"hi\"", "quoted");
+	map.emplace<std::pmr::vector<uint8_t>>("image", std::pmr::vector<uint8_t>(300, 0xee));
+
+	Map& route = map.emplace<Map>("route");
+	route.emplace<std::pmr::string>("service", "telemetry");
+
+	Array& hops = route.emplace<Array>("hops");
+
+	for(int64_t i = 0; i < 20; i++)
+	{
+		hops.emplace<Map>().emplace<std::pmr::string>("host", "host-" + std::to_string(i));
+	}
+
+	Map& numbers = map.emplace<Map>("numbers");
+	numbers.emplace<std::pmr::string>(int64_t(-1), "minus one");
+	numbers.emplace<std::pmr::string>(uint64_t(7), "seven");
+	numbers.emplace<std::pmr::string>("7", "string seven");
+
+	const std::vector<uint8_t> data = serialize(object);
+
+	SUBCASE("Found")
+	{
+		CHECK(Query("id").find(data).asInt() == 42);
+		CHECK(Query(".id").find(data).asInt() == 42);
+		CHECK(Query("[\"a.b\"]").find(data).asString() == "dotted");
+		CHECK(Query("[\"say \\\"hi\\\"\"]").find(data).asString() == "quoted");
+		CHECK(Query("image").find(data).asBinary().size() == 300);
+		CHECK(Query("route.service").find(data).asString() == "telemetry");
+		CHECK(Query("route.hops[0].host").find(data).asString() == "host-0");
+		CHECK(Query("route.hops[19].host").find(data).asString() == "host-19");
+		CHECK(Query("route.hops[-1].host").find(data).asString() == "host-19");
+		CHECK(Query("route.hops[-20].host").find(data).asString() == "host-0");
+		CHECK(Query("route[\"hops\"][3][\"host\"]").find(data).asString() == "host-3");
+		CHECK(Query("numbers[-1]").find(data).asString() == "minus one");
+		CHECK(Query("numbers[7]").find(data).asString() == "seven");
+		CHECK(Query("numbers.7").find(data).asString() == "string seven");
+		CHECK(Query("route.hops").find(data).asArray().size() == 20);
+
+		const ObjectView root = Query("").find(data);
+
+		CHECK(root.isMap());
+		CHECK(root.data().size() == data.size());
+
+		// The view only has the found Object
+		const std::span<const uint8_t> found = Query("route.hops[4]").find(data).data();
+
+		CHECK(deserialize(found).asMap()[Object{"host"}].asString() == "host-4");
+	}
+
+	SUBCASE("Not Found")
+	{
+		for(const std::string_view path : {"name", "ID", "id.x", "id[0]", "route.hops[20]", "route.hops[-21]", "route.hops.host", "route.hops[0].port", "[0]", "numbers[8]", "numbers[\"-1\"]", "image[0]"})
+		{
+			CAPTURE(path);
+
+			const Query query(path);
+
+			size_t index = 0;
+
+			CHECK(query.find(data, index) == Error_Path_Not_Found);
+			CHECK(index == 0);
+			CHECK(query.find(data).isValid() == false);
+		}
+	}
+
+	SUBCASE("Index")
+	{
+		// A sequence of messages
+		std::vector<uint8_t> stream = serialize(Object{int64_t(1)});
+		stream.insert(stream.end(), data.begin(), data.end());
+
+		const Query query("route.hops[2].host");
+
+		size_t index = 1;
+
+		CHECK(query.find(stream, index) == Error_None);
+		CHECK(ObjectView(std::span(stream).subspan(index)).asString() == "host-2");
+
+		index = stream.size();
+
+		CHECK(query.find(stream, index) == Error_Invalid_Index);
+		CHECK(query.find(std::vector<uint8_t>{}).isValid() == false);
+
+		index = 0;
+
+		CHECK(Query("").find(stream, index) == Error_None);
+		CHECK(index == 0);
+	}
+
+	SUBCASE("Invalid Data")
+	{
+		// The last value of the data
+		const Query query("numbers.7");
+
+		CHECK(query.find(data).asString() == "string seven");
+
+		for(size_t size = 1; size < data.size(); size++)
+		{
+			size_t index = 0;
+
+			const std::error_code error = query.find(std::span(data).first(size), index);
+
+			CHECK(error != Error_None);
+			CHECK(error != Error_Path_Not_Found);
+		}
+
+		// A Map that claims more pairs than there are
+		const std::vector<uint8_t> map_data = {(uint8_t)Format::Fixed_Map | 2, 0xa1, 'a', 0x01};
+
+		size_t index = 0;
+
+		CHECK(Query("b").find(map_data, index) == Error_Invalid_Index);
+		CHECK(Query("a").find(map_data, index) == Error_None);
+		CHECK(index == 3);
+
+		const std::vector<uint8_t> invalid = {(uint8_t)Format::Fixed_Map | 1, (uint8_t)Format::Never_Used, 0x01};
+
+		index = 0;
+
+		CHECK(Query("a").find(invalid, index) == Error_Invalid_Format_Type);
+	}
+
+	SUBCASE("Threads")
+	{
+		const Query query("route.hops[-1].host");
+
+		std::atomic<size_t> found = 0;
+
+		std::vector<std::thread> thread_vector;
+
+		for(size_t t = 0; t < 4; t++)
+		{
+			thread_vector.emplace_back([&]()
+			{
+				for(size_t i = 0; i < 100; i++)
+				{
+					found += (query.find(data).asString() == "host-19");
+				}
+			});
+		}
+
+		for(std::thread& thread : thread_vector)
+		{
+			thread.join();
+		}
+
+		CHECK(found == 400);
+	}
+}
+#endif // }}}
+
+// }}} Query
+// {{{ Reader
+
+/**
+ * \class Reader
+ *
+ * \brief A pull parser for packed data.
+ *
+ * The Reader decodes packed data one token at a time. Nothing is decoded 
+ * until next() is called, and only the current token is decoded. Scalar 
+ * values are decoded without using heap memory and strings and binary data 
+ * refer to the packed data.
+ *
+ * Containers produce a begin token, the tokens of their contents, and then 
+ * an end token. In a Map, each key produces a Token::Key. The type of the 
+ * key is available from keyToken() and its value is available from the 
+ * same methods as any other value.
+ *
+ * When the contents of a container or a value are not needed, use skip() 
+ * to move past them without decoding them.
+ *
+ * \parcode
+ * zakero::messagepack::Reader reader(data);
+ *
+ * using Token = zakero::messagepack::Reader::Token;
+ *
+ * if(reader.next() != Token::Map_Begin)
+ * {
+ * 	return;
+ * }
+ *
+ * while(reader.next() == Token::Key)
+ * {
+ * 	std::string_view key = reader.asString();
+ *
+ * 	reader.next();
+ *
+ * 	if(key == "id")
+ * 	{
+ * 		id = reader.asUint();
+ * 	}
+ * 	else
+ * 	{
+ * 		reader.skip();
+ * 	}
+ * }
+ * \endparcode
+ *
+ * After the last Object in the data, Token::End is produced. If the data is 
+ * not valid, Token::Error is produced and the error is available from 
+ * error().
+ *
+ * Containers can not be nested deeper than \ref Reader::Depth_Max.
+ *
+ * \note The packed data must exist for as long as the Reader is in use.
+ */
+
+
+/**
+ * \var Reader::Depth_Max
+ *
+ * \brief The maximum nesting depth of containers.
+ */
+
+
+/**
+ * \enum Reader::Token
+ *
+ * \brief The type of data that was read.
+ */
+
+
+/**
+ * \fn Reader::Reader(const Range&)
+ *
+ * \brief Constructor.
+ *
+ * The \p range can be any contiguous range of bytes.
+ *
+ * \tparam Range The type of the byte range.
+ */
+
+
+/**
+ * \fn Reader::token()
+ *
+ * \brief The current token.
+ *
+ * \return The token.
+ */
+
+
+/**
+ * \fn Reader::keyToken()
+ *
+ * \brief The type of the current token.
+ *
+ * If the current token is a Token::Key, the type of the key is returned.  
+ * Otherwise, the same value as token() is returned.
+ *
+ * \return The token.
+ */
+
+
+/**
+ * \fn Reader::isKey()
+ *
+ * \brief Check for a Map key.
+ *
+ * \retval true  The current token is a Map key.
+ * \retval false The current token is not a Map key.
+ */
+
+
+/**
+ * \fn Reader::depth()
+ *
+ * \brief The number of containers that are being read.
+ *
+ * \return The depth.
+ */
+
+
+/**
+ * \fn Reader::index()
+ *
+ * \brief The location of the next token in the packed data.
+ *
+ * \return The index.
+ */
+
+
+/**
+ * \fn Reader::error()
+ *
+ * \brief The current error.
+ *
+ * \return The error.
+ */
+
+
+/**
+ * \brief Constructor.
+ *
+ * The Reader will read the \p data.
+ */
+Reader::Reader(const std::span<const uint8_t> data ///< The packed data
+	) noexcept
+	: data_(data)
+{
+}
+
+
+/**
+ * \brief Read the next token.
+ *
+ * \return The token.
+ */
+Reader::Token Reader::next() noexcept
+{
+	if(error_)
+	{
+		return Token::Error;
+	}
+
+	key_ = false;
+
+	if(depth_ > 0)
+	{
+		Frame& frame = stack_[depth_ - 1];
+
+		if(frame.remaining == 0)
+		{
+			depth_--;
+
+			token_ = frame.map
+				? Token::Map_End
+				: Token::Array_End
+				;
+
+			return token_;
+		}
+
+		key_ = frame.map && (frame.remaining % 2 == 0);
+
+		frame.remaining--;
+	}
+	else if(index_ >= data_.size())
+	{
+		token_ = Token::End;
+
+		return token_;
+	}
+
+	Header_ header;
+
+	start_ = index_;
+	error_ = (index_ < data_.size())
+		? readHeader_(data_, index_, header)
+		: Error_Incomplete
+		;
+
+	if(error_)
+	{
+		key_   = false;
+		token_ = Token::Error;
+
+		return token_;
+	}
+
+	value_    = header.value;
+	ext_type_ = header.ext_type;
+
+	switch(header.type)
+	{
+		case Type_::Null:   token_ = Token::Null;   break;
+		case Type_::Bool:   token_ = Token::Bool;   break;
+		case Type_::Int:    token_ = Token::Int;    break;
+		case Type_::Uint:   token_ = Token::Uint;   break;
+		case Type_::Float:  token_ = Token::Float;  break;
+		case Type_::Double: token_ = Token::Double; break;
+
+		case Type_::String:
+			token_  = Token::Str;
+			index_ += value_;
+			break;
+
+		case Type_::Binary:
+			token_  = Token::Bin;
+			index_ += value_;
+			break;
+
+		case Type_::Ext:
+			token_  = Token::Ext;
+			index_ += value_;
+			break;
+
+		case Type_::Array:
+		case Type_::Map:
+			if(depth_ >= Depth_Max)
+			{
+				error_ = Error_Depth_Limit;
+				key_   = false;
+				token_ = Token::Error;
+
+				return token_;
+			}
+
+			if(header.type == Type_::Map)
+			{
+				token_ = Token::Map_Begin;
+				stack_[depth_++] = {value_ * 2, true};
+			}
+			else
+			{
+				token_ = Token::Array_Begin;
+				stack_[depth_++] = {value_, false};
+			}
+			break;
+
+		case Type_::Invalid:
+			break;
+	}
+
+	return token();
+}
+
+
+/**
+ * \brief Skip the contents of a container.
+ *
+ * If the current token is a Token::Array_Begin or a Token::Map_Begin, the 
+ * contents of the container will be skipped without being decoded. The 
+ * end token of the container will not be produced. For all other tokens, 
+ * nothing is done.
+ *
+ * \return The current error.
+ */
+std::error_code Reader::skip() noexcept
+{
+	if(error_ || depth_ == 0)
+	{
+		return error_;
+	}
+
+	if(token_ != Token::Array_Begin && token_ != Token::Map_Begin)
+	{
+		return error_;
+	}
+
+	size_t index = start_;
+
+	error_ = skip_(data_, index);
+
+	if(error_)
+	{
+		token_ = Token::Error;
+
+		return error_;
+	}
+
+	index_ = index;
+	depth_--;
+
+	return error_;
+}
+
+
+/**
+ * \brief Get binary data.
+ *
+ * \return The binary data or an empty span if the token is not binary 
+ * data.
+ */
+std::span<const uint8_t> Reader::asBinary() const noexcept
+{
+	if(token_ != Token::Bin)
+	{
+		return {};
+	}
+
+	return data_.subspan(index_ - value_, value_);
+}
+
+
+/**
+ * \brief Get a boolean value.
+ *
+ * \return The value or `false` if the token is not a boolean.
+ */
+bool Reader::asBool() const noexcept
+{
+	return (token_ == Token::Bool) && (value_ != 0);
+}
+
+
+/**
+ * \brief Get a 64-bit floating point value.
+ *
+ * \return The value or `0` if the token is not a 64-bit floating point 
+ * value.
+ */
+double Reader::asDouble() const noexcept
+{
+	if(token_ != Token::Double)
+	{
+		return 0;
+	}
+
+	return std::bit_cast<double>(value_);
+}
+
+
+/**
+ * \brief Get Extension data.
+ *
+ * \return The Extension data or an empty ExtView if the token is not an 
+ * Extension.
+ */
+ExtView Reader::asExt() const noexcept
+{
+	if(token_ != Token::Ext)
+	{
+		return {};
+	}
+
+	return ExtView{data_.subspan(index_ - value_, value_), ext_type_};
+}
+
+
+/**
+ * \brief Get a 32-bit floating point value.
+ *
+ * \return The value or `0` if the token is not a 32-bit floating point 
+ * value.
+ */
+float Reader::asFloat() const noexcept
+{
+	if(token_ != Token::Float)
+	{
+		return 0;
+	}
+
+	return std::bit_cast<float>((uint32_t)value_);
+}
+
+
+/**
+ * \brief Get a signed integer value.
+ *
+ * \return The value or `0` if the token is not a signed integer.
+ */
+int64_t Reader::asInt() const noexcept
+{
+	if(token_ != Token::Int)
+	{
+		return 0;
+	}
+
+	return (int64_t)value_;
+}
+
+
+/**
+ * \brief Get a string.
+ *
+ * \return The string or an empty string if the token is not a string.
+ */
+std::string_view Reader::asString() const noexcept
+{
+	if(token_ != Token::Str)
+	{
+		return {};
+	}
+
+	return std::string_view((const char*)data_.data() + index_ - value_, value_);
+}
+
+
+/**
+ * \brief Get an unsigned integer value.
+ *
+ * \return The value or `0` if the token is not an unsigned integer.
+ */
+uint64_t Reader::asUint() const noexcept
+{
+	if(token_ != Token::Uint)
+	{
+		return 0;
+	}
+
+	return value_;
+}
+
+
+/**
+ * \brief The size of the current token.
+ *
+ * - Token::Array_Begin: The number of elements
+ * - Token::Map_Begin: The number of key/value pairs
+ * - Token::Str, Token::Bin, Token::Ext: The number of bytes
+ *
+ * \return The size or `0` for all other tokens.
+ */
+size_t Reader::size() const noexcept
+{
+	switch(token_)
+	{
+		case Token::Array_Begin:
+		case Token::Map_Begin:
+		case Token::Str:
+		case Token::Bin:
+		case Token::Ext:
+			return value_;
+
+		default:
+			return 0;
+	}
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("reader/tokens")
+{
+	using Token = Reader::Token;
+
+	Ext ext;
+	ext.type = 3;
+	ext.data = {1, 2, 3, 4};
+
+	Map map;
+	map[uint64_t(7)] = Object{Array{}};
+	map["key"]       = Object{int64_t(-5)};
+
+	Array array;
+	array.appendNull();
+	array.append(true);
+	array.append(int64_t(-1));
+	array.append(uint64_t(1));
+	array.append(1.5f);
+	array.append(2.5);
+	array.append(std::string_view("str"));
+	array.append(std::vector<uint8_t>{9, 8});
+	array.append(ext);
+	array.append(map);
+
+	const std::vector<uint8_t> data = serialize(array);
+
+	Reader reader(data);
+
+	CHECK(reader.next()   == Token::Array_Begin);
+	CHECK(reader.size()   == 10);
+	CHECK(reader.depth()  == 1);
+	CHECK(reader.next()   == Token::Null);
+	CHECK(reader.next()   == Token::Bool);
+	CHECK(reader.asBool() == true);
+	CHECK(reader.next()   == Token::Int);
+	CHECK(reader.asInt()  == -1);
+	CHECK(reader.next()   == Token::Uint);
+	CHECK(reader.asUint() == 1);
+	CHECK(reader.next()   == Token::Float);
+	CHECK(reader.asFloat() == 1.5f);
+	CHECK(reader.next()   == Token::Double);
+	CHECK(reader.asDouble() == 2.5);
+	CHECK(reader.next()   == Token::Str);
+	CHECK(reader.asString() == "str");
+	CHECK(reader.next()   == Token::Bin);
+	CHECK(reader.asBinary().size() == 2);
+	CHECK(reader.asBinary()[0] == 9);
+	CHECK(reader.next()   == Token::Ext);
+	CHECK(reader.asExt().type == 3);
+	CHECK(reader.asExt().data.size() == 4);
+
+	CHECK(reader.next()     == Token::Map_Begin);
+	CHECK(reader.size()     == 2);
+	CHECK(reader.next()     == Token::Key);
+	CHECK(reader.keyToken() == Token::Uint);
+	CHECK(reader.asUint()   == 7);
+	CHECK(reader.next()     == Token::Array_Begin);
+	CHECK(reader.isKey()    == false);
+	CHECK(reader.depth()    == 3);
+	CHECK(reader.next()     == Token::Array_End);
+	CHECK(reader.next()     == Token::Key);
+	CHECK(reader.keyToken() == Token::Str);
+	CHECK(reader.asString() == "key");
+	CHECK(reader.next()     == Token::Int);
+	CHECK(reader.asInt()    == -5);
+	CHECK(reader.next()     == Token::Map_End);
+	CHECK(reader.next()     == Token::Array_End);
+	CHECK(reader.depth()    == 0);
+	CHECK(reader.next()     == Token::End);
+	CHECK(reader.next()     == Token::End);
+	CHECK(reader.error()    == Error_None);
+}
+
+TEST_CASE("reader/skip")
+{
+	using Token = Reader::Token;
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	packer.packMapHeader(3);
+	packer.packStr("skip");
+	packer.packArrayHeader(3);
+	packer.packInt(1);
+	packer.packMapHeader(1);
+	packer.packStr("a");
+	packer.packStr("b");
+	packer.packInt(3);
+	packer.packStr("id");
+	packer.packUint(42);
+	packer.packStr("name");
+	packer.packStr("zakero");
+
+	Reader reader(data);
+
+	uint64_t         id = 0;
+	std::string_view name;
+
+	REQUIRE(reader.next() == Token::Map_Begin);
+
+	while(reader.next() == Token::Key)
+	{
+		const std::string_view key = reader.asString();
+
+		reader.next();
+
+		if(key == "id")
+		{
+			id = reader.asUint();
+		}
+		else if(key == "name")
+		{
+			name = reader.asString();
+		}
+		else
+		{
+			CHECK(reader.skip() == Error_None);
+		}
+	}
+
+	CHECK(reader.token() == Token::Map_End);
+	CHECK(id   == 42);
+	CHECK(name == "zakero");
+	CHECK(reader.next() == Token::End);
+}
+
+TEST_CASE("reader/sequence")
+{
+	using Token = Reader::Token;
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	packer.packInt(1);
+	packer.packInt(2);
+
+	Reader reader(data);
+
+	CHECK(reader.next()  == Token::Int);
+	CHECK(reader.asInt() == 1);
+	CHECK(reader.next()  == Token::Int);
+	CHECK(reader.asInt() == 2);
+	CHECK(reader.next()  == Token::End);
+}
+
+TEST_CASE("reader/error")
+{
+	using Token = Reader::Token;
+
+	SUBCASE("incomplete")
+	{
+		std::vector<uint8_t> data = serialize(Object{std::pmr::string(40, 'x')});
+		data.pop_back();
+
+		Reader reader(data);
+
+		CHECK(reader.next()  == Token::Error);
+		CHECK(reader.error() == Error_Incomplete);
+		CHECK(reader.next()  == Token::Error);
+	}
+
+	SUBCASE("missing element")
+	{
+		const std::vector<uint8_t> data = {(uint8_t)Format::Fixed_Array | 2, 0x01};
+
+		Reader reader(data);
+
+		CHECK(reader.next()  == Token::Array_Begin);
+		CHECK(reader.next()  == Token::Int);
+		CHECK(reader.next()  == Token::Error);
+		CHECK(reader.error() == Error_Incomplete);
+	}
+
+	SUBCASE("depth")
+	{
+		const std::vector<uint8_t> data(Reader::Depth_Max + 1, (uint8_t)Format::Fixed_Array | 1);
+
+		Reader reader(data);
+
+		for(size_t i = 0; i < Reader::Depth_Max; i++)
+		{
+			CHECK(reader.next() == Token::Array_Begin);
+		}
+
+		CHECK(reader.next()  == Token::Error);
+		CHECK(reader.error() == Error_Depth_Limit);
+	}
+
+	SUBCASE("never used")
+	{
+		const std::vector<uint8_t> data = {(uint8_t)Format::Never_Used};
+
+		Reader reader(data);
+
+		CHECK(reader.next()  == Token::Error);
+		CHECK(reader.error() == Error_Invalid_Format_Type);
+	}
+}
+#endif // }}}
+
+// }}} Reader
+// {{{ Unpacker
+
+/**
+ * \class Unpacker
+ *
+ * \brief Deserialize data that arrives in pieces.
+ *
+ * When data is read from a socket or a pipe, an Object may be split across 
+ * many reads. Using deserialize() would require collecting the data and 
+ * starting over each time more data arrives. The Unpacker keeps track of 
+ * where it is, so each byte is only looked at once no matter how the data 
+ * is split.
+ *
+ * Give the Unpacker data with feed(). Each time an Object is complete, it 
+ * is added to a queue. Use next() to take Objects from the queue.
+ *
+ * \parcode
+ * zakero::messagepack::Unpacker unpacker;
+ *
+ * uint8_t buffer[4096];
+ * ssize_t size;
+ *
+ * while((size = read(fd, buffer, sizeof(buffer))) > 0)
+ * {
+ * 	std::error_code error = unpacker.feed(std::span(buffer, size));
+ *
+ * 	if(error)
+ * 	{
+ * 		break;
+ * 	}
+ *
+ * 	zakero::messagepack::Object object;
+ * 	while(unpacker.next(object))
+ * 	{
+ * 		process(object);
+ * 	}
+ * }
+ * \endparcode
+ *
+ * If an error occurs, all later data will be ignored until reset() is 
+ * called.
+ *
+ * The data usually comes from an untrusted source, so each top-level Object 
+ * is checked against the Limits in the same way as deserialize(). Going 
+ * over a limit is an error.
+ */
+
+
+/**
+ * \fn Unpacker::Unpacker()
+ *
+ * \brief Constructor.
+ *
+ * The default Limits are used.
+ */
+
+
+/**
+ * \brief Constructor.
+ *
+ * The \p limits are used for all the data. A Limits::max_depth that is 
+ * larger than Limits::Depth_Max is treated as Limits::Depth_Max.
+ */
+Unpacker::Unpacker(const Limits& limits ///< The limits
+	) noexcept
+	: limits_(limits)
+{
+	limits_.max_depth = std::min(limits_.max_depth, Limits::Depth_Max);
+}
+
+
+/**
+ * \fn Unpacker::available()
+ *
+ * \brief The number of Objects that are ready.
+ *
+ * \return The Object count.
+ */
+
+
+/**
+ * \fn Unpacker::consumed()
+ *
+ * \brief The number of bytes that have been used.
+ *
+ * \return The byte count.
+ */
+
+
+/**
+ * \fn Unpacker::error()
+ *
+ * \brief The current error.
+ *
+ * \return The error code.
+ */
+
+
+/**
+ * \fn Unpacker::pending()
+ *
+ * \brief Check for an incomplete Object.
+ *
+ * \retval true  Part of an Object has been received.
+ * \retval false All received data has been converted into Objects.
+ */
+
+
+/**
+ * \brief Add data.
+ *
+ * The \p data will be decoded and any Objects that are completed will be 
+ * available from next(). The \p data does not need to be kept after this 
+ * method returns.
+ *
+ * \return An error code.
+ */
+std::error_code Unpacker::feed(const std::span<const uint8_t> data ///< The packed data
+	) noexcept
+{
+	size_t index = 0;
+
+	while(index < data.size() && !error_)
+	{
+		if(payload_ > 0)
+		{
+			const size_t   count = std::min<uint64_t>(payload_, data.size() - index);
+			const uint8_t* bytes = data.data() + index;
+
+			if(value_.isString())
+			{
+				value_.as<std::pmr::string>().append((const char*)bytes, count);
+			}
+			else if(value_.isBinary())
+			{
+				value_.asBinary().insert(value_.asBinary().end(), bytes, bytes + count);
+			}
+			else
+			{
+				value_.asExt().data.insert(value_.asExt().data.end(), bytes, bytes + count);
+			}
+
+			index    += count;
+			payload_ -= count;
+
+			if(payload_ == 0)
+			{
+				complete_(std::exchange(value_, Object{}));
+			}
+
+			continue;
+		}
+
+		if(header_size_ == 0)
+		{
+			header_[header_size_++] = data[index++];
+		}
+
+		const size_t header_size = headerSize_(header_[0]);
+
+		while(header_size_ < header_size && index < data.size())
+		{
+			header_[header_size_++] = data[index++];
+		}
+
+		if(header_size_ < header_size)
+		{
+			break;
+		}
+
+		header_size_ = 0;
+
+		Header_ header;
+
+		error_ = decodeHeader_(header_.data(), header);
+
+		if(error_)
+		{
+			break;
+		}
+
+		if(elements_ >= limits_.max_elements)
+		{
+			error_ = Error_Element_Limit;
+			break;
+		}
+
+		elements_++;
+
+		const uint64_t length = (header.type == Type_::String
+			|| header.type == Type_::Binary
+			|| header.type == Type_::Ext
+			) ? header.value : 0;
+
+		if(header_size > (limits_.max_bytes - bytes_)
+			|| length > (limits_.max_bytes - bytes_ - header_size)
+			)
+		{
+			error_ = Error_Size_Limit;
+			break;
+		}
+
+		bytes_ += header_size + length;
+
+		if(stack_.empty() == false
+			&& stack_.back().object.isMap()
+			&& stack_.back().has_key == false
+			&& (header.type == Type_::Binary
+				|| header.type == Type_::Array
+				|| header.type == Type_::Map
+				|| header.type == Type_::Ext
+			))
+		{
+			error_ = Error_Invalid_Format_Type;
+			break;
+		}
+
+		if(header.type == Type_::Array || header.type == Type_::Map)
+		{
+			const uint64_t count = (header.type == Type_::Map)
+				? header.value * 2
+				: header.value
+				;
+
+			if(stack_.size() >= limits_.max_depth)
+			{
+				error_ = Error_Depth_Limit;
+				break;
+			}
+
+			if(count > (limits_.max_elements - elements_))
+			{
+				error_ = Error_Element_Limit;
+				break;
+			}
+		}
+
+		// Large sizes may not be real, so limit the memory reserved
+		const size_t reserve = std::min<uint64_t>(header.value, 65'536);
+
+		switch(header.type)
+		{
+			case Type_::Null:   complete_(Object{});                                             break;
+			case Type_::Bool:   complete_(Object{header.value != 0});                            break;
+			case Type_::Int:    complete_(Object{(int64_t)header.value});                        break;
+			case Type_::Uint:   complete_(Object{header.value});                                 break;
+			case Type_::Float:  complete_(Object{std::bit_cast<float>((uint32_t)header.value)}); break;
+			case Type_::Double: complete_(Object{std::bit_cast<double>(header.value)});          break;
+
+			case Type_::String:
+				value_ = Object{std::pmr::string()};
+				value_.as<std::pmr::string>().reserve(reserve);
+				break;
+
+			case Type_::Binary:
+				value_ = Object{std::pmr::vector<uint8_t>()};
+				value_.asBinary().reserve(reserve);
+				break;
+
+			case Type_::Ext:
+				value_ = Object{Ext{}};
+				value_.asExt().type = header.ext_type;
+				value_.asExt().data.reserve(reserve);
+				break;
+
+			case Type_::Array:
+				if(header.value == 0)
+				{
+					complete_(Object{Array{}});
+				}
+				else
+				{
+					stack_.push_back({Object{Array{}}, Object{}, header.value, false});
+				}
+				break;
+
+			case Type_::Map:
+				if(header.value == 0)
+				{
+					complete_(Object{Map{}});
+				}
+				else
+				{
+					stack_.push_back({Object{Map{}}, Object{}, header.value * 2, false});
+				}
+				break;
+
+			case Type_::Invalid:
+				break;
+		}
+
+		if(header.type == Type_::String
+			|| header.type == Type_::Binary
+			|| header.type == Type_::Ext
+			)
+		{
+			payload_ = header.value;
+
+			if(payload_ == 0)
+			{
+				complete_(std::exchange(value_, Object{}));
+			}
+		}
+	}
+
+	consumed_ += index;
+
+	return error_;
+}
+
+
+/**
+ * \brief Add a completed Object.
+ *
+ * The \p object will be added to the container that is being built. If 
+ * that completes the container, the container will be added to its parent 
+ * container. Top-level Objects are added to the queue.
+ *
+ * If the \p object can not be added, the error is stored.
+ */
+void Unpacker::complete_(Object&& object ///< The completed Object
+	) noexcept
+{
+	while(stack_.empty() == false)
+	{
+		Frame& frame = stack_.back();
+
+		if(frame.object.isArray())
+		{
+			frame.object.asArray().object_vector.push_back(std::move(object));
+		}
+		else if(frame.has_key == false)
+		{
+			frame.key     = std::move(object);
+			frame.has_key = true;
+		}
+		else
+		{
+			error_ = frame.object.asMap().set(std::move(frame.key), std::move(object));
+
+			if(error_)
+			{
+				return;
+			}
+
+			frame.key     = Object{};
+			frame.has_key = false;
+		}
+
+		frame.remaining--;
+
+		if(frame.remaining > 0)
+		{
+			return;
+		}
+
+		object = std::move(frame.object);
+		stack_.pop_back();
+	}
+
+	ready_.push_back(std::move(object));
+
+	elements_ = 0;
+	bytes_    = 0;
+}
+
+
+/**
+ * \brief Get the next Object.
+ *
+ * If an Object is available, it will be moved into the \p object and 
+ * removed from the queue.
+ *
+ * \retval true  The \p object was set.
+ * \retval false No Object is available.
+ */
+bool Unpacker::next(Object& object ///< Where to store the Object
+	) noexcept
+{
+	if(ready_.empty())
+	{
+		return false;
+	}
+
+	object = std::move(ready_.front());
+	ready_.pop_front();
+
+	return true;
+}
+
+
+/**
+ * \brief Start over.
+ *
+ * All Objects, partial data, and errors will be discarded.
+ */
+void Unpacker::reset() noexcept
+{
+	ready_.clear();
+	stack_.clear();
+
+	value_       = Object{};
+	payload_     = 0;
+	header_size_ = 0;
+	consumed_    = 0;
+	elements_    = 0;
+	bytes_       = 0;
+	error_       = Error_None;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("unpacker/chunks")
+{
+	Ext ext;
+	ext.type = -3;
+	ext.data = std::pmr::vector<uint8_t>(300, 'e');
+
+	Map map;
+	map["string"]      = Object{std::pmr::string(1'000, 's')};
+	map[int64_t(-1)]   = Object{Array{}};
+	map[uint64_t(99)]  = Object{Map{}};
+	map[double(0.5)]   = Object{ext};
+
+	Array array;
+	array.appendNull();
+	array.append(true);
+	array.append(int64_t(-100'000));
+	array.append(uint64_t(1) << 40);
+	array.append(1.25f);
+	array.append(-8.5);
+	array.append(std::string_view(""));
+	array.append(std::vector<uint8_t>(70'000, 'b'));
+	array.append(map);
+
+	const std::vector<uint8_t> data = serialize(array);
+
+	for(const size_t chunk_size : {1, 2, 3, 7, 64, 4'096, 100'000})
+	{
+		Unpacker unpacker;
+		Object   object;
+
+		for(size_t index = 0; index < data.size(); index += chunk_size)
+		{
+			CHECK(unpacker.next(object) == false);
+
+			const size_t size = std::min(chunk_size, data.size() - index);
+
+			CHECK(unpacker.feed(std::span(data).subspan(index, size)) == Error_None);
+		}
+
+		CHECK(unpacker.consumed() == data.size());
+		CHECK(unpacker.pending()  == false);
+		CHECK(unpacker.available() == 1);
+		REQUIRE(unpacker.next(object) == true);
+		CHECK(unpacker.next(object) == false);
+
+		CHECK(serialize(object) == data);
+	}
+}
+
+TEST_CASE("unpacker/sequence")
+{
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	packer.packInt(1);
+	packer.packStr("two");
+	packer.packArrayHeader(0);
+	packer.packMapHeader(0);
+	packer.packBin(std::vector<uint8_t>{});
+	packer.packExt(5, std::vector<uint8_t>{});
+	packer.packUint(7);
+
+	Unpacker unpacker;
+	CHECK(unpacker.feed(std::span(data).first(3)) == Error_None);
+	CHECK(unpacker.available() == 1);
+	CHECK(unpacker.pending()   == true);
+
+	CHECK(unpacker.feed(std::span(data).subspan(3)) == Error_None);
+	CHECK(unpacker.available() == 7);
+	CHECK(unpacker.pending()   == false);
+
+	Object object;
+	CHECK(unpacker.next(object));
+	CHECK(object.as<int64_t>() == 1);
+	CHECK(unpacker.next(object));
+	CHECK(object.asString() == "two");
+	CHECK(unpacker.next(object));
+	CHECK(object.isArray());
+	CHECK(unpacker.next(object));
+	CHECK(object.isMap());
+	CHECK(unpacker.next(object));
+	CHECK(object.isBinary());
+	CHECK(unpacker.next(object));
+	CHECK(object.isExt());
+	CHECK(object.asExt().type == 5);
+	CHECK(unpacker.next(object));
+	CHECK(object.as<uint64_t>() == 7);
+	CHECK(unpacker.next(object) == false);
+}
+
+TEST_CASE("unpacker/error")
+{
+	const std::vector<uint8_t> data =
+	{	(uint8_t)Format::True
+	,	(uint8_t)Format::Never_Used
+	,	(uint8_t)Format::False
+	};
+
+	Unpacker unpacker;
+	CHECK(unpacker.feed(data)  == Error_Invalid_Format_Type);
+	CHECK(unpacker.available() == 1);
+
+	// Errors are sticky
+	CHECK(unpacker.feed(data)  == Error_Invalid_Format_Type);
+	CHECK(unpacker.available() == 1);
+
+	unpacker.reset();
+	CHECK(unpacker.error()     == Error_None);
+	CHECK(unpacker.available() == 0);
+	CHECK(unpacker.feed(std::span(data).first(1)) == Error_None);
+	CHECK(unpacker.available() == 1);
+}
+
+TEST_CASE("unpacker/depth")
+{
+	// [[[[ ... [nil] ... ]]]]
+	std::vector<uint8_t> data(4, (uint8_t)Format::Fixed_Array | 1);
+	data.push_back((uint8_t)Format::Nill);
+
+	Limits limits;
+	limits.max_depth = 4;
+
+	Unpacker unpacker(limits);
+	CHECK(unpacker.feed(data) == Error_None);
+	CHECK(unpacker.available() == 1);
+
+	data.insert(data.begin(), (uint8_t)Format::Fixed_Array | 1);
+
+	unpacker.reset();
+	CHECK(unpacker.feed(data) == Error_Depth_Limit);
+	CHECK(unpacker.available() == 0);
+
+	// A larger max_depth is capped
+	data.assign(2'000'000, (uint8_t)Format::Fixed_Array | 1);
+	data.push_back((uint8_t)Format::Nill);
+
+	limits.max_depth = std::numeric_limits<size_t>::max();
+
+	Unpacker hostile(limits);
+	CHECK(hostile.feed(data) == Error_Depth_Limit);
+	CHECK(hostile.consumed() == Limits::Depth_Max + 1);
+	CHECK(hostile.available() == 0);
+
+	// The default Limits
+	Unpacker unpacker_default;
+	CHECK(unpacker_default.feed(data) == Error_Depth_Limit);
+}
+
+TEST_CASE("unpacker/limits")
+{
+	Array array;
+	array.append(int64_t(1));
+	array.append(std::string_view("two"));
+	array.append(Array{});
+
+	// 1 byte header, 1 byte int, 4 byte string, 1 byte Array
+	const std::vector<uint8_t> data = serialize(array);
+	REQUIRE(data.size() == 7);
+
+	for(const size_t chunk_size : {1, 7})
+	{
+		auto feed = [&](Unpacker& unpacker) -> std::error_code
+		{
+			std::error_code error;
+
+			for(size_t i = 0; i < data.size() && !error; i += chunk_size)
+			{
+				error = unpacker.feed(std::span(data).subspan(i, std::min(chunk_size, data.size() - i)));
+			}
+
+			return error;
+		};
+
+		Limits limits;
+		limits.max_elements = 4;
+		limits.max_bytes    = 7;
+
+		Unpacker unpacker(limits);
+
+		// The limits are for each Object
+		CHECK(feed(unpacker) == Error_None);
+		CHECK(feed(unpacker) == Error_None);
+		CHECK(unpacker.available() == 2);
+
+		limits.max_elements = 3;
+		Unpacker elements(limits);
+		CHECK(feed(elements) == Error_Element_Limit);
+		CHECK(elements.available() == 0);
+
+		limits.max_elements = 4;
+		limits.max_bytes    = 6;
+		Unpacker bytes(limits);
+		CHECK(feed(bytes) == Error_Size_Limit);
+		CHECK(bytes.available() == 0);
+	}
+
+	// Sizes are checked at the header, before the data arrives
+
+	Limits limits;
+	limits.max_elements = 1'000;
+	limits.max_bytes    = 65'536;
+
+	Unpacker unpacker(limits);
+	CHECK(unpacker.feed(std::vector<uint8_t>{ (uint8_t)Format::Array32, 0xff, 0xff, 0xff, 0xff }) == Error_Element_Limit);
+
+	Unpacker text(limits);
+	CHECK(text.feed(std::vector<uint8_t>{ (uint8_t)Format::Str32, 0x00, 0x01, 0x00, 0x00 }) == Error_Size_Limit);
+}
+
+TEST_CASE("unpacker/map key")
+{
+	const uint8_t fixed_array = (uint8_t)Format::Fixed_Array;
+	const uint8_t fixed_map   = (uint8_t)Format::Fixed_Map;
+	const uint8_t fixed_str   = (uint8_t)Format::Fixed_Str;
+
+	// {[]: 1, "k": 2}
+	const std::vector<std::vector<uint8_t>> data_list =
+	{	{ (uint8_t)(fixed_map | 2), fixed_array, 0x01, (uint8_t)(fixed_str | 1), 'k', 0x02 }
+	,	{ (uint8_t)(fixed_map | 1), (uint8_t)(fixed_map | 1), 0x01, 0x02, 0x03 }
+	,	{ (uint8_t)(fixed_map | 1), (uint8_t)Format::Bin8, 1, 'b', 0x02 }
+	,	{ (uint8_t)(fixed_map | 1), (uint8_t)Format::Fixed_Ext1, 1, 'e', 0x02 }
+	,	{ (uint8_t)(fixed_array | 1), (uint8_t)(fixed_map | 1), 0x01, (uint8_t)(fixed_map | 1), fixed_array, 0x02 }
+	};
+
+	for(const std::vector<uint8_t>& data : data_list)
+	{
+		// The same data is accepted as deserialize()
+
+		size_t          index = 0;
+		std::error_code error;
+
+		Object object = deserialize(data, index, error);
+
+		CHECK(error == Error_Invalid_Format_Type);
+
+		for(const size_t chunk_size : {1, 2, 100})
+		{
+			Unpacker unpacker;
+
+			for(size_t i = 0; i < data.size(); i += chunk_size)
+			{
+				const size_t size = std::min(chunk_size, data.size() - i);
+
+				error = unpacker.feed(std::span(data).subspan(i, size));
+
+				if(error)
+				{
+					break;
+				}
+			}
+
+			CHECK(error == Error_Invalid_Format_Type);
+			CHECK(unpacker.available() == 0);
+		}
+	}
+
+	// Valid keys
+
+	Map map;
+	map[int64_t(-1)] = Object{Array{}};
+	map["k"]         = Object{Map{}};
+	map.set(Object{}, Object{true});
+
+	const std::vector<uint8_t> data = serialize(map);
+
+	Unpacker unpacker;
+	CHECK(unpacker.feed(data) == Error_None);
+
+	Object object;
+	REQUIRE(unpacker.next(object));
+	CHECK(serialize(object) == data);
+}
+#endif // }}}
+
+// }}} Unpacker
+// {{{ MappedFile
+
+/**
+ * \class MappedFile
+ *
+ * \brief Read a file of packed Objects without copying it.
+ *
+ * The file is mapped into memory with `mmap()` instead of being read into a 
+ * buffer. The Iterator visits each Object in the file, one after the other, 
+ * as an ObjectView of the mapped memory. Nothing is decoded until the 
+ * ObjectView is used.
+ *
+ * \parcode
+ * zakero::messagepack::MappedFile file;
+ *
+ * if(file.open("events.log"))
+ * {
+ * 	return;
+ * }
+ *
+ * for(const zakero::messagepack::ObjectView view : file)
+ * {
+ * 	process(view);
+ * }
+ * \endparcode
+ *
+ * The kernel is told that the file will be read in order, so it will read 
+ * ahead. The Iterator also gives the pages that it has passed back to the 
+ * kernel, every \ref MappedFile::Release_Size bytes. This keeps the memory 
+ * use of the process flat when scanning very large files. The memory is 
+ * still valid, if a page that was given back is used again it is read from 
+ * the file.
+ *
+ * If an Object in the file is not complete or is not valid, the Iterator 
+ * will become the end Iterator. To find out why the iteration ended, use 
+ * the Iterator directly:
+ *
+ * \parcode
+ * auto iter = file.begin();
+ *
+ * for(; iter != file.end(); iter++)
+ * {
+ * 	zakero::messagepack::Object object = iter.object();
+ * }
+ *
+ * if(iter.error())
+ * {
+ * 	// The file was not completely written
+ * }
+ * \endparcode
+ *
+ * \note All ObjectViews refer to the mapped memory and are only valid until 
+ * the MappedFile is closed.
+ */
+
+
+/**
+ * \var MappedFile::Release_Size
+ *
+ * \brief How often the Iterator gives pages back to the kernel.
+ */
+
+
+/**
+ * \class MappedFile::Iterator
+ *
+ * \brief Access the Objects of a MappedFile.
+ */
+
+
+/**
+ * \brief Constructor.
+ */
+MappedFile::Iterator::Iterator(const std::span<const uint8_t> data  ///< The mapped file
+	, const size_t                                        index ///< The location of the Object
+	) noexcept
+	: data_(data)
+	, index_(index)
+	, next_(index)
+{
+	check_();
+}
+
+
+/**
+ * \brief Find the end of the current Object.
+ *
+ * If the current Object is not valid, the Iterator will become the end 
+ * Iterator and the error will be kept.
+ */
+void MappedFile::Iterator::check_() noexcept
+{
+	if(index_ >= data_.size())
+	{
+		return;
+	}
+
+	next_ = index_;
+
+	error_ = skip_(data_, next_);
+
+	if(error_)
+	{
+		index_ = data_.size();
+		next_  = data_.size();
+	}
+}
+
+
+/**
+ * \brief Move to the next Object.
+ *
+ * \return The Iterator.
+ */
+MappedFile::Iterator& MappedFile::Iterator::operator++() noexcept
+{
+	if(index_ >= data_.size())
+	{
+		return *this;
+	}
+
+	index_ = next_;
+
+	if((index_ - released_) >= Release_Size)
+	{
+		static const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+		const size_t release = ((index_ / page_size) * page_size) - released_;
+
+		madvise((void*)(data_.data() + released_), release, MADV_DONTNEED);
+
+		released_ += release;
+	}
+
+	check_();
+
+	return *this;
+}
+
+
+/**
+ * \brief Deserialize the current Object.
+ *
+ * \return The Object.
+ */
+Object MappedFile::Iterator::object(std::pmr::memory_resource* resource ///< The memory resource
+	) const noexcept
+{
+	size_t          index = 0;
+	std::error_code error = Error_None;
+
+	return deserialize(data_.subspan(index_, next_ - index_), index, error, resource);
+}
+
+
+/**
+ * \fn MappedFile::Iterator::offset()
+ *
+ * \brief The location of the current Object in the file.
+ *
+ * \return The offset in bytes.
+ */
+
+
+/**
+ * \fn MappedFile::Iterator::error()
+ *
+ * \brief Why the iteration ended.
+ *
+ * \return The error of the Object that could not be read, or Error_None.
+ */
+
+
+/**
+ * \brief Destructor.
+ *
+ * The file will be closed.
+ */
+MappedFile::~MappedFile() noexcept
+{
+	close();
+}
+
+
+/**
+ * \brief Move constructor.
+ */
+MappedFile::MappedFile(MappedFile&& other ///< The MappedFile to move
+	) noexcept
+	: memory_(std::exchange(other.memory_, nullptr))
+	, size_(std::exchange(other.size_, 0))
+{
+}
+
+
+/**
+ * \brief Move assignment.
+ *
+ * \return This MappedFile.
+ */
+MappedFile& MappedFile::operator=(MappedFile&& other ///< The MappedFile to move
+	) noexcept
+{
+	if(this != &other)
+	{
+		close();
+
+		memory_ = std::exchange(other.memory_, nullptr);
+		size_   = std::exchange(other.size_, 0);
+	}
+
+	return *this;
+}
+
+
+/**
+ * \brief Map a file.
+ *
+ * The file at the \p path will be mapped into memory as read-only. If a 
+ * file was already open, it will be closed first. An empty file is valid 
+ * and has no Objects.
+ *
+ * \return An error code. If the file could not be opened or mapped, the 
+ * error is from `std::system_category()`.
+ */
+std::error_code MappedFile::open(const std::string& path ///< The file to map
+	) noexcept
+{
+	close();
+
+	const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+	if(fd == -1)
+	{
+		return std::error_code(errno, std::system_category());
+	}
+
+	struct stat file_stat;
+
+	if(fstat(fd, &file_stat) == -1)
+	{
+		const int error = errno;
+
+		::close(fd);
+
+		return std::error_code(error, std::system_category());
+	}
+
+	if(file_stat.st_size == 0)
+	{
+		::close(fd);
+
+		return Error_None;
+	}
+
+	void* memory = mmap(nullptr
+		, (size_t)file_stat.st_size
+		, PROT_READ
+		, MAP_SHARED
+		, fd
+		, 0
+		);
+
+	const int error = errno;
+
+	::close(fd);
+
+	if(memory == MAP_FAILED)
+	{
+		return std::error_code(error, std::system_category());
+	}
+
+	madvise(memory, (size_t)file_stat.st_size, MADV_SEQUENTIAL);
+
+	memory_ = (const uint8_t*)memory;
+	size_   = (size_t)file_stat.st_size;
+
+	return Error_None;
+}
+
+
+/**
+ * \brief Unmap the file.
+ *
+ * All ObjectViews of the file will no longer be valid.
+ */
+void MappedFile::close() noexcept
+{
+	if(memory_ != nullptr)
+	{
+		munmap((void*)memory_, size_);
+	}
+
+	memory_ = nullptr;
+	size_   = 0;
+}
+
+
+/**
+ * \fn MappedFile::data()
+ *
+ * \brief Access the mapped file.
+ *
+ * \return The contents of the file.
+ */
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+class TemporaryFile_
+{
+	public:
+		std::string path = "/tmp/zakero_messagepack_XXXXXX";
+
+		TemporaryFile_() noexcept
+		{
+			const int fd = mkstemp(path.data());
+
+			if(fd != -1)
+			{
+				::close(fd);
+			}
+		}
+
+		~TemporaryFile_() noexcept
+		{
+			unlink(path.c_str());
+		}
+
+		void write(const std::span<const uint8_t> data) noexcept
+		{
+			const int fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+
+			if(fd != -1)
+			{
+				[[maybe_unused]] ssize_t size = ::write(fd, data.data(), data.size());
+
+				::close(fd);
+			}
+		}
+};
+
+
+TEST_CASE("mappedfile")
+{
+	TemporaryFile_ file;
+
+	std::vector<Object> object_list;
+
+	for(size_t i = 0; i < 1'000; i++)
+	{
+		Map map;
+		map["id"]   = Object{uint64_t(i)};
+		map["name"] = Object{std::pmr::string(i % 40, 'n')};
+
+		const Object value = {int64_t(i) * -1'000};
+
+		object_list.push_back(Object{map});
+		object_list.push_back(value);
+
+		file.write(serialize(object_list[object_list.size() - 2]));
+		file.write(serialize(object_list.back()));
+	}
+
+	MappedFile mapped;
+
+	CHECK(mapped.begin() == mapped.end());
+	CHECK(mapped.open(file.path) == Error_None);
+	CHECK(mapped.size() > 0);
+
+	size_t index = 0;
+
+	for(const ObjectView view : mapped)
+	{
+		REQUIRE(index < object_list.size());
+		CHECK(std::ranges::equal(view.data(), serialize(object_list[index])));
+
+		index++;
+	}
+
+	CHECK(index == object_list.size());
+
+	auto iter = mapped.begin();
+	CHECK(iter.offset() == 0);
+	CHECK(serialize(iter.object()) == serialize(object_list[0]));
+	iter++;
+	CHECK(iter.offset() == serialize(object_list[0]).size());
+	CHECK((*iter).asInt() == 0);
+
+	// Move
+
+	MappedFile moved = std::move(mapped);
+	CHECK(mapped.size() == 0);
+	CHECK(mapped.begin() == mapped.end());
+	CHECK(serialize(moved.begin().object()) == serialize(object_list[0]));
+
+	moved.close();
+	CHECK(moved.size() == 0);
+	CHECK(moved.data().empty());
+}
+
+TEST_CASE("mappedfile/error")
+{
+	MappedFile mapped;
+
+	CHECK(mapped.open("/tmp/zakero_messagepack_does_not_exist") == std::error_code(ENOENT, std::system_category()));
+
+	TemporaryFile_ file;
+
+	CHECK(mapped.open(file.path) == Error_None);
+	CHECK(mapped.size() == 0);
+	CHECK(mapped.begin() == mapped.end());
+
+	// The last Object is not complete
+
+	file.write(serialize(Object{"one"}));
+	file.write(serialize(Object{"two"}));
+
+	std::vector<uint8_t> data = serialize(Object{"three"});
+	data.pop_back();
+	file.write(data);
+
+	CHECK(mapped.open(file.path) == Error_None);
+
+	size_t count = 0;
+	auto   iter  = mapped.begin();
+
+	for(; iter != mapped.end(); iter++)
+	{
+		count++;
+	}
+
+	CHECK(count == 2);
+	CHECK(iter.error() == Error_Incomplete);
+}
+#endif // }}}
+
+// }}} MappedFile
+// {{{ Fields
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+enum class FieldsColor_ : uint8_t
+{	Red   = 1
+,	Green = 2
+};
+
+struct FieldsPoint_
+{
+	float x = 0;
+	float y = 0;
+};
+
+ZAKERO_MESSAGEPACK_FIELDS(FieldsPoint_, x, y)
+
+struct FieldsRecord_
+{
+	bool                         flag     = false;
+	int8_t                       small    = 0;
+	int64_t                      offset   = 0;
+	uint32_t                     id       = 0;
+	double                       scale    = 0;
+	FieldsColor_                 color    = FieldsColor_::Red;
+	std::string                  name     = {};
+	std::pmr::string             unit     = {};
+	std::vector<uint8_t>         blob     = {};
+	std::array<uint8_t, 2>       pair     = {};
+	std::optional<int64_t>       maybe    = {};
+	std::optional<FieldsPoint_>  origin   = {};
+	std::vector<FieldsPoint_>    path     = {};
+	std::array<int32_t, 3>       triple   = {};
+	std::vector<std::string>     tag_list = {};
+	int64_t                      a_field_name_that_needs_str8_format = 0;
+};
+
+ZAKERO_MESSAGEPACK_FIELDS(FieldsRecord_
+	, flag, small, offset, id, scale, color, name, unit, blob, pair, maybe
+	, origin, path, triple, tag_list, a_field_name_that_needs_str8_format
+	)
+
+struct FieldsView_
+{
+	std::string_view         name = {};
+	std::span<const uint8_t> blob = {};
+};
+
+ZAKERO_MESSAGEPACK_FIELDS(FieldsView_, name, blob)
+
+struct FieldsChar_
+{
+	char     c   = 0;
+	char8_t  c8  = 0;
+	char16_t c16 = 0;
+	char32_t c32 = 0;
+	wchar_t  w   = 0;
+};
+
+ZAKERO_MESSAGEPACK_FIELDS(FieldsChar_, c, c8, c16, c32, w)
+
+struct FieldsWide_
+{
+	uint16_t f000 = 0, f001 = 0, f002 = 0, f003 = 0, f004 = 0, f005 = 0, f006 = 0, f007 = 0;
+	uint16_t f008 = 0, f009 = 0, f010 = 0, f011 = 0, f012 = 0, f013 = 0, f014 = 0, f015 = 0;
+	uint16_t f016 = 0, f017 = 0, f018 = 0, f019 = 0, f020 = 0, f021 = 0, f022 = 0, f023 = 0;
+	uint16_t f024 = 0, f025 = 0, f026 = 0, f027 = 0, f028 = 0, f029 = 0, f030 = 0, f031 = 0;
+	uint16_t f032 = 0, f033 = 0, f034 = 0, f035 = 0, f036 = 0, f037 = 0, f038 = 0, f039 = 0;
+	uint16_t f040 = 0, f041 = 0, f042 = 0, f043 = 0, f044 = 0, f045 = 0, f046 = 0, f047 = 0;
+	uint16_t f048 = 0, f049 = 0, f050 = 0, f051 = 0, f052 = 0, f053 = 0, f054 = 0, f055 = 0;
+	uint16_t f056 = 0, f057 = 0, f058 = 0, f059 = 0, f060 = 0, f061 = 0, f062 = 0, f063 = 0;
+	uint16_t f064 = 0, f065 = 0, f066 = 0, f067 = 0, f068 = 0, f069 = 0, f070 = 0, f071 = 0;
+	uint16_t f072 = 0, f073 = 0, f074 = 0, f075 = 0, f076 = 0, f077 = 0, f078 = 0, f079 = 0;
+	uint16_t f080 = 0, f081 = 0, f082 = 0, f083 = 0, f084 = 0, f085 = 0, f086 = 0, f087 = 0;
+	uint16_t f088 = 0, f089 = 0, f090 = 0, f091 = 0, f092 = 0, f093 = 0, f094 = 0, f095 = 0;
+	uint16_t f096 = 0, f097 = 0, f098 = 0, f099 = 0, f100 = 0, f101 = 0, f102 = 0, f103 = 0;
+	uint16_t f104 = 0, f105 = 0, f106 = 0, f107 = 0, f108 = 0, f109 = 0, f110 = 0, f111 = 0;
+	uint16_t f112 = 0, f113 = 0, f114 = 0, f115 = 0, f116 = 0, f117 = 0, f118 = 0, f119 = 0;
+	uint16_t f120 = 0, f121 = 0, f122 = 0, f123 = 0, f124 = 0, f125 = 0, f126 = 0, f127 = 0;
+	uint16_t f128 = 0, f129 = 0, f130 = 0, f131 = 0, f132 = 0, f133 = 0, f134 = 0, f135 = 0;
+	uint16_t f136 = 0, f137 = 0, f138 = 0, f139 = 0, f140 = 0, f141 = 0, f142 = 0, f143 = 0;
+	uint16_t f144 = 0, f145 = 0, f146 = 0, f147 = 0, f148 = 0, f149 = 0, f150 = 0, f151 = 0;
+	uint16_t f152 = 0, f153 = 0, f154 = 0, f155 = 0, f156 = 0, f157 = 0, f158 = 0, f159 = 0;
+	uint16_t f160 = 0, f161 = 0, f162 = 0, f163 = 0, f164 = 0, f165 = 0, f166 = 0, f167 = 0;
+	uint16_t f168 = 0, f169 = 0, f170 = 0, f171 = 0, f172 = 0, f173 = 0, f174 = 0, f175 = 0;
+	uint16_t f176 = 0, f177 = 0, f178 = 0, f179 = 0, f180 = 0, f181 = 0, f182 = 0, f183 = 0;
+	uint16_t f184 = 0, f185 = 0, f186 = 0, f187 = 0, f188 = 0, f189 = 0, f190 = 0, f191 = 0;
+	uint16_t f192 = 0, f193 = 0, f194 = 0, f195 = 0, f196 = 0, f197 = 0, f198 = 0, f199 = 0;
+	uint16_t f200 = 0, f201 = 0, f202 = 0, f203 = 0, f204 = 0, f205 = 0, f206 = 0, f207 = 0;
+	uint16_t f208 = 0, f209 = 0, f210 = 0, f211 = 0, f212 = 0, f213 = 0, f214 = 0, f215 = 0;
+	uint16_t f216 = 0, f217 = 0, f218 = 0, f219 = 0, f220 = 0, f221 = 0, f222 = 0, f223 = 0;
+	uint16_t f224 = 0, f225 = 0, f226 = 0, f227 = 0, f228 = 0, f229 = 0, f230 = 0, f231 = 0;
+	uint16_t f232 = 0, f233 = 0, f234 = 0, f235 = 0, f236 = 0, f237 = 0, f238 = 0, f239 = 0;
+	uint16_t f240 = 0, f241 = 0, f242 = 0, f243 = 0, f244 = 0, f245 = 0, f246 = 0, f247 = 0;
+	uint16_t f248 = 0, f249 = 0, f250 = 0, f251 = 0, f252 = 0, f253 = 0, f254 = 0, f255 = 0;
+};
+
+ZAKERO_MESSAGEPACK_FIELDS(FieldsWide_
+	, f000, f001, f002, f003, f004, f005, f006, f007, f008, f009, f010, f011, f012, f013, f014, f015
+	, f016, f017, f018, f019, f020, f021, f022, f023, f024, f025, f026, f027, f028, f029, f030, f031
+	, f032, f033, f034, f035, f036, f037, f038, f039, f040, f041, f042, f043, f044, f045, f046, f047
+	, f048, f049, f050, f051, f052, f053, f054, f055, f056, f057, f058, f059, f060, f061, f062, f063
+	, f064, f065, f066, f067, f068, f069, f070, f071, f072, f073, f074, f075, f076, f077, f078, f079
+	, f080, f081, f082, f083, f084, f085, f086, f087, f088, f089, f090, f091, f092, f093, f094, f095
+	, f096, f097, f098, f099, f100, f101, f102, f103, f104, f105, f106, f107, f108, f109, f110, f111
+	, f112, f113, f114, f115, f116, f117, f118, f119, f120, f121, f122, f123, f124, f125, f126, f127
+	, f128, f129, f130, f131, f132, f133, f134, f135, f136, f137, f138, f139, f140, f141, f142, f143
+	, f144, f145, f146, f147, f148, f149, f150, f151, f152, f153, f154, f155, f156, f157, f158, f159
+	, f160, f161, f162, f163, f164, f165, f166, f167, f168, f169, f170, f171, f172, f173, f174, f175
+	, f176, f177, f178, f179, f180, f181, f182, f183, f184, f185, f186, f187, f188, f189, f190, f191
+	, f192, f193, f194, f195, f196, f197, f198, f199, f200, f201, f202, f203, f204, f205, f206, f207
+	, f208, f209, f210, f211, f212, f213, f214, f215, f216, f217, f218, f219, f220, f221, f222, f223
+	, f224, f225, f226, f227, f228, f229, f230, f231, f232, f233, f234, f235, f236, f237, f238, f239
+	, f240, f241, f242, f243, f244, f245, f246, f247, f248, f249, f250, f251, f252, f253, f254, f255
+	)
+
+TEST_CASE("fields/round trip")
+{
+	FieldsRecord_ record;
+	record.flag     = true;
+	record.small    = -100;
+	record.offset   = -70'000'000'000;
+	record.id       = 4'000'000'000;
+	record.scale    = 0.125;
+	record.color    = FieldsColor_::Green;
+	record.name     = "telemetry";
+	record.unit     = std::pmr::string(40, 'u');
+	record.blob     = {1, 2, 3};
+	record.pair     = {4, 5};
+	record.maybe    = 7;
+	record.origin   = FieldsPoint_{1.5f, -2.5f};
+	record.path     = {{0, 0}, {1, 1}, {2, 4}};
+	record.triple   = {-1, 0, 1};
+	record.tag_list = {"a", "bb", ""};
+	record.a_field_name_that_needs_str8_format = 33;
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	CHECK(encode(record, packer) == Error_None);
+
+	FieldsRecord_ test;
+
+	CHECK(decode(data, test) == Error_None);
+	CHECK(test.flag     == record.flag);
+	CHECK(test.small    == record.small);
+	CHECK(test.offset   == record.offset);
+	CHECK(test.id       == record.id);
+	CHECK(test.scale    == record.scale);
+	CHECK(test.color    == record.color);
+	CHECK(test.name     == record.name);
+	CHECK(test.unit     == record.unit);
+	CHECK(test.blob     == record.blob);
+	CHECK(test.pair     == record.pair);
+	CHECK(test.maybe    == record.maybe);
+	CHECK(test.origin.has_value());
+	CHECK(test.origin->x == 1.5f);
+	CHECK(test.origin->y == -2.5f);
+	CHECK(test.path.size() == 3);
+	CHECK(test.path[2].y == 4);
+	CHECK(test.triple   == record.triple);
+	CHECK(test.tag_list == record.tag_list);
+	CHECK(test.a_field_name_that_needs_str8_format == 33);
+
+	// The same data as a Map
+
+	Object object = deserialize(data);
+	REQUIRE(object.isMap());
+
+	const Map& map = object.asMap();
+	CHECK(map.size() == 16);
+	CHECK(map.key(0).asString() == "flag");
+	CHECK(map.key(15).asString() == "a_field_name_that_needs_str8_format");
+	CHECK(map["name"].asString() == "telemetry");
+	CHECK(map["color"] == Object{uint64_t(2)});
+	CHECK(map["origin"].asMap()["y"] == Object{-2.5f});
+
+	// Empty optional values are Null
+
+	record.maybe.reset();
+	record.origin.reset();
+
+	data.clear();
+	Packer packer_null(data);
+	CHECK(encode(record, packer_null) == Error_None);
+
+	CHECK(deserialize(data).asMap()["maybe"].isNull());
+
+	CHECK(decode(data, test) == Error_None);
+	CHECK(test.maybe.has_value()  == false);
+	CHECK(test.origin.has_value() == false);
+}
+
+TEST_CASE("fields/map")
+{
+	Map map;
+	map["x"] = Object{0.25f};
+	map["y"] = Object{-8.0f};
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	CHECK(encode(FieldsPoint_{0.25f, -8.0f}, packer) == Error_None);
+	CHECK(data == serialize(map));
+
+	// Key order, unknown keys, and missing fields
+
+	map.clear();
+	map["extra"] = Object{Array{}};
+	map["y"]     = Object{int64_t(3)};
+	map[int64_t(1)] = Object{"not a field"};
+	map["z"]     = Object{Map{}};
+
+	FieldsPoint_ point = {7, 0};
+
+	CHECK(decode(serialize(map), point) == Error_None);
+	CHECK(point.x == 7);
+	CHECK(point.y == 3);
+}
+
+TEST_CASE("fields/view")
+{
+	Map map;
+	map["name"] = Object{"view"};
+	map["blob"] = Object{std::pmr::vector<uint8_t>{9, 8, 7}};
+
+	const std::vector<uint8_t> data = serialize(map);
+
+	FieldsView_ view;
+
+	CHECK(decode(data, view) == Error_None);
+	CHECK(view.name == "view");
+	CHECK(view.blob.size() == 3);
+	CHECK(view.blob[0] == 9);
+	CHECK((const uint8_t*)view.name.data() >= data.data());
+	CHECK((const uint8_t*)view.name.data() <  data.data() + data.size());
+}
+
+TEST_CASE("fields/char")
+{
+	const FieldsChar_ text = { 'a', u8'b', u'\u00e9', U'\U0001f600', L'w' };
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	CHECK(encode(text, packer) == Error_None);
+
+	FieldsChar_ test;
+
+	CHECK(decode(data, test) == Error_None);
+	CHECK(test.c   == text.c);
+	CHECK(test.c8  == text.c8);
+	CHECK(test.c16 == text.c16);
+	CHECK(test.c32 == text.c32);
+	CHECK(test.w   == text.w);
+
+	CHECK(deserialize(data).asMap()["c32"] == Object{uint64_t(0x1f600)});
+
+	Map map;
+	map["c16"] = Object{uint64_t(70'000)};
+	CHECK(decode(serialize(map), test) == Error_Type_Mismatch);
+
+	map.clear();
+	map["c8"] = Object{int64_t(-1)};
+	CHECK(decode(serialize(map), test) == Error_Type_Mismatch);
+	CHECK(test.c8 == text.c8);
+}
+
+TEST_CASE("fields/wide")
+{
+	// The most fields that ZAKERO_MESSAGEPACK_FIELDS() supports
+
+	FieldsWide_ wide;
+	wide.f000 = 1;
+	wide.f128 = 129;
+	wide.f255 = 256;
+
+	std::vector<uint8_t> data;
+	Packer packer(data);
+
+	CHECK(encode(wide, packer) == Error_None);
+
+	Object object = deserialize(data);
+	REQUIRE(object.isMap());
+	CHECK(object.asMap().size() == 256);
+	CHECK(object.asMap().key(255).asString() == "f255");
+	CHECK(object.asMap()["f255"] == Object{uint64_t(256)});
+
+	FieldsWide_ test;
+
+	CHECK(decode(data, test) == Error_None);
+	CHECK(test.f000 == 1);
+	CHECK(test.f001 == 0);
+	CHECK(test.f128 == 129);
+	CHECK(test.f255 == 256);
+}
+
+TEST_CASE("fields/error")
+{
+	FieldsRecord_ record;
+
+	CHECK(decode(std::span<const uint8_t>{}, record) == Error_No_Data);
+	CHECK(decode(serialize(Object{int64_t(1)}), record) == Error_Type_Mismatch);
+
+	Map map;
+	map["small"] = Object{int64_t(200)};
+	CHECK(decode(serialize(map), record) == Error_Type_Mismatch);
+
+	map.clear();
+	map["id"] = Object{int64_t(-1)};
+	CHECK(decode(serialize(map), record) == Error_Type_Mismatch);
+
+	map.clear();
+	map["name"] = Object{int64_t(1)};
+	CHECK(decode(serialize(map), record) == Error_Type_Mismatch);
+
+	map.clear();
+	map["pair"] = Object{std::pmr::vector<uint8_t>{1, 2, 3}};
+	CHECK(decode(serialize(map), record) == Error_Type_Mismatch);
+
+	map.clear();
+	map["triple"] = Object{Array{}};
+	CHECK(decode(serialize(map), record) == Error_Type_Mismatch);
+
+	map.clear();
+	map["origin"] = Object{"nowhere"};
+	map["maybe"]  = Object{"nothing"};
+	CHECK(decode(serialize(map), record) == Error_Type_Mismatch);
+	CHECK(record.origin.has_value() == false);
+	CHECK(record.maybe.has_value()  == false);
+
+	record.maybe = 5;
+	map.erase(Object{"origin"});
+	CHECK(decode(serialize(map), record) == Error_Type_Mismatch);
+	CHECK(record.maybe == 5);
+
+	map.clear();
+	map["flag"] = Object{true};
+	map["name"] = Object{"truncated"};
+
+	std::vector<uint8_t> data = serialize(map);
+	data.resize(data.size() - 2);
+
+	CHECK(decode(data, record) == Error_Incomplete);
+	CHECK(record.flag == true);
+}
+#endif // }}}
+
+// }}} Fields
+// {{{ Extensions
+// {{{ Extensions: Timestamp
+
+/**
+ * \brief Timestamp Extension Check.
+ *
+ * Use this method to determine if the \p object is a MessagePack Timestamp 
+ * Extension.
+ *
+ * \parcode
+ * std::vector<uint8_t> data = getSerializedData();
+ * zakero::messagepack::Object obj = zakero::messagepack::deserialize(data);
+ *
+ * if(zakero::messagepack::extensionTimestampCheck(obj) == false)
+ * {
+ * 	return ERROR_INVALID_TIMESTAMP;
+ * }
+ * \endparcode
+ *
+ * \retval true  The \p object is a Timestamp extension.
+ * \retval false The \p object is not a Timestamp extension.
+ */
+bool extensionTimestampCheck(const Object& object ///< The Ext to check.
+	) noexcept
+{
+	if(object.isExt() == true)
+	{
+		const Ext& ext = object.asExt();
+
+		if(ext.type == -1)
+		{
+			if(ext.data.size() == 4
+				|| ext.data.size() == 8
+				|| ext.data.size() == 12
+				)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("extension/timestamp/check")
+{
+	Object object = {Ext{}};
+	Ext& ext      = object.asExt();
+
+	CHECK(extensionTimestampCheck(object) == false);
+
+	// --- Bad Ext.type value --- //
+
+	ext.data = std::pmr::vector<uint8_t>();
+	CHECK(extensionTimestampCheck(object) == false);
+
+	ext.data = std::pmr::vector<uint8_t>(1, 0);
+	CHECK(extensionTimestampCheck(object) == false);
+
+	ext.data = std::pmr::vector<uint8_t>(4, 0);
+	CHECK(extensionTimestampCheck(object) == false);
+
+	ext.data = std::pmr::vector<uint8_t>(8, 0);
+	CHECK(extensionTimestampCheck(object) == false);
+
+	ext.data = std::pmr::vector<uint8_t>(12, 0);
+	CHECK(extensionTimestampCheck(object) == false);
+
+	// --- Good Ext.type value --- //
+
+	ext.type = -1;
+	ext.data = std::pmr::vector<uint8_t>();
+	CHECK(extensionTimestampCheck(object) == false);
+
+	ext.data = std::pmr::vector<uint8_t>();
+	CHECK(extensionTimestampCheck(object) == false);
+
+	ext.data = std::pmr::vector<uint8_t>(1, 0);
+	CHECK(extensionTimestampCheck(object) == false);
+
+	ext.data = std::pmr::vector<uint8_t>(4, 0);
+	CHECK(extensionTimestampCheck(object) == true);
+
+	ext.data = std::pmr::vector<uint8_t>(8, 0);
+	CHECK(extensionTimestampCheck(object) == true);
+
+	ext.data = std::pmr::vector<uint8_t>(12, 0);
+	CHECK(extensionTimestampCheck(object) == true);
+}
+#endif // }}}
+
+
+/**
+ * \brief Convert MessagePack Timestamp extension into a `struct timespec`.
+ *
+ * Conversion from Object to `struct timespec` is performed by this method. If 
+ * the provided \p object is not a valid Timestamp extension then an empty 
+ * `struct timespec` will be returned.
+ *
+ * \parcode
+ * std::vector<uint8_t> data = getSerializedData();
+ * zakero::messagepack::Object obj = zakero::messagepack::deserialize(data);
+ * struct timespec ts = zakero::messagepack::extensionTimestampConvert(obj);
+ *
+ * char buf[128];
+ * std::strftime(buf, sizeof(buf), "%D %T", std::gmtime(&ts.tv_sec));
+ * std::printf("Time: %s.%09ld UTC\n", buf, ts.tv_nsec);
+ * \endparcode
+ *
+ * \return A `struct timespec`.
+ */
+struct timespec extensionTimestampConvert(const Object& object ///< The Ext data.
+	) noexcept
+{
+	if(object.isExt() == false)
+	{
+		return {};
+	}
+
+	const Ext& ext = object.asExt();
+
+	if(ext.type != -1)
+	{
+		return {};
+	}
+
+	switch(ext.data.size())
+	{
+		case 4:
+		{
+			timespec ts =
+			{	.tv_sec  = fromBigEndian<uint32_t>(&ext.data[0])
+			,	.tv_nsec = 0
+			};
+
+			return ts;
+		}
+
+		case 8:
+		{
+			const uint64_t value = fromBigEndian<uint64_t>(&ext.data[0]);
+			const uint32_t nsec  = (uint32_t)(value >> 34);
+			const int64_t  sec   = (int64_t)(value & 0x0000'0003'ffff'ffff);
+
+			timespec ts =
+			{	.tv_sec  = sec
+			,	.tv_nsec = nsec
+			};
+
+			return ts;
+		}
+
+		case 12:
+		{
+			const uint32_t nsec = fromBigEndian<uint32_t>(&ext.data[0]);
+			const int64_t  sec  = fromBigEndian<int64_t>(&ext.data[4]);
+
+			timespec ts =
+			{	.tv_sec  = sec
+			,	.tv_nsec = nsec
+			};
+
+			return ts;
+		}
+	}
+
+	return {};
+}
+
+
+// Test is below
+
+
+/**
+ * \brief Convert a `struct timespec` into a MessagePack Timestamp extension.
+ *
+ * Conversion from a `struct timespec` into the MessagePack Timestamp extension 
+ * is handled by this method.
+ *
+ * \parcode
+ * std::timespec ts;
+ * std::timespec_get(&ts, TIME_UTC);
+ *
+ * zakero::messagepack::Object object =
+ * 	zakero::messagepack::extensionTimestampConvert(ts);
+ *
+ * std::vector<uint8_t> data = zakero::messagepack::serialize(object);
+ * \endparcode
+ *
+ * \return A MessagePack Object.
+ */
+Object extensionTimestampConvert(const struct timespec& ts ///< The time data
+	) noexcept
+{
+	Object object = {Ext{}};
+	Ext&   ext    = object.asExt();
+
+	if((ts.tv_sec >> 34) == 0)
+	{
+		const uint64_t value = (ts.tv_nsec << 34) | ts.tv_sec;
+		if((value & 0xffff'ffff'0000'0000) == 0)
+		{
+			ext.type = -1;
+			ext.data.resize(4);
+
+			toBigEndian((uint32_t)value, &ext.data[0]);
+
+			return object;
+		}
+
+		ext.type = -1;
+		ext.data.resize(8);
+
+		toBigEndian(value, &ext.data[0]);
+
+		return object;
+	}
+
+	ext.type = -1;
+	ext.data.resize(12);
+
+	toBigEndian((uint32_t)ts.tv_nsec, &ext.data[0]);
+	toBigEndian((int64_t)ts.tv_sec,   &ext.data[4]);
+
+	return object;
+}
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("extension/timestamp/convert/32bit")
+{
+	SUBCASE("min")
+	{
+		const uint64_t sec  = 0;
+		const uint32_t nsec = 0;
+
+		struct timespec time =
+		{	.tv_sec  = sec
+		,	.tv_nsec = nsec
+		};
+
+		Object object = extensionTimestampConvert(time);
+		{
+			Ext& ext = object.asExt();
+			CHECK(ext.type        == -1);
+			CHECK(ext.data.size() == 4);
+		}
+
+		std::vector<uint8_t> data = serialize(object);
+		CHECK(data.size() == 6);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext4);
+		CHECK(data[index++] == (uint8_t)-1);
+		CHECK(data[index++] == 0);
+		CHECK(data[index++] == 0);
+		CHECK(data[index++] == 0);
+		CHECK(data[index++] == 0);
+
+		object = deserialize(data);
+		CHECK(object.isExt() == true);
+
+		Ext& ext = object.asExt();
+		CHECK(ext.type        == -1);
+		CHECK(ext.data.size() == 4);
+
+		time = extensionTimestampConvert(object);
+		CHECK(time.tv_sec  == sec);
+		CHECK(time.tv_nsec == nsec);
+	}
+
+	SUBCASE("max")
+	{
+		const uint64_t sec  = 0x0000'0000'ffff'ffff;
+		const uint32_t nsec = 0;
+
+		struct timespec time =
+		{	.tv_sec  = sec
+		,	.tv_nsec = nsec
+		};
+
+		Object object = extensionTimestampConvert(time);
+		{
+			Ext& ext = object.asExt();
+			CHECK(ext.type        == -1);
+			CHECK(ext.data.size() == 4);
+		}
+
+		std::vector<uint8_t> data = serialize(object);
+		CHECK(data.size() == 6);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext4);
+		CHECK(data[index++] == (uint8_t)-1);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+
+		object = deserialize(data);
+		CHECK(object.isExt() == true);
+
+		Ext& ext = object.asExt();
+		CHECK(ext.type        == -1);
+		CHECK(ext.data.size() == 4);
+
+		time = extensionTimestampConvert(object);
+		CHECK(time.tv_sec  == sec);
+		CHECK(time.tv_nsec == nsec);
+	}
+
+	SUBCASE("pattern")
+	{
+		const uint64_t sec  = 0x12345678;
+		const uint32_t nsec = 0;
+
+		struct timespec time =
+		{	.tv_sec  = sec
+		,	.tv_nsec = nsec
+		};
+
+		Object object = extensionTimestampConvert(time);
+		{
+			Ext& ext = object.asExt();
+			CHECK(ext.type        == -1);
+			CHECK(ext.data.size() == 4);
+		}
+
+		std::vector<uint8_t> data = serialize(object);
+		CHECK(data.size() == 6);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext4);
+		CHECK(data[index++] == (uint8_t)-1);
+		CHECK(data[index++] == 0x12);
+		CHECK(data[index++] == 0x34);
+		CHECK(data[index++] == 0x56);
+		CHECK(data[index++] == 0x78);
+
+		object = deserialize(data);
+		CHECK(object.isExt() == true);
+
+		Ext& ext = object.asExt();
+		CHECK(ext.type        == -1);
+		CHECK(ext.data.size() == 4);
+
+		time = extensionTimestampConvert(object);
+		CHECK(time.tv_sec  == sec);
+		CHECK(time.tv_nsec == nsec);
+	}
+}
+
+TEST_CASE("extension/timestamp/convert/64bit")
+{
+	SUBCASE("min")
+	{
+		const uint64_t sec  = 0x0000'0002'0000'0000;
+		const uint32_t nsec = 0;
+
+		struct timespec time =
+		{	.tv_sec  = sec
+		,	.tv_nsec = nsec
+		};
+
+		Object object = extensionTimestampConvert(time);
+		{
+			Ext& ext = object.asExt();
+			CHECK(ext.type        == -1);
+			CHECK(ext.data.size() == 8);
+		}
+
+		std::vector<uint8_t> data = serialize(object);
+		CHECK(data.size() == 10);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext8);
+		CHECK(data[index++] == (uint8_t)-1);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x02);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+
+		object = deserialize(data);
+		CHECK(object.isExt() == true);
+
+		Ext& ext = object.asExt();
+		CHECK(ext.type        == -1);
+		CHECK(ext.data.size() == 8);
+
+		time = extensionTimestampConvert(object);
+		CHECK(time.tv_sec  == sec);
+		CHECK(time.tv_nsec == nsec);
+	}
+
+	SUBCASE("max")
+	{
+		const uint64_t sec  = 0x0000'0003'ffff'ffff;
+		const uint32_t nsec = 0x3fff'ffff;
+
+		struct timespec time =
+		{	.tv_sec  = sec
+		,	.tv_nsec = nsec
+		};
+
+		Object object = extensionTimestampConvert(time);
+		{
+			Ext& ext = object.asExt();
+			CHECK(ext.type        == -1);
+			CHECK(ext.data.size() == 8);
+		}
+
+		std::vector<uint8_t> data = serialize(object);
+		CHECK(data.size() == 10);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext8);
+		CHECK(data[index++] == (uint8_t)-1);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+
+		object = deserialize(data);
+		CHECK(object.isExt() == true);
+
+		Ext& ext = object.asExt();
+		CHECK(ext.type        == -1);
+		CHECK(ext.data.size() == 8);
+
+		time = extensionTimestampConvert(object);
+		CHECK(time.tv_sec  == sec);
+		CHECK(time.tv_nsec == nsec);
+	}
+
+	SUBCASE("pattern")
+	{
+		const uint64_t sec  = 0x0000'0001'2345'6789;
+		const uint32_t nsec = 0x0fed'cba9;
+		// 0x0fed'cba9
+		// 0b0000'1111'1110'1101'1100'1011'1010'1001
+		//                                      << 2
+		// 0b0011'1111'1011'0111'0010'1110'1010'0100
+		// 0x3fb7'2ea4
+
+		struct timespec time =
+		{	.tv_sec  = sec
+		,	.tv_nsec = nsec
+		};
+
+		Object object = extensionTimestampConvert(time);
+		{
+			Ext& ext = object.asExt();
+			CHECK(ext.type        == -1);
+			CHECK(ext.data.size() == 8);
+		}
+
+		std::vector<uint8_t> data = serialize(object);
+		CHECK(data.size() == 10);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Fixed_Ext8);
+		CHECK(data[index++] == (uint8_t)-1);
+		CHECK(data[index++] == 0x3f);
+		CHECK(data[index++] == 0xb7);
+		CHECK(data[index++] == 0x2e);
+		CHECK(data[index++] == 0xa5); // 0xa4 | 0x01
+		CHECK(data[index++] == 0x23);
+		CHECK(data[index++] == 0x45);
+		CHECK(data[index++] == 0x67);
+		CHECK(data[index++] == 0x89);
+
+		object = deserialize(data);
+		CHECK(object.isExt() == true);
+
+		Ext& ext = object.asExt();
+		CHECK(ext.type        == -1);
+		CHECK(ext.data.size() == 8);
+
+		time = extensionTimestampConvert(object);
+		CHECK(time.tv_sec  == sec);
+		CHECK(time.tv_nsec == nsec);
+	}
+}
+
+TEST_CASE("extension/timestamp/convert/96bit")
+{
+	SUBCASE("min")
+	{
+		const int64_t  sec  = 0x0000'0004'0000'0000;
+		const uint64_t nsec = 0x0000'0000;
+
+		struct timespec time =
+		{	.tv_sec  = sec
+		,	.tv_nsec = nsec
+		};
+
+		Object object = extensionTimestampConvert(time);
+		{
+			Ext& ext = object.asExt();
+			CHECK(ext.type        == -1);
+			CHECK(ext.data.size() == 12);
+		}
+
+		std::vector<uint8_t> data = serialize(object);
+		CHECK(data.size() == 15);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext8);
+		CHECK(data[index++] == 12);
+		CHECK(data[index++] == (uint8_t)-1);
+		// nsec
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		// sec
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x04);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+		CHECK(data[index++] == 0x00);
+
+		object = deserialize(data);
+		CHECK(object.isExt() == true);
+
+		Ext& ext = object.asExt();
+		CHECK(ext.type        == -1);
+		CHECK(ext.data.size() == 12);
+
+		time = extensionTimestampConvert(object);
+		CHECK(time.tv_sec  == sec);
+		CHECK(time.tv_nsec == nsec);
+	}
+
+	SUBCASE("max")
+	{
+		const int64_t  sec  = 0x7fff'ffff'ffff'ffff;
+		const uint64_t nsec = 0xffff'ffff;
+
+		struct timespec time =
+		{	.tv_sec  = sec
+		,	.tv_nsec = nsec
+		};
+
+		Object object = extensionTimestampConvert(time);
+		{
+			Ext& ext = object.asExt();
+			CHECK(ext.type        == -1);
+			CHECK(ext.data.size() == 12);
+		}
+
+		std::vector<uint8_t> data = serialize(object);
+		CHECK(data.size() == 15);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext8);
+		CHECK(data[index++] == 12);
+		CHECK(data[index++] == (uint8_t)-1);
+		// nsec
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		// sec
+		CHECK(data[index++] == 0x7f);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+		CHECK(data[index++] == 0xff);
+
+		object = deserialize(data);
+		CHECK(object.isExt() == true);
+
+		Ext& ext = object.asExt();
+		CHECK(ext.type        == -1);
+		CHECK(ext.data.size() == 12);
+
+		time = extensionTimestampConvert(object);
+		CHECK(time.tv_sec  == sec);
+		CHECK(time.tv_nsec == nsec);
+	}
+
+	SUBCASE("pattern")
+	{
+		const int64_t  sec  = 0x1234'5678'9abc'def0;
+		const uint64_t nsec = 0xfedc'ba98;
+
+		struct timespec time =
+		{	.tv_sec  = sec
+		,	.tv_nsec = nsec
+		};
+
+		Object object = extensionTimestampConvert(time);
+		{
+			Ext& ext = object.asExt();
+			CHECK(ext.type        == -1);
+			CHECK(ext.data.size() == 12);
+		}
+
+		std::vector<uint8_t> data = serialize(object);
+		CHECK(data.size() == 15);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext8);
+		CHECK(data[index++] == 12);
+		CHECK(data[index++] == (uint8_t)-1);
+		// nsec
+		CHECK(data[index++] == 0xfe);
+		CHECK(data[index++] == 0xdc);
+		CHECK(data[index++] == 0xba);
+		CHECK(data[index++] == 0x98);
+		// sec
+		CHECK(data[index++] == 0x12);
+		CHECK(data[index++] == 0x34);
+		CHECK(data[index++] == 0x56);
+		CHECK(data[index++] == 0x78);
+		CHECK(data[index++] == 0x9a);
+		CHECK(data[index++] == 0xbc);
+		CHECK(data[index++] == 0xde);
+		CHECK(data[index++] == 0xf0);
+
+		object = deserialize(data);
+		CHECK(object.isExt() == true);
+
+		Ext& ext = object.asExt();
+		CHECK(ext.type        == -1);
+		CHECK(ext.data.size() == 12);
+
+		time = extensionTimestampConvert(object);
+		CHECK(time.tv_sec  == sec);
+		CHECK(time.tv_nsec == nsec);
+	}
+}
+#endif // }}}
+// }}} Extensions: Timestamp
+// {{{ Extensions: Typed Array
+
+/**
+ * \var zakero::messagepack::Extension_Typed_Array
+ *
+ * \brief The Ext type of the Typed Array extension.
+ *
+ * A Typed Array holds a contiguous array of numbers that all have the same 
+ * type. Instead of packing every number as its own MessagePack value, the 
+ * numbers are copied into the extension data as-is. A large array can be 
+ * packed with a single `memcpy()` and read without decoding the values.
+ *
+ * The extension data is:
+ * | Size    | Content                                             |
+ * |---------|-----------------------------------------------------|
+ * | 1       | The element code                                    |
+ * | 1       | The number of padding bytes (0 to 7)                |
+ * | padding | Zeros, to align the values in memory                |
+ * | N       | The values, little-endian                           |
+ *
+ * The element code has the kind of number in the high nibble (0: unsigned, 
+ * 1: signed, 2: floating point) and the size of the number in bytes in the 
+ * low nibble. For example, `float` is 0x24 and `int16_t` is 0x12.
+ *
+ * The value is the last of the application Ext types, which makes a 
+ * conflict with the Ext types of an application unlikely.
+ */
+
+
+/**
+ * \brief Typed Array Extension Check.
+ *
+ * Use this method to determine if the \p object is a Typed Array extension 
+ * with valid contents.
+ *
+ * \retval true  The \p object is a Typed Array extension.
+ * \retval false The \p object is not a Typed Array extension.
+ */
+bool extensionTypedArrayCheck(const Object& object ///< The Ext to check.
+	) noexcept
+{
+	if(object.isExt() == false)
+	{
+		return false;
+	}
+
+	const Ext& ext = object.asExt();
+
+	return extensionTypedArrayCheck(ExtView{ext.data, ext.type});
+}
+
+
+/**
+ * \brief Typed Array Extension Check.
+ *
+ * \copydetails extensionTypedArrayCheck(const Object&)
+ */
+bool extensionTypedArrayCheck(const ExtView& ext ///< The Ext to check.
+	) noexcept
+{
+	std::span<const uint8_t> data;
+
+	return !extensionTypedArrayData_(ext.type, ext.data, 0, data);
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("extension/typedarray/check")
+{
+	Object object = {Ext{}};
+	Ext& ext      = object.asExt();
+
+	CHECK(extensionTypedArrayCheck(Object{}) == false);
+	CHECK(extensionTypedArrayCheck(object) == false);
+
+	ext.type = Extension_Typed_Array;
+	CHECK(extensionTypedArrayCheck(object) == false);
+
+	ext.data = {0x24, 0};
+	CHECK(extensionTypedArrayCheck(object) == true);
+
+	ext.data = {0x24, 2, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8};
+	CHECK(extensionTypedArrayCheck(object) == true);
+	CHECK(extensionTypedArrayCheck(ExtView{ext.data, ext.type}) == true);
+
+	// --- Bad Ext.type value --- //
+
+	ext.type = -1;
+	CHECK(extensionTypedArrayCheck(object) == false);
+	ext.type = Extension_Typed_Array;
+
+	// --- Bad element code --- //
+
+	for(const uint8_t code : {0x00, 0x03, 0x10, 0x16, 0x21, 0x22, 0x34})
+	{
+		ext.data = {code, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+		CHECK(extensionTypedArrayCheck(object) == false);
+	}
+
+	// --- Bad size --- //
+
+	ext.data = {0x24, 0, 1, 2, 3};
+	CHECK(extensionTypedArrayCheck(object) == false);
+
+	ext.data = {0x24, 8, 0, 0, 0, 0, 0, 0, 0, 0};
+	CHECK(extensionTypedArrayCheck(object) == false);
+
+	ext.data = {0x24, 3, 0, 0};
+	CHECK(extensionTypedArrayCheck(object) == false);
+
+	ext.data = {0x24};
+	CHECK(extensionTypedArrayCheck(object) == false);
+}
+#endif // }}}
+
+
+/**
+ * \brief Create a Typed Array extension.
+ *
+ * The \p value bytes, in the byte order of the CPU, are copied into the 
+ * extension data. Padding is added so that the values are aligned in the 
+ * extension data.
+ *
+ * \see extensionTypedArrayCreate()
+ *
+ * \return A MessagePack Object.
+ */
+Object extensionTypedArrayCreate_(const uint8_t element ///< The element code
+	, const std::span<const std::byte>      value   ///< The values
+	) noexcept
+{
+	const size_t size = element & 0x0f;
+	const size_t pad  = (size - (2 % size)) % size;
+
+	Object object = {Ext{}};
+	Ext&   ext    = object.asExt();
+
+	ext.type = Extension_Typed_Array;
+	ext.data.resize(2 + pad + value.size());
+	ext.data[0] = element;
+	ext.data[1] = (uint8_t)pad;
+
+	extensionTypedArrayCopy_({(const uint8_t*)value.data(), value.size()}
+		, size
+		, ext.data.data() + 2 + pad
+		);
+
+	return object;
+}
+
+
+/**
+ * \brief Find the values of a Typed Array extension.
+ *
+ * The layout of the \p data is checked and \p values is set to the bytes 
+ * of the values. An \p element of 0 will match any element code.
+ *
+ * \retval Error_Invalid_Format_Type The data is not a Typed Array.
+ * \retval Error_Type_Mismatch       The element code is not \p element.
+ *
+ * \return An error code.
+ */
+std::error_code extensionTypedArrayData_(const int8_t type    ///< The Ext type
+	, const std::span<const uint8_t>               data    ///< The Ext data
+	, const uint8_t                                element ///< The element code
+	, std::span<const uint8_t>&                    values  ///< The values
+	) noexcept
+{
+	if(type != Extension_Typed_Array || data.size() < 2)
+	{
+		return Error_Invalid_Format_Type;
+	}
+
+	const uint8_t code = data[0];
+	const size_t  kind = code >> 4;
+	const size_t  size = code & 0x0f;
+	const size_t  pad  = data[1];
+
+	if(std::has_single_bit(size) == false
+		|| size > 8
+		|| kind > 2
+		|| (kind == 2 && size < 4)
+		)
+	{
+		return Error_Invalid_Format_Type;
+	}
+
+	if(pad > 7
+		|| 2 + pad > data.size()
+		|| (data.size() - 2 - pad) % size != 0
+		)
+	{
+		return Error_Invalid_Format_Type;
+	}
+
+	if(element != 0 && element != code)
+	{
+		return Error_Type_Mismatch;
+	}
+
+	values = data.subspan(2 + pad);
+
+	return Error_None;
+}
+
+
+/**
+ * \brief Copy the values of a Typed Array.
+ *
+ * The \p data is copied to the \p destination, converting each \p size 
+ * byte value between little-endian and the byte order of the CPU.
+ */
+void extensionTypedArrayCopy_(const std::span<const uint8_t> data        ///< The values
+	, const size_t                                 size        ///< The size of a value
+	, uint8_t*                                     destination ///< Where to copy
+	) noexcept
+{
+	if(data.empty())
+	{
+		return;
+	}
+
+	if constexpr(std::endian::native == std::endian::little)
+	{
+		memcpy(destination, data.data(), data.size());
+	}
+	else
+	{
+		for(size_t i = 0; i < data.size(); i += size)
+		{
+			for(size_t b = 0; b < size; b++)
+			{
+				destination[i + b] = data[i + size - 1 - b];
+			}
+		}
+	}
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("extension/typedarray/object")
+{
+	auto check = [&]<typename T>(const std::vector<T>& value)
+	{
+		Object object = extensionTypedArrayCreate<T>(value);
+
+		CHECK(extensionTypedArrayCheck(object) == true);
+		CHECK(object.asExt().type == Extension_Typed_Array);
+		CHECK(object.asExt().data[0] == typedArrayElement_<T>());
+
+		const std::span<const T> view = extensionTypedArrayView<T>(object);
+		CHECK(view.size() == value.size());
+		CHECK(std::ranges::equal(view, value));
+
+		if(view.empty() == false)
+		{
+			CHECK((const uint8_t*)view.data() >= object.asExt().data.data());
+			CHECK((const uint8_t*)view.data() <  object.asExt().data.data() + object.asExt().data.size());
+		}
+
+		CHECK(extensionTypedArrayConvert<T>(object) == value);
+
+		// Serialize and deserialize
+
+		const std::vector<uint8_t> data = serialize(object);
+
+		Object copy = deserialize(data);
+		CHECK(extensionTypedArrayCheck(copy) == true);
+		CHECK(extensionTypedArrayConvert<T>(copy) == value);
+	};
+
+	check(std::vector<int8_t>{-1, 0, 1, 127});
+	check(std::vector<uint8_t>{});
+	check(std::vector<int16_t>{-300, 300});
+	check(std::vector<uint16_t>{65'535});
+	check(std::vector<int32_t>{std::numeric_limits<int32_t>::min(), 7});
+	check(std::vector<uint32_t>{1, 2, 3});
+	check(std::vector<int64_t>{std::numeric_limits<int64_t>::max(), -1});
+	check(std::vector<uint64_t>{42});
+	check(std::vector<float>{0.5f, -1.25f, 3.0f});
+	check(std::vector<double>(100, 2.5));
+
+	// --- Little-endian data --- //
+
+	Object object = extensionTypedArrayCreate<uint32_t>(std::vector<uint32_t>{0x01020304});
+	const Ext& ext = object.asExt();
+	CHECK(ext.data.size() == 8);
+	CHECK(ext.data[1] == 2);
+	CHECK(ext.data[4] == 0x04);
+	CHECK(ext.data[7] == 0x01);
+
+	// --- Type mismatch --- //
+
+	CHECK(extensionTypedArrayView<double>(object).empty());
+	CHECK(extensionTypedArrayView<int32_t>(object).empty());
+	CHECK(extensionTypedArrayConvert<float>(object).empty());
+	CHECK(extensionTypedArrayView<uint32_t>(Object{true}).empty());
+	CHECK(extensionTypedArrayConvert<uint32_t>(Object{true}).empty());
+	CHECK(extensionTypedArrayView<uint32_t>(extensionTimestampConvert(timespec{})).empty());
+}
+
+TEST_CASE("extension/typedarray/packer")
+{
+	std::vector<double> value(1'000);
+	for(size_t i = 0; i < value.size(); i++)
+	{
+		value[i] = double(i) * -0.5;
+	}
+
+	for(size_t prefix = 0; prefix < 9; prefix++)
+	{
+		for(const size_t count : {size_t(0), size_t(1), size_t(20), value.size()})
+		{
+			const std::span<const double> range(value.data(), count);
+
+			std::vector<uint8_t> data;
+			Packer packer(data);
+
+			for(size_t i = 0; i < prefix; i++)
+			{
+				packer.packNull();
+			}
+
+			CHECK(packer.packTypedArray(range) == Error_None);
+			CHECK(packer.size() == data.size());
+
+			size_t          index = prefix;
+			std::error_code error;
+
+			ObjectView view(data, index, error);
+			CHECK(error == Error_None);
+			CHECK(index == data.size());
+			CHECK(view.isExt());
+
+			const std::span<const double> values = extensionTypedArrayView<double>(view.asExt());
+			CHECK(values.size() == count);
+			CHECK(std::ranges::equal(values, range));
+
+			if(count > 0)
+			{
+				CHECK((const uint8_t*)values.data() > data.data());
+				CHECK((const uint8_t*)values.data() < data.data() + data.size());
+			}
+
+			index = prefix;
+			Object object = deserialize(data, index);
+			CHECK(extensionTypedArrayCheck(object) == true);
+			CHECK(std::ranges::equal(extensionTypedArrayConvert<double>(object), range));
+		}
+	}
+}
+
+TEST_CASE("extension/typedarray/packer/span")
+{
+	const std::vector<float> value(100, 1.5f);
+
+	alignas(16) std::array<uint8_t, 512> buffer = {};
+
+	for(size_t offset = 0; offset < 4; offset++)
+	{
+		Packer packer(std::span<uint8_t>{buffer.data() + offset, buffer.size() - offset});
+
+		packer.packBool(true);
+		CHECK(packer.packTypedArray<float>(value) == Error_None);
+
+		ObjectView view(std::span<const uint8_t>{buffer.data() + offset + 1, packer.size() - 1});
+		CHECK(std::ranges::equal(extensionTypedArrayView<float>(view.asExt()), value));
+	}
+
+	Packer small(std::span<uint8_t>{buffer.data(), 100});
+	CHECK(small.packTypedArray<float>(value) == Error_Buffer_Too_Small);
+}
+
+TEST_CASE("extension/typedarray/packer/sink")
+{
+	std::vector<int16_t> value(10'000);
+	for(size_t i = 0; i < value.size(); i++)
+	{
+		value[i] = int16_t(i * 7);
+	}
+
+	std::vector<uint8_t> data;
+	Packer packer([&](std::span<const uint8_t> part)
+		{
+			data.insert(data.end(), part.begin(), part.end());
+		}
+		, 64
+		);
+
+	packer.packUint(1);
+	CHECK(packer.packTypedArray<int16_t>(value) == Error_None);
+	packer.packUint(2);
+	packer.flush();
+
+	CHECK(packer.size() == data.size());
+
+	size_t index = 0;
+	CHECK(deserialize(data, index).as<uint64_t>() == 1);
+
+	const ObjectView view(std::span<const uint8_t>(data).subspan(index));
+	CHECK(std::ranges::equal(extensionTypedArrayView<int16_t>(view.asExt()), value));
+
+	Object object = deserialize(data, index);
+	CHECK(extensionTypedArrayConvert<int16_t>(object) == value);
+	CHECK(deserialize(data, index).as<uint64_t>() == 2);
+	CHECK(index == data.size());
+}
+#endif // }}}
+
+// }}} Extensions: Typed Array
+// }}} Extensions
+// {{{ Utilities
+// {{{ Utilities::deserialize
+
+/**
+ * \brief Deserialize MessagePack data.
+ *
+ * The packed vector of \p data will be converted into an object that can be 
+ * queried and used.
+ *
+ * \parcode
+ * std::vector<uint8_t> command_result = get_reply(command_id);
+ *
+ * zakero::messagepack::Object object;
+ * object = zakero::messagepack::deserialize(command_result);
+ * if(object.isArray() == false)
+ * {
+ * 	writeError(ERROR_INVALID_COMMAND_RESULT);
+ *
+ * 	return;
+ * }
+ *
+ * zakero::messagepack::Array& array = object.asArray();
+ *
+ * constexpr size_t success_index = 1;
+ * constexpr size_t result_code_index = 2;
+ * if(array(success_index).boolean == true)
+ * {
+ * 	writeError(array(error_code_index).as<int64_t>());
+ * }
+ * \endparcode
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::vector<uint8_t>& data ///< The packed data
+	) noexcept
+{
+	size_t          index = 0;
+	std::error_code error = {};
+
+	return deserialize(data, index, error);
+}
+
+
+/**
+ * \brief Deserialize MessagePack data.
+ *
+ * The packed vector of \p data will be converted into an object that can be 
+ * queried and used.
+ *
+ * \parcode
+ * std::vector<uint8_t> command_result = get_reply(command_id);
+ *
+ * zakero::messagepack::Object object;
+ * std::error_code             error;
+ * object = zakero::messagepack::deserialize(command_result, error);
+ * if(error)
+ * {
+ *	writeError(ERROR_INVALID_COMMAND_RESULT);
+ *
+ * 	return;
+ * }
+ *
+ * zakero::messagepack::Array& array = object.asArray();
+ *
+ * constexpr size_t error_index = 1;
+ * constexpr size_t error_code_index = 2;
+ * if(array(error_index).as<bool>() == true)
+ * {
+ * 	writeError(array(error_code_index).as<int64_t>());
+ * }
+ * \endparcode
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::vector<uint8_t>& data  ///< The packed data
+	, std::error_code&                     error ///< The error code
+	) noexcept
+{
+	size_t index = 0;
+
+	return deserialize(data, index, error);
+}
+
+
+/**
+ * \brief Deserialize MessagePack data.
+ *
+ * The packed vector of \p data will be converted into an object that can be 
+ * queried and used.
+ *
+ * \parcode
+ * std::vector<uint8_t> command_result = get_reply(command_id);
+ *
+ * zakero::messagepack::Object object;
+ * size_t                      index;
+ * object = zakero::messagepack::deserialize(command_result, index);
+ * if(object.isArray() == false)
+ * {
+ *	writeError(ERROR_INVALID_COMMAND_RESULT);
+ *
+ * 	return;
+ * }
+ *
+ * zakero::messagepack::Array& array = object.asArray();
+ *
+ * constexpr size_t error_index = 1;
+ * constexpr size_t error_code_index = 2;
+ * if(array(error_index).as<bool>() == true)
+ * {
+ * 	writeError(array(error_code_index).as<int64_t>());
+ * }
+ * \endparcode
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::vector<uint8_t>& data  ///< The packed data
+	, size_t&                              index ///< The starting index
+	) noexcept
+{
+	std::error_code error = {};
+
+	return deserialize(data, index, error);
+}
+
+
+/**
+ * \brief Deserialize MessagePack data.
+ *
+ * The packed vector of \p data will be converted into an object that can be 
+ * queried and used.
+ *
+ * \parcode
+ * std::vector<uint8_t> command_result = get_reply(command_id);
+ *
+ * zakero::messagepack::Object object;
+ * size_t index;
+ * std::error_code error;
+ * object = zakero::messagepack::deserialize(command_result, index, error);
+ * if(object.isArray() == false)
+ * {
+ *	writeError(ERROR_INVALID_COMMAND_RESULT, error);
+ *
+ * 	// index points to the end of the "object"
+ * 	crashAnalysis(&command_result[index]);
+ *
+ * 	return;
+ * }
+ *
+ * zakero::messagepack::Array& array = object.asArray();
+ *
+ * constexpr size_t error_index = 1;
+ * constexpr size_t error_code_index = 2;
+ * if(array(error_index).as<bool>() == true)
+ * {
+ * 	writeError(array(error_code_index).as<int64_t>());
+ * }
+ * \endparcode
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::vector<uint8_t>& data  ///< The packed data
+	, size_t&                              index ///< The starting index
+	, std::error_code&                     error ///< The error code
+	) noexcept
+{
+	return deserialize(std::span<const uint8_t>(data), index, error);
+}
+
+
+/**
+ * \brief Deserialize MessagePack data.
+ *
+ * The packed \p data will be converted into an object that can be queried 
+ * and used. Any contiguous range of bytes can be used as the \p data.
+ *
+ * \parcode
+ * uint8_t buffer[1024];
+ * size_t  length = read(socket, buffer, sizeof(buffer));
+ *
+ * zakero::messagepack::Object object;
+ * object = zakero::messagepack::deserialize(std::span(buffer, length));
+ * \endparcode
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data ///< The packed data
+	) noexcept
+{
+	size_t          index = 0;
+	std::error_code error = {};
+
+	return deserialize(data, index, error);
+}
+
+
+/**
+ * \brief Deserialize MessagePack data.
+ *
+ * The packed \p data, starting at the \p index, will be converted into an 
+ * object that can be queried and used. Any contiguous range of bytes can be 
+ * used as the \p data.
+ *
+ * When this function returns, the \p index will point to the byte after the 
+ * Object. If an error occurred, the \p index will point to where the error 
+ * was found.
+ *
+ * \parcode
+ * std::span<const uint8_t> data = memory_mapped_file();
+ *
+ * size_t          index = 0;
+ * std::error_code error;
+ *
+ * while(index < data.size())
+ * {
+ * 	zakero::messagepack::Object object;
+ * 	object = zakero::messagepack::deserialize(data, index, error);
+ *
+ * 	if(error)
+ * 	{
+ * 		break;
+ * 	}
+ *
+ * 	process(object);
+ * }
+ * \endparcode
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data  ///< The packed data
+	, size_t&                                 index ///< The starting index
+	, std::error_code&                        error ///< The error code
+	) noexcept
+{
+	return deserialize(data, index, error, std::pmr::get_default_resource());
+}
+
+
+/**
+ * \brief Deserialize MessagePack data into a memory resource.
+ *
+ * The packed \p data will be converted into an object that can be queried 
+ * and used. All the strings, binary data, Arrays, Maps, and Extensions in the 
+ * Object will allocate their memory from the \p resource.
+ *
+ * Using a `std::pmr::monotonic_buffer_resource` as the \p resource places the 
+ * entire Object into one buffer, which is released all at once instead of 
+ * freeing every Object.
+ *
+ * \parcode
+ * std::array<std::byte, 64 * 1024> buffer;
+ *
+ * std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+ *
+ * zakero::messagepack::Object object;
+ * object = zakero::messagepack::deserialize(data, &arena);
+ * \endparcode
+ *
+ * \note The Object must be destroyed before the \p resource. Copies of the 
+ * Object use the default memory resource, moves keep the \p resource.
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data     ///< The packed data
+	, std::pmr::memory_resource*              resource ///< The memory resource
+	) noexcept
+{
+	size_t          index = 0;
+	std::error_code error = {};
+
+	return deserialize(data, index, error, resource);
+}
+
+
+/**
+ * \brief Deserialize MessagePack data into a memory resource.
+ *
+ * The packed \p data, starting at the \p index, will be converted into an 
+ * object that can be queried and used. All the strings, binary data, Arrays, 
+ * Maps, and Extensions in the Object will allocate their memory from the \p 
+ * resource.
+ *
+ * When this function returns, the \p index will point to the byte after the 
+ * Object. If an error occurred, the \p index will point to where the error 
+ * was found.
+ *
+ * \parcode
+ * std::pmr::monotonic_buffer_resource arena;
+ *
+ * size_t          index = 0;
+ * std::error_code error;
+ *
+ * while(index < data.size())
+ * {
+ * 	zakero::messagepack::Object object;
+ * 	object = zakero::messagepack::deserialize(data, index, error, &arena);
+ *
+ * 	if(error)
+ * 	{
+ * 		break;
+ * 	}
+ *
+ * 	process(object);
+ * }
+ * \endparcode
+ *
+ * The default Limits are used, so containers can not be nested deeper than 
+ * Limits::max_depth.
+ *
+ * \note The Object must be destroyed before the \p resource. Copies of the 
+ * Object use the default memory resource, moves keep the \p resource.
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data     ///< The packed data
+	, size_t&                                 index    ///< The starting index
+	, std::error_code&                        error    ///< The error code
+	, std::pmr::memory_resource*              resource ///< The memory resource
+	) noexcept
+{
+	return deserialize(data, index, error, Limits{}, resource);
+}
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("deserialize/memory_resource")
+{
+	Map map;
+	map.set(Object{}, Object{"null"});
+	map.set(Object{true}, Object{std::pmr::string(100, 'b')});
+	map.set(Object{int64_t(-1)}, Object{std::pmr::vector<uint8_t>(100, 'i')});
+	map.set(Object{uint64_t(1)}, Object{uint64_t(1)});
+	map.set(Object{float(2)}, Object{float(2)});
+	map.set(Object{double(3)}, Object{double(3)});
+	map.set(Object{std::pmr::string(100, 'k')}, Object{std::pmr::string(100, 'v')});
+
+	Ext ext;
+	ext.type = 7;
+	ext.data = std::pmr::vector<uint8_t>(100, 'e');
+
+	Array array;
+	for(size_t i = 0; i < 100; i++)
+	{
+		array.append(int64_t(i));
+	}
+
+	Object object = {Array{}};
+	object.asArray().append(std::string_view(std::string(100, 's')));
+	object.asArray().append(map);
+	object.asArray().append(ext);
+	object.asArray().append(array);
+
+	const Map& map_copy = object.asArray()[1].asMap();
+	const Ext& ext_copy = object.asArray()[2].asExt();
+
+	const std::vector<uint8_t> data = serialize(object);
+
+	CountingResource_ upstream;
+	CountingResource_ heap;
+
+	std::pmr::memory_resource* default_resource = std::pmr::set_default_resource(&heap);
+
+	SUBCASE("Monotonic")
+	{
+		std::pmr::monotonic_buffer_resource arena(1024 * 1024, &upstream);
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		Object test = deserialize(data, index, error, &arena);
+
+		CHECK(error == Error_None);
+		CHECK(index == data.size());
+		CHECK(heap.count == 0);
+		CHECK(upstream.count == 1);
+
+		CHECK(test.asArray().size() == 4);
+		CHECK(test.asArray().object_vector.get_allocator().resource() == &arena);
+		CHECK(test.asArray()[0].asString() == std::string(100, 's').c_str());
+		CHECK(test.asArray()[0].asString().get_allocator().resource() == &arena);
+
+		const Map& test_map = test.asArray()[1].asMap();
+		CHECK(test_map.size() == map_copy.size());
+		CHECK(test_map.key(6).asString().get_allocator().resource() == &arena);
+		CHECK(test_map.value(6).asString() == map_copy.value(6).asString());
+		CHECK(test_map[true].asString().get_allocator().resource() == &arena);
+		CHECK(test_map[int64_t(-1)].asBinary() == map_copy[int64_t(-1)].asBinary());
+		CHECK(test_map[int64_t(-1)].asBinary().get_allocator().resource() == &arena);
+		CHECK(test_map.at(Object{}).asString() == "null");
+
+		CHECK(test.asArray()[2].asExt().type == 7);
+		CHECK(test.asArray()[2].asExt().data == ext_copy.data);
+		CHECK(test.asArray()[2].asExt().data.get_allocator().resource() == &arena);
+
+		CHECK(test.asArray()[3] == object.asArray()[3]);
+		CHECK(test.asArray()[3].asArray().object_vector.get_allocator().resource() == &arena);
+
+		CHECK(serialize(test) == data);
+
+		// A copy is not in the arena
+
+		const size_t count = heap.count;
+
+		Object copy = test;
+
+		CHECK(heap.count > count);
+		CHECK(copy.asArray().object_vector.get_allocator().resource() == &heap);
+		CHECK(serialize(copy) == data);
+	}
+
+	SUBCASE("Default")
+	{
+		Object test = deserialize(data);
+
+		CHECK(heap.count > 0);
+		CHECK(test.asArray().object_vector.get_allocator().resource() == &heap);
+		CHECK(serialize(test) == data);
+	}
+
+	SUBCASE("Error")
+	{
+		std::pmr::monotonic_buffer_resource arena(&upstream);
+
+		const std::span<const uint8_t> part(data.data(), data.size() - 1);
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		Object test = deserialize(part, index, error, &arena);
+
+		CHECK(error != Error_None);
+		CHECK(test.isNull());
+		CHECK(heap.count == 0);
+	}
+
+	std::pmr::set_default_resource(default_resource);
+}
+#endif // }}}
+
+
+/**
+ * \brief Deserialize MessagePack data from an untrusted source.
+ *
+ * The packed \p data, starting at the \p index, will be converted into an 
+ * object that can be queried and used. If the data goes over any of the \p 
+ * limits, decoding stops and the \p error is set.
+ *
+ * When this function returns, the \p index will point to the byte after the 
+ * Object. If an error occurred, the \p index will point to where the error 
+ * was found.
+ *
+ * \parcode
+ * zakero::messagepack::Limits limits;
+ * limits.max_depth = 8;
+ *
+ * size_t          index = 0;
+ * std::error_code error;
+ *
+ * zakero::messagepack::Object object = zakero::messagepack::deserialize(data, index, error, limits);
+ *
+ * if(error == zakero::messagepack::Error_Depth_Limit)
+ * {
+ * 	reject(data);
+ * }
+ * \endparcode
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data   ///< The packed data
+	, size_t&                                 index  ///< The starting index
+	, std::error_code&                        error  ///< The error code
+	, const Limits&                           limits ///< The limits
+	) noexcept
+{
+	return deserialize(data, index, error, limits, std::pmr::get_default_resource());
+}
+
+
+/**
+ * \brief Deserialize MessagePack data from an untrusted source.
+ *
+ * The packed \p data, starting at the \p index, will be converted into an 
+ * object that can be queried and used. All the strings, binary data, Arrays, 
+ * Maps, and Extensions in the Object will allocate their memory from the \p 
+ * resource. If the data goes over any of the \p limits, decoding stops and 
+ * the \p error is set.
+ *
+ * Nested Arrays and Maps are not decoded with recursion. The Arrays and Maps 
+ * that are being filled are kept on a stack that can hold 32 levels without 
+ * allocating memory. Deeper data allocates the stack once, so the depth of 
+ * the data is only limited by Limits::max_depth and Limits::Depth_Max.
+ *
+ * Array elements are decoded in place and Map values are decoded directly 
+ * into the Map, so nothing is copied or moved after it has been decoded.
+ *
+ * When this function returns, the \p index will point to the byte after the 
+ * Object. If an error occurred, the \p index will point to where the error 
+ * was found.
+ *
+ * \note The Object must be destroyed before the \p resource. Copies of the 
+ * Object use the default memory resource, moves keep the \p resource.
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data     ///< The packed data
+	, size_t&                                 index    ///< The starting index
+	, std::error_code&                        error    ///< The error code
+	, const Limits&                           limits   ///< The limits
+	, std::pmr::memory_resource*              resource ///< The memory resource
+	) noexcept
+{
+	return deserialize(data, index, error, limits, nullptr, resource);
+}
+
+
+/**
+ * \brief Deserialize MessagePack data with repeated keys.
+ *
+ * The packed \p data, starting at the \p index, will be converted into an 
+ * object that can be queried and used. The string keys of Maps are looked 
+ * up in the \p key_cache, see KeyCache for details.
+ *
+ * When this function returns, the \p index will point to the byte after the 
+ * Object. If an error occurred, the \p index will point to where the error 
+ * was found.
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data      ///< The packed data
+	, size_t&                                 index     ///< The starting index
+	, std::error_code&                        error     ///< The error code
+	, KeyCache&                               key_cache ///< The key cache
+	) noexcept
+{
+	return deserialize(data, index, error, Limits{}, &key_cache, std::pmr::get_default_resource());
+}
+
+
+/**
+ * \brief Deserialize MessagePack data with repeated Map shapes.
+ *
+ * The packed \p data, starting at the \p index, will be converted into an 
+ * object that can be queried and used. Maps that have the same keys as a 
+ * shape in the \p shape_cache are decoded without decoding their keys, see 
+ * ShapeCache for details.
+ *
+ * When this function returns, the \p index will point to the byte after the 
+ * Object. If an error occurred, the \p index will point to where the error 
+ * was found.
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data        ///< The packed data
+	, size_t&                                 index       ///< The starting index
+	, std::error_code&                        error       ///< The error code
+	, ShapeCache&                             shape_cache ///< The shape cache
+	) noexcept
+{
+	return deserialize(data, index, error, Limits{}, nullptr, &shape_cache, std::pmr::get_default_resource());
+}
+
+
+/**
+ * \brief Deserialize MessagePack data.
+ *
+ * The same as deserialize(data, index, error, limits, key_cache, nullptr, 
+ * resource).
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data      ///< The packed data
+	, size_t&                                 index     ///< The starting index
+	, std::error_code&                        error     ///< The error code
+	, const Limits&                           limits    ///< The limits
+	, KeyCache*                               key_cache ///< The key cache
+	, std::pmr::memory_resource*              resource  ///< The memory resource
+	) noexcept
+{
+	return deserialize(data, index, error, limits, key_cache, nullptr, resource);
+}
+
+
+/**
+ * \brief Deserialize MessagePack data.
+ *
+ * The packed \p data, starting at the \p index, will be converted into an 
+ * object that can be queried and used. All the strings, binary data, Arrays, 
+ * Maps, and Extensions in the Object will allocate their memory from the \p 
+ * resource. If the data goes over any of the \p limits, decoding stops and 
+ * the \p error is set. If the \p key_cache is not `nullptr`, the string keys 
+ * of Maps are looked up in it, see KeyCache for details. If the \p 
+ * shape_cache is not `nullptr`, Maps with a known shape are decoded without 
+ * decoding their keys, see ShapeCache for details.
+ *
+ * Nested Arrays and Maps are not decoded with recursion. The Arrays and Maps 
+ * that are being filled are kept on a stack that can hold 32 levels without 
+ * allocating memory. Deeper data allocates the stack once, so the depth of 
+ * the data is only limited by Limits::max_depth and Limits::Depth_Max.
+ *
+ * Array elements are decoded in place and Map values are decoded directly 
+ * into the Map, so nothing is copied or moved after it has been decoded.
+ *
+ * When this function returns, the \p index will point to the byte after the 
+ * Object. If an error occurred, the \p index will point to where the error 
+ * was found.
+ *
+ * \note The Object must be destroyed before the \p resource. Copies of the 
+ * Object use the default memory resource, moves keep the \p resource.
+ *
+ * \return The MessagePack Object.
+ */
+Object deserialize(const std::span<const uint8_t> data        ///< The packed data
+	, size_t&                                 index       ///< The starting index
+	, std::error_code&                        error       ///< The error code
+	, const Limits&                           limits      ///< The limits
+	, KeyCache*                               key_cache   ///< The key cache
+	, ShapeCache*                             shape_cache ///< The shape cache
+	, std::pmr::memory_resource*              resource    ///< The memory resource
+	) noexcept
+{
+	constexpr size_t Npos = std::numeric_limits<size_t>::max();
+
+	// The first keys of the KeyCache that are tracked in each Map
+	constexpr size_t Seen_Count = 64;
+
+	struct Frame
+	{
+		Array*   array      = nullptr;
+		Map*     map        = nullptr;
+		uint64_t remaining  = 0;
+		uint64_t seen       = 0;
+		size_t   shape      = Npos;
+		uint64_t generation = 0;
+		size_t   record     = Npos;
+		uint64_t keys       = 0;
+	};
+
+	constexpr size_t Stack_Size = 32;
+
+	std::array<Frame, Stack_Size> stack_array;
+	std::vector<Frame>            stack_vector;
+
+	Frame*  stack    = stack_array.data();
+	size_t  capacity = stack_array.size();
+	size_t  depth    = 0;
+
+	const size_t max_depth = std::min(limits.max_depth, Limits::Depth_Max);
+
+	const size_t start    = index;
+	size_t       elements = 0;
+
+	Object  object;
+	Object  key;
+	Object* target = &object;
+	Map*    key_of = nullptr;
+
+	error = Error_None;
+
+	if(shape_cache != nullptr)
+	{
+		shape_cache->record_bytes_.clear();
+		shape_cache->record_offset_.clear();
+	}
+
+	while(true)
+	{
+		const size_t position = index;
+
+		Header_ header;
+
+		error = readHeader_(data, index, header);
+
+		if(error)
+		{
+			break;
+		}
+
+		if(elements >= limits.max_elements)
+		{
+			error = Error_Element_Limit;
+			index = position;
+			break;
+		}
+
+		elements++;
+
+		const uint64_t length = (header.type == Type_::String
+			|| header.type == Type_::Binary
+			|| header.type == Type_::Ext
+			) ? header.value : 0;
+
+		if((index - start) > limits.max_bytes
+			|| length > (limits.max_bytes - (index - start))
+			)
+		{
+			error = Error_Size_Limit;
+			index = position;
+			break;
+		}
+
+		if(key_of != nullptr
+			&& (header.type == Type_::Binary
+				|| header.type == Type_::Array
+				|| header.type == Type_::Map
+				|| header.type == Type_::Ext
+			))
+		{
+			error = Error_Invalid_Format_Type;
+			index = position;
+			break;
+		}
+
+		if(key_of != nullptr
+			&& key_cache != nullptr
+			&& header.type == Type_::String
+			)
+		{
+			const std::string_view str((const char*)&data[index], header.value);
+
+			const size_t id = key_cache->intern_(str);
+
+			if(id < Seen_Count)
+			{
+				Frame&         frame = stack[depth - 1];
+				const uint64_t bit   = uint64_t(1) << id;
+
+				if((frame.seen & bit) == 0)
+				{
+					// The first time in this Map, not a duplicate
+					frame.seen |= bit;
+
+					key.value.emplace<std::pmr::string>(str, resource);
+					index += header.value;
+
+					if(frame.record != Npos
+						&& !shape_cache->recordKey_(frame.record, data.subspan(position, index - position))
+						)
+					{
+						frame.record = Npos;
+					}
+
+					target = &key_of->insert_(std::move(key), key_cache->entry_vector_[id].hash);
+					key_of = nullptr;
+					continue;
+				}
+			}
+		}
+
+		if(header.type == Type_::Array || header.type == Type_::Map)
+		{
+			const uint64_t count = (header.type == Type_::Map)
+				? header.value * 2
+				: header.value
+				;
+
+			if(depth >= max_depth)
+			{
+				error = Error_Depth_Limit;
+				index = position;
+				break;
+			}
+
+			if(count > (limits.max_elements - elements))
+			{
+				error = Error_Element_Limit;
+				index = position;
+				break;
+			}
+
+			if(depth == capacity)
+			{
+				// Every container is at least 1 byte, the stack will
+				// never need to grow again.
+				capacity = std::min(max_depth, depth + (data.size() - index) + 1);
+
+				stack_vector.reserve(capacity);
+				stack_vector.assign(stack, stack + depth);
+				stack_vector.resize(capacity);
+
+				stack = stack_vector.data();
+			}
+		}
+
+		switch(header.type)
+		{
+			case Type_::Null:
+				target->value.emplace<std::monostate>();
+				break;
+
+			case Type_::Bool:
+				target->value.emplace<bool>(header.value != 0);
+				break;
+
+			case Type_::Int:
+				target->value.emplace<int64_t>((int64_t)header.value);
+				break;
+
+			case Type_::Uint:
+				target->value.emplace<uint64_t>(header.value);
+				break;
+
+			case Type_::Float:
+				target->value.emplace<float>(std::bit_cast<float>((uint32_t)header.value));
+				break;
+
+			case Type_::Double:
+				target->value.emplace<double>(std::bit_cast<double>(header.value));
+				break;
+
+			case Type_::String:
+				target->value.emplace<std::pmr::string>((const char*)&data[index], header.value, resource);
+				index += header.value;
+				break;
+
+			case Type_::Binary:
+			{
+				const uint8_t* bytes = data.data() + index;
+
+				target->value.emplace<std::pmr::vector<uint8_t>>(bytes, bytes + header.value, resource);
+				index += header.value;
+				break;
+			}
+
+			case Type_::Array:
+			{
+				Array& array = target->value.emplace<Array>(std::pmr::vector<Object>(resource));
+
+				// Every element is at least 1 byte
+				array.object_vector.reserve(std::min(header.value, data.size() - index));
+
+				stack[depth++] = {&array, nullptr, header.value, 0};
+				break;
+			}
+
+			case Type_::Map:
+			{
+				Map& map = target->value.emplace<Map>(resource);
+
+				Frame frame = {nullptr, &map, header.value, 0};
+				frame.keys = header.value;
+
+				if(shape_cache != nullptr
+					&& header.value > 0
+					&& header.value <= ShapeCache::Key_Count_Max
+					)
+				{
+					frame.shape = shape_cache->find_(data, index, header.value);
+
+					if(frame.shape != Npos)
+					{
+						const ShapeCache::Shape& shape = shape_cache->shape_vector_[frame.shape];
+
+						shape_cache->create_(shape, map, resource);
+						frame.generation = shape.generation;
+					}
+					else
+					{
+						frame.record = shape_cache->recordBegin_();
+					}
+				}
+
+				if(frame.shape == Npos)
+				{
+					map.reserve(std::min(header.value, (data.size() - index) / 2));
+				}
+
+				stack[depth++] = frame;
+				break;
+			}
+
+			case Type_::Ext:
+			{
+				const uint8_t* bytes = data.data() + index;
+
+				target->value.emplace<Ext>(Ext
+				{	std::pmr::vector<uint8_t>(bytes, bytes + header.value, resource)
+				,	header.ext_type
+				});
+				index += header.value;
+				break;
+			}
+
+			case Type_::Invalid:
+				break;
+		}
+
+		if(key_of != nullptr)
+		{
+			Frame& frame = stack[depth - 1];
+
+			if(frame.record != Npos
+				&& !shape_cache->recordKey_(frame.record, data.subspan(position, index - position))
+				)
+			{
+				frame.record = Npos;
+			}
+
+			// The value of a duplicate key replaces the old value
+			target = &key_of->findOrInsert_(std::move(key));
+			key_of = nullptr;
+			continue;
+		}
+
+		while(depth > 0 && stack[depth - 1].remaining == 0)
+		{
+			depth--;
+
+			const Frame& frame = stack[depth];
+
+			if(shape_cache == nullptr
+				|| frame.map == nullptr
+				|| frame.map->size() == 0
+				)
+			{
+				continue;
+			}
+
+			if(frame.shape != Npos)
+			{
+				shape_cache->hits_++;
+				continue;
+			}
+
+			shape_cache->misses_++;
+
+			if(frame.record != Npos)
+			{
+				shape_cache->recordEnd_(frame.record, *frame.map);
+			}
+		}
+
+		if(depth == 0)
+		{
+			break;
+		}
+
+		Frame& frame = stack[depth - 1];
+
+		frame.remaining--;
+
+		if(frame.array != nullptr)
+		{
+			target = &frame.array->object_vector.emplace_back();
+			continue;
+		}
+
+		if(frame.shape != Npos)
+		{
+			// A nested Map may have replaced the shape, the Map only 
+			// trusts the shape that it was created from
+			const size_t key_index = frame.keys - frame.remaining - 1;
+
+			const ShapeCache::Shape* shape = (frame.shape < shape_cache->shape_vector_.size()
+				&& shape_cache->shape_vector_[frame.shape].generation == frame.generation
+				) ? &shape_cache->shape_vector_[frame.shape]
+				: nullptr
+				;
+
+			if(shape != nullptr
+				&& shape_cache->match_(*shape, key_index, data, index)
+				)
+			{
+				const size_t length = shape->key_offset[key_index + 1] - shape->key_offset[key_index];
+
+				if(elements >= limits.max_elements)
+				{
+					error = Error_Element_Limit;
+					break;
+				}
+
+				if((index + length - start) > limits.max_bytes)
+				{
+					error = Error_Size_Limit;
+					break;
+				}
+
+				elements++;
+				index += length;
+
+				target = &frame.map->data_->value_vector[key_index];
+				continue;
+			}
+
+			// Not the same shape, the rest of the Map is decoded normally
+			frame.map->data_->key_vector.resize(key_index);
+			frame.map->data_->value_vector.resize(key_index);
+			frame.map->indexBuild_();
+
+			if(shape != nullptr)
+			{
+				frame.record = shape_cache->recordBegin_(*shape, key_index);
+			}
+
+			// The KeyCache does not know the keys that are already
+			// in the Map
+			frame.shape = Npos;
+			frame.seen  = ~uint64_t(0);
+		}
+
+		target = &key;
+		key_of = frame.map;
+	}
+
+	if(error)
+	{
+		object = Object{};
+	}
+
+	return object;
+}
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("deserialize/keycache")
+{
+	auto make_message = [](const size_t seed, const size_t key_count) -> Object
+	{
+		Object object = {Map{}};
+		Map&   map    = object.asMap();
+
+		for(size_t i = 0; i < key_count; i++)
+		{
+			map.emplace<uint64_t>("key_" + std::to_string(i), seed + i);
+		}
+
+		map.emplace<int64_t>(int64_t(-1), -1);
+		map.emplace<Map>("nested").emplace<std::pmr::string>("key_0", "nested");
+
+		return object;
+	};
+
+	// 20 string keys + "nested" and "key_0" in the nested Map
+	const std::vector<uint8_t> data = serialize(make_message(1, 20));
+
+	SUBCASE("Statistics")
+	{
+		KeyCache key_cache;
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		Object object = deserialize(data, index, error, key_cache);
+
+		CHECK(error == Error_None);
+		CHECK(serialize(object) == data);
+		CHECK(key_cache.size()   == 21);
+		CHECK(key_cache.misses() == 21);
+		CHECK(key_cache.hits()   == 1);
+
+		for(size_t i = 0; i < 9; i++)
+		{
+			index  = 0;
+			object = deserialize(data, index, error, key_cache);
+
+			CHECK(error == Error_None);
+			CHECK(serialize(object) == data);
+		}
+
+		CHECK(key_cache.size()    == 21);
+		CHECK(key_cache.misses()  == 21);
+		CHECK(key_cache.hits()    == 1 + (9 * 22));
+		CHECK(key_cache.hitRate() == doctest::Approx(199.0 / 220.0));
+
+		// The Map can still find its keys
+		CHECK(object.asMap()["key_19"].as<uint64_t>() == 20);
+		CHECK(object.asMap()[int64_t(-1)].as<int64_t>() == -1);
+		CHECK(object.asMap()["nested"].asMap()["key_0"].asString() == "nested");
+	}
+
+	SUBCASE("Duplicate keys")
+	{
+		KeyCache key_cache;
+
+		// {"a": 1, "b": {"a": 2}, "a": 3}
+		const std::vector<uint8_t> duplicate =
+		{	(uint8_t)Format::Fixed_Map | 3
+		,	(uint8_t)Format::Fixed_Str | 1, 'a', 1
+		,	(uint8_t)Format::Fixed_Str | 1, 'b', (uint8_t)Format::Fixed_Map | 1
+		,		(uint8_t)Format::Fixed_Str | 1, 'a', 2
+		,	(uint8_t)Format::Fixed_Str | 1, 'a', 3
+		};
+
+		for(size_t i = 0; i < 2; i++)
+		{
+			size_t          index = 0;
+			std::error_code error = {};
+
+			const Object object = deserialize(duplicate, index, error, key_cache);
+
+			CHECK(error == Error_None);
+			CHECK(object.asMap().size() == 2);
+			CHECK(object.asMap()["a"].as<int64_t>() == 3);
+			CHECK(object.asMap()["b"].asMap()["a"].as<int64_t>() == 2);
+		}
+	}
+
+	SUBCASE("Full")
+	{
+		// Only some keys fit, the rest are decoded without the KeyCache
+		KeyCache key_cache(5);
+
+		const std::vector<uint8_t> large = serialize(make_message(7, 100));
+
+		for(size_t i = 0; i < 3; i++)
+		{
+			size_t          index = 0;
+			std::error_code error = {};
+
+			const Object object = deserialize(large, index, error, key_cache);
+
+			CHECK(error == Error_None);
+			CHECK(serialize(object) == large);
+			CHECK(object.asMap()["key_99"].as<uint64_t>() == 106);
+		}
+
+		CHECK(key_cache.size() == 5);
+	}
+
+	SUBCASE("More keys than are tracked")
+	{
+		KeyCache key_cache(1'000);
+
+		const std::vector<uint8_t> large = serialize(make_message(7, 200));
+
+		for(size_t i = 0; i < 3; i++)
+		{
+			size_t          index = 0;
+			std::error_code error = {};
+
+			const Object object = deserialize(large, index, error, key_cache);
+
+			CHECK(error == Error_None);
+			CHECK(serialize(object) == large);
+		}
+
+		CHECK(key_cache.size() == 201);
+	}
+
+	SUBCASE("Clear")
+	{
+		KeyCache key_cache;
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		(void)deserialize(data, index, error, key_cache);
+
+		key_cache.clearStatistics();
+		CHECK(key_cache.hits()    == 0);
+		CHECK(key_cache.misses()  == 0);
+		CHECK(key_cache.hitRate() == 0);
+		CHECK(key_cache.size()    == 21);
+
+		key_cache.clear();
+		CHECK(key_cache.size() == 0);
+
+		index = 0;
+		(void)deserialize(data, index, error, key_cache);
+		CHECK(key_cache.misses() == 21);
+	}
+
+	SUBCASE("Long keys")
+	{
+		KeyCache key_cache;
+
+		Object object = {Map{}};
+		object.asMap().emplace<bool>(std::string(KeyCache::Key_Length_Max + 1, 'k'), true);
+		object.asMap().emplace<bool>(std::string(KeyCache::Key_Length_Max, 'k'), false);
+
+		const std::vector<uint8_t> packed = serialize(object);
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		CHECK(serialize(deserialize(packed, index, error, key_cache)) == packed);
+		CHECK(key_cache.size() == 1);
+	}
+}
+
+TEST_CASE("deserialize/shapecache")
+{
+	auto make_message = [](const size_t seed, const size_t key_count) -> Object
+	{
+		Object object = {Map{}};
+		Map&   map    = object.asMap();
+
+		for(size_t i = 0; i < key_count; i++)
+		{
+			map.emplace<uint64_t>("key_" + std::to_string(i), seed + i);
+		}
+
+		map.emplace<int64_t>(int64_t(-1), -1);
+		map.emplace<Map>("nested").emplace<std::pmr::string>("key_0", "nested");
+
+		return object;
+	};
+
+	auto make_map = [](const std::vector<std::pair<std::string, int64_t>>& pair_vector) -> std::vector<uint8_t>
+	{
+		Object object = {Map{}};
+
+		for(const auto& [key, value] : pair_vector)
+		{
+			object.asMap().emplace<int64_t>(key, value);
+		}
+
+		return serialize(object);
+	};
+
+	// 20 string keys + "nested" and "key_0" in the nested Map
+	const std::vector<uint8_t> data = serialize(make_message(1, 20));
+
+	SUBCASE("Statistics")
+	{
+		ShapeCache shape_cache;
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		Object object = deserialize(data, index, error, shape_cache);
+
+		CHECK(error == Error_None);
+		CHECK(serialize(object) == data);
+		CHECK(shape_cache.size()   == 2);
+		CHECK(shape_cache.misses() == 2);
+		CHECK(shape_cache.hits()   == 0);
+
+		for(size_t i = 0; i < 9; i++)
+		{
+			const std::vector<uint8_t> other = serialize(make_message(i * 100, 20));
+
+			index  = 0;
+			object = deserialize(other, index, error, shape_cache);
+
+			CHECK(error == Error_None);
+			CHECK(index == other.size());
+			CHECK(serialize(object) == other);
+		}
+
+		CHECK(shape_cache.size()    == 2);
+		CHECK(shape_cache.misses()  == 2);
+		CHECK(shape_cache.hits()    == 18);
+		CHECK(shape_cache.hitRate() == doctest::Approx(18.0 / 20.0));
+
+		// The Map can still find its keys
+		for(size_t i = 0; i < 20; i++)
+		{
+			CHECK(object.asMap()["key_" + std::to_string(i)].as<uint64_t>() == 800 + i);
+		}
+
+		CHECK(object.asMap()[int64_t(-1)].as<int64_t>() == -1);
+		CHECK(object.asMap()["nested"].asMap()["key_0"].asString() == "nested");
+		CHECK(object.asMap().keyExists("key_20") == false);
+	}
+
+	SUBCASE("Different values")
+	{
+		ShapeCache shape_cache;
+
+		// {"a": 1, "b": 2}
+		const std::vector<uint8_t> ints = make_map({{"a", 1}, {"b", 2}});
+
+		// {"a": [true], "b": {"a": "x"}}
+		Object object = {Map{}};
+		object.asMap().emplace<Array>("a").append(true);
+		object.asMap().emplace<Map>("b").emplace<std::pmr::string>("a", "x");
+
+		const std::vector<uint8_t> other = serialize(object);
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		(void)deserialize(ints, index, error, shape_cache);
+
+		index  = 0;
+		object = deserialize(other, index, error, shape_cache);
+
+		CHECK(error == Error_None);
+		CHECK(serialize(object) == other);
+		CHECK(shape_cache.hits() == 1);
+	}
+
+	SUBCASE("Different keys")
+	{
+		ShapeCache shape_cache;
+
+		// Same number of keys and the same first key
+		const std::vector<uint8_t> abc = make_map({{"a", 1}, {"b", 2}, {"c", 3}});
+		const std::vector<uint8_t> axc = make_map({{"a", 4}, {"x", 5}, {"c", 6}});
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		(void)deserialize(abc, index, error, shape_cache);
+
+		index = 0;
+		Object object = deserialize(axc, index, error, shape_cache);
+
+		CHECK(error == Error_None);
+		CHECK(serialize(object) == axc);
+		CHECK(object.asMap().keyExists("b") == false);
+		CHECK(object.asMap()["x"].as<int64_t>() == 5);
+		CHECK(shape_cache.hits()   == 0);
+		CHECK(shape_cache.misses() == 2);
+
+		// The new shape replaced the old shape
+		CHECK(shape_cache.size() == 1);
+
+		index  = 0;
+		object = deserialize(axc, index, error, shape_cache);
+
+		CHECK(serialize(object) == axc);
+		CHECK(shape_cache.hits() == 1);
+	}
+
+	SUBCASE("Duplicate keys")
+	{
+		ShapeCache shape_cache;
+
+		// {"a": 1, "b": {"a": 2}, "a": 3}
+		const std::vector<uint8_t> duplicate =
+		{	(uint8_t)Format::Fixed_Map | 3
+		,	(uint8_t)Format::Fixed_Str | 1, 'a', 1
+		,	(uint8_t)Format::Fixed_Str | 1, 'b', (uint8_t)Format::Fixed_Map | 1
+		,		(uint8_t)Format::Fixed_Str | 1, 'a', 2
+		,	(uint8_t)Format::Fixed_Str | 1, 'a', 3
+		};
+
+		for(size_t i = 0; i < 2; i++)
+		{
+			size_t          index = 0;
+			std::error_code error = {};
+
+			const Object object = deserialize(duplicate, index, error, shape_cache);
+
+			CHECK(error == Error_None);
+			CHECK(object.asMap().size() == 2);
+			CHECK(object.asMap()["a"].as<int64_t>() == 3);
+			CHECK(object.asMap()["b"].asMap()["a"].as<int64_t>() == 2);
+		}
+
+		// Only the nested Map is a shape
+		CHECK(shape_cache.size() == 1);
+	}
+
+	SUBCASE("Duplicate keys in a known shape")
+	{
+		ShapeCache shape_cache;
+		KeyCache   key_cache;
+
+		const std::vector<uint8_t> abc = make_map({{"a", 1}, {"b", 2}, {"c", 3}});
+
+		// {"a": 4, "a": 5, "c": 6}
+		const std::vector<uint8_t> duplicate =
+		{	(uint8_t)Format::Fixed_Map | 3
+		,	(uint8_t)Format::Fixed_Str | 1, 'a', 4
+		,	(uint8_t)Format::Fixed_Str | 1, 'a', 5
+		,	(uint8_t)Format::Fixed_Str | 1, 'c', 6
+		};
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		(void)deserialize(abc, index, error, Limits{}, &key_cache, &shape_cache, std::pmr::get_default_resource());
+
+		index = 0;
+		const Object object = deserialize(duplicate, index, error, Limits{}, &key_cache, &shape_cache, std::pmr::get_default_resource());
+
+		CHECK(error == Error_None);
+		CHECK(object.asMap().size() == 2);
+		CHECK(object.asMap()["a"].as<int64_t>() == 5);
+		CHECK(object.asMap()["c"].as<int64_t>() == 6);
+	}
+
+	SUBCASE("Full")
+	{
+		ShapeCache shape_cache(2);
+
+		for(size_t key_count = 1; key_count <= 4; key_count++)
+		{
+			const std::vector<uint8_t> packed = serialize(make_message(0, key_count));
+
+			size_t          index = 0;
+			std::error_code error = {};
+
+			CHECK(serialize(deserialize(packed, index, error, shape_cache)) == packed);
+		}
+
+		CHECK(shape_cache.size() == 2);
+
+		shape_cache.clear();
+		CHECK(shape_cache.size() == 0);
+	}
+
+	SUBCASE("Replaced by a nested Map")
+	{
+		// {a: 1, b: {x: 1}, c: 2}
+		Object object = {Map{}};
+		object.asMap().emplace<int64_t>("a", 1);
+		object.asMap().emplace<Map>("b").emplace<int64_t>("x", 1);
+		object.asMap().emplace<int64_t>("c", 2);
+
+		// Nested Maps that have the same first key and key count as 
+		// their parent
+		Object shared = {Map{}};
+		Map&   inner  = shared.asMap().emplace<Map>("a");
+		inner.emplace<Map>("a").emplace<int64_t>("a", 3);
+		inner.emplace<int64_t>("z", 4);
+		shared.asMap().emplace<Map>("b").emplace<int64_t>("a", 5);
+
+		std::vector<std::vector<uint8_t>> message_vector =
+		{	serialize(object)
+		,	serialize(shared)
+		,	serialize(make_message(1, 3))
+		};
+
+		for(size_t capacity = 1; capacity <= 4; capacity++)
+		{
+			CAPTURE(capacity);
+
+			ShapeCache shape_cache(capacity);
+
+			for(size_t round = 0; round < 3; round++)
+			{
+				for(const std::vector<uint8_t>& packed : message_vector)
+				{
+					size_t          index = 0;
+					std::error_code error = {};
+
+					const Object result = deserialize(packed, index, error, shape_cache);
+
+					CHECK(error == Error_None);
+					CHECK(index == packed.size());
+					CHECK(serialize(result) == packed);
+				}
+			}
+		}
+
+		ShapeCache none(0);
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		CHECK(serialize(deserialize(data, index, error, none)) == data);
+		CHECK(none.size() == 0);
+	}
+
+	SUBCASE("Too many keys")
+	{
+		ShapeCache shape_cache;
+
+		// Only the nested Map is a shape
+		const std::vector<uint8_t> large = serialize(make_message(7, ShapeCache::Key_Count_Max));
+
+		for(size_t i = 0; i < 2; i++)
+		{
+			size_t          index = 0;
+			std::error_code error = {};
+
+			CHECK(serialize(deserialize(large, index, error, shape_cache)) == large);
+		}
+
+		CHECK(shape_cache.size()   == 1);
+		CHECK(shape_cache.hits()   == 1);
+		CHECK(shape_cache.misses() == 3);
+	}
+
+	SUBCASE("Long keys")
+	{
+		ShapeCache shape_cache;
+
+		const std::vector<uint8_t> packed = make_map(
+		{	{std::string(ShapeCache::Key_Length_Max, 'k'), 1}
+		,	{"short", 2}
+		});
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		CHECK(serialize(deserialize(packed, index, error, shape_cache)) == packed);
+		CHECK(shape_cache.size() == 0);
+	}
+
+	SUBCASE("Memory resource")
+	{
+		ShapeCache shape_cache;
+
+		std::pmr::monotonic_buffer_resource arena;
+
+		for(size_t i = 0; i < 2; i++)
+		{
+			size_t          index = 0;
+			std::error_code error = {};
+
+			const Object object = deserialize(data, index, error, Limits{}, nullptr, &shape_cache, &arena);
+
+			CHECK(serialize(object) == data);
+			CHECK(object.asMap().key(0).asString().get_allocator().resource() == &arena);
+		}
+
+		CHECK(shape_cache.hits() == 2);
+	}
+
+	SUBCASE("Limits")
+	{
+		// The same errors with and without a shape
+		for(size_t max = 0; max < 30; max++)
+		{
+			ShapeCache shape_cache;
+
+			size_t          index = 0;
+			std::error_code error = {};
+
+			(void)deserialize(data, index, error, shape_cache);
+
+			Limits limits;
+			limits.max_elements = max;
+
+			size_t          expect_index = 0;
+			std::error_code expect_error = {};
+
+			const Object expect = deserialize(data, expect_index, expect_error, limits);
+
+			index = 0;
+			const Object object = deserialize(data, index, error, limits, nullptr, &shape_cache, std::pmr::get_default_resource());
+
+			CHECK(error == expect_error);
+			CHECK(index == expect_index);
+			CHECK(object == expect);
+		}
+
+		for(size_t max = 0; max < data.size(); max++)
+		{
+			ShapeCache shape_cache;
+
+			size_t          index = 0;
+			std::error_code error = {};
+
+			(void)deserialize(data, index, error, shape_cache);
+
+			Limits limits;
+			limits.max_bytes = max;
+
+			size_t          expect_index = 0;
+			std::error_code expect_error = {};
+
+			(void)deserialize(data, expect_index, expect_error, limits);
+
+			index = 0;
+			(void)deserialize(data, index, error, limits, nullptr, &shape_cache, std::pmr::get_default_resource());
+
+			CHECK(error == expect_error);
+		}
+	}
+
+	SUBCASE("Truncated")
+	{
+		ShapeCache shape_cache;
+
+		for(size_t size = 0; size < data.size(); size++)
+		{
+			const std::span<const uint8_t> truncated(data.data(), size);
+
+			size_t          expect_index = 0;
+			std::error_code expect_error = {};
+
+			(void)deserialize(truncated, expect_index, expect_error);
+
+			size_t          index = 0;
+			std::error_code error = {};
+
+			(void)deserialize(data, index, error, shape_cache);
+
+			index = 0;
+			(void)deserialize(truncated, index, error, shape_cache);
+
+			CHECK(error == expect_error);
+			CHECK(index == expect_index);
+		}
+	}
+
+	SUBCASE("Clear")
+	{
+		ShapeCache shape_cache;
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		(void)deserialize(data, index, error, shape_cache);
+
+		shape_cache.clearStatistics();
+		CHECK(shape_cache.hits()    == 0);
+		CHECK(shape_cache.misses()  == 0);
+		CHECK(shape_cache.hitRate() == 0);
+		CHECK(shape_cache.size()    == 2);
+	}
+}
+
+
+
+TEST_CASE("deserialize/limits")
+{
+	Map map;
+	map.set(Object{"id"}, Object{uint64_t(42)});
+	map.set(Object{"name"}, Object{std::pmr::string(100, 'n')});
+	map.set(Object{"data"}, Object{std::pmr::vector<uint8_t>(100, 'd')});
+
+	Array list;
+	list.append(int64_t(1));
+	list.append(int64_t(2));
+	list.append(int64_t(3));
+	map.set(Object{"list"}, Object{std::move(list)});
+
+	// 1 + 4 keys + 4 values + 3 elements
+	const size_t               element_count = 12;
+	const std::vector<uint8_t> data          = serialize(Object{map});
+
+	SUBCASE("Within the limits")
+	{
+		Limits limits;
+		limits.max_depth    = 2;
+		limits.max_elements = element_count;
+		limits.max_bytes    = data.size();
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		const Object object = deserialize(data, index, error, limits);
+
+		CHECK(error == Error_None);
+		CHECK(index == data.size());
+		CHECK(serialize(object) == data);
+	}
+
+	SUBCASE("Depth")
+	{
+		Limits limits;
+		limits.max_depth = 1;
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		const Object object = deserialize(data, index, error, limits);
+
+		CHECK(error == Error_Depth_Limit);
+		CHECK(object.isNull());
+		CHECK(data[index] == ((uint8_t)Format::Fixed_Array | 3));
+
+		limits.max_depth = 0;
+		index            = 0;
+
+		CHECK(deserialize(data, index, error, limits).isNull());
+		CHECK(error == Error_Depth_Limit);
+		CHECK(index == 0);
+
+		const std::vector<uint8_t> scalar = serialize(Object{int64_t(-1)});
+
+		index = 0;
+		CHECK(deserialize(scalar, index, error, limits).as<int64_t>() == -1);
+		CHECK(error == Error_None);
+	}
+
+	SUBCASE("Elements")
+	{
+		Limits limits;
+		limits.max_elements = element_count - 1;
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		CHECK(deserialize(data, index, error, limits).isNull());
+		CHECK(error == Error_Element_Limit);
+
+		// A container that claims too many elements is found before 
+		// any of its elements are decoded
+		std::vector<uint8_t> huge = { (uint8_t)Format::Array16, 0x07, 0xd0 };
+		huge.resize(3 + 2000, (uint8_t)Format::Nill);
+
+		limits.max_elements = 1000;
+		index               = 0;
+
+		CHECK(deserialize(huge, index, error, limits).isNull());
+		CHECK(error == Error_Element_Limit);
+		CHECK(index == 0);
+	}
+
+	SUBCASE("Bytes")
+	{
+		Limits limits;
+		limits.max_bytes = data.size() - 1;
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		CHECK(deserialize(data, index, error, limits).isNull());
+		CHECK(error == Error_Size_Limit);
+
+		// Strings are checked before they are copied
+		const std::vector<uint8_t> str = serialize(Object{std::pmr::string(1000, 's')});
+
+		CountingResource_ heap;
+
+		std::pmr::memory_resource* default_resource = std::pmr::set_default_resource(&heap);
+
+		limits.max_bytes = 100;
+		index            = 0;
+
+		CHECK(deserialize(str, index, error, limits).isNull());
+		CHECK(error == Error_Size_Limit);
+		CHECK(index == 0);
+		CHECK(heap.count == 0);
+
+		std::pmr::set_default_resource(default_resource);
+	}
+
+	SUBCASE("Starting index")
+	{
+		std::vector<uint8_t> two = data;
+		two.insert(two.end(), data.begin(), data.end());
+
+		Limits limits;
+		limits.max_bytes = data.size();
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		(void)deserialize(two, index, error, limits);
+		CHECK(error == Error_None);
+		CHECK(index == data.size());
+
+		(void)deserialize(two, index, error, limits);
+		CHECK(error == Error_None);
+		CHECK(index == two.size());
+	}
+}
+
+
+TEST_CASE("deserialize/nested")
+{
+	SUBCASE("Deeper than the stack")
+	{
+		const size_t depth = Limits::Depth_Max;
+
+		// [[[[ ... [1, "end"] ... ]]]]
+		std::vector<uint8_t> data(depth - 1, (uint8_t)Format::Fixed_Array | 1);
+		data.push_back((uint8_t)Format::Fixed_Map | 1);
+		data.push_back((uint8_t)Format::Fixed_Str | 3);
+		data.insert(data.end(), {'e', 'n', 'd'});
+		data.push_back(1);
+
+		Limits limits;
+		limits.max_depth = depth;
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		Object object = deserialize(data, index, error, limits);
+
+		CHECK(error == Error_None);
+		CHECK(index == data.size());
+
+		Object* level = &object;
+		for(size_t i = 0; i < depth - 1; i++)
+		{
+			REQUIRE(level->isArray());
+			REQUIRE(level->asArray().size() == 1);
+			level = &level->asArray()[0];
+		}
+
+		REQUIRE(level->isMap());
+		CHECK(level->asMap()["end"].as<int64_t>() == 1);
+
+		limits.max_depth = depth - 1;
+		index            = 0;
+
+		CHECK(deserialize(data, index, error, limits).isNull());
+		CHECK(error == Error_Depth_Limit);
+		CHECK(index == depth - 1);
+
+		// A larger max_depth is capped
+		data.insert(data.begin(), (uint8_t)Format::Fixed_Array | 1);
+
+		limits.max_depth = std::numeric_limits<size_t>::max();
+		index            = 0;
+
+		CHECK(deserialize(data, index, error, limits).isNull());
+		CHECK(error == Error_Depth_Limit);
+		CHECK(index == Limits::Depth_Max);
+	}
+
+	SUBCASE("Hostile")
+	{
+		// Recursion would overflow the stack
+		const std::vector<uint8_t> data(10'000'000, (uint8_t)Format::Fixed_Array | 1);
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		CHECK(deserialize(data, index, error).isNull());
+		CHECK(error == Error_Depth_Limit);
+		CHECK(index == Limits{}.max_depth);
+	}
+
+	SUBCASE("Map")
+	{
+		Map inner;
+		inner.set(Object{int64_t(-1)}, Object{Array{}});
+		inner[int64_t(-1)].asArray().append(std::string_view("value"));
+
+		Map outer;
+		outer.set(Object{"inner"}, Object{inner});
+		outer.set(Object{true}, Object{Map{}});
+		outer.set(Object{double(0.5)}, Object{Ext{std::pmr::vector<uint8_t>(3, 'x'), 9}});
+
+		const std::vector<uint8_t> data = serialize(Object{outer});
+
+		const Object object = deserialize(data);
+
+		CHECK(object.asMap().size() == 3);
+		CHECK(object.asMap()["inner"].asMap()[int64_t(-1)].asArray()[0].asString() == "value");
+		CHECK(object.asMap()[true].asMap().size() == 0);
+		CHECK(object.asMap()[double(0.5)].asExt().type == 9);
+		CHECK(serialize(object) == data);
+	}
+
+	SUBCASE("Duplicate keys")
+	{
+		// {"a": [1], "a": 2}
+		const std::vector<uint8_t> data =
+		{	(uint8_t)Format::Fixed_Map | 2
+		,	(uint8_t)Format::Fixed_Str | 1, 'a', (uint8_t)Format::Fixed_Array | 1, 1
+		,	(uint8_t)Format::Fixed_Str | 1, 'a', 2
+		};
+
+		const Object object = deserialize(data);
+
+		CHECK(object.asMap().size() == 1);
+		CHECK(object.asMap()["a"].as<int64_t>() == 2);
+	}
+
+	SUBCASE("Container keys")
+	{
+		// {[]: 1}
+		const std::vector<uint8_t> data =
+		{	(uint8_t)Format::Fixed_Map | 1
+		,	(uint8_t)Format::Fixed_Array | 0, 1
+		};
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		CHECK(deserialize(data, index, error).isNull());
+		CHECK(error == Error_Invalid_Format_Type);
+		CHECK(index == 1);
+	}
+}
+#endif // }}}
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("deserialize/error")
+{
+	std::vector<uint8_t> data   = {};
+	std::error_code      error  = {};
+	Object               object = {};
+	size_t               index  = 0;
+
+	SUBCASE("no data")
+	{
+		object = deserialize(data, index, error);
+		CHECK(error           == Error_No_Data);
+		CHECK(index           == 0);
+		CHECK(object.isNull() == true);
+	}
 	
-		case Format::Float64:
-			Convert_Byte7 = data[index++];
-			Convert_Byte6 = data[index++];
-			Convert_Byte5 = data[index++];
-			Convert_Byte4 = data[index++];
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			return Object{Convert.float64};
+	SUBCASE("invalid index")
+	{
+		data.push_back(0);
+		index = 10;
+
+		object = deserialize(data, index, error);
+		CHECK(error           == Error_Invalid_Index);
+		CHECK(index           == 10);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Never_Used")
+	{
+		data.push_back((uint8_t)Format::Never_Used);
+
+		object = deserialize(data, index, error);
+		CHECK(error           == Error_Invalid_Format_Type);
+		CHECK(index           == 1);
+		CHECK(object.isNull() == true);
+	}
 	
-		case Format::Str8:
+	// The following format ID's can not be tested for incomplete data
+	// because the value is encoded in the Format ID itself:
+	// - Nill
+	// - True
+	// - False
+	// - Fixed_Int_Pos
+	// - Fixed_Int_Neg
+
+	SUBCASE("Uint8")
+	{
+		object = Object{(uint64_t)std::numeric_limits<uint8_t>::max()};
+		object = Object{uint64_t(0xff)};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Uint8);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Uint16")
+	{
+		object = Object{(uint64_t)std::numeric_limits<uint16_t>::max()};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Uint16);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Uint32")
+	{
+		object = Object{(uint64_t)std::numeric_limits<uint32_t>::max()};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Uint32);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Uint64")
+	{
+		object = Object{(uint64_t)std::numeric_limits<uint64_t>::max()};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Uint64);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Int8")
+	{
+		object = Object{int64_t(std::numeric_limits<int8_t>::min())};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Int8);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Int16")
+	{
+		object = Object{int64_t(std::numeric_limits<int16_t>::min())};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Int16);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Int32")
+	{
+		object = Object{int64_t(std::numeric_limits<int32_t>::min())};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Int32);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Int64")
+	{
+		object = Object{std::numeric_limits<int64_t>::min()};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Int64);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Float32")
+	{
+		object = Object{std::numeric_limits<float>::min()};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Float32);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Float64")
+	{
+		object = Object{std::numeric_limits<double>::min()};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Float64);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Fixed_Str")
+	{
+		object = Object{std::pmr::string(16, 'X')};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK((data[0] & Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str);
+		CHECK(error                      == Error_Incomplete);
+		CHECK(index                      != 0);
+		CHECK(object.isNull()            == true);
+	}
+
+	SUBCASE("Str8")
+	{
+		object = Object{std::pmr::string(32, 'X')};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Str8);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Str16")
+	{
+		object = Object{std::pmr::string(std::numeric_limits<uint8_t>::max() + 1, 'X')};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Str16);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Str32")
+	{
+		object = Object{std::pmr::string(std::numeric_limits<uint16_t>::max() + 1, 'X')};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Str32);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Bin8")
+	{
+		object = Object{std::pmr::vector<uint8_t>(0, 'X')};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Bin8);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Bin16")
+	{
+		object = Object{std::pmr::vector<uint8_t>(std::numeric_limits<uint8_t>::max() + 1, 'X')};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Bin16);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Bin32")
+	{
+		object = Object{std::pmr::vector<uint8_t>(std::numeric_limits<uint16_t>::max() + 1, 'X')};
+		data = serialize(object);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Bin32);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Fixed_Array")
+	{
+		// Check the Array itself
+		Array array;
+		array.object_vector = std::pmr::vector<Object>(8, Object{});
+		data = serialize(array);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK((data[0] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
+		CHECK(error                        == Error_Invalid_Index);
+		CHECK(index                        != 0);
+		CHECK(object.isNull()              == true);
+
+		// Check the contents of the Array
+		index = 0;
+		array.object_vector = std::pmr::vector<Object>(1, Object{});
+		array.object(0) = Object{std::pmr::string("ABC")};
+		data = serialize(array);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK((data[0] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
+		CHECK(error                        == Error_Incomplete);
+		CHECK(index                        != 0);
+		CHECK(object.isNull()              == true);
+	}
+
+	SUBCASE("Array16")
+	{
+		Array array;
+		array.object_vector = std::pmr::vector<Object>(16, Object{});
+		data = serialize(array);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Array16);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Array32")
+	{
+		Array array;
+		array.object_vector = std::pmr::vector<Object>(std::numeric_limits<uint16_t>::max() + 1, Object{});
+		data = serialize(array);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Array32);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Fixed_Map")
+	{
+		// Check the Map itself
+		Map map;
+		map.set(Object{}, Object{});
+		data = serialize(map);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK((data[0] & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map);
+		CHECK(error                        == Error_Invalid_Index);
+		CHECK(index                        != 0);
+		CHECK(object.isNull()              == true);
+
+		// Check the contents of the Map
+		index = 0;
+		map.set(Object{int64_t(0)}, Object{});
+		map.set(Object{int64_t(1)}, Object{std::pmr::string("Hello, World")});
+		data = serialize(map);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK((data[0] & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map);
+		CHECK(error                      == Error_Incomplete);
+		CHECK(index                      != 0);
+		CHECK(object.isNull()            == true);
+	}
+
+	SUBCASE("Map16")
+	{
+		Map map;
+		for(size_t i = 0; i < 16; i++)
+		{
+			map.set(Object{int64_t(i)}, Object{});
+		}
+		data = serialize(map);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Map16);
+		CHECK(data[1]         == (uint8_t)Format::Fixed_Int_Pos);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Map32")
+	{
+		Map map;
+		for(size_t i = 0; i < (std::numeric_limits<uint16_t>::max() + 1) ; i++)
+		{
+			map.set(Object{int64_t(i)}, Object{});
+		}
+		data = serialize(map);
+		data.resize(data.size() / 2);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Map32);
+		CHECK(data[1]         == (uint8_t)Format::Fixed_Int_Pos);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Fixed_Ext1")
+	{
+		Ext ext;
+		ext.data = std::pmr::vector<uint8_t>(1, 'X');
+		data = serialize(ext);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext1);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Fixed_Ext2")
+	{
+		Ext ext;
+		ext.data = std::pmr::vector<uint8_t>(2, 'X');
+		data = serialize(ext);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext2);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Fixed_Ext4")
+	{
+		Ext ext;
+		ext.data = std::pmr::vector<uint8_t>(4, 'X');
+		data = serialize(ext);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext4);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Fixed_Ext8")
+	{
+		Ext ext;
+		ext.data = std::pmr::vector<uint8_t>(8, 'X');
+		data = serialize(ext);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext8);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Fixed_Ext16")
+	{
+		Ext ext;
+		ext.data = std::pmr::vector<uint8_t>(16, 'X');
+		data = serialize(ext);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext16);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Ext8")
+	{
+		Ext ext;
+		ext.data = std::pmr::vector<uint8_t>(0, 'X');
+		data = serialize(ext);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Ext8);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Ext16")
+	{
+		Ext ext;
+		ext.data = std::pmr::vector<uint8_t>(std::numeric_limits<uint8_t>::max() + 1, 'X');
+		data = serialize(ext);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Ext16);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("Ext32")
+	{
+		Ext ext;
+		ext.data = std::pmr::vector<uint8_t>(std::numeric_limits<uint16_t>::max() + 1, 'X');
+		data = serialize(ext);
+		data.resize(data.size() - 1);
+
+		object = deserialize(data, index, error);
+		CHECK(data[0]         == (uint8_t)Format::Ext32);
+		CHECK(error           == Error_Incomplete);
+		CHECK(index           != 0);
+		CHECK(object.isNull() == true);
+	}
+
+	SUBCASE("multi-part/null")
+	{
+		std::vector<uint8_t> vector = {};
+
+		Object object = Object{};
+		data = serialize(object);
+
+		const int multi_part_count = 3;
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
-			const size_t length = data[index++];
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-			if((index + length) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
+		size_t last_index = 0;
+
+		index = 0;
+		error = Error_None;
+
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error         == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.isNull() == true);
+
+			last_index = index;
+		}
+	}
+
+	SUBCASE("multi-part/false")
+	{
+		std::vector<uint8_t> vector = {};
+
+		Object object = Object{false};
+		data = serialize(object);
+
+		const int multi_part_count = 3;
 
-			std::string_view str((char*)&data[index], length);
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
+
+		size_t last_index = 0;
+
+		index = 0;
+		error = Error_None;
+
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<bool>() == true);
+			CHECK(part.as<bool>() == false);
+
+			last_index = index;
+		}
+	}
+
+	SUBCASE("multi-part/true")
+	{
+		std::vector<uint8_t> vector = {};
+
+		Object object = Object{true};
+		data = serialize(object);
+
+		const int multi_part_count = 3;
+
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
+
+		size_t last_index = 0;
+
+		index = 0;
+		error = Error_None;
+
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<bool>() == true);
+			CHECK(part.as<bool>() == true);
+
+			last_index = index;
+		}
+	}
+
+	SUBCASE("multi-part/int8")
+	{
+		std::vector<uint8_t> vector = {};
+
+		const int     multi_part_count = 3;
+		const int64_t value_start      = std::numeric_limits<int8_t>::min();
+		int64_t       value            = value_start;
 
-			index += length;
+		for(int i = 0; i < multi_part_count; i++, value++)
+		{
+			Object object = Object{value};
+			data = serialize(object);
+
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
+
+		size_t last_index = 0;
+
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++, value++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<int64_t>() == true);
+			CHECK(part.as<int64_t>() == value);
+
+			last_index = index;
+		}
+	}
+
+	SUBCASE("multi-part/int16")
+	{
+		std::vector<uint8_t> vector = {};
+
+		const int     multi_part_count = 3;
+		const int64_t value_start      = std::numeric_limits<int16_t>::min();
+		int64_t       value            = value_start;
+
+		for(int i = 0; i < multi_part_count; i++, value++)
+		{
+			Object object = Object{value};
+			data = serialize(object);
+
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
+
+		size_t last_index = 0;
+
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++, value++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<int64_t>() == true);
+			CHECK(part.as<int64_t>() == value);
+
+			last_index = index;
+		}
+	}
+
+	SUBCASE("multi-part/int32")
+	{
+		std::vector<uint8_t> vector = {};
 
-			return Object{std::string(str)};
-		}
+		const int     multi_part_count = 3;
+		const int64_t value_start      = std::numeric_limits<int32_t>::min();
+		int64_t       value            = value_start;
 
-		case Format::Str16:
+		for(int i = 0; i < multi_part_count; i++, value++)
 		{
-			Convert.uint64 = 0;
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t length = Convert.uint64;
-
-			if((index + length) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
+			Object object = Object{value};
+			data = serialize(object);
 
-			const std::string_view str((char*)&data[index], length);
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-			index += length;
+		size_t last_index = 0;
 
-			return Object{std::string(str)};
-		}
-	
-		case Format::Str32:
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++, value++)
 		{
-			Convert.uint64 = 0;
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t length = Convert.uint64;
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<int64_t>() == true);
+			CHECK(part.as<int64_t>() == value);
 
-			if((index + length) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
+			last_index = index;
+		}
+	}
 
-			const std::string_view str((char*)&data[index], length);
+	SUBCASE("multi-part/int64")
+	{
+		std::vector<uint8_t> vector = {};
 
-			index += length;
+		const int     multi_part_count = 3;
+		const int64_t value_start      = std::numeric_limits<int64_t>::min();
+		int64_t       value            = value_start;
 
-			return Object{std::string(str)};
-		}
-	
-		case Format::Bin8:
+		for(int i = 0; i < multi_part_count; i++, value++)
 		{
-			const size_t length = data[index++];
-
-			if((index + length) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
+			Object object = Object{value};
+			data = serialize(object);
 
-			std::vector<uint8_t> vector(length);
-			memcpy((void*)vector.data(), (void*)&data[index], length);
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-			index += length;
+		size_t last_index = 0;
 
-			return Object{std::move(vector)};
-		}
-	
-		case Format::Bin16:
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++, value++)
 		{
-			Convert.uint64 = 0;
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t length = Convert.uint64;
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<int64_t>() == true);
+			CHECK(part.as<int64_t>() == value);
 
-			if((index + length) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
+			last_index = index;
+		}
+	}
 
-			std::vector<uint8_t> vector(length);
-			memcpy((void*)vector.data(), (void*)&data[index], length);
+	SUBCASE("multi-part/uint8")
+	{
+		std::vector<uint8_t> vector = {};
 
-			index += length;
+		const int      multi_part_count = 3;
+		const uint64_t value_start      = std::numeric_limits<uint8_t>::max();
+		uint64_t       value            = value_start;
 
-			return Object{std::move(vector)};
-		}
-	
-		case Format::Bin32:
+		for(int i = 0; i < multi_part_count; i++, value--)
 		{
-			Convert.uint64 = 0;
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t length = Convert.uint64;
+			Object object = Object{(uint64_t)value};
+			data = serialize(object);
 
-			if((index + length) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-			std::vector<uint8_t> vector(length);
-			memcpy((void*)vector.data(), (void*)&data[index], length);
+		size_t last_index = 0;
 
-			index += length;
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++, value--)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<uint64_t>() == true);
+			CHECK(part.as<uint64_t>() == value);
 
-			return Object{std::move(vector)};
+			last_index = index;
 		}
+	}
 
-		case Format::Array16:
-		{
-			Object object = {Array{}};
-
-			Convert.uint64 = 0;
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t count = Convert.uint64;
+	SUBCASE("multi-part/uint16")
+	{
+		std::vector<uint8_t> vector = {};
 
-			for(size_t i = 0; i < count; i++)
-			{
-				object.asArray().append(deserialize(data, index, error));
-				if(error)
-				{
-					return {};
-				}
-			}
+		const int      multi_part_count = 3;
+		const uint64_t value_start      = std::numeric_limits<uint16_t>::max();
+		uint64_t       value            = value_start;
 
-			return object;
-		}
-	
-		case Format::Array32:
+		for(int i = 0; i < multi_part_count; i++, value--)
 		{
-			Object object = {Array{}};
-
-			Convert.uint64 = 0;
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t count = Convert.uint64;
-
-			for(size_t i = 0; i < count; i++)
-			{
-				object.asArray().append(deserialize(data, index, error));
-				if(error)
-				{
-					return {};
-				}
-			}
+			Object object = Object{(uint64_t)value};
+			data = serialize(object);
 
-			return object;
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
 		}
 
-		case Format::Map16:
-		{
-			Object object = {Map{}};
-
-			Convert.uint64 = 0;
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t count = Convert.uint64;
+		size_t last_index = 0;
 
-			for(size_t i = 0; i < count; i++)
-			{
-				Object key = deserialize(data, index, error);
-				if(error)
-				{
-					return {};
-				}
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++, value--)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<uint64_t>() == true);
+			CHECK(part.as<uint64_t>() == value);
 
-				Object val = deserialize(data, index, error);
-				if(error)
-				{
-					return {};
-				}
+			last_index = index;
+		}
+	}
 
-				object.asMap().set(std::move(key), std::move(val));
-			}
+	SUBCASE("multi-part/uint32")
+	{
+		std::vector<uint8_t> vector = {};
 
-			return object;
-		}
+		const int      multi_part_count = 3;
+		const uint64_t value_start      = std::numeric_limits<uint32_t>::max();
+		uint64_t       value            = value_start;
 
-		case Format::Map32:
+		for(int i = 0; i < multi_part_count; i++, value--)
 		{
-			Object object = {Map{}};
-
-			Convert.uint64 = 0;
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t count = Convert.uint64;
+			Object object = Object{(uint64_t)value};
+			data = serialize(object);
 
-			for(size_t i = 0; i < count; i++)
-			{
-				Object key = deserialize(data, index, error);
-				if(error)
-				{
-					return {};
-				}
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-				Object val = deserialize(data, index, error);
-				if(error)
-				{
-					return {};
-				}
+		size_t last_index = 0;
 
-				object.asMap().set(std::move(key), std::move(val));
-			}
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++, value--)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<uint64_t>() == true);
+			CHECK(part.as<uint64_t>() == value);
 
-			return object;
+			last_index = index;
 		}
+	}
 
-		case Format::Fixed_Ext1:
-		{
-			Object object = {Ext{}};
-			Ext& ext = object.asExt();
+	SUBCASE("multi-part/uint64")
+	{
+		std::vector<uint8_t> vector = {};
 
-			Convert.uint64 = 0;
-			Convert.uint8  = data[index++];
-			ext.type = Convert.int8;
+		const int      multi_part_count = 3;
+		const uint64_t value_start      = std::numeric_limits<uint64_t>::max();
+		uint64_t       value            = value_start;
 
-			ext.data.push_back(data[index++]);
+		for(int i = 0; i < multi_part_count; i++, value--)
+		{
+			Object object = Object{(uint64_t)value};
+			data = serialize(object);
 
-			return object;
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
 		}
 
-		case Format::Fixed_Ext2:
+		size_t last_index = 0;
+
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++, value--)
 		{
-			Object object = {Ext{}};
-			Ext& ext = object.asExt();
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<uint64_t>() == true);
+			CHECK(part.as<uint64_t>() == value);
 
-			Convert.uint64 = 0;
-			Convert.uint8  = data[index++];
-			ext.type = Convert.int8;
+			last_index = index;
+		}
+	}
 
-			ext.data.push_back(data[index++]);
-			ext.data.push_back(data[index++]);
+	SUBCASE("multi-part/float32")
+	{
+		std::vector<uint8_t> vector = {};
 
-			return object;
-		}
+		const int   multi_part_count = 3;
+		const float value_start      = std::numeric_limits<float>::max();
+		float       value            = value_start;
 
-		case Format::Fixed_Ext4:
+		for(int i = 0; i < multi_part_count; i++)
 		{
-			Object object = {Ext{}};
-			Ext& ext = object.asExt();
-
-			Convert.uint64 = 0;
-			Convert.uint8  = data[index++];
-			ext.type = Convert.int8;
+			value = value - 1.1f;
 
-			ext.data.push_back(data[index++]);
-			ext.data.push_back(data[index++]);
-			ext.data.push_back(data[index++]);
-			ext.data.push_back(data[index++]);
+			Object object = Object{(float)value};
+			data = serialize(object);
 
-			return object;
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
 		}
 
-		case Format::Fixed_Ext8:
-		{
-			Object object = {Ext{}};
-			Ext& ext = object.asExt();
-
-			Convert.uint64 = 0;
-			Convert.uint8  = data[index++];
-			ext.type = Convert.int8;
+		size_t last_index = 0;
 
-			const size_t data_size = 8;
-			ext.data.reserve(data_size);
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			value = value - 1.1f;
 
-			for(size_t i = 0; i < data_size; i++)
-			{
-				ext.data.push_back(data[index++]);
-			}
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<float>() == true);
+			CHECK(part.as<float>() == value);
 
-			return object;
+			last_index = index;
 		}
+	}
 
-		case Format::Fixed_Ext16:
-		{
-			Object object = {Ext{}};
-			Ext& ext = object.asExt();
+	SUBCASE("multi-part/float64")
+	{
+		std::vector<uint8_t> vector = {};
 
-			Convert.uint64 = 0;
-			Convert.uint8  = data[index++];
-			ext.type = Convert.int8;
+		const int    multi_part_count = 3;
+		const double value_start      = std::numeric_limits<double>::max();
+		double       value            = value_start;
 
-			const size_t data_size = 16;
-			ext.data.reserve(data_size);
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			value = value - 1.1f;
 
-			for(size_t i = 0; i < data_size; i++)
-			{
-				ext.data.push_back(data[index++]);
-			}
+			Object object = Object{(double)value};
+			data = serialize(object);
 
-			return object;
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
 		}
 
-		case Format::Ext8:
+		size_t last_index = 0;
+
+		index = 0;
+		error = Error_None;
+		value = value_start;
+		for(int i = 0; i < multi_part_count; i++)
 		{
-			Object object = {Ext{}};
-			Ext& ext = object.asExt();
+			value = value - 1.1f;
 
-			const size_t data_size = data[index++];
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.is<double>() == true);
+			CHECK(part.as<double>() == value);
 
-			if((index + data_size) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
+			last_index = index;
+		}
+	}
 
-			Convert.uint64 = 0;
-			Convert.uint8  = data[index++];
-			ext.type = Convert.int8;
+	SUBCASE("multi-part/str8")
+	{
+		std::vector<uint8_t> vector = {};
 
-			if(data_size > 0)
-			{
-				ext.data.resize(data_size);
-				memcpy((void*)ext.data.data(), (void*)&data[index], data_size);
-				index += data_size;
-			}
+		const int              multi_part_count = 3;
+		const std::pmr::string value            = std::pmr::string(std::numeric_limits<uint8_t>::max(), 'X');
 
-			return object;
-		}
+		Object object = Object{value};
+		data = serialize(object);
 
-		case Format::Ext16:
+		for(int i = 0; i < multi_part_count; i++)
 		{
-			Object object = {Ext{}};
-			Ext& ext = object.asExt();
-
-			Convert.uint64 = 0;
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t data_size = Convert.uint16;
-
-			if((index + data_size) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-			Convert.uint64 = 0;
-			Convert.uint8  = data[index++];
-			ext.type = Convert.int8;
+		size_t last_index = 0;
 
-			ext.data.resize(data_size);
-			memcpy((void*)ext.data.data(), (void*)&data[index], data_size);
+		index = 0;
+		error = Error_None;
 
-			index += data_size;
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.isString() == true);
+			CHECK(part.asString() == value);
 
-			return object;
+			last_index = index;
 		}
+	}
 
-		case Format::Ext32:
-		{
-			Object object = {Ext{}};
-			Ext& ext = object.asExt();
+	SUBCASE("multi-part/str16")
+	{
+		std::vector<uint8_t> vector = {};
 
-			Convert.uint64 = 0;
-			Convert_Byte3 = data[index++];
-			Convert_Byte2 = data[index++];
-			Convert_Byte1 = data[index++];
-			Convert_Byte0 = data[index++];
-			const size_t data_size = Convert.uint32;
+		const int              multi_part_count = 3;
+		const std::pmr::string value            = std::pmr::string(std::numeric_limits<uint8_t>::max() + 1, 'X');
 
-			if((index + data_size) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
+		Object object = Object{value};
+		data = serialize(object);
 
-			Convert.uint64 = 0;
-			Convert.uint8  = data[index++];
-			ext.type = Convert.int8;
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-			ext.data.resize(data_size);
-			memcpy((void*)ext.data.data(), (void*)&data[index], data_size);
+		size_t last_index = 0;
 
-			index += data_size;
+		index = 0;
+		error = Error_None;
 
-			return object;
-		}
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.isString() == true);
+			CHECK(part.asString() == value);
 
-		case Format::Fixed_Int_Pos:
-		case Format::Fixed_Int_Neg:
-		case Format::Fixed_Array:
-		case Format::Fixed_Str:
-		case Format::Fixed_Map:
-		case Format::Never_Used:
-			// Handled outside of this swith() statement
-			break;
+			last_index = index;
+		}
 	}
 
-	if((format_byte & (uint8_t)Fixed_Int_Pos_Mask) == (uint8_t)Format::Fixed_Int_Pos)
+	SUBCASE("multi-part/str32")
 	{
-		const int64_t value = format_byte & (uint8_t)Fixed_Int_Pos_Value;
-
-		return Object{value};
-	}
+		std::vector<uint8_t> vector = {};
 
-	if((format_byte & (uint8_t)Fixed_Int_Neg_Mask) == (uint8_t)Format::Fixed_Int_Neg)
-	{
-		const int64_t value = (int8_t)(format_byte & Fixed_Int_Neg_Value) - 32;
+		const int              multi_part_count = 3;
+		const std::pmr::string value            = std::pmr::string(std::numeric_limits<uint16_t>::max() + 1, 'X');
 
-		return Object{value};
-	}
-	
-	if((format_byte & (uint8_t)Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str)
-	{
-		const size_t length = format_byte & Fixed_Str_Value;
+		Object object = Object{value};
+		data = serialize(object);
 
-		if(length == 0)
+		for(int i = 0; i < multi_part_count; i++)
 		{
-			return Object{std::string("")};
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
 		}
-		else
-		{
-			if((index + length) > data.size())
-			{
-				error = Error_Incomplete;
-				return Object{};
-			}
 
-			std::string_view str((char*)&data[index], length);
+		size_t last_index = 0;
+
+		index = 0;
+		error = Error_None;
 
-			index += length;
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error           == Error_None);
+			CHECK(last_index      != index);
+			CHECK(part.isString() == true);
+			CHECK(part.asString() == value);
 
-			return Object{std::string(str)};
+			last_index = index;
 		}
 	}
-	
-	if((format_byte & (uint8_t)Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array)
+
+	SUBCASE("multi-part/bin8")
 	{
-		Object object = {Array{}};
+		std::vector<uint8_t> vector = {};
 
-		const size_t count = format_byte & (uint8_t)Fixed_Array_Value;
+		const int                       multi_part_count = 3;
+		const std::pmr::vector<uint8_t> value            = std::pmr::vector<uint8_t>(std::numeric_limits<uint8_t>::max(), 0xff);
 
-		for(size_t i = 0; i < count; i++)
-		{
-			object.asArray().append(deserialize(data, index, error));
+		Object object = Object{value};
+		data = serialize(object);
 
-			if(error)
-			{
-				return {};
-			}
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
 		}
 
-		return object;
-	}
-	
-	if((format_byte & (uint8_t)Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map)
-	{
-		Object object = {Map{}};
+		size_t last_index = 0;
 
-		const size_t count = format_byte & (uint8_t)Fixed_Map_Value;
+		index = 0;
+		error = Error_None;
 
-		for(size_t i = 0; i < count; i++)
+		for(int i = 0; i < multi_part_count; i++)
 		{
-			Object key = deserialize(data, index, error);
-			if(error)
-			{
-				return {};
-			}
+			Object part = deserialize(vector, index, error);
+			CHECK(error                  == Error_None);
+			CHECK(last_index             != index);
+			CHECK(part.isBinary()        == true);
+			CHECK(part.asBinary().size() == value.size());
 
-			Object val = deserialize(data, index, error);
-			if(error)
+			std::pmr::vector<uint8_t>& bin = part.asBinary();
+			for(size_t i = 0; i < value.size(); i++)
 			{
-				return {};
+				CHECK(bin[i] == value[i]);
 			}
 
-			object.asMap().set(std::move(key), std::move(val));
+			last_index = index;
 		}
-
-		return object;
 	}
-	
-	return {};
-}
-
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("deserialize/error")
-{
-	std::vector<uint8_t> data   = {};
-	std::error_code      error  = {};
-	Object               object = {};
-	size_t               index  = 0;
 
-	SUBCASE("no data")
-	{
-		object = deserialize(data, index, error);
-		CHECK(error           == Error_No_Data);
-		CHECK(index           == 0);
-		CHECK(object.isNull() == true);
-	}
-	
-	SUBCASE("invalid index")
+	SUBCASE("multi-part/bin16")
 	{
-		data.push_back(0);
-		index = 10;
+		std::vector<uint8_t> vector = {};
 
-		object = deserialize(data, index, error);
-		CHECK(error           == Error_Invalid_Index);
-		CHECK(index           == 10);
-		CHECK(object.isNull() == true);
-	}
+		const int                       multi_part_count = 3;
+		const std::pmr::vector<uint8_t> value            = std::pmr::vector<uint8_t>(std::numeric_limits<uint8_t>::max() + 1, 0xff);
 
-	SUBCASE("Never_Used")
-	{
-		data.push_back((uint8_t)Format::Never_Used);
+		Object object = Object{value};
+		data = serialize(object);
 
-		object = deserialize(data, index, error);
-		CHECK(error           == Error_Invalid_Format_Type);
-		CHECK(index           == 1);
-		CHECK(object.isNull() == true);
-	}
-	
-	// The following format ID's can not be tested for incomplete data
-	// because the value is encoded in the Format ID itself:
-	// - Nill
-	// - True
-	// - False
-	// - Fixed_Int_Pos
-	// - Fixed_Int_Neg
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-	SUBCASE("Uint8")
-	{
-		object = Object{(uint64_t)std::numeric_limits<uint8_t>::max()};
-		object = Object{uint64_t(0xff)};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		size_t last_index = 0;
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Uint8);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
+		index = 0;
+		error = Error_None;
+
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error                  == Error_None);
+			CHECK(last_index             != index);
+			CHECK(part.isBinary()        == true);
+			CHECK(part.asBinary().size() == value.size());
+
+			std::pmr::vector<uint8_t>& bin = part.asBinary();
+			for(size_t i = 0; i < value.size(); i++)
+			{
+				CHECK(bin[i] == value[i]);
+			}
+
+			last_index = index;
+		}
 	}
 
-	SUBCASE("Uint16")
+	SUBCASE("multi-part/bin32")
 	{
-		object = Object{(uint64_t)std::numeric_limits<uint16_t>::max()};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		std::vector<uint8_t> vector = {};
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Uint16);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		const int                       multi_part_count = 3;
+		const std::pmr::vector<uint8_t> value            = std::pmr::vector<uint8_t>(std::numeric_limits<uint16_t>::max() + 1, 0xff);
 
-	SUBCASE("Uint32")
-	{
-		object = Object{(uint64_t)std::numeric_limits<uint32_t>::max()};
+		Object object = Object{value};
 		data = serialize(object);
-		data.resize(data.size() - 1);
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Uint32);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-	SUBCASE("Uint64")
-	{
-		object = Object{(uint64_t)std::numeric_limits<uint64_t>::max()};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		size_t last_index = 0;
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Uint64);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		index = 0;
+		error = Error_None;
 
-	SUBCASE("Int8")
-	{
-		object = Object{int64_t(std::numeric_limits<int8_t>::min())};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error                  == Error_None);
+			CHECK(last_index             != index);
+			CHECK(part.isBinary()        == true);
+			CHECK(part.asBinary().size() == value.size());
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Int8);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
+			std::pmr::vector<uint8_t>& bin = part.asBinary();
+			for(size_t i = 0; i < value.size(); i++)
+			{
+				CHECK(bin[i] == value[i]);
+			}
+
+			last_index = index;
+		}
 	}
 
-	SUBCASE("Int16")
+	SUBCASE("multi-part/array16")
 	{
-		object = Object{int64_t(std::numeric_limits<int16_t>::min())};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		std::vector<uint8_t> vector = {};
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Int16);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		const int    multi_part_count = 3;
+		const size_t value_len        = std::numeric_limits<uint8_t>::max() + 1;
 
-	SUBCASE("Int32")
-	{
-		object = Object{int64_t(std::numeric_limits<int32_t>::min())};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		Array value;
+		value.resize(value_len);
+		int data_type = 0;
+		for(size_t i = 0; i < value_len; i++)
+		{
+			switch(data_type)
+			{
+				case 0: value[i] = Object{};               break;
+				case 1: value[i] = Object{false};          break;
+				case 2: value[i] = Object{true};           break;
+				case 3: value[i] = Object{(uint64_t)0xff}; break;
+			}
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Int32);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+			data_type = (data_type + 1) % 4;
+		}
 
-	SUBCASE("Int64")
-	{
-		object = Object{std::numeric_limits<int64_t>::min()};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		data = serialize(value);
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Int64);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-	SUBCASE("Float32")
-	{
-		object = Object{std::numeric_limits<float>::min()};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		size_t last_index = 0;
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Float32);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		index = 0;
+		error = Error_None;
 
-	SUBCASE("Float64")
-	{
-		object = Object{std::numeric_limits<double>::min()};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error                 == Error_None);
+			CHECK(last_index            != index);
+			CHECK(part.isArray()        == true);
+			CHECK(part.asArray().size() == value.size());
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Float64);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
+			Array& array = part.asArray();
+			for(size_t i = 0; i < value.size(); i++)
+			{
+				CHECK(array[i] == value[i]);
+			}
+
+			last_index = index;
+		}
 	}
 
-	SUBCASE("Fixed_Str")
+	SUBCASE("multi-part/array32")
 	{
-		object = Object{std::string(16, 'X')};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		std::vector<uint8_t> vector = {};
 
-		object = deserialize(data, index, error);
-		CHECK((data[0] & Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str);
-		CHECK(error                      == Error_Incomplete);
-		CHECK(index                      != 0);
-		CHECK(object.isNull()            == true);
-	}
+		const int    multi_part_count = 3;
+		const size_t value_len        = std::numeric_limits<uint16_t>::max() + 1;
 
-	SUBCASE("Str8")
-	{
-		object = Object{std::string(32, 'X')};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		Array value;
+		value.resize(value_len);
+		int data_type = 0;
+		for(size_t i = 0; i < value_len; i++)
+		{
+			switch(data_type)
+			{
+				case 0: value[i] = Object{};               break;
+				case 1: value[i] = Object{false};          break;
+				case 2: value[i] = Object{true};           break;
+				case 3: value[i] = Object{(uint64_t)0xff}; break;
+			}
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Str8);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+			data_type = (data_type + 1) % 4;
+		}
 
-	SUBCASE("Str16")
-	{
-		object = Object{std::string(std::numeric_limits<uint8_t>::max() + 1, 'X')};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		data = serialize(value);
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Str16);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-	SUBCASE("Str32")
-	{
-		object = Object{std::string(std::numeric_limits<uint16_t>::max() + 1, 'X')};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		size_t last_index = 0;
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Str32);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		index = 0;
+		error = Error_None;
 
-	SUBCASE("Bin8")
-	{
-		object = Object{std::vector<uint8_t>(0, 'X')};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error                 == Error_None);
+			CHECK(last_index            != index);
+			CHECK(part.isArray()        == true);
+			CHECK(part.asArray().size() == value.size());
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Bin8);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
+			Array& array = part.asArray();
+			for(size_t i = 0; i < value.size(); i++)
+			{
+				CHECK(array[i] == value[i]);
+			}
+
+			last_index = index;
+		}
 	}
 
-	SUBCASE("Bin16")
+	SUBCASE("multi-part/map16")
 	{
-		object = Object{std::vector<uint8_t>(std::numeric_limits<uint8_t>::max() + 1, 'X')};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		std::vector<uint8_t> vector = {};
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Bin16);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		const int    multi_part_count = 3;
+		const size_t value_len        = std::numeric_limits<uint8_t>::max() + 1;
 
-	SUBCASE("Bin32")
-	{
-		object = Object{std::vector<uint8_t>(std::numeric_limits<uint16_t>::max() + 1, 'X')};
-		data = serialize(object);
-		data.resize(data.size() - 1);
+		Map value;
+		int data_type = 0;
+		for(size_t i = 0; i < value_len; i++)
+		{
+			switch(data_type)
+			{
+				case 0: value[i] = Object{};               break;
+				case 1: value[i] = Object{false};          break;
+				case 2: value[i] = Object{true};           break;
+				case 3: value[i] = Object{(uint64_t)0xff}; break;
+			}
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Bin32);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+			data_type = (data_type + 1) % 4;
+		}
 
-	SUBCASE("Fixed_Array")
-	{
-		// Check the Array itself
-		Array array;
-		array.object_vector = std::vector<Object>(8, Object{});
-		data = serialize(array);
-		data.resize(data.size() - 1);
+		data = serialize(value);
 
-		object = deserialize(data, index, error);
-		CHECK((data[0] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
-		CHECK(error                        == Error_Invalid_Index);
-		CHECK(index                        != 0);
-		CHECK(object.isNull()              == true);
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
+
+		size_t last_index = 0;
 
-		// Check the contents of the Array
 		index = 0;
-		array.object_vector = std::vector<Object>(1, Object{});
-		array.object(0) = Object{std::string("ABC")};
-		data = serialize(array);
-		data.resize(data.size() - 1);
+		error = Error_None;
 
-		object = deserialize(data, index, error);
-		CHECK((data[0] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
-		CHECK(error                        == Error_Incomplete);
-		CHECK(index                        != 0);
-		CHECK(object.isNull()              == true);
-	}
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error               == Error_None);
+			CHECK(last_index          != index);
+			CHECK(part.isMap()        == true);
+			CHECK(part.asMap().size() == value.size());
 
-	SUBCASE("Array16")
-	{
-		Array array;
-		array.object_vector = std::vector<Object>(16, Object{});
-		data = serialize(array);
-		data.resize(data.size() - 1);
+			Map& map = part.asMap();
+			for(size_t i = 0; i < value.size(); i++)
+			{
+				CHECK(map[i] == value[i]);
+			}
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Array16);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
+			last_index = index;
+		}
 	}
 
-	SUBCASE("Array32")
+	SUBCASE("multi-part/map32")
 	{
-		Array array;
-		array.object_vector = std::vector<Object>(std::numeric_limits<uint16_t>::max() + 1, Object{});
-		data = serialize(array);
-		data.resize(data.size() - 1);
+		std::vector<uint8_t> vector = {};
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Array32);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		const int    multi_part_count = 3;
+		const size_t value_len        = std::numeric_limits<uint16_t>::max() + 1;
 
-	SUBCASE("Fixed_Map")
-	{
-		// Check the Map itself
-		Map map;
-		map.set(Object{}, Object{});
-		data = serialize(map);
-		data.resize(data.size() - 1);
+		Map value;
+		int data_type = 0;
+		for(size_t i = 0; i < value_len; i++)
+		{
+			switch(data_type)
+			{
+				case 0: value[i] = Object{};               break;
+				case 1: value[i] = Object{false};          break;
+				case 2: value[i] = Object{true};           break;
+				case 3: value[i] = Object{(uint64_t)0xff}; break;
+			}
 
-		object = deserialize(data, index, error);
-		CHECK((data[0] & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map);
-		CHECK(error                        == Error_Invalid_Index);
-		CHECK(index                        != 0);
-		CHECK(object.isNull()              == true);
+			data_type = (data_type + 1) % 4;
+		}
+
+		data = serialize(value);
+
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
+
+		size_t last_index = 0;
 
-		// Check the contents of the Map
 		index = 0;
-		map.set(Object{int64_t(0)}, Object{});
-		map.set(Object{int64_t(1)}, Object{std::string("Hello, World")});
-		data = serialize(map);
-		data.resize(data.size() - 1);
+		error = Error_None;
 
-		object = deserialize(data, index, error);
-		CHECK((data[0] & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map);
-		CHECK(error                      == Error_Incomplete);
-		CHECK(index                      != 0);
-		CHECK(object.isNull()            == true);
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error               == Error_None);
+			CHECK(last_index          != index);
+			CHECK(part.isMap()        == true);
+			CHECK(part.asMap().size() == value.size());
+
+			Map& map = part.asMap();
+			for(size_t i = 0; i < value.size(); i++)
+			{
+				CHECK(map[i] == value[i]);
+			}
+
+			last_index = index;
+		}
 	}
 
-	SUBCASE("Map16")
+	SUBCASE("multi-part/ext (fixed_ext1)")
 	{
-		Map map;
-		for(size_t i = 0; i < 16; i++)
+		std::vector<uint8_t> vector = {};
+
+		const int    multi_part_count = 3;
+		const size_t data_len         = 1;
+		const int8_t type             = 42;
+
+		Ext value;
+		value.type = type;
+		value.data = std::pmr::vector<uint8_t>(data_len, '_');
+
+		data = serialize(value);
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
-			map.set(Object{int64_t(i)}, Object{});
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
 		}
-		data = serialize(map);
-		data.resize(data.size() - 1);
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Map16);
-		CHECK(data[1]         == (uint8_t)Format::Fixed_Int_Pos);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		size_t last_index = 0;
 
-	SUBCASE("Map32")
-	{
-		Map map;
-		for(size_t i = 0; i < (std::numeric_limits<uint16_t>::max() + 1) ; i++)
+		index = 0;
+		error = Error_None;
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
-			map.set(Object{int64_t(i)}, Object{});
-		}
-		data = serialize(map);
-		data.resize(data.size() / 2);
+			Object part = deserialize(vector, index, error);
+			CHECK(error        == Error_None);
+			CHECK(last_index   != index);
+			CHECK(part.isExt() == true);
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Map32);
-		CHECK(data[1]         == (uint8_t)Format::Fixed_Int_Pos);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
+			Ext& ext = part.asExt();
+			CHECK(ext.type == value.type);
+			CHECK(ext.data == value.data);
+
+			last_index = index;
+		}
 	}
 
-	SUBCASE("Fixed_Ext1")
+	SUBCASE("multi-part/ext (fixed_ext2)")
 	{
-		Ext ext;
-		ext.data = std::vector<uint8_t>(1, 'X');
-		data = serialize(ext);
-		data.resize(data.size() - 1);
+		std::vector<uint8_t> vector = {};
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext1);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		const int    multi_part_count = 3;
+		const size_t data_len         = 2;
+		const int8_t type             = 42;
+
+		Ext value;
+		value.type = type;
+		value.data = std::pmr::vector<uint8_t>(data_len, '_');
+
+		data = serialize(value);
+
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
+
+		size_t last_index = 0;
 
-	SUBCASE("Fixed_Ext2")
-	{
-		Ext ext;
-		ext.data = std::vector<uint8_t>(2, 'X');
-		data = serialize(ext);
-		data.resize(data.size() - 1);
+		index = 0;
+		error = Error_None;
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext2);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error        == Error_None);
+			CHECK(last_index   != index);
+			CHECK(part.isExt() == true);
 
-	SUBCASE("Fixed_Ext4")
-	{
-		Ext ext;
-		ext.data = std::vector<uint8_t>(4, 'X');
-		data = serialize(ext);
-		data.resize(data.size() - 1);
+			Ext& ext = part.asExt();
+			CHECK(ext.type == value.type);
+			CHECK(ext.data == value.data);
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext4);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
+			last_index = index;
+		}
 	}
 
-	SUBCASE("Fixed_Ext8")
+	SUBCASE("multi-part/ext (fixed_ext4)")
 	{
-		Ext ext;
-		ext.data = std::vector<uint8_t>(8, 'X');
-		data = serialize(ext);
-		data.resize(data.size() - 1);
+		std::vector<uint8_t> vector = {};
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext8);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		const int    multi_part_count = 3;
+		const size_t data_len         = 4;
+		const int8_t type             = 42;
 
-	SUBCASE("Fixed_Ext16")
-	{
-		Ext ext;
-		ext.data = std::vector<uint8_t>(16, 'X');
-		data = serialize(ext);
-		data.resize(data.size() - 1);
+		Ext value;
+		value.type = type;
+		value.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Fixed_Ext16);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		data = serialize(value);
 
-	SUBCASE("Ext8")
-	{
-		Ext ext;
-		ext.data = std::vector<uint8_t>(0, 'X');
-		data = serialize(ext);
-		data.resize(data.size() - 1);
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			vector.insert(std::end(vector)
+				, std::begin(data), std::end(data)
+				);
+		}
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Ext8);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		size_t last_index = 0;
 
-	SUBCASE("Ext16")
-	{
-		Ext ext;
-		ext.data = std::vector<uint8_t>(std::numeric_limits<uint8_t>::max() + 1, 'X');
-		data = serialize(ext);
-		data.resize(data.size() - 1);
+		index = 0;
+		error = Error_None;
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Ext16);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
-	}
+		for(int i = 0; i < multi_part_count; i++)
+		{
+			Object part = deserialize(vector, index, error);
+			CHECK(error        == Error_None);
+			CHECK(last_index   != index);
+			CHECK(part.isExt() == true);
 
-	SUBCASE("Ext32")
-	{
-		Ext ext;
-		ext.data = std::vector<uint8_t>(std::numeric_limits<uint16_t>::max() + 1, 'X');
-		data = serialize(ext);
-		data.resize(data.size() - 1);
+			Ext& ext = part.asExt();
+			CHECK(ext.type == value.type);
+			CHECK(ext.data == value.data);
 
-		object = deserialize(data, index, error);
-		CHECK(data[0]         == (uint8_t)Format::Ext32);
-		CHECK(error           == Error_Incomplete);
-		CHECK(index           != 0);
-		CHECK(object.isNull() == true);
+			last_index = index;
+		}
 	}
 
-	SUBCASE("multi-part/null")
+	SUBCASE("multi-part/ext (fixed_ext8)")
 	{
 		std::vector<uint8_t> vector = {};
 
-		Object object = Object{};
-		data = serialize(object);
+		const int    multi_part_count = 3;
+		const size_t data_len         = 8;
+		const int8_t type             = 42;
 
-		const int multi_part_count = 3;
+		Ext value;
+		value.type = type;
+		value.data = std::pmr::vector<uint8_t>(data_len, '_');
+
+		data = serialize(value);
 
 		for(int i = 0; i < multi_part_count; i++)
 		{
@@ -6266,22 +20408,31 @@ TEST_CASE("deserialize/error")
 		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
-			CHECK(error         == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.isNull() == true);
+			CHECK(error        == Error_None);
+			CHECK(last_index   != index);
+			CHECK(part.isExt() == true);
+
+			Ext& ext = part.asExt();
+			CHECK(ext.type == value.type);
+			CHECK(ext.data == value.data);
 
 			last_index = index;
 		}
 	}
 
-	SUBCASE("multi-part/false")
+	SUBCASE("multi-part/ext (fixed_ext16)")
 	{
 		std::vector<uint8_t> vector = {};
 
-		Object object = Object{false};
-		data = serialize(object);
+		const int    multi_part_count = 3;
+		const size_t data_len         = 16;
+		const int8_t type             = 42;
 
-		const int multi_part_count = 3;
+		Ext value;
+		value.type = type;
+		value.data = std::pmr::vector<uint8_t>(data_len, '_');
+
+		data = serialize(value);
 
 		for(int i = 0; i < multi_part_count; i++)
 		{
@@ -6298,23 +20449,31 @@ TEST_CASE("deserialize/error")
 		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.is<bool>() == true);
-			CHECK(part.as<bool>() == false);
+			CHECK(error        == Error_None);
+			CHECK(last_index   != index);
+			CHECK(part.isExt() == true);
+
+			Ext& ext = part.asExt();
+			CHECK(ext.type == value.type);
+			CHECK(ext.data == value.data);
 
 			last_index = index;
 		}
 	}
 
-	SUBCASE("multi-part/true")
+	SUBCASE("multi-part/ext (ext8)")
 	{
 		std::vector<uint8_t> vector = {};
 
-		Object object = Object{true};
-		data = serialize(object);
+		const int    multi_part_count = 3;
+		const size_t data_len         = std::numeric_limits<uint8_t>::max();
+		const int8_t type             = 42;
 
-		const int multi_part_count = 3;
+		Ext value;
+		value.type = type;
+		value.data = std::pmr::vector<uint8_t>(data_len, '_');
+
+		data = serialize(value);
 
 		for(int i = 0; i < multi_part_count; i++)
 		{
@@ -6331,28 +20490,34 @@ TEST_CASE("deserialize/error")
 		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.is<bool>() == true);
-			CHECK(part.as<bool>() == true);
+			CHECK(error        == Error_None);
+			CHECK(last_index   != index);
+			CHECK(part.isExt() == true);
+
+			Ext& ext = part.asExt();
+			CHECK(ext.type == value.type);
+			CHECK(ext.data == value.data);
 
 			last_index = index;
 		}
 	}
 
-	SUBCASE("multi-part/int8")
+	SUBCASE("multi-part/ext (ext16)")
 	{
 		std::vector<uint8_t> vector = {};
 
-		const int     multi_part_count = 3;
-		const int64_t value_start      = std::numeric_limits<int8_t>::min();
-		int64_t       value            = value_start;
+		const int    multi_part_count = 3;
+		const size_t data_len         = std::numeric_limits<uint8_t>::max() + 1;
+		const int8_t type             = 42;
 
-		for(int i = 0; i < multi_part_count; i++, value++)
-		{
-			Object object = Object{value};
-			data = serialize(object);
+		Ext value;
+		value.type = type;
+		value.data = std::pmr::vector<uint8_t>(data_len, '_');
+
+		data = serialize(value);
 
+		for(int i = 0; i < multi_part_count; i++)
+		{
 			vector.insert(std::end(vector)
 				, std::begin(data), std::end(data)
 				);
@@ -6362,32 +20527,38 @@ TEST_CASE("deserialize/error")
 
 		index = 0;
 		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++, value++)
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.is<int64_t>() == true);
-			CHECK(part.as<int64_t>() == value);
+			CHECK(error        == Error_None);
+			CHECK(last_index   != index);
+			CHECK(part.isExt() == true);
+
+			Ext& ext = part.asExt();
+			CHECK(ext.type == value.type);
+			CHECK(ext.data == value.data);
 
 			last_index = index;
 		}
 	}
 
-	SUBCASE("multi-part/int16")
+	SUBCASE("multi-part/ext (ext32)")
 	{
 		std::vector<uint8_t> vector = {};
 
-		const int     multi_part_count = 3;
-		const int64_t value_start      = std::numeric_limits<int16_t>::min();
-		int64_t       value            = value_start;
+		const int    multi_part_count = 3;
+		const size_t data_len         = std::numeric_limits<uint16_t>::max() + 1;
+		const int8_t type             = 42;
 
-		for(int i = 0; i < multi_part_count; i++, value++)
-		{
-			Object object = Object{value};
-			data = serialize(object);
+		Ext value;
+		value.type = type;
+		value.data = std::pmr::vector<uint8_t>(data_len, '_');
+
+		data = serialize(value);
 
+		for(int i = 0; i < multi_part_count; i++)
+		{
 			vector.insert(std::end(vector)
 				, std::begin(data), std::end(data)
 				);
@@ -6397,32 +20568,35 @@ TEST_CASE("deserialize/error")
 
 		index = 0;
 		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++, value++)
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.is<int64_t>() == true);
-			CHECK(part.as<int64_t>() == value);
+			CHECK(error        == Error_None);
+			CHECK(last_index   != index);
+			CHECK(part.isExt() == true);
+
+			Ext& ext = part.asExt();
+			CHECK(ext.type == value.type);
+			CHECK(ext.data == value.data);
 
 			last_index = index;
 		}
 	}
 
-	SUBCASE("multi-part/int32")
+	SUBCASE("multi-part/fixed_int (positive)")
 	{
 		std::vector<uint8_t> vector = {};
 
 		const int     multi_part_count = 3;
-		const int64_t value_start      = std::numeric_limits<int32_t>::min();
-		int64_t       value            = value_start;
+		const int64_t value            = 1;
+
+		Object object = {value};
 
-		for(int i = 0; i < multi_part_count; i++, value++)
-		{
-			Object object = Object{value};
-			data = serialize(object);
+		data = serialize(object);
 
+		for(int i = 0; i < multi_part_count; i++)
+		{
 			vector.insert(std::end(vector)
 				, std::begin(data), std::end(data)
 				);
@@ -6432,12 +20606,12 @@ TEST_CASE("deserialize/error")
 
 		index = 0;
 		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++, value++)
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
+			CHECK(error              == Error_None);
+			CHECK(last_index         != index);
 			CHECK(part.is<int64_t>() == true);
 			CHECK(part.as<int64_t>() == value);
 
@@ -6445,19 +20619,19 @@ TEST_CASE("deserialize/error")
 		}
 	}
 
-	SUBCASE("multi-part/int64")
+	SUBCASE("multi-part/fixed_int (negative)")
 	{
 		std::vector<uint8_t> vector = {};
 
 		const int     multi_part_count = 3;
-		const int64_t value_start      = std::numeric_limits<int64_t>::min();
-		int64_t       value            = value_start;
+		const int64_t value            = -1;
 
-		for(int i = 0; i < multi_part_count; i++, value++)
-		{
-			Object object = Object{value};
-			data = serialize(object);
+		Object object = {value};
+
+		data = serialize(object);
 
+		for(int i = 0; i < multi_part_count; i++)
+		{
 			vector.insert(std::end(vector)
 				, std::begin(data), std::end(data)
 				);
@@ -6467,12 +20641,12 @@ TEST_CASE("deserialize/error")
 
 		index = 0;
 		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++, value++)
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
+			CHECK(error              == Error_None);
+			CHECK(last_index         != index);
 			CHECK(part.is<int64_t>() == true);
 			CHECK(part.as<int64_t>() == value);
 
@@ -6480,19 +20654,19 @@ TEST_CASE("deserialize/error")
 		}
 	}
 
-	SUBCASE("multi-part/uint8")
+	SUBCASE("multi-part/fixed_str")
 	{
 		std::vector<uint8_t> vector = {};
 
-		const int      multi_part_count = 3;
-		const uint64_t value_start      = std::numeric_limits<uint8_t>::max();
-		uint64_t       value            = value_start;
+		const int              multi_part_count = 3;
+		const std::pmr::string value            = "xyzzy";
 
-		for(int i = 0; i < multi_part_count; i++, value--)
-		{
-			Object object = Object{(uint64_t)value};
-			data = serialize(object);
+		Object object = {value};
 
+		data = serialize(object);
+
+		for(int i = 0; i < multi_part_count; i++)
+		{
 			vector.insert(std::end(vector)
 				, std::begin(data), std::end(data)
 				);
@@ -6502,32 +20676,36 @@ TEST_CASE("deserialize/error")
 
 		index = 0;
 		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++, value--)
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
 			CHECK(error           == Error_None);
 			CHECK(last_index      != index);
-			CHECK(part.is<uint64_t>() == true);
-			CHECK(part.as<uint64_t>() == value);
+			CHECK(part.isString() == true);
+			CHECK(part.asString() == value);
 
 			last_index = index;
 		}
 	}
 
-	SUBCASE("multi-part/uint16")
+	SUBCASE("multi-part/fixed_array")
 	{
 		std::vector<uint8_t> vector = {};
 
-		const int      multi_part_count = 3;
-		const uint64_t value_start      = std::numeric_limits<uint16_t>::max();
-		uint64_t       value            = value_start;
+		const int    multi_part_count = 3;
+		const size_t value_size       = 8;
 
-		for(int i = 0; i < multi_part_count; i++, value--)
+		Array value;
+		for(size_t i = 0; i < value_size; i++)
 		{
-			Object object = Object{(uint64_t)value};
-			data = serialize(object);
+			value.appendNull();
+		}
+
+		data = serialize(value);
 
+		for(int i = 0; i < multi_part_count; i++)
+		{
 			vector.insert(std::end(vector)
 				, std::begin(data), std::end(data)
 				);
@@ -6537,32 +20715,41 @@ TEST_CASE("deserialize/error")
 
 		index = 0;
 		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++, value--)
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.is<uint64_t>() == true);
-			CHECK(part.as<uint64_t>() == value);
+			CHECK(error          == Error_None);
+			CHECK(last_index     != index);
+			CHECK(part.isArray() == true);
+
+			Array& array = part.asArray();
+			for(size_t i = 0; i < value_size; i++)
+			{
+				CHECK(array[i] == value[i]);
+			}
 
 			last_index = index;
 		}
 	}
 
-	SUBCASE("multi-part/uint32")
+	SUBCASE("multi-part/fixed_map")
 	{
 		std::vector<uint8_t> vector = {};
 
-		const int      multi_part_count = 3;
-		const uint64_t value_start      = std::numeric_limits<uint32_t>::max();
-		uint64_t       value            = value_start;
+		const int    multi_part_count = 3;
+		const size_t value_size       = 8;
 
-		for(int i = 0; i < multi_part_count; i++, value--)
+		Map value;
+		for(size_t i = 0; i < value_size; i++)
 		{
-			Object object = Object{(uint64_t)value};
-			data = serialize(object);
+			value[i] = Object{};
+		}
+
+		data = serialize(value);
 
+		for(int i = 0; i < multi_part_count; i++)
+		{
 			vector.insert(std::end(vector)
 				, std::begin(data), std::end(data)
 				);
@@ -6572,2105 +20759,2769 @@ TEST_CASE("deserialize/error")
 
 		index = 0;
 		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++, value--)
+
+		for(int i = 0; i < multi_part_count; i++)
 		{
 			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.is<uint64_t>() == true);
-			CHECK(part.as<uint64_t>() == value);
+			CHECK(error        == Error_None);
+			CHECK(last_index   != index);
+			CHECK(part.isMap() == true);
+
+			Map& map = part.asMap();
+			for(size_t i = 0; i < value_size; i++)
+			{
+				CHECK(map[i] == value[i]);
+			}
 
 			last_index = index;
 		}
 	}
+}
+#endif // }}}
 
-	SUBCASE("multi-part/uint64")
+// }}} Utilities::deserialize
+// {{{ Utilities::deserializeBatch
+
+/**
+ * \brief Deserialize a sequence of Objects in parallel.
+ *
+ * The \p data holds Objects that were packed one after another. Every Object 
+ * will be deserialized and appended to the \p object_vector, in the same 
+ * order as the \p data.
+ *
+ * See deserializeBatch(const std::span<const uint8_t>, size_t&, 
+ * std::vector<Object>&, size_t) for details.
+ *
+ * \parcode
+ * std::vector<zakero::messagepack::Object> object_vector;
+ *
+ * std::error_code error = zakero::messagepack::deserializeBatch(data, object_vector);
+ * \endparcode
+ *
+ * \return An error code.
+ */
+std::error_code deserializeBatch(const std::span<const uint8_t> data          ///< The packed data
+	, std::vector<Object>&                    object_vector ///< The Objects
+	, size_t                                  thread_count  ///< The number of threads
+	) noexcept
+{
+	size_t index = 0;
+
+	return deserializeBatch(data, index, object_vector, thread_count);
+}
+
+
+/**
+ * \brief Deserialize a sequence of Objects in parallel.
+ *
+ * The \p data, starting at the \p index, holds Objects that were packed one 
+ * after another. Every Object will be deserialized and appended to the \p 
+ * object_vector, in the same order as the \p data.
+ *
+ * This is done in two passes:
+ * -# The start of each Object is found with skip(), which does not decode 
+ *    anything and does not allocate memory. Then the \p object_vector is 
+ *    resized so that every Object has a slot.
+ * -# The Objects are deserialized by \p thread_count threads, each thread 
+ *    takes the next group of Objects that has not been deserialized and 
+ *    writes them into their slots. The calling thread is one of the threads.
+ *
+ * If the \p thread_count is `0`, `std::thread::hardware_concurrency()` 
+ * threads will be used. Small amounts of data are deserialized without 
+ * starting any threads.
+ *
+ * When this function returns, the \p index will point to the byte after the 
+ * last Object. If an error occurred, the \p object_vector will contain the 
+ * Objects before the error and the \p index will point to the Object with 
+ * the error. This makes it possible to keep the last Object of a stream that 
+ * is not complete yet.
+ *
+ * \parcode
+ * std::vector<uint8_t>                     buffer;
+ * std::vector<zakero::messagepack::Object> object_vector;
+ *
+ * while(receive(buffer))
+ * {
+ * 	size_t index = 0;
+ *
+ * 	std::error_code error = zakero::messagepack::deserializeBatch(buffer, index, object_vector);
+ *
+ * 	process(object_vector);
+ * 	object_vector.clear();
+ *
+ * 	// Keep the Object that is not complete
+ * 	buffer.erase(buffer.begin(), buffer.begin() + index);
+ * }
+ * \endparcode
+ *
+ * \retval Error_None                 All the Objects were deserialized.
+ * \retval Error_No_Data              The \p data is empty.
+ * \retval Error_Invalid_Index        The last Object is not complete.
+ * \retval Error_Incomplete           The last Object is not complete.
+ * \retval Error_Invalid_Format_Type  An invalid Format ID was found.
+ * \retval Error_Depth_Limit          An Object is nested too deeply.
+ *
+ * \return An error code.
+ */
+std::error_code deserializeBatch(const std::span<const uint8_t> data          ///< The packed data
+	, size_t&                                 index         ///< The starting index
+	, std::vector<Object>&                    object_vector ///< The Objects
+	, size_t                                  thread_count  ///< The number of threads
+	) noexcept
+{
+	// Objects deserialized by a thread at a time
+	constexpr size_t Group_Size = 64;
+
+	if(data.size() == 0)
 	{
-		std::vector<uint8_t> vector = {};
+		return Error_No_Data;
+	}
 
-		const int      multi_part_count = 3;
-		const uint64_t value_start      = std::numeric_limits<uint64_t>::max();
-		uint64_t       value            = value_start;
+	std::error_code     error = Error_None;
+	std::vector<size_t> offset_vector;
 
-		for(int i = 0; i < multi_part_count; i++, value--)
+	// Each Object is at least 1 byte
+	offset_vector.reserve(std::min(data.size() - std::min(index, data.size()), size_t(64 * 1024)));
+
+	size_t end = index;
+
+	while(end < data.size())
+	{
+		const size_t offset = end;
+
+		error = skip_(data, end);
+
+		if(error)
 		{
-			Object object = Object{(uint64_t)value};
-			data = serialize(object);
+			end = offset;
+			break;
+		}
 
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+		offset_vector.push_back(offset);
+	}
+
+	if(offset_vector.empty())
+	{
+		index = end;
+
+		return error ? error : Error_Invalid_Index;
+	}
+
+	const size_t record_count = offset_vector.size();
+	const size_t base         = object_vector.size();
+
+	object_vector.resize(base + record_count);
+
+	if(thread_count == 0)
+	{
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	thread_count = std::min(thread_count, (record_count + Group_Size - 1) / Group_Size);
+
+	std::atomic<size_t> next_group   = 0;
+	std::atomic<size_t> error_record = record_count;
+	std::error_code     error_code   = Error_None;
+	std::mutex          error_mutex;
+
+	auto work = [&]()
+	{
+		while(true)
+		{
+			const size_t first = next_group.fetch_add(Group_Size);
+
+			if(first >= record_count || first > error_record)
+			{
+				break;
+			}
+
+			const size_t last = std::min(first + Group_Size, record_count);
+
+			for(size_t i = first; i < last; i++)
+			{
+				size_t          position     = offset_vector[i];
+				std::error_code record_error = Error_None;
+
+				object_vector[base + i] = deserialize(data, position, record_error);
+
+				if(record_error)
+				{
+					std::lock_guard<std::mutex> lock(error_mutex);
+
+					if(i < error_record)
+					{
+						error_record = i;
+						error_code   = record_error;
+					}
+
+					break;
+				}
+			}
 		}
+	};
 
-		size_t last_index = 0;
+	runThreads_(thread_count, work);
 
-		index = 0;
-		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++, value--)
+	if(error_record < record_count)
+	{
+		object_vector.resize(base + error_record);
+		index = offset_vector[error_record];
+
+		return error_code;
+	}
+
+	index = end;
+
+	return error;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("deserializeBatch")
+{
+	std::vector<Object>  expect;
+	std::vector<uint8_t> data;
+
+	for(size_t i = 0; i < 1'000; i++)
+	{
+		Object object;
+
+		switch(i % 4)
 		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.is<uint64_t>() == true);
-			CHECK(part.as<uint64_t>() == value);
+			case 0:
+				object = int64_t(i) * -1'000;
+				break;
+
+			case 1:
+				object = std::pmr::string(i % 100, 's');
+				break;
+
+			case 2:
+				object = Array{};
+				object.asArray().append(uint64_t(i));
+				object.asArray().append(std::pmr::vector<uint8_t>(i % 50, 'b'));
+				break;
+
+			case 3:
+				object = Map{};
+				object.asMap().set(Object{"id"}, Object{uint64_t(i)});
+				object.asMap().set(Object{"value"}, Object{double(i) * 0.5});
+				break;
+		}
 
-			last_index = index;
+		const std::vector<uint8_t> packed = serialize(object);
+		data.insert(data.end(), packed.begin(), packed.end());
+
+		expect.push_back(std::move(object));
+	}
+
+	for(const size_t thread_count : {0, 1, 2, 3, 8})
+	{
+		std::vector<Object> object_vector;
+
+		size_t index = 0;
+
+		CHECK(deserializeBatch(data, index, object_vector, thread_count) == Error_None);
+		CHECK(index == data.size());
+		REQUIRE(object_vector.size() == expect.size());
+
+		for(size_t i = 0; i < expect.size(); i++)
+		{
+			CHECK(serialize(object_vector[i]) == serialize(expect[i]));
 		}
 	}
 
-	SUBCASE("multi-part/float32")
+	SUBCASE("Append")
+	{
+		std::vector<Object> object_vector;
+		object_vector.push_back(Object{"first"});
+
+		CHECK(deserializeBatch(data, object_vector, 4) == Error_None);
+		REQUIRE(object_vector.size() == expect.size() + 1);
+		CHECK(object_vector[0].asString() == "first");
+		CHECK(serialize(object_vector.back()) == serialize(expect.back()));
+	}
+
+	SUBCASE("Stream")
 	{
-		std::vector<uint8_t> vector = {};
+		// The last Object is not complete
+		const std::span<const uint8_t> part(data.data(), data.size() - 1);
 
-		const int   multi_part_count = 3;
-		const float value_start      = std::numeric_limits<float>::max();
-		float       value            = value_start;
+		std::vector<Object> object_vector;
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			value = value - 1.1f;
+		size_t index = 0;
 
-			Object object = Object{(float)value};
-			data = serialize(object);
+		CHECK(deserializeBatch(part, index, object_vector, 4) != Error_None);
+		CHECK(object_vector.size() == expect.size() - 1);
+		CHECK(index == data.size() - serialize(expect.back()).size());
 
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+		CHECK(deserializeBatch(data, index, object_vector, 4) == Error_None);
+		CHECK(object_vector.size() == expect.size());
+		CHECK(index == data.size());
+	}
 
-		size_t last_index = 0;
+	SUBCASE("Decode error")
+	{
+		// Too deep for deserialize() but skip() accepts it
+		std::vector<uint8_t> bad = data;
+		const size_t         bad_index = bad.size();
 
-		index = 0;
-		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			value = value - 1.1f;
+		bad.insert(bad.end(), Limits{}.max_depth + 1, (uint8_t)Format::Fixed_Array | 1);
+		bad.push_back((uint8_t)Format::Nill);
+		bad.insert(bad.end(), data.begin(), data.end());
 
-			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.is<float>() == true);
-			CHECK(part.as<float>() == value);
+		std::vector<Object> object_vector;
 
-			last_index = index;
-		}
+		size_t index = 0;
+
+		CHECK(deserializeBatch(bad, index, object_vector, 4) == Error_Depth_Limit);
+		CHECK(object_vector.size() == expect.size());
+		CHECK(index == bad_index);
 	}
 
-	SUBCASE("multi-part/float64")
+	SUBCASE("Errors")
 	{
-		std::vector<uint8_t> vector = {};
+		std::vector<Object> object_vector;
 
-		const int    multi_part_count = 3;
-		const double value_start      = std::numeric_limits<double>::max();
-		double       value            = value_start;
+		CHECK(deserializeBatch(std::span<const uint8_t>{}, object_vector) == Error_No_Data);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			value = value - 1.1f;
+		const std::vector<uint8_t> never_used = { (uint8_t)Format::Never_Used };
 
-			Object object = Object{(double)value};
-			data = serialize(object);
+		size_t index = 0;
 
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+		CHECK(deserializeBatch(never_used, index, object_vector) == Error_Invalid_Format_Type);
+		CHECK(index == 0);
+		CHECK(object_vector.empty());
 
-		size_t last_index = 0;
+		index = data.size();
 
-		index = 0;
-		error = Error_None;
-		value = value_start;
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			value = value - 1.1f;
+		CHECK(deserializeBatch(data, index, object_vector) == Error_Invalid_Index);
+		CHECK(object_vector.empty());
+	}
+}
+#endif // }}}
 
-			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.is<double>() == true);
-			CHECK(part.as<double>() == value);
+// }}} Utilities::deserializeBatch
+// {{{ Utilities::find
 
-			last_index = index;
-		}
-	}
+/**
+ * \brief Find an Object in packed data by its path.
+ *
+ * The \p path is compiled and used to find an Object in the packed \p data. 
+ * See Query for the syntax of the \p path.
+ *
+ * \parcode
+ * std::string_view host = zakero::messagepack::find(message, "route.hops[-1].host").asString();
+ * \endparcode
+ *
+ * \note When the same path is used with many messages, compile it once with 
+ * a Query.
+ *
+ * \return The Object. If the \p path is not valid or the Object was not 
+ * found, the ObjectView will not be valid.
+ */
+ObjectView find(const std::span<const uint8_t> data ///< The packed data
+	, const std::string_view               path ///< The path
+	) noexcept
+{
+	return Query(path).find(data);
+}
 
-	SUBCASE("multi-part/str8")
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("find")
+{
+	Object object = {Map{}};
+	Array& list = object.asMap().emplace<Array>("list");
+	list.append(int64_t(-5));
+	list.emplace<Map>().emplace<bool>("ok", true);
+
+	const std::vector<uint8_t> data = serialize(object);
+
+	CHECK(find(data, "list[0]").asInt() == -5);
+	CHECK(find(data, "list[1].ok").asBool() == true);
+	CHECK(find(data, "list[2]").isValid() == false);
+	CHECK(find(data, "list[").isValid() == false);
+	CHECK(find(data, "").isMap());
+}
+#endif // }}}
+
+// }}} Utilities::find
+// {{{ Utilities::fromJson
+
+/**
+ * \brief Convert JSON text to MessagePack data.
+ *
+ * The JSON \p text is packed with the \p packer without creating an Object or 
+ * any other tree of the JSON values.
+ *
+ * | JSON          | MessagePack                                           |
+ * |---------------|-------------------------------------------------------|
+ * | `null`        | Nil                                                   |
+ * | `true`        | Boolean                                               |
+ * | `false`       | Boolean                                               |
+ * | An integer    | Integer, see below                                    |
+ * | A number      | Float (64-bit)                                        |
+ * | A string      | String, with the escapes decoded as UTF-8             |
+ * | An array      | Array                                                 |
+ * | An object     | Map, the keys are Strings                             |
+ *
+ * A number that does not have a fraction or exponent is packed as an `int64_t` 
+ * if it fits, otherwise as a `uint64_t` if it fits. All other numbers are 
+ * packed as a `double`. Like JavaScript, numbers too large for a `double` 
+ * become infinity and numbers too small become zero.
+ *
+ * The conversion is done in three passes:
+ * -# The position of every token is found. 64 bytes are classified at a 
+ *    time with AVX2 or SSE2, when the CPU supports them, and the tokens in 
+ *    strings are removed with bit operations.
+ * -# The grammar of the tokens is checked and the number of elements of 
+ *    each array and object is counted. MessagePack needs the counts before 
+ *    the elements.
+ * -# The tokens are packed. Strings without escapes are passed to the \p 
+ *    packer directly from the \p text.
+ *
+ * Nested arrays and objects do not use recursion.
+ *
+ * \parcode
+ * std::vector<uint8_t> data;
+ * zakero::messagepack::Packer packer(data);
+ *
+ * std::error_code error = zakero::messagepack::fromJson(R"({"id": 42, "tags": ["a", "b"]})", packer);
+ * \endparcode
+ *
+ * Because the grammar is checked before anything is packed, invalid JSON 
+ * structure does not write anything. An invalid number or string is only 
+ * found while packing, so the \p packer will have the data before it.
+ *
+ * \retval Error_None         The JSON text was converted.
+ * \retval Error_No_Data      The \p text is empty or only whitespace.
+ * \retval Error_Incomplete   The JSON text ends before the value is 
+ *                            complete.
+ * \retval Error_Invalid_Json The JSON text is not valid.
+ * \retval Error_Size_Limit   The \p text is 4GB or larger.
+ * \retval Other              Any error from the \p packer.
+ *
+ * \return An error code.
+ */
+std::error_code fromJson(const std::string_view text   ///< The JSON text
+	, Packer&                               packer ///< The output
+	) noexcept
+{
+	std::vector<uint32_t> token_vector;
+	std::vector<uint32_t> count_vector;
+
+	std::error_code error = jsonTokens_(text, token_vector);
+
+	if(!error)
 	{
-		std::vector<uint8_t> vector = {};
+		error = jsonCount_(text, token_vector, count_vector);
+	}
 
-		const int         multi_part_count = 3;
-		const std::string value            = std::string(std::numeric_limits<uint8_t>::max(), 'X');
+	if(!error)
+	{
+		error = jsonPack_(text, token_vector, count_vector, packer);
+	}
 
-		Object object = Object{value};
-		data = serialize(object);
+	return error;
+}
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
 
-		size_t last_index = 0;
+/**
+ * \brief Convert JSON text to MessagePack data.
+ *
+ * The JSON \p text is converted to MessagePack data, see fromJson(text, 
+ * packer) for details.
+ *
+ * \parcode
+ * std::error_code error;
+ *
+ * std::vector<uint8_t> data = zakero::messagepack::fromJson(json, error);
+ * \endparcode
+ *
+ * \return The MessagePack data, or an empty vector if there was an error.
+ */
+std::vector<uint8_t> fromJson(const std::string_view text  ///< The JSON text
+	, std::error_code&                         error ///< The error code
+	) noexcept
+{
+	std::vector<uint8_t> data;
 
-		index = 0;
-		error = Error_None;
+	{
+		Packer packer(data);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.isString() == true);
-			CHECK(part.asString() == value);
+		error = fromJson(text, packer);
+	}
 
-			last_index = index;
-		}
+	if(error)
+	{
+		data.clear();
 	}
 
-	SUBCASE("multi-part/str16")
+	return data;
+}
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("fromJson/classify")
+{
+	std::vector<uint8_t> block(Json_Block_Size_);
+
+	const std::string_view alphabet = "\"\\{}[]:, \t\n\rax0-;Z\x7f\x80\x1a\x1b\x3b\xbb\xdb\xfb";
+
+	uint32_t random = 42;
+
+	for(size_t test = 0; test < 1000; test++)
 	{
-		std::vector<uint8_t> vector = {};
+		for(uint8_t& byte : block)
+		{
+			random = random * 1664525 + 1013904223;
 
-		const int         multi_part_count = 3;
-		const std::string value            = std::string(std::numeric_limits<uint8_t>::max() + 1, 'X');
+			byte = (test < 500)
+				? (uint8_t)alphabet[(random >> 16) % alphabet.size()]
+				: (uint8_t)(random >> 24)
+				;
+		}
 
-		Object object = Object{value};
-		data = serialize(object);
+		const JsonBlock_ expect = jsonClassifyScalar_(block.data());
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < Json_Block_Size_; i++)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			const uint8_t  byte = block[i];
+			const uint64_t bit  = uint64_t(1) << i;
+
+			CHECK(((expect.quote & bit) != 0) == (byte == '"'));
+			CHECK(((expect.operators & bit) != 0) == (std::string_view("{}[]:,").find((char)byte) != std::string_view::npos));
 		}
 
-		size_t last_index = 0;
+		auto equal = [&](const JsonBlock_ result)
+		{
+			return result.quote == expect.quote
+				&& result.backslash == expect.backslash
+				&& result.operators == expect.operators
+				&& result.space == expect.space
+				;
+		};
 
-		index = 0;
-		error = Error_None;
+		CHECK(equal(jsonClassify_(block.data())));
 
-		for(int i = 0; i < multi_part_count; i++)
+#if defined(__x86_64__) || defined(__i386__)
+		if(__builtin_cpu_supports("sse2"))
 		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.isString() == true);
-			CHECK(part.asString() == value);
+			CHECK(equal(jsonClassifySse2_(block.data())));
+		}
 
-			last_index = index;
+		if(__builtin_cpu_supports("avx2"))
+		{
+			CHECK(equal(jsonClassifyAvx2_(block.data())));
 		}
+#endif
 	}
+}
 
-	SUBCASE("multi-part/str32")
+TEST_CASE("fromJson/tokens")
+{
+	// One byte at a time
+	auto reference = [](const std::string_view text)
 	{
-		std::vector<uint8_t> vector = {};
+		std::vector<uint32_t> token_vector;
+		bool                  in_string = false;
+		bool                  in_atom   = false;
 
-		const int         multi_part_count = 3;
-		const std::string value            = std::string(std::numeric_limits<uint16_t>::max() + 1, 'X');
+		for(size_t i = 0; i < text.size(); i++)
+		{
+			const char character = text[i];
 
-		Object object = Object{value};
-		data = serialize(object);
+			if(in_string)
+			{
+				if(character == '\\')
+				{
+					i++;
+				}
+				else if(character == '"')
+				{
+					in_string = false;
+				}
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+				continue;
+			}
 
-		size_t last_index = 0;
+			if(std::string_view("{}[]:,").find(character) != std::string_view::npos)
+			{
+				token_vector.push_back((uint32_t)i);
+				in_atom = false;
+			}
+			else if(std::string_view(" \t\n\r").find(character) != std::string_view::npos)
+			{
+				in_atom = false;
+			}
+			else if(character == '"')
+			{
+				if(in_atom == false)
+				{
+					token_vector.push_back((uint32_t)i);
+				}
 
-		index = 0;
-		error = Error_None;
+				in_string = true;
+				in_atom   = false;
+			}
+			else
+			{
+				if(in_atom == false)
+				{
+					token_vector.push_back((uint32_t)i);
+				}
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.isString() == true);
-			CHECK(part.asString() == value);
+				// A backslash outside of a string still escapes a 
+				// quote or a backslash, the JSON is not valid anyway
+				if(character == '\\'
+					&& i + 1 < text.size()
+					&& (text[i + 1] == '"' || text[i + 1] == '\\')
+					)
+				{
+					i++;
+				}
 
-			last_index = index;
+				in_atom = true;
+			}
 		}
-	}
 
-	SUBCASE("multi-part/bin8")
-	{
-		std::vector<uint8_t> vector = {};
+		return std::pair{token_vector, in_string};
+	};
 
-		const int                  multi_part_count = 3;
-		const std::vector<uint8_t> value            = std::vector<uint8_t>(std::numeric_limits<uint8_t>::max(), 0xff);
+	const std::string_view alphabet = "\"\\\\\\{}[]:, \nax0";
 
-		Object object = Object{value};
-		data = serialize(object);
+	uint32_t random = 7;
 
-		for(int i = 0; i < multi_part_count; i++)
+	for(size_t test = 0; test < 2000; test++)
+	{
+		random = random * 1664525 + 1013904223;
+
+		std::string text((random >> 16) % 300, ' ');
+
+		for(char& character : text)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			random = random * 1664525 + 1013904223;
+			character = alphabet[(random >> 16) % alphabet.size()];
 		}
 
-		size_t last_index = 0;
+		// The reference skips the byte after a backslash, even at the end
+		if(text.empty() == false && text.back() == '\\')
+		{
+			text.back() = 'a';
+		}
 
-		index = 0;
-		error = Error_None;
+		const auto [expect, open] = reference(text);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error                  == Error_None);
-			CHECK(last_index             != index);
-			CHECK(part.isBinary()        == true);
-			CHECK(part.asBinary().size() == value.size());
+		std::vector<uint32_t> token_vector;
 
-			std::vector<uint8_t>& bin = part.asBinary();
-			for(size_t i = 0; i < value.size(); i++)
-			{
-				CHECK(bin[i] == value[i]);
-			}
+		const std::error_code error = jsonTokens_(text, token_vector);
 
-			last_index = index;
-		}
+		CHECK(error == (open ? Error_Incomplete : Error_None));
+		CHECK(token_vector == expect);
 	}
 
-	SUBCASE("multi-part/bin16")
+	// Runs of backslashes that cross blocks
+	for(size_t run = 0; run < 10; run++)
 	{
-		std::vector<uint8_t> vector = {};
+		for(size_t start = 50; start < 70; start++)
+		{
+			std::string text = "[" + std::string(start, ' ') + "\"" + std::string(run, '\\') + "\",1]";
+
+			std::vector<uint32_t> token_vector;
 
-		const int                  multi_part_count = 3;
-		const std::vector<uint8_t> value            = std::vector<uint8_t>(std::numeric_limits<uint8_t>::max() + 1, 0xff);
+			const std::error_code error = jsonTokens_(text, token_vector);
+			const auto [expect, open]   = reference(text);
+
+			CHECK(error == (open ? Error_Incomplete : Error_None));
+			CHECK(token_vector == expect);
+		}
+	}
+}
 
-		Object object = Object{value};
-		data = serialize(object);
+TEST_CASE("fromJson")
+{
+	auto pack = [](const std::string_view text, std::error_code& error) -> Object
+	{
+		const std::vector<uint8_t> data = fromJson(text, error);
 
-		for(int i = 0; i < multi_part_count; i++)
+		if(error)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			CHECK(data.empty());
+
+			return {};
 		}
 
-		size_t last_index = 0;
+		return deserialize(data);
+	};
 
-		index = 0;
-		error = Error_None;
+	auto check = [&](const std::string_view text) -> Object
+	{
+		std::error_code error = {};
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error                  == Error_None);
-			CHECK(last_index             != index);
-			CHECK(part.isBinary()        == true);
-			CHECK(part.asBinary().size() == value.size());
+		Object object = pack(text, error);
 
-			std::vector<uint8_t>& bin = part.asBinary();
-			for(size_t i = 0; i < value.size(); i++)
-			{
-				CHECK(bin[i] == value[i]);
-			}
+		CHECK(error == Error_None);
 
-			last_index = index;
-		}
-	}
+		return object;
+	};
 
-	SUBCASE("multi-part/bin32")
+	auto fail = [&](const std::string_view text) -> std::error_code
 	{
-		std::vector<uint8_t> vector = {};
+		std::error_code error = {};
 
-		const int                  multi_part_count = 3;
-		const std::vector<uint8_t> value            = std::vector<uint8_t>(std::numeric_limits<uint16_t>::max() + 1, 0xff);
+		pack(text, error);
 
-		Object object = Object{value};
-		data = serialize(object);
+		return error;
+	};
 
-		for(int i = 0; i < multi_part_count; i++)
+	SUBCASE("Scalars")
+	{
+		CHECK(check("null").isNull());
+		CHECK(check(" true ").as<bool>() == true);
+		CHECK(check("\n\tfalse\r").as<bool>() == false);
+
+		CHECK(check("0").as<int64_t>() == 0);
+		CHECK(check("-0").as<int64_t>() == 0);
+		CHECK(check("42").as<int64_t>() == 42);
+		CHECK(check("-42").as<int64_t>() == -42);
+		CHECK(check("9223372036854775807").as<int64_t>() == std::numeric_limits<int64_t>::max());
+		CHECK(check("-9223372036854775808").as<int64_t>() == std::numeric_limits<int64_t>::min());
+		CHECK(check("9223372036854775808").as<uint64_t>() == uint64_t(1) << 63);
+		CHECK(check("18446744073709551615").as<uint64_t>() == std::numeric_limits<uint64_t>::max());
+		CHECK(check("18446744073709551616").as<double>() == 18446744073709551616.0);
+		CHECK(check("-9223372036854775809").as<double>() == -9223372036854775809.0);
+
+		CHECK(check("0.5").as<double>() == 0.5);
+		CHECK(check("-1.25e2").as<double>() == -125.0);
+		CHECK(check("1E+2").as<double>() == 100.0);
+		CHECK(check("1e-2").as<double>() == 0.01);
+		CHECK(check("5e-324").as<double>() == std::numeric_limits<double>::denorm_min());
+		CHECK(check("1e400").as<double>() == std::numeric_limits<double>::infinity());
+		CHECK(check("-1e400").as<double>() == -std::numeric_limits<double>::infinity());
+		CHECK(check("1e-400").as<double>() == 0.0);
+		CHECK(check("0.0000001e-400").as<double>() == 0.0);
+		CHECK(check("1000000000e-9999999999999").as<double>() == 0.0);
+		CHECK(check("0.001e310").as<double>() == 1e307);
+		CHECK(check("123456789e310").as<double>() == std::numeric_limits<double>::infinity());
+
+		for(const std::string_view text : {"tru", "truee", "nul", "False", "01", "-", "1.", ".5", "+1", "1e", "1e+", "--1", "0x10", "1.5.5", "NaN", "Infinity", "1\"a\""})
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			CAPTURE(text);
+			CHECK(fail(text) == Error_Invalid_Json);
 		}
+	}
 
-		size_t last_index = 0;
-
-		index = 0;
-		error = Error_None;
+	SUBCASE("Strings")
+	{
+		CHECK(check("\"\"").asString() == "");
+		CHECK(check("\"zakero\"").asString() == "zakero");
+		CHECK(check(R"("a\"b\\c\/d")").asString() == "a\"b\\c/d");
+		CHECK(check(R"("\b\f\n\r\t")").asString() == "\b\f\n\r\t");
+		CHECK(check(R"("Aé€")").asString() == "A\xc3\xa9\xe2\x82\xac");
+		CHECK(check(R"("😀")").asString() == "\xf0\x9f\x98\x80");
+		CHECK(check(R"("\u0000")").asString() == std::string_view("\0", 1));
+		CHECK(check("\"\xc3\xa9\"").asString() == "\xc3\xa9");
 
-		for(int i = 0; i < multi_part_count; i++)
+		// Escapes in long strings, before and after blocks of plain bytes
+		for(size_t i = 0; i < 150; i += 7)
 		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error                  == Error_None);
-			CHECK(last_index             != index);
-			CHECK(part.isBinary()        == true);
-			CHECK(part.asBinary().size() == value.size());
+			const std::string plain(i, 'x');
+			const std::string line = plain + "\n" + plain;
 
-			std::vector<uint8_t>& bin = part.asBinary();
-			for(size_t i = 0; i < value.size(); i++)
-			{
-				CHECK(bin[i] == value[i]);
+			CHECK(check("\"" + plain + "\\n" + plain + "\"").asString() == std::string_view(line));
+			CHECK(check("[\"" + plain + "\\\\\"," + "\"" + plain + "\"]").asArray().object(1).asString() == std::string_view(plain));
+		}
+
+		CHECK(fail(R"("\x")") == Error_Invalid_Json);
+		CHECK(fail(R"("\u12")") == Error_Invalid_Json);
+		CHECK(fail(R"("\u12g4")") == Error_Invalid_Json);
+		CHECK(fail(R"("\ud83d")") == Error_Invalid_Json);
+		CHECK(fail(R"("\ud83dx")") == Error_Invalid_Json);
+		CHECK(fail(R"("\ud83dA")") == Error_Invalid_Json);
+		CHECK(fail(R"("\ude00")") == Error_Invalid_Json);
+		CHECK(fail("\"a\nb\"") == Error_Invalid_Json);
+		CHECK(fail("\"abc") == Error_Incomplete);
+		CHECK(fail("\"abc\\\"") == Error_Incomplete);
+		CHECK(fail("\"a\"\"b\"") == Error_Invalid_Json);
+		CHECK(fail("\"a\"b") == Error_Invalid_Json);
+	}
+
+	SUBCASE("Containers")
+	{
+		CHECK(check("[]").asArray().size() == 0);
+		CHECK(check("{}").asMap().size() == 0);
+		CHECK(check("[[],{},[[]]]").asArray().size() == 3);
+
+		Object object = check(R"(
+			{ "id"    : 42
+			, "name"  : "zakero"
+			, "list"  : [1, -2.5, true, null, {"x": [] }, "A"]
+			, "empty" : {}
 			}
+			)");
 
-			last_index = index;
-		}
-	}
+		REQUIRE(object.isMap());
 
-	SUBCASE("multi-part/array16")
-	{
-		std::vector<uint8_t> vector = {};
+		const Map& map = object.asMap();
 
-		const int    multi_part_count = 3;
-		const size_t value_len        = std::numeric_limits<uint8_t>::max() + 1;
+		CHECK(map.size() == 4);
+		CHECK(map[Object{"id"}].as<int64_t>() == 42);
+		CHECK(map[Object{"name"}].asString() == "zakero");
+		CHECK(map[Object{"empty"}].asMap().size() == 0);
 
-		Array value;
-		value.resize(value_len);
-		int data_type = 0;
-		for(size_t i = 0; i < value_len; i++)
-		{
-			switch(data_type)
-			{
-				case 0: value[i] = Object{};               break;
-				case 1: value[i] = Object{false};          break;
-				case 2: value[i] = Object{true};           break;
-				case 3: value[i] = Object{(uint64_t)0xff}; break;
-			}
+		const Array& list = map[Object{"list"}].asArray();
 
-			data_type = (data_type + 1) % 4;
-		}
+		REQUIRE(list.size() == 6);
+		CHECK(list.object(0).as<int64_t>() == 1);
+		CHECK(list.object(1).as<double>() == -2.5);
+		CHECK(list.object(2).as<bool>() == true);
+		CHECK(list.object(3).isNull());
+		CHECK(list.object(4).asMap()[Object{"x"}].asArray().size() == 0);
+		CHECK(list.object(5).asString() == "A");
 
-		data = serialize(value);
+		// Duplicate keys are packed as they are
+		std::error_code error = {};
 
-		for(int i = 0; i < multi_part_count; i++)
+		const std::vector<uint8_t> duplicate = fromJson(R"({"a": 1, "a": 2})", error);
+
+		CHECK(error == Error_None);
+		CHECK(duplicate == std::vector<uint8_t>{(uint8_t)Format::Fixed_Map | 2, 0xa1, 'a', 1, 0xa1, 'a', 2});
+
+		// Deep data does not use recursion
+		const size_t depth = 100'000;
+
+		const std::vector<uint8_t> deep = fromJson(std::string(depth, '[') + std::string(depth, ']'), error);
+
+		CHECK(error == Error_None);
+		CHECK(deep.size() == depth);
+		CHECK(deep[depth - 1] == ((uint8_t)Format::Fixed_Array | 0));
+		CHECK(validate(std::span(deep).subspan(depth - 1)) == Error_None);
+
+		// Large containers
+		std::string large = "[";
+
+		for(size_t i = 0; i < 70'000; i++)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			large += std::to_string(i) + ",";
 		}
 
-		size_t last_index = 0;
+		large.back() = ']';
 
-		index = 0;
-		error = Error_None;
+		const Object array = check(large);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error                 == Error_None);
-			CHECK(last_index            != index);
-			CHECK(part.isArray()        == true);
-			CHECK(part.asArray().size() == value.size());
+		REQUIRE(array.asArray().size() == 70'000);
+		CHECK(array.asArray().object(69'999).as<int64_t>() == 69'999);
 
-			Array& array = part.asArray();
-			for(size_t i = 0; i < value.size(); i++)
-			{
-				CHECK(array[i] == value[i]);
-			}
+		for(const std::string_view text : {"[1 2]", "[1,]", "[,1]", "{,}", "{\"a\" 1}", "{\"a\":}", "{\"a\":1,}", "{1:2}", "{\"a\"}", "[1}", "{\"a\":1]", "1 2", "[] []", "]", ":", "[\"a\":1]"})
+		{
+			CAPTURE(text);
+			CHECK(fail(text) == Error_Invalid_Json);
+		}
 
-			last_index = index;
+		for(const std::string_view text : {"[", "[1", "[1,", "{", "{\"a\"", "{\"a\":", "{\"a\":1", "[[[]]"})
+		{
+			CAPTURE(text);
+			CHECK(fail(text) == Error_Incomplete);
 		}
+
+		CHECK(fail("") == Error_No_Data);
+		CHECK(fail(" \n\t ") == Error_No_Data);
 	}
 
-	SUBCASE("multi-part/array32")
+	SUBCASE("toJson")
 	{
-		std::vector<uint8_t> vector = {};
+		// MessagePack → JSON → MessagePack
+		Object object = {Map{}};
+		Map&   map    = object.asMap();
 
-		const int    multi_part_count = 3;
-		const size_t value_len        = std::numeric_limits<uint16_t>::max() + 1;
+		map.emplace<std::pmr::string>("name", "zakero \"\xc3\xa9\"\n");
+		map.emplace<int64_t>("min", std::numeric_limits<int64_t>::min());
+		map.emplace<uint64_t>("max", std::numeric_limits<uint64_t>::max());
+		map.emplace<double>("pi", 3.141592653589793);
+		map.emplace<double>("tiny", 1e-300);
+		map.emplace<Array>("list").append(false);
+		map["list"].asArray().appendNull();
+		map["list"].asArray().emplace<Map>().emplace<int64_t>("x", -1);
+		map.emplace<Map>("none");
 
-		Array value;
-		value.resize(value_len);
-		int data_type = 0;
-		for(size_t i = 0; i < value_len; i++)
+		const std::vector<uint8_t> data = serialize(object);
+
+		for(const bool pretty : {false, true})
 		{
-			switch(data_type)
-			{
-				case 0: value[i] = Object{};               break;
-				case 1: value[i] = Object{false};          break;
-				case 2: value[i] = Object{true};           break;
-				case 3: value[i] = Object{(uint64_t)0xff}; break;
-			}
+			JsonOptions options;
+			options.pretty = pretty;
 
-			data_type = (data_type + 1) % 4;
-		}
+			std::error_code error = {};
 
-		data = serialize(value);
+			const std::string json = toJson(data, error, options);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			CHECK(error == Error_None);
+			CHECK(fromJson(json, error) == data);
+			CHECK(error == Error_None);
 		}
+	}
 
-		size_t last_index = 0;
+	SUBCASE("Packer")
+	{
+		std::vector<uint8_t> buffer(4);
+		Packer               packer(std::span<uint8_t>(buffer.data(), buffer.size()));
 
-		index = 0;
-		error = Error_None;
+		CHECK(fromJson("[1, 2, 3, 4, 5]", packer) == Error_Buffer_Too_Small);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error                 == Error_None);
-			CHECK(last_index            != index);
-			CHECK(part.isArray()        == true);
-			CHECK(part.asArray().size() == value.size());
+		// Invalid structure is found before anything is packed
+		std::vector<uint8_t> data;
+		Packer               vector_packer(data);
 
-			Array& array = part.asArray();
-			for(size_t i = 0; i < value.size(); i++)
-			{
-				CHECK(array[i] == value[i]);
-			}
+		CHECK(fromJson("[1, 2, 3, 4, 5,]", vector_packer) == Error_Invalid_Json);
+		CHECK(data.empty());
 
-			last_index = index;
-		}
+		CHECK(fromJson("[\"a\", [1]]", vector_packer) == Error_None);
+		CHECK(fromJson("{\"b\": null}", vector_packer) == Error_None);
+
+		std::error_code error = {};
+		size_t          index = 0;
+
+		CHECK(deserialize(data, index, error).asArray().object(0).asString() == "a");
+		CHECK(deserialize(data, index, error).asMap()[Object{"b"}].isNull());
+		CHECK(index == data.size());
 	}
+}
+#endif // }}}
 
-	SUBCASE("multi-part/map16")
-	{
-		std::vector<uint8_t> vector = {};
+// }}} Utilities::fromJson
+// {{{ Utilities::serialize
 
-		const int    multi_part_count = 3;
-		const size_t value_len        = std::numeric_limits<uint8_t>::max() + 1;
+/**
+ * \brief Serialize Array data.
+ *
+ * The contents of the Array will be packed into the returned std::vector.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.append(command_id);
+ * array.append(true);
+ * array.append(error_code);
+ *
+ * std::vector<uint8_t> result = zakero::messagepack::serialize(array);
+ *
+ * reply(host_ip, result);
+ * \endparcode
+ *
+ * \return The packed data.
+ */
+std::vector<uint8_t> serialize(const Array& array ///< The Array
+	) noexcept
+{
+	std::error_code error;
 
-		Map value;
-		int data_type = 0;
-		for(size_t i = 0; i < value_len; i++)
-		{
-			switch(data_type)
-			{
-				case 0: value[i] = Object{};               break;
-				case 1: value[i] = Object{false};          break;
-				case 2: value[i] = Object{true};           break;
-				case 3: value[i] = Object{(uint64_t)0xff}; break;
-			}
+	return serialize(array, error);
+}
 
-			data_type = (data_type + 1) % 4;
-		}
 
-		data = serialize(value);
+/**
+ * \brief Serialize Array data.
+ *
+ * The contents of the Array will be packed into the returned std::vector.
+ *
+ * \parcode
+ * zakero::messagepack::Array array;
+ * array.append(command_id);
+ * array.append(true);
+ * array.append(error_code);
+ *
+ * std::error_code error;
+ *
+ * std::vector<uint8_t> result = zakero::messagepack::serialize(array, error);
+ *
+ * if(error)
+ * {
+ * 	logError(command_id, error);
+ * }
+ * else
+ * {
+ * 	reply(host_ip, result);
+ * }
+ * \endparcode
+ *
+ * \return The packed data.
+ */
+std::vector<uint8_t> serialize(const Array& array ///< The Array
+	, std::error_code&                  error ///< The Error
+	) noexcept
+{
+	std::vector<uint8_t> vector(serializedSize(array));
+	Packer packer(std::span<uint8_t>{vector});
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+	error = packer.pack(array);
 
-		size_t last_index = 0;
+	vector.resize(packer.size());
 
-		index = 0;
-		error = Error_None;
+	return vector;
+}
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error               == Error_None);
-			CHECK(last_index          != index);
-			CHECK(part.isMap()        == true);
-			CHECK(part.asMap().size() == value.size());
 
-			Map& map = part.asMap();
-			for(size_t i = 0; i < value.size(); i++)
-			{
-				CHECK(map[i] == value[i]);
-			}
+/**
+ * \brief Serialize Array data in parallel.
+ *
+ * The contents of the Array will be packed into the returned std::vector, 
+ * using \p thread_count threads. The packed data is the same as 
+ * serialize(const Array&, std::error_code&).
+ *
+ * See serialize(const Object&, std::error_code&, const size_t) for details.
+ *
+ * \return The packed data.
+ */
+std::vector<uint8_t> serialize(const Array& array        ///< The Array
+	, std::error_code&                  error        ///< The Error
+	, const size_t                      thread_count ///< The number of threads
+	) noexcept
+{
+	std::vector<SerializeUnit_> unit_vector;
+
+	serializeUnits_(array, unit_vector, 0);
 
-			last_index = index;
-		}
-	}
+	std::vector<uint8_t> vector = serializeUnits_(unit_vector, thread_count);
 
-	SUBCASE("multi-part/map32")
+	if(vector.empty())
 	{
-		std::vector<uint8_t> vector = {};
+		return serialize(array, error);
+	}
 
-		const int    multi_part_count = 3;
-		const size_t value_len        = std::numeric_limits<uint16_t>::max() + 1;
+	error = Error_None;
 
-		Map value;
-		int data_type = 0;
-		for(size_t i = 0; i < value_len; i++)
-		{
-			switch(data_type)
-			{
-				case 0: value[i] = Object{};               break;
-				case 1: value[i] = Object{false};          break;
-				case 2: value[i] = Object{true};           break;
-				case 3: value[i] = Object{(uint64_t)0xff}; break;
-			}
+	return vector;
+}
 
-			data_type = (data_type + 1) % 4;
-		}
 
-		data = serialize(value);
+/**
+ * \brief Serialize Ext data.
+ *
+ * The contents of the Ext will be packed into the returned std::vector.
+ *
+ * \parcode
+ * zakero::messagepack::Ext ext;
+ * ext.type = 42;
+ * ext.data = std::pmr::vector<uint8_t>(16, '_');
+ *
+ * std::vector<uint8_t> result = zakero::messagepack::serialize(ext);
+ * \endparcode
+ *
+ * \return The packed data.
+ */
+std::vector<uint8_t> serialize(const Ext& ext ///< The Extension
+	) noexcept
+{
+	std::error_code error;
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+	return serialize(ext, error);
+}
 
-		size_t last_index = 0;
 
-		index = 0;
-		error = Error_None;
+/**
+ * \brief Serialize Ext data.
+ *
+ * The contents of the Ext will be packed into the returned std::vector.
+ *
+ * \parcode
+ * zakero::messagepack::Ext ext;
+ * ext.type = 42;
+ * ext.data = std::pmr::vector<uint8_t>(16, '_');
+ *
+ * std::error_code error;
+ * std::vector<uint8_t> result = zakero::messagepack::serialize(ext, error);
+ * \endparcode
+ *
+ * \return The packed data.
+ */
+std::vector<uint8_t> serialize(const Ext& ext   ///< The Extension
+	, std::error_code&                error ///< The Error
+	) noexcept
+{
+	std::vector<uint8_t> vector(serializedSize(ext));
+	Packer packer(std::span<uint8_t>{vector});
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error               == Error_None);
-			CHECK(last_index          != index);
-			CHECK(part.isMap()        == true);
-			CHECK(part.asMap().size() == value.size());
+	error = packer.pack(ext);
 
-			Map& map = part.asMap();
-			for(size_t i = 0; i < value.size(); i++)
-			{
-				CHECK(map[i] == value[i]);
-			}
+	vector.resize(packer.size());
 
-			last_index = index;
-		}
-	}
+	return vector;
+}
 
-	SUBCASE("multi-part/ext (fixed_ext1)")
-	{
-		std::vector<uint8_t> vector = {};
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("serialize/ext (fixed_ext1)")
+{
+	Ext ext;
+	std::vector<uint8_t> data;
+	const size_t data_len = 1;
+	const int8_t type = 42;
 
-		const int    multi_part_count = 3;
-		const size_t data_len         = 1;
-		const int8_t type             = 42;
+	ext.type = type;
+	ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		Ext value;
-		value.type = type;
-		value.data = std::vector<uint8_t>(data_len, '_');
+	data = serialize(ext);
+	CHECK(data.size() == 3);
+	size_t index = 0;
+	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext1);
+	CHECK(data[index++] == type);
+	CHECK(data[index++] == '_');
 
-		data = serialize(value);
+	Object object = deserialize(data);
+	CHECK(object.isExt() == true);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+	CHECK(object.asExt().type        == type);
+	CHECK(object.asExt().data.size() == 1);
+	CHECK(object.asExt().data[0] == '_');
+}
 
-		size_t last_index = 0;
+TEST_CASE("serialize/ext (fixed_ext2)")
+{
+	Ext ext;
+	std::vector<uint8_t> data;
+	const size_t data_len = 2;
+	const int8_t type = 42;
 
-		index = 0;
-		error = Error_None;
+	ext.type = type;
+	ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error        == Error_None);
-			CHECK(last_index   != index);
-			CHECK(part.isExt() == true);
+	data = serialize(ext);
+	CHECK(data.size() == 4);
+	size_t index = 0;
+	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext2);
+	CHECK(data[index++] == type);
 
-			Ext& ext = part.asExt();
-			CHECK(ext.type == value.type);
-			CHECK(ext.data == value.data);
+	Object object = deserialize(data);
+	CHECK(object.isExt() == true);
 
-			last_index = index;
-		}
-	}
+	CHECK(object.asExt().type        == type);
+	CHECK(object.asExt().data.size() == data_len);
 
-	SUBCASE("multi-part/ext (fixed_ext2)")
+	for(size_t i = 0; i < data_len; i++)
 	{
-		std::vector<uint8_t> vector = {};
-
-		const int    multi_part_count = 3;
-		const size_t data_len         = 2;
-		const int8_t type             = 42;
-
-		Ext value;
-		value.type = type;
-		value.data = std::vector<uint8_t>(data_len, '_');
-
-		data = serialize(value);
+		CHECK(object.asExt().data[i] == '_');
+	}
+}
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+TEST_CASE("serialize/ext (fixed_ext4)")
+{
+	Ext ext;
+	std::vector<uint8_t> data;
+	const size_t data_len = 4;
+	const int8_t type = 42;
 
-		size_t last_index = 0;
+	ext.type = type;
+	ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		index = 0;
-		error = Error_None;
+	data = serialize(ext);
+	CHECK(data.size() == 6);
+	size_t index = 0;
+	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext4);
+	CHECK(data[index++] == type);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error        == Error_None);
-			CHECK(last_index   != index);
-			CHECK(part.isExt() == true);
+	Object object = deserialize(data);
+	CHECK(object.isExt() == true);
 
-			Ext& ext = part.asExt();
-			CHECK(ext.type == value.type);
-			CHECK(ext.data == value.data);
+	CHECK(object.asExt().type        == type);
+	CHECK(object.asExt().data.size() == data_len);
 
-			last_index = index;
-		}
+	for(size_t i = 0; i < data_len; i++)
+	{
+		CHECK(object.asExt().data[i] == '_');
 	}
+}
 
-	SUBCASE("multi-part/ext (fixed_ext4)")
-	{
-		std::vector<uint8_t> vector = {};
+TEST_CASE("serialize/ext (fixed_ext8)")
+{
+	Ext ext;
+	std::vector<uint8_t> data;
+	const size_t data_len = 8;
+	const int8_t type = 42;
 
-		const int    multi_part_count = 3;
-		const size_t data_len         = 4;
-		const int8_t type             = 42;
+	ext.type = type;
+	ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		Ext value;
-		value.type = type;
-		value.data = std::vector<uint8_t>(data_len, '_');
+	data = serialize(ext);
+	CHECK(data.size() == 10);
+	size_t index = 0;
+	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext8);
+	CHECK(data[index++] == type);
 
-		data = serialize(value);
+	Object object = deserialize(data);
+	CHECK(object.isExt() == true);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+	CHECK(object.asExt().type        == type);
+	CHECK(object.asExt().data.size() == data_len);
+
+	for(size_t i = 0; i < data_len; i++)
+	{
+		CHECK(object.asExt().data[i] == '_');
+	}
+}
 
-		size_t last_index = 0;
+TEST_CASE("serialize/ext (fixed_ext16)")
+{
+	Ext ext;
+	std::vector<uint8_t> data;
+	const size_t data_len = 16;
+	const int8_t type = 42;
 
-		index = 0;
-		error = Error_None;
+	ext.type = type;
+	ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error        == Error_None);
-			CHECK(last_index   != index);
-			CHECK(part.isExt() == true);
+	data = serialize(ext);
+	CHECK(data.size() == 18);
+	size_t index = 0;
+	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext16);
+	CHECK(data[index++] == type);
 
-			Ext& ext = part.asExt();
-			CHECK(ext.type == value.type);
-			CHECK(ext.data == value.data);
+	Object object = deserialize(data);
+	CHECK(object.isExt() == true);
 
-			last_index = index;
-		}
-	}
+	CHECK(object.asExt().type        == type);
+	CHECK(object.asExt().data.size() == data_len);
 
-	SUBCASE("multi-part/ext (fixed_ext8)")
+	for(size_t i = 0; i < data_len; i++)
 	{
-		std::vector<uint8_t> vector = {};
+		CHECK(object.asExt().data[i] == '_');
+	}
+}
 
-		const int    multi_part_count = 3;
-		const size_t data_len         = 8;
-		const int8_t type             = 42;
+TEST_CASE("serialize/ext (ext8)")
+{
+	std::vector<uint8_t> data;
+	const int8_t type = 42;
 
-		Ext value;
-		value.type = type;
-		value.data = std::vector<uint8_t>(data_len, '_');
+	Ext ext;
+	ext.type = type;
 
-		data = serialize(value);
+	SUBCASE("length=0")
+	{
+		const size_t data_len = 0;
+		ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+		data = serialize(ext);
+		CHECK(data.size() == 3);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext8);
+		CHECK(data[index++] == data_len);
+		CHECK(data[index++] == type);
 
-		size_t last_index = 0;
+		Object object = deserialize(data);
+		CHECK(object.isExt() == true);
 
-		index = 0;
-		error = Error_None;
+		CHECK(object.asExt().type        == type);
+		CHECK(object.asExt().data.size() == data_len);
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < data_len; i++)
 		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error        == Error_None);
-			CHECK(last_index   != index);
-			CHECK(part.isExt() == true);
-
-			Ext& ext = part.asExt();
-			CHECK(ext.type == value.type);
-			CHECK(ext.data == value.data);
-
-			last_index = index;
+			CHECK(object.asExt().data[i] == '_');
 		}
 	}
 
-	SUBCASE("multi-part/ext (fixed_ext16)")
+	SUBCASE("length=5")
 	{
-		std::vector<uint8_t> vector = {};
+		const size_t data_len = 5;
+		ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		const int    multi_part_count = 3;
-		const size_t data_len         = 16;
-		const int8_t type             = 42;
+		data = serialize(ext);
+		CHECK(data.size() == 8);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext8);
+		CHECK(data[index++] == data_len);
+		CHECK(data[index++] == type);
 
-		Ext value;
-		value.type = type;
-		value.data = std::vector<uint8_t>(data_len, '_');
+		Object object = deserialize(data);
+		CHECK(object.isExt() == true);
 
-		data = serialize(value);
+		CHECK(object.asExt().type        == type);
+		CHECK(object.asExt().data.size() == data_len);
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < data_len; i++)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			CHECK(object.asExt().data[i] == '_');
 		}
+	}
 
-		size_t last_index = 0;
+	SUBCASE("length=max")
+	{
+		const size_t data_len = std::numeric_limits<uint8_t>::max();
+		ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		index = 0;
-		error = Error_None;
+		data = serialize(ext);
+		CHECK(data.size() == 258);
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext8);
+		CHECK(data[index++] == data_len);
+		CHECK(data[index++] == type);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error        == Error_None);
-			CHECK(last_index   != index);
-			CHECK(part.isExt() == true);
+		Object object = deserialize(data);
+		CHECK(object.isExt() == true);
 
-			Ext& ext = part.asExt();
-			CHECK(ext.type == value.type);
-			CHECK(ext.data == value.data);
+		CHECK(object.asExt().type        == type);
+		CHECK(object.asExt().data.size() == data_len);
 
-			last_index = index;
+		for(size_t i = 0; i < data_len; i++)
+		{
+			CHECK(object.asExt().data[i] == '_');
 		}
 	}
+}
 
-	SUBCASE("multi-part/ext (ext8)")
+TEST_CASE("serialize/ext (ext16)")
+{
+	std::vector<uint8_t> data;
+	const int8_t type = 42;
+
+	Ext ext;
+	ext.type = type;
+
+	SUBCASE("length=min")
 	{
-		std::vector<uint8_t> vector = {};
+		const size_t data_len = std::numeric_limits<uint8_t>::max() + (size_t)1;
+		ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		const int    multi_part_count = 3;
-		const size_t data_len         = std::numeric_limits<uint8_t>::max();
-		const int8_t type             = 42;
+		data = serialize(ext);
+		CHECK(data.size() == (data_len + 4));
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext16);
+		CHECK(readBigEndian<uint16_t>(data.data(), index) == data_len);
+		CHECK(data[index++] == type);
 
-		Ext value;
-		value.type = type;
-		value.data = std::vector<uint8_t>(data_len, '_');
+		Object object = deserialize(data);
+		CHECK(object.isExt() == true);
 
-		data = serialize(value);
+		CHECK(object.asExt().type        == type);
+		CHECK(object.asExt().data.size() == data_len);
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < data_len; i++)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			CHECK(object.asExt().data[i] == '_');
 		}
+	}
 
-		size_t last_index = 0;
+	SUBCASE("length=max")
+	{
+		const size_t data_len = std::numeric_limits<uint16_t>::max();
+		ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		index = 0;
-		error = Error_None;
+		data = serialize(ext);
+		CHECK(data.size() == (data_len + 4));
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext16);
+		CHECK(readBigEndian<uint16_t>(data.data(), index) == data_len);
+		CHECK(data[index++] == type);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error        == Error_None);
-			CHECK(last_index   != index);
-			CHECK(part.isExt() == true);
+		Object object = deserialize(data);
+		CHECK(object.isExt() == true);
 
-			Ext& ext = part.asExt();
-			CHECK(ext.type == value.type);
-			CHECK(ext.data == value.data);
+		CHECK(object.asExt().type        == type);
+		CHECK(object.asExt().data.size() == data_len);
 
-			last_index = index;
+		for(size_t i = 0; i < data_len; i++)
+		{
+			CHECK(object.asExt().data[i] == '_');
 		}
 	}
+}
 
-	SUBCASE("multi-part/ext (ext16)")
+TEST_CASE("serialize/ext (ext32)")
+{
+	std::vector<uint8_t> data;
+	const int8_t type = 42;
+
+	Ext ext;
+	ext.type = type;
+
+	SUBCASE("length=min")
 	{
-		std::vector<uint8_t> vector = {};
+		const size_t data_len = std::numeric_limits<uint16_t>::max() + (size_t)1;
+		ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		const int    multi_part_count = 3;
-		const size_t data_len         = std::numeric_limits<uint8_t>::max() + 1;
-		const int8_t type             = 42;
+		data = serialize(ext);
+		CHECK(data.size() == (data_len + 6));
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext32);
+		CHECK(readBigEndian<uint32_t>(data.data(), index) == data_len);
+		CHECK(data[index++] == type);
 
-		Ext value;
-		value.type = type;
-		value.data = std::vector<uint8_t>(data_len, '_');
+		Object object = deserialize(data);
+		CHECK(object.isExt() == true);
 
-		data = serialize(value);
+		CHECK(object.asExt().type        == type);
+		CHECK(object.asExt().data.size() == data_len);
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < data_len; i++)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			CHECK(object.asExt().data[i] == '_');
 		}
+	}
 
-		size_t last_index = 0;
-
-		index = 0;
-		error = Error_None;
+#if 0 // Uses too much RAM and takes too long.
+	SUBCASE("length=max")
+	{
+		const size_t data_len = std::numeric_limits<uint32_t>::max();
+		ext.data = std::pmr::vector<uint8_t>(data_len, '_');
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error        == Error_None);
-			CHECK(last_index   != index);
-			CHECK(part.isExt() == true);
+		data = serialize(ext);
+		CHECK(data.size() == (data_len + 6));
+		size_t index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Ext32);
+		CHECK(readBigEndian<uint32_t>(data.data(), index) == data_len);
+		CHECK(data[index++] == type);
 
-			Ext& ext = part.asExt();
-			CHECK(ext.type == value.type);
-			CHECK(ext.data == value.data);
+		Object object = deserialize(data);
+		CHECK(object.isExt() == true);
 
-			last_index = index;
+		CHECK(object.asExt().type        == type);
+		CHECK(object.asExt().data.size() == data_len);
+
+		for(size_t i = 0; i < data_len; i++)
+		{
+			CHECK(object.asExt().data[i] == '_');
 		}
 	}
+#endif
+}
+#endif // }}}
 
-	SUBCASE("multi-part/ext (ext32)")
-	{
-		std::vector<uint8_t> vector = {};
 
-		const int    multi_part_count = 3;
-		const size_t data_len         = std::numeric_limits<uint16_t>::max() + 1;
-		const int8_t type             = 42;
+/**
+ * \brief Serialize Map data.
+ *
+ * The contents of the Map will be packed into the returned std::vector.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ * map.set(Object{uint64_t(42)}, Object{true});
+ *
+ * std::vector<uint8_t> result = zakero::messagepack::serialize(map);
+ *
+ * reply(host_ip, result);
+ * \endparcode
+ *
+ * \return The packed data.
+ */
+std::vector<uint8_t> serialize(const Map& map ///< The Map
+	) noexcept
+{
+	std::error_code error;
 
-		Ext value;
-		value.type = type;
-		value.data = std::vector<uint8_t>(data_len, '_');
+	return serialize(map, error);
+}
 
-		data = serialize(value);
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+/**
+ * \brief Serialize Map data.
+ *
+ * The contents of the Map will be packed into the returned std::vector.
+ *
+ * \parcode
+ * zakero::messagepack::Map map;
+ * map.set(Object{uint64_t(42)}, Object{true});
+ *
+ * std::error_code error;
+ * std::vector<uint8_t> result = zakero::messagepack::serialize(map, error);
+ *
+ * reply(host_ip, result);
+ * \endparcode
+ *
+ * \return The packed data.
+ */
+std::vector<uint8_t> serialize(const Map& map   ///< The Map
+	, std::error_code&                error ///< The Error
+	) noexcept
+{
+	std::vector<uint8_t> vector(serializedSize(map));
+	Packer packer(std::span<uint8_t>{vector});
 
-		size_t last_index = 0;
+	error = packer.pack(map);
 
-		index = 0;
-		error = Error_None;
+	vector.resize(packer.size());
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error        == Error_None);
-			CHECK(last_index   != index);
-			CHECK(part.isExt() == true);
+	return vector;
+}
 
-			Ext& ext = part.asExt();
-			CHECK(ext.type == value.type);
-			CHECK(ext.data == value.data);
 
-			last_index = index;
-		}
-	}
+/**
+ * \brief Serialize Map data in parallel.
+ *
+ * The contents of the Map will be packed into the returned std::vector, 
+ * using \p thread_count threads. The packed data is the same as 
+ * serialize(const Map&, std::error_code&).
+ *
+ * See serialize(const Object&, std::error_code&, const size_t) for details.
+ *
+ * \return The packed data.
+ */
+std::vector<uint8_t> serialize(const Map& map        ///< The Map
+	, std::error_code&                error        ///< The Error
+	, const size_t                    thread_count ///< The number of threads
+	) noexcept
+{
+	std::vector<SerializeUnit_> unit_vector;
 
-	SUBCASE("multi-part/fixed_int (positive)")
-	{
-		std::vector<uint8_t> vector = {};
+	serializeUnits_(map, unit_vector, 0);
 
-		const int     multi_part_count = 3;
-		const int64_t value            = 1;
+	std::vector<uint8_t> vector = serializeUnits_(unit_vector, thread_count);
 
-		Object object = {value};
+	if(vector.empty())
+	{
+		return serialize(map, error);
+	}
 
-		data = serialize(object);
+	error = Error_None;
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
-		}
+	return vector;
+}
 
-		size_t last_index = 0;
 
-		index = 0;
-		error = Error_None;
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("serialize/map (fixed_map)")
+{
+	Map map;
+	std::vector<uint8_t> data;
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error              == Error_None);
-			CHECK(last_index         != index);
-			CHECK(part.is<int64_t>() == true);
-			CHECK(part.as<int64_t>() == value);
+	SUBCASE("empty")
+	{
+		data = serialize(map);
+		CHECK(data.size() == 1);
+		CHECK((data[0] & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map);
+		CHECK((data[0] & Fixed_Map_Value) == 0);
 
-			last_index = index;
-		}
+		Object object = deserialize(data);
+		CHECK(object.isMap() == true);
+		CHECK(object.asMap().size() == 0);
 	}
 
-	SUBCASE("multi-part/fixed_int (negative)")
+	SUBCASE("max")
 	{
-		std::vector<uint8_t> vector = {};
-
-		const int     multi_part_count = 3;
-		const int64_t value            = -1;
-
-		Object object = {value};
-
-		data = serialize(object);
+		size_t max = 15;
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < max; i++)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			// i          ==> 1 byte
+			// str(0-9)   ==> 2 bytes
+			// str(10-14) ==> 3 bytes
+			map.set(Object{int64_t(i)}, Object{std::pmr::string(std::to_string(i))});
 		}
 
-		size_t last_index = 0;
+		data = serialize(map);
+		CHECK(data.size() == 51);
+		CHECK((data[0] & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map);
+		CHECK((data[0] & Fixed_Map_Value) == max);
 
-		index = 0;
-		error = Error_None;
+		Object object = deserialize(data);
+		CHECK(object.isMap() == true);
+		CHECK(object.asMap().size() == max);
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < max; i++)
 		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error              == Error_None);
-			CHECK(last_index         != index);
-			CHECK(part.is<int64_t>() == true);
-			CHECK(part.as<int64_t>() == value);
-
-			last_index = index;
+			Object key = Object{int64_t(i)};
+			CHECK(map.keyExists(key) == true);
+			
+			Object value = map.at(key);
+			CHECK(value.asString() == std::to_string(i).c_str());
 		}
 	}
+}
 
-	SUBCASE("multi-part/fixed_str")
-	{
-		std::vector<uint8_t> vector = {};
-
-		const int         multi_part_count = 3;
-		const std::string value            = "xyzzy";
 
-		Object object = {value};
+TEST_CASE("serialize/map (map16)")
+{
+	Map map;
+	std::vector<uint8_t> data;
 
-		data = serialize(object);
+	SUBCASE("min")
+	{
+		const size_t min = 16;
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < min; i++)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			map.set(Object{int64_t(i)}, Object{std::pmr::string(std::to_string(i))});
 		}
 
-		size_t last_index = 0;
+		data = serialize(map);
+		CHECK(data.size() == 57);
+		CHECK(data[0] == (uint8_t)Format::Map16);
+		CHECK(fromBigEndian<uint16_t>(&data[1]) == min);
 
-		index = 0;
-		error = Error_None;
+		Object object = deserialize(data);
+		CHECK(object.isMap() == true);
+		CHECK(object.asMap().size() == min);
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < min; i++)
 		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error           == Error_None);
-			CHECK(last_index      != index);
-			CHECK(part.isString() == true);
-			CHECK(part.asString() == value);
-
-			last_index = index;
+			Object key = Object{int64_t(i)};
+			CHECK(map.keyExists(key) == true);
+			
+			Object value = map.at(key);
+			CHECK(value.asString() == std::to_string(i).c_str());
 		}
 	}
 
-	SUBCASE("multi-part/fixed_array")
+	SUBCASE("max")
 	{
-		std::vector<uint8_t> vector = {};
-
-		const int    multi_part_count = 3;
-		const size_t value_size       = 8;
+		const size_t max = std::numeric_limits<uint16_t>::max();
 
-		Array value;
-		for(size_t i = 0; i < value_size; i++)
+		//printf("Generating %lu Map entries\n", max);
+		for(size_t i = 0; i < max; i++)
 		{
-			value.appendNull();
+			Object key = {int64_t(i)};
+			Object val = {std::pmr::string(std::to_string(i))};
+			map.set(std::move(key), std::move(val));
+
+			//if(i % 1000 == 0) { printf("%lu/%lu\n", i, max); }
 		}
 
-		data = serialize(value);
+		data = serialize(map);
+		CHECK(data.size() == 643986);
+		CHECK(data[0] == (uint8_t)Format::Map16);
+		CHECK(fromBigEndian<uint16_t>(&data[1]) == max);
 
-		for(int i = 0; i < multi_part_count; i++)
+		Object object = deserialize(data);
+		CHECK(object.isMap() == true);
+		CHECK(object.asMap().size() == max);
+
+		for(size_t i = 0; i < max; i++)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			Object key = Object{int64_t(i)};
+			CHECK(map.keyExists(key) == true);
+			
+			Object value = map.at(key);
+			CHECK(value.asString() == std::to_string(i).c_str());
 		}
+	}
+}
 
-		size_t last_index = 0;
 
-		index = 0;
-		error = Error_None;
+TEST_CASE("serialize/map (map32)")
+{
+	Map map;
+	std::vector<uint8_t> data;
 
-		for(int i = 0; i < multi_part_count; i++)
-		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error          == Error_None);
-			CHECK(last_index     != index);
-			CHECK(part.isArray() == true);
+	SUBCASE("min")
+	{
+		const size_t min = std::numeric_limits<uint16_t>::max() + 1;
 
-			Array& array = part.asArray();
-			for(size_t i = 0; i < value_size; i++)
-			{
-				CHECK(array[i] == value[i]);
-			}
+		//printf("Generating %lu Map entries\n", min);
+		for(size_t i = 0; i < min; i++)
+		{
+			Object key = {int64_t(i)};
+			Object val = {std::pmr::string(std::to_string(i))};
+			map.set(std::move(key), std::move(val));
 
-			last_index = index;
+			//if(i % 1000 == 0) { printf("%lu/%lu\n", i, min); }
 		}
-	}
 
-	SUBCASE("multi-part/fixed_map")
-	{
-		std::vector<uint8_t> vector = {};
+		data = serialize(map);
+		CHECK(data.size() == 643999);
+		CHECK(data[0] == (uint8_t)Format::Map32);
+		CHECK(fromBigEndian<uint32_t>(&data[1]) == min);
 
-		const int    multi_part_count = 3;
-		const size_t value_size       = 8;
+		Object object = deserialize(data);
+		CHECK(object.isMap() == true);
+		CHECK(object.asMap().size() == min);
 
-		Map value;
-		for(size_t i = 0; i < value_size; i++)
+		for(size_t i = 0; i < min; i++)
 		{
-			value[i] = Object{};
+			Object key = Object{int64_t(i)};
+			CHECK(map.keyExists(key) == true);
+			
+			Object value = map.at(key);
+			CHECK(value.asString() == std::to_string(i).c_str());
 		}
+	}
 
-		data = serialize(value);
+#if 0 // Will use too much memory and take to long
+	SUBCASE("max")
+	{
+		const size_t max = std::numeric_limits<uint32_t>::max();
+		map.object_key.reserve(max);
+		map.object_value.reserve(max);
 
-		for(int i = 0; i < multi_part_count; i++)
+		printf("Generating %lu Map entries\n", max);
+		for(size_t i = 0; i < max; i++)
 		{
-			vector.insert(std::end(vector)
-				, std::begin(data), std::end(data)
-				);
+			Object key = {int64_t(i)};
+			Object val = {std::pmr::string(std::to_string(i))};
+			map.set(std::move(key), std::move(val));
+
+			if(i % 1000 == 0) { printf("%lu/%lu\n", i, max); }
 		}
 
-		size_t last_index = 0;
+		data = serialize(map);
+		CHECK(data.size() == 0); // Unknown
+		CHECK(data[0] == (uint8_t)Format::Map32);
+		CHECK(fromBigEndian<uint32_t>(&data[1]) == max);
 
-		index = 0;
-		error = Error_None;
+		Object object = deserialize(data);
+		CHECK(object.isMap() == true);
+		CHECK(object.asMap().size() == max);
 
-		for(int i = 0; i < multi_part_count; i++)
+		for(size_t i = 0; i < max; i++)
 		{
-			Object part = deserialize(vector, index, error);
-			CHECK(error        == Error_None);
-			CHECK(last_index   != index);
-			CHECK(part.isMap() == true);
-
-			Map& map = part.asMap();
-			for(size_t i = 0; i < value_size; i++)
-			{
-				CHECK(map[i] == value[i]);
-			}
-
-			last_index = index;
+			Object key = Object{int64_t(i)};
+			CHECK(map.keyExists(key) == true);
+			
+			Object value = map.at(key);
+			CHECK(value.asString() == std::to_string(i).c_str());
 		}
 	}
+#endif
 }
 #endif // }}}
 
-// }}} Utilities::deserialize
-// {{{ Utilities::serialize
 
 /**
- * \brief Serialize Array data.
+ * \brief Serialize Object data.
  *
- * The contents of the Array will be packed into the returned std::vector.
+ * The contents of the Object will be packed into the returned std::vector.
  *
  * \parcode
- * zakero::messagepack::Array array;
- * array.append(command_id);
- * array.append(true);
- * array.append(error_code);
+ * zakero::messagepack::Object object = { true };
  *
- * std::vector<uint8_t> result = zakero::messagepack::serialize(array);
+ * std::vector<uint8_t> result = zakero::messagepack::serialize(object);
  *
  * reply(host_ip, result);
  * \endparcode
  *
  * \return The packed data.
  */
-std::vector<uint8_t> serialize(const Array& array ///< The Array
+std::vector<uint8_t> serialize(const Object& object ///< The Object
 	) noexcept
 {
 	std::error_code error;
 
-	return serialize(array, error);
+	return serialize(object, error);
 }
 
 
 /**
- * \brief Serialize Array data.
+ * \brief Serialize Object data.
  *
- * The contents of the Array will be packed into the returned std::vector.
+ * The contents of the Object will be packed into the returned std::vector.
  *
  * \parcode
- * zakero::messagepack::Array array;
- * array.append(command_id);
- * array.append(true);
- * array.append(error_code);
+ * zakero::messagepack::Object object = { true };
  *
  * std::error_code error;
+ * std::vector<uint8_t> result = zakero::messagepack::serialize(object, error);
  *
- * std::vector<uint8_t> result = zakero::messagepack::serialize(array, error);
- *
- * if(error)
- * {
- * 	logError(command_id, error);
- * }
- * else
- * {
- * 	reply(host_ip, result);
- * }
+ * reply(host_ip, result);
  * \endparcode
  *
  * \return The packed data.
  */
-std::vector<uint8_t> serialize(const Array& array ///< The Array
-	, std::error_code&                  error ///< The Error
+std::vector<uint8_t> serialize(const Object& object ///< The Object
+	, std::error_code&                   error  ///< The Error
 	) noexcept
 {
-	std::vector<uint8_t> vector;
+	std::vector<uint8_t> vector(serializedSize(object));
+	Packer packer(std::span<uint8_t>{vector});
 
-	error = serialize_(array, vector);
+	error = packer.pack(object);
+
+	vector.resize(packer.size());
 
 	return vector;
 }
 
 
 /**
- * \brief Serialize Ext data.
- *
- * The contents of the Ext will be packed into the returned std::vector.
+ * \brief Serialize Object data in parallel.
+ *
+ * The contents of the Object will be packed into the returned std::vector, 
+ * using \p thread_count threads. If the \p thread_count is `0`, 
+ * `std::thread::hardware_concurrency()` threads will be used.
+ *
+ * The packed data is byte-for-byte the same as serialize(const Object&, 
+ * std::error_code&). This is done in three passes:
+ * -# The Object is split into units. A unit is the header of an Array or 
+ *    Map, a range of up to 256 Array elements, or a range of up to 256 
+ *    key/value pairs. Arrays and Maps with less than 64 elements, near the 
+ *    top of the Object, are split into their contents so that large 
+ *    children are split as well.
+ * -# The threads calculate the packed size of every unit, then the sizes 
+ *    are added up to find the offset of every unit.
+ * -# The output is allocated once and the threads pack every unit at its 
+ *    offset.
+ *
+ * Small Objects do not have enough units to use more than one thread. If 
+ * there is an error, the Object is packed again by serialize(const Object&, 
+ * std::error_code&) so that the packed data and the \p error are the same.
  *
  * \parcode
- * zakero::messagepack::Ext ext;
- * ext.type = 42;
- * ext.data = std::vector<uint8_t>(16, '_');
+ * zakero::messagepack::Object snapshot = takeSnapshot();
  *
- * std::vector<uint8_t> result = zakero::messagepack::serialize(ext);
+ * std::error_code error;
+ *
+ * std::vector<uint8_t> data = zakero::messagepack::serialize(snapshot, error, 0);
  * \endparcode
  *
+ * \note The Object must not be changed while it is being serialized.
+ *
  * \return The packed data.
  */
-std::vector<uint8_t> serialize(const Ext& ext ///< The Extension
+std::vector<uint8_t> serialize(const Object& object       ///< The Object
+	, std::error_code&                   error        ///< The Error
+	, const size_t                       thread_count ///< The number of threads
 	) noexcept
 {
-	std::error_code error;
+	std::vector<SerializeUnit_> unit_vector;
 
-	return serialize(ext, error);
+	serializeUnits_(object, unit_vector, 0);
+
+	std::vector<uint8_t> vector = serializeUnits_(unit_vector, thread_count);
+
+	if(vector.empty())
+	{
+		return serialize(object, error);
+	}
+
+	error = Error_None;
+
+	return vector;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("serialize/parallel")
+{
+	auto check = [](const Object& object)
+	{
+		const std::vector<uint8_t> expected = serialize(object);
+
+		for(const size_t thread_count : {0, 1, 2, 3, 8})
+		{
+			std::error_code error = Error_Unknown;
+
+			CHECK(serialize(object, error, thread_count) == expected);
+			CHECK(error == Error_None);
+
+			if(object.isArray())
+			{
+				error = Error_Unknown;
+				CHECK(serialize(object.asArray(), error, thread_count) == expected);
+				CHECK(error == Error_None);
+			}
+
+			if(object.isMap())
+			{
+				error = Error_Unknown;
+				CHECK(serialize(object.asMap(), error, thread_count) == expected);
+				CHECK(error == Error_None);
+			}
+		}
+	};
+
+	auto make_child = [](const size_t i) -> Object
+	{
+		switch(i % 6)
+		{
+			case 0: return Object{int64_t(i) * -7};
+			case 1: return Object{float(i) * 0.5f};
+			case 2: return Object{std::pmr::string(i % 40, 's')};
+			case 3: return Object{std::pmr::vector<uint8_t>(i % 300, 'b')};
+			case 4:
+			{
+				Object object = {Map{}};
+				object.asMap().set(Object{"id"}, Object{uint64_t(i)});
+				object.asMap().set(Object{"scale"}, Object{double(i) * 0.25});
+				return object;
+			}
+		}
+
+		Object object = {Array{}};
+		object.asArray().appendRange(std::vector<double>(i % 20, 1.5));
+		return object;
+	};
+
+	SUBCASE("Scalar")
+	{
+		check(Object{});
+		check(Object{uint64_t(42)});
+		check(Object{std::pmr::string(100'000, 's')});
+	}
+
+	SUBCASE("Empty")
+	{
+		check(Object{Array{}});
+		check(Object{Map{}});
+	}
+
+	SUBCASE("Large Array")
+	{
+		Object object = {Array{}};
+
+		for(size_t i = 0; i < 20'000; i++)
+		{
+			object.asArray().append(make_child(i));
+		}
+
+		check(object);
+	}
+
+	SUBCASE("Float Array")
+	{
+		// Runs of floats that cross the units
+		Object object = {Array{}};
+		object.asArray().appendRange(std::vector<float>(10'000, 2.5f));
+
+		check(object);
+	}
+
+	SUBCASE("Large Map")
+	{
+		Object object = {Map{}};
+
+		for(size_t i = 0; i < 5'000; i++)
+		{
+			object.asMap().set(Object{int64_t(i)}, make_child(i));
+		}
+
+		check(object);
+	}
+
+	SUBCASE("Small containers")
+	{
+		// {"meta": {...}, "data": [...], "more": [[...], [...]]}
+		Object object = {Map{}};
+		Map&   map    = object.asMap();
+
+		map.emplace<Map>("meta").emplace<std::pmr::string>("name", "snapshot");
+
+		Array& data = map.emplace<Array>("data");
+		for(size_t i = 0; i < 10'000; i++)
+		{
+			data.append(make_child(i));
+		}
+
+		Array& more = map.emplace<Array>("more");
+		for(size_t i = 0; i < 3; i++)
+		{
+			Array& child = more.emplace<Array>();
+			for(size_t c = 0; c < 1'000 * i; c++)
+			{
+				child.append(make_child(c));
+			}
+		}
+
+		check(object);
+	}
+
+	SUBCASE("Deep")
+	{
+		Object  object = {Array{}};
+		Object* level  = &object;
+
+		for(size_t i = 0; i < 100; i++)
+		{
+			level->asArray().append(make_child(i));
+			level->asArray().append(Array{});
+			level = &level->asArray().object_vector.back();
+		}
+
+		check(object);
+	}
 }
+#endif // }}}
 
 
 /**
- * \brief Serialize Ext data.
+ * \brief Serialize Object data without copying large data.
  *
- * The contents of the Ext will be packed into the returned std::vector.
+ * The \p object is packed into the \p buffer, except for string, binary, 
+ * and extension data that is Packer::Gather_Size or larger. The 
+ * \p iovec_vector will refer to both the \p buffer and the large data in 
+ * the \p object, so the \p buffer and the \p object must not be changed 
+ * until the data has been written.
  *
  * \parcode
- * zakero::messagepack::Ext ext;
- * ext.type = 42;
- * ext.data = std::vector<uint8_t>(16, '_');
+ * std::vector<uint8_t>      buffer;
+ * std::vector<struct iovec> iovec_vector;
  *
- * std::error_code error;
- * std::vector<uint8_t> result = zakero::messagepack::serialize(ext, error);
+ * std::error_code error = zakero::messagepack::serialize(object, buffer, iovec_vector);
+ *
+ * if(!error)
+ * {
+ * 	writev(fd, iovec_vector.data(), iovec_vector.size());
+ * }
  * \endparcode
  *
- * \return The packed data.
+ * \see Packer::Packer(std::vector<uint8_t>&, std::vector<struct iovec>&, const size_t)
+ *
+ * \return An error code.
  */
-std::vector<uint8_t> serialize(const Ext& ext   ///< The Extension
-	, std::error_code&                error ///< The Error
+std::error_code serialize(const Object& object           ///< The Object
+	, std::vector<uint8_t>&           buffer       ///< The packed data
+	, std::vector<struct iovec>&      iovec_vector ///< The data to write
 	) noexcept
 {
-	std::vector<uint8_t> vector;
+	Packer packer(buffer, iovec_vector);
 
-	error = serialize_(ext, vector);
+	packer.pack(object);
 
-	return vector;
+	return packer.flush();
 }
 
+
 #ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("serialize/ext (fixed_ext1)")
+std::vector<uint8_t> gatherData_(const std::vector<struct iovec>& iovec_vector
+	) noexcept
 {
-	Ext ext;
 	std::vector<uint8_t> data;
-	const size_t data_len = 1;
-	const int8_t type = 42;
-
-	ext.type = type;
-	ext.data = std::vector<uint8_t>(data_len, '_');
 
-	data = serialize(ext);
-	CHECK(data.size() == 3);
-	size_t index = 0;
-	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext1);
-	CHECK(data[index++] == type);
-	CHECK(data[index++] == '_');
+	for(const struct iovec& iov : iovec_vector)
+	{
+		const uint8_t* base = (const uint8_t*)iov.iov_base;
 
-	Object object = deserialize(data);
-	CHECK(object.isExt() == true);
+		data.insert(data.end(), base, base + iov.iov_len);
+	}
 
-	CHECK(object.asExt().type        == type);
-	CHECK(object.asExt().data.size() == 1);
-	CHECK(object.asExt().data[0] == '_');
+	return data;
 }
 
-TEST_CASE("serialize/ext (fixed_ext2)")
-{
-	Ext ext;
-	std::vector<uint8_t> data;
-	const size_t data_len = 2;
-	const int8_t type = 42;
 
-	ext.type = type;
-	ext.data = std::vector<uint8_t>(data_len, '_');
+TEST_CASE("serialize/gather")
+{
+	const std::pmr::vector<uint8_t> large_bin(100'000, 0xb1);
+	const std::pmr::string          large_str(Packer::Gather_Size, 's');
 
-	data = serialize(ext);
-	CHECK(data.size() == 4);
-	size_t index = 0;
-	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext2);
-	CHECK(data[index++] == type);
+	Object object = {Array{}};
+	Array& array  = object.asArray();
 
-	Object object = deserialize(data);
-	CHECK(object.isExt() == true);
+	array.append(std::string_view("small"));
+	array.append(std::span<const uint8_t>(large_bin));
+	array.append(uint64_t(42));
+	array.append(std::string_view(large_str));
+	array.append(std::span<const uint8_t>(large_bin));
 
-	CHECK(object.asExt().type        == type);
-	CHECK(object.asExt().data.size() == data_len);
+	Ext ext;
+	ext.type = 7;
+	ext.data = std::pmr::vector<uint8_t>(5'000, 0xe7);
+	array.append(ext);
 
-	for(size_t i = 0; i < data_len; i++)
+	for(size_t i = 0; i < 1'000; i++)
 	{
-		CHECK(object.asExt().data[i] == '_');
+		array.append(float(i));
 	}
-}
 
-TEST_CASE("serialize/ext (fixed_ext4)")
-{
-	Ext ext;
-	std::vector<uint8_t> data;
-	const size_t data_len = 4;
-	const int8_t type = 42;
+	std::vector<uint8_t>      buffer;
+	std::vector<struct iovec> iovec_vector;
 
-	ext.type = type;
-	ext.data = std::vector<uint8_t>(data_len, '_');
+	CHECK(serialize(object, buffer, iovec_vector) == Error_None);
 
-	data = serialize(ext);
-	CHECK(data.size() == 6);
-	size_t index = 0;
-	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext4);
-	CHECK(data[index++] == type);
+	const std::vector<uint8_t> expected = serialize(object);
+	CHECK(gatherData_(iovec_vector) == expected);
+	CHECK(buffer.size() < expected.size() - 200'000);
 
-	Object object = deserialize(data);
-	CHECK(object.isExt() == true);
+	// The large data is not copied
 
-	CHECK(object.asExt().type        == type);
-	CHECK(object.asExt().data.size() == data_len);
+	CHECK(iovec_vector.size() == 9);
+	CHECK(iovec_vector[1].iov_base == array.object(1).asBinary().data());
+	CHECK(iovec_vector[1].iov_len  == large_bin.size());
+	CHECK(iovec_vector[3].iov_base == array.object(3).asString().data());
+	CHECK(iovec_vector[5].iov_base == array.object(4).asBinary().data());
+	CHECK(iovec_vector[7].iov_base == array.object(5).asExt().data.data());
 
-	for(size_t i = 0; i < data_len; i++)
+	// writev()
+
+	TemporaryFile_ file;
 	{
-		CHECK(object.asExt().data[i] == '_');
+		const int fd = ::open(file.path.c_str(), O_WRONLY);
+
+		CHECK(writev(fd, iovec_vector.data(), (int)iovec_vector.size()) == (ssize_t)expected.size());
+
+		::close(fd);
 	}
+
+	MappedFile mapped;
+	CHECK(mapped.open(file.path) == Error_None);
+	CHECK(std::ranges::equal(mapped.data(), expected));
 }
 
-TEST_CASE("serialize/ext (fixed_ext8)")
+TEST_CASE("packer/gather")
 {
-	Ext ext;
-	std::vector<uint8_t> data;
-	const size_t data_len = 8;
-	const int8_t type = 42;
-
-	ext.type = type;
-	ext.data = std::vector<uint8_t>(data_len, '_');
-
-	data = serialize(ext);
-	CHECK(data.size() == 10);
-	size_t index = 0;
-	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext8);
-	CHECK(data[index++] == type);
+	const std::vector<uint8_t> large(300, 'L');
 
-	Object object = deserialize(data);
-	CHECK(object.isExt() == true);
+	std::vector<uint8_t>      buffer = {0xff};
+	std::vector<struct iovec> iovec_vector;
 
-	CHECK(object.asExt().type        == type);
-	CHECK(object.asExt().data.size() == data_len);
+	std::vector<uint8_t> expected;
+	Packer vector_packer(expected);
 
-	for(size_t i = 0; i < data_len; i++)
 	{
-		CHECK(object.asExt().data[i] == '_');
-	}
-}
-
-TEST_CASE("serialize/ext (fixed_ext16)")
-{
-	Ext ext;
-	std::vector<uint8_t> data;
-	const size_t data_len = 16;
-	const int8_t type = 42;
+		Packer packer(buffer, iovec_vector, 256);
 
-	ext.type = type;
-	ext.data = std::vector<uint8_t>(data_len, '_');
+		CHECK(iovec_vector.empty());
 
-	data = serialize(ext);
-	CHECK(data.size() == 18);
-	size_t index = 0;
-	CHECK(data[index++] == (uint8_t)Format::Fixed_Ext16);
-	CHECK(data[index++] == type);
+		for(size_t i = 0; i < 100; i++)
+		{
+			// Enough small data for the buffer to move
+			for(size_t n = 0; n < 50; n++)
+			{
+				packer.packStr("small");
+				vector_packer.packStr("small");
+			}
 
-	Object object = deserialize(data);
-	CHECK(object.isExt() == true);
+			packer.packBin(large);
+			vector_packer.packBin(large);
+		}
 
-	CHECK(object.asExt().type        == type);
-	CHECK(object.asExt().data.size() == data_len);
+		packer.packRaw(large);
+		vector_packer.packRaw(large);
 
-	for(size_t i = 0; i < data_len; i++)
-	{
-		CHECK(object.asExt().data[i] == '_');
+		CHECK(packer.size() == expected.size());
 	}
-}
-
-TEST_CASE("serialize/ext (ext8)")
-{
-	std::vector<uint8_t> data;
-	const int8_t type = 42;
 
-	Ext ext;
-	ext.type = type;
+	CHECK(buffer[0] == 0xff);
+	CHECK(iovec_vector.size() == 201);
+	CHECK(gatherData_(iovec_vector) == expected);
 
-	SUBCASE("length=0")
+	for(size_t i = 0; i < 100; i++)
 	{
-		const size_t data_len = 0;
-		ext.data = std::vector<uint8_t>(data_len, '_');
+		CHECK(iovec_vector[(i * 2) + 1].iov_base == large.data());
+	}
 
-		data = serialize(ext);
-		CHECK(data.size() == 3);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext8);
-		CHECK(data[index++] == data_len);
-		CHECK(data[index++] == type);
+	// --- Only small data --- //
 
-		Object object = deserialize(data);
-		CHECK(object.isExt() == true);
+	buffer.clear();
+	iovec_vector.clear();
 
-		CHECK(object.asExt().type        == type);
-		CHECK(object.asExt().data.size() == data_len);
+	Packer small(buffer, iovec_vector);
+	small.packStr("small");
+	CHECK(iovec_vector.empty());
 
-		for(size_t i = 0; i < data_len; i++)
-		{
-			CHECK(object.asExt().data[i] == '_');
-		}
-	}
+	small.flush();
+	CHECK(iovec_vector.size() == 1);
+	CHECK(iovec_vector[0].iov_base == buffer.data());
+	CHECK(gatherData_(iovec_vector) == serialize(Object{"small"}));
 
-	SUBCASE("length=5")
-	{
-		const size_t data_len = 5;
-		ext.data = std::vector<uint8_t>(data_len, '_');
+	// --- Nothing --- //
 
-		data = serialize(ext);
-		CHECK(data.size() == 8);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext8);
-		CHECK(data[index++] == data_len);
-		CHECK(data[index++] == type);
+	buffer.clear();
+	iovec_vector.clear();
 
-		Object object = deserialize(data);
-		CHECK(object.isExt() == true);
+	Packer nothing(buffer, iovec_vector);
+	CHECK(nothing.flush() == Error_None);
+	CHECK(iovec_vector.empty());
+}
+#endif // }}}
 
-		CHECK(object.asExt().type        == type);
-		CHECK(object.asExt().data.size() == data_len);
 
-		for(size_t i = 0; i < data_len; i++)
-		{
-			CHECK(object.asExt().data[i] == '_');
-		}
-	}
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
 
-	SUBCASE("length=max")
-	{
-		const size_t data_len = std::numeric_limits<uint8_t>::max();
-		ext.data = std::vector<uint8_t>(data_len, '_');
+TEST_CASE("serialize/object/nill")
+{
+	Object object = {};
+	CHECK(object.isNull());
 
-		data = serialize(ext);
-		CHECK(data.size() == 258);
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext8);
-		CHECK(data[index++] == data_len);
-		CHECK(data[index++] == type);
+	// Check serialized data
 
-		Object object = deserialize(data);
-		CHECK(object.isExt() == true);
+	std::vector<uint8_t> data = serialize(object);
+	CHECK(data.size() == 1);
 
-		CHECK(object.asExt().type        == type);
-		CHECK(object.asExt().data.size() == data_len);
+	// Check deserialized data
 
-		for(size_t i = 0; i < data_len; i++)
-		{
-			CHECK(object.asExt().data[i] == '_');
-		}
-	}
+	size_t index = 0;
+	CHECK(data[index] == (uint8_t)Format::Nill);
+
+	object = deserialize(data);
+	CHECK(object.isNull());
 }
 
-TEST_CASE("serialize/ext (ext16)")
+
+TEST_CASE("serialize/object/bool")
 {
+	Object               object;
 	std::vector<uint8_t> data;
-	const int8_t type = 42;
-
-	Ext ext;
-	ext.type = type;
+	size_t               index = 0;
 
-	SUBCASE("length=min")
+	SUBCASE("True")
 	{
-		const size_t data_len = std::numeric_limits<uint8_t>::max() + (size_t)1;
-		ext.data = std::vector<uint8_t>(data_len, '_');
+		object = {true};
+		CHECK(object.is<bool>());
 
-		data = serialize(ext);
-		CHECK(data.size() == (data_len + 4));
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext16);
-		Convert.uint64 = 0;
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint16 == data_len);
-		CHECK(data[index++] == type);
+		// Check serialized data
 
-		Object object = deserialize(data);
-		CHECK(object.isExt() == true);
+		data = serialize(object);
+		CHECK(data.size() == 1);
 
-		CHECK(object.asExt().type        == type);
-		CHECK(object.asExt().data.size() == data_len);
+		index = 0;
+		CHECK(data[index] == (uint8_t)Format::True);
 
-		for(size_t i = 0; i < data_len; i++)
-		{
-			CHECK(object.asExt().data[i] == '_');
-		}
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<bool>());
+		CHECK(object.as<bool>() == true);
 	}
 
-	SUBCASE("length=max")
+	SUBCASE("False")
 	{
-		const size_t data_len = std::numeric_limits<uint16_t>::max();
-		ext.data = std::vector<uint8_t>(data_len, '_');
+		object = {false};
+		CHECK(object.is<bool>());
 
-		data = serialize(ext);
-		CHECK(data.size() == (data_len + 4));
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext16);
-		Convert.uint64 = 0;
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint16 == data_len);
-		CHECK(data[index++] == type);
+		// Check serialized data
 
-		Object object = deserialize(data);
-		CHECK(object.isExt() == true);
+		data = serialize(object);
+		CHECK(data.size() == 1);
+		index = 0;
+		CHECK(data[index] == (uint8_t)Format::False);
 
-		CHECK(object.asExt().type        == type);
-		CHECK(object.asExt().data.size() == data_len);
+		// Check deserialized data
 
-		for(size_t i = 0; i < data_len; i++)
-		{
-			CHECK(object.asExt().data[i] == '_');
-		}
+		object = deserialize(data);
+		CHECK(object.is<bool>());
+		CHECK(object.as<bool>() == false);
 	}
 }
 
-TEST_CASE("serialize/ext (ext32)")
+
+TEST_CASE("serialize/object/fixed_int")
 {
+	Object               object;
 	std::vector<uint8_t> data;
-	const int8_t type = 42;
+	size_t               index;
 
-	Ext ext;
-	ext.type = type;
+	// -------------------------------------------------------------------
 
-	SUBCASE("length=min")
+	SUBCASE("Zero")
 	{
-		const size_t data_len = std::numeric_limits<uint16_t>::max() + (size_t)1;
-		ext.data = std::vector<uint8_t>(data_len, '_');
+		const int64_t fixint_zero = 0;
 
-		data = serialize(ext);
-		CHECK(data.size() == (data_len + 6));
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext32);
-		Convert.uint64 = 0;
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint32 == data_len);
-		CHECK(data[index++] == type);
+		object = {fixint_zero};
+		CHECK(object.is<int64_t>());
 
-		Object object = deserialize(data);
-		CHECK(object.isExt() == true);
+		// Check serialized data
 
-		CHECK(object.asExt().type        == type);
-		CHECK(object.asExt().data.size() == data_len);
+		data = serialize(object);
+		CHECK(data.size() == 1);
 
-		for(size_t i = 0; i < data_len; i++)
-		{
-			CHECK(object.asExt().data[i] == '_');
-		}
+		index = 0;
+		CHECK((data[index] & Fixed_Int_Pos_Mask) == (uint8_t)Format::Fixed_Int_Pos);
+		CHECK((data[index] & Fixed_Int_Pos_Value) == fixint_zero);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == fixint_zero);
 	}
 
-#if 0 // Uses too much RAM and takes too long.
-	SUBCASE("length=max")
+	// -------------------------------------------------------------------
+
+	SUBCASE("Max")
 	{
-		const size_t data_len = std::numeric_limits<uint32_t>::max();
-		ext.data = std::vector<uint8_t>(data_len, '_');
+		const int64_t fixint_max = 127;
 
-		data = serialize(ext);
-		CHECK(data.size() == (data_len + 6));
-		size_t index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Ext32);
-		Convert.uint64 = 0;
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint32 == data_len);
-		CHECK(data[index++] == type);
+		object = {fixint_max};
+		CHECK(object.is<int64_t>());
 
-		Object object = deserialize(data);
-		CHECK(object.isExt() == true);
+		// Check serialized data
 
-		CHECK(object.asExt().type        == type);
-		CHECK(object.asExt().data.size() == data_len);
+		data = serialize(object);
+		CHECK(data.size() == 1);
 
-		for(size_t i = 0; i < data_len; i++)
-		{
-			CHECK(object.asExt().data[i] == '_');
-		}
+		index = 0;
+		CHECK((data[index] & Fixed_Int_Pos_Mask) == (uint8_t)Format::Fixed_Int_Pos);
+		CHECK((data[index] & Fixed_Int_Pos_Value) == fixint_max);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == fixint_max);
 	}
-#endif
-}
-#endif // }}}
 
+	// -------------------------------------------------------------------
 
-/**
- * \brief Serialize Map data.
- *
- * The contents of the Map will be packed into the returned std::vector.
- *
- * \parcode
- * zakero::messagepack::Map map;
- * map.set(Object{uint64_t(42)}, Object{true});
- *
- * std::vector<uint8_t> result = zakero::messagepack::serialize(map);
- *
- * reply(host_ip, result);
- * \endparcode
- *
- * \return The packed data.
- */
-std::vector<uint8_t> serialize(const Map& map ///< The Map
-	) noexcept
-{
-	std::error_code error;
+	SUBCASE("Min")
+	{
+		const int64_t fixint_min = -32;
 
-	return serialize(map, error);
-}
+		object = {fixint_min};
+		CHECK(object.is<int64_t>());
 
+		// Check serialized data
 
-/**
- * \brief Serialize Map data.
- *
- * The contents of the Map will be packed into the returned std::vector.
- *
- * \parcode
- * zakero::messagepack::Map map;
- * map.set(Object{uint64_t(42)}, Object{true});
- *
- * std::error_code error;
- * std::vector<uint8_t> result = zakero::messagepack::serialize(map, error);
- *
- * reply(host_ip, result);
- * \endparcode
- *
- * \return The packed data.
- */
-std::vector<uint8_t> serialize(const Map& map   ///< The Map
-	, std::error_code&                error ///< The Error
-	) noexcept
-{
-	std::vector<uint8_t> vector;
+		data = serialize(object);
+		CHECK(data.size() == 1);
+
+		index = 0;
+		CHECK((data[index] & Fixed_Int_Neg_Mask) == (uint8_t)Format::Fixed_Int_Neg);
+		CHECK(((data[index] & Fixed_Int_Neg_Value) - 32) == fixint_min);
 
-	error = serialize_(map, vector);
+		// Check deserialized data
 
-	return vector;
-}
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == fixint_min);
+	}
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
-TEST_CASE("serialize/map (fixed_map)")
-{
-	Map map;
-	std::vector<uint8_t> data;
+	// -------------------------------------------------------------------
 
-	SUBCASE("empty")
+	SUBCASE("Value: 24")
 	{
-		data = serialize(map);
+		const int64_t fixint_p24 = 24;
+
+		object = {fixint_p24};
+		CHECK(object.is<int64_t>());
+
+		// Check serialized data
+
+		data = serialize(object);
 		CHECK(data.size() == 1);
-		CHECK((data[0] & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map);
-		CHECK((data[0] & Fixed_Map_Value) == 0);
 
-		Object object = deserialize(data);
-		CHECK(object.isMap() == true);
-		CHECK(object.asMap().size() == 0);
+		index = 0;
+		CHECK((data[index] & Fixed_Int_Pos_Mask) == (uint8_t)Format::Fixed_Int_Pos);
+		CHECK((data[index] & Fixed_Int_Pos_Value) == fixint_p24);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == fixint_p24);
 	}
 
-	SUBCASE("max")
+	// -------------------------------------------------------------------
+
+	SUBCASE("Value: -24")
 	{
-		size_t max = 15;
+		const int64_t fixint_n24 = -24;
 
-		for(size_t i = 0; i < max; i++)
-		{
-			// i          ==> 1 byte
-			// str(0-9)   ==> 2 bytes
-			// str(10-14) ==> 3 bytes
-			map.set(Object{int64_t(i)}, Object{std::to_string(i)});
-		}
+		object = {fixint_n24};
+		CHECK(object.is<int64_t>());
 
-		data = serialize(map);
-		CHECK(data.size() == 51);
-		CHECK((data[0] & Fixed_Map_Mask) == (uint8_t)Format::Fixed_Map);
-		CHECK((data[0] & Fixed_Map_Value) == max);
+		// Check serialized data
 
-		Object object = deserialize(data);
-		CHECK(object.isMap() == true);
-		CHECK(object.asMap().size() == max);
+		data = serialize(object);
+		CHECK(data.size() == 1);
 
-		for(size_t i = 0; i < max; i++)
-		{
-			Object key = Object{int64_t(i)};
-			CHECK(map.keyExists(key) == true);
-			
-			Object value = map.at(key);
-			CHECK(value.asString() == std::to_string(i));
-		}
+		index = 0;
+		CHECK((data[index] & Fixed_Int_Neg_Mask) == (uint8_t)Format::Fixed_Int_Neg);
+		CHECK(((data[index] & Fixed_Int_Neg_Value) - 32) == fixint_n24);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == fixint_n24);
 	}
 }
 
 
-TEST_CASE("serialize/map (map16)")
+TEST_CASE("serialize/object/int8")
 {
-	Map map;
+	Object               object;
 	std::vector<uint8_t> data;
+	size_t               index;
 
-	SUBCASE("min")
+	// Don't test the maximum Int8 value 127
+	// because that is handled by Fixed_Int_Pos
+
+	// -------------------------------------------------------------------
+
+	SUBCASE("Min")
 	{
-		const size_t min = 16;
+		const int64_t i8_min = std::numeric_limits<int8_t>::min();
 
-		for(size_t i = 0; i < min; i++)
-		{
-			map.set(Object{int64_t(i)}, Object{std::to_string(i)});
-		}
+		object = {i8_min};
+		CHECK(object.is<int64_t>());
 
-		data = serialize(map);
-		CHECK(data.size() == 57);
-		CHECK(data[0] == (uint8_t)Format::Map16);
-		Convert.uint64 = 0;
-		Convert_Byte1 = data[1];
-		Convert_Byte0 = data[2];
-		CHECK(Convert.uint16 == min);
+		// Check serialized data
 
-		Object object = deserialize(data);
-		CHECK(object.isMap() == true);
-		CHECK(object.asMap().size() == min);
+		data = serialize(object);
+		CHECK(data.size() == 2);
 
-		for(size_t i = 0; i < min; i++)
-		{
-			Object key = Object{int64_t(i)};
-			CHECK(map.keyExists(key) == true);
-			
-			Object value = map.at(key);
-			CHECK(value.asString() == std::to_string(i));
-		}
+		index = 0;
+		CHECK(data[index] == (uint8_t)Format::Int8);
+		index++;
+		CHECK((int8_t)data[index] == i8_min);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == i8_min);
 	}
 
-	SUBCASE("max")
+	// -------------------------------------------------------------------
+
+	SUBCASE("Value: -33")
 	{
-		const size_t max = std::numeric_limits<uint16_t>::max();
+		const int64_t i8_min = -33;
 
-		//printf("Generating %lu Map entries\n", max);
-		for(size_t i = 0; i < max; i++)
-		{
-			Object key = {int64_t(i)};
-			Object val = {std::to_string(i)};
-			map.set(std::move(key), std::move(val));
+		object = {i8_min};
+		CHECK(object.is<int64_t>());
 
-			//if(i % 1000 == 0) { printf("%lu/%lu\n", i, max); }
-		}
+		// Check serialized data
 
-		data = serialize(map);
-		CHECK(data.size() == 643986);
-		CHECK(data[0] == (uint8_t)Format::Map16);
-		Convert.uint64 = 0;
-		Convert_Byte1 = data[1];
-		Convert_Byte0 = data[2];
-		CHECK(Convert.uint16 == max);
+		data = serialize(object);
+		CHECK(data.size() == 2);
 
-		Object object = deserialize(data);
-		CHECK(object.isMap() == true);
-		CHECK(object.asMap().size() == max);
+		index = 0;
+		CHECK(data[index] == (uint8_t)Format::Int8);
+		index++;
+		CHECK((int8_t)data[index] == i8_min);
 
-		for(size_t i = 0; i < max; i++)
-		{
-			Object key = Object{int64_t(i)};
-			CHECK(map.keyExists(key) == true);
-			
-			Object value = map.at(key);
-			CHECK(value.asString() == std::to_string(i));
-		}
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == i8_min);
 	}
 }
 
 
-TEST_CASE("serialize/map (map32)")
+TEST_CASE("serialize/object/int16")
 {
-	Map map;
+	Object               object;
 	std::vector<uint8_t> data;
+	size_t               index;
 
-	SUBCASE("min")
+	// -------------------------------------------------------------------
+
+	SUBCASE("Min16")
 	{
-		const size_t min = std::numeric_limits<uint16_t>::max() + 1;
+		const int64_t i16_min = std::numeric_limits<int16_t>::min();
 
-		//printf("Generating %lu Map entries\n", min);
-		for(size_t i = 0; i < min; i++)
-		{
-			Object key = {int64_t(i)};
-			Object val = {std::to_string(i)};
-			map.set(std::move(key), std::move(val));
+		object = {i16_min};
+		CHECK(object.is<int64_t>());
 
-			//if(i % 1000 == 0) { printf("%lu/%lu\n", i, min); }
-		}
+		// Check serialized data
 
-		data = serialize(map);
-		CHECK(data.size() == 643999);
-		CHECK(data[0] == (uint8_t)Format::Map32);
-		Convert.uint64 = 0;
-		Convert_Byte3 = data[1];
-		Convert_Byte2 = data[2];
-		Convert_Byte1 = data[3];
-		Convert_Byte0 = data[4];
-		CHECK(Convert.uint32 == min);
+		data = serialize(object);
+		CHECK(data.size() == 3);
 
-		Object object = deserialize(data);
-		CHECK(object.isMap() == true);
-		CHECK(object.asMap().size() == min);
+		index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Int16);
 
-		for(size_t i = 0; i < min; i++)
-		{
-			Object key = Object{int64_t(i)};
-			CHECK(map.keyExists(key) == true);
-			
-			Object value = map.at(key);
-			CHECK(value.asString() == std::to_string(i));
-		}
+		CHECK(readBigEndian<int16_t>(data.data(), index) == i16_min);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == i16_min);
 	}
 
-#if 0 // Will use too much memory and take to long
-	SUBCASE("max")
+	// -------------------------------------------------------------------
+
+	SUBCASE("Min8-1")
 	{
-		const size_t max = std::numeric_limits<uint32_t>::max();
-		map.object_key.reserve(max);
-		map.object_value.reserve(max);
+		const int64_t i16_min = std::numeric_limits<int8_t>::min() - (int64_t)1;
 
-		printf("Generating %lu Map entries\n", max);
-		for(size_t i = 0; i < max; i++)
-		{
-			Object key = {int64_t(i)};
-			Object val = {std::to_string(i)};
-			map.set(std::move(key), std::move(val));
+		object = {i16_min};
+		CHECK(object.is<int64_t>());
 
-			if(i % 1000 == 0) { printf("%lu/%lu\n", i, max); }
-		}
+		// Check serialized data
 
-		data = serialize(map);
-		CHECK(data.size() == 0); // Unknown
-		CHECK(data[0] == (uint8_t)Format::Map32);
-		Convert.uint64 = 0;
-		Convert_Byte3 = data[1];
-		Convert_Byte2 = data[2];
-		Convert_Byte1 = data[3];
-		Convert_Byte0 = data[4];
-		CHECK(Convert.uint32 == max);
+		data = serialize(object);
+		CHECK(data.size() == 3);
 
-		Object object = deserialize(data);
-		CHECK(object.isMap() == true);
-		CHECK(object.asMap().size() == max);
+		index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Int16);
 
-		for(size_t i = 0; i < max; i++)
-		{
-			Object key = Object{int64_t(i)};
-			CHECK(map.keyExists(key) == true);
-			
-			Object value = map.at(key);
-			CHECK(value.asString() == std::to_string(i));
-		}
+		CHECK(readBigEndian<int16_t>(data.data(), index) == i16_min);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == i16_min);
 	}
-#endif
-}
-#endif // }}}
 
+	// -------------------------------------------------------------------
 
-/**
- * \brief Serialize Object data.
- *
- * The contents of the Object will be packed into the returned std::vector.
- *
- * \parcode
- * zakero::messagepack::Object object = { true };
- *
- * std::vector<uint8_t> result = zakero::messagepack::serialize(object);
- *
- * reply(host_ip, result);
- * \endparcode
- *
- * \return The packed data.
- */
-std::vector<uint8_t> serialize(const Object& object ///< The Object
-	) noexcept
-{
-	std::error_code error;
+	SUBCASE("Max16")
+	{
+		const int64_t i16_max = std::numeric_limits<int16_t>::max();
 
-	return serialize(object, error);
-}
+		object = {i16_max};
+		CHECK(object.is<int64_t>());
 
+		// Check serialized data
 
-/**
- * \brief Serialize Object data.
- *
- * The contents of the Object will be packed into the returned std::vector.
- *
- * \parcode
- * zakero::messagepack::Object object = { true };
- *
- * std::error_code error;
- * std::vector<uint8_t> result = zakero::messagepack::serialize(object, error);
- *
- * reply(host_ip, result);
- * \endparcode
- *
- * \return The packed data.
- */
-std::vector<uint8_t> serialize(const Object& object ///< The Object
-	, std::error_code&                   error  ///< The Error
-	) noexcept
-{
-	std::vector<uint8_t> vector;
+		data = serialize(object);
+		CHECK(data.size() == 3);
 
-	error = serialize_(object, vector);
+		index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Int16);
 
-	return vector;
-}
+		CHECK(readBigEndian<int16_t>(data.data(), index) == i16_max);
 
+		// Check deserialized data
 
-#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == i16_max);
+	}
 
-TEST_CASE("serialize/object/nill")
-{
-	Object object = {};
-	CHECK(object.isNull());
+	// -------------------------------------------------------------------
 
-	// Check serialized data
+	SUBCASE("Max8+1")
+	{
+		const int64_t i16_max = std::numeric_limits<int16_t>::max();
 
-	std::vector<uint8_t> data = serialize(object);
-	CHECK(data.size() == 1);
+		object = {i16_max};
+		CHECK(object.is<int64_t>());
 
-	// Check deserialized data
+		// Check serialized data
 
-	size_t index = 0;
-	CHECK(data[index] == (uint8_t)Format::Nill);
+		data = serialize(object);
+		CHECK(data.size() == 3);
 
-	object = deserialize(data);
-	CHECK(object.isNull());
+		index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Int16);
+
+		CHECK(readBigEndian<int16_t>(data.data(), index) == i16_max);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == i16_max);
+	}
 }
 
 
-TEST_CASE("serialize/object/bool")
+TEST_CASE("serialize/object/int32")
 {
 	Object               object;
 	std::vector<uint8_t> data;
-	size_t               index = 0;
+	size_t               index;
 
-	SUBCASE("True")
+	// -------------------------------------------------------------------
+
+	SUBCASE("Min32")
 	{
-		object = {true};
-		CHECK(object.is<bool>());
+		const int64_t i32_min = std::numeric_limits<int32_t>::min();
+
+		object = {i32_min};
+		CHECK(object.is<int64_t>());
+
+		// Check serialized data
+
+		data = serialize(object);
+		CHECK(data.size() == 5);
+
+		index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Int32);
+
+		CHECK(readBigEndian<int32_t>(data.data(), index) == i32_min);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == i32_min);
+	}
+
+	// -------------------------------------------------------------------
+
+	SUBCASE("Min16-1")
+	{
+		const int64_t i32_min = std::numeric_limits<int16_t>::min() - (int64_t)1;
+
+		object = {i32_min};
+		CHECK(object.is<int64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 1);
+		CHECK(data.size() == 5);
 
 		index = 0;
-		CHECK(data[index] == (uint8_t)Format::True);
+		CHECK(data[index++] == (uint8_t)Format::Int32);
+
+		CHECK(readBigEndian<int32_t>(data.data(), index) == i32_min);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<bool>());
-		CHECK(object.as<bool>() == true);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == i32_min);
 	}
 
-	SUBCASE("False")
+	// -------------------------------------------------------------------
+
+	SUBCASE("Max32")
 	{
-		object = {false};
-		CHECK(object.is<bool>());
+		const int64_t i32_max = std::numeric_limits<int32_t>::max();
+
+		object = {i32_max};
+		CHECK(object.is<int64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 1);
+		CHECK(data.size() == 5);
+
 		index = 0;
-		CHECK(data[index] == (uint8_t)Format::False);
+		CHECK(data[index++] == (uint8_t)Format::Int32);
+
+		CHECK(readBigEndian<int32_t>(data.data(), index) == i32_max);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<bool>());
-		CHECK(object.as<bool>() == false);
+		CHECK(object.is<int64_t>());
+		CHECK(object.as<int64_t>() == i32_max);
 	}
-}
-
-
-TEST_CASE("serialize/object/fixed_int")
-{
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Zero")
+	SUBCASE("Max16+1")
 	{
-		const int64_t fixint_zero = 0;
+		const int64_t i32_max = std::numeric_limits<int16_t>::max() + 1;
 
-		object = {fixint_zero};
+		object = {i32_max};
 		CHECK(object.is<int64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 1);
+		CHECK(data.size() == 5);
 
 		index = 0;
-		CHECK((data[index] & Fixed_Int_Pos_Mask) == (uint8_t)Format::Fixed_Int_Pos);
-		CHECK((data[index] & Fixed_Int_Pos_Value) == fixint_zero);
+		CHECK(data[index++] == (uint8_t)Format::Int32);
+
+		CHECK(readBigEndian<int32_t>(data.data(), index) == i32_max);
 
 		// Check deserialized data
 
 		object = deserialize(data);
 		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == fixint_zero);
+		CHECK(object.as<int64_t>() == i32_max);
 	}
+}
+
+
+TEST_CASE("serialize/object/int64")
+{
+	Object               object;
+	std::vector<uint8_t> data;
+	size_t               index;
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Max")
+	SUBCASE("Min64")
 	{
-		const int64_t fixint_max = 127;
+		const int64_t i64_min = std::numeric_limits<int64_t>::min();
 
-		object = {fixint_max};
+		object = {i64_min};
 		CHECK(object.is<int64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 1);
+		CHECK(data.size() == 9);
 
 		index = 0;
-		CHECK((data[index] & Fixed_Int_Pos_Mask) == (uint8_t)Format::Fixed_Int_Pos);
-		CHECK((data[index] & Fixed_Int_Pos_Value) == fixint_max);
+		CHECK(data[index++] == (uint8_t)Format::Int64);
+
+		CHECK(readBigEndian<int64_t>(data.data(), index) == i64_min);
 
 		// Check deserialized data
 
 		object = deserialize(data);
 		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == fixint_max);
+		CHECK(object.as<int64_t>() == i64_min);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Min")
+	SUBCASE("Min32-1")
 	{
-		const int64_t fixint_min = -32;
+		const int64_t i64_min = std::numeric_limits<int32_t>::min() - (int64_t)1;
 
-		object = {fixint_min};
+		object = {i64_min};
 		CHECK(object.is<int64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 1);
+		CHECK(data.size() == 9);
 
 		index = 0;
-		CHECK((data[index] & Fixed_Int_Neg_Mask) == (uint8_t)Format::Fixed_Int_Neg);
-		CHECK(((data[index] & Fixed_Int_Neg_Value) - 32) == fixint_min);
+		CHECK(data[index++] == (uint8_t)Format::Int64);
+
+		CHECK(readBigEndian<int64_t>(data.data(), index) == i64_min);
 
 		// Check deserialized data
 
 		object = deserialize(data);
 		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == fixint_min);
+		CHECK(object.as<int64_t>() == i64_min);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Value: 24")
+	SUBCASE("Max64")
 	{
-		const int64_t fixint_p24 = 24;
+		const int64_t i64_max = std::numeric_limits<int64_t>::max();
 
-		object = {fixint_p24};
+		object = {i64_max};
 		CHECK(object.is<int64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 1);
+		CHECK(data.size() == 9);
 
 		index = 0;
-		CHECK((data[index] & Fixed_Int_Pos_Mask) == (uint8_t)Format::Fixed_Int_Pos);
-		CHECK((data[index] & Fixed_Int_Pos_Value) == fixint_p24);
+		CHECK(data[index++] == (uint8_t)Format::Int64);
+
+		CHECK(readBigEndian<int64_t>(data.data(), index) == i64_max);
 
 		// Check deserialized data
 
 		object = deserialize(data);
 		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == fixint_p24);
+		CHECK(object.as<int64_t>() == i64_max);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Value: -24")
+	SUBCASE("Max32+1")
 	{
-		const int64_t fixint_n24 = -24;
+		const int64_t i64_max = std::numeric_limits<int32_t>::max() + (int64_t)1;
 
-		object = {fixint_n24};
+		object = {i64_max};
 		CHECK(object.is<int64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 1);
+		CHECK(data.size() == 9);
 
 		index = 0;
-		CHECK((data[index] & Fixed_Int_Neg_Mask) == (uint8_t)Format::Fixed_Int_Neg);
-		CHECK(((data[index] & Fixed_Int_Neg_Value) - 32) == fixint_n24);
+		CHECK(data[index++] == (uint8_t)Format::Int64);
+
+		CHECK(readBigEndian<int64_t>(data.data(), index) == i64_max);
 
 		// Check deserialized data
 
 		object = deserialize(data);
 		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == fixint_n24);
+		CHECK(object.as<int64_t>() == i64_max);
 	}
 }
 
 
-TEST_CASE("serialize/object/int8")
+TEST_CASE("serialize/object/uint8")
 {
 	Object               object;
 	std::vector<uint8_t> data;
 	size_t               index;
 
-	// Don't test the maximum Int8 value 127
-	// because that is handled by Fixed_Int_Pos
-
 	// -------------------------------------------------------------------
 
 	SUBCASE("Min")
 	{
-		const int64_t i8_min = std::numeric_limits<int8_t>::min();
+		const uint64_t u8_min = 0;
 
-		object = {i8_min};
-		CHECK(object.is<int64_t>());
+		object = {u8_min};
+		CHECK(object.is<uint64_t>());
 
 		// Check serialized data
 
@@ -8678,25 +23529,24 @@ TEST_CASE("serialize/object/int8")
 		CHECK(data.size() == 2);
 
 		index = 0;
-		CHECK(data[index] == (uint8_t)Format::Int8);
-		index++;
-		CHECK((int8_t)data[index] == i8_min);
+		CHECK(data[index++] == (uint8_t)Format::Uint8);
+		CHECK(data[index++] == u8_min);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i8_min);
+		CHECK(object.is<uint64_t>());
+		CHECK(object.as<uint64_t>() == u8_min);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Value: -33")
+	SUBCASE("Max")
 	{
-		const int64_t i8_min = -33;
+		const uint64_t u8_max = std::numeric_limits<uint8_t>::max();
 
-		object = {i8_min};
-		CHECK(object.is<int64_t>());
+		object = {u8_max};
+		CHECK(object.is<uint64_t>());
 
 		// Check serialized data
 
@@ -8704,20 +23554,19 @@ TEST_CASE("serialize/object/int8")
 		CHECK(data.size() == 2);
 
 		index = 0;
-		CHECK(data[index] == (uint8_t)Format::Int8);
-		index++;
-		CHECK((int8_t)data[index] == i8_min);
+		CHECK(data[index++] == (uint8_t)Format::Uint8);
+		CHECK(data[index++] == u8_max);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i8_min);
+		CHECK(object.is<uint64_t>());
+		CHECK(object.as<uint64_t>() == u8_max);
 	}
 }
 
 
-TEST_CASE("serialize/object/int16")
+TEST_CASE("serialize/object/uint16")
 {
 	Object               object;
 	std::vector<uint8_t> data;
@@ -8725,12 +23574,12 @@ TEST_CASE("serialize/object/int16")
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Min16")
+	SUBCASE("Min")
 	{
-		const int64_t i16_min = std::numeric_limits<int16_t>::min();
+		const uint64_t u16_min = std::numeric_limits<uint8_t>::max() + (uint64_t)1;
 
-		object = {i16_min};
-		CHECK(object.is<int64_t>());
+		object = {u16_min};
+		CHECK(object.is<uint64_t>());
 
 		// Check serialized data
 
@@ -8738,28 +23587,24 @@ TEST_CASE("serialize/object/int16")
 		CHECK(data.size() == 3);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int16);
-
-		Convert.uint64 = 0;
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int16 == i16_min);
+		CHECK(data[index++] == (uint8_t)Format::Uint16);
+		CHECK(readBigEndian<uint16_t>(data.data(), index) == u16_min);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i16_min);
+		CHECK(object.is<uint64_t>());
+		CHECK(object.as<uint64_t>() == u16_min);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Min8-1")
+	SUBCASE("Max")
 	{
-		const int64_t i16_min = std::numeric_limits<int8_t>::min() - (int64_t)1;
+		const uint64_t u16_max = std::numeric_limits<uint16_t>::max();
 
-		object = {i16_min};
-		CHECK(object.is<int64_t>());
+		object = {u16_max};
+		CHECK(object.is<uint64_t>());
 
 		// Check serialized data
 
@@ -8767,125 +23612,148 @@ TEST_CASE("serialize/object/int16")
 		CHECK(data.size() == 3);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int16);
-
-		Convert.uint64 = 0;
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int16 == i16_min);
+		CHECK(data[index++] == (uint8_t)Format::Uint16);
+		CHECK(readBigEndian<uint16_t>(data.data(), index) == u16_max);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i16_min);
+		CHECK(object.is<uint64_t>());
+		CHECK(object.as<uint64_t>() == u16_max);
 	}
+}
+
+
+TEST_CASE("serialize/object/uint32")
+{
+	Object               object;
+	std::vector<uint8_t> data;
+	size_t               index;
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Max16")
+	SUBCASE("Min")
 	{
-		const int64_t i16_max = std::numeric_limits<int16_t>::max();
+		const uint64_t u32_min = std::numeric_limits<uint16_t>::max() + (uint64_t)1;
 
-		object = {i16_max};
-		CHECK(object.is<int64_t>());
+		object = {u32_min};
+		CHECK(object.is<uint64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 3);
+		CHECK(data.size() == 5);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int16);
-
-		Convert.uint64 = 0;
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int16 == i16_max);
+		CHECK(data[index++] == (uint8_t)Format::Uint32);
+		CHECK(readBigEndian<uint32_t>(data.data(), index) == u32_min);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i16_max);
+		CHECK(object.is<uint64_t>());
+		CHECK(object.as<uint64_t>() == u32_min);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Max8+1")
+	SUBCASE("Max")
 	{
-		const int64_t i16_max = std::numeric_limits<int16_t>::max();
+		const uint64_t u32_max = std::numeric_limits<uint32_t>::max();
 
-		object = {i16_max};
-		CHECK(object.is<int64_t>());
+		object = {u32_max};
+		CHECK(object.is<uint64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 3);
+		CHECK(data.size() == 5);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int16);
+		CHECK(data[index++] == (uint8_t)Format::Uint32);
+		CHECK(readBigEndian<uint32_t>(data.data(), index) == u32_max);
+
+		// Check deserialized data
+
+		object = deserialize(data);
+		CHECK(object.is<uint64_t>());
+		CHECK(object.as<uint64_t>() == u32_max);
+	}
+}
+
+
+TEST_CASE("serialize/object/uint64")
+{
+	Object               object;
+	std::vector<uint8_t> data;
+	size_t               index;
+
+	// -------------------------------------------------------------------
+
+	SUBCASE("Min")
+	{
+		const uint64_t u64_min = std::numeric_limits<uint32_t>::max() + (uint64_t)1;
+
+		object = {u64_min};
+		CHECK(object.is<uint64_t>());
+
+		// Check serialized data
+
+		data = serialize(object);
+		CHECK(data.size() == 9);
 
-		Convert.uint64 = 0;
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int16 == i16_max);
+		index = 0;
+		CHECK(data[index++] == (uint8_t)Format::Uint64);
+		CHECK(readBigEndian<uint64_t>(data.data(), index) == u64_min);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i16_max);
+		CHECK(object.is<uint64_t>());
+		CHECK(object.as<uint64_t>() == u64_min);
 	}
-}
-
-
-TEST_CASE("serialize/object/int32")
-{
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Min32")
+	SUBCASE("Max")
 	{
-		const int64_t i32_min = std::numeric_limits<int32_t>::min();
+		const uint64_t u64_max = std::numeric_limits<uint64_t>::max();
 
-		object = {i32_min};
-		CHECK(object.is<int64_t>());
+		object = {u64_max};
+		CHECK(object.is<uint64_t>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 5);
+		CHECK(data.size() == 9);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int32);
-
-		Convert.uint64 = 0;
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int32 == i32_min);
+		CHECK(data[index++] == (uint8_t)Format::Uint64);
+		CHECK(readBigEndian<uint64_t>(data.data(), index) == u64_max);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i32_min);
+		CHECK(object.is<uint64_t>());
+		CHECK(object.as<uint64_t>() == u64_max);
 	}
+}
+
+
+TEST_CASE("serialize/object/float32")
+{
+	Object               object;
+	std::vector<uint8_t> data;
+	size_t               index;
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Min16-1")
+	SUBCASE("Zero")
 	{
-		const int64_t i32_min = std::numeric_limits<int16_t>::min() - (int64_t)1;
+		const float f32_zero = 0;
 
-		object = {i32_min};
-		CHECK(object.is<int64_t>());
+		object = {f32_zero};
+		CHECK(object.is<float>());
 
 		// Check serialized data
 
@@ -8893,30 +23761,24 @@ TEST_CASE("serialize/object/int32")
 		CHECK(data.size() == 5);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int32);
-
-		Convert.uint64 = 0;
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int32 == i32_min);
+		CHECK(data[index++] == (uint8_t)Format::Float32);
+		CHECK(readBigEndian<float>(data.data(), index) == f32_zero);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i32_min);
+		CHECK(object.is<float>());
+		CHECK(object.as<float>() == f32_zero);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Max32")
+	SUBCASE("Min")
 	{
-		const int64_t i32_max = std::numeric_limits<int32_t>::max();
+		const float f32_min = std::numeric_limits<float>::min();
 
-		object = {i32_max};
-		CHECK(object.is<int64_t>());
+		object = {f32_min};
+		CHECK(object.is<float>());
 
 		// Check serialized data
 
@@ -8924,30 +23786,24 @@ TEST_CASE("serialize/object/int32")
 		CHECK(data.size() == 5);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int32);
-
-		Convert.uint64 = 0;
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int32 == i32_max);
+		CHECK(data[index++] == (uint8_t)Format::Float32);
+		CHECK(readBigEndian<float>(data.data(), index) == f32_min);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i32_max);
+		CHECK(object.is<float>());
+		CHECK(object.as<float>() == f32_min);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Max16+1")
+	SUBCASE("Max")
 	{
-		const int64_t i32_max = std::numeric_limits<int16_t>::max() + 1;
+		const float f32_max = std::numeric_limits<float>::max();
 
-		object = {i32_max};
-		CHECK(object.is<int64_t>());
+		object = {f32_max};
+		CHECK(object.is<float>());
 
 		// Check serialized data
 
@@ -8955,25 +23811,19 @@ TEST_CASE("serialize/object/int32")
 		CHECK(data.size() == 5);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int32);
-
-		Convert.uint64 = 0;
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int32 == i32_max);
+		CHECK(data[index++] == (uint8_t)Format::Float32);
+		CHECK(readBigEndian<float>(data.data(), index) == f32_max);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i32_max);
+		CHECK(object.is<float>());
+		CHECK(object.as<float>() == f32_max);
 	}
 }
 
 
-TEST_CASE("serialize/object/int64")
+TEST_CASE("serialize/object/float64")
 {
 	Object               object;
 	std::vector<uint8_t> data;
@@ -8981,12 +23831,12 @@ TEST_CASE("serialize/object/int64")
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Min64")
+	SUBCASE("Zero")
 	{
-		const int64_t i64_min = std::numeric_limits<int64_t>::min();
+		const double f64_zero = 0;
 
-		object = {i64_min};
-		CHECK(object.is<int64_t>());
+		object = {f64_zero};
+		CHECK(object.is<double>());
 
 		// Check serialized data
 
@@ -8994,34 +23844,24 @@ TEST_CASE("serialize/object/int64")
 		CHECK(data.size() == 9);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int64);
-
-		Convert.uint64 = 0;
-		Convert_Byte7 = data[index++];
-		Convert_Byte6 = data[index++];
-		Convert_Byte5 = data[index++];
-		Convert_Byte4 = data[index++];
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int64 == i64_min);
+		CHECK(data[index++] == (uint8_t)Format::Float64);
+		CHECK(readBigEndian<double>(data.data(), index) == f64_zero);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i64_min);
+		CHECK(object.is<double>());
+		CHECK(object.as<double>() == f64_zero);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Min32-1")
+	SUBCASE("Min")
 	{
-		const int64_t i64_min = std::numeric_limits<int32_t>::min() - (int64_t)1;
+		const double f64_min = std::numeric_limits<double>::min();
 
-		object = {i64_min};
-		CHECK(object.is<int64_t>());
+		object = {f64_min};
+		CHECK(object.is<double>());
 
 		// Check serialized data
 
@@ -9029,34 +23869,24 @@ TEST_CASE("serialize/object/int64")
 		CHECK(data.size() == 9);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int64);
-
-		Convert.uint64 = 0;
-		Convert_Byte7 = data[index++];
-		Convert_Byte6 = data[index++];
-		Convert_Byte5 = data[index++];
-		Convert_Byte4 = data[index++];
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int64 == i64_min);
+		CHECK(data[index++] == (uint8_t)Format::Float64);
+		CHECK(readBigEndian<double>(data.data(), index) == f64_min);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i64_min);
+		CHECK(object.is<double>());
+		CHECK(object.as<double>() == f64_min);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Max64")
+	SUBCASE("Max")
 	{
-		const int64_t i64_max = std::numeric_limits<int64_t>::max();
+		const double f64_max = std::numeric_limits<double>::max();
 
-		object = {i64_max};
-		CHECK(object.is<int64_t>());
+		object = {f64_max};
+		CHECK(object.is<double>());
 
 		// Check serialized data
 
@@ -9064,540 +23894,525 @@ TEST_CASE("serialize/object/int64")
 		CHECK(data.size() == 9);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int64);
-
-		Convert.uint64 = 0;
-		Convert_Byte7 = data[index++];
-		Convert_Byte6 = data[index++];
-		Convert_Byte5 = data[index++];
-		Convert_Byte4 = data[index++];
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int64 == i64_max);
+		CHECK(data[index++] == (uint8_t)Format::Float64);
+		CHECK(readBigEndian<double>(data.data(), index) == f64_max);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i64_max);
+		CHECK(object.is<double>());
+		CHECK(object.as<double>() == f64_max);
 	}
+}
+
+
+TEST_CASE("serialize/object/fixed_str")
+{
+	Object               object;
+	std::vector<uint8_t> data;
+	size_t               index;
+	size_t               str_len;
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Max32+1")
+	SUBCASE("Empty")
 	{
-		const int64_t i64_max = std::numeric_limits<int32_t>::max() + (int64_t)1;
+		const std::pmr::string string;
 
-		object = {i64_max};
-		CHECK(object.is<int64_t>());
+		object = {string};
+		CHECK(object.is<std::pmr::string>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 9);
+		CHECK(data.size() == 1);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Int64);
-
-		Convert.uint64 = 0;
-		Convert_Byte7 = data[index++];
-		Convert_Byte6 = data[index++];
-		Convert_Byte5 = data[index++];
-		Convert_Byte4 = data[index++];
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.int64 == i64_max);
+		CHECK((data[index] & Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str);
+		str_len = data[index] & Fixed_Str_Value;
+		CHECK(str_len == string.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<int64_t>());
-		CHECK(object.as<int64_t>() == i64_max);
+		CHECK(object.is<std::pmr::string>());
+		CHECK(object.as<std::pmr::string>() == string);
 	}
-}
-
-
-TEST_CASE("serialize/object/uint8")
-{
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Min")
+	SUBCASE("Len_1")
 	{
-		const uint64_t u8_min = 0;
+		const std::pmr::string string(1, '_');
 
-		object = {u8_min};
-		CHECK(object.is<uint64_t>());
+		object = {string};
+		CHECK(object.is<std::pmr::string>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 2);
+		CHECK(data.size() == string.size() + 1);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Uint8);
-		CHECK(data[index++] == u8_min);
+		CHECK((data[index] & Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str);
+		str_len = data[index] & Fixed_Str_Value;
+		CHECK(str_len == string.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<uint64_t>());
-		CHECK(object.as<uint64_t>() == u8_min);
+		CHECK(object.is<std::pmr::string>());
+		CHECK(object.as<std::pmr::string>() == string);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Max")
+	SUBCASE("Len_31")
 	{
-		const uint64_t u8_max = std::numeric_limits<uint8_t>::max();
+		const std::pmr::string string(31, 'X');
 
-		object = {u8_max};
-		CHECK(object.is<uint64_t>());
+		object = {string};
+		CHECK(object.is<std::pmr::string>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 2);
+		CHECK(data.size() == string.size() + 1);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Uint8);
-		CHECK(data[index++] == u8_max);
+		CHECK((data[index] & Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str);
+		str_len = data[index] & Fixed_Str_Value;
+		CHECK(str_len == string.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<uint64_t>());
-		CHECK(object.as<uint64_t>() == u8_max);
+		CHECK(object.is<std::pmr::string>());
+		CHECK(object.as<std::pmr::string>() == string);
 	}
 }
 
 
-TEST_CASE("serialize/object/uint16")
+TEST_CASE("serialize/object/str8")
 {
 	Object               object;
 	std::vector<uint8_t> data;
 	size_t               index;
+	size_t               str_len;
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Min")
 	{
-		const uint64_t u16_min = std::numeric_limits<uint8_t>::max() + (uint64_t)1;
+		const std::pmr::string string(32, '_');
 
-		object = {u16_min};
-		CHECK(object.is<uint64_t>());
+		object = {string};
+		CHECK(object.is<std::pmr::string>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 3);
+		CHECK(data.size() == string.size() + 2);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Uint16);
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint16 == u16_min);
+		CHECK(data[index++] == (uint8_t)Format::Str8);
+		str_len = data[index++];
+		CHECK(str_len == string.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<uint64_t>());
-		CHECK(object.as<uint64_t>() == u16_min);
+		CHECK(object.is<std::pmr::string>());
+		CHECK(object.as<std::pmr::string>() == string);
 	}
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Max")
 	{
-		const uint64_t u16_max = std::numeric_limits<uint16_t>::max();
+		const std::pmr::string string(std::numeric_limits<uint8_t>::max(), 'X');
 
-		object = {u16_max};
-		CHECK(object.is<uint64_t>());
+		object = {string};
+		CHECK(object.is<std::pmr::string>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 3);
+		CHECK(data.size() == (string.size() + 2));
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Uint16);
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint16 == u16_max);
+		CHECK(data[index++] == (uint8_t)Format::Str8);
+		str_len = data[index++];
+		CHECK(str_len == string.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<uint64_t>());
-		CHECK(object.as<uint64_t>() == u16_max);
+		CHECK(object.is<std::pmr::string>());
+		CHECK(object.as<std::pmr::string>() == string);
 	}
 }
 
 
-TEST_CASE("serialize/object/uint32")
+TEST_CASE("serialize/object/str16")
 {
 	Object               object;
 	std::vector<uint8_t> data;
 	size_t               index;
+	size_t               str_len;
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Min")
 	{
-		const uint64_t u32_min = std::numeric_limits<uint16_t>::max() + (uint64_t)1;
+		const std::pmr::string string(std::numeric_limits<uint8_t>::max() + 1, '_');
 
-		object = {u32_min};
-		CHECK(object.is<uint64_t>());
+		object = {string};
+		CHECK(object.is<std::pmr::string>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 5);
+		CHECK(data.size() == string.size() + 3);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Uint32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint32 == u32_min);
+		CHECK(data[index++] == (uint8_t)Format::Str16);
+		str_len = readBigEndian<uint16_t>(data.data(), index);
+		CHECK(str_len == string.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<uint64_t>());
-		CHECK(object.as<uint64_t>() == u32_min);
+		CHECK(object.is<std::pmr::string>());
+		CHECK(object.as<std::pmr::string>() == string);
 	}
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Max")
 	{
-		const uint64_t u32_max = std::numeric_limits<uint32_t>::max();
+		const std::pmr::string string(std::numeric_limits<uint16_t>::max(), 'X');
 
-		object = {u32_max};
-		CHECK(object.is<uint64_t>());
+		object = {string};
+		CHECK(object.is<std::pmr::string>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 5);
+		CHECK(data.size() == (string.size() + 3));
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Uint32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint32 == u32_max);
+		CHECK(data[index++] == (uint8_t)Format::Str16);
+		str_len = readBigEndian<uint16_t>(data.data(), index);
+		CHECK(str_len == string.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<uint64_t>());
-		CHECK(object.as<uint64_t>() == u32_max);
+		CHECK(object.is<std::pmr::string>());
+		CHECK(object.as<std::pmr::string>() == string);
 	}
 }
 
 
-TEST_CASE("serialize/object/uint64")
+TEST_CASE("serialize/object/str32")
 {
 	Object               object;
 	std::vector<uint8_t> data;
 	size_t               index;
+	size_t               str_len;
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Min")
 	{
-		const uint64_t u64_min = std::numeric_limits<uint32_t>::max() + (uint64_t)1;
+		const std::pmr::string string(std::numeric_limits<uint16_t>::max() + 1, '_');
 
-		object = {u64_min};
-		CHECK(object.is<uint64_t>());
+		object = {string};
+		CHECK(object.is<std::pmr::string>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 9);
+		CHECK(data.size() == string.size() + 5);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Uint64);
-		Convert_Byte7 = data[index++];
-		Convert_Byte6 = data[index++];
-		Convert_Byte5 = data[index++];
-		Convert_Byte4 = data[index++];
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint64 == u64_min);
+		CHECK(data[index++] == (uint8_t)Format::Str32);
+		str_len = readBigEndian<uint32_t>(data.data(), index);
+		CHECK(str_len == string.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<uint64_t>());
-		CHECK(object.as<uint64_t>() == u64_min);
+		CHECK(object.is<std::pmr::string>());
+		CHECK(object.as<std::pmr::string>() == string);
 	}
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Max")
 	{
-		const uint64_t u64_max = std::numeric_limits<uint64_t>::max();
+		/*
+		 * This string would be 4GB + overhead from std::string
+		 * Serializing would consume another 4GB.
+		 * For a total of 8GB to test the maximum Str32 length.
+		const std::pmr::string string(std::numeric_limits<uint32_t>::max(), 'X');
 
-		object = {u64_max};
-		CHECK(object.is<uint64_t>());
+		object = {string};
+		CHECK(object.is<std::pmr::string>());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 9);
+		CHECK(data.size() == (string.size() + 3));
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Uint64);
-		Convert_Byte7 = data[index++];
-		Convert_Byte6 = data[index++];
-		Convert_Byte5 = data[index++];
-		Convert_Byte4 = data[index++];
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.uint64 == u64_max);
+		CHECK(data[index++] == (uint8_t)Format::Str32);
+		str_len = readBigEndian<uint32_t>(data.data(), index);
+		CHECK(str_len == string.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<uint64_t>());
-		CHECK(object.as<uint64_t>() == u64_max);
+		CHECK(object.is<std::pmr::string>());
+		CHECK(object.as<std::pmr::string>() == string);
+		 */
 	}
 }
 
 
-TEST_CASE("serialize/object/float32")
+TEST_CASE("serialize/object/bin8")
 {
 	Object               object;
 	std::vector<uint8_t> data;
 	size_t               index;
+	size_t               bin_len;
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Zero")
+	SUBCASE("Min")
 	{
-		const float f32_zero = 0;
+		const std::pmr::vector<uint8_t> bin = {};
 
-		object = {f32_zero};
-		CHECK(object.is<float>());
+		object = {bin};
+		CHECK(object.isBinary());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 5);
+		CHECK(data.size() == bin.size() + 2);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Float32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.float32 == f32_zero);
+		CHECK(data[index++] == (uint8_t)Format::Bin8);
+		bin_len = data[index++];
+		CHECK(bin_len == bin.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<float>());
-		CHECK(object.as<float>() == f32_zero);
+		CHECK(object.isBinary());
+
+		const std::pmr::vector<uint8_t>& vector = object.asBinary();
+		for(size_t i = 0; i < bin_len; i++)
+		{
+			CHECK(vector[i] == bin[i]);
+		}
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Min")
+	SUBCASE("Max")
 	{
-		const float f32_min = std::numeric_limits<float>::min();
+		const std::pmr::vector<uint8_t> bin(std::numeric_limits<uint8_t>::max(), 'X');
 
-		object = {f32_min};
-		CHECK(object.is<float>());
+		object = {bin};
+		CHECK(object.isBinary());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 5);
+		CHECK(data.size() == bin.size() + 2);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Float32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.float32 == f32_min);
+		CHECK(data[index++] == (uint8_t)Format::Bin8);
+		bin_len = data[index++];
+		CHECK(bin_len == bin.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<float>());
-		CHECK(object.as<float>() == f32_min);
+		CHECK(object.isBinary());
+
+		const std::pmr::vector<uint8_t>& vector = object.asBinary();
+		for(size_t i = 0; i < bin_len; i++)
+		{
+			CHECK(vector[i] == bin[i]);
+		}
 	}
+}
+
+
+TEST_CASE("serialize/object/bin16")
+{
+	Object               object;
+	std::vector<uint8_t> data;
+	size_t               index;
+	size_t               bin_len;
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Max")
+	SUBCASE("Min")
 	{
-		const float f32_max = std::numeric_limits<float>::max();
+		const std::pmr::vector<uint8_t> bin(std::numeric_limits<uint8_t>::max() + 1, '_');
 
-		object = {f32_max};
-		CHECK(object.is<float>());
+		object = {bin};
+		CHECK(object.isBinary());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 5);
+		CHECK(data.size() == bin.size() + 3);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Float32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.float32 == f32_max);
+		CHECK(data[index++] == (uint8_t)Format::Bin16);
+		bin_len = readBigEndian<uint16_t>(data.data(), index);
+		CHECK(bin_len == bin.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<float>());
-		CHECK(object.as<float>() == f32_max);
-	}
-}
-
+		CHECK(object.isBinary());
 
-TEST_CASE("serialize/object/float64")
-{
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
+		const std::pmr::vector<uint8_t>& vector = object.asBinary();
+		for(size_t i = 0; i < bin_len; i++)
+		{
+			CHECK(vector[i] == bin[i]);
+		}
+	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Zero")
+	SUBCASE("Max")
 	{
-		const double f64_zero = 0;
+		const std::pmr::vector<uint8_t> bin(std::numeric_limits<uint16_t>::max(), 'X');
 
-		object = {f64_zero};
-		CHECK(object.is<double>());
+		object = {bin};
+		CHECK(object.isBinary());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 9);
+		CHECK(data.size() == bin.size() + 3);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Float64);
-		Convert_Byte7 = data[index++];
-		Convert_Byte6 = data[index++];
-		Convert_Byte5 = data[index++];
-		Convert_Byte4 = data[index++];
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.float64 == f64_zero);
+		CHECK(data[index++] == (uint8_t)Format::Bin16);
+		bin_len = readBigEndian<uint16_t>(data.data(), index);
+		CHECK(bin_len == bin.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<double>());
-		CHECK(object.as<double>() == f64_zero);
+		CHECK(object.isBinary());
+
+		const std::pmr::vector<uint8_t>& vector = object.asBinary();
+		for(size_t i = 0; i < bin_len; i++)
+		{
+			CHECK(vector[i] == bin[i]);
+		}
 	}
+}
+
+
+TEST_CASE("serialize/object/bin32")
+{
+	Object               object;
+	std::vector<uint8_t> data;
+	size_t               index;
+	size_t               bin_len;
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Min")
 	{
-		const double f64_min = std::numeric_limits<double>::min();
+		const std::pmr::vector<uint8_t> bin(std::numeric_limits<uint16_t>::max() + 1, '_');
 
-		object = {f64_min};
-		CHECK(object.is<double>());
+		object = {bin};
+		CHECK(object.isBinary());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 9);
+		CHECK(data.size() == bin.size() + 5);
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Float64);
-		Convert_Byte7 = data[index++];
-		Convert_Byte6 = data[index++];
-		Convert_Byte5 = data[index++];
-		Convert_Byte4 = data[index++];
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.float64 == f64_min);
+		CHECK(data[index++] == (uint8_t)Format::Bin32);
+		bin_len = readBigEndian<uint32_t>(data.data(), index);
+		CHECK(bin_len == bin.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<double>());
-		CHECK(object.as<double>() == f64_min);
+		CHECK(object.isBinary());
+
+		const std::pmr::vector<uint8_t>& vector = object.asBinary();
+		for(size_t i = 0; i < bin_len; i++)
+		{
+			CHECK(vector[i] == bin[i]);
+		}
 	}
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Max")
 	{
-		const double f64_max = std::numeric_limits<double>::max();
+		/*
+		 * This vector would be 4GB + overhead from std::vector
+		 * Serializing would consume another 4GB.
+		 * For a total of 8GB to test the maximum Str32 length.
+		const std::vector<uint8_t> bin(std::numeric_limits<uint32_t>::max(), 'X');
 
-		object = {f64_max};
-		CHECK(object.is<double>());
+		object = {bin};
+		CHECK(object.isBinary());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == 9);
+		CHECK(data.size() == (bin.size() + 5));
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Float64);
-		Convert_Byte7 = data[index++];
-		Convert_Byte6 = data[index++];
-		Convert_Byte5 = data[index++];
-		Convert_Byte4 = data[index++];
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		CHECK(Convert.float64 == f64_max);
+		CHECK(data[index++] == (uint8_t)Format::Bin32);
+		bin_len = readBigEndian<uint32_t>(data.data(), index);
+		CHECK(bin_len == bin.size());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<double>());
-		CHECK(object.as<double>() == f64_max);
+		CHECK(object.isBinary());
+
+		const std::pmr::vector<uint8_t>& vector = object.asBinary();
+		for(size_t i = 0; i < bin_len; i++)
+		{
+			CHECK(vector[i] == bin[i]);
+		}
+		 */
 	}
 }
 
 
-TEST_CASE("serialize/object/fixed_str")
+TEST_CASE("serialize/object/fixed_array")
 {
 	Object               object;
 	std::vector<uint8_t> data;
 	size_t               index;
-	size_t               str_len;
+	size_t               array_len;
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Empty")
 	{
-		const std::string string;
-
-		object = {string};
-		CHECK(object.is<std::string>());
+		object = {Array{}};
+		CHECK(object.isArray());
+		CHECK(object.asArray().size() == 0);
 
 		// Check serialized data
 
@@ -9605,761 +24420,1216 @@ TEST_CASE("serialize/object/fixed_str")
 		CHECK(data.size() == 1);
 
 		index = 0;
-		CHECK((data[index] & Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str);
-		str_len = data[index] & Fixed_Str_Value;
-		CHECK(str_len == string.size());
+		CHECK((data[index] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
+		array_len = data[index] & Fixed_Array_Value;
+		CHECK(array_len == 0);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<std::string>());
-		CHECK(object.as<std::string>() == string);
+		CHECK(object.isArray());
+		CHECK(object.asArray().size() == 0);
 	}
 
 	// -------------------------------------------------------------------
 
-	SUBCASE("Len_1")
+	SUBCASE("Len 15")
 	{
-		const std::string string(1, '_');
-
-		object = {string};
-		CHECK(object.is<std::string>());
-
-		// Check serialized data
-
-		data = serialize(object);
-		CHECK(data.size() == string.size() + 1);
-
-		index = 0;
-		CHECK((data[index] & Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str);
-		str_len = data[index] & Fixed_Str_Value;
-		CHECK(str_len == string.size());
-
-		// Check deserialized data
-
-		object = deserialize(data);
-		CHECK(object.is<std::string>());
-		CHECK(object.as<std::string>() == string);
-	}
-
-	// -------------------------------------------------------------------
+		object = {Array{}};
+		CHECK(object.isArray());
 
-	SUBCASE("Len_31")
-	{
-		const std::string string(31, 'X');
+		for(size_t i = 0; i < 15; i++)
+		{
+			object.asArray().appendNull();
+		}
 
-		object = {string};
-		CHECK(object.is<std::string>());
+		array_len = object.asArray().size();
+		CHECK(array_len == 15);
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == string.size() + 1);
+		CHECK(data.size() == (array_len + 1));
 
 		index = 0;
-		CHECK((data[index] & Fixed_Str_Mask) == (uint8_t)Format::Fixed_Str);
-		str_len = data[index] & Fixed_Str_Value;
-		CHECK(str_len == string.size());
+		CHECK((data[index] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
+		array_len = data[index] & Fixed_Array_Value;
+		CHECK(array_len == 15);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<std::string>());
-		CHECK(object.as<std::string>() == string);
+		CHECK(object.isArray());
+		CHECK(object.asArray().size() == 15);
+
+		for(size_t i = 0; i < 15; i++)
+		{
+			CHECK(object.asArray().object(i).isNull());
+		}
 	}
 }
 
 
-TEST_CASE("serialize/object/str8")
+TEST_CASE("serialize/object/array16")
 {
 	Object               object;
 	std::vector<uint8_t> data;
 	size_t               index;
-	size_t               str_len;
+	size_t               array_len;
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Min")
 	{
-		const std::string string(32, '_');
+		object = {Array{}};
+		CHECK(object.isArray());
 
-		object = {string};
-		CHECK(object.is<std::string>());
+		for(size_t i = 0; i < 16; i++)
+		{
+			object.asArray().append(true);
+		}
+
+		array_len = object.asArray().size();
+		CHECK(array_len == 16);
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == string.size() + 2);
+		CHECK(data.size() == (array_len + 3));
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Str8);
-		str_len = data[index++];
-		CHECK(str_len == string.size());
+		CHECK(data[index++] == (uint8_t)Format::Array16);
+		array_len = readBigEndian<uint16_t>(data.data(), index);
+		CHECK(array_len == 16);
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<std::string>());
-		CHECK(object.as<std::string>() == string);
+		CHECK(object.isArray());
+		CHECK(object.asArray().size() == 16);
+
+		for(size_t i = 0; i < 16; i++)
+		{
+			CHECK(object.asArray().object(i).is<bool>());
+			CHECK(object.asArray().object(i).as<bool>() == true);
+		}
 	}
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Max")
 	{
-		const std::string string(std::numeric_limits<uint8_t>::max(), 'X');
+		object = {Array{}};
+		CHECK(object.isArray());
 
-		object = {string};
-		CHECK(object.is<std::string>());
+		for(size_t i = 0; i < std::numeric_limits<uint16_t>::max(); i++)
+		{
+			object.asArray().append(false);
+		}
+
+		array_len = object.asArray().size();
+		CHECK(array_len == std::numeric_limits<uint16_t>::max());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == (string.size() + 2));
+		CHECK(data.size() == (array_len + 3));
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Str8);
-		str_len = data[index++];
-		CHECK(str_len == string.size());
+		CHECK(data[index++] == (uint8_t)Format::Array16);
+		array_len = readBigEndian<uint16_t>(data.data(), index);
+		CHECK(array_len == std::numeric_limits<uint16_t>::max());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<std::string>());
-		CHECK(object.as<std::string>() == string);
+		CHECK(object.isArray());
+		CHECK(array_len == std::numeric_limits<uint16_t>::max());
+
+		for(int i = 0; i < std::numeric_limits<uint16_t>::max(); i++)
+		{
+			CHECK(object.asArray().object(i).is<bool>());
+			CHECK(object.asArray().object(i).as<bool>() == false);
+		}
 	}
 }
 
 
-TEST_CASE("serialize/object/str16")
+TEST_CASE("serialize/object/array32")
 {
 	Object               object;
 	std::vector<uint8_t> data;
 	size_t               index;
-	size_t               str_len;
+	size_t               array_len;
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Min")
 	{
-		const std::string string(std::numeric_limits<uint8_t>::max() + 1, '_');
+		object = {Array{}};
+		CHECK(object.isArray());
 
-		object = {string};
-		CHECK(object.is<std::string>());
+		for(size_t i = 0; i < std::numeric_limits<uint16_t>::max() + 1; i++)
+		{
+			object.asArray().append(true);
+		}
+
+		array_len = object.asArray().size();
+		CHECK(array_len == (std::numeric_limits<uint16_t>::max() + 1));
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == string.size() + 3);
+		CHECK(data.size() == (array_len + 5));
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Str16);
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		str_len = Convert.uint16;
-		CHECK(str_len == string.size());
+		CHECK(data[index++] == (uint8_t)Format::Array32);
+		array_len = readBigEndian<uint32_t>(data.data(), index);
+		CHECK(array_len == (std::numeric_limits<uint16_t>::max() + 1));
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<std::string>());
-		CHECK(object.as<std::string>() == string);
+		CHECK(object.isArray());
+		CHECK(object.asArray().size() == (std::numeric_limits<uint16_t>::max() + 1));
+
+		for(size_t i = 0; i < std::numeric_limits<uint16_t>::max() + 1; i++)
+		{
+			CHECK(object.asArray().object(i).is<bool>());
+			CHECK(object.asArray().object(i).as<bool>() == true);
+		}
 	}
 
 	// -------------------------------------------------------------------
 
 	SUBCASE("Max")
 	{
-		const std::string string(std::numeric_limits<uint16_t>::max(), 'X');
+		/*
+		 * This vector would be 4GB + overhead from std::vector
+		 * Serializing would consume another 4GB.
+		 * For a total of 8GB to test the maximum Array32 length.
+		object = {Array{}};
+		CHECK(object.isArray());
 
-		object = {string};
-		CHECK(object.is<std::string>());
+		for(size_t i = 0; i < std::numeric_limits<uint32_t>::max(); i++)
+		{
+			object.asArray().append(false);
+		}
+
+		array_len = object.asArray().size();
+		CHECK(array_len == std::numeric_limits<uint32_t>::max());
 
 		// Check serialized data
 
 		data = serialize(object);
-		CHECK(data.size() == (string.size() + 3));
+		CHECK(data.size() == (array_len + 5));
 
 		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Str16);
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		str_len = Convert.uint16;
-		CHECK(str_len == string.size());
+		CHECK(data[index++] == (uint8_t)Format::Array32);
+		array_len = readBigEndian<uint32_t>(data.data(), index);
+		CHECK(array_len == std::numeric_limits<uint32_t>::max());
 
 		// Check deserialized data
 
 		object = deserialize(data);
-		CHECK(object.is<std::string>());
-		CHECK(object.as<std::string>() == string);
+		CHECK(object.isArray());
+		CHECK(array_len == std::numeric_limits<uint32_t>::max());
+
+		for(int i = 0; i < std::numeric_limits<uint32_t>::max(); i++)
+		{
+			CHECK(object.asArray().object(i).is<bool>());
+			CHECK(object.asArray().object(i).as<bool>() == false);
+		}
+		*/
 	}
 }
 
+#endif // }}}
+
 
-TEST_CASE("serialize/object/str32")
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("serialize/deserialize/threads")
 {
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
-	size_t               str_len;
+	// Every thread packs and unpacks its own data. Any shared conversion 
+	// state would corrupt the multi-byte values of the other threads.
 
-	// -------------------------------------------------------------------
+	const size_t thread_count    = 8;
+	const size_t iteration_count = 2'000;
 
-	SUBCASE("Min")
+	auto make_object = [](const size_t seed) -> Object
 	{
-		const std::string string(std::numeric_limits<uint16_t>::max() + 1, '_');
+		Object object = {Array{}};
+		Array& array = object.asArray();
+
+		array.append(int64_t(seed) * -1'000);
+		array.append(int64_t(seed) * -100'000);
+		array.append(int64_t(seed) * -10'000'000'000);
+		array.append(uint64_t(seed) * 1'000);
+		array.append(uint64_t(seed) * 100'000);
+		array.append(uint64_t(seed) * 10'000'000'000);
+		array.append(float(seed) * 1.5f);
+		array.append(double(seed) * 2.25);
+		array.append(std::string(40 + seed, 'a' + (char)seed));
+		array.append(std::vector<uint8_t>(300 + seed, (uint8_t)seed));
 
-		object = {string};
-		CHECK(object.is<std::string>());
+		Ext ext;
+		ext.type = (int8_t)seed;
+		ext.data = std::pmr::vector<uint8_t>(260 + seed, (uint8_t)seed);
+		array.append(ext);
 
-		// Check serialized data
+		struct timespec ts =
+		{	.tv_sec  = (time_t)(seed * 0x1'0000'0000)
+		,	.tv_nsec = (long)seed
+		};
+		array.append(extensionTimestampConvert(ts));
 
-		data = serialize(object);
-		CHECK(data.size() == string.size() + 5);
+		Map map;
+		map.set(Object{int64_t(seed) * 70'000}, Object{uint64_t(seed)});
+		array.append(map);
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Str32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		str_len = Convert.uint32;
-		CHECK(str_len == string.size());
+		return object;
+	};
 
-		// Check deserialized data
+	std::vector<Object>               object_vector;
+	std::vector<std::vector<uint8_t>> data_vector;
 
-		object = deserialize(data);
-		CHECK(object.is<std::string>());
-		CHECK(object.as<std::string>() == string);
+	for(size_t i = 0; i < thread_count; i++)
+	{
+		object_vector.push_back(make_object(i + 1));
+		data_vector.push_back(serialize(object_vector.back()));
 	}
 
-	// -------------------------------------------------------------------
+	std::atomic<size_t>      failure_count = 0;
+	std::vector<std::thread> thread_vector;
 
-	SUBCASE("Max")
+	for(size_t t = 0; t < thread_count; t++)
 	{
-		/*
-		 * This string would be 4GB + overhead from std::string
-		 * Serializing would consume another 4GB.
-		 * For a total of 8GB to test the maximum Str32 length.
-		const std::string string(std::numeric_limits<uint32_t>::max(), 'X');
+		thread_vector.emplace_back([&, t]()
+		{
+			const Object&               expected_object = object_vector[t];
+			const std::vector<uint8_t>& expected_data   = data_vector[t];
 
-		object = {string};
-		CHECK(object.is<std::string>());
+			for(size_t i = 0; i < iteration_count; i++)
+			{
+				std::vector<uint8_t> data = serialize(expected_object);
+				if(data != expected_data)
+				{
+					failure_count++;
+				}
 
-		// Check serialized data
+				Object object = deserialize(expected_data);
+				if(serialize(object) != expected_data)
+				{
+					failure_count++;
+				}
 
-		data = serialize(object);
-		CHECK(data.size() == (string.size() + 3));
+				const Array& array = object.asArray();
+				struct timespec ts = extensionTimestampConvert(array.object(11));
+				if(ts.tv_sec != (time_t)((t + 1) * 0x1'0000'0000)
+					|| ts.tv_nsec != (long)(t + 1)
+					)
+				{
+					failure_count++;
+				}
+			}
+		});
+	}
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Str32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		str_len = Convert.uint32;
-		CHECK(str_len == string.size());
+	for(std::thread& thread : thread_vector)
+	{
+		thread.join();
+	}
 
-		// Check deserialized data
+	CHECK(failure_count == 0);
+}
+#endif // }}}
 
-		object = deserialize(data);
-		CHECK(object.is<std::string>());
-		CHECK(object.as<std::string>() == string);
-		 */
+// }}} Utilities::serialize
+// {{{ Utilities::serializedSize
+
+/**
+ * \brief The packed size of an Array.
+ *
+ * Calculate the number of bytes that serialize() will produce for the \p 
+ * array, without packing anything.
+ *
+ * \parcode
+ * std::vector<uint8_t> buffer(zakero::messagepack::serializedSize(array));
+ *
+ * zakero::messagepack::Packer packer(std::span<uint8_t>(buffer));
+ * packer.pack(array);
+ * \endparcode
+ *
+ * \return The number of bytes.
+ */
+size_t serializedSize(const Array& array ///< The Array
+	) noexcept
+{
+	size_t size = sizeContainer_(array.size());
+
+	for(const Object& object : array.object_vector)
+	{
+		size += serializedSize(object);
 	}
+
+	return size;
 }
 
 
-TEST_CASE("serialize/object/bin8")
+/**
+ * \brief The packed size of an Extension.
+ *
+ * Calculate the number of bytes that serialize() will produce for the \p 
+ * ext, without packing anything.
+ *
+ * \return The number of bytes.
+ */
+size_t serializedSize(const Ext& ext ///< The Extension
+	) noexcept
 {
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
-	size_t               bin_len;
+	return sizeExt_(ext.data.size());
+}
 
-	// -------------------------------------------------------------------
 
-	SUBCASE("Min")
-	{
-		const std::vector<uint8_t> bin = {};
+/**
+ * \brief The packed size of a Map.
+ *
+ * Calculate the number of bytes that serialize() will produce for the \p 
+ * map, without packing anything.
+ *
+ * \return The number of bytes.
+ */
+size_t serializedSize(const Map& map ///< The Map
+	) noexcept
+{
+	size_t size = sizeContainer_(map.size());
 
-		object = {bin};
-		CHECK(object.isBinary());
+	for(size_t i = 0; i < map.size(); i++)
+	{
+		size += serializedSize(map.key(i)) + serializedSize(map.value(i));
+	}
 
-		// Check serialized data
+	return size;
+}
 
-		data = serialize(object);
-		CHECK(data.size() == bin.size() + 2);
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Bin8);
-		bin_len = data[index++];
-		CHECK(bin_len == bin.size());
+/**
+ * \brief The packed size of an Object.
+ *
+ * Calculate the number of bytes that serialize() will produce for the \p 
+ * object, without packing anything. The contents of Arrays and Maps are 
+ * included.
+ *
+ * \return The number of bytes.
+ */
+size_t serializedSize(const Object& object ///< The Object
+	) noexcept
+{
+	switch(object.value.index())
+	{
+		case 0:  return 1;
+		case 1:  return 1;
+		case 2:  return sizeInt_(object.as<int64_t>());
+		case 3:  return sizeUint_(object.as<uint64_t>());
+		case 4:  return 5;
+		case 5:  return 9;
+		case 6:  return sizeStr_(object.asString().size());
+		case 7:  return sizeBin_(object.asBinary().size());
+		case 8:  return serializedSize(object.asArray());
+		case 9:  return serializedSize(object.asExt());
+		case 10: return serializedSize(object.asMap());
+	}
+
+	return 0;
+}
 
-		// Check deserialized data
 
-		object = deserialize(data);
-		CHECK(object.isBinary());
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("serializedSize")
+{
+	std::pmr::vector<Object> object_list =
+	{	Object{}
+	,	Object{true}
+	,	Object{float(1)}
+	,	Object{double(1)}
+	};
 
-		const std::vector<uint8_t>& vector = object.asBinary();
-		for(size_t i = 0; i < bin_len; i++)
-		{
-			CHECK(vector[i] == bin[i]);
-		}
+	for(const int64_t value :
+		{	int64_t(0), int64_t(127), int64_t(128), int64_t(-32), int64_t(-33)
+		,	int64_t(-128), int64_t(-129), int64_t(32'767), int64_t(32'768)
+		,	int64_t(-32'768), int64_t(-32'769), int64_t(2'147'483'647)
+		,	int64_t(2'147'483'648), std::numeric_limits<int64_t>::min()
+		})
+	{
+		object_list.push_back(Object{value});
 	}
 
-	// -------------------------------------------------------------------
-
-	SUBCASE("Max")
+	for(const uint64_t value :
+		{	uint64_t(0), uint64_t(255), uint64_t(256), uint64_t(65'535)
+		,	uint64_t(65'536), uint64_t(4'294'967'295), uint64_t(4'294'967'296)
+		})
 	{
-		const std::vector<uint8_t> bin(std::numeric_limits<uint8_t>::max(), 'X');
+		object_list.push_back(Object{value});
+	}
 
-		object = {bin};
-		CHECK(object.isBinary());
+	for(const size_t length : {0, 1, 2, 3, 4, 8, 16, 31, 32, 255, 256, 65'535, 65'536})
+	{
+		object_list.push_back(Object{std::pmr::string(length, 's')});
+		object_list.push_back(Object{std::pmr::vector<uint8_t>(length, 'b')});
 
-		// Check serialized data
+		Ext ext;
+		ext.data = std::pmr::vector<uint8_t>(length, 'e');
+		object_list.push_back(Object{ext});
+	}
 
-		data = serialize(object);
-		CHECK(data.size() == bin.size() + 2);
+	for(const size_t count : {0, 15, 16, 65'535, 65'536})
+	{
+		Object object = {Array{}};
+		Map    map;
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Bin8);
-		bin_len = data[index++];
-		CHECK(bin_len == bin.size());
+		for(size_t i = 0; i < count; i++)
+		{
+			object.asArray().append(int64_t(i));
+			map.set(Object{int64_t(i)}, Object{});
+		}
 
-		// Check deserialized data
+		object_list.push_back(object);
+		object_list.push_back(Object{map});
+	}
 
-		object = deserialize(data);
-		CHECK(object.isBinary());
+	Map map;
+	map.set(Object{}, Object{true});
+	map.set(Object{false}, Object{int64_t(-200)});
+	map.set(Object{int64_t(-1)}, Object{uint64_t(300)});
+	map.set(Object{uint64_t(70'000)}, Object{float(2)});
+	map.set(Object{float(3)}, Object{double(4)});
+	map.set(Object{double(5)}, Object{std::pmr::string(40, 's')});
+	Array array;
+	array.object_vector = object_list;
+	map.set(Object{"key"}, Object{array});
+	object_list.push_back(Object{map});
 
-		const std::vector<uint8_t>& vector = object.asBinary();
-		for(size_t i = 0; i < bin_len; i++)
-		{
-			CHECK(vector[i] == bin[i]);
-		}
+	for(const Object& object : object_list)
+	{
+		CHECK(serializedSize(object) == serialize(object).size());
 	}
 }
+#endif // }}}
+
+// }}} Utilities::serializedSize
+// {{{ Utilities::skip
+
+/**
+ * \brief Find the end of an Object.
+ *
+ * The \p index will be moved past the Object that starts at the \p index, 
+ * including all the contents of Arrays and Maps. Nothing is decoded and no 
+ * memory is allocated, only the Format IDs and the sizes and counts that 
+ * follow them are read. This makes it possible to find where each Object in 
+ * a buffer starts and ends.
+ *
+ * If there is an error, the \p index is not changed.
+ *
+ * \parcode
+ * // Forward each message without decoding it
+ * size_t index = 0;
+ *
+ * while(index < data.size())
+ * {
+ * 	const size_t start = index;
+ *
+ * 	if(zakero::messagepack::skip(data, index))
+ * 	{
+ * 		break;
+ * 	}
+ *
+ * 	forward(std::span(data).subspan(start, index - start));
+ * }
+ * \endparcode
+ *
+ * \retval Error_No_Data             The \p data is empty.
+ * \retval Error_Invalid_Index       The Object is not complete.
+ * \retval Error_Incomplete          The Object is not complete.
+ * \retval Error_Invalid_Format_Type An invalid Format ID was found.
+ *
+ * \return An error code.
+ */
+std::error_code skip(const std::span<const uint8_t> data  ///< The packed data
+	, size_t&                                   index ///< The location of the Object
+	) noexcept
+{
+	return skip_(data, index);
+}
 
 
-TEST_CASE("serialize/object/bin16")
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("skip")
 {
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
-	size_t               bin_len;
+	Map map;
+	map["name"]       = Object{"skip"};
+	map[int64_t(-1)]  = Object{std::pmr::vector<uint8_t>(300, 'b')};
+	map[double(0.5)]  = Object{Ext{.data = std::pmr::vector<uint8_t>(70'000, 'e'), .type = 3}};
 
-	// -------------------------------------------------------------------
+	Array array;
+	array.appendNull();
+	array.append(true);
+	array.append(int64_t(-100'000));
+	array.append(uint64_t(1) << 40);
+	array.append(1.25f);
+	array.append(-8.5);
+	array.append(std::string_view(std::string(40, 's')));
+	array.append(Ext{.data = std::pmr::vector<uint8_t>(4, 'x'), .type = 1});
+	array.append(map);
+
+	std::vector<Object> object_list =
+	{	Object{int64_t(0)}
+	,	Object{int64_t(-1)}
+	,	Object{"fixstr"}
+	,	Object{std::pmr::string(70'000, 'S')}
+	,	Object{array}
+	,	Object{Map{}}
+	};
 
-	SUBCASE("Min")
+	Array big;
+	for(size_t i = 0; i < 70'000; i++)
 	{
-		const std::vector<uint8_t> bin(std::numeric_limits<uint8_t>::max() + 1, '_');
+		big.append(int64_t(i));
+	}
+	object_list.push_back(Object{big});
 
-		object = {bin};
-		CHECK(object.isBinary());
+	std::vector<uint8_t> data;
+	std::vector<size_t>  end_list;
 
-		// Check serialized data
+	for(const Object& object : object_list)
+	{
+		const std::vector<uint8_t> packed = serialize(object);
 
-		data = serialize(object);
-		CHECK(data.size() == bin.size() + 3);
+		data.insert(data.end(), packed.begin(), packed.end());
+		end_list.push_back(data.size());
+	}
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Bin16);
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		bin_len = Convert.uint16;
-		CHECK(bin_len == bin.size());
+	size_t index = 0;
 
-		// Check deserialized data
+	for(const size_t end : end_list)
+	{
+		CHECK(skip(data, index) == Error_None);
+		CHECK(index == end);
+	}
 
-		object = deserialize(data);
-		CHECK(object.isBinary());
+	CHECK(skip(data, index) == Error_Invalid_Index);
+	CHECK(index == data.size());
 
-		const std::vector<uint8_t>& vector = object.asBinary();
-		for(size_t i = 0; i < bin_len; i++)
-		{
-			CHECK(vector[i] == bin[i]);
-		}
-	}
+	CHECK(validate(data) == Error_None);
 
-	// -------------------------------------------------------------------
+	// Every truncated Object is an error
 
-	SUBCASE("Max")
+	const std::vector<uint8_t> packed = serialize(array);
+
+	for(size_t size = 1; size < packed.size(); size++)
 	{
-		const std::vector<uint8_t> bin(std::numeric_limits<uint16_t>::max(), 'X');
+		index = 0;
 
-		object = {bin};
-		CHECK(object.isBinary());
+		CHECK(skip(std::span(packed).first(size), index) != Error_None);
+		CHECK(index == 0);
+	}
 
-		// Check serialized data
+	// The same data is accepted as deserialize()
 
-		data = serialize(object);
-		CHECK(data.size() == bin.size() + 3);
+	for(size_t size = 1; size <= packed.size(); size++)
+	{
+		std::span<const uint8_t> part = std::span(packed).first(size);
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Bin16);
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		bin_len = Convert.uint16;
-		CHECK(bin_len == bin.size());
+		size_t          deserialize_index = 0;
+		std::error_code error;
 
-		// Check deserialized data
+		Object object = deserialize(part, deserialize_index, error);
 
-		object = deserialize(data);
-		CHECK(object.isBinary());
+		index = 0;
 
-		const std::vector<uint8_t>& vector = object.asBinary();
-		for(size_t i = 0; i < bin_len; i++)
-		{
-			CHECK(vector[i] == bin[i]);
-		}
+		CHECK((skip(part, index) == Error_None) == (error == Error_None));
 	}
 }
 
-
-TEST_CASE("serialize/object/bin32")
+TEST_CASE("skip/error")
 {
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
-	size_t               bin_len;
-
-	// -------------------------------------------------------------------
+	size_t index = 0;
 
-	SUBCASE("Min")
-	{
-		const std::vector<uint8_t> bin(std::numeric_limits<uint16_t>::max() + 1, '_');
+	CHECK(skip(std::span<const uint8_t>{}, index) == Error_No_Data);
 
-		object = {bin};
-		CHECK(object.isBinary());
+	const std::vector<uint8_t> never_used = { 0x92, 0x01, (uint8_t)Format::Never_Used };
 
-		// Check serialized data
+	CHECK(skip(never_used, index) == Error_Invalid_Format_Type);
+	CHECK(index == 0);
 
-		data = serialize(object);
-		CHECK(data.size() == bin.size() + 5);
+	const std::vector<uint8_t> str8 = { (uint8_t)Format::Str8, 5, 'a', 'b' };
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Bin32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		bin_len = Convert.uint32;
-		CHECK(bin_len == bin.size());
+	CHECK(skip(str8, index) == Error_Incomplete);
 
-		// Check deserialized data
+	const std::vector<uint8_t> map32 = { (uint8_t)Format::Map32, 0xff, 0xff, 0xff, 0xff };
 
-		object = deserialize(data);
-		CHECK(object.isBinary());
+	CHECK(skip(map32, index) == Error_Incomplete);
 
-		const std::vector<uint8_t>& vector = object.asBinary();
-		for(size_t i = 0; i < bin_len; i++)
-		{
-			CHECK(vector[i] == bin[i]);
-		}
-	}
+	index = 1;
+	CHECK(skip(std::vector<uint8_t>{ 0x01 }, index) == Error_Invalid_Index);
+	CHECK(index == 1);
+}
 
-	// -------------------------------------------------------------------
+TEST_CASE("skip/table")
+{
+	// Every Format ID followed by enough bytes for any header
 
-	SUBCASE("Max")
+	for(size_t i = 0; i < 256; i++)
 	{
-		/*
-		 * This vector would be 4GB + overhead from std::vector
-		 * Serializing would consume another 4GB.
-		 * For a total of 8GB to test the maximum Str32 length.
-		const std::vector<uint8_t> bin(std::numeric_limits<uint32_t>::max(), 'X');
-
-		object = {bin};
-		CHECK(object.isBinary());
-
-		// Check serialized data
+		std::vector<uint8_t> data(140'000, 0);
+		data[0] = (uint8_t)i;
 
-		data = serialize(object);
-		CHECK(data.size() == (bin.size() + 5));
+		size_t          index = 0;
+		std::error_code error;
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Bin32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		bin_len = Convert.uint32;
-		CHECK(bin_len == bin.size());
+		Object object = deserialize(data, index, error);
 
-		// Check deserialized data
+		size_t skip_index = 0;
 
-		object = deserialize(data);
-		CHECK(object.isBinary());
+		CHECK(skip(data, skip_index) == error);
 
-		const std::vector<uint8_t>& vector = object.asBinary();
-		for(size_t i = 0; i < bin_len; i++)
+		if(error == Error_None)
 		{
-			CHECK(vector[i] == bin[i]);
+			CHECK(skip_index == index);
 		}
-		 */
 	}
 }
+#endif // }}}
 
+// }}} Utilities::skip
+// {{{ Utilities::toJson
 
-TEST_CASE("serialize/object/fixed_array")
+/**
+ * \brief Convert MessagePack data to JSON.
+ *
+ * The same as toJson(data, index, sink, options) with an \p index of `0`.
+ *
+ * \return An error code.
+ */
+std::error_code toJson(const std::span<const uint8_t> data    ///< The packed data
+	, const JsonSink&                         sink    ///< The JSON receiver
+	, const JsonOptions&                      options ///< The options
+	) noexcept
 {
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
-	size_t               array_len;
+	size_t index = 0;
 
-	// -------------------------------------------------------------------
+	return toJson(data, index, sink, options);
+}
 
-	SUBCASE("Empty")
+
+/**
+ * \brief Convert MessagePack data to JSON.
+ *
+ * The Object at the \p index of the packed \p data is converted to JSON text 
+ * without creating the Object. The JSON text is collected in a buffer of 
+ * JsonOptions::buffer_size bytes and passed to the \p sink, a piece at a 
+ * time, whenever the buffer is full and at the end. Large strings are 
+ * passed to the \p sink directly.
+ *
+ * | MessagePack | JSON                                                   |
+ * |-------------|--------------------------------------------------------|
+ * | Nil         | `null`                                                 |
+ * | Boolean     | `true` or `false`                                      |
+ * | Integer     | A number                                               |
+ * | Float       | The shortest number that is the same value, `null` for NaN and infinity |
+ * | String      | A string, escaped as needed                            |
+ * | Binary      | JsonOptions::binary                                    |
+ * | Array       | An array                                               |
+ * | Map         | An object, keys that are not strings are written as strings |
+ * | Extension   | `{"type": type, "data": data}`, the data uses JsonOptions::ext |
+ *
+ * Like skip(), nested data does not use recursion. A Map key that is an 
+ * Array, Map, Binary, or Extension causes Error_Invalid_Format_Type.
+ *
+ * \parcode
+ * std::string json;
+ *
+ * std::error_code error = zakero::messagepack::toJson(data, [&](std::string_view text)
+ * {
+ * 	json += text;
+ * });
+ * \endparcode
+ *
+ * When this function returns, the \p index will point to the byte after the 
+ * Object. If an error occurred, the \p index will point to where the error 
+ * was found and the \p sink will have been given the JSON text up to that 
+ * point.
+ *
+ * \retval Error_None                The data was converted.
+ * \retval Error_No_Data             The \p data is empty.
+ * \retval Error_Invalid_Index       The Object is not complete.
+ * \retval Error_Incomplete          The Object is not complete.
+ * \retval Error_Invalid_Format_Type An invalid Format ID was found, or a Map 
+ *                                   key can not be converted.
+ *
+ * \return An error code.
+ */
+std::error_code toJson(const std::span<const uint8_t> data    ///< The packed data
+	, size_t&                                 index   ///< The starting index
+	, const JsonSink&                         sink    ///< The JSON receiver
+	, const JsonOptions&                      options ///< The options
+	) noexcept
+{
+	struct Frame
 	{
-		object = {Array{}};
-		CHECK(object.isArray());
-		CHECK(object.asArray().size() == 0);
+		uint64_t remaining = 0;
+		bool     map       = false;
+		bool     key       = false;
+		bool     first     = true;
+	};
 
-		// Check serialized data
+	JsonWriter_        writer(sink, options.buffer_size);
+	std::vector<Frame> stack;
+	std::error_code    error;
 
-		data = serialize(object);
-		CHECK(data.size() == 1);
+	while(true)
+	{
+		if(stack.empty() == false)
+		{
+			Frame& frame = stack.back();
 
-		index = 0;
-		CHECK((data[index] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
-		array_len = data[index] & Fixed_Array_Value;
-		CHECK(array_len == 0);
+			if(frame.remaining == 0)
+			{
+				const bool map = frame.map;
 
-		// Check deserialized data
+				stack.pop_back();
 
-		object = deserialize(data);
-		CHECK(object.isArray());
-		CHECK(object.asArray().size() == 0);
-	}
+				if(options.pretty)
+				{
+					jsonIndent_(writer, stack.size() * options.indent);
+				}
 
-	// -------------------------------------------------------------------
+				writer.put(map ? '}' : ']');
 
-	SUBCASE("Len 15")
-	{
-		object = {Array{}};
-		CHECK(object.isArray());
+				if(stack.empty())
+				{
+					break;
+				}
 
-		for(size_t i = 0; i < 15; i++)
+				continue;
+			}
+
+			frame.remaining--;
+
+			if(frame.map == false || frame.key)
+			{
+				if(frame.first == false)
+				{
+					writer.put(',');
+				}
+
+				frame.first = false;
+
+				if(options.pretty)
+				{
+					jsonIndent_(writer, stack.size() * options.indent);
+				}
+			}
+			else
+			{
+				writer.put(options.pretty ? ": " : ":");
+			}
+		}
+
+		const size_t position = index;
+
+		Header_ header;
+
+		error = readHeader_(data, index, header);
+
+		if(error)
 		{
-			object.asArray().appendNull();
+			break;
 		}
 
-		array_len = object.asArray().size();
-		CHECK(array_len == 15);
+		if(stack.empty() == false
+			&& stack.back().map
+			)
+		{
+			Frame& frame = stack.back();
 
-		// Check serialized data
+			frame.key = !frame.key;
 
-		data = serialize(object);
-		CHECK(data.size() == (array_len + 1));
+			if(frame.key == false)
+			{
+				// JSON keys are strings
+				if(header.type == Type_::Binary
+					|| header.type == Type_::Array
+					|| header.type == Type_::Map
+					|| header.type == Type_::Ext
+					)
+				{
+					error = Error_Invalid_Format_Type;
+					index = position;
+					break;
+				}
 
-		index = 0;
-		CHECK((data[index] & Fixed_Array_Mask) == (uint8_t)Format::Fixed_Array);
-		array_len = data[index] & Fixed_Array_Value;
-		CHECK(array_len == 15);
+				if(header.type != Type_::String)
+				{
+					writer.put('"');
+					jsonValue_(writer, data, index, header, options);
+					writer.put('"');
+					continue;
+				}
+			}
+		}
 
-		// Check deserialized data
+		if(header.type == Type_::Array
+			|| header.type == Type_::Map
+			)
+		{
+			const bool map = (header.type == Type_::Map);
 
-		object = deserialize(data);
-		CHECK(object.isArray());
-		CHECK(object.asArray().size() == 15);
+			if(header.value == 0)
+			{
+				writer.put(map ? "{}" : "[]");
+			}
+			else
+			{
+				writer.put(map ? '{' : '[');
 
-		for(size_t i = 0; i < 15; i++)
+				stack.push_back({map ? header.value * 2 : header.value, map, map, true});
+				continue;
+			}
+		}
+		else
 		{
-			CHECK(object.asArray().object(i).isNull());
+			jsonValue_(writer, data, index, header, options);
+		}
+
+		if(stack.empty())
+		{
+			break;
 		}
 	}
+
+	writer.flush();
+
+	return error;
 }
 
 
-TEST_CASE("serialize/object/array16")
+/**
+ * \brief Convert MessagePack data to a JSON string.
+ *
+ * The Object at the start of the packed \p data is converted to JSON text, 
+ * see toJson(data, index, sink, options) for details.
+ *
+ * \parcode
+ * std::error_code error;
+ *
+ * printf("%s\n", zakero::messagepack::toJson(data, error).c_str());
+ * \endparcode
+ *
+ * \return The JSON text, or an empty string if there was an error.
+ */
+std::string toJson(const std::span<const uint8_t> data    ///< The packed data
+	, std::error_code&                        error   ///< The error code
+	, const JsonOptions&                      options ///< The options
+	) noexcept
 {
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
-	size_t               array_len;
-
-	// -------------------------------------------------------------------
+	std::string json;
 
-	SUBCASE("Min")
-	{
-		object = {Array{}};
-		CHECK(object.isArray());
+	error = toJson(data, [&](const std::string_view text)
+	{
+		json += text;
+	}, options);
 
-		for(size_t i = 0; i < 16; i++)
-		{
-			object.asArray().append(true);
-		}
+	if(error)
+	{
+		json.clear();
+	}
 
-		array_len = object.asArray().size();
-		CHECK(array_len == 16);
+	return json;
+}
 
-		// Check serialized data
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("toJson")
+{
+	auto json = [](const Object& object, const JsonOptions& options = {}) -> std::string
+	{
+		const std::vector<uint8_t> data = serialize(object);
 
-		data = serialize(object);
-		CHECK(data.size() == (array_len + 3));
+		std::error_code error = {};
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Array16);
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		array_len = Convert.uint16;
-		CHECK(array_len == 16);
+		const std::string text = toJson(data, error, options);
 
-		// Check deserialized data
+		CHECK(error == Error_None);
 
-		object = deserialize(data);
-		CHECK(object.isArray());
-		CHECK(object.asArray().size() == 16);
+		return text;
+	};
 
-		for(size_t i = 0; i < 16; i++)
+	SUBCASE("Scalars")
+	{
+		CHECK(json(Object{}) == "null");
+		CHECK(json(Object{true}) == "true");
+		CHECK(json(Object{false}) == "false");
+		CHECK(json(Object{int64_t(0)}) == "0");
+		CHECK(json(Object{int64_t(-33)}) == "-33");
+		CHECK(json(Object{std::numeric_limits<int64_t>::min()}) == "-9223372036854775808");
+		CHECK(json(Object{std::numeric_limits<uint64_t>::max()}) == "18446744073709551615");
+		CHECK(json(Object{float(0.1)}) == "0.1");
+		CHECK(json(Object{double(0.1)}) == "0.1");
+		CHECK(json(Object{double(-1.5e300)}) == "-1.5e+300");
+		CHECK(json(Object{std::numeric_limits<double>::quiet_NaN()}) == "null");
+		CHECK(json(Object{std::numeric_limits<float>::infinity()}) == "null");
+	}
+
+	SUBCASE("Strings")
+	{
+		CHECK(json(Object{""}) == "\"\"");
+		CHECK(json(Object{"zakero"}) == "\"zakero\"");
+		CHECK(json(Object{"a\"b\\c"}) == "\"a\\\"b\\\\c\"");
+		CHECK(json(Object{"\b\f\n\r\t"}) == "\"\\b\\f\\n\\r\\t\"");
+		CHECK(json(Object{std::pmr::string("\x00\x1f\x7f", 3)}) == "\"\\u0000\\u001f\x7f\"");
+		CHECK(json(Object{"/ \xc3\xa9"}) == "\"/ \xc3\xa9\"");
+
+		// Escapes at every position of the 8 byte blocks
+		for(size_t i = 0; i < 20; i++)
 		{
-			CHECK(object.asArray().object(i).is<bool>());
-			CHECK(object.asArray().object(i).as<bool>() == true);
+			std::pmr::string text(20, 'x');
+			text[i] = '\n';
+
+			std::string expect = "\"" + std::string(20, 'x') + "\"";
+			expect.replace(i + 1, 1, "\\n");
+
+			CHECK(json(Object{text}) == expect);
 		}
 	}
 
-	// -------------------------------------------------------------------
-
-	SUBCASE("Max")
+	SUBCASE("Binary")
 	{
-		object = {Array{}};
-		CHECK(object.isArray());
+		const std::vector<std::string> text_list = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};
 
-		for(size_t i = 0; i < std::numeric_limits<uint16_t>::max(); i++)
-		{
-			object.asArray().append(false);
-		}
+		const std::vector<std::string> base64_list =
+		{	"\"\"", "\"Zg==\"", "\"Zm8=\"", "\"Zm9v\"", "\"Zm9vYg==\"", "\"Zm9vYmE=\"", "\"Zm9vYmFy\""
+		};
 
-		array_len = object.asArray().size();
-		CHECK(array_len == std::numeric_limits<uint16_t>::max());
+		JsonOptions url;
+		url.binary = JsonEncoding::Base64_Url;
 
-		// Check serialized data
+		JsonOptions hex;
+		hex.binary = JsonEncoding::Hex;
 
-		data = serialize(object);
-		CHECK(data.size() == (array_len + 3));
+		JsonOptions array;
+		array.binary = JsonEncoding::Array;
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Array16);
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		array_len = Convert.uint16;
-		CHECK(array_len == std::numeric_limits<uint16_t>::max());
+		for(size_t i = 0; i < text_list.size(); i++)
+		{
+			const Object object = {std::pmr::vector<uint8_t>(text_list[i].begin(), text_list[i].end())};
 
-		// Check deserialized data
+			std::string unpadded = base64_list[i];
+			std::erase(unpadded, '=');
 
-		object = deserialize(data);
-		CHECK(object.isArray());
-		CHECK(array_len == std::numeric_limits<uint16_t>::max());
+			CHECK(json(object) == base64_list[i]);
+			CHECK(json(object, url) == unpadded);
+		}
 
-		for(int i = 0; i < std::numeric_limits<uint16_t>::max(); i++)
+		const Object bytes = {std::pmr::vector<uint8_t>{0x00, 0xfb, 0xff}};
+
+		CHECK(json(bytes) == "\"APv/\"");
+		CHECK(json(bytes, url) == "\"APv_\"");
+		CHECK(json(bytes, hex) == "\"00fbff\"");
+		CHECK(json(bytes, array) == "[0,251,255]");
+
+		// Larger than the output chunks
+		std::pmr::vector<uint8_t> large(1000);
+
+		for(size_t i = 0; i < large.size(); i++)
 		{
-			CHECK(object.asArray().object(i).is<bool>());
-			CHECK(object.asArray().object(i).as<bool>() == false);
+			large[i] = uint8_t(i * 7);
 		}
+
+		const std::string large_hex = json(Object{large}, hex);
+
+		REQUIRE(large_hex.size() == 2002);
+		CHECK(large_hex.substr(0, 9) == "\"00070e15");
+		CHECK(large_hex.substr(1995) == "434a51\"");
+
+		const std::string large_base64 = json(Object{large});
+
+		CHECK(large_base64.size() == 2 + ((1000 + 2) / 3) * 4);
+		CHECK(large_base64.substr(0, 9) == "\"AAcOFRwj");
 	}
-}
 
+	SUBCASE("Ext")
+	{
+		const Object ext = {Ext{std::pmr::vector<uint8_t>{'f', 'o', 'o'}, 42}};
 
-TEST_CASE("serialize/object/array32")
-{
-	Object               object;
-	std::vector<uint8_t> data;
-	size_t               index;
-	size_t               array_len;
+		JsonOptions hex;
+		hex.ext = JsonEncoding::Hex;
 
-	// -------------------------------------------------------------------
+		JsonOptions pretty;
+		pretty.pretty = true;
 
-	SUBCASE("Min")
+		CHECK(json(ext) == "{\"type\":42,\"data\":\"Zm9v\"}");
+		CHECK(json(ext, hex) == "{\"type\":42,\"data\":\"666f6f\"}");
+		CHECK(json(ext, pretty) == "{\"type\": 42, \"data\": \"Zm9v\"}");
+	}
+
+	SUBCASE("Containers")
 	{
-		object = {Array{}};
-		CHECK(object.isArray());
+		Object object = {Map{}};
+		Map&   map    = object.asMap();
+
+		map.emplace<std::pmr::string>("name", "zakero");
+		map.emplace<Array>("list").append(int64_t(1));
+		map["list"].asArray().append(true);
+		map["list"].asArray().emplace<Map>().emplace<bool>("x", false);
+		map.emplace<Array>("empty");
+		map.emplace<Map>("none");
+		map.emplace<int64_t>(int64_t(-7), 7);
+		map.emplace<bool>(true, true);
+		map.set(Object{}, Object{"null"});
+
+		CHECK(json(object) == "{\"name\":\"zakero\",\"list\":[1,true,{\"x\":false}],\"empty\":[],\"none\":{}"
+			",\"-7\":7,\"true\":true,\"null\":\"null\"}"
+			);
+
+		JsonOptions pretty;
+		pretty.pretty = true;
+		pretty.indent = 3;
+
+		CHECK(json(object, pretty) ==
+			"{\n"
+			"   \"name\": \"zakero\",\n"
+			"   \"list\": [\n"
+			"      1,\n"
+			"      true,\n"
+			"      {\n"
+			"         \"x\": false\n"
+			"      }\n"
+			"   ],\n"
+			"   \"empty\": [],\n"
+			"   \"none\": {},\n"
+			"   \"-7\": 7,\n"
+			"   \"true\": true,\n"
+			"   \"null\": \"null\"\n"
+			"}"
+			);
+
+		// Deep data does not use recursion
+		const size_t depth = 100'000;
+
+		std::vector<uint8_t> deep(depth, (uint8_t)Format::Fixed_Array | 1);
+		deep.push_back((uint8_t)Format::Nill);
+
+		std::error_code error = {};
+
+		const std::string deep_json = toJson(deep, error);
+
+		CHECK(error == Error_None);
+		CHECK(deep_json == std::string(depth, '[') + "null" + std::string(depth, ']'));
+	}
+
+	SUBCASE("Sink")
+	{
+		Object object = {Array{}};
 
-		for(size_t i = 0; i < std::numeric_limits<uint16_t>::max() + 1; i++)
+		for(size_t i = 0; i < 100; i++)
 		{
-			object.asArray().append(true);
+			object.asArray().append(std::string(i, 'a'));
+			object.asArray().append(uint64_t(i));
 		}
 
-		array_len = object.asArray().size();
-		CHECK(array_len == (std::numeric_limits<uint16_t>::max() + 1));
-
-		// Check serialized data
+		const std::vector<uint8_t> data   = serialize(object);
+		const std::string          expect = json(object);
 
-		data = serialize(object);
-		CHECK(data.size() == (array_len + 5));
+		for(const size_t buffer_size : {size_t(0), size_t(64), size_t(100), size_t(1'000'000)})
+		{
+			JsonOptions options;
+			options.buffer_size = buffer_size;
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Array32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		array_len = Convert.uint32;
-		CHECK(array_len == (std::numeric_limits<uint16_t>::max() + 1));
+			std::string text;
+			size_t      count = 0;
 
-		// Check deserialized data
+			const std::error_code error = toJson(data, [&](const std::string_view piece)
+			{
+				CHECK(piece.empty() == false);
+				text += piece;
+				count++;
+			}, options);
 
-		object = deserialize(data);
-		CHECK(object.isArray());
-		CHECK(object.asArray().size() == (std::numeric_limits<uint16_t>::max() + 1));
+			CHECK(error == Error_None);
+			CHECK(text == expect);
+			CHECK(count >= 1);
 
-		for(size_t i = 0; i < std::numeric_limits<uint16_t>::max() + 1; i++)
-		{
-			CHECK(object.asArray().object(i).is<bool>());
-			CHECK(object.asArray().object(i).as<bool>() == true);
+			if(buffer_size >= 1'000'000)
+			{
+				CHECK(count == 1);
+			}
 		}
 	}
 
-	// -------------------------------------------------------------------
-
-	SUBCASE("Max")
+	SUBCASE("Sequence")
 	{
-		/*
-		 * This vector would be 4GB + overhead from std::vector
-		 * Serializing would consume another 4GB.
-		 * For a total of 8GB to test the maximum Array32 length.
-		object = {Array{}};
-		CHECK(object.isArray());
+		std::vector<uint8_t> data = serialize(Object{int64_t(1)});
+		std::vector<uint8_t> next = serialize(Object{"two"});
+		data.insert(data.end(), next.begin(), next.end());
 
-		for(size_t i = 0; i < std::numeric_limits<uint32_t>::max(); i++)
+		std::string text;
+		size_t      index = 0;
+
+		auto sink = [&](const std::string_view piece)
 		{
-			object.asArray().append(false);
-		}
+			text += piece;
+		};
 
-		array_len = object.asArray().size();
-		CHECK(array_len == std::numeric_limits<uint32_t>::max());
+		CHECK(toJson(data, index, sink) == Error_None);
+		CHECK(index == 1);
+		CHECK(toJson(data, index, sink) == Error_None);
+		CHECK(index == data.size());
+		CHECK(text == "1\"two\"");
+		CHECK(toJson(data, index, sink) == Error_Invalid_Index);
+	}
 
-		// Check serialized data
+	SUBCASE("Errors")
+	{
+		std::error_code error = {};
 
-		data = serialize(object);
-		CHECK(data.size() == (array_len + 5));
+		CHECK(toJson(std::vector<uint8_t>{}, error).empty());
+		CHECK(error == Error_No_Data);
 
-		index = 0;
-		CHECK(data[index++] == (uint8_t)Format::Array32);
-		Convert_Byte3 = data[index++];
-		Convert_Byte2 = data[index++];
-		Convert_Byte1 = data[index++];
-		Convert_Byte0 = data[index++];
-		array_len = Convert.uint32;
-		CHECK(array_len == std::numeric_limits<uint32_t>::max());
+		// {[1]: 2}
+		const std::vector<uint8_t> array_key =
+		{	(uint8_t)Format::Fixed_Map | 1
+		,	(uint8_t)Format::Fixed_Array | 1, 1
+		,	2
+		};
 
-		// Check deserialized data
+		size_t index = 0;
 
-		object = deserialize(data);
-		CHECK(object.isArray());
-		CHECK(array_len == std::numeric_limits<uint32_t>::max());
+		CHECK(toJson(array_key, index, [](std::string_view){}) == Error_Invalid_Format_Type);
+		CHECK(index == 1);
 
-		for(int i = 0; i < std::numeric_limits<uint32_t>::max(); i++)
+		// Every truncation is an error
+		Object object = {Map{}};
+		object.asMap().emplace<std::pmr::string>("name", "zakero");
+		object.asMap().emplace<Array>("list").append(double(1.5));
+
+		const std::vector<uint8_t> data = serialize(object);
+
+		for(size_t size = 1; size < data.size(); size++)
 		{
-			CHECK(object.asArray().object(i).is<bool>());
-			CHECK(object.asArray().object(i).as<bool>() == false);
+			std::string text;
+
+			error = toJson(std::span<const uint8_t>(data.data(), size), [&](const std::string_view piece)
+			{
+				text += piece;
+			});
+
+			CHECK(error != Error_None);
+			CHECK(text.size() < 40);
 		}
-		*/
 	}
 }
-
 #endif // }}}
 
-// }}} Utilities::serialize
+// }}} Utilities::toJson
 // {{{ Utilities::to_string
 
 /**
@@ -10434,78 +25704,12 @@ std::string to_string(const messagepack::Map& map ///< The Map to convert.
 
 	std::string prefix = " ";
 
-	if(map.null_map.empty() == false)
-	{
-		s += prefix
-			+ to_string(Object{})
-			+ ": "
-			+ to_string(map.null_map[0])
-			;
-
-		prefix = ", ";
-	}
-
-	for(const auto& [key, value] : map.bool_map)
-	{
-		s += prefix
-			+ to_string(Object{key})
-			+ ": "
-			+ to_string(value)
-			;
-
-		prefix = ", ";
-	}
-
-	for(const auto& [key, value] : map.int64_map)
-	{
-		s += prefix
-			+ to_string(Object{key})
-			+ ": "
-			+ to_string(value)
-			;
-
-		prefix = ", ";
-	}
-
-	for(const auto& [key, value] : map.uint64_map)
-	{
-		s += prefix
-			+ to_string(Object{key})
-			+ ": "
-			+ to_string(value)
-			;
-
-		prefix = ", ";
-	}
-
-	for(const auto& [key, value] : map.float_map)
-	{
-		s += prefix
-			+ to_string(Object{key})
-			+ ": "
-			+ to_string(value)
-			;
-
-		prefix = ", ";
-	}
-
-	for(const auto& [key, value] : map.double_map)
-	{
-		s += prefix
-			+ to_string(Object{key})
-			+ ": "
-			+ to_string(value)
-			;
-
-		prefix = ", ";
-	}
-
-	for(const auto& [key, value] : map.string_map)
+	for(size_t i = 0; i < map.size(); i++)
 	{
 		s += prefix
-			+ to_string(Object{key})
+			+ to_string(map.key(i))
 			+ ": "
-			+ to_string(value)
+			+ to_string(map.value(i))
 			;
 
 		prefix = ", ";
@@ -10559,17 +25763,17 @@ std::string to_string(const messagepack::Object& object ///< The Object to conve
 	{
 		s += ", 'value': " + std::to_string(object.as<double>());
 	}
-	else if(object.is<std::string>())
+	else if(object.is<std::pmr::string>())
 	{
-		s += ", 'value': '" + object.as<std::string>() + "'";
+		s += ", 'value': '" + object.as<std::pmr::string>() + "'";
 	}
-	else if(object.is<std::vector<uint8_t>>())
+	else if(object.is<std::pmr::vector<uint8_t>>())
 	{
 		s += ", 'value': ";
 
 		std::string prefix = "[ ";
 
-		const std::vector<uint8_t>& data = object.as<std::vector<uint8_t>>();
+		const std::pmr::vector<uint8_t>& data = object.as<std::pmr::vector<uint8_t>>();
 		for(size_t i = 0; i < data.size(); i++)
 		{
 			s += prefix + std::to_string(data[i]);
@@ -10600,6 +25804,146 @@ std::string to_string(const messagepack::Object& object ///< The Object to conve
 	return s;
 }
 // }}} Utilities::to_string
+// {{{ Utilities::validate
+
+/**
+ * \brief Check packed data.
+ *
+ * Check that all of the \p data is a sequence of one or more complete 
+ * Objects. Like skip(), nothing is decoded and no memory is allocated.
+ *
+ * \parcode
+ * if(zakero::messagepack::validate(data))
+ * {
+ * 	// Drop the message
+ * }
+ * \endparcode
+ *
+ * \retval Error_No_Data             The \p data is empty.
+ * \retval Error_Invalid_Index       The last Object is not complete.
+ * \retval Error_Incomplete          The last Object is not complete.
+ * \retval Error_Invalid_Format_Type An invalid Format ID or Map key was 
+ *                                   found.
+ *
+ * \return An error code.
+ */
+std::error_code validate(const std::span<const uint8_t> data ///< The packed data
+	) noexcept
+{
+	if(data.size() == 0)
+	{
+		return Error_No_Data;
+	}
+
+	size_t index = 0;
+
+	while(index < data.size())
+	{
+		std::error_code error = skip_(data, index);
+
+		if(error)
+		{
+			return error;
+		}
+	}
+
+	return Error_None;
+}
+
+
+#ifdef ZAKERO_MESSAGEPACK_IMPLEMENTATION_TEST // {{{
+TEST_CASE("validate")
+{
+	std::vector<uint8_t> data = serialize(Object{"one"});
+
+	CHECK(validate(data) == Error_None);
+
+	const std::vector<uint8_t> two = serialize(Object{Array{}});
+	data.insert(data.end(), two.begin(), two.end());
+
+	CHECK(validate(data) == Error_None);
+
+	CHECK(validate(std::span<const uint8_t>{}) == Error_No_Data);
+
+	data.push_back((uint8_t)Format::Str8);
+	CHECK(validate(data) == Error_Incomplete);
+
+	data.back() = (uint8_t)Format::Never_Used;
+	CHECK(validate(data) == Error_Invalid_Format_Type);
+
+	data.back() = (uint8_t)Format::Fixed_Array | 1;
+	CHECK(validate(data) == Error_Invalid_Index);
+}
+
+TEST_CASE("validate/map key")
+{
+	const uint8_t fixed_array = (uint8_t)Format::Fixed_Array;
+	const uint8_t fixed_map   = (uint8_t)Format::Fixed_Map;
+	const uint8_t fixed_str   = (uint8_t)Format::Fixed_Str;
+
+	// The same data is accepted as deserialize()
+
+	std::vector<std::pair<std::error_code, std::vector<uint8_t>>> data_list =
+	{	// Valid keys
+		{ Error_None, { (uint8_t)(fixed_map | 1), 0x01, 0x02 } }
+	,	{ Error_None, { (uint8_t)(fixed_map | 1), (uint8_t)(fixed_str | 1), 'k', (uint8_t)(fixed_array | 1), 0x02 } }
+	,	{ Error_None, { (uint8_t)(fixed_map | 1), (uint8_t)Format::Nill, (uint8_t)(fixed_map | 1), 0x01, 0x02 } }
+	,	{ Error_None, { (uint8_t)(fixed_map | 1), (uint8_t)Format::Uint8, 0xff, 0x02 } }
+	,	{ Error_None, { (uint8_t)(fixed_map | 2), 0x01, (uint8_t)(fixed_array | 2), 0x03, 0x04, 0x05, 0x06 } }
+		// Container keys
+	,	{ Error_Invalid_Format_Type, { (uint8_t)(fixed_map | 1), (uint8_t)(fixed_array | 1), 0x01, 0x02 } }
+	,	{ Error_Invalid_Format_Type, { (uint8_t)(fixed_map | 1), fixed_array, 0x02 } }
+	,	{ Error_Invalid_Format_Type, { (uint8_t)(fixed_map | 1), (uint8_t)(fixed_map | 1), 0x01, 0x02, 0x03 } }
+		// Binary and extension keys
+	,	{ Error_Invalid_Format_Type, { (uint8_t)(fixed_map | 1), (uint8_t)Format::Bin8, 1, 'b', 0x02 } }
+	,	{ Error_Invalid_Format_Type, { (uint8_t)(fixed_map | 1), (uint8_t)Format::Fixed_Ext1, 1, 'e', 0x02 } }
+	,	{ Error_Invalid_Format_Type, { (uint8_t)(fixed_map | 1), (uint8_t)Format::Ext8, 1, 1, 'e', 0x02 } }
+		// Bad keys after nested values and inside Arrays
+	,	{ Error_Invalid_Format_Type, { (uint8_t)(fixed_map | 2), 0x01, (uint8_t)(fixed_array | 2), 0x03, 0x04, fixed_array, 0x05 } }
+	,	{ Error_Invalid_Format_Type, { (uint8_t)(fixed_array | 2), 0x01, (uint8_t)(fixed_map | 1), fixed_map, 0x02 } }
+	,	{ Error_Invalid_Format_Type, { (uint8_t)(fixed_map | 1), 0x01, (uint8_t)(fixed_map | 1), (uint8_t)Format::Bin8, 0, 0x02 } }
+		// Incomplete keys are found before their type
+	,	{ Error_Incomplete, { (uint8_t)(fixed_map | 1), (uint8_t)Format::Bin8, 5, 'b', 0x02 } }
+	,	{ Error_Incomplete, { (uint8_t)(fixed_map | 1), (uint8_t)Format::Array16, 0x00, 0x00, 0x02 } }
+	,	{ Error_Incomplete, { (uint8_t)(fixed_map | 1), (uint8_t)Format::Map16, 0x00, 0x00, 0x02 } }
+	};
+
+	// Array16 and Map16 need room for 16 elements
+	for(const Format format : { Format::Array16, Format::Map16 })
+	{
+		std::vector<uint8_t> data = { (uint8_t)(fixed_map | 1), (uint8_t)format, 0x00, 0x00 };
+		data.insert(data.end(), 32, 0x00);
+
+		data_list.push_back({ Error_Invalid_Format_Type, data });
+	}
+
+	for(const auto& [expected, data] : data_list)
+	{
+		size_t          index = 0;
+		std::error_code error;
+
+		Object object = deserialize(data, index, error);
+
+		CHECK(error == expected);
+		CHECK(validate(data) == error);
+
+		size_t skip_index = 0;
+
+		CHECK(skip(data, skip_index) == error);
+
+		if(error == Error_None)
+		{
+			CHECK(skip_index == data.size());
+		}
+		else
+		{
+			CHECK(skip_index == 0);
+		}
+	}
+}
+#endif // }}}
+
+// }}} Utilities::validate
 // }}} Utilities
 } // zakero::messagepack
 
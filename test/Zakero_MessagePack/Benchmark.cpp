@@ -0,0 +1,2131 @@
+/*
+g++ -std=c++20 -O2 -Wall -Werror -o Benchmark Benchmark.cpp -lpthread && ./Benchmark
+
+- Run a single benchmark
+./Benchmark threads
+./Benchmark packer
+./Benchmark size
+./Benchmark arena
+./Benchmark map
+./Benchmark fields
+./Benchmark skip
+./Benchmark index
+./Benchmark mapped
+./Benchmark bulk
+./Benchmark typed
+./Benchmark gather
+./Benchmark move
+./Benchmark limits
+./Benchmark batch
+./Benchmark parallel
+./Benchmark keys
+./Benchmark shapes
+./Benchmark footprint
+./Benchmark json
+./Benchmark fromjson
+./Benchmark query
+ */
+
+#define ZAKERO_MESSAGEPACK_IMPLEMENTATION
+#include "../../include/Zakero_MessagePack.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory_resource>
+#include <thread>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	namespace mp = zakero::messagepack;
+
+
+	double secondsSince(const Clock::time_point start)
+	{
+		const std::chrono::duration<double> duration = Clock::now() - start;
+
+		return duration.count();
+	}
+
+
+	mp::Object makeMessage(const size_t seed)
+	{
+		mp::Map header;
+		header.set(mp::Object{"id"}      , mp::Object{uint64_t(seed)});
+		header.set(mp::Object{"offset"}  , mp::Object{int64_t(seed) * -70'000});
+		header.set(mp::Object{"scale"}   , mp::Object{double(seed) * 0.125});
+		header.set(mp::Object{"service"} , mp::Object{"telemetry"});
+
+		mp::Object object = {mp::Array{}};
+		mp::Array& array  = object.asArray();
+
+		array.append(header);
+		array.append(std::vector<uint8_t>(512, (uint8_t)seed));
+
+		for(size_t i = 0; i < 32; i++)
+		{
+			array.append(float(i) * 0.5f);
+			array.append(int64_t(i) * 100'000);
+		}
+
+		return object;
+	}
+
+	// {{{ threads
+
+	void benchmarkThreads()
+	{
+		const size_t message_count = 20'000;
+		const size_t max_threads   = std::max(1u, std::thread::hardware_concurrency());
+
+		const mp::Object           message = makeMessage(42);
+		const std::vector<uint8_t> data    = mp::serialize(message);
+
+		printf("threads: serialize + deserialize of %zu messages per thread (%zu bytes each)\n"
+			, message_count
+			, data.size()
+			);
+
+		double single_rate = 0;
+
+		for(size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+		{
+			std::vector<std::thread> thread_vector;
+
+			const Clock::time_point start = Clock::now();
+
+			for(size_t t = 0; t < thread_count; t++)
+			{
+				thread_vector.emplace_back([&]()
+				{
+					for(size_t i = 0; i < message_count; i++)
+					{
+						std::vector<uint8_t> packed = mp::serialize(message);
+						mp::Object object = mp::deserialize(packed);
+					}
+				});
+			}
+
+			for(std::thread& thread : thread_vector)
+			{
+				thread.join();
+			}
+
+			const double seconds = secondsSince(start);
+			const double rate    = (double)(message_count * thread_count) / seconds;
+
+			if(thread_count == 1)
+			{
+				single_rate = rate;
+			}
+
+			printf("  %2zu thread(s): %10.0f msg/s  speed-up: %5.2fx\n"
+				, thread_count
+				, rate
+				, rate / single_rate
+				);
+		}
+	}
+
+	// }}}
+	// {{{ packer
+
+	void packMessage(mp::Packer&      packer
+		, const size_t                seed
+		, const std::vector<uint8_t>& binary
+		)
+	{
+		packer.packArrayHeader(2 + 64);
+
+		packer.packMapHeader(4);
+		packer.packStr("id");      packer.packUint(seed);
+		packer.packStr("offset");  packer.packInt(int64_t(seed) * -70'000);
+		packer.packStr("scale");   packer.packDouble(double(seed) * 0.125);
+		packer.packStr("service"); packer.packStr("telemetry");
+
+		packer.packBin(binary);
+
+		for(size_t i = 0; i < 32; i++)
+		{
+			packer.packFloat(float(i) * 0.5f);
+			packer.packInt(int64_t(i) * 100'000);
+		}
+	}
+
+
+	void benchmarkPacker()
+	{
+		const size_t message_count = 100'000;
+
+		const std::vector<uint8_t> binary(512, 42);
+		const std::vector<uint8_t> expected = mp::serialize(makeMessage(42));
+
+		printf("packer: %zu messages (%zu bytes each)\n"
+			, message_count
+			, expected.size()
+			);
+
+		size_t byte_count = 0;
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			const mp::Object           object = makeMessage(42);
+			const std::vector<uint8_t> data   = mp::serialize(object);
+
+			byte_count += data.size();
+		}
+
+		const double object_rate = (double)message_count / secondsSince(start);
+
+		std::vector<uint8_t> vector;
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			vector.clear();
+
+			mp::Packer packer(vector);
+			packMessage(packer, 42, binary);
+
+			byte_count += vector.size();
+		}
+
+		const double vector_rate = (double)message_count / secondsSince(start);
+
+		std::vector<uint8_t> buffer(expected.size());
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			mp::Packer packer(std::span<uint8_t>{buffer});
+			packMessage(packer, 42, binary);
+
+			byte_count += packer.size();
+		}
+
+		const double span_rate = (double)message_count / secondsSince(start);
+
+		if(vector != expected || buffer != expected)
+		{
+			printf("  ERROR: Packer output does not match serialize()\n");
+		}
+
+		printf("  Object tree + serialize(): %10.0f msg/s\n", object_rate);
+		printf("  Packer (std::vector)     : %10.0f msg/s  %5.2fx\n", vector_rate, vector_rate / object_rate);
+		printf("  Packer (std::span)       : %10.0f msg/s  %5.2fx\n", span_rate, span_rate / object_rate);
+		printf("  (%zu bytes total)\n", byte_count);
+	}
+
+	// }}}
+	// {{{ size
+
+	/*
+	 * Packing one element at a time with a reserve() of exactly the bytes 
+	 * needed defeats the geometric growth of std::vector, every element 
+	 * becomes a reallocation and a copy.
+	 */
+	std::vector<uint8_t> serializeReserveEach(const mp::Array& array)
+	{
+		std::vector<uint8_t> vector;
+
+		for(const mp::Object& object : array.object_vector)
+		{
+			const std::vector<uint8_t> data = mp::serialize(object);
+
+			vector.reserve(vector.size() + data.size());
+			vector.insert(vector.end(), data.begin(), data.end());
+		}
+
+		return vector;
+	}
+
+
+	void benchmarkSize()
+	{
+		const size_t int_count     = 1'000'000;
+		const size_t reserve_count = 100'000;
+		const size_t repeat        = 10;
+
+		mp::Object object = {mp::Array{}};
+
+		for(size_t i = 0; i < int_count; i++)
+		{
+			object.asArray().append(int64_t(i) * 37 - 500'000);
+		}
+
+		mp::Array small;
+		small.object_vector.assign(object.asArray().object_vector.begin()
+			, object.asArray().object_vector.begin() + reserve_count
+			);
+
+		printf("size: serialize an Array of %zu ints (%zu bytes)\n"
+			, int_count
+			, mp::serializedSize(object)
+			);
+
+		size_t byte_count = 0;
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			byte_count += serializeReserveEach(small).size();
+		}
+
+		const double reserve_time = secondsSince(start) / repeat;
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			std::vector<uint8_t> vector;
+			mp::Packer packer(vector);
+			packer.pack(object);
+
+			byte_count += vector.size();
+		}
+
+		const double grow_time = secondsSince(start) / repeat;
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			byte_count += mp::serialize(object).size();
+		}
+
+		const double exact_time = secondsSince(start) / repeat;
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			byte_count += mp::serializedSize(object);
+		}
+
+		const double size_time = secondsSince(start) / repeat;
+
+		printf("  reserve() per element    : %8.2f ms (%zu ints only)\n", reserve_time * 1000, reserve_count);
+		printf("  Packer, vector growth    : %8.2f ms\n", grow_time * 1000);
+		printf("  serialize(), exact size  : %8.2f ms  %5.2fx\n", exact_time * 1000, grow_time / exact_time);
+		printf("    serializedSize() alone : %8.2f ms\n", size_time * 1000);
+		printf("  (%zu bytes total)\n", byte_count);
+	}
+
+	// }}}
+	// {{{ arena
+
+	class CountingResource
+		: public std::pmr::memory_resource
+	{
+		public:
+			size_t count = 0;
+			size_t bytes = 0;
+
+		private:
+			void* do_allocate(size_t bytes, size_t alignment) override
+			{
+				count++;
+				this->bytes += bytes;
+				return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+			{
+				std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+			}
+
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+			{
+				return this == &other;
+			}
+	};
+
+
+	void benchmarkArena()
+	{
+		const size_t element_count = 100'000;
+		const size_t repeat        = 10;
+
+		mp::Object object = {mp::Array{}};
+
+		for(size_t i = 0; i < element_count; i++)
+		{
+			mp::Map map;
+			map.set(mp::Object{"id"}   , mp::Object{uint64_t(i)});
+			map.set(mp::Object{"name"} , mp::Object{std::pmr::string(24, char('a' + i % 26))});
+			map.set(mp::Object{"value"}, mp::Object{double(i) * 0.5});
+
+			object.asArray().append(map);
+		}
+
+		const std::vector<uint8_t> data = mp::serialize(object);
+
+		printf("arena: deserialize an Array of %zu Maps (%zu bytes)\n"
+			, element_count
+			, data.size()
+			);
+
+		CountingResource           heap;
+		std::pmr::memory_resource* default_resource = std::pmr::set_default_resource(&heap);
+
+		double decode_time = 0;
+		double free_time   = 0;
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			Clock::time_point start = Clock::now();
+
+			mp::Object* test = new mp::Object(mp::deserialize(data));
+
+			decode_time += secondsSince(start);
+			start = Clock::now();
+
+			delete test;
+
+			free_time += secondsSince(start);
+		}
+
+		const size_t heap_count = heap.count / repeat;
+
+		printf("  heap    : decode %8.2f ms  free %8.2f ms  %9zu allocations\n"
+			, decode_time / repeat * 1000
+			, free_time / repeat * 1000
+			, heap_count
+			);
+
+		CountingResource upstream;
+
+		decode_time = 0;
+		free_time   = 0;
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			Clock::time_point start = Clock::now();
+
+			std::pmr::monotonic_buffer_resource* arena =
+				new std::pmr::monotonic_buffer_resource(data.size(), &upstream);
+
+			mp::Object* test = new mp::Object(mp::deserialize(data, arena));
+
+			decode_time += secondsSince(start);
+			start = Clock::now();
+
+			delete test;
+			delete arena;
+
+			free_time += secondsSince(start);
+		}
+
+		printf("  arena   : decode %8.2f ms  free %8.2f ms  %9zu allocations (%zu from the heap)\n"
+			, decode_time / repeat * 1000
+			, free_time / repeat * 1000
+			, upstream.count / repeat
+			, (heap.count / repeat) - heap_count
+			);
+
+		std::pmr::set_default_resource(default_resource);
+	}
+
+	// }}}
+	// {{{ map
+
+	void benchmarkMap()
+	{
+		const size_t lookup_count = 2'000'000;
+		const size_t key_count[]  = { 4, 16, 64 };
+
+		printf("map: %zu lookups of a string key\n", lookup_count);
+
+		for(const size_t count : key_count)
+		{
+			std::vector<std::string>                       name_vector;
+			std::map<std::string, mp::Object, std::less<>> std_map;
+			mp::Map                                        map;
+
+			for(size_t i = 0; i < count; i++)
+			{
+				name_vector.push_back("field_name_" + std::to_string(i));
+
+				std_map[name_vector.back()] = mp::Object{uint64_t(i)};
+				map[name_vector.back()]     = mp::Object{uint64_t(i)};
+			}
+
+			uint64_t sum = 0;
+
+			Clock::time_point start = Clock::now();
+
+			for(size_t i = 0; i < lookup_count; i++)
+			{
+				const std::string_view name = name_vector[i % count];
+
+				sum += std_map.find(name)->second.as<uint64_t>();
+			}
+
+			const double std_time = secondsSince(start);
+
+			start = Clock::now();
+
+			for(size_t i = 0; i < lookup_count; i++)
+			{
+				const std::string_view name = name_vector[i % count];
+
+				sum += map[name].as<uint64_t>();
+			}
+
+			const double map_time = secondsSince(start);
+
+			printf("  %3zu keys: std::map %7.2f ms  Map %7.2f ms  %5.2fx  (%llu)\n"
+				, count
+				, std_time * 1000
+				, map_time * 1000
+				, std_time / map_time
+				, (unsigned long long)sum
+				);
+		}
+	}
+
+	// }}}
+	// {{{ fields
+
+	struct Telemetry
+	{
+		uint64_t    id      = 0;
+		int64_t     offset  = 0;
+		double      scale   = 0;
+		float       reading = 0;
+		std::string service = {};
+	};
+
+	ZAKERO_MESSAGEPACK_FIELDS(Telemetry, id, offset, scale, reading, service)
+
+
+	void benchmarkFields()
+	{
+		const size_t record_count = 1'000'000;
+
+		const Telemetry record = { 42, -70'000, 0.125, 3.5f, "telemetry" };
+
+		printf("fields: encode + decode of %zu records\n", record_count);
+
+		std::vector<uint8_t> data;
+		size_t               byte_count = 0;
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t i = 0; i < record_count; i++)
+		{
+			mp::Map map;
+			map.set(mp::Object{"id"}     , mp::Object{record.id});
+			map.set(mp::Object{"offset"} , mp::Object{record.offset});
+			map.set(mp::Object{"scale"}  , mp::Object{record.scale});
+			map.set(mp::Object{"reading"}, mp::Object{record.reading});
+			map.set(mp::Object{"service"}, mp::Object{std::pmr::string(record.service)});
+
+			data = mp::serialize(map);
+
+			mp::Object object = mp::deserialize(data);
+			const mp::Map& test = object.asMap();
+
+			Telemetry copy;
+			copy.id      = test["id"].as<uint64_t>();
+			copy.offset  = test["offset"].as<int64_t>();
+			copy.scale   = test["scale"].as<double>();
+			copy.reading = test["reading"].as<float>();
+			copy.service = test["service"].asString();
+
+			byte_count += data.size() + copy.service.size();
+		}
+
+		const double object_time = secondsSince(start);
+		const std::vector<uint8_t> expected = data;
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < record_count; i++)
+		{
+			data.clear();
+
+			mp::Packer packer(data);
+			encode(record, packer);
+
+			Telemetry copy;
+			decode(data, copy);
+
+			byte_count += data.size() + copy.service.size();
+		}
+
+		const double fields_time = secondsSince(start);
+
+		if(data != expected)
+		{
+			printf("  ERROR: encode() output does not match serialize()\n");
+		}
+
+		printf("  Map + serialize() + deserialize(): %8.2f ms\n", object_time * 1000);
+		printf("  encode() + decode()              : %8.2f ms  %5.2fx\n", fields_time * 1000, object_time / fields_time);
+		printf("  (%zu bytes total)\n", byte_count);
+	}
+
+	// }}}
+	// {{{ skip
+
+	void benchmarkSkip()
+	{
+		const size_t message_count = 10'000;
+		const size_t repeat        = 20;
+
+		std::vector<uint8_t> data;
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			const std::vector<uint8_t> message = mp::serialize(makeMessage(i));
+
+			data.insert(data.end(), message.begin(), message.end());
+		}
+
+		const double megabytes = (double)(data.size() * repeat) / (1024 * 1024);
+
+		printf("skip: find the end of %zu messages (%zu bytes)\n"
+			, message_count
+			, data.size()
+			);
+
+		size_t count = 0;
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			size_t          index = 0;
+			std::error_code error;
+
+			while(index < data.size())
+			{
+				mp::Object object = mp::deserialize(data, index, error);
+
+				count++;
+			}
+		}
+
+		const double deserialize_time = secondsSince(start);
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			size_t index = 0;
+
+			while(index < data.size() && mp::skip(data, index) == mp::Error_None)
+			{
+				count++;
+			}
+		}
+
+		const double skip_time = secondsSince(start);
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			count += (mp::validate(data) == mp::Error_None);
+		}
+
+		const double validate_time = secondsSince(start);
+
+		printf("  deserialize(): %9.1f MB/s\n", megabytes / deserialize_time);
+		printf("  skip()       : %9.1f MB/s  %6.2fx\n", megabytes / skip_time, deserialize_time / skip_time);
+		printf("  validate()   : %9.1f MB/s  %6.2fx\n", megabytes / validate_time, deserialize_time / validate_time);
+		printf("  (%zu)\n", count);
+	}
+
+	// }}}
+	// {{{ index
+
+	void benchmarkIndex()
+	{
+		const size_t element_count = 1'000'000;
+		const size_t fetch_count   = 1'000;
+
+		mp::Object object = {mp::Array{}};
+
+		for(size_t i = 0; i < element_count; i++)
+		{
+			mp::Map map;
+			map["id"]   = mp::Object{uint64_t(i)};
+			map["name"] = mp::Object{std::pmr::string(16, char('a' + i % 26))};
+
+			object.asArray().append(map);
+		}
+
+		const std::vector<uint8_t> data = mp::serialize(object);
+
+		printf("index: fetch %zu elements from an Array of %zu (%zu bytes)\n"
+			, fetch_count
+			, element_count
+			, data.size()
+			);
+
+		uint64_t sum = 0;
+
+		Clock::time_point start = Clock::now();
+
+		const mp::Object whole = mp::deserialize(data);
+		sum += whole.asArray()[element_count / 2].asMap()["id"].as<uint64_t>();
+
+		const double deserialize_time = secondsSince(start);
+
+		const mp::ArrayView view = mp::ObjectView(data).asArray();
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < fetch_count; i++)
+		{
+			sum += view[(i * 7'919) % element_count].asMap()["id"].asUint();
+		}
+
+		const double view_time = secondsSince(start) / fetch_count;
+
+		mp::ArrayIndex index;
+
+		start = Clock::now();
+
+		index.build(data);
+
+		const double build_time = secondsSince(start);
+
+		const std::vector<uint8_t> index_data = index.save();
+
+		mp::ArrayIndex loaded;
+
+		start = Clock::now();
+
+		loaded.load(data, index_data);
+
+		const double load_time = secondsSince(start);
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < fetch_count; i++)
+		{
+			sum += loaded.at((i * 7'919) % element_count).asMap()["id"].as<uint64_t>();
+		}
+
+		const double index_time = secondsSince(start) / fetch_count;
+
+		printf("  deserialize() whole Array : %10.3f ms per element\n", deserialize_time * 1000);
+		printf("  ArrayView::object()       : %10.3f ms per element\n", view_time * 1000);
+		printf("  ArrayIndex::at()          : %10.6f ms per element\n", index_time * 1000);
+		printf("  ArrayIndex::build()       : %10.3f ms\n", build_time * 1000);
+		printf("  ArrayIndex::load()        : %10.3f ms (%zu bytes)\n", load_time * 1000, index_data.size());
+		printf("  (%llu)\n", (unsigned long long)sum);
+	}
+
+	// }}}
+	// {{{ mapped
+
+	size_t residentKiB()
+	{
+		std::ifstream status("/proc/self/status");
+		std::string   line;
+
+		while(std::getline(status, line))
+		{
+			if(line.starts_with("VmRSS:"))
+			{
+				return std::stoul(line.substr(6));
+			}
+		}
+
+		return 0;
+	}
+
+
+	void benchmarkMapped()
+	{
+		const std::string path      = "/tmp/zakero_messagepack_benchmark.log";
+		const size_t      file_size = 512 * 1024 * 1024;
+
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+			const std::vector<uint8_t> message = mp::serialize(makeMessage(42));
+
+			for(size_t size = 0; size < file_size; size += message.size())
+			{
+				file.write((const char*)message.data(), message.size());
+			}
+		}
+
+		printf("mapped: scan a %zu MiB log file\n", file_size / (1024 * 1024));
+
+		size_t count = 0;
+
+		const size_t rss_start = residentKiB();
+
+		Clock::time_point start = Clock::now();
+
+		size_t rss_mapped = 0;
+		{
+			mp::MappedFile file;
+			file.open(path);
+
+			for(auto iter = file.begin(); iter != file.end(); iter++)
+			{
+				count += (*iter).asArray().size();
+			}
+
+			rss_mapped = residentKiB();
+		}
+
+		const double mapped_time = secondsSince(start);
+
+		start = Clock::now();
+
+		size_t rss_vector = 0;
+		{
+			std::ifstream        file(path, std::ios::binary);
+			std::vector<uint8_t> data(file_size + 4096);
+
+			file.read((char*)data.data(), data.size());
+			data.resize(file.gcount());
+
+			size_t          index = 0;
+			std::error_code error;
+
+			while(index < data.size())
+			{
+				mp::ObjectView view(data, index, error);
+
+				if(error)
+				{
+					break;
+				}
+
+				count += view.asArray().size();
+			}
+
+			rss_vector = residentKiB();
+		}
+
+		const double vector_time = secondsSince(start);
+
+		unlink(path.c_str());
+
+		printf("  read() + std::vector: %8.2f ms  RSS +%7zu KiB\n", vector_time * 1000, rss_vector - rss_start);
+		printf("  MappedFile          : %8.2f ms  RSS +%7zu KiB\n", mapped_time * 1000, rss_mapped - rss_start);
+		printf("  (%zu)\n", count);
+	}
+
+	// }}}
+	// {{{ bulk
+
+	template<typename T>
+	void benchmarkBulkColumn(const char* name
+		, const std::vector<T>&      column
+		, const size_t               frame_count
+		)
+	{
+		const size_t bytes = frame_count * column.size() * sizeof(T);
+
+		std::vector<uint8_t> data;
+		data.reserve(column.size() * (1 + sizeof(T)) + 8);
+
+		size_t check = 0;
+
+		auto report = [&](const char* label, const double seconds, const double base)
+		{
+			printf("  %-6s %-27s: %8.2f ms  %7.0f MB/s  speed-up: %5.2fx\n"
+				, name
+				, label
+				, seconds * 1000
+				, (double)bytes / seconds / 1'000'000
+				, base / seconds
+				);
+		};
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t f = 0; f < frame_count; f++)
+		{
+			mp::Array array;
+
+			for(const T value : column)
+			{
+				array.append(value);
+			}
+
+			check += mp::serialize(array).size();
+		}
+
+		const double append_time = secondsSince(start);
+
+		start = Clock::now();
+
+		for(size_t f = 0; f < frame_count; f++)
+		{
+			mp::Array array;
+			array.appendRange(column);
+
+			check += mp::serialize(array).size();
+		}
+
+		const double range_time = secondsSince(start);
+
+		start = Clock::now();
+
+		for(size_t f = 0; f < frame_count; f++)
+		{
+			data.clear();
+			mp::Packer packer(data);
+
+			packer.packArrayHeader(column.size());
+
+			for(const T value : column)
+			{
+				if constexpr(std::is_same_v<T, float>)
+				{
+					packer.packFloat(value);
+				}
+				else
+				{
+					packer.packDouble(value);
+				}
+			}
+
+			check += data.size();
+		}
+
+		const double packer_time = secondsSince(start);
+
+		start = Clock::now();
+
+		for(size_t f = 0; f < frame_count; f++)
+		{
+			data.clear();
+			mp::Packer packer(data);
+
+			packer.packArray(column);
+
+			check += data.size();
+		}
+
+		const double bulk_time = secondsSince(start);
+
+		report("append() + serialize()"     , append_time, append_time);
+		report("appendRange() + serialize()", range_time , append_time);
+		report("Packer::pack*() per value"  , packer_time, append_time);
+		report("Packer::packArray()"        , bulk_time  , append_time);
+		printf("  (%zu)\n", check);
+	}
+
+
+	void benchmarkBulk()
+	{
+		const size_t column_size = 4'096;
+		const size_t frame_count = 5'000;
+
+		std::vector<float>  column_f(column_size);
+		std::vector<double> column_d(column_size);
+
+		for(size_t i = 0; i < column_size; i++)
+		{
+			column_f[i] = (float)i * 0.25f - 300.0f;
+			column_d[i] = (double)i / 7.0;
+		}
+
+		printf("bulk: pack %zu frames of %zu values\n", frame_count, column_size);
+
+		benchmarkBulkColumn("float" , column_f, frame_count);
+		benchmarkBulkColumn("double", column_d, frame_count);
+	}
+
+	// }}}
+	// {{{ typed
+
+	void benchmarkTyped()
+	{
+		const size_t value_count = 1'000'000;
+		const size_t loop_count  = 20;
+
+		std::vector<float> value(value_count);
+		for(size_t i = 0; i < value_count; i++)
+		{
+			value[i] = (float)i * 0.001f;
+		}
+
+		printf("typed: pack and read %zu floats, %zu times\n", value_count, loop_count);
+
+		double sum = 0;
+
+		std::vector<uint8_t> array_data;
+		std::vector<uint8_t> typed_data;
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t loop = 0; loop < loop_count; loop++)
+		{
+			array_data.clear();
+			mp::Packer packer(array_data);
+
+			packer.packArray(value);
+		}
+
+		const double array_pack = secondsSince(start);
+
+		start = Clock::now();
+
+		for(size_t loop = 0; loop < loop_count; loop++)
+		{
+			mp::Object object = mp::deserialize(array_data);
+
+			for(const mp::Object& element : object.asArray().object_vector)
+			{
+				sum += element.as<float>();
+			}
+		}
+
+		const double array_read = secondsSince(start);
+
+		start = Clock::now();
+
+		for(size_t loop = 0; loop < loop_count; loop++)
+		{
+			typed_data.clear();
+			mp::Packer packer(typed_data);
+
+			packer.packTypedArray<float>(value);
+		}
+
+		const double typed_pack = secondsSince(start);
+
+		start = Clock::now();
+
+		for(size_t loop = 0; loop < loop_count; loop++)
+		{
+			const mp::ObjectView view(typed_data);
+
+			for(const float element : mp::extensionTypedArrayView<float>(view.asExt()))
+			{
+				sum += element;
+			}
+		}
+
+		const double typed_read = secondsSince(start);
+
+		printf("  Array of float 32 : %8zu bytes  pack: %8.2f ms  deserialize + read: %8.2f ms\n"
+			, array_data.size()
+			, array_pack * 1000 / loop_count
+			, array_read * 1000 / loop_count
+			);
+		printf("  Typed Array       : %8zu bytes  pack: %8.2f ms  view + read       : %8.2f ms\n"
+			, typed_data.size()
+			, typed_pack * 1000 / loop_count
+			, typed_read * 1000 / loop_count
+			);
+		printf("  (%f)\n", sum);
+	}
+
+	// }}}
+	// {{{ gather
+
+	void benchmarkGather()
+	{
+		const size_t message_count = 500;
+		const size_t payload_size  = 4 * 1024 * 1024;
+
+		mp::Object object = {mp::Map{}};
+		mp::Map&   map    = object.asMap();
+
+		map["id"]      = mp::Object{uint64_t(42)};
+		map["name"]    = mp::Object{"frame.raw"};
+		map["payload"] = mp::Object{std::pmr::vector<uint8_t>(payload_size, 0x5a)};
+
+		const int fd = open("/dev/null", O_WRONLY);
+
+		printf("gather: write %zu messages with a %zu MiB bin field to /dev/null\n"
+			, message_count
+			, payload_size / (1024 * 1024)
+			);
+
+		size_t check = 0;
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			const std::vector<uint8_t> data = mp::serialize(object);
+
+			check += write(fd, data.data(), data.size());
+		}
+
+		const double copy_time = secondsSince(start);
+
+		start = Clock::now();
+
+		std::vector<uint8_t>      buffer;
+		std::vector<struct iovec> iovec_vector;
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			buffer.clear();
+			iovec_vector.clear();
+
+			(void)mp::serialize(object, buffer, iovec_vector);
+
+			check += writev(fd, iovec_vector.data(), (int)iovec_vector.size());
+		}
+
+		const double gather_time = secondsSince(start);
+
+		close(fd);
+
+		printf("  serialize() + write()         : %8.2f ms\n", copy_time * 1000);
+		printf("  serialize(iovec) + writev()   : %8.2f ms  speed-up: %6.1fx\n", gather_time * 1000, copy_time / gather_time);
+		printf("  (%zu)\n", check);
+	}
+
+	// }}}
+	// {{{ move
+
+	constexpr size_t Move_Depth_ = 64;
+
+
+	mp::Map moveLevel(const size_t level)
+	{
+		mp::Map map;
+		map.set(mp::Object{"level"}  , mp::Object{uint64_t(level)});
+		map.set(mp::Object{"payload"}, mp::Object{std::pmr::string(64, 'p')});
+
+		mp::Array values;
+		values.appendRange(std::vector<int64_t>(16, int64_t(level)));
+		map.set(mp::Object{"values"}, mp::Object{std::move(values)});
+
+		return map;
+	}
+
+
+	mp::Object moveBuildCopy()
+	{
+		mp::Object child;
+
+		for(size_t level = Move_Depth_; level > 0; level--)
+		{
+			mp::Map map = moveLevel(level);
+
+			const mp::Object& child_ref = child;
+			map.set(mp::Object{"child"}, child_ref);
+
+			const mp::Map& map_ref = map;
+			child = mp::Object{map_ref};
+		}
+
+		return child;
+	}
+
+
+	mp::Object moveBuildMove()
+	{
+		mp::Object child;
+
+		for(size_t level = Move_Depth_; level > 0; level--)
+		{
+			mp::Map map = moveLevel(level);
+
+			map.set(mp::Object{"child"}, std::move(child));
+
+			child = std::move(map);
+		}
+
+		return child;
+	}
+
+
+	mp::Object moveBuildEmplace()
+	{
+		mp::Object object = {mp::Map{}};
+		mp::Map*   map    = &object.asMap();
+
+		for(size_t level = 1; level <= Move_Depth_; level++)
+		{
+			map->emplace<uint64_t>("level", level);
+			map->emplace<std::pmr::string>("payload", 64, 'p');
+			map->emplace<mp::Array>("values").appendRange(std::vector<int64_t>(16, int64_t(level)));
+
+			if(level == Move_Depth_)
+			{
+				map->emplace<std::monostate>("child");
+			}
+			else
+			{
+				map = &map->emplace<mp::Map>("child");
+			}
+		}
+
+		return object;
+	}
+
+
+	void benchmarkMove()
+	{
+		const size_t repeat = 100;
+
+		const std::vector<uint8_t> data = mp::serialize(moveBuildMove());
+
+		printf("move: build a %zu level nested Map document (%zu bytes)\n"
+			, Move_Depth_
+			, data.size()
+			);
+
+		CountingResource           heap;
+		std::pmr::memory_resource* default_resource = std::pmr::set_default_resource(&heap);
+
+		struct Build
+		{
+			const char* name;
+			mp::Object  (*function)();
+		};
+
+		const Build build_list[] =
+		{	{ "copy, const& set()     ", moveBuildCopy    }
+		,	{ "move, && set()         ", moveBuildMove    }
+		,	{ "emplace()              ", moveBuildEmplace }
+		};
+
+		for(const Build& build : build_list)
+		{
+			heap.count = 0;
+
+			const Clock::time_point start = Clock::now();
+
+			for(size_t i = 0; i < repeat; i++)
+			{
+				const mp::Object object = build.function();
+			}
+
+			const double time = secondsSince(start);
+
+			printf("  %s : %8.3f ms  %7zu allocations\n"
+				, build.name
+				, time / repeat * 1000
+				, heap.count / repeat
+				);
+		}
+
+		heap.count = 0;
+
+		const Clock::time_point start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			const mp::Object object = mp::deserialize(data);
+		}
+
+		const double time = secondsSince(start);
+
+		printf("  deserialize()           : %8.3f ms  %7zu allocations\n"
+			, time / repeat * 1000
+			, heap.count / repeat
+			);
+
+		std::pmr::set_default_resource(default_resource);
+	}
+
+	// }}}
+	// {{{ limits
+
+	void benchmarkLimits()
+	{
+		const size_t message_count = 10'000;
+		const size_t repeat        = 10;
+
+		mp::Object object = {mp::Array{}};
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			object.asArray().append(makeMessage(i));
+		}
+
+		const std::vector<uint8_t> data = mp::serialize(object);
+
+		printf("limits: deserialize %zu messages (%zu bytes)\n"
+			, message_count
+			, data.size()
+			);
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			const mp::Object test = mp::deserialize(data);
+		}
+
+		const double default_time = secondsSince(start);
+
+		mp::Limits limits;
+		limits.max_depth    = 8;
+		limits.max_elements = 1'000'000;
+		limits.max_bytes    = 16 * 1024 * 1024;
+
+		start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			size_t          index = 0;
+			std::error_code error = {};
+
+			const mp::Object test = mp::deserialize(data, index, error, limits);
+		}
+
+		const double limit_time = secondsSince(start);
+
+		printf("  deserialize()                 : %8.2f ms\n", default_time / repeat * 1000);
+		printf("  deserialize(Limits)           : %8.2f ms\n", limit_time / repeat * 1000);
+
+		// Recursion would overflow the stack
+		const std::vector<uint8_t> deep(64 * 1024 * 1024, 0x91);
+
+		start = Clock::now();
+
+		size_t          index = 0;
+		std::error_code error = {};
+
+		const mp::Object test = mp::deserialize(deep, index, error, limits);
+
+		printf("  64 MiB of nested Arrays       : %8.3f ms  %s at byte %zu\n"
+			, secondsSince(start) * 1000
+			, error.message().c_str()
+			, index
+			);
+	}
+
+	// }}}
+	// {{{ batch
+
+	void benchmarkBatch()
+	{
+		const size_t message_count = 20'000;
+		const size_t repeat        = 5;
+		const size_t max_threads   = std::max(1u, std::thread::hardware_concurrency());
+
+		std::vector<uint8_t> data;
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			const std::vector<uint8_t> packed = mp::serialize(makeMessage(i));
+
+			data.insert(data.end(), packed.begin(), packed.end());
+		}
+
+		printf("batch: deserialize a stream of %zu messages (%zu bytes)\n"
+			, message_count
+			, data.size()
+			);
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t r = 0; r < repeat; r++)
+		{
+			std::vector<mp::Object> object_vector;
+
+			size_t          index = 0;
+			std::error_code error = {};
+
+			while(index < data.size())
+			{
+				object_vector.push_back(mp::deserialize(data, index, error));
+			}
+		}
+
+		const double loop_time = secondsSince(start) / repeat;
+
+		printf("  deserialize() loop            : %8.2f ms\n", loop_time * 1000);
+
+		for(size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+		{
+			start = Clock::now();
+
+			for(size_t r = 0; r < repeat; r++)
+			{
+				std::vector<mp::Object> object_vector;
+
+				(void)mp::deserializeBatch(data, object_vector, thread_count);
+			}
+
+			const double batch_time = secondsSince(start) / repeat;
+
+			printf("  deserializeBatch() %3zu threads: %8.2f ms  %5.2fx\n"
+				, thread_count
+				, batch_time * 1000
+				, loop_time / batch_time
+				);
+		}
+	}
+
+	// }}}
+	// {{{ parallel
+
+	void benchmarkParallel()
+	{
+		const size_t child_count = 1'000'000;
+		const size_t repeat      = 5;
+		const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+		mp::Object object = {mp::Array{}};
+		mp::Array& array  = object.asArray();
+
+		for(size_t i = 0; i < child_count; i++)
+		{
+			mp::Map& map = array.emplace<mp::Map>();
+			map.emplace<uint64_t>("id", i);
+			map.emplace<double>("value", double(i) * 0.5);
+			map.emplace<std::pmr::string>("name", 16, char('a' + i % 26));
+		}
+
+		Clock::time_point start = Clock::now();
+
+		size_t byte_count = 0;
+
+		for(size_t r = 0; r < repeat; r++)
+		{
+			byte_count = mp::serialize(object).size();
+		}
+
+		const double sequential_time = secondsSince(start) / repeat;
+
+		printf("parallel: serialize an Array of %zu Maps (%zu bytes)\n"
+			, child_count
+			, byte_count
+			);
+		printf("  serialize()                   : %8.2f ms\n", sequential_time * 1000);
+
+		for(size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+		{
+			start = Clock::now();
+
+			for(size_t r = 0; r < repeat; r++)
+			{
+				std::error_code error;
+
+				byte_count = mp::serialize(object, error, thread_count).size();
+			}
+
+			const double parallel_time = secondsSince(start) / repeat;
+
+			printf("  serialize() %3zu threads       : %8.2f ms  %5.2fx\n"
+				, thread_count
+				, parallel_time * 1000
+				, sequential_time / parallel_time
+				);
+		}
+	}
+
+	// }}}
+	// {{{ keys
+
+	void benchmarkKeys()
+	{
+		const size_t message_count = 100'000;
+		const size_t key_count     = 24;
+
+		const char* key_name[key_count] =
+		{	"timestamp", "sequence", "device_id", "firmware", "temperature"
+		,	"humidity", "pressure", "battery_level", "signal_strength", "latitude"
+		,	"longitude", "altitude", "speed", "heading", "status"
+		,	"error_count", "uptime_seconds", "sample_rate", "channel", "gain"
+		,	"offset", "calibration_id", "checksum", "reserved"
+		};
+
+		std::vector<uint8_t> data;
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			mp::Object object = {mp::Map{}};
+
+			for(size_t k = 0; k < key_count; k++)
+			{
+				object.asMap().emplace<uint64_t>(key_name[k], i + k);
+			}
+
+			const std::vector<uint8_t> packed = mp::serialize(object);
+
+			data.insert(data.end(), packed.begin(), packed.end());
+		}
+
+		printf("keys: deserialize %zu Maps with %zu string keys (%zu bytes)\n"
+			, message_count
+			, key_count
+			, data.size()
+			);
+
+		Clock::time_point start = Clock::now();
+
+		size_t index = 0;
+
+		while(index < data.size())
+		{
+			std::error_code error;
+
+			const mp::Object object = mp::deserialize(data, index, error);
+		}
+
+		const double plain_time = secondsSince(start);
+
+		mp::KeyCache key_cache;
+
+		start = Clock::now();
+
+		index = 0;
+
+		while(index < data.size())
+		{
+			std::error_code error;
+
+			const mp::Object object = mp::deserialize(data, index, error, key_cache);
+		}
+
+		const double cache_time = secondsSince(start);
+
+		printf("  deserialize()                 : %8.2f ms\n", plain_time * 1000);
+		printf("  deserialize(KeyCache)         : %8.2f ms  %5.2fx  hit rate: %.4f (%zu keys)\n"
+			, cache_time * 1000
+			, plain_time / cache_time
+			, key_cache.hitRate()
+			, key_cache.size()
+			);
+	}
+
+	// }}}
+	// {{{ shapes
+
+	void benchmarkShapes()
+	{
+		const size_t message_count = 100'000;
+
+		const char* key_name[] =
+		{	"timestamp", "sequence", "device_id", "firmware", "temperature"
+		,	"humidity", "pressure", "battery_level", "signal_strength", "latitude"
+		,	"longitude", "altitude", "speed", "heading", "status"
+		,	"error_count", "uptime_seconds", "sample_rate", "channel", "gain"
+		,	"offset", "calibration_id", "checksum", "reserved"
+		};
+
+		for(const size_t key_count : {6, 24})
+		{
+			std::vector<uint8_t> data;
+
+			for(size_t i = 0; i < message_count; i++)
+			{
+				mp::Object object = {mp::Map{}};
+
+				for(size_t k = 0; k < key_count; k++)
+				{
+					object.asMap().emplace<uint64_t>(key_name[k], i + k);
+				}
+
+				const std::vector<uint8_t> packed = mp::serialize(object);
+
+				data.insert(data.end(), packed.begin(), packed.end());
+			}
+
+			printf("shapes: deserialize %zu Maps with %zu string keys (%zu bytes)\n"
+				, message_count
+				, key_count
+				, data.size()
+				);
+
+			// Warm up
+			size_t index = 0;
+
+			while(index < data.size())
+			{
+				std::error_code error;
+
+				const mp::Object object = mp::deserialize(data, index, error);
+			}
+
+			Clock::time_point start = Clock::now();
+
+			index = 0;
+
+			while(index < data.size())
+			{
+				std::error_code error;
+
+				const mp::Object object = mp::deserialize(data, index, error);
+			}
+
+			const double plain_time = secondsSince(start);
+
+			mp::KeyCache key_cache;
+
+			start = Clock::now();
+
+			index = 0;
+
+			while(index < data.size())
+			{
+				std::error_code error;
+
+				const mp::Object object = mp::deserialize(data, index, error, key_cache);
+			}
+
+			const double key_time = secondsSince(start);
+
+			mp::ShapeCache shape_cache;
+
+			start = Clock::now();
+
+			index = 0;
+
+			while(index < data.size())
+			{
+				std::error_code error;
+
+				const mp::Object object = mp::deserialize(data, index, error, shape_cache);
+			}
+
+			const double shape_time = secondsSince(start);
+
+			printf("  deserialize()                 : %8.2f ms\n", plain_time * 1000);
+			printf("  deserialize(KeyCache)         : %8.2f ms  %5.2fx\n"
+				, key_time * 1000
+				, plain_time / key_time
+				);
+			printf("  deserialize(ShapeCache)       : %8.2f ms  %5.2fx  hit rate: %.4f\n"
+				, shape_time * 1000
+				, plain_time / shape_time
+				, shape_cache.hitRate()
+				);
+		}
+	}
+
+	// }}}
+	// {{{ footprint
+
+	template<typename Build>
+	void footprintArray(const char* name
+		, const size_t          element_count
+		, Build                 build
+		)
+	{
+		const size_t repeat = 10;
+
+		mp::Object object = {mp::Array{}};
+
+		for(size_t i = 0; i < element_count; i++)
+		{
+			object.asArray().append(build(i));
+		}
+
+		const std::vector<uint8_t> data = mp::serialize(object);
+
+		CountingResource           heap;
+		std::pmr::memory_resource* default_resource = std::pmr::set_default_resource(&heap);
+
+		double decode_time = 0;
+		double visit_time  = 0;
+		size_t visit_count = 0;
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			Clock::time_point start = Clock::now();
+
+			const mp::Object test = mp::deserialize(data);
+
+			decode_time += secondsSince(start);
+			start = Clock::now();
+
+			for(const mp::Object& element : test.asArray().object_vector)
+			{
+				visit_count += element.value.index();
+			}
+
+			visit_time += secondsSince(start);
+		}
+
+		std::pmr::set_default_resource(default_resource);
+
+		const size_t heap_bytes = heap.bytes / repeat;
+
+		printf("  %-7s: %10zu bytes  %6.1f bytes/element  decode %7.2f ms  visit %6.2f ms  (%zu)\n"
+			, name
+			, heap_bytes
+			, (double)heap_bytes / (double)element_count
+			, decode_time / repeat * 1000
+			, visit_time / repeat * 1000
+			, visit_count / repeat
+			);
+	}
+
+
+	void benchmarkFootprint()
+	{
+		const size_t element_count = 1'000'000;
+
+		printf("footprint: memory used by Arrays of %zu elements\n", element_count);
+		printf("  sizeof(Object) = %zu, sizeof(Map) = %zu\n", sizeof(mp::Object), sizeof(mp::Map));
+
+		footprintArray("bool", element_count, [](size_t i)
+		{
+			return mp::Object{(i % 2) == 0};
+		});
+
+		footprintArray("int", element_count, [](size_t i)
+		{
+			return mp::Object{int64_t(i)};
+		});
+
+		footprintArray("string", element_count, [](size_t i)
+		{
+			return mp::Object{std::pmr::string(std::to_string(i % 1000))};
+		});
+
+		footprintArray("map", element_count / 10, [](size_t i)
+		{
+			mp::Map map;
+			map.set(mp::Object{"id"}   , mp::Object{uint64_t(i)});
+			map.set(mp::Object{"ok"}   , mp::Object{true});
+			map.set(mp::Object{"value"}, mp::Object{double(i) * 0.5});
+
+			return mp::Object{std::move(map)};
+		});
+	}
+
+	// }}}
+	// {{{ json
+
+	void benchmarkJson()
+	{
+		const size_t message_count = 10'000;
+		const size_t repeat        = 10;
+
+		std::vector<uint8_t> data;
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			const std::vector<uint8_t> message = mp::serialize(makeMessage(i));
+
+			data.insert(data.end(), message.begin(), message.end());
+		}
+
+		const double megabytes = (double)(data.size() * repeat) / (1024 * 1024);
+
+		printf("json: convert %zu messages (%zu bytes) to JSON\n"
+			, message_count
+			, data.size()
+			);
+
+		size_t output_size = 0;
+
+		Clock::time_point start = Clock::now();
+
+		for(size_t i = 0; i < repeat; i++)
+		{
+			size_t          index = 0;
+			std::error_code error;
+
+			while(index < data.size())
+			{
+				output_size += mp::to_string(mp::deserialize(data, index, error)).size();
+			}
+		}
+
+		const double string_time = secondsSince(start);
+
+		auto transcode = [&](const mp::JsonOptions& options)
+		{
+			const Clock::time_point start = Clock::now();
+
+			for(size_t i = 0; i < repeat; i++)
+			{
+				size_t index = 0;
+
+				while(index < data.size())
+				{
+					const std::error_code error = mp::toJson(data, index, [&](const std::string_view piece)
+					{
+						output_size += piece.size();
+					}, options);
+
+					if(error)
+					{
+						break;
+					}
+				}
+			}
+
+			return secondsSince(start);
+		};
+
+		mp::JsonOptions compact;
+
+		mp::JsonOptions pretty;
+		pretty.pretty = true;
+
+		const double compact_time = transcode(compact);
+		const double pretty_time  = transcode(pretty);
+
+		printf("  to_string(deserialize()): %8.1f MB/s\n", megabytes / string_time);
+		printf("  toJson()                : %8.1f MB/s  %6.2fx\n", megabytes / compact_time, string_time / compact_time);
+		printf("  toJson() pretty         : %8.1f MB/s  %6.2fx\n", megabytes / pretty_time, string_time / pretty_time);
+		printf("  (%zu)\n", output_size);
+	}
+
+	// }}}
+	// {{{ fromjson
+
+	/**
+	 * Documents shaped like the usual JSON parser corpora, which can not be 
+	 * downloaded here.
+	 */
+	std::string jsonTwitter(const size_t count)
+	{
+		std::string json = "{\"statuses\": [";
+
+		for(size_t i = 0; i < count; i++)
+		{
+			const std::string id = std::to_string(505874924095815681 + i * 7919);
+
+			json += (i == 0) ? "\n" : ",\n";
+			json += "  {\"created_at\": \"Sun Aug 31 00:29:15 +0000 2014\", \"id\": " + id
+				+ ", \"id_str\": \"" + id + "\""
+				+ ", \"text\": \"RT @user_" + std::to_string(i % 97) + ": \\\"Quoted\\\" text \\u3010\\u307f\\u3011 "
+				  "with an emoji \\ud83d\\ude00 and a link https:\\/\\/t.co\\/" + std::to_string(i * 31) + "\""
+				+ ", \"source\": \"<a href=\\\"https:\\/\\/mobile.twitter.com\\\" rel=\\\"nofollow\\\">Mobile Web<\\/a>\""
+				+ ", \"truncated\": false, \"in_reply_to_status_id\": null"
+				+ ", \"user\": {\"id\": " + std::to_string(1186275104 + i) + ", \"name\": \"いどすぎ\", "
+				  "\"screen_name\": \"user_" + std::to_string(i) + "\", \"location\": \"\", "
+				  "\"description\": \"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.\", "
+				  "\"followers_count\": " + std::to_string(i * 13 % 10000) + ", \"verified\": false, "
+				  "\"profile_background_color\": \"C0DEED\", \"lang\": \"ja\"}"
+				+ ", \"entities\": {\"hashtags\": [], \"symbols\": [], \"urls\": [{\"url\": \"https:\\/\\/t.co\\/abc\", "
+				  "\"indices\": [" + std::to_string(i % 140) + ", " + std::to_string(i % 140 + 23) + "]}], \"user_mentions\": []}"
+				+ ", \"retweet_count\": " + std::to_string(i % 1000) + ", \"favorited\": false, \"lang\": \"ja\"}";
+		}
+
+		json += "\n]}";
+
+		return json;
+	}
+
+
+	std::string jsonCanada(const size_t count)
+	{
+		std::string json = "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{\"name\":\"Canada\"},"
+			"\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[";
+
+		char buffer[64];
+
+		for(size_t i = 0; i < count; i++)
+		{
+			snprintf(buffer, sizeof(buffer), "%s[%.15f,%.15f]"
+				, (i == 0) ? "" : ","
+				, -65.613616999999977 + double(i) * 0.000123
+				, 43.420273000000009 + double(i % 1000) * 0.000987
+				);
+
+			json += buffer;
+		}
+
+		json += "]]}}]}";
+
+		return json;
+	}
+
+
+	std::string jsonCitm(const size_t count)
+	{
+		std::string json = "{\n  \"events\": {";
+
+		for(size_t i = 0; i < count; i++)
+		{
+			const std::string id = std::to_string(138586341 + i);
+
+			json += (i == 0) ? "\n" : ",\n";
+			json += "    \"" + id + "\": {\n      \"description\": null,\n      \"id\": " + id
+				+ ",\n      \"logo\": \"/images/UE0AAAAACEKo6QAAAAZDSVRN\",\n      \"name\": \"Event " + id + "\""
+				+ ",\n      \"subTopicIds\": [\n        337184269,\n        337184283\n      ],\n      \"subjectCode\": null"
+				+ ",\n      \"topicIds\": [\n        324846099,\n        107888604\n      ]\n    }";
+		}
+
+		json += "\n  },\n  \"performances\": [";
+
+		for(size_t i = 0; i < count; i++)
+		{
+			json += (i == 0) ? "\n" : ",\n";
+			json += "    {\n      \"eventId\": " + std::to_string(138586341 + i)
+				+ ",\n      \"id\": " + std::to_string(339887544 + i)
+				+ ",\n      \"prices\": [\n        {\n          \"amount\": " + std::to_string(90250 + i % 100 * 500)
+				+ ",\n          \"audienceSubCategoryId\": 337100890,\n          \"seatCategoryId\": 338937295\n        }\n      ]"
+				+ ",\n      \"start\": " + std::to_string(1372701600000 + i * 86400000)
+				+ ",\n      \"venueCode\": \"PLEYEL_PLEYEL\"\n    }";
+		}
+
+		json += "\n  ]\n}";
+
+		return json;
+	}
+
+
+	void benchmarkFromJson()
+	{
+		const size_t repeat = 20;
+
+		printf("fromjson: convert JSON to MessagePack\n");
+
+		const std::pair<const char*, std::string> corpus_list[] =
+		{	{ "twitter", jsonTwitter(5'000)  }
+		,	{ "canada" , jsonCanada(100'000) }
+		,	{ "citm"   , jsonCitm(10'000)    }
+		};
+
+		for(const auto& [name, json] : corpus_list)
+		{
+			const double megabytes = (double)(json.size() * repeat) / (1024 * 1024);
+
+			std::vector<uint8_t> data;
+			std::error_code      error;
+
+			// Find the tokens, with each classifier
+			auto classify = [&](mp::JsonBlock_ (*function)(const uint8_t*))
+			{
+				uint64_t count = 0;
+
+				const Clock::time_point start = Clock::now();
+
+				for(size_t i = 0; i < repeat; i++)
+				{
+					for(size_t offset = 0; offset + mp::Json_Block_Size_ <= json.size(); offset += mp::Json_Block_Size_)
+					{
+						const mp::JsonBlock_ block = function((const uint8_t*)json.data() + offset);
+
+						count += std::popcount(block.operators | block.quote);
+					}
+				}
+
+				const double time = secondsSince(start);
+
+				return std::pair{time, count};
+			};
+
+			const auto [scalar_time, scalar_count] = classify(mp::jsonClassifyScalar_);
+
+			printf("  %-7s %6.2f MB\n", name, (double)json.size() / (1024 * 1024));
+			printf("    classify scalar: %8.1f MB/s\n", megabytes / scalar_time);
+
+#if defined(__x86_64__) || defined(__i386__)
+			if(__builtin_cpu_supports("sse2"))
+			{
+				const auto [time, count] = classify(mp::jsonClassifySse2_);
+
+				printf("    classify sse2  : %8.1f MB/s  %6.2fx%s\n", megabytes / time, scalar_time / time, (count == scalar_count) ? "" : "  MISMATCH");
+			}
+
+			if(__builtin_cpu_supports("avx2"))
+			{
+				const auto [time, count] = classify(mp::jsonClassifyAvx2_);
+
+				printf("    classify avx2  : %8.1f MB/s  %6.2fx%s\n", megabytes / time, scalar_time / time, (count == scalar_count) ? "" : "  MISMATCH");
+			}
+#endif
+
+			std::vector<uint32_t> token_vector;
+
+			Clock::time_point start = Clock::now();
+
+			for(size_t i = 0; i < repeat; i++)
+			{
+				error = mp::jsonTokens_(json, token_vector);
+			}
+
+			const double token_time = secondsSince(start);
+
+			start = Clock::now();
+
+			for(size_t i = 0; i < repeat; i++)
+			{
+				data.clear();
+
+				mp::Packer packer(data);
+
+				error = mp::fromJson(json, packer);
+			}
+
+			const double convert_time = secondsSince(start);
+
+			printf("    tokens         : %8.1f MB/s  %zu tokens\n", megabytes / token_time, token_vector.size());
+			printf("    fromJson()     : %8.1f MB/s  %zu bytes of MessagePack  (%s)\n"
+				, megabytes / convert_time
+				, data.size()
+				, error.message().c_str()
+				);
+		}
+	}
+
+	// }}}
+	// {{{ query
+
+	void benchmarkQuery()
+	{
+		const size_t message_count = 1'000;
+		const size_t repeat        = 100;
+
+		std::vector<std::vector<uint8_t>> message_vector;
+
+		for(size_t i = 0; i < message_count; i++)
+		{
+			mp::Object object = {mp::Map{}};
+			mp::Map&   map    = object.asMap();
+
+			map.set(mp::Object{"id"}, mp::Object{uint64_t(i)});
+
+			for(size_t field = 0; field < 24; field++)
+			{
+				map.set(mp::Object{std::pmr::string("field_" + std::to_string(field))}
+					, mp::Object{std::pmr::string(40, char('a' + field))}
+					);
+			}
+
+			map.set(mp::Object{"payload"}, mp::Object{std::pmr::vector<uint8_t>(2048, (uint8_t)i)});
+
+			mp::Map& route = map.emplace<mp::Map>("meta").emplace<mp::Map>("route");
+			route.set(mp::Object{"service"}, mp::Object{"telemetry"});
+
+			mp::Array& hops = route.emplace<mp::Array>("hops");
+
+			for(size_t hop = 0; hop < 8; hop++)
+			{
+				mp::Map& entry = hops.emplace<mp::Map>();
+				entry.set(mp::Object{"host"}, mp::Object{std::pmr::string("host-" + std::to_string(hop))});
+				entry.set(mp::Object{"port"}, mp::Object{int64_t(8000 + hop)});
+			}
+
+			message_vector.push_back(mp::serialize(object));
+		}
+
+		printf("query: find \"meta.route.hops[5].host\" in %zu messages of %zu bytes\n"
+			, message_count
+			, message_vector[0].size()
+			);
+
+		auto measure = [&](const char* name, auto function, const double base_time)
+		{
+			size_t found = 0;
+
+			const Clock::time_point start = Clock::now();
+
+			for(size_t r = 0; r < repeat; r++)
+			{
+				for(const std::vector<uint8_t>& message : message_vector)
+				{
+					found += function(message);
+				}
+			}
+
+			const double time = secondsSince(start) / (double)(repeat * message_count);
+
+			printf("  %-24s: %9.1f ns  speed-up: %6.2fx  (%zu)\n"
+				, name
+				, time * 1e9
+				, (base_time > 0) ? base_time / time : 1.0
+				, found
+				);
+
+			return time;
+		};
+
+		const mp::Object meta  = {"meta"};
+		const mp::Object route = {"route"};
+		const mp::Object hops  = {"hops"};
+		const mp::Object host  = {"host"};
+
+		const double base_time = measure("deserialize() + at()", [&](const std::vector<uint8_t>& message)
+		{
+			const mp::Object object = mp::deserialize(message);
+			const mp::Array& array  = object.asMap().at(meta).asMap().at(route).asMap().at(hops).asArray();
+
+			return array.object(5).asMap().at(host).asString().size();
+		}, 0);
+
+		measure("ObjectView", [](const std::vector<uint8_t>& message)
+		{
+			return mp::ObjectView(message).asMap()["meta"].asMap()["route"].asMap()["hops"].asArray()[5].asMap()["host"].asString().size();
+		}, base_time);
+
+		measure("find()", [](const std::vector<uint8_t>& message)
+		{
+			return mp::find(message, "meta.route.hops[5].host").asString().size();
+		}, base_time);
+
+		const mp::Query query("meta.route.hops[5].host");
+
+		measure("Query::find()", [&](const std::vector<uint8_t>& message)
+		{
+			return query.find(message).asString().size();
+		}, base_time);
+
+		const mp::Query id_query("id");
+
+		measure("Query::find() \"id\"", [&](const std::vector<uint8_t>& message)
+		{
+			return (size_t)id_query.find(message).asUint();
+		}, base_time);
+	}
+
+	// }}}
+
+	struct Benchmark
+	{
+		const char* name;
+		void        (*function)();
+	};
+
+	const Benchmark Benchmark_List[] =
+	{	{ "threads"  , benchmarkThreads   }
+	,	{ "packer"   , benchmarkPacker    }
+	,	{ "size"     , benchmarkSize      }
+	,	{ "arena"    , benchmarkArena     }
+	,	{ "map"      , benchmarkMap       }
+	,	{ "fields"   , benchmarkFields    }
+	,	{ "skip"     , benchmarkSkip      }
+	,	{ "index"    , benchmarkIndex     }
+	,	{ "mapped"   , benchmarkMapped    }
+	,	{ "bulk"     , benchmarkBulk      }
+	,	{ "typed"    , benchmarkTyped     }
+	,	{ "gather"   , benchmarkGather    }
+	,	{ "move"     , benchmarkMove      }
+	,	{ "limits"   , benchmarkLimits    }
+	,	{ "batch"    , benchmarkBatch     }
+	,	{ "parallel" , benchmarkParallel  }
+	,	{ "keys"     , benchmarkKeys      }
+	,	{ "shapes"   , benchmarkShapes    }
+	,	{ "footprint", benchmarkFootprint }
+	,	{ "json"     , benchmarkJson      }
+	,	{ "fromjson" , benchmarkFromJson  }
+	,	{ "query"    , benchmarkQuery     }
+	};
+}
+
+
+int main(int argc, char** argv)
+{
+	const std::string_view name = (argc > 1) ? argv[1] : "";
+
+	for(const Benchmark& benchmark : Benchmark_List)
+	{
+		if(name.empty() || name == benchmark.name)
+		{
+			benchmark.function();
+		}
+	}
+
+	return 0;
+}
@@ -1,5 +1,5 @@
 /*
-g++ -std=c++20 -Wall -Werror -o Zakero_MessagePack Zakero_MessagePack.cpp && ./Zakero_MessagePack
+g++ -std=c++20 -Wall -Werror -o Zakero_MessagePack Zakero_MessagePack.cpp -lpthread && ./Zakero_MessagePack
  */
 #define DOCTEST_CONFIG_IMPLEMENT
 #include "../doctest.h"